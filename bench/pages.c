@@ -0,0 +1,98 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MVLA_IMPLEMENTATION
+#include "../mvla.h"
+#undef  MVLA_IMPLEMENTATION
+
+/*
+** Times the streaming batch kernels over arrays far bigger than the TLB can
+** cover with base pages, once per buffer backing. Each backing allocates the
+** inputs and output fresh, so the first pass also shows the page fault cost
+** of touching the memory. The backing reported is the one the OS granted,
+** followed by how much of the buffer actually sits on huge pages.
+**
+** usage: ./bin/pages [megabytes per array] [repetitions]
+*/
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static mvla_buffer_t alloc_or_die(size_t size, mvla_pages_t best) {
+  mvla_buffer_t buffer = mvla_buffer_alloc(size, best);
+  if (buffer.data == NULL) {
+    fprintf(stderr, "out of memory allocating %zu bytes\n", size);
+    exit(1);
+  }
+  return buffer;
+}
+
+static void run(mvla_pages_t best, size_t bytes, int reps) {
+  size_t n = bytes / sizeof(v4f_t), i;
+  mvla_buffer_t a = alloc_or_die(n * sizeof(v4f_t), best);
+  mvla_buffer_t b = alloc_or_die(n * sizeof(v4f_t), best);
+  mvla_buffer_t out = alloc_or_die(n * sizeof(v4f_t), best);
+  v4f_t *va = (v4f_t *) a.data, *vb = (v4f_t *) b.data, *vo = (v4f_t *) out.data;
+  mat4x4f_t m = mat4x4f_identity();
+  double t, touch, add = 1e30, xform = 1e30, len = 1e30;
+  int r;
+
+  t = now();
+  for (i = 0; i < n; ++i) {
+    va[i] = v4f((float) i, 1.0f, 2.0f, 1.0f);
+    vb[i] = v4f(0.5f, (float) i, 3.0f, 0.0f);
+  }
+  memset(vo, 0, n * sizeof(v4f_t));
+  touch = now() - t;
+
+  for (r = 0; r < reps; ++r) {
+    t = now();
+    v4f_add_n(va, vb, vo, n);
+    t = now() - t;
+    add = t < add ? t : add;
+    t = now();
+    mat4x4f_transform_v4f_n(m, va, vo, n, MVLA_XFORM_AFFINE);
+    t = now() - t;
+    xform = t < xform ? t : xform;
+    t = now();
+    v4f_len_n(va, (float *) vo, n);
+    t = now() - t;
+    len = t < len ? t : len;
+  }
+
+  // bytes moved: two reads and a write, a read and a write, a read and a quarter write
+  printf("%-12s %-12s %7.0f%% %9.1f %9.2f %9.2f %9.2f\n", mvla_pages_name(best),
+         mvla_pages_name(a.pages), 100.0 * mvla_buffer_huge_bytes(&a) / a.size,
+         3.0 * bytes / touch / 1e9, 3.0 * bytes / add / 1e9, 2.0 * bytes / xform / 1e9,
+         1.25 * bytes / len / 1e9);
+
+  mvla_buffer_free(&a);
+  mvla_buffer_free(&b);
+  mvla_buffer_free(&out);
+}
+
+int main(int argc, char **argv) {
+  size_t megabytes = argc > 1 ? strtoull(argv[1], NULL, 10) : 256;
+  int reps = argc > 2 ? atoi(argv[2]) : 5;
+  int p;
+  if (megabytes == 0) {
+    megabytes = 1;
+  }
+  if (reps < 1) {
+    reps = 1;
+  }
+
+  printf("3 arrays of %zu MB, best of %d, tier %s, %d threads, GB/s\n", megabytes, reps,
+         mvla_tier_name(mvla_tier_get()), mvla_threads_get());
+  printf("%-12s %-12s %8s %9s %9s %9s %9s\n", "asked", "granted", "on huge", "touch", "add_n",
+         "transform", "len_n");
+  for (p = MVLA_PAGES_HEAP; p <= MVLA_PAGES_HUGE; ++p) {
+    run((mvla_pages_t) p, megabytes << 20, reps);
+  }
+  return 0;
+}
@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MVLA_IMPLEMENTATION
+#include "../mvla.h"
+#undef  MVLA_IMPLEMENTATION
+
+/*
+** Times formatting and parsing lines of v3f and v3d against the printf and
+** strtod loops they replace, in nanoseconds per component, and checks that
+** every value reads back bit for bit.
+**
+** usage: ./bin/text [vectors]
+*/
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void run(mvla_type_t type, size_t n, char *text, size_t cap) {
+  size_t size = mvla_type_size(type), count = n * 3, len, used, i;
+  int single = type == MVLA_TYPE_V3F;
+  unsigned char *a = (unsigned char *) malloc(n * size), *back = (unsigned char *) malloc(n * size);
+  mvla_rng_t rng = mvla_rng(42);
+  double t, printf_ns, format_ns, strtod_ns, parse_ns;
+  char *p, *end;
+
+  for (i = 0; i < count; ++i) {
+    double v = (mvla_rng_randd(&rng) - 0.5) * 2000.0;
+    if (single) {
+      ((float *) a)[i] = (float) v;
+    } else {
+      ((double *) a)[i] = v;
+    }
+  }
+
+  t = now();
+  for (i = 0, len = 0; i < n; ++i) {
+    if (single) {
+      const float *v = (const float *) a + i * 3;
+      len += (size_t) snprintf(text + len, cap - len, "%.9g,%.9g,%.9g\n", v[0], v[1], v[2]);
+    } else {
+      const double *v = (const double *) a + i * 3;
+      len += (size_t) snprintf(text + len, cap - len, "%.17g,%.17g,%.17g\n", v[0], v[1], v[2]);
+    }
+  }
+  printf_ns = (now() - t) / count * 1e9;
+
+  t = now();
+  for (i = 0, p = text; i < count; ++i, p = end + 1) {
+    if (single) {
+      ((float *) back)[i] = strtof(p, &end);
+    } else {
+      ((double *) back)[i] = strtod(p, &end);
+    }
+  }
+  strtod_ns = (now() - t) / count * 1e9;
+
+  t = now();
+  mvla_format_n(type, a, n, text, cap, &len);
+  format_ns = (now() - t) / count * 1e9;
+
+  memset(back, 0, n * size);
+  t = now();
+  i = mvla_parse_n(type, text, len, back, n, &used);
+  parse_ns = (now() - t) / count * 1e9;
+
+  printf("%s  printf %6.1f  format_n %6.1f  strtod %6.1f  parse_n %6.1f  %.1f bytes/line%s\n",
+         single ? "v3f" : "v3d", printf_ns, format_ns, strtod_ns, parse_ns, (double) len / n,
+         i == n && used == len && memcmp(a, back, n * size) == 0 ? "" : "  MISMATCH");
+  free(a);
+  free(back);
+}
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : 1000000;
+  size_t cap = n * 3 * MVLA_FORMAT_MAX;
+  char *text = (char *) malloc(cap);
+  if (n == 0 || text == NULL) {
+    fprintf(stderr, "usage: ./bin/text [vectors]\n");
+    return 1;
+  }
+  printf("%zu vectors, ns per component\n", n);
+  run(MVLA_TYPE_V3F, n, text, cap);
+  run(MVLA_TYPE_V3D, n, text, cap);
+  free(text);
+  return 0;
+}
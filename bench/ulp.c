@@ -0,0 +1,287 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#define MVLA_IMPLEMENTATION
+#include "../mvla.h"
+#undef  MVLA_IMPLEMENTATION
+
+/*
+** Measures the error of the *_fast functions against libm in ulps, for every
+** dispatch tier the machine supports. Float functions sweep every bit pattern
+** (every stride'th one, stride defaults to 16 and 1 is exhaustive), double
+** functions take random bit patterns plus uniform samples in the polynomial
+** domain. References are computed one precision up (double for float, long
+** double for double) so they are effectively correctly rounded.
+**
+** usage: ./bin/ulp [float stride] [double samples]
+*/
+
+#define CHUNK 4096
+
+typedef void (*unary_f)(const v4f_t *, v4f_t *, size_t);
+typedef void (*unary_d)(const v4d_t *, v4d_t *, size_t);
+typedef void (*binary_f)(const v4f_t *, const v4f_t *, v4f_t *, size_t);
+typedef void (*binary_d)(const v4d_t *, const v4d_t *, v4d_t *, size_t);
+
+typedef struct result {
+  double max_ulp;
+  double worst_x, worst_y;
+  unsigned long long bad_special;
+} result_t;
+
+static double ulp_error_f(float got, double ref) {
+  int e;
+  double ulp;
+  float r = (float) ref;
+  if (isnan(ref) || isnan(got)) {
+    return (isnan(ref) && isnan(got)) ? 0.0 : INFINITY;
+  }
+  if (isinf(r) || isinf(got)) {
+    return (r == got) ? 0.0 : INFINITY;
+  }
+  frexp(ref, &e);
+  ulp = ldexp(1.0, e - 24);
+  if (ulp < ldexp(1.0, -149)) {
+    ulp = ldexp(1.0, -149);
+  }
+  return fabs((double) got - ref) / ulp;
+}
+
+static double ulp_error_d(double got, long double ref) {
+  int e;
+  long double ulp;
+  double r = (double) ref;
+  if (isnan(ref) || isnan(got)) {
+    return (isnan(ref) && isnan(got)) ? 0.0 : INFINITY;
+  }
+  if (isinf(r) || isinf(got)) {
+    return (r == got) ? 0.0 : INFINITY;
+  }
+  frexpl(ref, &e);
+  ulp = ldexpl(1.0L, e - 53);
+  if (ulp < ldexpl(1.0L, -1074)) {
+    ulp = ldexpl(1.0L, -1074);
+  }
+  return (double) (fabsl((long double) got - ref) / ulp);
+}
+
+static void track(result_t *res, double err, double x, double y) {
+  if (err == INFINITY) {
+    res->bad_special++;
+  } else if (err > res->max_ulp) {
+    res->max_ulp = err;
+    res->worst_x = x;
+    res->worst_y = y;
+  }
+}
+
+static unsigned long long rng_state = 0x9e3779b97f4a7c15ull;
+
+static unsigned long long rng(void) {
+  // splitmix64
+  unsigned long long z = (rng_state += 0x9e3779b97f4a7c15ull);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+static double uniform(double lo, double hi) {
+  return lo + (hi - lo) * ((double) (rng() >> 11) * 0x1.0p-53);
+}
+
+static double ref_exp_f(double x) { return exp(x); }
+static double ref_log_f(double x) { return log(x); }
+static double ref_sin_f(double x) { return sin(x); }
+static double ref_cos_f(double x) { return cos(x); }
+static double ref_tan_f(double x) { return tan(x); }
+static double ref_sqrt_f(double x) { return sqrt(x); }
+static double ref_rsqrt_f(double x) { return 1.0 / sqrt(x); }
+
+static long double ref_exp_d(long double x) { return expl(x); }
+static long double ref_log_d(long double x) { return logl(x); }
+static long double ref_sin_d(long double x) { return sinl(x); }
+static long double ref_cos_d(long double x) { return cosl(x); }
+static long double ref_tan_d(long double x) { return tanl(x); }
+static long double ref_sqrt_d(long double x) { return sqrtl(x); }
+static long double ref_rsqrt_d(long double x) { return 1.0L / sqrtl(x); }
+
+static void sweep_f(const char *name, unary_f fn, double (*ref)(double),
+                    unsigned long long stride) {
+  static float in[CHUNK], out[CHUNK];
+  result_t res;
+  unsigned long long bits;
+  size_t n = 0, i;
+  memset(&res, 0, sizeof(res));
+  for (bits = 0; bits <= 0xffffffffull; bits += stride) {
+    unsigned int b = (unsigned int) bits;
+    memcpy(&in[n++], &b, sizeof(b));
+    if (n == CHUNK || bits + stride > 0xffffffffull) {
+      size_t m = n & ~(size_t) 3;
+      fn((const v4f_t *) in, (v4f_t *) out, m / 4);
+      for (i = m; i < n; ++i) {
+        out[i] = in[i];
+      }
+      for (i = 0; i < m; ++i) {
+        track(&res, ulp_error_f(out[i], ref((double) in[i])), in[i], 0.0);
+      }
+      n = 0;
+    }
+  }
+  printf("  %-10s max %8.3f ulp at %.9g", name, res.max_ulp, res.worst_x);
+  printf(res.bad_special ? ", %llu special value mismatches\n" : "\n", res.bad_special);
+}
+
+static void sweep_d(const char *name, unary_d fn, long double (*ref)(long double),
+                    double lo, double hi, unsigned long long samples) {
+  static double in[CHUNK], out[CHUNK];
+  result_t res;
+  unsigned long long s;
+  size_t i;
+  memset(&res, 0, sizeof(res));
+  for (s = 0; s < samples; s += CHUNK) {
+    for (i = 0; i < CHUNK; ++i) {
+      if (i & 1) {
+        unsigned long long b = rng();
+        memcpy(&in[i], &b, sizeof(b));
+      } else {
+        in[i] = uniform(lo, hi);
+      }
+    }
+    fn((const v4d_t *) in, (v4d_t *) out, CHUNK / 4);
+    for (i = 0; i < CHUNK; ++i) {
+      track(&res, ulp_error_d(out[i], ref((long double) in[i])), in[i], 0.0);
+    }
+  }
+  printf("  %-10s max %8.3f ulp at %.17g", name, res.max_ulp, res.worst_x);
+  printf(res.bad_special ? ", %llu special value mismatches\n" : "\n", res.bad_special);
+}
+
+// bases over every exponent, exponents chosen so the result stays finite half the time
+static void sweep_pow_f(binary_f fn, unsigned long long samples) {
+  static float x[CHUNK], y[CHUNK], out[CHUNK];
+  result_t res;
+  unsigned long long s;
+  size_t i;
+  memset(&res, 0, sizeof(res));
+  for (s = 0; s < samples; s += CHUNK) {
+    for (i = 0; i < CHUNK; ++i) {
+      unsigned int b = (unsigned int) rng();
+      memcpy(&x[i], &b, sizeof(b));
+      if (i & 1) {
+        y[i] = (float) (uniform(-88.0, 88.0) / log(fabs(x[i]) + 1e-30));
+      } else {
+        b = (unsigned int) rng();
+        memcpy(&y[i], &b, sizeof(b));
+      }
+    }
+    fn((const v4f_t *) x, (const v4f_t *) y, (v4f_t *) out, CHUNK / 4);
+    for (i = 0; i < CHUNK; ++i) {
+      track(&res, ulp_error_f(out[i], pow((double) x[i], (double) y[i])), x[i], y[i]);
+    }
+  }
+  printf("  %-10s max %8.3f ulp at (%.9g, %.9g)", "powf", res.max_ulp, res.worst_x, res.worst_y);
+  printf(res.bad_special ? ", %llu special value mismatches\n" : "\n", res.bad_special);
+}
+
+static void sweep_pow_d(binary_d fn, unsigned long long samples, double tmax) {
+  static double x[CHUNK], y[CHUNK], out[CHUNK];
+  result_t res;
+  unsigned long long s;
+  size_t i;
+  memset(&res, 0, sizeof(res));
+  for (s = 0; s < samples; s += CHUNK) {
+    for (i = 0; i < CHUNK; ++i) {
+      unsigned long long b = rng();
+      memcpy(&x[i], &b, sizeof(b));
+      x[i] = fabs(x[i]);
+      y[i] = uniform(-tmax, tmax) / log(x[i] + 1e-300);
+    }
+    fn((const v4d_t *) x, (const v4d_t *) y, (v4d_t *) out, CHUNK / 4);
+    for (i = 0; i < CHUNK; ++i) {
+      track(&res, ulp_error_d(out[i], powl((long double) x[i], (long double) y[i])), x[i], y[i]);
+    }
+  }
+  printf("  powd |y ln x| <= %-5g max %8.3f ulp at (%.17g, %.17g)", tmax, res.max_ulp,
+         res.worst_x, res.worst_y);
+  printf(res.bad_special ? ", %llu special value mismatches\n" : "\n", res.bad_special);
+}
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// nanoseconds per component, fast batch against the libm backed batch
+static void speed(void) {
+  static v4f_t f[CHUNK / 4], fo[CHUNK / 4], fc[CHUNK / 4];
+  static v4d_t d[CHUNK / 4], dout[CHUNK / 4], dc[CHUNK / 4];
+  const int reps = 2000;
+  double t;
+  int r;
+  size_t i;
+  for (i = 0; i < CHUNK / 4; ++i) {
+    f[i] = v4f((float) uniform(-10, 10), (float) uniform(-10, 10),
+               (float) uniform(-10, 10), (float) uniform(-10, 10));
+    d[i] = v4d(uniform(-10, 10), uniform(-10, 10), uniform(-10, 10), uniform(-10, 10));
+  }
+#define TIME(label, call)                                                         \
+  t = now();                                                                      \
+  for (r = 0; r < reps; ++r) {                                                    \
+    call;                                                                         \
+  }                                                                               \
+  printf("  %-18s %7.3f ns\n", label, (now() - t) * 1e9 / ((double) reps * CHUNK));
+  TIME("v4f_exp_n", v4f_exp_n(f, fo, CHUNK / 4))
+  TIME("v4f_exp_fast_n", v4f_exp_fast_n(f, fo, CHUNK / 4))
+  TIME("v4f_sin_n", v4f_sin_n(f, fo, CHUNK / 4))
+  TIME("v4f_sin_fast_n", v4f_sin_fast_n(f, fo, CHUNK / 4))
+  TIME("v4f_sincos_n", v4f_sincos_n(f, fo, fc, CHUNK / 4))
+  TIME("v4f_sincos_fast_n", v4f_sincos_fast_n(f, fo, fc, CHUNK / 4))
+  TIME("v4d_exp_n", v4d_exp_n(d, dout, CHUNK / 4))
+  TIME("v4d_exp_fast_n", v4d_exp_fast_n(d, dout, CHUNK / 4))
+  TIME("v4d_sin_n", v4d_sin_n(d, dout, CHUNK / 4))
+  TIME("v4d_sin_fast_n", v4d_sin_fast_n(d, dout, CHUNK / 4))
+  TIME("v4d_sincos_n", v4d_sincos_n(d, dout, dc, CHUNK / 4))
+  TIME("v4d_sincos_fast_n", v4d_sincos_fast_n(d, dout, dc, CHUNK / 4))
+#undef TIME
+}
+
+int main(int argc, char **argv) {
+  unsigned long long stride = argc > 1 ? strtoull(argv[1], NULL, 10) : 16;
+  unsigned long long samples = argc > 2 ? strtoull(argv[2], NULL, 10) : 10000000;
+  mvla_tier_t best = mvla_tier_detect();
+  int t;
+  if (stride == 0) {
+    stride = 1;
+  }
+
+  for (t = MVLA_TIER_SCALAR; t <= (int) best; ++t) {
+    printf("tier %s (float stride %llu, %llu double samples)\n",
+           mvla_tier_name(mvla_tier_set((mvla_tier_t) t)), stride, samples);
+    sweep_f("expf", v4f_exp_fast_n, ref_exp_f, stride);
+    sweep_f("logf", v4f_log_fast_n, ref_log_f, stride);
+    sweep_f("sinf", v4f_sin_fast_n, ref_sin_f, stride);
+    sweep_f("cosf", v4f_cos_fast_n, ref_cos_f, stride);
+    sweep_f("tanf", v4f_tan_fast_n, ref_tan_f, stride);
+    sweep_f("sqrtf", v4f_sqrt_fast_n, ref_sqrt_f, stride);
+    sweep_f("rsqrtf", v4f_rsqrt_fast_n, ref_rsqrt_f, stride);
+    sweep_pow_f(v4f_pow_fast_n, samples);
+    sweep_d("expd", v4d_exp_fast_n, ref_exp_d, -708.0, 709.0, samples);
+    sweep_d("logd", v4d_log_fast_n, ref_log_d, 0.0, 4.0, samples);
+    sweep_d("sind", v4d_sin_fast_n, ref_sin_d, -65536.0, 65536.0, samples);
+    sweep_d("cosd", v4d_cos_fast_n, ref_cos_d, -65536.0, 65536.0, samples);
+    sweep_d("tand", v4d_tan_fast_n, ref_tan_d, -65536.0, 65536.0, samples);
+    sweep_d("sqrtd", v4d_sqrt_fast_n, ref_sqrt_d, 0.0, 4.0, samples);
+    sweep_d("rsqrtd", v4d_rsqrt_fast_n, ref_rsqrt_d, 0.0, 4.0, samples);
+    sweep_pow_d(v4d_pow_fast_n, samples, 1.0);
+    sweep_pow_d(v4d_pow_fast_n, samples, 700.0);
+  }
+
+  printf("speed (%s)\n", mvla_tier_name(mvla_tier_set(best)));
+  speed();
+
+  return 0;
+}
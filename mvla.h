@@ -33,9 +33,85 @@ extern "C" {
 ** INCLUDES
 */
 
+#include <float.h>
 #include <math.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+// -----------------------------------------
+
+/*
+** SIMD FEATURE DETECTION
+**
+** Detected from the compiler's target flags, so these only reflect what the
+** translation unit was built for (ie... -msse4.1, -mavx2, -march=native).
+** Define MVLA_NO_SIMD before including to force the scalar code paths.
+*/
+
+#ifndef MVLA_NO_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MVLA_HAS_SSE2
+#endif // SSE2
+#if defined(MVLA_HAS_SSE2) && (defined(__SSE4_1__) || defined(__AVX__))
+#define MVLA_HAS_SSE41
+#endif // SSE4.1
+#if defined(MVLA_HAS_SSE2) && defined(__AVX__)
+#define MVLA_HAS_AVX
+#endif // AVX
+#if defined(MVLA_HAS_AVX) && defined(__AVX2__)
+#define MVLA_HAS_AVX2
+#endif // AVX2
+#if defined(MVLA_HAS_AVX) && defined(__FMA__)
+#define MVLA_HAS_FMA
+#endif // FMA
+#if defined(MVLA_HAS_AVX2) && defined(__AVX512F__)
+#define MVLA_HAS_AVX512F
+#endif // AVX512F
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#define MVLA_HAS_NEON
+#endif // NEON
+#endif // MVLA_NO_SIMD
+
+#ifdef MVLA_HAS_SSE2
+#include <immintrin.h>
+#endif // MVLA_HAS_SSE2
+
+#ifdef MVLA_HAS_NEON
+#include <arm_neon.h>
+#endif // MVLA_HAS_NEON
+
+/*
+** Defining MVLA_SIMD stores v4i_t, v4u_t, v4f_t and v2d_t in 16 byte aligned
+** SSE or NEON registers (and v4d_t in a 32 byte AVX register when the target
+** has AVX) and maps their functions onto intrinsics. The components are
+** still reachable as .x, .y, .z and .w (anonymous structs need C11).
+*/
+
+#if defined(MVLA_SIMD) && defined(MVLA_HAS_SSE2)
+#define MVLA_SIMD_SSE
+#elif defined(MVLA_SIMD) && defined(MVLA_HAS_NEON)
+#define MVLA_SIMD_NEON
+#endif // MVLA_SIMD
+
+// v2d_t rides along with SSE2/NEON, v4d_t needs a 256-bit AVX register
+#if defined(MVLA_SIMD_SSE) && defined(MVLA_HAS_AVX)
+#define MVLA_SIMD_AVX
+#endif // MVLA_SIMD_AVX
+
+/*
+** Batch kernels are also built for tiers above the compile target and picked
+** at runtime from cpuid (see mvla_tier_get), so a baseline -msse2 binary still
+** runs AVX2 or AVX-512 code on machines that have it. This needs GCC or Clang
+** on x86, define MVLA_NO_DISPATCH to only use the compile target.
+*/
+
+#if defined(MVLA_HAS_SSE2) && !defined(MVLA_NO_DISPATCH) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define MVLA_DISPATCH
+#endif // MVLA_DISPATCH
 
 // -----------------------------------------
 
@@ -61,6 +137,61 @@ extern "C" {
 #define V3_ARGS(v) (v).x, (v).y, (v).z
 #define V4_ARGS(v) (v).x, (v).y, (v).z, (v).w
 
+// alignment in bytes of every structure-of-arrays component array
+#ifndef MVLA_SOA_ALIGN
+#define MVLA_SOA_ALIGN 64
+#endif // MVLA_SOA_ALIGN
+
+// size in bytes of the large pages mvla_buffer_alloc asks for
+#ifndef MVLA_HUGE_PAGE_SIZE
+#define MVLA_HUGE_PAGE_SIZE ((size_t) 2 << 20)
+#endif // MVLA_HUGE_PAGE_SIZE
+
+// largest buffer in bytes mvla_dump_n formats into before each write
+#ifndef MVLA_DUMP_CHUNK
+#define MVLA_DUMP_CHUNK ((size_t) 8 << 20)
+#endif // MVLA_DUMP_CHUNK
+
+// fewest elements worth handing to one thread in the threaded batch functions
+#ifndef MVLA_PARALLEL_GRAIN
+#define MVLA_PARALLEL_GRAIN 32768
+#endif // MVLA_PARALLEL_GRAIN
+
+// GEMM cache blocking in elements, MC x KC blocks of A are sized for L2 and
+// KC x NC panels of B for L3; rounded down to whole micro-tiles
+#ifndef MVLA_GEMM_MC
+#define MVLA_GEMM_MC 192
+#endif // MVLA_GEMM_MC
+
+#ifndef MVLA_GEMM_KC
+#define MVLA_GEMM_KC 256
+#endif // MVLA_GEMM_KC
+
+#ifndef MVLA_GEMM_NC
+#define MVLA_GEMM_NC 3072
+#endif // MVLA_GEMM_NC
+
+/*
+** Every allocation goes through MVLA_MALLOC and MVLA_FREE, define both to
+** replace them. Aligned blocks are carved out of MVLA_MALLOC unless
+** MVLA_ALIGNED_ALLOC(size, align) and its MVLA_ALIGNED_FREE(ptr) are defined.
+** Buffers handed to the caller and GEMM scratch can also be redirected at
+** runtime (see mvla_allocator_set).
+*/
+
+#if defined(MVLA_MALLOC) != defined(MVLA_FREE)
+#error "define both MVLA_MALLOC and MVLA_FREE or neither"
+#endif // MVLA_MALLOC
+
+#ifndef MVLA_MALLOC
+#define MVLA_MALLOC(size) malloc(size)
+#define MVLA_FREE(ptr) free(ptr)
+#endif // MVLA_MALLOC
+
+#if defined(MVLA_ALIGNED_ALLOC) != defined(MVLA_ALIGNED_FREE)
+#error "define both MVLA_ALIGNED_ALLOC and MVLA_ALIGNED_FREE or neither"
+#endif // MVLA_ALIGNED_ALLOC
+
 // -----------------------------------------
 
 /*
@@ -81,6 +212,9 @@ extern "C" {
 #define MVLA_LNPI   1.14472988584940016388
 #define MVLA_LOGE   0.43429448190325181667
 
+// bytes the v*_format and mvla_format* functions write at most, NUL included
+#define MVLA_FORMAT_MAX 128
+
 // -----------------------------------------
 
 /*
@@ -99,10 +233,28 @@ typedef struct v2f {
   float x, y;
 } v2f_t;
 
+#if defined(MVLA_SIMD_SSE)
+
+typedef union v2d {
+  struct { double x, y; };
+  __m128d m;
+} v2d_t;
+
+#elif defined(MVLA_SIMD_NEON)
+
+typedef union v2d {
+  struct { double x, y; };
+  float64x2_t m;
+} v2d_t;
+
+#else
+
 typedef struct v2d {
   double x, y;
 } v2d_t;
 
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+
 // -----------------------------------------
 
 /*
@@ -131,6 +283,42 @@ typedef struct v3d {
 ** 4D VECTOR DEFINITIONS
 */
 
+#if defined(MVLA_SIMD_SSE)
+
+typedef union v4i {
+  struct { signed int x, y, z, w; };
+  __m128i m;
+} v4i_t;
+
+typedef union v4u {
+  struct { unsigned int x, y, z, w; };
+  __m128i m;
+} v4u_t;
+
+typedef union v4f {
+  struct { float x, y, z, w; };
+  __m128 m;
+} v4f_t;
+
+#elif defined(MVLA_SIMD_NEON)
+
+typedef union v4i {
+  struct { signed int x, y, z, w; };
+  int32x4_t m;
+} v4i_t;
+
+typedef union v4u {
+  struct { unsigned int x, y, z, w; };
+  uint32x4_t m;
+} v4u_t;
+
+typedef union v4f {
+  struct { float x, y, z, w; };
+  float32x4_t m;
+} v4f_t;
+
+#else
+
 typedef struct v4i {
   signed int x, y, z, w;
 } v4i_t;
@@ -143,10 +331,388 @@ typedef struct v4f {
   float x, y, z, w;
 } v4f_t;
 
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+
+#if defined(MVLA_SIMD_AVX)
+
+typedef union v4d {
+  struct { double x, y, z, w; };
+  __m256d m;
+} v4d_t;
+
+#else
+
 typedef struct v4d {
   double x, y, z, w;
 } v4d_t;
 
+#endif // MVLA_SIMD_AVX
+
+// -----------------------------------------
+
+/*
+** MATRIX DEFINITIONS
+**
+** Matrices are column-major and stored as their column vectors, so c[j] is
+** column j and a matrix times a vector sums the columns weighted by the
+** vector's components. Products compose right to left: (a * b) * v applies b
+** first.
+*/
+
+// flags for the batch matrix transforms
+typedef enum mvla_xform_flags {
+  MVLA_XFORM_AFFINE = 1 << 0, // take the bottom row as (0, 0, 0, 1), the 3x4 fast path
+  MVLA_XFORM_DIVIDE = 1 << 1, // divide the result by its w, which becomes 1
+  MVLA_XFORM_STREAM = 1 << 2  // non-temporal stores, for outputs not read again soon
+} mvla_xform_flags_t;
+
+typedef struct mat2x2f {
+  v2f_t c[2];
+} mat2x2f_t;
+
+typedef struct mat2x2d {
+  v2d_t c[2];
+} mat2x2d_t;
+
+typedef struct mat3x3f {
+  v3f_t c[3];
+} mat3x3f_t;
+
+typedef struct mat3x3d {
+  v3d_t c[3];
+} mat3x3d_t;
+
+typedef struct mat4x4f {
+  v4f_t c[4];
+} mat4x4f_t;
+
+typedef struct mat4x4d {
+  v4d_t c[4];
+} mat4x4d_t;
+
+// -----------------------------------------
+
+/*
+** 2D STRUCTURE-OF-ARRAYS DEFINITIONS
+**
+** Each component lives in its own MVLA_SOA_ALIGN aligned array, so SIMD
+** kernels get one lane per vector instead of one lane per component.
+*/
+
+typedef struct v2i_soa {
+  signed int *x, *y;
+  size_t count;
+} v2i_soa_t;
+
+typedef struct v2u_soa {
+  unsigned int *x, *y;
+  size_t count;
+} v2u_soa_t;
+
+typedef struct v2f_soa {
+  float *x, *y;
+  size_t count;
+} v2f_soa_t;
+
+typedef struct v2d_soa {
+  double *x, *y;
+  size_t count;
+} v2d_soa_t;
+
+// -----------------------------------------
+
+/*
+** 3D STRUCTURE-OF-ARRAYS DEFINITIONS
+*/
+
+typedef struct v3i_soa {
+  signed int *x, *y, *z;
+  size_t count;
+} v3i_soa_t;
+
+typedef struct v3u_soa {
+  unsigned int *x, *y, *z;
+  size_t count;
+} v3u_soa_t;
+
+typedef struct v3f_soa {
+  float *x, *y, *z;
+  size_t count;
+} v3f_soa_t;
+
+typedef struct v3d_soa {
+  double *x, *y, *z;
+  size_t count;
+} v3d_soa_t;
+
+// -----------------------------------------
+
+/*
+** 4D STRUCTURE-OF-ARRAYS DEFINITIONS
+*/
+
+typedef struct v4i_soa {
+  signed int *x, *y, *z, *w;
+  size_t count;
+} v4i_soa_t;
+
+typedef struct v4u_soa {
+  unsigned int *x, *y, *z, *w;
+  size_t count;
+} v4u_soa_t;
+
+typedef struct v4f_soa {
+  float *x, *y, *z, *w;
+  size_t count;
+} v4f_soa_t;
+
+typedef struct v4d_soa {
+  double *x, *y, *z, *w;
+  size_t count;
+} v4d_soa_t;
+
+// -----------------------------------------
+
+/*
+** MATRIX STRUCTURE-OF-ARRAYS DEFINITIONS
+**
+** One array per matrix element, in the column-major order of the matrix types:
+** row r of column c of matrix i is m[c * N + r][i].
+*/
+
+typedef struct mat3x3f_soa {
+  float *m[9];
+  size_t count;
+} mat3x3f_soa_t;
+
+typedef struct mat3x3d_soa {
+  double *m[9];
+  size_t count;
+} mat3x3d_soa_t;
+
+typedef struct mat4x4f_soa {
+  float *m[16];
+  size_t count;
+} mat4x4f_soa_t;
+
+typedef struct mat4x4d_soa {
+  double *m[16];
+  size_t count;
+} mat4x4d_soa_t;
+
+// -----------------------------------------
+
+/*
+** DYNAMIC VECTOR DEFINITIONS
+**
+** Dense vectors of any length, for feature and embedding workloads that don't
+** fit in 4 components. data is MVLA_SOA_ALIGN aligned when allocated by
+** mvla_vec*_alloc.
+*/
+
+typedef struct mvla_vecf {
+  float *data;
+  size_t len;
+} mvla_vecf_t;
+
+typedef struct mvla_vecd {
+  double *data;
+  size_t len;
+} mvla_vecd_t;
+
+// -----------------------------------------
+
+/*
+** DENSE MATRIX DEFINITIONS
+**
+** Matrices of any size, column-major like the fixed size matrices: element
+** (i, j) is data[j * ld + i] with a leading dimension ld of at least rows.
+*/
+
+// whether a GEMM operand is used as stored or transposed
+typedef enum mvla_trans {
+  MVLA_NO_TRANS = 0,
+  MVLA_TRANS = 1
+} mvla_trans_t;
+
+typedef struct mvla_matf {
+  float *data;
+  size_t rows, cols, ld;
+} mvla_matf_t;
+
+typedef struct mvla_matd {
+  double *data;
+  size_t rows, cols, ld;
+} mvla_matd_t;
+
+// -----------------------------------------
+
+/*
+** DISPATCH TIER DEFINITIONS
+*/
+
+// instruction set tiers the batch kernels are built for, in increasing order
+typedef enum mvla_tier {
+  MVLA_TIER_SCALAR,
+  MVLA_TIER_SSE2,
+  MVLA_TIER_AVX2,
+  MVLA_TIER_AVX512
+} mvla_tier_t;
+
+// -----------------------------------------
+
+/*
+** MEMORY DEFINITIONS
+*/
+
+// where the buffers mvla allocates come from (see mvla_allocator_set)
+typedef struct mvla_allocator {
+  // returns size bytes aligned to align (a power of two), or NULL
+  void *(*alloc)(void *user, size_t size, size_t align);
+  // releases a block returned by alloc, may do nothing
+  void (*free)(void *user, void *ptr);
+  void *user;
+} mvla_allocator_t;
+
+// backings of an mvla_buffer_t, from plainest to largest pages
+typedef enum mvla_pages {
+  MVLA_PAGES_HEAP,        // the default allocator, when nothing can be mapped
+  MVLA_PAGES_SMALL,       // a private anonymous mapping of base pages
+  MVLA_PAGES_TRANSPARENT, // a mapping the kernel promotes to 2MB pages as it faults in
+  MVLA_PAGES_HUGE         // a mapping of reserved 2MB pages (MAP_HUGETLB)
+} mvla_pages_t;
+
+// a large buffer, 2MB aligned when mapped
+typedef struct mvla_buffer {
+  void *data;
+  size_t size, mapped;
+  mvla_pages_t pages;
+} mvla_buffer_t;
+
+// a linear allocator over one buffer, allocations are freed by resetting it
+typedef struct mvla_arena {
+  unsigned char *base;
+  size_t size, used;
+  int owned;
+} mvla_arena_t;
+
+// -----------------------------------------
+
+/*
+** FILE DEFINITIONS
+*/
+
+// element types of a vector file, the scalar kind in the low byte and the
+// number of components above it
+typedef enum mvla_type {
+  MVLA_TYPE_I32 = 0x0101,
+  MVLA_TYPE_U32 = 0x0102,
+  MVLA_TYPE_F32 = 0x0103,
+  MVLA_TYPE_F64 = 0x0104,
+  MVLA_TYPE_V2I = 0x0201,
+  MVLA_TYPE_V2U = 0x0202,
+  MVLA_TYPE_V2F = 0x0203,
+  MVLA_TYPE_V2D = 0x0204,
+  MVLA_TYPE_V3I = 0x0301,
+  MVLA_TYPE_V3U = 0x0302,
+  MVLA_TYPE_V3F = 0x0303,
+  MVLA_TYPE_V3D = 0x0304,
+  MVLA_TYPE_V4I = 0x0401,
+  MVLA_TYPE_V4U = 0x0402,
+  MVLA_TYPE_V4F = 0x0403,
+  MVLA_TYPE_V4D = 0x0404,
+  MVLA_TYPE_MAT3X3F = 0x0903,
+  MVLA_TYPE_MAT3X3D = 0x0904,
+  MVLA_TYPE_MAT4X4F = 0x1003,
+  MVLA_TYPE_MAT4X4D = 0x1004
+} mvla_type_t;
+
+// how the elements of a vector file are stored
+typedef enum mvla_layout {
+  MVLA_LAYOUT_AOS, // whole elements one after another, like an array of v3f_t
+  MVLA_LAYOUT_SOA  // one MVLA_SOA_ALIGN aligned array per component, like a v3f_soa_t
+} mvla_layout_t;
+
+typedef enum mvla_file_status {
+  MVLA_FILE_OK,
+  MVLA_FILE_ERR_IO,       // the file couldn't be opened, read, written or mapped
+  MVLA_FILE_ERR_FORMAT,   // not a vector file, a newer version or the other byte order
+  MVLA_FILE_ERR_CHECKSUM, // the payload doesn't match the checksum in the header
+  MVLA_FILE_ERR_MEMORY,   // too large to address or to allocate
+  MVLA_FILE_ERR_ARG       // a bad type or layout, or a writer given the wrong number of elements
+} mvla_file_status_t;
+
+typedef enum mvla_file_flags {
+  MVLA_FILE_VERIFY = 1 << 0 // check the checksum, which reads the whole payload
+} mvla_file_flags_t;
+
+// a vector file opened by mvla_file_open, data points into a private mapping
+// of the file so the first write to a page copies it
+typedef struct mvla_file {
+  void *data;
+  mvla_type_t type;
+  mvla_layout_t layout;
+  size_t count, stride;
+  void *base;
+  size_t size;
+  int mapped;
+} mvla_file_t;
+
+// a vector file being written chunk by chunk (see mvla_writer_open)
+typedef struct mvla_writer {
+  FILE *file;
+  mvla_type_t type;
+  mvla_layout_t layout;
+  size_t count, written, stride;
+  uint64_t sum[16][2];
+  mvla_file_status_t status;
+} mvla_writer_t;
+
+// -----------------------------------------
+
+/*
+** THREADING DEFINITIONS
+*/
+
+// a piece of a parallel loop, called with disjoint [begin, end) ranges
+typedef void (*mvla_range_fn_t)(void *ctx, size_t begin, size_t end);
+
+// one of count independent tasks handed to an executor
+typedef void (*mvla_task_fn_t)(void *ctx, size_t index);
+
+// runs parallel loops on threads the caller manages (see mvla_executor_set)
+typedef struct mvla_executor {
+  // calls task(ctx, i) once for every i in [0, count) in any order, on any
+  // threads, and returns once all of them have returned
+  void (*run)(void *user, size_t count, mvla_task_fn_t task, void *ctx);
+  void *user;
+} mvla_executor_t;
+
+// -----------------------------------------
+
+/*
+** RANDOM GENERATOR DEFINITIONS
+*/
+
+// xoshiro256++ state, one per thread or stream, never all zero
+typedef struct mvla_rng {
+  uint64_t s[4];
+} mvla_rng_t;
+
+#define MVLA_RNG_LANES 8
+
+// MVLA_RNG_LANES xoshiro256++ states side by side, lane l is s[0..3][l]
+typedef struct mvla_rng_lanes {
+  uint64_t s[4][MVLA_RNG_LANES];
+} mvla_rng_lanes_t;
+
+// randomization applied to a low-discrepancy sequence
+typedef enum mvla_scramble {
+  MVLA_SCRAMBLE_NONE,  // the sequence itself
+  MVLA_SCRAMBLE_OWEN,  // nested uniform scramble of the digits per dimension
+  MVLA_SCRAMBLE_SHIFT  // Cranley-Patterson rotation, a random offset modulo 1 per dimension
+} mvla_scramble_t;
+
 // -----------------------------------------
 
 /*
@@ -154,14 +720,16 @@ typedef struct v4d {
 */
 
 /*
-** Generates a random float between 0 and 1
-** @returns: A random float between 0 and 1
+** Generates a random float in [0, 1) from the calling thread's generator. Each
+** thread is seeded on its own, see mvla_srand
+** @returns: A random float in [0, 1)
 */
 MVLADEF float randf(void);
 
 /*
-** Generates a random double between 0 and 1
-** @returns: A random double between 0 and 1
+** Generates a random double in [0, 1) from the calling thread's generator. Each
+** thread is seeded on its own, see mvla_srand
+** @returns: A random double in [0, 1)
 */
 MVLADEF double randd(void);
 
@@ -293,6 +861,14 @@ MVLADEF v2i_t v2i_max(v2i_t a, v2i_t b);
 */
 MVLADEF void v2i_print(v2i_t a);
 
+/*
+** Formats the components of a 2D integer vector the way v2i_print prints them
+** @param a: The vector to format
+** @param buf: The buffer to write to, MVLA_FORMAT_MAX bytes are always enough
+** @returns: The length written, not counting the terminating NUL
+*/
+MVLADEF size_t v2i_format(v2i_t a, char *buf);
+
 // v2u_t
 
 /*
@@ -365,6 +941,14 @@ MVLADEF v2u_t v2u_max(v2u_t a, v2u_t b);
 */
 MVLADEF void v2u_print(v2u_t a);
 
+/*
+** Formats the components of a 2D unsigned integer vector the way v2u_print prints them
+** @param a: The vector to format
+** @param buf: The buffer to write to, MVLA_FORMAT_MAX bytes are always enough
+** @returns: The length written, not counting the terminating NUL
+*/
+MVLADEF size_t v2u_format(v2u_t a, char *buf);
+
 // v2f_t
 
 /*
@@ -406,6 +990,24 @@ MVLADEF v2f_t v2f_sub(v2f_t a, v2f_t b);
 */
 MVLADEF v2f_t v2f_mul(v2f_t a, v2f_t b);
 
+/*
+** Multiplies two 2D float vectors component-wise and adds a third, rounding once when the target has FMA
+** @param a: The first vector to multiply
+** @param b: The second vector to multiply
+** @param c: The vector to add
+** @returns: The component-wise a * b + c
+*/
+MVLADEF v2f_t v2f_fma(v2f_t a, v2f_t b, v2f_t c);
+
+/*
+** Multiplies two 2D float vectors component-wise and subtracts a third, rounding once when the target has FMA
+** @param a: The first vector to multiply
+** @param b: The second vector to multiply
+** @param c: The vector to subtract
+** @returns: The component-wise a * b - c
+*/
+MVLADEF v2f_t v2f_fms(v2f_t a, v2f_t b, v2f_t c);
+
 /*
 ** Divides the components of the first 2D float vector by the second, component-wise
 ** @param a: The vector to be divided
@@ -481,6 +1083,15 @@ MVLADEF v2f_t v2f_cos(v2f_t a);
 */
 MVLADEF v2f_t v2f_tan(v2f_t a);
 
+/*
+** Calculates the component-wise sine and cosine of a 2D float vector, sharing the work of both
+** @param a: The vector to apply sine and cosine to
+** @param s: Receives the component-wise sine of a
+** @param c: Receives the component-wise cosine of a
+** @returns: N/A
+*/
+MVLADEF void v2f_sincos(v2f_t a, v2f_t *s, v2f_t *c);
+
 /*
 ** Calculates the magnitude (length) of a 2D float vector
 ** @param a: The vector to find the length of
@@ -495,6 +1106,68 @@ MVLADEF float v2f_len(v2f_t a);
 */
 MVLADEF float v2f_sqr_len(v2f_t a);
 
+/*
+** Calculates the dot product of two 2D float vectors
+** @param a: The first vector
+** @param b: The second vector
+** @returns: The sum of the component-wise products of a and b
+*/
+MVLADEF float v2f_dot(v2f_t a, v2f_t b);
+
+/*
+** Calculates the 2D cross product (perp dot product) of two 2D float vectors
+** @param a: The first vector
+** @param b: The second vector
+** @returns: a.x * b.y - a.y * b.x, the z component of the 3D cross product
+*/
+MVLADEF float v2f_cross(v2f_t a, v2f_t b);
+
+/*
+** Scales a 2D float vector to unit length, dividing by its length (the zero vector stays zero)
+** @param a: The vector to normalize
+** @returns: The unit vector in the direction of a
+*/
+MVLADEF v2f_t v2f_normalize(v2f_t a);
+
+/*
+** Scales a 2D float vector to unit length with rsqrtf_fast, a few ulp less accurate than v2f_normalize
+** @param a: The vector to normalize
+** @returns: The unit vector in the direction of a (the zero vector stays zero)
+*/
+MVLADEF v2f_t v2f_normalize_fast(v2f_t a);
+
+/*
+** Calculates the distance between two 2D float vectors
+** @param a: The first point
+** @param b: The second point
+** @returns: The length of a - b
+*/
+MVLADEF float v2f_dist(v2f_t a, v2f_t b);
+
+/*
+** Calculates the squared distance between two 2D float vectors
+** @param a: The first point
+** @param b: The second point
+** @returns: The squared length of a - b
+*/
+MVLADEF float v2f_sqr_dist(v2f_t a, v2f_t b);
+
+/*
+** Projects a 2D float vector onto another
+** @param a: The vector to project
+** @param b: The vector to project onto (a zero b gives the zero vector)
+** @returns: The component of a along b, b * dot(a, b) / dot(b, b)
+*/
+MVLADEF v2f_t v2f_project(v2f_t a, v2f_t b);
+
+/*
+** Reflects a 2D float vector off a surface
+** @param a: The incident vector
+** @param n: The unit normal of the surface
+** @returns: a - 2 * dot(a, n) * n
+*/
+MVLADEF v2f_t v2f_reflect(v2f_t a, v2f_t n);
+
 /*
 ** Prints the components of a 2D float vector
 ** @param a: The vector to print
@@ -502,6 +1175,15 @@ MVLADEF float v2f_sqr_len(v2f_t a);
 */
 MVLADEF void v2f_print(v2f_t a);
 
+/*
+** Formats the components of a 2D float vector the way v2f_print prints them,
+** each component in the fewest digits that read back to the same value
+** @param a: The vector to format
+** @param buf: The buffer to write to, MVLA_FORMAT_MAX bytes are always enough
+** @returns: The length written, not counting the terminating NUL
+*/
+MVLADEF size_t v2f_format(v2f_t a, char *buf);
+
 // v2d_t
 
 /*
@@ -543,6 +1225,24 @@ MVLADEF v2d_t v2d_sub(v2d_t a, v2d_t b);
 */
 MVLADEF v2d_t v2d_mul(v2d_t a, v2d_t b);
 
+/*
+** Multiplies two 2D double vectors component-wise and adds a third, rounding once when the target has FMA
+** @param a: The first vector to multiply
+** @param b: The second vector to multiply
+** @param c: The vector to add
+** @returns: The component-wise a * b + c
+*/
+MVLADEF v2d_t v2d_fma(v2d_t a, v2d_t b, v2d_t c);
+
+/*
+** Multiplies two 2D double vectors component-wise and subtracts a third, rounding once when the target has FMA
+** @param a: The first vector to multiply
+** @param b: The second vector to multiply
+** @param c: The vector to subtract
+** @returns: The component-wise a * b - c
+*/
+MVLADEF v2d_t v2d_fms(v2d_t a, v2d_t b, v2d_t c);
+
 /*
 ** Divides the components of the first 2D double vector by the second, component-wise
 ** @param a: The vector to be divided
@@ -618,6 +1318,15 @@ MVLADEF v2d_t v2d_cos(v2d_t a);
 */
 MVLADEF v2d_t v2d_tan(v2d_t a);
 
+/*
+** Calculates the component-wise sine and cosine of a 2D double vector, sharing the work of both
+** @param a: The vector to apply sine and cosine to
+** @param s: Receives the component-wise sine of a
+** @param c: Receives the component-wise cosine of a
+** @returns: N/A
+*/
+MVLADEF void v2d_sincos(v2d_t a, v2d_t *s, v2d_t *c);
+
 /*
 ** Calculates the magnitude (length) of a 2D double vector
 ** @param a: The vector to find the length of
@@ -632,6 +1341,68 @@ MVLADEF double v2d_len(v2d_t a);
 */
 MVLADEF double v2d_sqr_len(v2d_t a);
 
+/*
+** Calculates the dot product of two 2D double vectors
+** @param a: The first vector
+** @param b: The second vector
+** @returns: The sum of the component-wise products of a and b
+*/
+MVLADEF double v2d_dot(v2d_t a, v2d_t b);
+
+/*
+** Calculates the 2D cross product (perp dot product) of two 2D double vectors
+** @param a: The first vector
+** @param b: The second vector
+** @returns: a.x * b.y - a.y * b.x, the z component of the 3D cross product
+*/
+MVLADEF double v2d_cross(v2d_t a, v2d_t b);
+
+/*
+** Scales a 2D double vector to unit length, dividing by its length (the zero vector stays zero)
+** @param a: The vector to normalize
+** @returns: The unit vector in the direction of a
+*/
+MVLADEF v2d_t v2d_normalize(v2d_t a);
+
+/*
+** Scales a 2D double vector to unit length with rsqrtd_fast, a few ulp less accurate than v2d_normalize
+** @param a: The vector to normalize
+** @returns: The unit vector in the direction of a (the zero vector stays zero)
+*/
+MVLADEF v2d_t v2d_normalize_fast(v2d_t a);
+
+/*
+** Calculates the distance between two 2D double vectors
+** @param a: The first point
+** @param b: The second point
+** @returns: The length of a - b
+*/
+MVLADEF double v2d_dist(v2d_t a, v2d_t b);
+
+/*
+** Calculates the squared distance between two 2D double vectors
+** @param a: The first point
+** @param b: The second point
+** @returns: The squared length of a - b
+*/
+MVLADEF double v2d_sqr_dist(v2d_t a, v2d_t b);
+
+/*
+** Projects a 2D double vector onto another
+** @param a: The vector to project
+** @param b: The vector to project onto (a zero b gives the zero vector)
+** @returns: The component of a along b, b * dot(a, b) / dot(b, b)
+*/
+MVLADEF v2d_t v2d_project(v2d_t a, v2d_t b);
+
+/*
+** Reflects a 2D double vector off a surface
+** @param a: The incident vector
+** @param n: The unit normal of the surface
+** @returns: a - 2 * dot(a, n) * n
+*/
+MVLADEF v2d_t v2d_reflect(v2d_t a, v2d_t n);
+
 /*
 ** Prints the components of a 2D double vector
 ** @param a: The vector to print
@@ -639,6 +1410,15 @@ MVLADEF double v2d_sqr_len(v2d_t a);
 */
 MVLADEF void v2d_print(v2d_t a);
 
+/*
+** Formats the components of a 2D double vector the way v2d_print prints them,
+** each component in the fewest digits that read back to the same value
+** @param a: The vector to format
+** @param buf: The buffer to write to, MVLA_FORMAT_MAX bytes are always enough
+** @returns: The length written, not counting the terminating NUL
+*/
+MVLADEF size_t v2d_format(v2d_t a, char *buf);
+
 // -----------------------------------------
 
 /*
@@ -718,6 +1498,14 @@ MVLADEF v3i_t v3i_max(v3i_t a, v3i_t b);
 */
 MVLADEF void v3i_print(v3i_t a);
 
+/*
+** Formats the components of a 3D signed integer vector the way v3i_print prints them
+** @param a: The vector to format
+** @param buf: The buffer to write to, MVLA_FORMAT_MAX bytes are always enough
+** @returns: The length written, not counting the terminating NUL
+*/
+MVLADEF size_t v3i_format(v3i_t a, char *buf);
+
 // v3u_t
 
 /*
@@ -792,6 +1580,14 @@ MVLADEF v3u_t v3u_max(v3u_t a, v3u_t b);
 */
 MVLADEF void v3u_print(v3u_t a);
 
+/*
+** Formats the components of a 3D unsigned integer vector the way v3u_print prints them
+** @param a: The vector to format
+** @param buf: The buffer to write to, MVLA_FORMAT_MAX bytes are always enough
+** @returns: The length written, not counting the terminating NUL
+*/
+MVLADEF size_t v3u_format(v3u_t a, char *buf);
+
 // v3f_t
 
 /*
@@ -834,6 +1630,24 @@ MVLADEF v3f_t v3f_sub(v3f_t a, v3f_t b);
 */
 MVLADEF v3f_t v3f_mul(v3f_t a, v3f_t b);
 
+/*
+** Multiplies two 3D float vectors component-wise and adds a third, rounding once when the target has FMA
+** @param a: The first vector to multiply
+** @param b: The second vector to multiply
+** @param c: The vector to add
+** @returns: The component-wise a * b + c
+*/
+MVLADEF v3f_t v3f_fma(v3f_t a, v3f_t b, v3f_t c);
+
+/*
+** Multiplies two 3D float vectors component-wise and subtracts a third, rounding once when the target has FMA
+** @param a: The first vector to multiply
+** @param b: The second vector to multiply
+** @param c: The vector to subtract
+** @returns: The component-wise a * b - c
+*/
+MVLADEF v3f_t v3f_fms(v3f_t a, v3f_t b, v3f_t c);
+
 /*
 ** Divides the components of the first 3D float vector by the second, component-wise
 ** @param a: The vector to be divided
@@ -909,6 +1723,15 @@ MVLADEF v3f_t v3f_cos(v3f_t a);
 */
 MVLADEF v3f_t v3f_tan(v3f_t a);
 
+/*
+** Calculates the component-wise sine and cosine of a 3D float vector, sharing the work of both
+** @param a: The vector to apply sine and cosine to
+** @param s: Receives the component-wise sine of a
+** @param c: Receives the component-wise cosine of a
+** @returns: N/A
+*/
+MVLADEF void v3f_sincos(v3f_t a, v3f_t *s, v3f_t *c);
+
 /*
 ** Calculates the magnitude (length) of a 3D float vector
 ** @param a: The vector to find the length of
@@ -923,6 +1746,68 @@ MVLADEF float v3f_len(v3f_t a);
 */
 MVLADEF float v3f_sqr_len(v3f_t a);
 
+/*
+** Calculates the dot product of two 3D float vectors
+** @param a: The first vector
+** @param b: The second vector
+** @returns: The sum of the component-wise products of a and b
+*/
+MVLADEF float v3f_dot(v3f_t a, v3f_t b);
+
+/*
+** Calculates the cross product of two 3D float vectors
+** @param a: The first vector
+** @param b: The second vector
+** @returns: The vector perpendicular to a and b, following the right-hand rule
+*/
+MVLADEF v3f_t v3f_cross(v3f_t a, v3f_t b);
+
+/*
+** Scales a 3D float vector to unit length, dividing by its length (the zero vector stays zero)
+** @param a: The vector to normalize
+** @returns: The unit vector in the direction of a
+*/
+MVLADEF v3f_t v3f_normalize(v3f_t a);
+
+/*
+** Scales a 3D float vector to unit length with rsqrtf_fast, a few ulp less accurate than v3f_normalize
+** @param a: The vector to normalize
+** @returns: The unit vector in the direction of a (the zero vector stays zero)
+*/
+MVLADEF v3f_t v3f_normalize_fast(v3f_t a);
+
+/*
+** Calculates the distance between two 3D float vectors
+** @param a: The first point
+** @param b: The second point
+** @returns: The length of a - b
+*/
+MVLADEF float v3f_dist(v3f_t a, v3f_t b);
+
+/*
+** Calculates the squared distance between two 3D float vectors
+** @param a: The first point
+** @param b: The second point
+** @returns: The squared length of a - b
+*/
+MVLADEF float v3f_sqr_dist(v3f_t a, v3f_t b);
+
+/*
+** Projects a 3D float vector onto another
+** @param a: The vector to project
+** @param b: The vector to project onto (a zero b gives the zero vector)
+** @returns: The component of a along b, b * dot(a, b) / dot(b, b)
+*/
+MVLADEF v3f_t v3f_project(v3f_t a, v3f_t b);
+
+/*
+** Reflects a 3D float vector off a surface
+** @param a: The incident vector
+** @param n: The unit normal of the surface
+** @returns: a - 2 * dot(a, n) * n
+*/
+MVLADEF v3f_t v3f_reflect(v3f_t a, v3f_t n);
+
 /*
 ** Prints the components of a 3D float vector
 ** @param a: The vector to print
@@ -930,6 +1815,15 @@ MVLADEF float v3f_sqr_len(v3f_t a);
 */
 MVLADEF void v3f_print(v3f_t a);
 
+/*
+** Formats the components of a 3D float vector the way v3f_print prints them,
+** each component in the fewest digits that read back to the same value
+** @param a: The vector to format
+** @param buf: The buffer to write to, MVLA_FORMAT_MAX bytes are always enough
+** @returns: The length written, not counting the terminating NUL
+*/
+MVLADEF size_t v3f_format(v3f_t a, char *buf);
+
 // v3d_t
 
 /*
@@ -972,6 +1866,24 @@ MVLADEF v3d_t v3d_sub(v3d_t a, v3d_t b);
 */
 MVLADEF v3d_t v3d_mul(v3d_t a, v3d_t b);
 
+/*
+** Multiplies two 3D double vectors component-wise and adds a third, rounding once when the target has FMA
+** @param a: The first vector to multiply
+** @param b: The second vector to multiply
+** @param c: The vector to add
+** @returns: The component-wise a * b + c
+*/
+MVLADEF v3d_t v3d_fma(v3d_t a, v3d_t b, v3d_t c);
+
+/*
+** Multiplies two 3D double vectors component-wise and subtracts a third, rounding once when the target has FMA
+** @param a: The first vector to multiply
+** @param b: The second vector to multiply
+** @param c: The vector to subtract
+** @returns: The component-wise a * b - c
+*/
+MVLADEF v3d_t v3d_fms(v3d_t a, v3d_t b, v3d_t c);
+
 /*
 ** Divides the components of the first 3D double vector by the second, component-wise
 ** @param a: The vector to be divided
@@ -1047,6 +1959,15 @@ MVLADEF v3d_t v3d_cos(v3d_t a);
 */
 MVLADEF v3d_t v3d_tan(v3d_t a);
 
+/*
+** Calculates the component-wise sine and cosine of a 3D double vector, sharing the work of both
+** @param a: The vector to apply sine and cosine to
+** @param s: Receives the component-wise sine of a
+** @param c: Receives the component-wise cosine of a
+** @returns: N/A
+*/
+MVLADEF void v3d_sincos(v3d_t a, v3d_t *s, v3d_t *c);
+
 /*
 ** Calculates the magnitude (length) of a 3D double vector
 ** @param a: The vector to find the length of
@@ -1061,6 +1982,68 @@ MVLADEF double v3d_len(v3d_t a);
 */
 MVLADEF double v3d_sqr_len(v3d_t a);
 
+/*
+** Calculates the dot product of two 3D double vectors
+** @param a: The first vector
+** @param b: The second vector
+** @returns: The sum of the component-wise products of a and b
+*/
+MVLADEF double v3d_dot(v3d_t a, v3d_t b);
+
+/*
+** Calculates the cross product of two 3D double vectors
+** @param a: The first vector
+** @param b: The second vector
+** @returns: The vector perpendicular to a and b, following the right-hand rule
+*/
+MVLADEF v3d_t v3d_cross(v3d_t a, v3d_t b);
+
+/*
+** Scales a 3D double vector to unit length, dividing by its length (the zero vector stays zero)
+** @param a: The vector to normalize
+** @returns: The unit vector in the direction of a
+*/
+MVLADEF v3d_t v3d_normalize(v3d_t a);
+
+/*
+** Scales a 3D double vector to unit length with rsqrtd_fast, a few ulp less accurate than v3d_normalize
+** @param a: The vector to normalize
+** @returns: The unit vector in the direction of a (the zero vector stays zero)
+*/
+MVLADEF v3d_t v3d_normalize_fast(v3d_t a);
+
+/*
+** Calculates the distance between two 3D double vectors
+** @param a: The first point
+** @param b: The second point
+** @returns: The length of a - b
+*/
+MVLADEF double v3d_dist(v3d_t a, v3d_t b);
+
+/*
+** Calculates the squared distance between two 3D double vectors
+** @param a: The first point
+** @param b: The second point
+** @returns: The squared length of a - b
+*/
+MVLADEF double v3d_sqr_dist(v3d_t a, v3d_t b);
+
+/*
+** Projects a 3D double vector onto another
+** @param a: The vector to project
+** @param b: The vector to project onto (a zero b gives the zero vector)
+** @returns: The component of a along b, b * dot(a, b) / dot(b, b)
+*/
+MVLADEF v3d_t v3d_project(v3d_t a, v3d_t b);
+
+/*
+** Reflects a 3D double vector off a surface
+** @param a: The incident vector
+** @param n: The unit normal of the surface
+** @returns: a - 2 * dot(a, n) * n
+*/
+MVLADEF v3d_t v3d_reflect(v3d_t a, v3d_t n);
+
 /*
 ** Prints the components of a 3D double vector
 ** @param a: The vector to print
@@ -1068,6 +2051,15 @@ MVLADEF double v3d_sqr_len(v3d_t a);
 */
 MVLADEF void v3d_print(v3d_t a);
 
+/*
+** Formats the components of a 3D double vector the way v3d_print prints them,
+** each component in the fewest digits that read back to the same value
+** @param a: The vector to format
+** @param buf: The buffer to write to, MVLA_FORMAT_MAX bytes are always enough
+** @returns: The length written, not counting the terminating NUL
+*/
+MVLADEF size_t v3d_format(v3d_t a, char *buf);
+
 // -----------------------------------------
 
 /*
@@ -1148,6 +2140,14 @@ MVLADEF v4i_t v4i_max(v4i_t a, v4i_t b);
 */
 MVLADEF void v4i_print(v4i_t a);
 
+/*
+** Formats the components of a 4D signed integer vector the way v4i_print prints them
+** @param a: The vector to format
+** @param buf: The buffer to write to, MVLA_FORMAT_MAX bytes are always enough
+** @returns: The length written, not counting the terminating NUL
+*/
+MVLADEF size_t v4i_format(v4i_t a, char *buf);
+
 // v4u_t
 
 /*
@@ -1222,6 +2222,14 @@ MVLADEF v4u_t v4u_max(v4u_t a, v4u_t b);
 */
 MVLADEF void v4u_print(v4u_t a);
 
+/*
+** Formats the components of a 4D unsigned integer vector the way v4u_print prints them
+** @param a: The vector to format
+** @param buf: The buffer to write to, MVLA_FORMAT_MAX bytes are always enough
+** @returns: The length written, not counting the terminating NUL
+*/
+MVLADEF size_t v4u_format(v4u_t a, char *buf);
+
 // v4f_t
 
 /*
@@ -1265,6 +2273,24 @@ MVLADEF v4f_t v4f_sub(v4f_t a, v4f_t b);
 */
 MVLADEF v4f_t v4f_mul(v4f_t a, v4f_t b);
 
+/*
+** Multiplies two 4D float vectors component-wise and adds a third, rounding once when the target has FMA
+** @param a: The first vector to multiply
+** @param b: The second vector to multiply
+** @param c: The vector to add
+** @returns: The component-wise a * b + c
+*/
+MVLADEF v4f_t v4f_fma(v4f_t a, v4f_t b, v4f_t c);
+
+/*
+** Multiplies two 4D float vectors component-wise and subtracts a third, rounding once when the target has FMA
+** @param a: The first vector to multiply
+** @param b: The second vector to multiply
+** @param c: The vector to subtract
+** @returns: The component-wise a * b - c
+*/
+MVLADEF v4f_t v4f_fms(v4f_t a, v4f_t b, v4f_t c);
+
 /*
 ** Divides the components of the first 4D float vector by the second, component-wise
 ** @param a: The vector to be divided
@@ -1340,6 +2366,15 @@ MVLADEF v4f_t v4f_cos(v4f_t a);
 */
 MVLADEF v4f_t v4f_tan(v4f_t a);
 
+/*
+** Calculates the component-wise sine and cosine of a 4D float vector, sharing the work of both
+** @param a: The vector to apply sine and cosine to
+** @param s: Receives the component-wise sine of a
+** @param c: Receives the component-wise cosine of a
+** @returns: N/A
+*/
+MVLADEF void v4f_sincos(v4f_t a, v4f_t *s, v4f_t *c);
+
 /*
 ** Calculates the magnitude (length) of a 4D float vector
 ** @param a: The vector to find the length of
@@ -1354,6 +2389,60 @@ MVLADEF float v4f_len(v4f_t a);
 */
 MVLADEF float v4f_sqr_len(v4f_t a);
 
+/*
+** Calculates the dot product of two 4D float vectors
+** @param a: The first vector
+** @param b: The second vector
+** @returns: The sum of the component-wise products of a and b
+*/
+MVLADEF float v4f_dot(v4f_t a, v4f_t b);
+
+/*
+** Scales a 4D float vector to unit length, dividing by its length (the zero vector stays zero)
+** @param a: The vector to normalize
+** @returns: The unit vector in the direction of a
+*/
+MVLADEF v4f_t v4f_normalize(v4f_t a);
+
+/*
+** Scales a 4D float vector to unit length with rsqrtf_fast, a few ulp less accurate than v4f_normalize
+** @param a: The vector to normalize
+** @returns: The unit vector in the direction of a (the zero vector stays zero)
+*/
+MVLADEF v4f_t v4f_normalize_fast(v4f_t a);
+
+/*
+** Calculates the distance between two 4D float vectors
+** @param a: The first point
+** @param b: The second point
+** @returns: The length of a - b
+*/
+MVLADEF float v4f_dist(v4f_t a, v4f_t b);
+
+/*
+** Calculates the squared distance between two 4D float vectors
+** @param a: The first point
+** @param b: The second point
+** @returns: The squared length of a - b
+*/
+MVLADEF float v4f_sqr_dist(v4f_t a, v4f_t b);
+
+/*
+** Projects a 4D float vector onto another
+** @param a: The vector to project
+** @param b: The vector to project onto (a zero b gives the zero vector)
+** @returns: The component of a along b, b * dot(a, b) / dot(b, b)
+*/
+MVLADEF v4f_t v4f_project(v4f_t a, v4f_t b);
+
+/*
+** Reflects a 4D float vector off a surface
+** @param a: The incident vector
+** @param n: The unit normal of the surface
+** @returns: a - 2 * dot(a, n) * n
+*/
+MVLADEF v4f_t v4f_reflect(v4f_t a, v4f_t n);
+
 /*
 ** Prints the components of a 4D float vector
 ** @param a: The vector to print
@@ -1361,6 +2450,15 @@ MVLADEF float v4f_sqr_len(v4f_t a);
 */
 MVLADEF void v4f_print(v4f_t a);
 
+/*
+** Formats the components of a 4D float vector the way v4f_print prints them,
+** each component in the fewest digits that read back to the same value
+** @param a: The vector to format
+** @param buf: The buffer to write to, MVLA_FORMAT_MAX bytes are always enough
+** @returns: The length written, not counting the terminating NUL
+*/
+MVLADEF size_t v4f_format(v4f_t a, char *buf);
+
 // v4d_t
 
 /*
@@ -1404,6 +2502,24 @@ MVLADEF v4d_t v4d_sub(v4d_t a, v4d_t b);
 */
 MVLADEF v4d_t v4d_mul(v4d_t a, v4d_t b);
 
+/*
+** Multiplies two 4D double vectors component-wise and adds a third, rounding once when the target has FMA
+** @param a: The first vector to multiply
+** @param b: The second vector to multiply
+** @param c: The vector to add
+** @returns: The component-wise a * b + c
+*/
+MVLADEF v4d_t v4d_fma(v4d_t a, v4d_t b, v4d_t c);
+
+/*
+** Multiplies two 4D double vectors component-wise and subtracts a third, rounding once when the target has FMA
+** @param a: The first vector to multiply
+** @param b: The second vector to multiply
+** @param c: The vector to subtract
+** @returns: The component-wise a * b - c
+*/
+MVLADEF v4d_t v4d_fms(v4d_t a, v4d_t b, v4d_t c);
+
 /*
 ** Divides the components of the first 4D double vector by the second, component-wise
 ** @param a: The vector to be divided
@@ -1479,6 +2595,15 @@ MVLADEF v4d_t v4d_cos(v4d_t a);
 */
 MVLADEF v4d_t v4d_tan(v4d_t a);
 
+/*
+** Calculates the component-wise sine and cosine of a 4D double vector, sharing the work of both
+** @param a: The vector to apply sine and cosine to
+** @param s: Receives the component-wise sine of a
+** @param c: Receives the component-wise cosine of a
+** @returns: N/A
+*/
+MVLADEF void v4d_sincos(v4d_t a, v4d_t *s, v4d_t *c);
+
 /*
 ** Calculates the magnitude (length) of a 4D double vector
 ** @param a: The vector to find the length of
@@ -1493,6 +2618,60 @@ MVLADEF double v4d_len(v4d_t a);
 */
 MVLADEF double v4d_sqr_len(v4d_t a);
 
+/*
+** Calculates the dot product of two 4D double vectors
+** @param a: The first vector
+** @param b: The second vector
+** @returns: The sum of the component-wise products of a and b
+*/
+MVLADEF double v4d_dot(v4d_t a, v4d_t b);
+
+/*
+** Scales a 4D double vector to unit length, dividing by its length (the zero vector stays zero)
+** @param a: The vector to normalize
+** @returns: The unit vector in the direction of a
+*/
+MVLADEF v4d_t v4d_normalize(v4d_t a);
+
+/*
+** Scales a 4D double vector to unit length with rsqrtd_fast, a few ulp less accurate than v4d_normalize
+** @param a: The vector to normalize
+** @returns: The unit vector in the direction of a (the zero vector stays zero)
+*/
+MVLADEF v4d_t v4d_normalize_fast(v4d_t a);
+
+/*
+** Calculates the distance between two 4D double vectors
+** @param a: The first point
+** @param b: The second point
+** @returns: The length of a - b
+*/
+MVLADEF double v4d_dist(v4d_t a, v4d_t b);
+
+/*
+** Calculates the squared distance between two 4D double vectors
+** @param a: The first point
+** @param b: The second point
+** @returns: The squared length of a - b
+*/
+MVLADEF double v4d_sqr_dist(v4d_t a, v4d_t b);
+
+/*
+** Projects a 4D double vector onto another
+** @param a: The vector to project
+** @param b: The vector to project onto (a zero b gives the zero vector)
+** @returns: The component of a along b, b * dot(a, b) / dot(b, b)
+*/
+MVLADEF v4d_t v4d_project(v4d_t a, v4d_t b);
+
+/*
+** Reflects a 4D double vector off a surface
+** @param a: The incident vector
+** @param n: The unit normal of the surface
+** @returns: a - 2 * dot(a, n) * n
+*/
+MVLADEF v4d_t v4d_reflect(v4d_t a, v4d_t n);
+
 /*
 ** Prints the components of a 4D double vector
 ** @param a: The vector to print
@@ -1500,95 +2679,8184 @@ MVLADEF double v4d_sqr_len(v4d_t a);
 */
 MVLADEF void v4d_print(v4d_t a);
 
-// -----------------------------------------
+/*
+** Formats the components of a 4D double vector the way v4d_print prints them,
+** each component in the fewest digits that read back to the same value
+** @param a: The vector to format
+** @param buf: The buffer to write to, MVLA_FORMAT_MAX bytes are always enough
+** @returns: The length written, not counting the terminating NUL
+*/
+MVLADEF size_t v4d_format(v4d_t a, char *buf);
 
-#endif // MVLA_H
+// -----------------------------------------
 
 /*
-** HEADER ONLY IMPLEMENTATION
+** MATRIX FUNCTION PROTOTYPES
 */
 
-#ifdef MVLA_IMPLEMENTATION
+// mat2x2f_t
 
-// -----------------------------------------
+/*
+** Creates a 2x2 float matrix from its columns
+** @param c0: Column 0 of the matrix
+** @param c1: Column 1 of the matrix
+** @returns: A new 2x2 float matrix
+*/
+MVLADEF mat2x2f_t mat2x2f(v2f_t c0, v2f_t c1);
 
-MVLAIMPL float randf(void) {
-  // assume we have seeded srand first to use rand
-  return ((float) rand()) /
-         ((float) RAND_MAX);
-}
+/*
+** Creates the 2x2 float identity matrix
+** @returns: The identity matrix
+*/
+MVLADEF mat2x2f_t mat2x2f_identity(void);
 
-MVLAIMPL double randd(void) {
-  return ((double) rand()) /
-         ((double) RAND_MAX);
-}
+/*
+** Multiplies two 2x2 float matrices
+** @param a: The left matrix
+** @param b: The right matrix, applied first when the product transforms a vector
+** @returns: The matrix product a * b
+*/
+MVLADEF mat2x2f_t mat2x2f_mul(mat2x2f_t a, mat2x2f_t b);
 
-MVLAIMPL float lerpf(float a, float b, float t) {
-  return a + ((b - a) * t);
-}
+/*
+** Multiplies a 2x2 float matrix by a column vector
+** @param m: The matrix
+** @param v: The vector to transform
+** @returns: The vector m * v
+*/
+MVLADEF v2f_t mat2x2f_mul_v2f(mat2x2f_t m, v2f_t v);
 
-MVLAIMPL double lerpd(double a, double b, double t) {
-  return a + ((b - a) * t);
-}
+/*
+** Transposes a 2x2 float matrix
+** @param m: The matrix to transpose
+** @returns: The matrix with rows and columns swapped
+*/
+MVLADEF mat2x2f_t mat2x2f_transpose(mat2x2f_t m);
 
-MVLAIMPL signed int mini(signed int a, signed int b) {
-  return (a < b) ? a : b;
-}
+/*
+** Calculates the determinant of a 2x2 float matrix
+** @param m: The matrix
+** @returns: The determinant of m
+*/
+MVLADEF float mat2x2f_det(mat2x2f_t m);
 
-MVLAIMPL signed int maxi(signed int a, signed int b) {
-  return (a < b) ? b : a;
-}
+/*
+** Inverts a 2x2 float matrix
+** @param m: The matrix to invert
+** @returns: The inverse of m, or the zero matrix if m is singular
+*/
+MVLADEF mat2x2f_t mat2x2f_inverse(mat2x2f_t m);
 
-MVLAIMPL unsigned int minu(unsigned int a, unsigned int b) {
-  return (a < b) ? a : b;
-}
+/*
+** Prints the rows of a 2x2 float matrix
+** @param m: The matrix to print
+** @returns: N/A
+*/
+MVLADEF void mat2x2f_print(mat2x2f_t m);
 
-MVLAIMPL unsigned int maxu(unsigned int a, unsigned int b) {
-  return (a < b) ? b : a;
-}
+// mat2x2d_t
 
-// -----------------------------------------
+/*
+** Creates a 2x2 double matrix from its columns
+** @param c0: Column 0 of the matrix
+** @param c1: Column 1 of the matrix
+** @returns: A new 2x2 double matrix
+*/
+MVLADEF mat2x2d_t mat2x2d(v2d_t c0, v2d_t c1);
 
-MVLAIMPL v2i_t v2i(signed int x, signed int y) {
-  v2i_t vec;
-  vec.x = x;
-  vec.y = y;
-  return vec;
-}
+/*
+** Creates the 2x2 double identity matrix
+** @returns: The identity matrix
+*/
+MVLADEF mat2x2d_t mat2x2d_identity(void);
 
-MVLAIMPL v2i_t v2ii(signed int x) { 
-  return v2i(x, x); 
-}
+/*
+** Multiplies two 2x2 double matrices
+** @param a: The left matrix
+** @param b: The right matrix, applied first when the product transforms a vector
+** @returns: The matrix product a * b
+*/
+MVLADEF mat2x2d_t mat2x2d_mul(mat2x2d_t a, mat2x2d_t b);
 
-MVLAIMPL v2i_t v2i_add(v2i_t a, v2i_t b) {
-  a.x += b.x;
-  a.y += b.y;
-  return a;
-}
+/*
+** Multiplies a 2x2 double matrix by a column vector
+** @param m: The matrix
+** @param v: The vector to transform
+** @returns: The vector m * v
+*/
+MVLADEF v2d_t mat2x2d_mul_v2d(mat2x2d_t m, v2d_t v);
 
-MVLAIMPL v2i_t v2i_sub(v2i_t a, v2i_t b) {
-  a.x -= b.x;
-  a.y -= b.y;
-  return a;
-}
+/*
+** Transposes a 2x2 double matrix
+** @param m: The matrix to transpose
+** @returns: The matrix with rows and columns swapped
+*/
+MVLADEF mat2x2d_t mat2x2d_transpose(mat2x2d_t m);
 
-MVLAIMPL v2i_t v2i_mul(v2i_t a, v2i_t b) {
-  a.x *= b.x;
-  a.y *= b.y;
-  return a;
-}
+/*
+** Calculates the determinant of a 2x2 double matrix
+** @param m: The matrix
+** @returns: The determinant of m
+*/
+MVLADEF double mat2x2d_det(mat2x2d_t m);
 
-MVLAIMPL v2i_t v2i_div(v2i_t a, v2i_t b) {
-  a.x /= b.x;
-  a.y /= b.y;
-  return a;
-}
+/*
+** Inverts a 2x2 double matrix
+** @param m: The matrix to invert
+** @returns: The inverse of m, or the zero matrix if m is singular
+*/
+MVLADEF mat2x2d_t mat2x2d_inverse(mat2x2d_t m);
 
-MVLAIMPL v2i_t v2i_min(v2i_t a, v2i_t b) {
-  a.x = mini(a.x, b.x);
-  a.y = mini(a.y, b.y);
-  return a;
-}
+/*
+** Prints the rows of a 2x2 double matrix
+** @param m: The matrix to print
+** @returns: N/A
+*/
+MVLADEF void mat2x2d_print(mat2x2d_t m);
+
+// mat3x3f_t
+
+/*
+** Creates a 3x3 float matrix from its columns
+** @param c0: Column 0 of the matrix
+** @param c1: Column 1 of the matrix
+** @param c2: Column 2 of the matrix
+** @returns: A new 3x3 float matrix
+*/
+MVLADEF mat3x3f_t mat3x3f(v3f_t c0, v3f_t c1, v3f_t c2);
+
+/*
+** Creates the 3x3 float identity matrix
+** @returns: The identity matrix
+*/
+MVLADEF mat3x3f_t mat3x3f_identity(void);
+
+/*
+** Multiplies two 3x3 float matrices
+** @param a: The left matrix
+** @param b: The right matrix, applied first when the product transforms a vector
+** @returns: The matrix product a * b
+*/
+MVLADEF mat3x3f_t mat3x3f_mul(mat3x3f_t a, mat3x3f_t b);
+
+/*
+** Multiplies a 3x3 float matrix by a column vector
+** @param m: The matrix
+** @param v: The vector to transform
+** @returns: The vector m * v
+*/
+MVLADEF v3f_t mat3x3f_mul_v3f(mat3x3f_t m, v3f_t v);
+
+/*
+** Transposes a 3x3 float matrix
+** @param m: The matrix to transpose
+** @returns: The matrix with rows and columns swapped
+*/
+MVLADEF mat3x3f_t mat3x3f_transpose(mat3x3f_t m);
+
+/*
+** Calculates the determinant of a 3x3 float matrix
+** @param m: The matrix
+** @returns: The determinant of m
+*/
+MVLADEF float mat3x3f_det(mat3x3f_t m);
+
+/*
+** Inverts a 3x3 float matrix
+** @param m: The matrix to invert
+** @returns: The inverse of m, or the zero matrix if m is singular
+*/
+MVLADEF mat3x3f_t mat3x3f_inverse(mat3x3f_t m);
+
+/*
+** Prints the rows of a 3x3 float matrix
+** @param m: The matrix to print
+** @returns: N/A
+*/
+MVLADEF void mat3x3f_print(mat3x3f_t m);
+
+// mat3x3d_t
+
+/*
+** Creates a 3x3 double matrix from its columns
+** @param c0: Column 0 of the matrix
+** @param c1: Column 1 of the matrix
+** @param c2: Column 2 of the matrix
+** @returns: A new 3x3 double matrix
+*/
+MVLADEF mat3x3d_t mat3x3d(v3d_t c0, v3d_t c1, v3d_t c2);
+
+/*
+** Creates the 3x3 double identity matrix
+** @returns: The identity matrix
+*/
+MVLADEF mat3x3d_t mat3x3d_identity(void);
+
+/*
+** Multiplies two 3x3 double matrices
+** @param a: The left matrix
+** @param b: The right matrix, applied first when the product transforms a vector
+** @returns: The matrix product a * b
+*/
+MVLADEF mat3x3d_t mat3x3d_mul(mat3x3d_t a, mat3x3d_t b);
+
+/*
+** Multiplies a 3x3 double matrix by a column vector
+** @param m: The matrix
+** @param v: The vector to transform
+** @returns: The vector m * v
+*/
+MVLADEF v3d_t mat3x3d_mul_v3d(mat3x3d_t m, v3d_t v);
+
+/*
+** Transposes a 3x3 double matrix
+** @param m: The matrix to transpose
+** @returns: The matrix with rows and columns swapped
+*/
+MVLADEF mat3x3d_t mat3x3d_transpose(mat3x3d_t m);
+
+/*
+** Calculates the determinant of a 3x3 double matrix
+** @param m: The matrix
+** @returns: The determinant of m
+*/
+MVLADEF double mat3x3d_det(mat3x3d_t m);
+
+/*
+** Inverts a 3x3 double matrix
+** @param m: The matrix to invert
+** @returns: The inverse of m, or the zero matrix if m is singular
+*/
+MVLADEF mat3x3d_t mat3x3d_inverse(mat3x3d_t m);
+
+/*
+** Prints the rows of a 3x3 double matrix
+** @param m: The matrix to print
+** @returns: N/A
+*/
+MVLADEF void mat3x3d_print(mat3x3d_t m);
+
+// mat4x4f_t
+
+/*
+** Creates a 4x4 float matrix from its columns
+** @param c0: Column 0 of the matrix
+** @param c1: Column 1 of the matrix
+** @param c2: Column 2 of the matrix
+** @param c3: Column 3 of the matrix
+** @returns: A new 4x4 float matrix
+*/
+MVLADEF mat4x4f_t mat4x4f(v4f_t c0, v4f_t c1, v4f_t c2, v4f_t c3);
+
+/*
+** Creates the 4x4 float identity matrix
+** @returns: The identity matrix
+*/
+MVLADEF mat4x4f_t mat4x4f_identity(void);
+
+/*
+** Multiplies two 4x4 float matrices
+** @param a: The left matrix
+** @param b: The right matrix, applied first when the product transforms a vector
+** @returns: The matrix product a * b
+*/
+MVLADEF mat4x4f_t mat4x4f_mul(mat4x4f_t a, mat4x4f_t b);
+
+/*
+** Multiplies a 4x4 float matrix by a column vector
+** @param m: The matrix
+** @param v: The vector to transform
+** @returns: The vector m * v
+*/
+MVLADEF v4f_t mat4x4f_mul_v4f(mat4x4f_t m, v4f_t v);
+
+/*
+** Transposes a 4x4 float matrix
+** @param m: The matrix to transpose
+** @returns: The matrix with rows and columns swapped
+*/
+MVLADEF mat4x4f_t mat4x4f_transpose(mat4x4f_t m);
+
+/*
+** Calculates the determinant of a 4x4 float matrix
+** @param m: The matrix
+** @returns: The determinant of m
+*/
+MVLADEF float mat4x4f_det(mat4x4f_t m);
+
+/*
+** Inverts a 4x4 float matrix
+** @param m: The matrix to invert
+** @returns: The inverse of m, or the zero matrix if m is singular
+*/
+MVLADEF mat4x4f_t mat4x4f_inverse(mat4x4f_t m);
+
+/*
+** Inverts a rigid 4x4 float matrix, a rotation followed by a translation, by
+** transposing the rotation instead of solving the general inverse
+** @param m: The rigid matrix to invert, its bottom row must be (0, 0, 0, 1)
+** @returns: The inverse of m, meaningless if m is not rigid
+*/
+MVLADEF mat4x4f_t mat4x4f_inverse_rigid(mat4x4f_t m);
+
+/*
+** Prints the rows of a 4x4 float matrix
+** @param m: The matrix to print
+** @returns: N/A
+*/
+MVLADEF void mat4x4f_print(mat4x4f_t m);
+
+// mat4x4d_t
+
+/*
+** Creates a 4x4 double matrix from its columns
+** @param c0: Column 0 of the matrix
+** @param c1: Column 1 of the matrix
+** @param c2: Column 2 of the matrix
+** @param c3: Column 3 of the matrix
+** @returns: A new 4x4 double matrix
+*/
+MVLADEF mat4x4d_t mat4x4d(v4d_t c0, v4d_t c1, v4d_t c2, v4d_t c3);
+
+/*
+** Creates the 4x4 double identity matrix
+** @returns: The identity matrix
+*/
+MVLADEF mat4x4d_t mat4x4d_identity(void);
+
+/*
+** Multiplies two 4x4 double matrices
+** @param a: The left matrix
+** @param b: The right matrix, applied first when the product transforms a vector
+** @returns: The matrix product a * b
+*/
+MVLADEF mat4x4d_t mat4x4d_mul(mat4x4d_t a, mat4x4d_t b);
+
+/*
+** Multiplies a 4x4 double matrix by a column vector
+** @param m: The matrix
+** @param v: The vector to transform
+** @returns: The vector m * v
+*/
+MVLADEF v4d_t mat4x4d_mul_v4d(mat4x4d_t m, v4d_t v);
+
+/*
+** Transposes a 4x4 double matrix
+** @param m: The matrix to transpose
+** @returns: The matrix with rows and columns swapped
+*/
+MVLADEF mat4x4d_t mat4x4d_transpose(mat4x4d_t m);
+
+/*
+** Calculates the determinant of a 4x4 double matrix
+** @param m: The matrix
+** @returns: The determinant of m
+*/
+MVLADEF double mat4x4d_det(mat4x4d_t m);
+
+/*
+** Inverts a 4x4 double matrix
+** @param m: The matrix to invert
+** @returns: The inverse of m, or the zero matrix if m is singular
+*/
+MVLADEF mat4x4d_t mat4x4d_inverse(mat4x4d_t m);
+
+/*
+** Inverts a rigid 4x4 double matrix, a rotation followed by a translation, by
+** transposing the rotation instead of solving the general inverse
+** @param m: The rigid matrix to invert, its bottom row must be (0, 0, 0, 1)
+** @returns: The inverse of m, meaningless if m is not rigid
+*/
+MVLADEF mat4x4d_t mat4x4d_inverse_rigid(mat4x4d_t m);
+
+/*
+** Prints the rows of a 4x4 double matrix
+** @param m: The matrix to print
+** @returns: N/A
+*/
+MVLADEF void mat4x4d_print(mat4x4d_t m);
+
+// -----------------------------------------
+
+/*
+** DISPATCH FUNCTION PROTOTYPES
+**
+** Batch functions run the best kernels the CPU supports (AVX-512, AVX2+FMA,
+** SSE2 or scalar), detected once on first use. Setting the environment
+** variable MVLA_TIER to scalar, sse2, avx2 or avx512 before that caps it.
+*/
+
+/*
+** Finds the highest tier both the CPU and this build support
+** @returns: The best available tier
+*/
+MVLADEF mvla_tier_t mvla_tier_detect(void);
+
+/*
+** Gets the tier the batch functions are currently bound to
+** @returns: The active tier
+*/
+MVLADEF mvla_tier_t mvla_tier_get(void);
+
+/*
+** Binds the batch functions to a tier, lowered to the best available one if
+** unsupported. Must not run while batch functions are executing on any
+** thread, including the workers of mvla_parallel_for
+** @param tier: The requested tier
+** @returns: The tier actually bound
+*/
+MVLADEF mvla_tier_t mvla_tier_set(mvla_tier_t tier);
+
+/*
+** Names a tier
+** @param tier: The tier to name
+** @returns: "scalar", "sse2", "avx2", "avx512" or "unknown"
+*/
+MVLADEF const char *mvla_tier_name(mvla_tier_t tier);
+
+// -----------------------------------------
+
+/*
+** MEMORY FUNCTION PROTOTYPES
+**
+** The _alloc functions of SoA buffers, dynamic vectors and dense matrices,
+** and the GEMM pack buffers, get their memory from the current allocator.
+** Each block remembers the allocator that made it, so the allocator can be
+** swapped while blocks are alive and their _free functions still return them
+** to the right place. Thread pool internals always use MVLA_MALLOC.
+**
+** Buffers of tens of megabytes and up stream faster from 2MB pages, which
+** cover 512 times the memory per TLB entry. mvla_buffer_alloc maps them
+** directly and reports what the OS granted; mvla_pages_allocator applies the
+** same to mvla's own large allocations.
+**
+** An arena hands out consecutive pieces of one buffer with no per-allocation
+** bookkeeping. mvla_arena_mark and mvla_arena_reset free everything allocated
+** since a mark in one step, which suits per-frame temporaries; installing an
+** arena as the allocator routes mvla's own buffers there too. Arenas are not
+** thread-safe.
+*/
+
+/*
+** Sets the allocator behind mvla's buffers. Not thread-safe against
+** allocations running at the same time
+** @param allocator: The allocator, copied, or NULL for the default built on MVLA_MALLOC
+** @returns: N/A
+*/
+MVLADEF void mvla_allocator_set(const mvla_allocator_t *allocator);
+
+/*
+** Gets the allocator behind mvla's buffers
+** @returns: A copy of the current allocator
+*/
+MVLADEF mvla_allocator_t mvla_allocator_get(void);
+
+/*
+** Allocates an arena with its own buffer
+** @param size: The capacity in bytes
+** @returns: The arena, or one with NULL base and no capacity on failure
+*/
+MVLADEF mvla_arena_t mvla_arena_alloc(size_t size);
+
+/*
+** Wraps caller owned memory as an arena
+** @param buffer: The memory to hand out, not freed by the arena
+** @param size: The size of buffer in bytes
+** @returns: The arena over buffer
+*/
+MVLADEF mvla_arena_t mvla_arena_wrap(void *buffer, size_t size);
+
+/*
+** Frees an arena allocated by mvla_arena_alloc, a wrapped buffer is left alone
+** @param arena: The arena to free, its base is reset to NULL
+** @returns: N/A
+*/
+MVLADEF void mvla_arena_free(mvla_arena_t *arena);
+
+/*
+** Takes the next block out of an arena
+** @param arena: The arena to allocate from
+** @param size: The size of the block in bytes
+** @param align: The alignment of the block, a power of two
+** @returns: The block, or NULL if the arena is out of room or align is not a power of two
+*/
+MVLADEF void *mvla_arena_push(mvla_arena_t *arena, size_t size, size_t align);
+
+/*
+** Records the current fill level of an arena
+** @param arena: The arena to mark
+** @returns: The mark to pass to mvla_arena_reset
+*/
+MVLADEF size_t mvla_arena_mark(const mvla_arena_t *arena);
+
+/*
+** Frees every block allocated since a mark at once
+** @param arena: The arena to roll back
+** @param mark: A mark from mvla_arena_mark, 0 to empty the arena
+** @returns: N/A
+*/
+MVLADEF void mvla_arena_reset(mvla_arena_t *arena, size_t mark);
+
+/*
+** Makes an allocator that takes blocks from an arena and never frees them
+** @param arena: The arena to allocate from, must outlive the allocator
+** @returns: The allocator to pass to mvla_allocator_set
+*/
+MVLADEF mvla_allocator_t mvla_arena_allocator(mvla_arena_t *arena);
+
+/*
+** Maps a large buffer with the biggest pages on offer up to a limit: reserved
+** huge pages, then base pages marked for transparent huge pages, then base
+** pages, then the heap. Mapped buffers are MVLA_HUGE_PAGE_SIZE aligned and
+** zeroed, heap ones MVLA_SOA_ALIGN aligned and uninitialized
+** @param size: The size in bytes
+** @param best: The largest backing to try, MVLA_PAGES_SMALL also opts out of transparent huge pages
+** @returns: The buffer and the backing it got, or NULL data and no size on failure
+*/
+MVLADEF mvla_buffer_t mvla_buffer_alloc(size_t size, mvla_pages_t best);
+
+/*
+** Frees a buffer allocated by mvla_buffer_alloc
+** @param buffer: The buffer to free, its data is reset to NULL
+** @returns: N/A
+*/
+MVLADEF void mvla_buffer_free(mvla_buffer_t *buffer);
+
+/*
+** Counts the bytes of a buffer backed by huge pages right now. Transparent
+** huge pages are only promoted as the buffer is touched, and only where the
+** kernel finds free 2MB frames, so this reads /proc/self/smaps on Linux
+** @param buffer: The buffer to look at
+** @returns: The bytes on huge pages, 0 where the OS can't tell
+*/
+MVLADEF size_t mvla_buffer_huge_bytes(const mvla_buffer_t *buffer);
+
+/*
+** Names a buffer backing
+** @param pages: The backing to name
+** @returns: "heap", "small", "transparent", "huge" or "unknown"
+*/
+MVLADEF const char *mvla_pages_name(mvla_pages_t pages);
+
+/*
+** Makes an allocator that maps blocks of MVLA_HUGE_PAGE_SIZE or more like
+** mvla_buffer_alloc and takes smaller ones from the default allocator
+** @param best: The largest backing to try for big blocks
+** @returns: The allocator to pass to mvla_allocator_set
+*/
+MVLADEF mvla_allocator_t mvla_pages_allocator(mvla_pages_t best);
+
+// -----------------------------------------
+
+/*
+** FILE FUNCTION PROTOTYPES
+**
+** A vector file is a 4096 byte header followed by the payload, so the payload
+** starts page aligned and mvla_file_open can hand out pointers straight into
+** a mapping of the file instead of parsing it. The header holds the magic
+** "MVLA", a byte order mark, the format version, the element type and layout,
+** the count, the payload offset and alignment, the distance between SoA
+** component arrays and a checksum of the payload. The checksum is Fletcher's
+** over 32-bit words with 64-bit sums, so a writer can build it per component
+** array and join them. Files use the byte order of the machine that wrote
+** them and are rejected on machines with the other one.
+*/
+
+/*
+** Gets the size of one element of a vector file type
+** @param type: The element type
+** @returns: The size in bytes (12 for MVLA_TYPE_V3F), 0 for an unknown type
+*/
+MVLADEF size_t mvla_type_size(mvla_type_t type);
+
+/*
+** Gets the number of components of a vector file type
+** @param type: The element type
+** @returns: The number of scalars per element (16 for MVLA_TYPE_MAT4X4F), 0 for an unknown type
+*/
+MVLADEF size_t mvla_type_components(mvla_type_t type);
+
+/*
+** Names a vector file status
+** @param status: The status to name
+** @returns: A short description, "unknown" for values outside mvla_file_status_t
+*/
+MVLADEF const char *mvla_file_status_name(mvla_file_status_t status);
+
+/*
+** Creates a vector file to write in chunks, so arrays never need to be in
+** memory at once. AoS files take any number of elements, SoA files lay out
+** their component arrays up front so they need exactly count of them. SoA
+** writes seek, so past 2 GiB on hosts with a 32-bit long they need fseeko with
+** a 64-bit off_t (define _FILE_OFFSET_BITS=64 before any include) and fail
+** with MVLA_FILE_ERR_IO otherwise
+** @param writer: The writer to set up
+** @param path: The file to create or truncate
+** @param type: The element type
+** @param layout: The layout of the file, independent of how chunks are passed in
+** @param count: The number of elements an SoA file will hold, ignored for AoS
+** @returns: MVLA_FILE_OK, or the error that also sticks to the writer
+*/
+MVLADEF mvla_file_status_t mvla_writer_open(mvla_writer_t *writer, const char *path, mvla_type_t type,
+                                            mvla_layout_t layout, size_t count);
+
+/*
+** Appends elements to a vector file from an array of whole elements
+** @param writer: The writer opened by mvla_writer_open
+** @param elements: The elements, laid out like an array of the writer's type (ie... v3f_t *)
+** @param n: The number of elements
+** @returns: MVLA_FILE_OK, or the first error the writer hit
+*/
+MVLADEF mvla_file_status_t mvla_writer_write(mvla_writer_t *writer, const void *elements, size_t n);
+
+/*
+** Appends elements to a vector file from one array per component
+** @param writer: The writer opened by mvla_writer_open
+** @param components: The component arrays (ie... { soa.x, soa.y, soa.z } plus an offset)
+** @param n: The number of elements
+** @returns: MVLA_FILE_OK, or the first error the writer hit
+*/
+MVLADEF mvla_file_status_t mvla_writer_write_soa(mvla_writer_t *writer, const void *const *components, size_t n);
+
+/*
+** Writes the header of a vector file and closes it, a file whose writer hit
+** an error is left without a header and fails to open
+** @param writer: The writer opened by mvla_writer_open
+** @returns: MVLA_FILE_OK, or the first error the writer hit
+*/
+MVLADEF mvla_file_status_t mvla_writer_close(mvla_writer_t *writer);
+
+/*
+** Opens a vector file by mapping it, so data and the component arrays point
+** into the page cache and pages are only read as they are touched. Where
+** mmap doesn't exist the file is read into memory instead
+** @param file: The file to set up
+** @param path: The file to open
+** @param flags: A combination of mvla_file_flags_t
+** @returns: MVLA_FILE_OK, or the reason the file couldn't be opened
+*/
+MVLADEF mvla_file_status_t mvla_file_open(mvla_file_t *file, const char *path, int flags);
+
+/*
+** Gets one component of an opened vector file: an aligned array for SoA
+** files, the component of the first element for AoS files, where the next
+** one is mvla_type_size bytes further
+** @param file: The file opened by mvla_file_open
+** @param component: The component index, 0 for x
+** @returns: The component, NULL past the last component
+*/
+MVLADEF void *mvla_file_component(const mvla_file_t *file, size_t component);
+
+/*
+** Unmaps a vector file opened by mvla_file_open
+** @param file: The file to close, its data is reset to NULL
+** @returns: N/A
+*/
+MVLADEF void mvla_file_close(mvla_file_t *file);
+
+// -----------------------------------------
+
+/*
+** TEXT FUNCTION PROTOTYPES
+**
+** Text holds one element per line with its components separated by commas,
+** semicolons, spaces or tabs (CSV or whitespace separated columns). Floats
+** are written in the fewest digits that read back to the same value, plain
+** from 1e-4 up to 1e16 and with an exponent outside that (1.5e-7, 2e20).
+** Parsing is exact for up to 19 significant digits with a decimal exponent
+** of up to 27 either way, and goes through strtod past that. None of these
+** touch stdio except to write the finished buffers.
+*/
+
+/*
+** Formats a float in the fewest digits that read back to the same value
+** @param a: The value to format
+** @param buf: The buffer to write to, MVLA_FORMAT_MAX bytes are always enough
+** @returns: The length written, not counting the terminating NUL
+*/
+MVLADEF size_t mvla_formatf(float a, char *buf);
+
+/*
+** Formats a double in the fewest digits that read back to the same value
+** @param a: The value to format
+** @param buf: The buffer to write to, MVLA_FORMAT_MAX bytes are always enough
+** @returns: The length written, not counting the terminating NUL
+*/
+MVLADEF size_t mvla_formatd(double a, char *buf);
+
+/*
+** Formats an array as text, one element per line with comma separated
+** components, stopping before the first line that might not fit
+** @param type: The element type (ie... MVLA_TYPE_V3F for an array of v3f_t)
+** @param a: The array of elements
+** @param n: The number of elements
+** @param buf: The buffer to write to, no NUL is added
+** @param cap: The size of the buffer
+** @param len: Receives the number of bytes written
+** @returns: The number of elements formatted
+*/
+MVLADEF size_t mvla_format_n(mvla_type_t type, const void *a, size_t n, char *buf, size_t cap,
+                             size_t *len);
+
+/*
+** Parses lines of numbers into an array, skipping blank lines and stopping at
+** the first line that doesn't hold exactly one element. A last line without
+** a newline is parsed too, so text read in chunks should be cut after a newline
+** @param type: The element type (ie... MVLA_TYPE_V3F for an array of v3f_t)
+** @param text: The text to parse, doesn't need a NUL
+** @param len: The length of the text
+** @param out: The array receiving the elements
+** @param n: The most elements to parse
+** @param used: Receives the number of bytes of text consumed, up to the line that stopped the parse
+** @returns: The number of elements parsed
+*/
+MVLADEF size_t mvla_parse_n(mvla_type_t type, const char *text, size_t len, void *out, size_t n,
+                            size_t *used);
+
+/*
+** Writes an array to a file as text like mvla_format_n, with one fwrite
+** per MVLA_DUMP_CHUNK bytes instead of one call per element
+** @param type: The element type
+** @param a: The array of elements
+** @param n: The number of elements
+** @param file: The file to write to
+** @returns: MVLA_FILE_OK, MVLA_FILE_ERR_IO, MVLA_FILE_ERR_MEMORY or MVLA_FILE_ERR_ARG for an unknown type
+*/
+MVLADEF mvla_file_status_t mvla_dump_n(mvla_type_t type, const void *a, size_t n, FILE *file);
+
+#if defined(__unix__) || defined(__APPLE__)
+/*
+** Writes an array to a file descriptor as text like mvla_dump_n, bypassing stdio
+** @param type: The element type
+** @param a: The array of elements
+** @param n: The number of elements
+** @param fd: The file descriptor to write to
+** @returns: MVLA_FILE_OK, MVLA_FILE_ERR_IO, MVLA_FILE_ERR_MEMORY or MVLA_FILE_ERR_ARG for an unknown type
+*/
+MVLADEF mvla_file_status_t mvla_dump_fd(mvla_type_t type, const void *a, size_t n, int fd);
+#endif // __unix__
+
+// -----------------------------------------
+
+/*
+** THREADING FUNCTION PROTOTYPES
+**
+** Batch, transform, reduction and dense matrix functions split large inputs
+** into ranges run by a built-in pool of worker threads, created on first use.
+** Each worker owns a deque of ranges and idle workers steal the oldest, largest
+** range from another's, so uneven ranges still balance. A thread waiting on a
+** parallel loop runs ranges too, which makes nested loops safe. Define
+** MVLA_NO_THREADS to build without the pool, or plug in an executor to run the
+** loops on threads the application already manages.
+*/
+
+/*
+** Sets how many threads the parallel loops may use, the calling thread
+** included. The pool's n - 1 workers are shared by every caller, so calls from
+** several threads at once or from inside a loop never add threads past that.
+** Stops the pool, which restarts with the new count on next use. Not
+** thread-safe against parallel loops running at the same time
+** @param n: The thread count, 0 for one per online CPU (the default) or 1 to stay on the calling thread
+** @returns: N/A
+*/
+MVLADEF void mvla_threads_set(int n);
+
+/*
+** Gets how many threads the parallel loops may use
+** @returns: The thread count, 1 when built without threads
+*/
+MVLADEF int mvla_threads_get(void);
+
+/*
+** Runs fn over [0, n) split into ranges that start on multiples of grain and
+** are whole multiples of it long except the last, in parallel on the pool or
+** the executor. Inputs of at most one grain run inline
+** @param n: The length of the range
+** @param grain: The smallest range worth a task, 0 is taken as 1
+** @param fn: The function called with each range, possibly from several threads at once
+** @param ctx: The pointer passed to fn
+** @returns: N/A, once every range has run
+*/
+MVLADEF void mvla_parallel_for(size_t n, size_t grain, mvla_range_fn_t fn, void *ctx);
+
+/*
+** Hands the parallel loops to an external executor instead of the built-in
+** pool, whose threads are stopped. Not thread-safe against parallel loops
+** running at the same time
+** @param executor: The executor, copied, or NULL to go back to the pool
+** @returns: N/A
+*/
+MVLADEF void mvla_executor_set(const mvla_executor_t *executor);
+
+// -----------------------------------------
+
+/*
+** 2D VECTOR BATCH FUNCTION PROTOTYPES
+**
+** Each batch function applies its scalar namesake to n contiguous vectors.
+** Inputs and outputs are plain arrays with no alignment requirement.
+*/
+
+// v2i_t
+
+/*
+** Adds two arrays of 2D integer vectors element-wise
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the sums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2i_add_n(const v2i_t *a, const v2i_t *b, v2i_t *out, size_t n);
+
+/*
+** Subtracts an array of 2D integer vectors from another element-wise
+** @param a: The array of vectors to subtract from
+** @param b: The array of vectors to subtract
+** @param out: The array receiving the differences (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2i_sub_n(const v2i_t *a, const v2i_t *b, v2i_t *out, size_t n);
+
+/*
+** Multiplies two arrays of 2D integer vectors component-wise
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the products (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2i_mul_n(const v2i_t *a, const v2i_t *b, v2i_t *out, size_t n);
+
+/*
+** Divides an array of 2D integer vectors by another component-wise
+** @param a: The array of vectors to be divided
+** @param b: The array of vectors to divide by
+** @param out: The array receiving the quotients (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2i_div_n(const v2i_t *a, const v2i_t *b, v2i_t *out, size_t n);
+
+/*
+** Finds the component-wise minimum of two arrays of 2D integer vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the minimums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2i_min_n(const v2i_t *a, const v2i_t *b, v2i_t *out, size_t n);
+
+/*
+** Finds the component-wise maximum of two arrays of 2D integer vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the maximums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2i_max_n(const v2i_t *a, const v2i_t *b, v2i_t *out, size_t n);
+
+// v2u_t
+
+/*
+** Adds two arrays of 2D unsigned integer vectors element-wise
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the sums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2u_add_n(const v2u_t *a, const v2u_t *b, v2u_t *out, size_t n);
+
+/*
+** Subtracts an array of 2D unsigned integer vectors from another element-wise
+** @param a: The array of vectors to subtract from
+** @param b: The array of vectors to subtract
+** @param out: The array receiving the differences (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2u_sub_n(const v2u_t *a, const v2u_t *b, v2u_t *out, size_t n);
+
+/*
+** Multiplies two arrays of 2D unsigned integer vectors component-wise
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the products (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2u_mul_n(const v2u_t *a, const v2u_t *b, v2u_t *out, size_t n);
+
+/*
+** Divides an array of 2D unsigned integer vectors by another component-wise
+** @param a: The array of vectors to be divided
+** @param b: The array of vectors to divide by
+** @param out: The array receiving the quotients (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2u_div_n(const v2u_t *a, const v2u_t *b, v2u_t *out, size_t n);
+
+/*
+** Finds the component-wise minimum of two arrays of 2D unsigned integer vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the minimums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2u_min_n(const v2u_t *a, const v2u_t *b, v2u_t *out, size_t n);
+
+/*
+** Finds the component-wise maximum of two arrays of 2D unsigned integer vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the maximums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2u_max_n(const v2u_t *a, const v2u_t *b, v2u_t *out, size_t n);
+
+// v2f_t
+
+/*
+** Adds two arrays of 2D float vectors element-wise
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the sums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2f_add_n(const v2f_t *a, const v2f_t *b, v2f_t *out, size_t n);
+
+/*
+** Subtracts an array of 2D float vectors from another element-wise
+** @param a: The array of vectors to subtract from
+** @param b: The array of vectors to subtract
+** @param out: The array receiving the differences (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2f_sub_n(const v2f_t *a, const v2f_t *b, v2f_t *out, size_t n);
+
+/*
+** Multiplies two arrays of 2D float vectors component-wise
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the products (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2f_mul_n(const v2f_t *a, const v2f_t *b, v2f_t *out, size_t n);
+
+/*
+** Multiplies two arrays of 2D float vectors component-wise and adds a third (see v2f_fma)
+** @param a: The first array of vectors to multiply
+** @param b: The second array of vectors to multiply
+** @param c: The array of vectors to add
+** @param out: The array receiving the results (may alias a, b or c)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2f_fma_n(const v2f_t *a, const v2f_t *b, const v2f_t *c, v2f_t *out, size_t n);
+
+/*
+** Multiplies two arrays of 2D float vectors component-wise and subtracts a third (see v2f_fms)
+** @param a: The first array of vectors to multiply
+** @param b: The second array of vectors to multiply
+** @param c: The array of vectors to subtract
+** @param out: The array receiving the results (may alias a, b or c)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2f_fms_n(const v2f_t *a, const v2f_t *b, const v2f_t *c, v2f_t *out, size_t n);
+
+/*
+** Divides an array of 2D float vectors by another component-wise
+** @param a: The array of vectors to be divided
+** @param b: The array of vectors to divide by
+** @param out: The array receiving the quotients (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2f_div_n(const v2f_t *a, const v2f_t *b, v2f_t *out, size_t n);
+
+/*
+** Finds the component-wise minimum of two arrays of 2D float vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the minimums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2f_min_n(const v2f_t *a, const v2f_t *b, v2f_t *out, size_t n);
+
+/*
+** Finds the component-wise maximum of two arrays of 2D float vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the maximums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2f_max_n(const v2f_t *a, const v2f_t *b, v2f_t *out, size_t n);
+
+/*
+** Raises each component of an array of 2D float vectors to a specified exponent
+** @param a: The array of vectors to raise to the power
+** @param exp: The exponent to apply to each component
+** @param out: The array receiving the powers (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2f_poww_n(const v2f_t *a, float exp, v2f_t *out, size_t n);
+
+/*
+** Raises each component of an array of 2D float vectors to the power of the corresponding component in another array
+** @param a: The array of vectors to raise to the power
+** @param exp: The array of vectors containing the exponents
+** @param out: The array receiving the powers (may alias a or exp)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2f_pow_n(const v2f_t *a, const v2f_t *exp, v2f_t *out, size_t n);
+
+/*
+** Calculates the component-wise square root of an array of 2D float vectors
+** @param a: The array of vectors
+** @param out: The array receiving the square roots (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2f_sqrt_n(const v2f_t *a, v2f_t *out, size_t n);
+
+/*
+** Calculates the component-wise exponential of an array of 2D float vectors
+** @param a: The array of vectors
+** @param out: The array receiving the exponentials (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2f_exp_n(const v2f_t *a, v2f_t *out, size_t n);
+
+/*
+** Calculates the component-wise sine of an array of 2D float vectors
+** @param a: The array of vectors
+** @param out: The array receiving the sines (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2f_sin_n(const v2f_t *a, v2f_t *out, size_t n);
+
+/*
+** Calculates the component-wise cosine of an array of 2D float vectors
+** @param a: The array of vectors
+** @param out: The array receiving the cosines (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2f_cos_n(const v2f_t *a, v2f_t *out, size_t n);
+
+/*
+** Calculates the component-wise tangent of an array of 2D float vectors
+** @param a: The array of vectors
+** @param out: The array receiving the tangents (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2f_tan_n(const v2f_t *a, v2f_t *out, size_t n);
+
+/*
+** Calculates the component-wise sine and cosine of an array of 2D float vectors
+** @param a: The array of vectors
+** @param s: The array receiving the sines (may alias a)
+** @param c: The array receiving the cosines (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2f_sincos_n(const v2f_t *a, v2f_t *s, v2f_t *c, size_t n);
+
+/*
+** Calculates the magnitude (length) of each vector in an array of 2D float vectors
+** @param a: The array of vectors
+** @param out: The array receiving the n lengths
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2f_len_n(const v2f_t *a, float *out, size_t n);
+
+/*
+** Calculates the squared magnitude of each vector in an array of 2D float vectors
+** @param a: The array of vectors
+** @param out: The array receiving the n squared lengths
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2f_sqr_len_n(const v2f_t *a, float *out, size_t n);
+
+/*
+** Calculates the dot product of each pair of vectors in two arrays of 2D float vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the n dot products
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2f_dot_n(const v2f_t *a, const v2f_t *b, float *out, size_t n);
+
+/*
+** Calculates the 2D cross product of each pair of vectors in two arrays of 2D float vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the n cross products
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2f_cross_n(const v2f_t *a, const v2f_t *b, float *out, size_t n);
+
+/*
+** Normalizes each vector in an array of 2D float vectors (see v2f_normalize)
+** @param a: The array of vectors
+** @param out: The array receiving the unit vectors (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2f_normalize_n(const v2f_t *a, v2f_t *out, size_t n);
+
+/*
+** Normalizes each vector in an array of 2D float vectors with the fast reciprocal square root (see v2f_normalize_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the unit vectors (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2f_normalize_fast_n(const v2f_t *a, v2f_t *out, size_t n);
+
+/*
+** Calculates the distance between each pair of vectors in two arrays of 2D float vectors
+** @param a: The first array of points
+** @param b: The second array of points
+** @param out: The array receiving the n distances
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2f_dist_n(const v2f_t *a, const v2f_t *b, float *out, size_t n);
+
+/*
+** Calculates the squared distance between each pair of vectors in two arrays of 2D float vectors
+** @param a: The first array of points
+** @param b: The second array of points
+** @param out: The array receiving the n squared distances
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2f_sqr_dist_n(const v2f_t *a, const v2f_t *b, float *out, size_t n);
+
+/*
+** Projects each vector in an array of 2D float vectors onto the corresponding vector in another (see v2f_project)
+** @param a: The array of vectors to project
+** @param b: The array of vectors to project onto
+** @param out: The array receiving the projections (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2f_project_n(const v2f_t *a, const v2f_t *b, v2f_t *out, size_t n);
+
+/*
+** Reflects each vector in an array of 2D float vectors off the corresponding unit normal (see v2f_reflect)
+** @param a: The array of incident vectors
+** @param n: The array of unit normals
+** @param out: The array receiving the reflections (may alias a or n)
+** @param count: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2f_reflect_n(const v2f_t *a, const v2f_t *n, v2f_t *out, size_t count);
+
+// v2d_t
+
+/*
+** Adds two arrays of 2D double vectors element-wise
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the sums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2d_add_n(const v2d_t *a, const v2d_t *b, v2d_t *out, size_t n);
+
+/*
+** Subtracts an array of 2D double vectors from another element-wise
+** @param a: The array of vectors to subtract from
+** @param b: The array of vectors to subtract
+** @param out: The array receiving the differences (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2d_sub_n(const v2d_t *a, const v2d_t *b, v2d_t *out, size_t n);
+
+/*
+** Multiplies two arrays of 2D double vectors component-wise
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the products (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2d_mul_n(const v2d_t *a, const v2d_t *b, v2d_t *out, size_t n);
+
+/*
+** Multiplies two arrays of 2D double vectors component-wise and adds a third (see v2d_fma)
+** @param a: The first array of vectors to multiply
+** @param b: The second array of vectors to multiply
+** @param c: The array of vectors to add
+** @param out: The array receiving the results (may alias a, b or c)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2d_fma_n(const v2d_t *a, const v2d_t *b, const v2d_t *c, v2d_t *out, size_t n);
+
+/*
+** Multiplies two arrays of 2D double vectors component-wise and subtracts a third (see v2d_fms)
+** @param a: The first array of vectors to multiply
+** @param b: The second array of vectors to multiply
+** @param c: The array of vectors to subtract
+** @param out: The array receiving the results (may alias a, b or c)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2d_fms_n(const v2d_t *a, const v2d_t *b, const v2d_t *c, v2d_t *out, size_t n);
+
+/*
+** Divides an array of 2D double vectors by another component-wise
+** @param a: The array of vectors to be divided
+** @param b: The array of vectors to divide by
+** @param out: The array receiving the quotients (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2d_div_n(const v2d_t *a, const v2d_t *b, v2d_t *out, size_t n);
+
+/*
+** Finds the component-wise minimum of two arrays of 2D double vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the minimums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2d_min_n(const v2d_t *a, const v2d_t *b, v2d_t *out, size_t n);
+
+/*
+** Finds the component-wise maximum of two arrays of 2D double vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the maximums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2d_max_n(const v2d_t *a, const v2d_t *b, v2d_t *out, size_t n);
+
+/*
+** Raises each component of an array of 2D double vectors to a specified exponent
+** @param a: The array of vectors to raise to the power
+** @param exp: The exponent to apply to each component
+** @param out: The array receiving the powers (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2d_poww_n(const v2d_t *a, double exp, v2d_t *out, size_t n);
+
+/*
+** Raises each component of an array of 2D double vectors to the power of the corresponding component in another array
+** @param a: The array of vectors to raise to the power
+** @param exp: The array of vectors containing the exponents
+** @param out: The array receiving the powers (may alias a or exp)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2d_pow_n(const v2d_t *a, const v2d_t *exp, v2d_t *out, size_t n);
+
+/*
+** Calculates the component-wise square root of an array of 2D double vectors
+** @param a: The array of vectors
+** @param out: The array receiving the square roots (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2d_sqrt_n(const v2d_t *a, v2d_t *out, size_t n);
+
+/*
+** Calculates the component-wise exponential of an array of 2D double vectors
+** @param a: The array of vectors
+** @param out: The array receiving the exponentials (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2d_exp_n(const v2d_t *a, v2d_t *out, size_t n);
+
+/*
+** Calculates the component-wise sine of an array of 2D double vectors
+** @param a: The array of vectors
+** @param out: The array receiving the sines (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2d_sin_n(const v2d_t *a, v2d_t *out, size_t n);
+
+/*
+** Calculates the component-wise cosine of an array of 2D double vectors
+** @param a: The array of vectors
+** @param out: The array receiving the cosines (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2d_cos_n(const v2d_t *a, v2d_t *out, size_t n);
+
+/*
+** Calculates the component-wise tangent of an array of 2D double vectors
+** @param a: The array of vectors
+** @param out: The array receiving the tangents (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2d_tan_n(const v2d_t *a, v2d_t *out, size_t n);
+
+/*
+** Calculates the component-wise sine and cosine of an array of 2D double vectors
+** @param a: The array of vectors
+** @param s: The array receiving the sines (may alias a)
+** @param c: The array receiving the cosines (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2d_sincos_n(const v2d_t *a, v2d_t *s, v2d_t *c, size_t n);
+
+/*
+** Calculates the magnitude (length) of each vector in an array of 2D double vectors
+** @param a: The array of vectors
+** @param out: The array receiving the n lengths
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2d_len_n(const v2d_t *a, double *out, size_t n);
+
+/*
+** Calculates the squared magnitude of each vector in an array of 2D double vectors
+** @param a: The array of vectors
+** @param out: The array receiving the n squared lengths
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2d_sqr_len_n(const v2d_t *a, double *out, size_t n);
+
+/*
+** Calculates the dot product of each pair of vectors in two arrays of 2D double vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the n dot products
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2d_dot_n(const v2d_t *a, const v2d_t *b, double *out, size_t n);
+
+/*
+** Calculates the 2D cross product of each pair of vectors in two arrays of 2D double vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the n cross products
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2d_cross_n(const v2d_t *a, const v2d_t *b, double *out, size_t n);
+
+/*
+** Normalizes each vector in an array of 2D double vectors (see v2d_normalize)
+** @param a: The array of vectors
+** @param out: The array receiving the unit vectors (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2d_normalize_n(const v2d_t *a, v2d_t *out, size_t n);
+
+/*
+** Normalizes each vector in an array of 2D double vectors with the fast reciprocal square root (see v2d_normalize_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the unit vectors (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2d_normalize_fast_n(const v2d_t *a, v2d_t *out, size_t n);
+
+/*
+** Calculates the distance between each pair of vectors in two arrays of 2D double vectors
+** @param a: The first array of points
+** @param b: The second array of points
+** @param out: The array receiving the n distances
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2d_dist_n(const v2d_t *a, const v2d_t *b, double *out, size_t n);
+
+/*
+** Calculates the squared distance between each pair of vectors in two arrays of 2D double vectors
+** @param a: The first array of points
+** @param b: The second array of points
+** @param out: The array receiving the n squared distances
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2d_sqr_dist_n(const v2d_t *a, const v2d_t *b, double *out, size_t n);
+
+/*
+** Projects each vector in an array of 2D double vectors onto the corresponding vector in another (see v2d_project)
+** @param a: The array of vectors to project
+** @param b: The array of vectors to project onto
+** @param out: The array receiving the projections (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2d_project_n(const v2d_t *a, const v2d_t *b, v2d_t *out, size_t n);
+
+/*
+** Reflects each vector in an array of 2D double vectors off the corresponding unit normal (see v2d_reflect)
+** @param a: The array of incident vectors
+** @param n: The array of unit normals
+** @param out: The array receiving the reflections (may alias a or n)
+** @param count: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2d_reflect_n(const v2d_t *a, const v2d_t *n, v2d_t *out, size_t count);
+
+// -----------------------------------------
+
+/*
+** 3D VECTOR BATCH FUNCTION PROTOTYPES
+*/
+
+// v3i_t
+
+/*
+** Adds two arrays of 3D integer vectors element-wise
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the sums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3i_add_n(const v3i_t *a, const v3i_t *b, v3i_t *out, size_t n);
+
+/*
+** Subtracts an array of 3D integer vectors from another element-wise
+** @param a: The array of vectors to subtract from
+** @param b: The array of vectors to subtract
+** @param out: The array receiving the differences (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3i_sub_n(const v3i_t *a, const v3i_t *b, v3i_t *out, size_t n);
+
+/*
+** Multiplies two arrays of 3D integer vectors component-wise
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the products (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3i_mul_n(const v3i_t *a, const v3i_t *b, v3i_t *out, size_t n);
+
+/*
+** Divides an array of 3D integer vectors by another component-wise
+** @param a: The array of vectors to be divided
+** @param b: The array of vectors to divide by
+** @param out: The array receiving the quotients (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3i_div_n(const v3i_t *a, const v3i_t *b, v3i_t *out, size_t n);
+
+/*
+** Finds the component-wise minimum of two arrays of 3D integer vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the minimums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3i_min_n(const v3i_t *a, const v3i_t *b, v3i_t *out, size_t n);
+
+/*
+** Finds the component-wise maximum of two arrays of 3D integer vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the maximums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3i_max_n(const v3i_t *a, const v3i_t *b, v3i_t *out, size_t n);
+
+// v3u_t
+
+/*
+** Adds two arrays of 3D unsigned integer vectors element-wise
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the sums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3u_add_n(const v3u_t *a, const v3u_t *b, v3u_t *out, size_t n);
+
+/*
+** Subtracts an array of 3D unsigned integer vectors from another element-wise
+** @param a: The array of vectors to subtract from
+** @param b: The array of vectors to subtract
+** @param out: The array receiving the differences (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3u_sub_n(const v3u_t *a, const v3u_t *b, v3u_t *out, size_t n);
+
+/*
+** Multiplies two arrays of 3D unsigned integer vectors component-wise
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the products (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3u_mul_n(const v3u_t *a, const v3u_t *b, v3u_t *out, size_t n);
+
+/*
+** Divides an array of 3D unsigned integer vectors by another component-wise
+** @param a: The array of vectors to be divided
+** @param b: The array of vectors to divide by
+** @param out: The array receiving the quotients (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3u_div_n(const v3u_t *a, const v3u_t *b, v3u_t *out, size_t n);
+
+/*
+** Finds the component-wise minimum of two arrays of 3D unsigned integer vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the minimums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3u_min_n(const v3u_t *a, const v3u_t *b, v3u_t *out, size_t n);
+
+/*
+** Finds the component-wise maximum of two arrays of 3D unsigned integer vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the maximums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3u_max_n(const v3u_t *a, const v3u_t *b, v3u_t *out, size_t n);
+
+// v3f_t
+
+/*
+** Adds two arrays of 3D float vectors element-wise
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the sums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3f_add_n(const v3f_t *a, const v3f_t *b, v3f_t *out, size_t n);
+
+/*
+** Subtracts an array of 3D float vectors from another element-wise
+** @param a: The array of vectors to subtract from
+** @param b: The array of vectors to subtract
+** @param out: The array receiving the differences (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3f_sub_n(const v3f_t *a, const v3f_t *b, v3f_t *out, size_t n);
+
+/*
+** Multiplies two arrays of 3D float vectors component-wise
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the products (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3f_mul_n(const v3f_t *a, const v3f_t *b, v3f_t *out, size_t n);
+
+/*
+** Multiplies two arrays of 3D float vectors component-wise and adds a third (see v3f_fma)
+** @param a: The first array of vectors to multiply
+** @param b: The second array of vectors to multiply
+** @param c: The array of vectors to add
+** @param out: The array receiving the results (may alias a, b or c)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3f_fma_n(const v3f_t *a, const v3f_t *b, const v3f_t *c, v3f_t *out, size_t n);
+
+/*
+** Multiplies two arrays of 3D float vectors component-wise and subtracts a third (see v3f_fms)
+** @param a: The first array of vectors to multiply
+** @param b: The second array of vectors to multiply
+** @param c: The array of vectors to subtract
+** @param out: The array receiving the results (may alias a, b or c)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3f_fms_n(const v3f_t *a, const v3f_t *b, const v3f_t *c, v3f_t *out, size_t n);
+
+/*
+** Divides an array of 3D float vectors by another component-wise
+** @param a: The array of vectors to be divided
+** @param b: The array of vectors to divide by
+** @param out: The array receiving the quotients (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3f_div_n(const v3f_t *a, const v3f_t *b, v3f_t *out, size_t n);
+
+/*
+** Finds the component-wise minimum of two arrays of 3D float vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the minimums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3f_min_n(const v3f_t *a, const v3f_t *b, v3f_t *out, size_t n);
+
+/*
+** Finds the component-wise maximum of two arrays of 3D float vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the maximums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3f_max_n(const v3f_t *a, const v3f_t *b, v3f_t *out, size_t n);
+
+/*
+** Raises each component of an array of 3D float vectors to a specified exponent
+** @param a: The array of vectors to raise to the power
+** @param exp: The exponent to apply to each component
+** @param out: The array receiving the powers (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3f_poww_n(const v3f_t *a, float exp, v3f_t *out, size_t n);
+
+/*
+** Raises each component of an array of 3D float vectors to the power of the corresponding component in another array
+** @param a: The array of vectors to raise to the power
+** @param exp: The array of vectors containing the exponents
+** @param out: The array receiving the powers (may alias a or exp)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3f_pow_n(const v3f_t *a, const v3f_t *exp, v3f_t *out, size_t n);
+
+/*
+** Calculates the component-wise square root of an array of 3D float vectors
+** @param a: The array of vectors
+** @param out: The array receiving the square roots (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3f_sqrt_n(const v3f_t *a, v3f_t *out, size_t n);
+
+/*
+** Calculates the component-wise exponential of an array of 3D float vectors
+** @param a: The array of vectors
+** @param out: The array receiving the exponentials (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3f_exp_n(const v3f_t *a, v3f_t *out, size_t n);
+
+/*
+** Calculates the component-wise sine of an array of 3D float vectors
+** @param a: The array of vectors
+** @param out: The array receiving the sines (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3f_sin_n(const v3f_t *a, v3f_t *out, size_t n);
+
+/*
+** Calculates the component-wise cosine of an array of 3D float vectors
+** @param a: The array of vectors
+** @param out: The array receiving the cosines (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3f_cos_n(const v3f_t *a, v3f_t *out, size_t n);
+
+/*
+** Calculates the component-wise tangent of an array of 3D float vectors
+** @param a: The array of vectors
+** @param out: The array receiving the tangents (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3f_tan_n(const v3f_t *a, v3f_t *out, size_t n);
+
+/*
+** Calculates the component-wise sine and cosine of an array of 3D float vectors
+** @param a: The array of vectors
+** @param s: The array receiving the sines (may alias a)
+** @param c: The array receiving the cosines (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3f_sincos_n(const v3f_t *a, v3f_t *s, v3f_t *c, size_t n);
+
+/*
+** Calculates the magnitude (length) of each vector in an array of 3D float vectors
+** @param a: The array of vectors
+** @param out: The array receiving the n lengths
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3f_len_n(const v3f_t *a, float *out, size_t n);
+
+/*
+** Calculates the squared magnitude of each vector in an array of 3D float vectors
+** @param a: The array of vectors
+** @param out: The array receiving the n squared lengths
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3f_sqr_len_n(const v3f_t *a, float *out, size_t n);
+
+/*
+** Calculates the dot product of each pair of vectors in two arrays of 3D float vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the n dot products
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3f_dot_n(const v3f_t *a, const v3f_t *b, float *out, size_t n);
+
+/*
+** Calculates the cross product of each pair of vectors in two arrays of 3D float vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the cross products (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3f_cross_n(const v3f_t *a, const v3f_t *b, v3f_t *out, size_t n);
+
+/*
+** Normalizes each vector in an array of 3D float vectors (see v3f_normalize)
+** @param a: The array of vectors
+** @param out: The array receiving the unit vectors (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3f_normalize_n(const v3f_t *a, v3f_t *out, size_t n);
+
+/*
+** Normalizes each vector in an array of 3D float vectors with the fast reciprocal square root (see v3f_normalize_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the unit vectors (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3f_normalize_fast_n(const v3f_t *a, v3f_t *out, size_t n);
+
+/*
+** Calculates the distance between each pair of vectors in two arrays of 3D float vectors
+** @param a: The first array of points
+** @param b: The second array of points
+** @param out: The array receiving the n distances
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3f_dist_n(const v3f_t *a, const v3f_t *b, float *out, size_t n);
+
+/*
+** Calculates the squared distance between each pair of vectors in two arrays of 3D float vectors
+** @param a: The first array of points
+** @param b: The second array of points
+** @param out: The array receiving the n squared distances
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3f_sqr_dist_n(const v3f_t *a, const v3f_t *b, float *out, size_t n);
+
+/*
+** Projects each vector in an array of 3D float vectors onto the corresponding vector in another (see v3f_project)
+** @param a: The array of vectors to project
+** @param b: The array of vectors to project onto
+** @param out: The array receiving the projections (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3f_project_n(const v3f_t *a, const v3f_t *b, v3f_t *out, size_t n);
+
+/*
+** Reflects each vector in an array of 3D float vectors off the corresponding unit normal (see v3f_reflect)
+** @param a: The array of incident vectors
+** @param n: The array of unit normals
+** @param out: The array receiving the reflections (may alias a or n)
+** @param count: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3f_reflect_n(const v3f_t *a, const v3f_t *n, v3f_t *out, size_t count);
+
+// v3d_t
+
+/*
+** Adds two arrays of 3D double vectors element-wise
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the sums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3d_add_n(const v3d_t *a, const v3d_t *b, v3d_t *out, size_t n);
+
+/*
+** Subtracts an array of 3D double vectors from another element-wise
+** @param a: The array of vectors to subtract from
+** @param b: The array of vectors to subtract
+** @param out: The array receiving the differences (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3d_sub_n(const v3d_t *a, const v3d_t *b, v3d_t *out, size_t n);
+
+/*
+** Multiplies two arrays of 3D double vectors component-wise
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the products (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3d_mul_n(const v3d_t *a, const v3d_t *b, v3d_t *out, size_t n);
+
+/*
+** Multiplies two arrays of 3D double vectors component-wise and adds a third (see v3d_fma)
+** @param a: The first array of vectors to multiply
+** @param b: The second array of vectors to multiply
+** @param c: The array of vectors to add
+** @param out: The array receiving the results (may alias a, b or c)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3d_fma_n(const v3d_t *a, const v3d_t *b, const v3d_t *c, v3d_t *out, size_t n);
+
+/*
+** Multiplies two arrays of 3D double vectors component-wise and subtracts a third (see v3d_fms)
+** @param a: The first array of vectors to multiply
+** @param b: The second array of vectors to multiply
+** @param c: The array of vectors to subtract
+** @param out: The array receiving the results (may alias a, b or c)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3d_fms_n(const v3d_t *a, const v3d_t *b, const v3d_t *c, v3d_t *out, size_t n);
+
+/*
+** Divides an array of 3D double vectors by another component-wise
+** @param a: The array of vectors to be divided
+** @param b: The array of vectors to divide by
+** @param out: The array receiving the quotients (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3d_div_n(const v3d_t *a, const v3d_t *b, v3d_t *out, size_t n);
+
+/*
+** Finds the component-wise minimum of two arrays of 3D double vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the minimums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3d_min_n(const v3d_t *a, const v3d_t *b, v3d_t *out, size_t n);
+
+/*
+** Finds the component-wise maximum of two arrays of 3D double vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the maximums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3d_max_n(const v3d_t *a, const v3d_t *b, v3d_t *out, size_t n);
+
+/*
+** Raises each component of an array of 3D double vectors to a specified exponent
+** @param a: The array of vectors to raise to the power
+** @param exp: The exponent to apply to each component
+** @param out: The array receiving the powers (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3d_poww_n(const v3d_t *a, double exp, v3d_t *out, size_t n);
+
+/*
+** Raises each component of an array of 3D double vectors to the power of the corresponding component in another array
+** @param a: The array of vectors to raise to the power
+** @param exp: The array of vectors containing the exponents
+** @param out: The array receiving the powers (may alias a or exp)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3d_pow_n(const v3d_t *a, const v3d_t *exp, v3d_t *out, size_t n);
+
+/*
+** Calculates the component-wise square root of an array of 3D double vectors
+** @param a: The array of vectors
+** @param out: The array receiving the square roots (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3d_sqrt_n(const v3d_t *a, v3d_t *out, size_t n);
+
+/*
+** Calculates the component-wise exponential of an array of 3D double vectors
+** @param a: The array of vectors
+** @param out: The array receiving the exponentials (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3d_exp_n(const v3d_t *a, v3d_t *out, size_t n);
+
+/*
+** Calculates the component-wise sine of an array of 3D double vectors
+** @param a: The array of vectors
+** @param out: The array receiving the sines (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3d_sin_n(const v3d_t *a, v3d_t *out, size_t n);
+
+/*
+** Calculates the component-wise cosine of an array of 3D double vectors
+** @param a: The array of vectors
+** @param out: The array receiving the cosines (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3d_cos_n(const v3d_t *a, v3d_t *out, size_t n);
+
+/*
+** Calculates the component-wise tangent of an array of 3D double vectors
+** @param a: The array of vectors
+** @param out: The array receiving the tangents (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3d_tan_n(const v3d_t *a, v3d_t *out, size_t n);
+
+/*
+** Calculates the component-wise sine and cosine of an array of 3D double vectors
+** @param a: The array of vectors
+** @param s: The array receiving the sines (may alias a)
+** @param c: The array receiving the cosines (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3d_sincos_n(const v3d_t *a, v3d_t *s, v3d_t *c, size_t n);
+
+/*
+** Calculates the magnitude (length) of each vector in an array of 3D double vectors
+** @param a: The array of vectors
+** @param out: The array receiving the n lengths
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3d_len_n(const v3d_t *a, double *out, size_t n);
+
+/*
+** Calculates the squared magnitude of each vector in an array of 3D double vectors
+** @param a: The array of vectors
+** @param out: The array receiving the n squared lengths
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3d_sqr_len_n(const v3d_t *a, double *out, size_t n);
+
+/*
+** Calculates the dot product of each pair of vectors in two arrays of 3D double vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the n dot products
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3d_dot_n(const v3d_t *a, const v3d_t *b, double *out, size_t n);
+
+/*
+** Calculates the cross product of each pair of vectors in two arrays of 3D double vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the cross products (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3d_cross_n(const v3d_t *a, const v3d_t *b, v3d_t *out, size_t n);
+
+/*
+** Normalizes each vector in an array of 3D double vectors (see v3d_normalize)
+** @param a: The array of vectors
+** @param out: The array receiving the unit vectors (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3d_normalize_n(const v3d_t *a, v3d_t *out, size_t n);
+
+/*
+** Normalizes each vector in an array of 3D double vectors with the fast reciprocal square root (see v3d_normalize_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the unit vectors (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3d_normalize_fast_n(const v3d_t *a, v3d_t *out, size_t n);
+
+/*
+** Calculates the distance between each pair of vectors in two arrays of 3D double vectors
+** @param a: The first array of points
+** @param b: The second array of points
+** @param out: The array receiving the n distances
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3d_dist_n(const v3d_t *a, const v3d_t *b, double *out, size_t n);
+
+/*
+** Calculates the squared distance between each pair of vectors in two arrays of 3D double vectors
+** @param a: The first array of points
+** @param b: The second array of points
+** @param out: The array receiving the n squared distances
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3d_sqr_dist_n(const v3d_t *a, const v3d_t *b, double *out, size_t n);
+
+/*
+** Projects each vector in an array of 3D double vectors onto the corresponding vector in another (see v3d_project)
+** @param a: The array of vectors to project
+** @param b: The array of vectors to project onto
+** @param out: The array receiving the projections (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3d_project_n(const v3d_t *a, const v3d_t *b, v3d_t *out, size_t n);
+
+/*
+** Reflects each vector in an array of 3D double vectors off the corresponding unit normal (see v3d_reflect)
+** @param a: The array of incident vectors
+** @param n: The array of unit normals
+** @param out: The array receiving the reflections (may alias a or n)
+** @param count: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3d_reflect_n(const v3d_t *a, const v3d_t *n, v3d_t *out, size_t count);
+
+// -----------------------------------------
+
+/*
+** 4D VECTOR BATCH FUNCTION PROTOTYPES
+*/
+
+// v4i_t
+
+/*
+** Adds two arrays of 4D integer vectors element-wise
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the sums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4i_add_n(const v4i_t *a, const v4i_t *b, v4i_t *out, size_t n);
+
+/*
+** Subtracts an array of 4D integer vectors from another element-wise
+** @param a: The array of vectors to subtract from
+** @param b: The array of vectors to subtract
+** @param out: The array receiving the differences (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4i_sub_n(const v4i_t *a, const v4i_t *b, v4i_t *out, size_t n);
+
+/*
+** Multiplies two arrays of 4D integer vectors component-wise
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the products (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4i_mul_n(const v4i_t *a, const v4i_t *b, v4i_t *out, size_t n);
+
+/*
+** Divides an array of 4D integer vectors by another component-wise
+** @param a: The array of vectors to be divided
+** @param b: The array of vectors to divide by
+** @param out: The array receiving the quotients (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4i_div_n(const v4i_t *a, const v4i_t *b, v4i_t *out, size_t n);
+
+/*
+** Finds the component-wise minimum of two arrays of 4D integer vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the minimums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4i_min_n(const v4i_t *a, const v4i_t *b, v4i_t *out, size_t n);
+
+/*
+** Finds the component-wise maximum of two arrays of 4D integer vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the maximums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4i_max_n(const v4i_t *a, const v4i_t *b, v4i_t *out, size_t n);
+
+// v4u_t
+
+/*
+** Adds two arrays of 4D unsigned integer vectors element-wise
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the sums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4u_add_n(const v4u_t *a, const v4u_t *b, v4u_t *out, size_t n);
+
+/*
+** Subtracts an array of 4D unsigned integer vectors from another element-wise
+** @param a: The array of vectors to subtract from
+** @param b: The array of vectors to subtract
+** @param out: The array receiving the differences (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4u_sub_n(const v4u_t *a, const v4u_t *b, v4u_t *out, size_t n);
+
+/*
+** Multiplies two arrays of 4D unsigned integer vectors component-wise
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the products (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4u_mul_n(const v4u_t *a, const v4u_t *b, v4u_t *out, size_t n);
+
+/*
+** Divides an array of 4D unsigned integer vectors by another component-wise
+** @param a: The array of vectors to be divided
+** @param b: The array of vectors to divide by
+** @param out: The array receiving the quotients (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4u_div_n(const v4u_t *a, const v4u_t *b, v4u_t *out, size_t n);
+
+/*
+** Finds the component-wise minimum of two arrays of 4D unsigned integer vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the minimums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4u_min_n(const v4u_t *a, const v4u_t *b, v4u_t *out, size_t n);
+
+/*
+** Finds the component-wise maximum of two arrays of 4D unsigned integer vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the maximums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4u_max_n(const v4u_t *a, const v4u_t *b, v4u_t *out, size_t n);
+
+// v4f_t
+
+/*
+** Adds two arrays of 4D float vectors element-wise
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the sums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4f_add_n(const v4f_t *a, const v4f_t *b, v4f_t *out, size_t n);
+
+/*
+** Subtracts an array of 4D float vectors from another element-wise
+** @param a: The array of vectors to subtract from
+** @param b: The array of vectors to subtract
+** @param out: The array receiving the differences (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4f_sub_n(const v4f_t *a, const v4f_t *b, v4f_t *out, size_t n);
+
+/*
+** Multiplies two arrays of 4D float vectors component-wise
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the products (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4f_mul_n(const v4f_t *a, const v4f_t *b, v4f_t *out, size_t n);
+
+/*
+** Multiplies two arrays of 4D float vectors component-wise and adds a third (see v4f_fma)
+** @param a: The first array of vectors to multiply
+** @param b: The second array of vectors to multiply
+** @param c: The array of vectors to add
+** @param out: The array receiving the results (may alias a, b or c)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4f_fma_n(const v4f_t *a, const v4f_t *b, const v4f_t *c, v4f_t *out, size_t n);
+
+/*
+** Multiplies two arrays of 4D float vectors component-wise and subtracts a third (see v4f_fms)
+** @param a: The first array of vectors to multiply
+** @param b: The second array of vectors to multiply
+** @param c: The array of vectors to subtract
+** @param out: The array receiving the results (may alias a, b or c)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4f_fms_n(const v4f_t *a, const v4f_t *b, const v4f_t *c, v4f_t *out, size_t n);
+
+/*
+** Divides an array of 4D float vectors by another component-wise
+** @param a: The array of vectors to be divided
+** @param b: The array of vectors to divide by
+** @param out: The array receiving the quotients (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4f_div_n(const v4f_t *a, const v4f_t *b, v4f_t *out, size_t n);
+
+/*
+** Finds the component-wise minimum of two arrays of 4D float vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the minimums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4f_min_n(const v4f_t *a, const v4f_t *b, v4f_t *out, size_t n);
+
+/*
+** Finds the component-wise maximum of two arrays of 4D float vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the maximums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4f_max_n(const v4f_t *a, const v4f_t *b, v4f_t *out, size_t n);
+
+/*
+** Raises each component of an array of 4D float vectors to a specified exponent
+** @param a: The array of vectors to raise to the power
+** @param exp: The exponent to apply to each component
+** @param out: The array receiving the powers (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4f_poww_n(const v4f_t *a, float exp, v4f_t *out, size_t n);
+
+/*
+** Raises each component of an array of 4D float vectors to the power of the corresponding component in another array
+** @param a: The array of vectors to raise to the power
+** @param exp: The array of vectors containing the exponents
+** @param out: The array receiving the powers (may alias a or exp)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4f_pow_n(const v4f_t *a, const v4f_t *exp, v4f_t *out, size_t n);
+
+/*
+** Calculates the component-wise square root of an array of 4D float vectors
+** @param a: The array of vectors
+** @param out: The array receiving the square roots (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4f_sqrt_n(const v4f_t *a, v4f_t *out, size_t n);
+
+/*
+** Calculates the component-wise exponential of an array of 4D float vectors
+** @param a: The array of vectors
+** @param out: The array receiving the exponentials (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4f_exp_n(const v4f_t *a, v4f_t *out, size_t n);
+
+/*
+** Calculates the component-wise sine of an array of 4D float vectors
+** @param a: The array of vectors
+** @param out: The array receiving the sines (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4f_sin_n(const v4f_t *a, v4f_t *out, size_t n);
+
+/*
+** Calculates the component-wise cosine of an array of 4D float vectors
+** @param a: The array of vectors
+** @param out: The array receiving the cosines (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4f_cos_n(const v4f_t *a, v4f_t *out, size_t n);
+
+/*
+** Calculates the component-wise tangent of an array of 4D float vectors
+** @param a: The array of vectors
+** @param out: The array receiving the tangents (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4f_tan_n(const v4f_t *a, v4f_t *out, size_t n);
+
+/*
+** Calculates the component-wise sine and cosine of an array of 4D float vectors
+** @param a: The array of vectors
+** @param s: The array receiving the sines (may alias a)
+** @param c: The array receiving the cosines (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4f_sincos_n(const v4f_t *a, v4f_t *s, v4f_t *c, size_t n);
+
+/*
+** Calculates the magnitude (length) of each vector in an array of 4D float vectors
+** @param a: The array of vectors
+** @param out: The array receiving the n lengths
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4f_len_n(const v4f_t *a, float *out, size_t n);
+
+/*
+** Calculates the squared magnitude of each vector in an array of 4D float vectors
+** @param a: The array of vectors
+** @param out: The array receiving the n squared lengths
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4f_sqr_len_n(const v4f_t *a, float *out, size_t n);
+
+/*
+** Calculates the dot product of each pair of vectors in two arrays of 4D float vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the n dot products
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4f_dot_n(const v4f_t *a, const v4f_t *b, float *out, size_t n);
+
+/*
+** Normalizes each vector in an array of 4D float vectors (see v4f_normalize)
+** @param a: The array of vectors
+** @param out: The array receiving the unit vectors (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4f_normalize_n(const v4f_t *a, v4f_t *out, size_t n);
+
+/*
+** Normalizes each vector in an array of 4D float vectors with the fast reciprocal square root (see v4f_normalize_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the unit vectors (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4f_normalize_fast_n(const v4f_t *a, v4f_t *out, size_t n);
+
+/*
+** Calculates the distance between each pair of vectors in two arrays of 4D float vectors
+** @param a: The first array of points
+** @param b: The second array of points
+** @param out: The array receiving the n distances
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4f_dist_n(const v4f_t *a, const v4f_t *b, float *out, size_t n);
+
+/*
+** Calculates the squared distance between each pair of vectors in two arrays of 4D float vectors
+** @param a: The first array of points
+** @param b: The second array of points
+** @param out: The array receiving the n squared distances
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4f_sqr_dist_n(const v4f_t *a, const v4f_t *b, float *out, size_t n);
+
+/*
+** Projects each vector in an array of 4D float vectors onto the corresponding vector in another (see v4f_project)
+** @param a: The array of vectors to project
+** @param b: The array of vectors to project onto
+** @param out: The array receiving the projections (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4f_project_n(const v4f_t *a, const v4f_t *b, v4f_t *out, size_t n);
+
+/*
+** Reflects each vector in an array of 4D float vectors off the corresponding unit normal (see v4f_reflect)
+** @param a: The array of incident vectors
+** @param n: The array of unit normals
+** @param out: The array receiving the reflections (may alias a or n)
+** @param count: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4f_reflect_n(const v4f_t *a, const v4f_t *n, v4f_t *out, size_t count);
+
+// v4d_t
+
+/*
+** Adds two arrays of 4D double vectors element-wise
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the sums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4d_add_n(const v4d_t *a, const v4d_t *b, v4d_t *out, size_t n);
+
+/*
+** Subtracts an array of 4D double vectors from another element-wise
+** @param a: The array of vectors to subtract from
+** @param b: The array of vectors to subtract
+** @param out: The array receiving the differences (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4d_sub_n(const v4d_t *a, const v4d_t *b, v4d_t *out, size_t n);
+
+/*
+** Multiplies two arrays of 4D double vectors component-wise
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the products (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4d_mul_n(const v4d_t *a, const v4d_t *b, v4d_t *out, size_t n);
+
+/*
+** Multiplies two arrays of 4D double vectors component-wise and adds a third (see v4d_fma)
+** @param a: The first array of vectors to multiply
+** @param b: The second array of vectors to multiply
+** @param c: The array of vectors to add
+** @param out: The array receiving the results (may alias a, b or c)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4d_fma_n(const v4d_t *a, const v4d_t *b, const v4d_t *c, v4d_t *out, size_t n);
+
+/*
+** Multiplies two arrays of 4D double vectors component-wise and subtracts a third (see v4d_fms)
+** @param a: The first array of vectors to multiply
+** @param b: The second array of vectors to multiply
+** @param c: The array of vectors to subtract
+** @param out: The array receiving the results (may alias a, b or c)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4d_fms_n(const v4d_t *a, const v4d_t *b, const v4d_t *c, v4d_t *out, size_t n);
+
+/*
+** Divides an array of 4D double vectors by another component-wise
+** @param a: The array of vectors to be divided
+** @param b: The array of vectors to divide by
+** @param out: The array receiving the quotients (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4d_div_n(const v4d_t *a, const v4d_t *b, v4d_t *out, size_t n);
+
+/*
+** Finds the component-wise minimum of two arrays of 4D double vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the minimums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4d_min_n(const v4d_t *a, const v4d_t *b, v4d_t *out, size_t n);
+
+/*
+** Finds the component-wise maximum of two arrays of 4D double vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the maximums (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4d_max_n(const v4d_t *a, const v4d_t *b, v4d_t *out, size_t n);
+
+/*
+** Raises each component of an array of 4D double vectors to a specified exponent
+** @param a: The array of vectors to raise to the power
+** @param exp: The exponent to apply to each component
+** @param out: The array receiving the powers (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4d_poww_n(const v4d_t *a, double exp, v4d_t *out, size_t n);
+
+/*
+** Raises each component of an array of 4D double vectors to the power of the corresponding component in another array
+** @param a: The array of vectors to raise to the power
+** @param exp: The array of vectors containing the exponents
+** @param out: The array receiving the powers (may alias a or exp)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4d_pow_n(const v4d_t *a, const v4d_t *exp, v4d_t *out, size_t n);
+
+/*
+** Calculates the component-wise square root of an array of 4D double vectors
+** @param a: The array of vectors
+** @param out: The array receiving the square roots (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4d_sqrt_n(const v4d_t *a, v4d_t *out, size_t n);
+
+/*
+** Calculates the component-wise exponential of an array of 4D double vectors
+** @param a: The array of vectors
+** @param out: The array receiving the exponentials (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4d_exp_n(const v4d_t *a, v4d_t *out, size_t n);
+
+/*
+** Calculates the component-wise sine of an array of 4D double vectors
+** @param a: The array of vectors
+** @param out: The array receiving the sines (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4d_sin_n(const v4d_t *a, v4d_t *out, size_t n);
+
+/*
+** Calculates the component-wise cosine of an array of 4D double vectors
+** @param a: The array of vectors
+** @param out: The array receiving the cosines (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4d_cos_n(const v4d_t *a, v4d_t *out, size_t n);
+
+/*
+** Calculates the component-wise tangent of an array of 4D double vectors
+** @param a: The array of vectors
+** @param out: The array receiving the tangents (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4d_tan_n(const v4d_t *a, v4d_t *out, size_t n);
+
+/*
+** Calculates the component-wise sine and cosine of an array of 4D double vectors
+** @param a: The array of vectors
+** @param s: The array receiving the sines (may alias a)
+** @param c: The array receiving the cosines (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4d_sincos_n(const v4d_t *a, v4d_t *s, v4d_t *c, size_t n);
+
+/*
+** Calculates the magnitude (length) of each vector in an array of 4D double vectors
+** @param a: The array of vectors
+** @param out: The array receiving the n lengths
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4d_len_n(const v4d_t *a, double *out, size_t n);
+
+/*
+** Calculates the squared magnitude of each vector in an array of 4D double vectors
+** @param a: The array of vectors
+** @param out: The array receiving the n squared lengths
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4d_sqr_len_n(const v4d_t *a, double *out, size_t n);
+
+/*
+** Calculates the dot product of each pair of vectors in two arrays of 4D double vectors
+** @param a: The first array of vectors
+** @param b: The second array of vectors
+** @param out: The array receiving the n dot products
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4d_dot_n(const v4d_t *a, const v4d_t *b, double *out, size_t n);
+
+/*
+** Normalizes each vector in an array of 4D double vectors (see v4d_normalize)
+** @param a: The array of vectors
+** @param out: The array receiving the unit vectors (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4d_normalize_n(const v4d_t *a, v4d_t *out, size_t n);
+
+/*
+** Normalizes each vector in an array of 4D double vectors with the fast reciprocal square root (see v4d_normalize_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the unit vectors (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4d_normalize_fast_n(const v4d_t *a, v4d_t *out, size_t n);
+
+/*
+** Calculates the distance between each pair of vectors in two arrays of 4D double vectors
+** @param a: The first array of points
+** @param b: The second array of points
+** @param out: The array receiving the n distances
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4d_dist_n(const v4d_t *a, const v4d_t *b, double *out, size_t n);
+
+/*
+** Calculates the squared distance between each pair of vectors in two arrays of 4D double vectors
+** @param a: The first array of points
+** @param b: The second array of points
+** @param out: The array receiving the n squared distances
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4d_sqr_dist_n(const v4d_t *a, const v4d_t *b, double *out, size_t n);
+
+/*
+** Projects each vector in an array of 4D double vectors onto the corresponding vector in another (see v4d_project)
+** @param a: The array of vectors to project
+** @param b: The array of vectors to project onto
+** @param out: The array receiving the projections (may alias a or b)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4d_project_n(const v4d_t *a, const v4d_t *b, v4d_t *out, size_t n);
+
+/*
+** Reflects each vector in an array of 4D double vectors off the corresponding unit normal (see v4d_reflect)
+** @param a: The array of incident vectors
+** @param n: The array of unit normals
+** @param out: The array receiving the reflections (may alias a or n)
+** @param count: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4d_reflect_n(const v4d_t *a, const v4d_t *n, v4d_t *out, size_t count);
+
+// -----------------------------------------
+
+/*
+** LEVEL 1 BLAS FUNCTION PROTOTYPES
+**
+** The classic vector updates and reductions over flat float and double
+** arrays, and over arrays of vectors viewed as one long array of components.
+** They run through the dispatch table like the batch functions. Reductions
+** sum in a different order than a plain loop, so results can differ from one
+** in the last bits.
+*/
+
+/*
+** Adds a scaled float array to another in place, y = alpha * x + y
+** @param alpha: The scale applied to x
+** @param x: The array to scale and add
+** @param y: The array to add to, receives the result
+** @param n: The number of elements in each array
+** @returns: N/A
+*/
+MVLADEF void axpyf_n(float alpha, const float *x, float *y, size_t n);
+
+/*
+** Scales a float array in place, x = alpha * x
+** @param alpha: The scale to apply
+** @param x: The array to scale, receives the result
+** @param n: The number of elements in the array
+** @returns: N/A
+*/
+MVLADEF void scalf_n(float alpha, float *x, size_t n);
+
+/*
+** Calculates the dot product of two float arrays
+** @param x: The first array
+** @param y: The second array
+** @param n: The number of elements in each array
+** @returns: The sum of x[i] * y[i]
+*/
+MVLADEF float dotf_n(const float *x, const float *y, size_t n);
+
+/*
+** Calculates the Euclidean norm of a float array without intermediate overflow or underflow
+** @param x: The array
+** @param n: The number of elements in the array
+** @returns: The square root of the sum of x[i] * x[i]
+*/
+MVLADEF float nrm2f_n(const float *x, size_t n);
+
+/*
+** Sums the absolute values of a float array
+** @param x: The array
+** @param n: The number of elements in the array
+** @returns: The sum of |x[i]|
+*/
+MVLADEF float asumf_n(const float *x, size_t n);
+
+/*
+** Adds a scaled double array to another in place, y = alpha * x + y
+** @param alpha: The scale applied to x
+** @param x: The array to scale and add
+** @param y: The array to add to, receives the result
+** @param n: The number of elements in each array
+** @returns: N/A
+*/
+MVLADEF void axpyd_n(double alpha, const double *x, double *y, size_t n);
+
+/*
+** Scales a double array in place, x = alpha * x
+** @param alpha: The scale to apply
+** @param x: The array to scale, receives the result
+** @param n: The number of elements in the array
+** @returns: N/A
+*/
+MVLADEF void scald_n(double alpha, double *x, size_t n);
+
+/*
+** Calculates the dot product of two double arrays
+** @param x: The first array
+** @param y: The second array
+** @param n: The number of elements in each array
+** @returns: The sum of x[i] * y[i]
+*/
+MVLADEF double dotd_n(const double *x, const double *y, size_t n);
+
+/*
+** Calculates the Euclidean norm of a double array without intermediate overflow or underflow
+** @param x: The array
+** @param n: The number of elements in the array
+** @returns: The square root of the sum of x[i] * x[i]
+*/
+MVLADEF double nrm2d_n(const double *x, size_t n);
+
+/*
+** Sums the absolute values of a double array
+** @param x: The array
+** @param n: The number of elements in the array
+** @returns: The sum of |x[i]|
+*/
+MVLADEF double asumd_n(const double *x, size_t n);
+
+// v2f_t
+
+/*
+** Adds a scaled array of 2D float vectors to another in place, y = alpha * x + y
+** @param alpha: The scale applied to x
+** @param x: The array of vectors to scale and add
+** @param y: The array of vectors to add to, receives the result
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2f_axpy_n(float alpha, const v2f_t *x, v2f_t *y, size_t n);
+
+/*
+** Scales an array of 2D float vectors in place, x = alpha * x
+** @param alpha: The scale to apply
+** @param x: The array of vectors to scale, receives the result
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2f_scal_n(float alpha, v2f_t *x, size_t n);
+
+/*
+** Sums the dot products of two arrays of 2D float vectors
+** @param x: The first array of vectors
+** @param y: The second array of vectors
+** @param n: The number of vectors in each array
+** @returns: The sum of v2f_dot(x[i], y[i])
+*/
+MVLADEF float v2f_dot_sum_n(const v2f_t *x, const v2f_t *y, size_t n);
+
+/*
+** Calculates the Euclidean norm of an array of 2D float vectors taken as one long vector
+** @param x: The array of vectors
+** @param n: The number of vectors in the array
+** @returns: The square root of the sum of v2f_sqr_len(x[i])
+*/
+MVLADEF float v2f_nrm2_n(const v2f_t *x, size_t n);
+
+/*
+** Sums the absolute values of every component in an array of 2D float vectors
+** @param x: The array of vectors
+** @param n: The number of vectors in the array
+** @returns: The sum of the absolute components
+*/
+MVLADEF float v2f_asum_n(const v2f_t *x, size_t n);
+
+// v2d_t
+
+/*
+** Adds a scaled array of 2D double vectors to another in place, y = alpha * x + y
+** @param alpha: The scale applied to x
+** @param x: The array of vectors to scale and add
+** @param y: The array of vectors to add to, receives the result
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2d_axpy_n(double alpha, const v2d_t *x, v2d_t *y, size_t n);
+
+/*
+** Scales an array of 2D double vectors in place, x = alpha * x
+** @param alpha: The scale to apply
+** @param x: The array of vectors to scale, receives the result
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2d_scal_n(double alpha, v2d_t *x, size_t n);
+
+/*
+** Sums the dot products of two arrays of 2D double vectors
+** @param x: The first array of vectors
+** @param y: The second array of vectors
+** @param n: The number of vectors in each array
+** @returns: The sum of v2d_dot(x[i], y[i])
+*/
+MVLADEF double v2d_dot_sum_n(const v2d_t *x, const v2d_t *y, size_t n);
+
+/*
+** Calculates the Euclidean norm of an array of 2D double vectors taken as one long vector
+** @param x: The array of vectors
+** @param n: The number of vectors in the array
+** @returns: The square root of the sum of v2d_sqr_len(x[i])
+*/
+MVLADEF double v2d_nrm2_n(const v2d_t *x, size_t n);
+
+/*
+** Sums the absolute values of every component in an array of 2D double vectors
+** @param x: The array of vectors
+** @param n: The number of vectors in the array
+** @returns: The sum of the absolute components
+*/
+MVLADEF double v2d_asum_n(const v2d_t *x, size_t n);
+
+// v3f_t
+
+/*
+** Adds a scaled array of 3D float vectors to another in place, y = alpha * x + y
+** @param alpha: The scale applied to x
+** @param x: The array of vectors to scale and add
+** @param y: The array of vectors to add to, receives the result
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3f_axpy_n(float alpha, const v3f_t *x, v3f_t *y, size_t n);
+
+/*
+** Scales an array of 3D float vectors in place, x = alpha * x
+** @param alpha: The scale to apply
+** @param x: The array of vectors to scale, receives the result
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3f_scal_n(float alpha, v3f_t *x, size_t n);
+
+/*
+** Sums the dot products of two arrays of 3D float vectors
+** @param x: The first array of vectors
+** @param y: The second array of vectors
+** @param n: The number of vectors in each array
+** @returns: The sum of v3f_dot(x[i], y[i])
+*/
+MVLADEF float v3f_dot_sum_n(const v3f_t *x, const v3f_t *y, size_t n);
+
+/*
+** Calculates the Euclidean norm of an array of 3D float vectors taken as one long vector
+** @param x: The array of vectors
+** @param n: The number of vectors in the array
+** @returns: The square root of the sum of v3f_sqr_len(x[i])
+*/
+MVLADEF float v3f_nrm2_n(const v3f_t *x, size_t n);
+
+/*
+** Sums the absolute values of every component in an array of 3D float vectors
+** @param x: The array of vectors
+** @param n: The number of vectors in the array
+** @returns: The sum of the absolute components
+*/
+MVLADEF float v3f_asum_n(const v3f_t *x, size_t n);
+
+// v3d_t
+
+/*
+** Adds a scaled array of 3D double vectors to another in place, y = alpha * x + y
+** @param alpha: The scale applied to x
+** @param x: The array of vectors to scale and add
+** @param y: The array of vectors to add to, receives the result
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3d_axpy_n(double alpha, const v3d_t *x, v3d_t *y, size_t n);
+
+/*
+** Scales an array of 3D double vectors in place, x = alpha * x
+** @param alpha: The scale to apply
+** @param x: The array of vectors to scale, receives the result
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3d_scal_n(double alpha, v3d_t *x, size_t n);
+
+/*
+** Sums the dot products of two arrays of 3D double vectors
+** @param x: The first array of vectors
+** @param y: The second array of vectors
+** @param n: The number of vectors in each array
+** @returns: The sum of v3d_dot(x[i], y[i])
+*/
+MVLADEF double v3d_dot_sum_n(const v3d_t *x, const v3d_t *y, size_t n);
+
+/*
+** Calculates the Euclidean norm of an array of 3D double vectors taken as one long vector
+** @param x: The array of vectors
+** @param n: The number of vectors in the array
+** @returns: The square root of the sum of v3d_sqr_len(x[i])
+*/
+MVLADEF double v3d_nrm2_n(const v3d_t *x, size_t n);
+
+/*
+** Sums the absolute values of every component in an array of 3D double vectors
+** @param x: The array of vectors
+** @param n: The number of vectors in the array
+** @returns: The sum of the absolute components
+*/
+MVLADEF double v3d_asum_n(const v3d_t *x, size_t n);
+
+// v4f_t
+
+/*
+** Adds a scaled array of 4D float vectors to another in place, y = alpha * x + y
+** @param alpha: The scale applied to x
+** @param x: The array of vectors to scale and add
+** @param y: The array of vectors to add to, receives the result
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4f_axpy_n(float alpha, const v4f_t *x, v4f_t *y, size_t n);
+
+/*
+** Scales an array of 4D float vectors in place, x = alpha * x
+** @param alpha: The scale to apply
+** @param x: The array of vectors to scale, receives the result
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4f_scal_n(float alpha, v4f_t *x, size_t n);
+
+/*
+** Sums the dot products of two arrays of 4D float vectors
+** @param x: The first array of vectors
+** @param y: The second array of vectors
+** @param n: The number of vectors in each array
+** @returns: The sum of v4f_dot(x[i], y[i])
+*/
+MVLADEF float v4f_dot_sum_n(const v4f_t *x, const v4f_t *y, size_t n);
+
+/*
+** Calculates the Euclidean norm of an array of 4D float vectors taken as one long vector
+** @param x: The array of vectors
+** @param n: The number of vectors in the array
+** @returns: The square root of the sum of v4f_sqr_len(x[i])
+*/
+MVLADEF float v4f_nrm2_n(const v4f_t *x, size_t n);
+
+/*
+** Sums the absolute values of every component in an array of 4D float vectors
+** @param x: The array of vectors
+** @param n: The number of vectors in the array
+** @returns: The sum of the absolute components
+*/
+MVLADEF float v4f_asum_n(const v4f_t *x, size_t n);
+
+// v4d_t
+
+/*
+** Adds a scaled array of 4D double vectors to another in place, y = alpha * x + y
+** @param alpha: The scale applied to x
+** @param x: The array of vectors to scale and add
+** @param y: The array of vectors to add to, receives the result
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4d_axpy_n(double alpha, const v4d_t *x, v4d_t *y, size_t n);
+
+/*
+** Scales an array of 4D double vectors in place, x = alpha * x
+** @param alpha: The scale to apply
+** @param x: The array of vectors to scale, receives the result
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4d_scal_n(double alpha, v4d_t *x, size_t n);
+
+/*
+** Sums the dot products of two arrays of 4D double vectors
+** @param x: The first array of vectors
+** @param y: The second array of vectors
+** @param n: The number of vectors in each array
+** @returns: The sum of v4d_dot(x[i], y[i])
+*/
+MVLADEF double v4d_dot_sum_n(const v4d_t *x, const v4d_t *y, size_t n);
+
+/*
+** Calculates the Euclidean norm of an array of 4D double vectors taken as one long vector
+** @param x: The array of vectors
+** @param n: The number of vectors in the array
+** @returns: The square root of the sum of v4d_sqr_len(x[i])
+*/
+MVLADEF double v4d_nrm2_n(const v4d_t *x, size_t n);
+
+/*
+** Sums the absolute values of every component in an array of 4D double vectors
+** @param x: The array of vectors
+** @param n: The number of vectors in the array
+** @returns: The sum of the absolute components
+*/
+MVLADEF double v4d_asum_n(const v4d_t *x, size_t n);
+
+// -----------------------------------------
+
+/*
+** 2D STRUCTURE-OF-ARRAYS FUNCTION PROTOTYPES
+*/
+
+// v2i_soa_t
+
+/*
+** Allocates a 2D integer structure-of-arrays buffer
+** @param n: The number of vectors the buffer holds
+** @returns: A buffer with MVLA_SOA_ALIGN aligned component arrays, or NULL arrays and a count of 0 on failure
+*/
+MVLADEF v2i_soa_t v2i_soa_alloc(size_t n);
+
+/*
+** Frees a 2D integer structure-of-arrays buffer allocated by v2i_soa_alloc
+** @param soa: The buffer to free, its arrays are reset to NULL
+** @returns: N/A
+*/
+MVLADEF void v2i_soa_free(v2i_soa_t *soa);
+
+/*
+** Reads one vector out of a 2D integer structure-of-arrays buffer
+** @param soa: The buffer to read from
+** @param i: The index of the vector
+** @returns: The vector at index i
+*/
+MVLADEF v2i_t v2i_soa_get(const v2i_soa_t *soa, size_t i);
+
+/*
+** Writes one vector into a 2D integer structure-of-arrays buffer
+** @param soa: The buffer to write to
+** @param i: The index of the vector
+** @param a: The vector to store
+** @returns: N/A
+*/
+MVLADEF void v2i_soa_set(v2i_soa_t *soa, size_t i, v2i_t a);
+
+/*
+** Adds two 2D integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The sums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2i_soa_add(const v2i_soa_t *a, const v2i_soa_t *b, v2i_soa_t *out);
+
+/*
+** Subtracts the second of two 2D integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The differences, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2i_soa_sub(const v2i_soa_t *a, const v2i_soa_t *b, v2i_soa_t *out);
+
+/*
+** Multiplies component-wise two 2D integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The products, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2i_soa_mul(const v2i_soa_t *a, const v2i_soa_t *b, v2i_soa_t *out);
+
+/*
+** Divides component-wise the first of two 2D integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The quotients, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2i_soa_div(const v2i_soa_t *a, const v2i_soa_t *b, v2i_soa_t *out);
+
+/*
+** Finds the component-wise minimum of two 2D integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The minimums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2i_soa_min(const v2i_soa_t *a, const v2i_soa_t *b, v2i_soa_t *out);
+
+/*
+** Finds the component-wise maximum of two 2D integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The maximums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2i_soa_max(const v2i_soa_t *a, const v2i_soa_t *b, v2i_soa_t *out);
+
+// v2u_soa_t
+
+/*
+** Allocates a 2D unsigned integer structure-of-arrays buffer
+** @param n: The number of vectors the buffer holds
+** @returns: A buffer with MVLA_SOA_ALIGN aligned component arrays, or NULL arrays and a count of 0 on failure
+*/
+MVLADEF v2u_soa_t v2u_soa_alloc(size_t n);
+
+/*
+** Frees a 2D unsigned integer structure-of-arrays buffer allocated by v2u_soa_alloc
+** @param soa: The buffer to free, its arrays are reset to NULL
+** @returns: N/A
+*/
+MVLADEF void v2u_soa_free(v2u_soa_t *soa);
+
+/*
+** Reads one vector out of a 2D unsigned integer structure-of-arrays buffer
+** @param soa: The buffer to read from
+** @param i: The index of the vector
+** @returns: The vector at index i
+*/
+MVLADEF v2u_t v2u_soa_get(const v2u_soa_t *soa, size_t i);
+
+/*
+** Writes one vector into a 2D unsigned integer structure-of-arrays buffer
+** @param soa: The buffer to write to
+** @param i: The index of the vector
+** @param a: The vector to store
+** @returns: N/A
+*/
+MVLADEF void v2u_soa_set(v2u_soa_t *soa, size_t i, v2u_t a);
+
+/*
+** Adds two 2D unsigned integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The sums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2u_soa_add(const v2u_soa_t *a, const v2u_soa_t *b, v2u_soa_t *out);
+
+/*
+** Subtracts the second of two 2D unsigned integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The differences, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2u_soa_sub(const v2u_soa_t *a, const v2u_soa_t *b, v2u_soa_t *out);
+
+/*
+** Multiplies component-wise two 2D unsigned integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The products, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2u_soa_mul(const v2u_soa_t *a, const v2u_soa_t *b, v2u_soa_t *out);
+
+/*
+** Divides component-wise the first of two 2D unsigned integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The quotients, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2u_soa_div(const v2u_soa_t *a, const v2u_soa_t *b, v2u_soa_t *out);
+
+/*
+** Finds the component-wise minimum of two 2D unsigned integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The minimums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2u_soa_min(const v2u_soa_t *a, const v2u_soa_t *b, v2u_soa_t *out);
+
+/*
+** Finds the component-wise maximum of two 2D unsigned integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The maximums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2u_soa_max(const v2u_soa_t *a, const v2u_soa_t *b, v2u_soa_t *out);
+
+// v2f_soa_t
+
+/*
+** Allocates a 2D float structure-of-arrays buffer
+** @param n: The number of vectors the buffer holds
+** @returns: A buffer with MVLA_SOA_ALIGN aligned component arrays, or NULL arrays and a count of 0 on failure
+*/
+MVLADEF v2f_soa_t v2f_soa_alloc(size_t n);
+
+/*
+** Frees a 2D float structure-of-arrays buffer allocated by v2f_soa_alloc
+** @param soa: The buffer to free, its arrays are reset to NULL
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_free(v2f_soa_t *soa);
+
+/*
+** Reads one vector out of a 2D float structure-of-arrays buffer
+** @param soa: The buffer to read from
+** @param i: The index of the vector
+** @returns: The vector at index i
+*/
+MVLADEF v2f_t v2f_soa_get(const v2f_soa_t *soa, size_t i);
+
+/*
+** Writes one vector into a 2D float structure-of-arrays buffer
+** @param soa: The buffer to write to
+** @param i: The index of the vector
+** @param a: The vector to store
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_set(v2f_soa_t *soa, size_t i, v2f_t a);
+
+/*
+** Adds two 2D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The sums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_add(const v2f_soa_t *a, const v2f_soa_t *b, v2f_soa_t *out);
+
+/*
+** Subtracts the second of two 2D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The differences, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_sub(const v2f_soa_t *a, const v2f_soa_t *b, v2f_soa_t *out);
+
+/*
+** Multiplies component-wise two 2D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The products, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_mul(const v2f_soa_t *a, const v2f_soa_t *b, v2f_soa_t *out);
+
+/*
+** Divides component-wise the first of two 2D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The quotients, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_div(const v2f_soa_t *a, const v2f_soa_t *b, v2f_soa_t *out);
+
+/*
+** Finds the component-wise minimum of two 2D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The minimums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_min(const v2f_soa_t *a, const v2f_soa_t *b, v2f_soa_t *out);
+
+/*
+** Finds the component-wise maximum of two 2D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The maximums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_max(const v2f_soa_t *a, const v2f_soa_t *b, v2f_soa_t *out);
+
+/*
+** Raises the first to the power of the second of two 2D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The powers, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_pow(const v2f_soa_t *a, const v2f_soa_t *b, v2f_soa_t *out);
+
+/*
+** Calculates the component-wise square root of a 2D float structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_sqrt(const v2f_soa_t *a, v2f_soa_t *out);
+
+/*
+** Calculates the component-wise exponential of a 2D float structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_exp(const v2f_soa_t *a, v2f_soa_t *out);
+
+/*
+** Calculates the component-wise sine of a 2D float structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_sin(const v2f_soa_t *a, v2f_soa_t *out);
+
+/*
+** Calculates the component-wise cosine of a 2D float structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_cos(const v2f_soa_t *a, v2f_soa_t *out);
+
+/*
+** Calculates the component-wise tangent of a 2D float structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_tan(const v2f_soa_t *a, v2f_soa_t *out);
+
+/*
+** Calculates the component-wise sine and cosine of a 2D float structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param s: The sines, holding at least a->count vectors (may alias a)
+** @param c: The cosines, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_sincos(const v2f_soa_t *a, v2f_soa_t *s, v2f_soa_t *c);
+
+/*
+** Calculates the magnitude (length) of each vector in a 2D float structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The array receiving a->count results
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_len(const v2f_soa_t *a, float *out);
+
+/*
+** Calculates the squared magnitude of each vector in a 2D float structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The array receiving a->count results
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_sqr_len(const v2f_soa_t *a, float *out);
+
+/*
+** Calculates the dot product of each pair of vectors in two 2D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The array receiving a->count results
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_dot(const v2f_soa_t *a, const v2f_soa_t *b, float *out);
+
+/*
+** Calculates the 2D cross product of each pair of vectors in two 2D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The array receiving a->count results
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_cross(const v2f_soa_t *a, const v2f_soa_t *b, float *out);
+
+/*
+** Normalizes each vector in a 2D float structure-of-arrays buffer (see v2f_normalize)
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The result, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_normalize(const v2f_soa_t *a, v2f_soa_t *out);
+
+/*
+** Normalizes each vector in a 2D float structure-of-arrays buffer with the fast reciprocal square root (see v2f_normalize_fast)
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The result, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_normalize_fast(const v2f_soa_t *a, v2f_soa_t *out);
+
+// v2d_soa_t
+
+/*
+** Allocates a 2D double structure-of-arrays buffer
+** @param n: The number of vectors the buffer holds
+** @returns: A buffer with MVLA_SOA_ALIGN aligned component arrays, or NULL arrays and a count of 0 on failure
+*/
+MVLADEF v2d_soa_t v2d_soa_alloc(size_t n);
+
+/*
+** Frees a 2D double structure-of-arrays buffer allocated by v2d_soa_alloc
+** @param soa: The buffer to free, its arrays are reset to NULL
+** @returns: N/A
+*/
+MVLADEF void v2d_soa_free(v2d_soa_t *soa);
+
+/*
+** Reads one vector out of a 2D double structure-of-arrays buffer
+** @param soa: The buffer to read from
+** @param i: The index of the vector
+** @returns: The vector at index i
+*/
+MVLADEF v2d_t v2d_soa_get(const v2d_soa_t *soa, size_t i);
+
+/*
+** Writes one vector into a 2D double structure-of-arrays buffer
+** @param soa: The buffer to write to
+** @param i: The index of the vector
+** @param a: The vector to store
+** @returns: N/A
+*/
+MVLADEF void v2d_soa_set(v2d_soa_t *soa, size_t i, v2d_t a);
+
+/*
+** Adds two 2D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The sums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2d_soa_add(const v2d_soa_t *a, const v2d_soa_t *b, v2d_soa_t *out);
+
+/*
+** Subtracts the second of two 2D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The differences, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2d_soa_sub(const v2d_soa_t *a, const v2d_soa_t *b, v2d_soa_t *out);
+
+/*
+** Multiplies component-wise two 2D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The products, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2d_soa_mul(const v2d_soa_t *a, const v2d_soa_t *b, v2d_soa_t *out);
+
+/*
+** Divides component-wise the first of two 2D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The quotients, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2d_soa_div(const v2d_soa_t *a, const v2d_soa_t *b, v2d_soa_t *out);
+
+/*
+** Finds the component-wise minimum of two 2D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The minimums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2d_soa_min(const v2d_soa_t *a, const v2d_soa_t *b, v2d_soa_t *out);
+
+/*
+** Finds the component-wise maximum of two 2D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The maximums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2d_soa_max(const v2d_soa_t *a, const v2d_soa_t *b, v2d_soa_t *out);
+
+/*
+** Raises the first to the power of the second of two 2D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The powers, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v2d_soa_pow(const v2d_soa_t *a, const v2d_soa_t *b, v2d_soa_t *out);
+
+/*
+** Calculates the component-wise square root of a 2D double structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v2d_soa_sqrt(const v2d_soa_t *a, v2d_soa_t *out);
+
+/*
+** Calculates the component-wise exponential of a 2D double structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v2d_soa_exp(const v2d_soa_t *a, v2d_soa_t *out);
+
+/*
+** Calculates the component-wise sine of a 2D double structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v2d_soa_sin(const v2d_soa_t *a, v2d_soa_t *out);
+
+/*
+** Calculates the component-wise cosine of a 2D double structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v2d_soa_cos(const v2d_soa_t *a, v2d_soa_t *out);
+
+/*
+** Calculates the component-wise tangent of a 2D double structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v2d_soa_tan(const v2d_soa_t *a, v2d_soa_t *out);
+
+/*
+** Calculates the component-wise sine and cosine of a 2D double structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param s: The sines, holding at least a->count vectors (may alias a)
+** @param c: The cosines, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v2d_soa_sincos(const v2d_soa_t *a, v2d_soa_t *s, v2d_soa_t *c);
+
+/*
+** Calculates the magnitude (length) of each vector in a 2D double structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The array receiving a->count results
+** @returns: N/A
+*/
+MVLADEF void v2d_soa_len(const v2d_soa_t *a, double *out);
+
+/*
+** Calculates the squared magnitude of each vector in a 2D double structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The array receiving a->count results
+** @returns: N/A
+*/
+MVLADEF void v2d_soa_sqr_len(const v2d_soa_t *a, double *out);
+
+/*
+** Calculates the dot product of each pair of vectors in two 2D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The array receiving a->count results
+** @returns: N/A
+*/
+MVLADEF void v2d_soa_dot(const v2d_soa_t *a, const v2d_soa_t *b, double *out);
+
+/*
+** Calculates the 2D cross product of each pair of vectors in two 2D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The array receiving a->count results
+** @returns: N/A
+*/
+MVLADEF void v2d_soa_cross(const v2d_soa_t *a, const v2d_soa_t *b, double *out);
+
+/*
+** Normalizes each vector in a 2D double structure-of-arrays buffer (see v2d_normalize)
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The result, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v2d_soa_normalize(const v2d_soa_t *a, v2d_soa_t *out);
+
+/*
+** Normalizes each vector in a 2D double structure-of-arrays buffer with the fast reciprocal square root (see v2d_normalize_fast)
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The result, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v2d_soa_normalize_fast(const v2d_soa_t *a, v2d_soa_t *out);
+
+// -----------------------------------------
+
+/*
+** 3D STRUCTURE-OF-ARRAYS FUNCTION PROTOTYPES
+*/
+
+// v3i_soa_t
+
+/*
+** Allocates a 3D integer structure-of-arrays buffer
+** @param n: The number of vectors the buffer holds
+** @returns: A buffer with MVLA_SOA_ALIGN aligned component arrays, or NULL arrays and a count of 0 on failure
+*/
+MVLADEF v3i_soa_t v3i_soa_alloc(size_t n);
+
+/*
+** Frees a 3D integer structure-of-arrays buffer allocated by v3i_soa_alloc
+** @param soa: The buffer to free, its arrays are reset to NULL
+** @returns: N/A
+*/
+MVLADEF void v3i_soa_free(v3i_soa_t *soa);
+
+/*
+** Reads one vector out of a 3D integer structure-of-arrays buffer
+** @param soa: The buffer to read from
+** @param i: The index of the vector
+** @returns: The vector at index i
+*/
+MVLADEF v3i_t v3i_soa_get(const v3i_soa_t *soa, size_t i);
+
+/*
+** Writes one vector into a 3D integer structure-of-arrays buffer
+** @param soa: The buffer to write to
+** @param i: The index of the vector
+** @param a: The vector to store
+** @returns: N/A
+*/
+MVLADEF void v3i_soa_set(v3i_soa_t *soa, size_t i, v3i_t a);
+
+/*
+** Adds two 3D integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The sums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3i_soa_add(const v3i_soa_t *a, const v3i_soa_t *b, v3i_soa_t *out);
+
+/*
+** Subtracts the second of two 3D integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The differences, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3i_soa_sub(const v3i_soa_t *a, const v3i_soa_t *b, v3i_soa_t *out);
+
+/*
+** Multiplies component-wise two 3D integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The products, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3i_soa_mul(const v3i_soa_t *a, const v3i_soa_t *b, v3i_soa_t *out);
+
+/*
+** Divides component-wise the first of two 3D integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The quotients, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3i_soa_div(const v3i_soa_t *a, const v3i_soa_t *b, v3i_soa_t *out);
+
+/*
+** Finds the component-wise minimum of two 3D integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The minimums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3i_soa_min(const v3i_soa_t *a, const v3i_soa_t *b, v3i_soa_t *out);
+
+/*
+** Finds the component-wise maximum of two 3D integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The maximums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3i_soa_max(const v3i_soa_t *a, const v3i_soa_t *b, v3i_soa_t *out);
+
+// v3u_soa_t
+
+/*
+** Allocates a 3D unsigned integer structure-of-arrays buffer
+** @param n: The number of vectors the buffer holds
+** @returns: A buffer with MVLA_SOA_ALIGN aligned component arrays, or NULL arrays and a count of 0 on failure
+*/
+MVLADEF v3u_soa_t v3u_soa_alloc(size_t n);
+
+/*
+** Frees a 3D unsigned integer structure-of-arrays buffer allocated by v3u_soa_alloc
+** @param soa: The buffer to free, its arrays are reset to NULL
+** @returns: N/A
+*/
+MVLADEF void v3u_soa_free(v3u_soa_t *soa);
+
+/*
+** Reads one vector out of a 3D unsigned integer structure-of-arrays buffer
+** @param soa: The buffer to read from
+** @param i: The index of the vector
+** @returns: The vector at index i
+*/
+MVLADEF v3u_t v3u_soa_get(const v3u_soa_t *soa, size_t i);
+
+/*
+** Writes one vector into a 3D unsigned integer structure-of-arrays buffer
+** @param soa: The buffer to write to
+** @param i: The index of the vector
+** @param a: The vector to store
+** @returns: N/A
+*/
+MVLADEF void v3u_soa_set(v3u_soa_t *soa, size_t i, v3u_t a);
+
+/*
+** Adds two 3D unsigned integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The sums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3u_soa_add(const v3u_soa_t *a, const v3u_soa_t *b, v3u_soa_t *out);
+
+/*
+** Subtracts the second of two 3D unsigned integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The differences, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3u_soa_sub(const v3u_soa_t *a, const v3u_soa_t *b, v3u_soa_t *out);
+
+/*
+** Multiplies component-wise two 3D unsigned integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The products, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3u_soa_mul(const v3u_soa_t *a, const v3u_soa_t *b, v3u_soa_t *out);
+
+/*
+** Divides component-wise the first of two 3D unsigned integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The quotients, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3u_soa_div(const v3u_soa_t *a, const v3u_soa_t *b, v3u_soa_t *out);
+
+/*
+** Finds the component-wise minimum of two 3D unsigned integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The minimums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3u_soa_min(const v3u_soa_t *a, const v3u_soa_t *b, v3u_soa_t *out);
+
+/*
+** Finds the component-wise maximum of two 3D unsigned integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The maximums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3u_soa_max(const v3u_soa_t *a, const v3u_soa_t *b, v3u_soa_t *out);
+
+// v3f_soa_t
+
+/*
+** Allocates a 3D float structure-of-arrays buffer
+** @param n: The number of vectors the buffer holds
+** @returns: A buffer with MVLA_SOA_ALIGN aligned component arrays, or NULL arrays and a count of 0 on failure
+*/
+MVLADEF v3f_soa_t v3f_soa_alloc(size_t n);
+
+/*
+** Frees a 3D float structure-of-arrays buffer allocated by v3f_soa_alloc
+** @param soa: The buffer to free, its arrays are reset to NULL
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_free(v3f_soa_t *soa);
+
+/*
+** Reads one vector out of a 3D float structure-of-arrays buffer
+** @param soa: The buffer to read from
+** @param i: The index of the vector
+** @returns: The vector at index i
+*/
+MVLADEF v3f_t v3f_soa_get(const v3f_soa_t *soa, size_t i);
+
+/*
+** Writes one vector into a 3D float structure-of-arrays buffer
+** @param soa: The buffer to write to
+** @param i: The index of the vector
+** @param a: The vector to store
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_set(v3f_soa_t *soa, size_t i, v3f_t a);
+
+/*
+** Adds two 3D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The sums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_add(const v3f_soa_t *a, const v3f_soa_t *b, v3f_soa_t *out);
+
+/*
+** Subtracts the second of two 3D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The differences, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_sub(const v3f_soa_t *a, const v3f_soa_t *b, v3f_soa_t *out);
+
+/*
+** Multiplies component-wise two 3D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The products, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_mul(const v3f_soa_t *a, const v3f_soa_t *b, v3f_soa_t *out);
+
+/*
+** Divides component-wise the first of two 3D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The quotients, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_div(const v3f_soa_t *a, const v3f_soa_t *b, v3f_soa_t *out);
+
+/*
+** Finds the component-wise minimum of two 3D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The minimums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_min(const v3f_soa_t *a, const v3f_soa_t *b, v3f_soa_t *out);
+
+/*
+** Finds the component-wise maximum of two 3D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The maximums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_max(const v3f_soa_t *a, const v3f_soa_t *b, v3f_soa_t *out);
+
+/*
+** Raises the first to the power of the second of two 3D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The powers, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_pow(const v3f_soa_t *a, const v3f_soa_t *b, v3f_soa_t *out);
+
+/*
+** Calculates the component-wise square root of a 3D float structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_sqrt(const v3f_soa_t *a, v3f_soa_t *out);
+
+/*
+** Calculates the component-wise exponential of a 3D float structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_exp(const v3f_soa_t *a, v3f_soa_t *out);
+
+/*
+** Calculates the component-wise sine of a 3D float structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_sin(const v3f_soa_t *a, v3f_soa_t *out);
+
+/*
+** Calculates the component-wise cosine of a 3D float structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_cos(const v3f_soa_t *a, v3f_soa_t *out);
+
+/*
+** Calculates the component-wise tangent of a 3D float structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_tan(const v3f_soa_t *a, v3f_soa_t *out);
+
+/*
+** Calculates the component-wise sine and cosine of a 3D float structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param s: The sines, holding at least a->count vectors (may alias a)
+** @param c: The cosines, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_sincos(const v3f_soa_t *a, v3f_soa_t *s, v3f_soa_t *c);
+
+/*
+** Calculates the magnitude (length) of each vector in a 3D float structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The array receiving a->count results
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_len(const v3f_soa_t *a, float *out);
+
+/*
+** Calculates the squared magnitude of each vector in a 3D float structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The array receiving a->count results
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_sqr_len(const v3f_soa_t *a, float *out);
+
+/*
+** Calculates the dot product of each pair of vectors in two 3D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The array receiving a->count results
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_dot(const v3f_soa_t *a, const v3f_soa_t *b, float *out);
+
+/*
+** Calculates the cross product of each pair of vectors in two 3D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The result, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_cross(const v3f_soa_t *a, const v3f_soa_t *b, v3f_soa_t *out);
+
+/*
+** Normalizes each vector in a 3D float structure-of-arrays buffer (see v3f_normalize)
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The result, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_normalize(const v3f_soa_t *a, v3f_soa_t *out);
+
+/*
+** Normalizes each vector in a 3D float structure-of-arrays buffer with the fast reciprocal square root (see v3f_normalize_fast)
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The result, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_normalize_fast(const v3f_soa_t *a, v3f_soa_t *out);
+
+// v3d_soa_t
+
+/*
+** Allocates a 3D double structure-of-arrays buffer
+** @param n: The number of vectors the buffer holds
+** @returns: A buffer with MVLA_SOA_ALIGN aligned component arrays, or NULL arrays and a count of 0 on failure
+*/
+MVLADEF v3d_soa_t v3d_soa_alloc(size_t n);
+
+/*
+** Frees a 3D double structure-of-arrays buffer allocated by v3d_soa_alloc
+** @param soa: The buffer to free, its arrays are reset to NULL
+** @returns: N/A
+*/
+MVLADEF void v3d_soa_free(v3d_soa_t *soa);
+
+/*
+** Reads one vector out of a 3D double structure-of-arrays buffer
+** @param soa: The buffer to read from
+** @param i: The index of the vector
+** @returns: The vector at index i
+*/
+MVLADEF v3d_t v3d_soa_get(const v3d_soa_t *soa, size_t i);
+
+/*
+** Writes one vector into a 3D double structure-of-arrays buffer
+** @param soa: The buffer to write to
+** @param i: The index of the vector
+** @param a: The vector to store
+** @returns: N/A
+*/
+MVLADEF void v3d_soa_set(v3d_soa_t *soa, size_t i, v3d_t a);
+
+/*
+** Adds two 3D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The sums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3d_soa_add(const v3d_soa_t *a, const v3d_soa_t *b, v3d_soa_t *out);
+
+/*
+** Subtracts the second of two 3D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The differences, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3d_soa_sub(const v3d_soa_t *a, const v3d_soa_t *b, v3d_soa_t *out);
+
+/*
+** Multiplies component-wise two 3D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The products, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3d_soa_mul(const v3d_soa_t *a, const v3d_soa_t *b, v3d_soa_t *out);
+
+/*
+** Divides component-wise the first of two 3D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The quotients, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3d_soa_div(const v3d_soa_t *a, const v3d_soa_t *b, v3d_soa_t *out);
+
+/*
+** Finds the component-wise minimum of two 3D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The minimums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3d_soa_min(const v3d_soa_t *a, const v3d_soa_t *b, v3d_soa_t *out);
+
+/*
+** Finds the component-wise maximum of two 3D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The maximums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3d_soa_max(const v3d_soa_t *a, const v3d_soa_t *b, v3d_soa_t *out);
+
+/*
+** Raises the first to the power of the second of two 3D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The powers, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3d_soa_pow(const v3d_soa_t *a, const v3d_soa_t *b, v3d_soa_t *out);
+
+/*
+** Calculates the component-wise square root of a 3D double structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v3d_soa_sqrt(const v3d_soa_t *a, v3d_soa_t *out);
+
+/*
+** Calculates the component-wise exponential of a 3D double structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v3d_soa_exp(const v3d_soa_t *a, v3d_soa_t *out);
+
+/*
+** Calculates the component-wise sine of a 3D double structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v3d_soa_sin(const v3d_soa_t *a, v3d_soa_t *out);
+
+/*
+** Calculates the component-wise cosine of a 3D double structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v3d_soa_cos(const v3d_soa_t *a, v3d_soa_t *out);
+
+/*
+** Calculates the component-wise tangent of a 3D double structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v3d_soa_tan(const v3d_soa_t *a, v3d_soa_t *out);
+
+/*
+** Calculates the component-wise sine and cosine of a 3D double structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param s: The sines, holding at least a->count vectors (may alias a)
+** @param c: The cosines, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v3d_soa_sincos(const v3d_soa_t *a, v3d_soa_t *s, v3d_soa_t *c);
+
+/*
+** Calculates the magnitude (length) of each vector in a 3D double structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The array receiving a->count results
+** @returns: N/A
+*/
+MVLADEF void v3d_soa_len(const v3d_soa_t *a, double *out);
+
+/*
+** Calculates the squared magnitude of each vector in a 3D double structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The array receiving a->count results
+** @returns: N/A
+*/
+MVLADEF void v3d_soa_sqr_len(const v3d_soa_t *a, double *out);
+
+/*
+** Calculates the dot product of each pair of vectors in two 3D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The array receiving a->count results
+** @returns: N/A
+*/
+MVLADEF void v3d_soa_dot(const v3d_soa_t *a, const v3d_soa_t *b, double *out);
+
+/*
+** Calculates the cross product of each pair of vectors in two 3D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The result, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v3d_soa_cross(const v3d_soa_t *a, const v3d_soa_t *b, v3d_soa_t *out);
+
+/*
+** Normalizes each vector in a 3D double structure-of-arrays buffer (see v3d_normalize)
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The result, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v3d_soa_normalize(const v3d_soa_t *a, v3d_soa_t *out);
+
+/*
+** Normalizes each vector in a 3D double structure-of-arrays buffer with the fast reciprocal square root (see v3d_normalize_fast)
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The result, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v3d_soa_normalize_fast(const v3d_soa_t *a, v3d_soa_t *out);
+
+// -----------------------------------------
+
+/*
+** 4D STRUCTURE-OF-ARRAYS FUNCTION PROTOTYPES
+*/
+
+// v4i_soa_t
+
+/*
+** Allocates a 4D integer structure-of-arrays buffer
+** @param n: The number of vectors the buffer holds
+** @returns: A buffer with MVLA_SOA_ALIGN aligned component arrays, or NULL arrays and a count of 0 on failure
+*/
+MVLADEF v4i_soa_t v4i_soa_alloc(size_t n);
+
+/*
+** Frees a 4D integer structure-of-arrays buffer allocated by v4i_soa_alloc
+** @param soa: The buffer to free, its arrays are reset to NULL
+** @returns: N/A
+*/
+MVLADEF void v4i_soa_free(v4i_soa_t *soa);
+
+/*
+** Reads one vector out of a 4D integer structure-of-arrays buffer
+** @param soa: The buffer to read from
+** @param i: The index of the vector
+** @returns: The vector at index i
+*/
+MVLADEF v4i_t v4i_soa_get(const v4i_soa_t *soa, size_t i);
+
+/*
+** Writes one vector into a 4D integer structure-of-arrays buffer
+** @param soa: The buffer to write to
+** @param i: The index of the vector
+** @param a: The vector to store
+** @returns: N/A
+*/
+MVLADEF void v4i_soa_set(v4i_soa_t *soa, size_t i, v4i_t a);
+
+/*
+** Adds two 4D integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The sums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4i_soa_add(const v4i_soa_t *a, const v4i_soa_t *b, v4i_soa_t *out);
+
+/*
+** Subtracts the second of two 4D integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The differences, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4i_soa_sub(const v4i_soa_t *a, const v4i_soa_t *b, v4i_soa_t *out);
+
+/*
+** Multiplies component-wise two 4D integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The products, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4i_soa_mul(const v4i_soa_t *a, const v4i_soa_t *b, v4i_soa_t *out);
+
+/*
+** Divides component-wise the first of two 4D integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The quotients, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4i_soa_div(const v4i_soa_t *a, const v4i_soa_t *b, v4i_soa_t *out);
+
+/*
+** Finds the component-wise minimum of two 4D integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The minimums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4i_soa_min(const v4i_soa_t *a, const v4i_soa_t *b, v4i_soa_t *out);
+
+/*
+** Finds the component-wise maximum of two 4D integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The maximums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4i_soa_max(const v4i_soa_t *a, const v4i_soa_t *b, v4i_soa_t *out);
+
+// v4u_soa_t
+
+/*
+** Allocates a 4D unsigned integer structure-of-arrays buffer
+** @param n: The number of vectors the buffer holds
+** @returns: A buffer with MVLA_SOA_ALIGN aligned component arrays, or NULL arrays and a count of 0 on failure
+*/
+MVLADEF v4u_soa_t v4u_soa_alloc(size_t n);
+
+/*
+** Frees a 4D unsigned integer structure-of-arrays buffer allocated by v4u_soa_alloc
+** @param soa: The buffer to free, its arrays are reset to NULL
+** @returns: N/A
+*/
+MVLADEF void v4u_soa_free(v4u_soa_t *soa);
+
+/*
+** Reads one vector out of a 4D unsigned integer structure-of-arrays buffer
+** @param soa: The buffer to read from
+** @param i: The index of the vector
+** @returns: The vector at index i
+*/
+MVLADEF v4u_t v4u_soa_get(const v4u_soa_t *soa, size_t i);
+
+/*
+** Writes one vector into a 4D unsigned integer structure-of-arrays buffer
+** @param soa: The buffer to write to
+** @param i: The index of the vector
+** @param a: The vector to store
+** @returns: N/A
+*/
+MVLADEF void v4u_soa_set(v4u_soa_t *soa, size_t i, v4u_t a);
+
+/*
+** Adds two 4D unsigned integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The sums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4u_soa_add(const v4u_soa_t *a, const v4u_soa_t *b, v4u_soa_t *out);
+
+/*
+** Subtracts the second of two 4D unsigned integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The differences, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4u_soa_sub(const v4u_soa_t *a, const v4u_soa_t *b, v4u_soa_t *out);
+
+/*
+** Multiplies component-wise two 4D unsigned integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The products, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4u_soa_mul(const v4u_soa_t *a, const v4u_soa_t *b, v4u_soa_t *out);
+
+/*
+** Divides component-wise the first of two 4D unsigned integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The quotients, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4u_soa_div(const v4u_soa_t *a, const v4u_soa_t *b, v4u_soa_t *out);
+
+/*
+** Finds the component-wise minimum of two 4D unsigned integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The minimums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4u_soa_min(const v4u_soa_t *a, const v4u_soa_t *b, v4u_soa_t *out);
+
+/*
+** Finds the component-wise maximum of two 4D unsigned integer structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The maximums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4u_soa_max(const v4u_soa_t *a, const v4u_soa_t *b, v4u_soa_t *out);
+
+// v4f_soa_t
+
+/*
+** Allocates a 4D float structure-of-arrays buffer
+** @param n: The number of vectors the buffer holds
+** @returns: A buffer with MVLA_SOA_ALIGN aligned component arrays, or NULL arrays and a count of 0 on failure
+*/
+MVLADEF v4f_soa_t v4f_soa_alloc(size_t n);
+
+/*
+** Frees a 4D float structure-of-arrays buffer allocated by v4f_soa_alloc
+** @param soa: The buffer to free, its arrays are reset to NULL
+** @returns: N/A
+*/
+MVLADEF void v4f_soa_free(v4f_soa_t *soa);
+
+/*
+** Reads one vector out of a 4D float structure-of-arrays buffer
+** @param soa: The buffer to read from
+** @param i: The index of the vector
+** @returns: The vector at index i
+*/
+MVLADEF v4f_t v4f_soa_get(const v4f_soa_t *soa, size_t i);
+
+/*
+** Writes one vector into a 4D float structure-of-arrays buffer
+** @param soa: The buffer to write to
+** @param i: The index of the vector
+** @param a: The vector to store
+** @returns: N/A
+*/
+MVLADEF void v4f_soa_set(v4f_soa_t *soa, size_t i, v4f_t a);
+
+/*
+** Adds two 4D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The sums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4f_soa_add(const v4f_soa_t *a, const v4f_soa_t *b, v4f_soa_t *out);
+
+/*
+** Subtracts the second of two 4D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The differences, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4f_soa_sub(const v4f_soa_t *a, const v4f_soa_t *b, v4f_soa_t *out);
+
+/*
+** Multiplies component-wise two 4D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The products, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4f_soa_mul(const v4f_soa_t *a, const v4f_soa_t *b, v4f_soa_t *out);
+
+/*
+** Divides component-wise the first of two 4D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The quotients, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4f_soa_div(const v4f_soa_t *a, const v4f_soa_t *b, v4f_soa_t *out);
+
+/*
+** Finds the component-wise minimum of two 4D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The minimums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4f_soa_min(const v4f_soa_t *a, const v4f_soa_t *b, v4f_soa_t *out);
+
+/*
+** Finds the component-wise maximum of two 4D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The maximums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4f_soa_max(const v4f_soa_t *a, const v4f_soa_t *b, v4f_soa_t *out);
+
+/*
+** Raises the first to the power of the second of two 4D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The powers, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4f_soa_pow(const v4f_soa_t *a, const v4f_soa_t *b, v4f_soa_t *out);
+
+/*
+** Calculates the component-wise square root of a 4D float structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v4f_soa_sqrt(const v4f_soa_t *a, v4f_soa_t *out);
+
+/*
+** Calculates the component-wise exponential of a 4D float structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v4f_soa_exp(const v4f_soa_t *a, v4f_soa_t *out);
+
+/*
+** Calculates the component-wise sine of a 4D float structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v4f_soa_sin(const v4f_soa_t *a, v4f_soa_t *out);
+
+/*
+** Calculates the component-wise cosine of a 4D float structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v4f_soa_cos(const v4f_soa_t *a, v4f_soa_t *out);
+
+/*
+** Calculates the component-wise tangent of a 4D float structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v4f_soa_tan(const v4f_soa_t *a, v4f_soa_t *out);
+
+/*
+** Calculates the component-wise sine and cosine of a 4D float structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param s: The sines, holding at least a->count vectors (may alias a)
+** @param c: The cosines, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v4f_soa_sincos(const v4f_soa_t *a, v4f_soa_t *s, v4f_soa_t *c);
+
+/*
+** Calculates the magnitude (length) of each vector in a 4D float structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The array receiving a->count results
+** @returns: N/A
+*/
+MVLADEF void v4f_soa_len(const v4f_soa_t *a, float *out);
+
+/*
+** Calculates the squared magnitude of each vector in a 4D float structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The array receiving a->count results
+** @returns: N/A
+*/
+MVLADEF void v4f_soa_sqr_len(const v4f_soa_t *a, float *out);
+
+/*
+** Calculates the dot product of each pair of vectors in two 4D float structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The array receiving a->count results
+** @returns: N/A
+*/
+MVLADEF void v4f_soa_dot(const v4f_soa_t *a, const v4f_soa_t *b, float *out);
+
+/*
+** Normalizes each vector in a 4D float structure-of-arrays buffer (see v4f_normalize)
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The result, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v4f_soa_normalize(const v4f_soa_t *a, v4f_soa_t *out);
+
+/*
+** Normalizes each vector in a 4D float structure-of-arrays buffer with the fast reciprocal square root (see v4f_normalize_fast)
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The result, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v4f_soa_normalize_fast(const v4f_soa_t *a, v4f_soa_t *out);
+
+// v4d_soa_t
+
+/*
+** Allocates a 4D double structure-of-arrays buffer
+** @param n: The number of vectors the buffer holds
+** @returns: A buffer with MVLA_SOA_ALIGN aligned component arrays, or NULL arrays and a count of 0 on failure
+*/
+MVLADEF v4d_soa_t v4d_soa_alloc(size_t n);
+
+/*
+** Frees a 4D double structure-of-arrays buffer allocated by v4d_soa_alloc
+** @param soa: The buffer to free, its arrays are reset to NULL
+** @returns: N/A
+*/
+MVLADEF void v4d_soa_free(v4d_soa_t *soa);
+
+/*
+** Reads one vector out of a 4D double structure-of-arrays buffer
+** @param soa: The buffer to read from
+** @param i: The index of the vector
+** @returns: The vector at index i
+*/
+MVLADEF v4d_t v4d_soa_get(const v4d_soa_t *soa, size_t i);
+
+/*
+** Writes one vector into a 4D double structure-of-arrays buffer
+** @param soa: The buffer to write to
+** @param i: The index of the vector
+** @param a: The vector to store
+** @returns: N/A
+*/
+MVLADEF void v4d_soa_set(v4d_soa_t *soa, size_t i, v4d_t a);
+
+/*
+** Adds two 4D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The sums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4d_soa_add(const v4d_soa_t *a, const v4d_soa_t *b, v4d_soa_t *out);
+
+/*
+** Subtracts the second of two 4D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The differences, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4d_soa_sub(const v4d_soa_t *a, const v4d_soa_t *b, v4d_soa_t *out);
+
+/*
+** Multiplies component-wise two 4D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The products, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4d_soa_mul(const v4d_soa_t *a, const v4d_soa_t *b, v4d_soa_t *out);
+
+/*
+** Divides component-wise the first of two 4D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The quotients, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4d_soa_div(const v4d_soa_t *a, const v4d_soa_t *b, v4d_soa_t *out);
+
+/*
+** Finds the component-wise minimum of two 4D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The minimums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4d_soa_min(const v4d_soa_t *a, const v4d_soa_t *b, v4d_soa_t *out);
+
+/*
+** Finds the component-wise maximum of two 4D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The maximums, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4d_soa_max(const v4d_soa_t *a, const v4d_soa_t *b, v4d_soa_t *out);
+
+/*
+** Raises the first to the power of the second of two 4D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The powers, holding at least a->count vectors (may alias a or b)
+** @returns: N/A
+*/
+MVLADEF void v4d_soa_pow(const v4d_soa_t *a, const v4d_soa_t *b, v4d_soa_t *out);
+
+/*
+** Calculates the component-wise square root of a 4D double structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v4d_soa_sqrt(const v4d_soa_t *a, v4d_soa_t *out);
+
+/*
+** Calculates the component-wise exponential of a 4D double structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v4d_soa_exp(const v4d_soa_t *a, v4d_soa_t *out);
+
+/*
+** Calculates the component-wise sine of a 4D double structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v4d_soa_sin(const v4d_soa_t *a, v4d_soa_t *out);
+
+/*
+** Calculates the component-wise cosine of a 4D double structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v4d_soa_cos(const v4d_soa_t *a, v4d_soa_t *out);
+
+/*
+** Calculates the component-wise tangent of a 4D double structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The results, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v4d_soa_tan(const v4d_soa_t *a, v4d_soa_t *out);
+
+/*
+** Calculates the component-wise sine and cosine of a 4D double structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param s: The sines, holding at least a->count vectors (may alias a)
+** @param c: The cosines, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v4d_soa_sincos(const v4d_soa_t *a, v4d_soa_t *s, v4d_soa_t *c);
+
+/*
+** Calculates the magnitude (length) of each vector in a 4D double structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The array receiving a->count results
+** @returns: N/A
+*/
+MVLADEF void v4d_soa_len(const v4d_soa_t *a, double *out);
+
+/*
+** Calculates the squared magnitude of each vector in a 4D double structure-of-arrays buffer
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The array receiving a->count results
+** @returns: N/A
+*/
+MVLADEF void v4d_soa_sqr_len(const v4d_soa_t *a, double *out);
+
+/*
+** Calculates the dot product of each pair of vectors in two 4D double structure-of-arrays buffers
+** @param a: The first buffer, its count is the number of vectors processed
+** @param b: The second buffer, holding at least a->count vectors
+** @param out: The array receiving a->count results
+** @returns: N/A
+*/
+MVLADEF void v4d_soa_dot(const v4d_soa_t *a, const v4d_soa_t *b, double *out);
+
+/*
+** Normalizes each vector in a 4D double structure-of-arrays buffer (see v4d_normalize)
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The result, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v4d_soa_normalize(const v4d_soa_t *a, v4d_soa_t *out);
+
+/*
+** Normalizes each vector in a 4D double structure-of-arrays buffer with the fast reciprocal square root (see v4d_normalize_fast)
+** @param a: The buffer, its count is the number of vectors processed
+** @param out: The result, holding at least a->count vectors (may alias a)
+** @returns: N/A
+*/
+MVLADEF void v4d_soa_normalize_fast(const v4d_soa_t *a, v4d_soa_t *out);
+
+// -----------------------------------------
+
+/*
+** MATRIX BATCH FUNCTION PROTOTYPES
+**
+** Transforms apply one 4x4 matrix to every vector of an array or SoA buffer.
+** flags combines mvla_xform_flags_t values (0 for none). A matrix whose bottom
+** row is exactly (0, 0, 0, 1) takes the affine path on its own. 3D inputs take
+** w as 1 and keep x, y and z of the result. Arrays of more than
+** MVLA_PARALLEL_GRAIN vectors are split across threads (see mvla_threads_set).
+**
+** The inverse and determinant functions work on many matrices at once, one
+** matrix per SIMD lane, from structure-of-arrays buffers or from matrix arrays
+** gathered into that layout in chunks. Singular matrices invert to the zero
+** matrix like the single matrix forms and can be reported per matrix.
+*/
+
+/*
+** Transforms an array of 3D float vectors by a 4x4 matrix
+** @param m: The matrix to apply
+** @param a: The array of vectors to transform
+** @param out: The array receiving m * a[i] (may alias a)
+** @param n: The number of vectors in each array
+** @param flags: A combination of mvla_xform_flags_t
+** @returns: N/A
+*/
+MVLADEF void mat4x4f_transform_v3f_n(mat4x4f_t m, const v3f_t *a, v3f_t *out, size_t n, int flags);
+
+/*
+** Transforms an array of 4D float vectors by a 4x4 matrix
+** @param m: The matrix to apply
+** @param a: The array of vectors to transform
+** @param out: The array receiving m * a[i] (may alias a)
+** @param n: The number of vectors in each array
+** @param flags: A combination of mvla_xform_flags_t
+** @returns: N/A
+*/
+MVLADEF void mat4x4f_transform_v4f_n(mat4x4f_t m, const v4f_t *a, v4f_t *out, size_t n, int flags);
+
+/*
+** Transforms a 3D float structure-of-arrays buffer by a 4x4 matrix
+** @param m: The matrix to apply
+** @param a: The buffer of vectors to transform
+** @param out: The buffer receiving m * a[i], at least a->count long (may alias a)
+** @param flags: A combination of mvla_xform_flags_t
+** @returns: N/A
+*/
+MVLADEF void mat4x4f_transform_v3f_soa(mat4x4f_t m, const v3f_soa_t *a, v3f_soa_t *out, int flags);
+
+/*
+** Transforms a 4D float structure-of-arrays buffer by a 4x4 matrix
+** @param m: The matrix to apply
+** @param a: The buffer of vectors to transform
+** @param out: The buffer receiving m * a[i], at least a->count long (may alias a)
+** @param flags: A combination of mvla_xform_flags_t
+** @returns: N/A
+*/
+MVLADEF void mat4x4f_transform_v4f_soa(mat4x4f_t m, const v4f_soa_t *a, v4f_soa_t *out, int flags);
+
+/*
+** Transforms an array of 3D double vectors by a 4x4 matrix
+** @param m: The matrix to apply
+** @param a: The array of vectors to transform
+** @param out: The array receiving m * a[i] (may alias a)
+** @param n: The number of vectors in each array
+** @param flags: A combination of mvla_xform_flags_t
+** @returns: N/A
+*/
+MVLADEF void mat4x4d_transform_v3d_n(mat4x4d_t m, const v3d_t *a, v3d_t *out, size_t n, int flags);
+
+/*
+** Transforms an array of 4D double vectors by a 4x4 matrix
+** @param m: The matrix to apply
+** @param a: The array of vectors to transform
+** @param out: The array receiving m * a[i] (may alias a)
+** @param n: The number of vectors in each array
+** @param flags: A combination of mvla_xform_flags_t
+** @returns: N/A
+*/
+MVLADEF void mat4x4d_transform_v4d_n(mat4x4d_t m, const v4d_t *a, v4d_t *out, size_t n, int flags);
+
+/*
+** Transforms a 3D double structure-of-arrays buffer by a 4x4 matrix
+** @param m: The matrix to apply
+** @param a: The buffer of vectors to transform
+** @param out: The buffer receiving m * a[i], at least a->count long (may alias a)
+** @param flags: A combination of mvla_xform_flags_t
+** @returns: N/A
+*/
+MVLADEF void mat4x4d_transform_v3d_soa(mat4x4d_t m, const v3d_soa_t *a, v3d_soa_t *out, int flags);
+
+/*
+** Transforms a 4D double structure-of-arrays buffer by a 4x4 matrix
+** @param m: The matrix to apply
+** @param a: The buffer of vectors to transform
+** @param out: The buffer receiving m * a[i], at least a->count long (may alias a)
+** @param flags: A combination of mvla_xform_flags_t
+** @returns: N/A
+*/
+MVLADEF void mat4x4d_transform_v4d_soa(mat4x4d_t m, const v4d_soa_t *a, v4d_soa_t *out, int flags);
+
+// mat3x3f_soa_t
+
+/*
+** Allocates a 3x3 float matrix structure-of-arrays buffer
+** @param n: The number of matrices the buffer holds
+** @returns: A buffer with MVLA_SOA_ALIGN aligned element arrays, or NULL arrays and a count of 0 on failure
+*/
+MVLADEF mat3x3f_soa_t mat3x3f_soa_alloc(size_t n);
+
+/*
+** Frees a 3x3 float matrix structure-of-arrays buffer allocated by mat3x3f_soa_alloc
+** @param soa: The buffer to free, its arrays are reset to NULL
+** @returns: N/A
+*/
+MVLADEF void mat3x3f_soa_free(mat3x3f_soa_t *soa);
+
+/*
+** Reads one matrix out of a 3x3 float matrix structure-of-arrays buffer
+** @param soa: The buffer to read from
+** @param i: The index of the matrix
+** @returns: The matrix at index i
+*/
+MVLADEF mat3x3f_t mat3x3f_soa_get(const mat3x3f_soa_t *soa, size_t i);
+
+/*
+** Writes one matrix into a 3x3 float matrix structure-of-arrays buffer
+** @param soa: The buffer to write to
+** @param i: The index of the matrix
+** @param m: The matrix to store
+** @returns: N/A
+*/
+MVLADEF void mat3x3f_soa_set(mat3x3f_soa_t *soa, size_t i, mat3x3f_t m);
+
+/*
+** Finds the determinants of a 3x3 float matrix structure-of-arrays buffer
+** @param a: The buffer of matrices, its count is the number of matrices processed
+** @param out: The array receiving the determinants, at least a->count long
+** @returns: N/A
+*/
+MVLADEF void mat3x3f_soa_det(const mat3x3f_soa_t *a, float *out);
+
+/*
+** Inverts a 3x3 float matrix structure-of-arrays buffer
+** @param a: The buffer of matrices, its count is the number of matrices processed
+** @param out: The inverses, holding at least a->count matrices (may alias a)
+** @param singular: Set to 1 for each singular matrix and 0 otherwise, at least a->count long, or NULL
+** @returns: The number of singular matrices, whose inverses are the zero matrix
+*/
+MVLADEF size_t mat3x3f_soa_inverse(const mat3x3f_soa_t *a, mat3x3f_soa_t *out, unsigned char *singular);
+
+// mat3x3f_t
+
+/*
+** Finds the determinants of an array of 3x3 float matrices
+** @param a: The array of matrices
+** @param out: The array receiving the determinants
+** @param n: The number of matrices in the array
+** @returns: N/A
+*/
+MVLADEF void mat3x3f_det_n(const mat3x3f_t *a, float *out, size_t n);
+
+/*
+** Inverts an array of 3x3 float matrices
+** @param a: The array of matrices to invert
+** @param out: The array receiving the inverses (may alias a)
+** @param n: The number of matrices in each array
+** @param singular: Set to 1 for each singular matrix and 0 otherwise, n long, or NULL
+** @returns: The number of singular matrices, whose inverses are the zero matrix
+*/
+MVLADEF size_t mat3x3f_inverse_n(const mat3x3f_t *a, mat3x3f_t *out, size_t n, unsigned char *singular);
+
+// mat3x3d_soa_t
+
+/*
+** Allocates a 3x3 double matrix structure-of-arrays buffer
+** @param n: The number of matrices the buffer holds
+** @returns: A buffer with MVLA_SOA_ALIGN aligned element arrays, or NULL arrays and a count of 0 on failure
+*/
+MVLADEF mat3x3d_soa_t mat3x3d_soa_alloc(size_t n);
+
+/*
+** Frees a 3x3 double matrix structure-of-arrays buffer allocated by mat3x3d_soa_alloc
+** @param soa: The buffer to free, its arrays are reset to NULL
+** @returns: N/A
+*/
+MVLADEF void mat3x3d_soa_free(mat3x3d_soa_t *soa);
+
+/*
+** Reads one matrix out of a 3x3 double matrix structure-of-arrays buffer
+** @param soa: The buffer to read from
+** @param i: The index of the matrix
+** @returns: The matrix at index i
+*/
+MVLADEF mat3x3d_t mat3x3d_soa_get(const mat3x3d_soa_t *soa, size_t i);
+
+/*
+** Writes one matrix into a 3x3 double matrix structure-of-arrays buffer
+** @param soa: The buffer to write to
+** @param i: The index of the matrix
+** @param m: The matrix to store
+** @returns: N/A
+*/
+MVLADEF void mat3x3d_soa_set(mat3x3d_soa_t *soa, size_t i, mat3x3d_t m);
+
+/*
+** Finds the determinants of a 3x3 double matrix structure-of-arrays buffer
+** @param a: The buffer of matrices, its count is the number of matrices processed
+** @param out: The array receiving the determinants, at least a->count long
+** @returns: N/A
+*/
+MVLADEF void mat3x3d_soa_det(const mat3x3d_soa_t *a, double *out);
+
+/*
+** Inverts a 3x3 double matrix structure-of-arrays buffer
+** @param a: The buffer of matrices, its count is the number of matrices processed
+** @param out: The inverses, holding at least a->count matrices (may alias a)
+** @param singular: Set to 1 for each singular matrix and 0 otherwise, at least a->count long, or NULL
+** @returns: The number of singular matrices, whose inverses are the zero matrix
+*/
+MVLADEF size_t mat3x3d_soa_inverse(const mat3x3d_soa_t *a, mat3x3d_soa_t *out, unsigned char *singular);
+
+// mat3x3d_t
+
+/*
+** Finds the determinants of an array of 3x3 double matrices
+** @param a: The array of matrices
+** @param out: The array receiving the determinants
+** @param n: The number of matrices in the array
+** @returns: N/A
+*/
+MVLADEF void mat3x3d_det_n(const mat3x3d_t *a, double *out, size_t n);
+
+/*
+** Inverts an array of 3x3 double matrices
+** @param a: The array of matrices to invert
+** @param out: The array receiving the inverses (may alias a)
+** @param n: The number of matrices in each array
+** @param singular: Set to 1 for each singular matrix and 0 otherwise, n long, or NULL
+** @returns: The number of singular matrices, whose inverses are the zero matrix
+*/
+MVLADEF size_t mat3x3d_inverse_n(const mat3x3d_t *a, mat3x3d_t *out, size_t n, unsigned char *singular);
+
+// mat4x4f_soa_t
+
+/*
+** Allocates a 4x4 float matrix structure-of-arrays buffer
+** @param n: The number of matrices the buffer holds
+** @returns: A buffer with MVLA_SOA_ALIGN aligned element arrays, or NULL arrays and a count of 0 on failure
+*/
+MVLADEF mat4x4f_soa_t mat4x4f_soa_alloc(size_t n);
+
+/*
+** Frees a 4x4 float matrix structure-of-arrays buffer allocated by mat4x4f_soa_alloc
+** @param soa: The buffer to free, its arrays are reset to NULL
+** @returns: N/A
+*/
+MVLADEF void mat4x4f_soa_free(mat4x4f_soa_t *soa);
+
+/*
+** Reads one matrix out of a 4x4 float matrix structure-of-arrays buffer
+** @param soa: The buffer to read from
+** @param i: The index of the matrix
+** @returns: The matrix at index i
+*/
+MVLADEF mat4x4f_t mat4x4f_soa_get(const mat4x4f_soa_t *soa, size_t i);
+
+/*
+** Writes one matrix into a 4x4 float matrix structure-of-arrays buffer
+** @param soa: The buffer to write to
+** @param i: The index of the matrix
+** @param m: The matrix to store
+** @returns: N/A
+*/
+MVLADEF void mat4x4f_soa_set(mat4x4f_soa_t *soa, size_t i, mat4x4f_t m);
+
+/*
+** Finds the determinants of a 4x4 float matrix structure-of-arrays buffer
+** @param a: The buffer of matrices, its count is the number of matrices processed
+** @param out: The array receiving the determinants, at least a->count long
+** @returns: N/A
+*/
+MVLADEF void mat4x4f_soa_det(const mat4x4f_soa_t *a, float *out);
+
+/*
+** Inverts a 4x4 float matrix structure-of-arrays buffer
+** @param a: The buffer of matrices, its count is the number of matrices processed
+** @param out: The inverses, holding at least a->count matrices (may alias a)
+** @param singular: Set to 1 for each singular matrix and 0 otherwise, at least a->count long, or NULL
+** @returns: The number of singular matrices, whose inverses are the zero matrix
+*/
+MVLADEF size_t mat4x4f_soa_inverse(const mat4x4f_soa_t *a, mat4x4f_soa_t *out, unsigned char *singular);
+
+/*
+** Inverts a 4x4 float matrix structure-of-arrays buffer of rigid transforms (see mat4x4f_inverse_rigid)
+** @param a: The buffer of rigid matrices, its count is the number of matrices processed
+** @param out: The inverses, holding at least a->count matrices (may alias a)
+** @returns: N/A
+*/
+MVLADEF void mat4x4f_soa_inverse_rigid(const mat4x4f_soa_t *a, mat4x4f_soa_t *out);
+
+// mat4x4f_t
+
+/*
+** Finds the determinants of an array of 4x4 float matrices
+** @param a: The array of matrices
+** @param out: The array receiving the determinants
+** @param n: The number of matrices in the array
+** @returns: N/A
+*/
+MVLADEF void mat4x4f_det_n(const mat4x4f_t *a, float *out, size_t n);
+
+/*
+** Inverts an array of 4x4 float matrices
+** @param a: The array of matrices to invert
+** @param out: The array receiving the inverses (may alias a)
+** @param n: The number of matrices in each array
+** @param singular: Set to 1 for each singular matrix and 0 otherwise, n long, or NULL
+** @returns: The number of singular matrices, whose inverses are the zero matrix
+*/
+MVLADEF size_t mat4x4f_inverse_n(const mat4x4f_t *a, mat4x4f_t *out, size_t n, unsigned char *singular);
+
+/*
+** Inverts an array of rigid 4x4 float matrices (see mat4x4f_inverse_rigid)
+** @param a: The array of rigid matrices to invert
+** @param out: The array receiving the inverses (may alias a)
+** @param n: The number of matrices in each array
+** @returns: N/A
+*/
+MVLADEF void mat4x4f_inverse_rigid_n(const mat4x4f_t *a, mat4x4f_t *out, size_t n);
+
+// mat4x4d_soa_t
+
+/*
+** Allocates a 4x4 double matrix structure-of-arrays buffer
+** @param n: The number of matrices the buffer holds
+** @returns: A buffer with MVLA_SOA_ALIGN aligned element arrays, or NULL arrays and a count of 0 on failure
+*/
+MVLADEF mat4x4d_soa_t mat4x4d_soa_alloc(size_t n);
+
+/*
+** Frees a 4x4 double matrix structure-of-arrays buffer allocated by mat4x4d_soa_alloc
+** @param soa: The buffer to free, its arrays are reset to NULL
+** @returns: N/A
+*/
+MVLADEF void mat4x4d_soa_free(mat4x4d_soa_t *soa);
+
+/*
+** Reads one matrix out of a 4x4 double matrix structure-of-arrays buffer
+** @param soa: The buffer to read from
+** @param i: The index of the matrix
+** @returns: The matrix at index i
+*/
+MVLADEF mat4x4d_t mat4x4d_soa_get(const mat4x4d_soa_t *soa, size_t i);
+
+/*
+** Writes one matrix into a 4x4 double matrix structure-of-arrays buffer
+** @param soa: The buffer to write to
+** @param i: The index of the matrix
+** @param m: The matrix to store
+** @returns: N/A
+*/
+MVLADEF void mat4x4d_soa_set(mat4x4d_soa_t *soa, size_t i, mat4x4d_t m);
+
+/*
+** Finds the determinants of a 4x4 double matrix structure-of-arrays buffer
+** @param a: The buffer of matrices, its count is the number of matrices processed
+** @param out: The array receiving the determinants, at least a->count long
+** @returns: N/A
+*/
+MVLADEF void mat4x4d_soa_det(const mat4x4d_soa_t *a, double *out);
+
+/*
+** Inverts a 4x4 double matrix structure-of-arrays buffer
+** @param a: The buffer of matrices, its count is the number of matrices processed
+** @param out: The inverses, holding at least a->count matrices (may alias a)
+** @param singular: Set to 1 for each singular matrix and 0 otherwise, at least a->count long, or NULL
+** @returns: The number of singular matrices, whose inverses are the zero matrix
+*/
+MVLADEF size_t mat4x4d_soa_inverse(const mat4x4d_soa_t *a, mat4x4d_soa_t *out, unsigned char *singular);
+
+/*
+** Inverts a 4x4 double matrix structure-of-arrays buffer of rigid transforms (see mat4x4d_inverse_rigid)
+** @param a: The buffer of rigid matrices, its count is the number of matrices processed
+** @param out: The inverses, holding at least a->count matrices (may alias a)
+** @returns: N/A
+*/
+MVLADEF void mat4x4d_soa_inverse_rigid(const mat4x4d_soa_t *a, mat4x4d_soa_t *out);
+
+// mat4x4d_t
+
+/*
+** Finds the determinants of an array of 4x4 double matrices
+** @param a: The array of matrices
+** @param out: The array receiving the determinants
+** @param n: The number of matrices in the array
+** @returns: N/A
+*/
+MVLADEF void mat4x4d_det_n(const mat4x4d_t *a, double *out, size_t n);
+
+/*
+** Inverts an array of 4x4 double matrices
+** @param a: The array of matrices to invert
+** @param out: The array receiving the inverses (may alias a)
+** @param n: The number of matrices in each array
+** @param singular: Set to 1 for each singular matrix and 0 otherwise, n long, or NULL
+** @returns: The number of singular matrices, whose inverses are the zero matrix
+*/
+MVLADEF size_t mat4x4d_inverse_n(const mat4x4d_t *a, mat4x4d_t *out, size_t n, unsigned char *singular);
+
+/*
+** Inverts an array of rigid 4x4 double matrices (see mat4x4d_inverse_rigid)
+** @param a: The array of rigid matrices to invert
+** @param out: The array receiving the inverses (may alias a)
+** @param n: The number of matrices in each array
+** @returns: N/A
+*/
+MVLADEF void mat4x4d_inverse_rigid_n(const mat4x4d_t *a, mat4x4d_t *out, size_t n);
+
+// -----------------------------------------
+
+/*
+** DYNAMIC VECTOR FUNCTION PROTOTYPES
+**
+** The operations run over a->len components through the batch kernels, so
+** they are SIMD loops with scalar tails. Other operands must be at least as
+** long as a and outputs may alias the inputs.
+*/
+
+// mvla_vecf_t
+
+/*
+** Allocates a dynamic float vector
+** @param len: The number of components
+** @returns: A vector with MVLA_SOA_ALIGN aligned, uninitialized components, or NULL data and a len of 0 on failure
+*/
+MVLADEF mvla_vecf_t mvla_vecf_alloc(size_t len);
+
+/*
+** Wraps caller owned storage, such as an arena block, as a dynamic float vector
+** @param data: The components, not freed by the vector
+** @param len: The number of components
+** @returns: The vector viewing data
+*/
+MVLADEF mvla_vecf_t mvla_vecf_wrap(float *data, size_t len);
+
+/*
+** Frees a dynamic float vector allocated by mvla_vecf_alloc
+** @param v: The vector to free, its data is reset to NULL
+** @returns: N/A
+*/
+MVLADEF void mvla_vecf_free(mvla_vecf_t *v);
+
+/*
+** Sets every component of a dynamic float vector
+** @param v: The vector to fill
+** @param value: The value to store
+** @returns: N/A
+*/
+MVLADEF void mvla_vecf_fill(mvla_vecf_t *v, float value);
+
+/*
+** Adds two dynamic float vectors
+** @param a: The first vector, its len is the number of components processed
+** @param b: The second vector
+** @param out: The sums
+** @returns: N/A
+*/
+MVLADEF void mvla_vecf_add(const mvla_vecf_t *a, const mvla_vecf_t *b, mvla_vecf_t *out);
+
+/*
+** Subtracts one dynamic float vector from another
+** @param a: The vector to subtract from, its len is the number of components processed
+** @param b: The vector to subtract
+** @param out: The differences
+** @returns: N/A
+*/
+MVLADEF void mvla_vecf_sub(const mvla_vecf_t *a, const mvla_vecf_t *b, mvla_vecf_t *out);
+
+/*
+** Multiplies two dynamic float vectors
+** @param a: The first vector, its len is the number of components processed
+** @param b: The second vector
+** @param out: The products
+** @returns: N/A
+*/
+MVLADEF void mvla_vecf_mul(const mvla_vecf_t *a, const mvla_vecf_t *b, mvla_vecf_t *out);
+
+/*
+** Divides one dynamic float vector by another
+** @param a: The dividend, its len is the number of components processed
+** @param b: The divisor
+** @param out: The quotients
+** @returns: N/A
+*/
+MVLADEF void mvla_vecf_div(const mvla_vecf_t *a, const mvla_vecf_t *b, mvla_vecf_t *out);
+
+/*
+** Finds the component-wise minimum of two dynamic float vectors
+** @param a: The first vector, its len is the number of components processed
+** @param b: The second vector
+** @param out: The minimums
+** @returns: N/A
+*/
+MVLADEF void mvla_vecf_min(const mvla_vecf_t *a, const mvla_vecf_t *b, mvla_vecf_t *out);
+
+/*
+** Finds the component-wise maximum of two dynamic float vectors
+** @param a: The first vector, its len is the number of components processed
+** @param b: The second vector
+** @param out: The maximums
+** @returns: N/A
+*/
+MVLADEF void mvla_vecf_max(const mvla_vecf_t *a, const mvla_vecf_t *b, mvla_vecf_t *out);
+
+/*
+** Finds the square root of each component of a dynamic float vector
+** @param a: The input vector
+** @param out: The results
+** @returns: N/A
+*/
+MVLADEF void mvla_vecf_sqrt(const mvla_vecf_t *a, mvla_vecf_t *out);
+
+/*
+** Raises e to each component of a dynamic float vector
+** @param a: The input vector
+** @param out: The results
+** @returns: N/A
+*/
+MVLADEF void mvla_vecf_exp(const mvla_vecf_t *a, mvla_vecf_t *out);
+
+/*
+** Scales a dynamic float vector
+** @param a: The vector to scale
+** @param s: The scale factor
+** @param out: The scaled vector
+** @returns: N/A
+*/
+MVLADEF void mvla_vecf_scale(const mvla_vecf_t *a, float s, mvla_vecf_t *out);
+
+/*
+** Finds the dot product of two dynamic float vectors
+** @param a: The first vector, its len is the number of components processed
+** @param b: The second vector
+** @returns: The dot product of a and b
+*/
+MVLADEF float mvla_vecf_dot(const mvla_vecf_t *a, const mvla_vecf_t *b);
+
+/*
+** Finds the length of a dynamic float vector (see nrm2f_n)
+** @param a: The vector
+** @returns: The euclidean length of a
+*/
+MVLADEF float mvla_vecf_len(const mvla_vecf_t *a);
+
+/*
+** Finds the squared length of a dynamic float vector
+** @param a: The vector
+** @returns: The squared euclidean length of a
+*/
+MVLADEF float mvla_vecf_sqr_len(const mvla_vecf_t *a);
+
+// mvla_vecd_t
+
+/*
+** Allocates a dynamic double vector
+** @param len: The number of components
+** @returns: A vector with MVLA_SOA_ALIGN aligned, uninitialized components, or NULL data and a len of 0 on failure
+*/
+MVLADEF mvla_vecd_t mvla_vecd_alloc(size_t len);
+
+/*
+** Wraps caller owned storage, such as an arena block, as a dynamic double vector
+** @param data: The components, not freed by the vector
+** @param len: The number of components
+** @returns: The vector viewing data
+*/
+MVLADEF mvla_vecd_t mvla_vecd_wrap(double *data, size_t len);
+
+/*
+** Frees a dynamic double vector allocated by mvla_vecd_alloc
+** @param v: The vector to free, its data is reset to NULL
+** @returns: N/A
+*/
+MVLADEF void mvla_vecd_free(mvla_vecd_t *v);
+
+/*
+** Sets every component of a dynamic double vector
+** @param v: The vector to fill
+** @param value: The value to store
+** @returns: N/A
+*/
+MVLADEF void mvla_vecd_fill(mvla_vecd_t *v, double value);
+
+/*
+** Adds two dynamic double vectors
+** @param a: The first vector, its len is the number of components processed
+** @param b: The second vector
+** @param out: The sums
+** @returns: N/A
+*/
+MVLADEF void mvla_vecd_add(const mvla_vecd_t *a, const mvla_vecd_t *b, mvla_vecd_t *out);
+
+/*
+** Subtracts one dynamic double vector from another
+** @param a: The vector to subtract from, its len is the number of components processed
+** @param b: The vector to subtract
+** @param out: The differences
+** @returns: N/A
+*/
+MVLADEF void mvla_vecd_sub(const mvla_vecd_t *a, const mvla_vecd_t *b, mvla_vecd_t *out);
+
+/*
+** Multiplies two dynamic double vectors
+** @param a: The first vector, its len is the number of components processed
+** @param b: The second vector
+** @param out: The products
+** @returns: N/A
+*/
+MVLADEF void mvla_vecd_mul(const mvla_vecd_t *a, const mvla_vecd_t *b, mvla_vecd_t *out);
+
+/*
+** Divides one dynamic double vector by another
+** @param a: The dividend, its len is the number of components processed
+** @param b: The divisor
+** @param out: The quotients
+** @returns: N/A
+*/
+MVLADEF void mvla_vecd_div(const mvla_vecd_t *a, const mvla_vecd_t *b, mvla_vecd_t *out);
+
+/*
+** Finds the component-wise minimum of two dynamic double vectors
+** @param a: The first vector, its len is the number of components processed
+** @param b: The second vector
+** @param out: The minimums
+** @returns: N/A
+*/
+MVLADEF void mvla_vecd_min(const mvla_vecd_t *a, const mvla_vecd_t *b, mvla_vecd_t *out);
+
+/*
+** Finds the component-wise maximum of two dynamic double vectors
+** @param a: The first vector, its len is the number of components processed
+** @param b: The second vector
+** @param out: The maximums
+** @returns: N/A
+*/
+MVLADEF void mvla_vecd_max(const mvla_vecd_t *a, const mvla_vecd_t *b, mvla_vecd_t *out);
+
+/*
+** Finds the square root of each component of a dynamic double vector
+** @param a: The input vector
+** @param out: The results
+** @returns: N/A
+*/
+MVLADEF void mvla_vecd_sqrt(const mvla_vecd_t *a, mvla_vecd_t *out);
+
+/*
+** Raises e to each component of a dynamic double vector
+** @param a: The input vector
+** @param out: The results
+** @returns: N/A
+*/
+MVLADEF void mvla_vecd_exp(const mvla_vecd_t *a, mvla_vecd_t *out);
+
+/*
+** Scales a dynamic double vector
+** @param a: The vector to scale
+** @param s: The scale factor
+** @param out: The scaled vector
+** @returns: N/A
+*/
+MVLADEF void mvla_vecd_scale(const mvla_vecd_t *a, double s, mvla_vecd_t *out);
+
+/*
+** Finds the dot product of two dynamic double vectors
+** @param a: The first vector, its len is the number of components processed
+** @param b: The second vector
+** @returns: The dot product of a and b
+*/
+MVLADEF double mvla_vecd_dot(const mvla_vecd_t *a, const mvla_vecd_t *b);
+
+/*
+** Finds the length of a dynamic double vector (see nrm2d_n)
+** @param a: The vector
+** @returns: The euclidean length of a
+*/
+MVLADEF double mvla_vecd_len(const mvla_vecd_t *a);
+
+/*
+** Finds the squared length of a dynamic double vector
+** @param a: The vector
+** @returns: The squared euclidean length of a
+*/
+MVLADEF double mvla_vecd_sqr_len(const mvla_vecd_t *a);
+
+// -----------------------------------------
+
+/*
+** DENSE MATRIX FUNCTION PROTOTYPES
+**
+** gemm follows the BLAS convention on column-major storage: C = alpha *
+** op(A) * op(B) + beta * C, where op transposes its operand for MVLA_TRANS.
+** C is not read when beta is 0. It packs A and B into micro-tile order and
+** blocks for the caches (see MVLA_GEMM_MC, MVLA_GEMM_KC and MVLA_GEMM_NC).
+** gemv is the matrix-vector form, y is likewise not read when beta is 0.
+** Large products are split across threads (see mvla_threads_set) and give
+** the same result for any thread count.
+*/
+
+/*
+** Multiplies two column-major float matrices into a third, C = alpha * op(A) * op(B) + beta * C
+** @param transa: Whether A is used transposed
+** @param transb: Whether B is used transposed
+** @param m: The number of rows of op(A) and C
+** @param n: The number of columns of op(B) and C
+** @param k: The number of columns of op(A) and rows of op(B)
+** @param alpha: The scale of the product
+** @param a: The elements of A
+** @param lda: The leading dimension of A
+** @param b: The elements of B
+** @param ldb: The leading dimension of B
+** @param beta: The scale of the existing C, 0 to overwrite it
+** @param c: The elements of C, must not overlap A or B
+** @param ldc: The leading dimension of C
+** @returns: N/A
+*/
+MVLADEF void gemmf(mvla_trans_t transa, mvla_trans_t transb, size_t m, size_t n, size_t k,
+                   float alpha, const float *a, size_t lda, const float *b, size_t ldb,
+                   float beta, float *c, size_t ldc);
+
+/*
+** Multiplies a column-major float matrix by a vector, y = alpha * op(A) * x + beta * y
+** @param trans: Whether A is used transposed
+** @param m: The number of rows of A
+** @param n: The number of columns of A
+** @param alpha: The scale of the product
+** @param a: The elements of A
+** @param lda: The leading dimension of A
+** @param x: The vector to multiply, n long (m when transposed)
+** @param beta: The scale of the existing y, 0 to overwrite it
+** @param y: The vector receiving the result, m long (n when transposed), must not overlap A or x
+** @returns: N/A
+*/
+MVLADEF void gemvf(mvla_trans_t trans, size_t m, size_t n, float alpha, const float *a,
+                   size_t lda, const float *x, float beta, float *y);
+
+// mvla_matf_t
+
+/*
+** Allocates a dense float matrix
+** @param rows: The number of rows
+** @param cols: The number of columns
+** @returns: A matrix with MVLA_SOA_ALIGN aligned, uninitialized columns, or NULL data and no rows or columns on failure
+*/
+MVLADEF mvla_matf_t mvla_matf_alloc(size_t rows, size_t cols);
+
+/*
+** Wraps caller owned column-major storage as a dense float matrix
+** @param data: The elements, not freed by the matrix
+** @param rows: The number of rows
+** @param cols: The number of columns
+** @param ld: The distance between the starts of two columns, at least rows
+** @returns: The matrix viewing data
+*/
+MVLADEF mvla_matf_t mvla_matf_wrap(float *data, size_t rows, size_t cols, size_t ld);
+
+/*
+** Frees a dense float matrix allocated by mvla_matf_alloc
+** @param m: The matrix to free, its data is reset to NULL
+** @returns: N/A
+*/
+MVLADEF void mvla_matf_free(mvla_matf_t *m);
+
+/*
+** Reads one element of a dense float matrix
+** @param m: The matrix to read from
+** @param i: The row of the element
+** @param j: The column of the element
+** @returns: The element at row i and column j
+*/
+MVLADEF float mvla_matf_get(const mvla_matf_t *m, size_t i, size_t j);
+
+/*
+** Writes one element of a dense float matrix
+** @param m: The matrix to write to
+** @param i: The row of the element
+** @param j: The column of the element
+** @param value: The value to store
+** @returns: N/A
+*/
+MVLADEF void mvla_matf_set(mvla_matf_t *m, size_t i, size_t j, float value);
+
+/*
+** Multiplies two dense float matrices into a third (see gemmf)
+** @param transa: Whether a is used transposed
+** @param transb: Whether b is used transposed
+** @param alpha: The scale of the product
+** @param a: The left matrix, op(a) must have c->rows rows
+** @param b: The right matrix, op(b) must have c->cols columns and as many rows as op(a) has columns
+** @param beta: The scale of the existing c, 0 to overwrite it
+** @param c: The matrix receiving alpha * op(a) * op(b) + beta * c
+** @returns: N/A
+*/
+MVLADEF void mvla_matf_gemm(mvla_trans_t transa, mvla_trans_t transb, float alpha, const mvla_matf_t *a,
+                        const mvla_matf_t *b, float beta, mvla_matf_t *c);
+
+/*
+** Multiplies a dense float matrix by a dynamic vector (see gemvf)
+** @param trans: Whether a is used transposed
+** @param alpha: The scale of the product
+** @param a: The matrix
+** @param x: The vector to multiply, as long as op(a) has columns
+** @param beta: The scale of the existing y, 0 to overwrite it
+** @param y: The vector receiving alpha * op(a) * x + beta * y, as long as op(a) has rows
+** @returns: N/A
+*/
+MVLADEF void mvla_matf_gemv(mvla_trans_t trans, float alpha, const mvla_matf_t *a,
+                         const mvla_vecf_t *x, float beta, mvla_vecf_t *y);
+
+/*
+** Multiplies two column-major double matrices into a third, C = alpha * op(A) * op(B) + beta * C
+** @param transa: Whether A is used transposed
+** @param transb: Whether B is used transposed
+** @param m: The number of rows of op(A) and C
+** @param n: The number of columns of op(B) and C
+** @param k: The number of columns of op(A) and rows of op(B)
+** @param alpha: The scale of the product
+** @param a: The elements of A
+** @param lda: The leading dimension of A
+** @param b: The elements of B
+** @param ldb: The leading dimension of B
+** @param beta: The scale of the existing C, 0 to overwrite it
+** @param c: The elements of C, must not overlap A or B
+** @param ldc: The leading dimension of C
+** @returns: N/A
+*/
+MVLADEF void gemmd(mvla_trans_t transa, mvla_trans_t transb, size_t m, size_t n, size_t k,
+                   double alpha, const double *a, size_t lda, const double *b, size_t ldb,
+                   double beta, double *c, size_t ldc);
+
+/*
+** Multiplies a column-major double matrix by a vector, y = alpha * op(A) * x + beta * y
+** @param trans: Whether A is used transposed
+** @param m: The number of rows of A
+** @param n: The number of columns of A
+** @param alpha: The scale of the product
+** @param a: The elements of A
+** @param lda: The leading dimension of A
+** @param x: The vector to multiply, n long (m when transposed)
+** @param beta: The scale of the existing y, 0 to overwrite it
+** @param y: The vector receiving the result, m long (n when transposed), must not overlap A or x
+** @returns: N/A
+*/
+MVLADEF void gemvd(mvla_trans_t trans, size_t m, size_t n, double alpha, const double *a,
+                   size_t lda, const double *x, double beta, double *y);
+
+// mvla_matd_t
+
+/*
+** Allocates a dense double matrix
+** @param rows: The number of rows
+** @param cols: The number of columns
+** @returns: A matrix with MVLA_SOA_ALIGN aligned, uninitialized columns, or NULL data and no rows or columns on failure
+*/
+MVLADEF mvla_matd_t mvla_matd_alloc(size_t rows, size_t cols);
+
+/*
+** Wraps caller owned column-major storage as a dense double matrix
+** @param data: The elements, not freed by the matrix
+** @param rows: The number of rows
+** @param cols: The number of columns
+** @param ld: The distance between the starts of two columns, at least rows
+** @returns: The matrix viewing data
+*/
+MVLADEF mvla_matd_t mvla_matd_wrap(double *data, size_t rows, size_t cols, size_t ld);
+
+/*
+** Frees a dense double matrix allocated by mvla_matd_alloc
+** @param m: The matrix to free, its data is reset to NULL
+** @returns: N/A
+*/
+MVLADEF void mvla_matd_free(mvla_matd_t *m);
+
+/*
+** Reads one element of a dense double matrix
+** @param m: The matrix to read from
+** @param i: The row of the element
+** @param j: The column of the element
+** @returns: The element at row i and column j
+*/
+MVLADEF double mvla_matd_get(const mvla_matd_t *m, size_t i, size_t j);
+
+/*
+** Writes one element of a dense double matrix
+** @param m: The matrix to write to
+** @param i: The row of the element
+** @param j: The column of the element
+** @param value: The value to store
+** @returns: N/A
+*/
+MVLADEF void mvla_matd_set(mvla_matd_t *m, size_t i, size_t j, double value);
+
+/*
+** Multiplies two dense double matrices into a third (see gemmd)
+** @param transa: Whether a is used transposed
+** @param transb: Whether b is used transposed
+** @param alpha: The scale of the product
+** @param a: The left matrix, op(a) must have c->rows rows
+** @param b: The right matrix, op(b) must have c->cols columns and as many rows as op(a) has columns
+** @param beta: The scale of the existing c, 0 to overwrite it
+** @param c: The matrix receiving alpha * op(a) * op(b) + beta * c
+** @returns: N/A
+*/
+MVLADEF void mvla_matd_gemm(mvla_trans_t transa, mvla_trans_t transb, double alpha, const mvla_matd_t *a,
+                        const mvla_matd_t *b, double beta, mvla_matd_t *c);
+
+/*
+** Multiplies a dense double matrix by a dynamic vector (see gemvd)
+** @param trans: Whether a is used transposed
+** @param alpha: The scale of the product
+** @param a: The matrix
+** @param x: The vector to multiply, as long as op(a) has columns
+** @param beta: The scale of the existing y, 0 to overwrite it
+** @param y: The vector receiving alpha * op(a) * x + beta * y, as long as op(a) has rows
+** @returns: N/A
+*/
+MVLADEF void mvla_matd_gemv(mvla_trans_t trans, double alpha, const mvla_matd_t *a,
+                         const mvla_vecd_t *x, double beta, mvla_vecd_t *y);
+
+// -----------------------------------------
+
+/*
+** LAYOUT CONVERSION FUNCTION PROTOTYPES
+**
+** Bulk conversions between interleaved (AoS) vector arrays, structure-of-arrays
+** buffers and padded v4 arrays. Inputs and outputs must not overlap.
+*/
+
+// v2i_soa_t
+
+/*
+** Fills a 2D integer structure-of-arrays buffer from an array of vectors
+** @param soa: The buffer to fill, its count is the number of vectors copied
+** @param a: The array of at least soa->count vectors to read
+** @returns: N/A
+*/
+MVLADEF void v2i_soa_from_aos(v2i_soa_t *soa, const v2i_t *a);
+
+/*
+** Writes a 2D integer structure-of-arrays buffer out as an array of vectors
+** @param soa: The buffer to read, its count is the number of vectors copied
+** @param out: The array receiving soa->count vectors
+** @returns: N/A
+*/
+MVLADEF void v2i_soa_to_aos(const v2i_soa_t *soa, v2i_t *out);
+
+/*
+** Fills a 3D integer structure-of-arrays buffer from an array of vectors
+** @param soa: The buffer to fill, its count is the number of vectors copied
+** @param a: The array of at least soa->count vectors to read
+** @returns: N/A
+*/
+MVLADEF void v3i_soa_from_aos(v3i_soa_t *soa, const v3i_t *a);
+
+/*
+** Writes a 3D integer structure-of-arrays buffer out as an array of vectors
+** @param soa: The buffer to read, its count is the number of vectors copied
+** @param out: The array receiving soa->count vectors
+** @returns: N/A
+*/
+MVLADEF void v3i_soa_to_aos(const v3i_soa_t *soa, v3i_t *out);
+
+/*
+** Fills a 4D integer structure-of-arrays buffer from an array of vectors
+** @param soa: The buffer to fill, its count is the number of vectors copied
+** @param a: The array of at least soa->count vectors to read
+** @returns: N/A
+*/
+MVLADEF void v4i_soa_from_aos(v4i_soa_t *soa, const v4i_t *a);
+
+/*
+** Writes a 4D integer structure-of-arrays buffer out as an array of vectors
+** @param soa: The buffer to read, its count is the number of vectors copied
+** @param out: The array receiving soa->count vectors
+** @returns: N/A
+*/
+MVLADEF void v4i_soa_to_aos(const v4i_soa_t *soa, v4i_t *out);
+
+/*
+** Widens an array of 3D integer vectors into 4D vectors with a constant w
+** @param a: The array of vectors to widen
+** @param w: The w component given to every output vector
+** @param out: The array receiving n padded vectors
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3i_pad_n(const v3i_t *a, signed int w, v4i_t *out, size_t n);
+
+/*
+** Narrows an array of 4D integer vectors into 3D vectors, dropping w
+** @param a: The array of vectors to narrow
+** @param out: The array receiving n 3D vectors
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4i_unpad_n(const v4i_t *a, v3i_t *out, size_t n);
+
+// v2u_soa_t
+
+/*
+** Fills a 2D unsigned integer structure-of-arrays buffer from an array of vectors
+** @param soa: The buffer to fill, its count is the number of vectors copied
+** @param a: The array of at least soa->count vectors to read
+** @returns: N/A
+*/
+MVLADEF void v2u_soa_from_aos(v2u_soa_t *soa, const v2u_t *a);
+
+/*
+** Writes a 2D unsigned integer structure-of-arrays buffer out as an array of vectors
+** @param soa: The buffer to read, its count is the number of vectors copied
+** @param out: The array receiving soa->count vectors
+** @returns: N/A
+*/
+MVLADEF void v2u_soa_to_aos(const v2u_soa_t *soa, v2u_t *out);
+
+/*
+** Fills a 3D unsigned integer structure-of-arrays buffer from an array of vectors
+** @param soa: The buffer to fill, its count is the number of vectors copied
+** @param a: The array of at least soa->count vectors to read
+** @returns: N/A
+*/
+MVLADEF void v3u_soa_from_aos(v3u_soa_t *soa, const v3u_t *a);
+
+/*
+** Writes a 3D unsigned integer structure-of-arrays buffer out as an array of vectors
+** @param soa: The buffer to read, its count is the number of vectors copied
+** @param out: The array receiving soa->count vectors
+** @returns: N/A
+*/
+MVLADEF void v3u_soa_to_aos(const v3u_soa_t *soa, v3u_t *out);
+
+/*
+** Fills a 4D unsigned integer structure-of-arrays buffer from an array of vectors
+** @param soa: The buffer to fill, its count is the number of vectors copied
+** @param a: The array of at least soa->count vectors to read
+** @returns: N/A
+*/
+MVLADEF void v4u_soa_from_aos(v4u_soa_t *soa, const v4u_t *a);
+
+/*
+** Writes a 4D unsigned integer structure-of-arrays buffer out as an array of vectors
+** @param soa: The buffer to read, its count is the number of vectors copied
+** @param out: The array receiving soa->count vectors
+** @returns: N/A
+*/
+MVLADEF void v4u_soa_to_aos(const v4u_soa_t *soa, v4u_t *out);
+
+/*
+** Widens an array of 3D unsigned integer vectors into 4D vectors with a constant w
+** @param a: The array of vectors to widen
+** @param w: The w component given to every output vector
+** @param out: The array receiving n padded vectors
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3u_pad_n(const v3u_t *a, unsigned int w, v4u_t *out, size_t n);
+
+/*
+** Narrows an array of 4D unsigned integer vectors into 3D vectors, dropping w
+** @param a: The array of vectors to narrow
+** @param out: The array receiving n 3D vectors
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4u_unpad_n(const v4u_t *a, v3u_t *out, size_t n);
+
+// v2f_soa_t
+
+/*
+** Fills a 2D float structure-of-arrays buffer from an array of vectors
+** @param soa: The buffer to fill, its count is the number of vectors copied
+** @param a: The array of at least soa->count vectors to read
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_from_aos(v2f_soa_t *soa, const v2f_t *a);
+
+/*
+** Writes a 2D float structure-of-arrays buffer out as an array of vectors
+** @param soa: The buffer to read, its count is the number of vectors copied
+** @param out: The array receiving soa->count vectors
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_to_aos(const v2f_soa_t *soa, v2f_t *out);
+
+/*
+** Fills a 3D float structure-of-arrays buffer from an array of vectors
+** @param soa: The buffer to fill, its count is the number of vectors copied
+** @param a: The array of at least soa->count vectors to read
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_from_aos(v3f_soa_t *soa, const v3f_t *a);
+
+/*
+** Writes a 3D float structure-of-arrays buffer out as an array of vectors
+** @param soa: The buffer to read, its count is the number of vectors copied
+** @param out: The array receiving soa->count vectors
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_to_aos(const v3f_soa_t *soa, v3f_t *out);
+
+/*
+** Fills a 4D float structure-of-arrays buffer from an array of vectors
+** @param soa: The buffer to fill, its count is the number of vectors copied
+** @param a: The array of at least soa->count vectors to read
+** @returns: N/A
+*/
+MVLADEF void v4f_soa_from_aos(v4f_soa_t *soa, const v4f_t *a);
+
+/*
+** Writes a 4D float structure-of-arrays buffer out as an array of vectors
+** @param soa: The buffer to read, its count is the number of vectors copied
+** @param out: The array receiving soa->count vectors
+** @returns: N/A
+*/
+MVLADEF void v4f_soa_to_aos(const v4f_soa_t *soa, v4f_t *out);
+
+/*
+** Widens an array of 3D float vectors into 4D vectors with a constant w
+** @param a: The array of vectors to widen
+** @param w: The w component given to every output vector
+** @param out: The array receiving n padded vectors
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3f_pad_n(const v3f_t *a, float w, v4f_t *out, size_t n);
+
+/*
+** Narrows an array of 4D float vectors into 3D vectors, dropping w
+** @param a: The array of vectors to narrow
+** @param out: The array receiving n 3D vectors
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4f_unpad_n(const v4f_t *a, v3f_t *out, size_t n);
+
+// v2d_soa_t
+
+/*
+** Fills a 2D double structure-of-arrays buffer from an array of vectors
+** @param soa: The buffer to fill, its count is the number of vectors copied
+** @param a: The array of at least soa->count vectors to read
+** @returns: N/A
+*/
+MVLADEF void v2d_soa_from_aos(v2d_soa_t *soa, const v2d_t *a);
+
+/*
+** Writes a 2D double structure-of-arrays buffer out as an array of vectors
+** @param soa: The buffer to read, its count is the number of vectors copied
+** @param out: The array receiving soa->count vectors
+** @returns: N/A
+*/
+MVLADEF void v2d_soa_to_aos(const v2d_soa_t *soa, v2d_t *out);
+
+/*
+** Fills a 3D double structure-of-arrays buffer from an array of vectors
+** @param soa: The buffer to fill, its count is the number of vectors copied
+** @param a: The array of at least soa->count vectors to read
+** @returns: N/A
+*/
+MVLADEF void v3d_soa_from_aos(v3d_soa_t *soa, const v3d_t *a);
+
+/*
+** Writes a 3D double structure-of-arrays buffer out as an array of vectors
+** @param soa: The buffer to read, its count is the number of vectors copied
+** @param out: The array receiving soa->count vectors
+** @returns: N/A
+*/
+MVLADEF void v3d_soa_to_aos(const v3d_soa_t *soa, v3d_t *out);
+
+/*
+** Fills a 4D double structure-of-arrays buffer from an array of vectors
+** @param soa: The buffer to fill, its count is the number of vectors copied
+** @param a: The array of at least soa->count vectors to read
+** @returns: N/A
+*/
+MVLADEF void v4d_soa_from_aos(v4d_soa_t *soa, const v4d_t *a);
+
+/*
+** Writes a 4D double structure-of-arrays buffer out as an array of vectors
+** @param soa: The buffer to read, its count is the number of vectors copied
+** @param out: The array receiving soa->count vectors
+** @returns: N/A
+*/
+MVLADEF void v4d_soa_to_aos(const v4d_soa_t *soa, v4d_t *out);
+
+/*
+** Widens an array of 3D double vectors into 4D vectors with a constant w
+** @param a: The array of vectors to widen
+** @param w: The w component given to every output vector
+** @param out: The array receiving n padded vectors
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3d_pad_n(const v3d_t *a, double w, v4d_t *out, size_t n);
+
+/*
+** Narrows an array of 4D double vectors into 3D vectors, dropping w
+** @param a: The array of vectors to narrow
+** @param out: The array receiving n 3D vectors
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4d_unpad_n(const v4d_t *a, v3d_t *out, size_t n);
+
+// -----------------------------------------
+
+/*
+** FAST MATH FUNCTION PROTOTYPES
+**
+** Polynomial approximations of the libm functions, vectorized in the batch
+** forms. Error bounds are the largest seen by bench/ulp.c against a correctly
+** rounded reference and hold for every dispatch tier. Inputs outside the
+** range a polynomial covers (huge arguments, NaN, inf, zero, denormals) are
+** passed to libm, so the special cases behave like libm.
+*/
+
+/*
+** Approximates e raised to a float (1.3 ulp, polynomial for -87.3 <= a <= 88.3, libm outside)
+** @param a: The input value
+** @returns: The approximation of expf(a)
+*/
+MVLADEF float expf_fast(float a);
+
+/*
+** Approximates the natural logarithm of a float (0.9 ulp, polynomial for normal positive a, libm otherwise)
+** @param a: The input value
+** @returns: The approximation of logf(a)
+*/
+MVLADEF float logf_fast(float a);
+
+/*
+** Approximates the sine of a float (2.4 ulp, polynomial for |a| <= 8192, libm outside)
+** @param a: The input value
+** @returns: The approximation of sinf(a)
+*/
+MVLADEF float sinf_fast(float a);
+
+/*
+** Approximates the cosine of a float (2.3 ulp, polynomial for |a| <= 8192, libm outside)
+** @param a: The input value
+** @returns: The approximation of cosf(a)
+*/
+MVLADEF float cosf_fast(float a);
+
+/*
+** Approximates the tangent of a float (3.8 ulp, polynomial for |a| <= 8192, libm outside)
+** @param a: The input value
+** @returns: The approximation of tanf(a)
+*/
+MVLADEF float tanf_fast(float a);
+
+/*
+** Approximates the sine and cosine of a float with one shared range reduction (as accurate as sinf_fast and cosf_fast)
+** @param a: The input value
+** @param s: Receives the approximation of sinf(a)
+** @param c: Receives the approximation of cosf(a)
+** @returns: N/A
+*/
+MVLADEF void sincosf_fast(float a, float *s, float *c);
+
+/*
+** Approximates the square root of a float (2.7 ulp, estimate plus one Newton step for normal positive a)
+** @param a: The input value
+** @returns: The approximation of sqrtf(a)
+*/
+MVLADEF float sqrtf_fast(float a);
+
+/*
+** Approximates the reciprocal square root of a float (2.8 ulp, estimate plus one Newton step for normal positive a)
+** @param a: The input value
+** @returns: The approximation of 1 / sqrtf(a)
+*/
+MVLADEF float rsqrtf_fast(float a);
+
+/*
+** Approximates a float raised to a power (0.8 ulp, computed as e^(b * ln(a)) in double for positive a and finite b)
+** @param a: The base
+** @param b: The exponent
+** @returns: The approximation of powf(a, b)
+*/
+MVLADEF float powf_fast(float a, float b);
+
+/*
+** Approximates e raised to a double (0.9 ulp, polynomial for -708 <= a <= 709, libm outside)
+** @param a: The input value
+** @returns: The approximation of exp(a)
+*/
+MVLADEF double expd_fast(double a);
+
+/*
+** Approximates the natural logarithm of a double (0.9 ulp, polynomial for normal positive a, libm otherwise)
+** @param a: The input value
+** @returns: The approximation of log(a)
+*/
+MVLADEF double logd_fast(double a);
+
+/*
+** Approximates the sine of a double (2.5 ulp, polynomial for |a| <= 65536, libm outside)
+** @param a: The input value
+** @returns: The approximation of sin(a)
+*/
+MVLADEF double sind_fast(double a);
+
+/*
+** Approximates the cosine of a double (2.4 ulp, polynomial for |a| <= 65536, libm outside)
+** @param a: The input value
+** @returns: The approximation of cos(a)
+*/
+MVLADEF double cosd_fast(double a);
+
+/*
+** Approximates the tangent of a double (3.8 ulp, polynomial for |a| <= 65536, libm outside)
+** @param a: The input value
+** @returns: The approximation of tan(a)
+*/
+MVLADEF double tand_fast(double a);
+
+/*
+** Approximates the sine and cosine of a double with one shared range reduction (as accurate as sind_fast and cosd_fast)
+** @param a: The input value
+** @param s: Receives the approximation of sin(a)
+** @param c: Receives the approximation of cos(a)
+** @returns: N/A
+*/
+MVLADEF void sincosd_fast(double a, double *s, double *c);
+
+/*
+** Approximates the square root of a double (0.5 ulp, the hardware square root, already correctly rounded)
+** @param a: The input value
+** @returns: The approximation of sqrt(a)
+*/
+MVLADEF double sqrtd_fast(double a);
+
+/*
+** Approximates the reciprocal square root of a double (1.5 ulp, hardware square root and division)
+** @param a: The input value
+** @returns: The approximation of 1 / sqrt(a)
+*/
+MVLADEF double rsqrtd_fast(double a);
+
+/*
+** Approximates a double raised to a power (1.9 ulp, for |b * ln(a)| <= 1, about 2 more per unit of |b * ln(a)| above that; computed as e^(b * ln(a)) for positive a and finite b)
+** @param a: The base
+** @param b: The exponent
+** @returns: The approximation of pow(a, b)
+*/
+MVLADEF double powd_fast(double a, double b);
+
+/*
+** Approximates e raised to each component of a 2D float vector (see expf_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v2f_t v2f_exp_fast(v2f_t a);
+
+/*
+** Approximates the natural logarithm of each component of a 2D float vector (see logf_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v2f_t v2f_log_fast(v2f_t a);
+
+/*
+** Approximates the sine of each component of a 2D float vector (see sinf_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v2f_t v2f_sin_fast(v2f_t a);
+
+/*
+** Approximates the cosine of each component of a 2D float vector (see cosf_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v2f_t v2f_cos_fast(v2f_t a);
+
+/*
+** Approximates the tangent of each component of a 2D float vector (see tanf_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v2f_t v2f_tan_fast(v2f_t a);
+
+/*
+** Approximates the sine and cosine of each component of a 2D float vector (see sincosf_fast)
+** @param a: The input vector
+** @param s: Receives the approximate sines
+** @param c: Receives the approximate cosines
+** @returns: N/A
+*/
+MVLADEF void v2f_sincos_fast(v2f_t a, v2f_t *s, v2f_t *c);
+
+/*
+** Approximates the square root of each component of a 2D float vector (see sqrtf_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v2f_t v2f_sqrt_fast(v2f_t a);
+
+/*
+** Approximates the reciprocal square root of each component of a 2D float vector (see rsqrtf_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v2f_t v2f_rsqrt_fast(v2f_t a);
+
+/*
+** Approximates each component of a 2D float vector raised to an exponent (see powf_fast)
+** @param a: The vector to raise to the power
+** @param exp: The exponent to apply to each component
+** @returns: The component-wise approximation
+*/
+MVLADEF v2f_t v2f_poww_fast(v2f_t a, float exp);
+
+/*
+** Approximates each component of a 2D float vector raised to the corresponding component of another (see powf_fast)
+** @param a: The vector to raise to the power
+** @param exp: The vector containing the exponents for each component
+** @returns: The component-wise approximation
+*/
+MVLADEF v2f_t v2f_pow_fast(v2f_t a, v2f_t exp);
+
+/*
+** Approximates e raised to each component of a 2D double vector (see expd_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v2d_t v2d_exp_fast(v2d_t a);
+
+/*
+** Approximates the natural logarithm of each component of a 2D double vector (see logd_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v2d_t v2d_log_fast(v2d_t a);
+
+/*
+** Approximates the sine of each component of a 2D double vector (see sind_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v2d_t v2d_sin_fast(v2d_t a);
+
+/*
+** Approximates the cosine of each component of a 2D double vector (see cosd_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v2d_t v2d_cos_fast(v2d_t a);
+
+/*
+** Approximates the tangent of each component of a 2D double vector (see tand_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v2d_t v2d_tan_fast(v2d_t a);
+
+/*
+** Approximates the sine and cosine of each component of a 2D double vector (see sincosd_fast)
+** @param a: The input vector
+** @param s: Receives the approximate sines
+** @param c: Receives the approximate cosines
+** @returns: N/A
+*/
+MVLADEF void v2d_sincos_fast(v2d_t a, v2d_t *s, v2d_t *c);
+
+/*
+** Approximates the square root of each component of a 2D double vector (see sqrtd_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v2d_t v2d_sqrt_fast(v2d_t a);
+
+/*
+** Approximates the reciprocal square root of each component of a 2D double vector (see rsqrtd_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v2d_t v2d_rsqrt_fast(v2d_t a);
+
+/*
+** Approximates each component of a 2D double vector raised to an exponent (see powd_fast)
+** @param a: The vector to raise to the power
+** @param exp: The exponent to apply to each component
+** @returns: The component-wise approximation
+*/
+MVLADEF v2d_t v2d_poww_fast(v2d_t a, double exp);
+
+/*
+** Approximates each component of a 2D double vector raised to the corresponding component of another (see powd_fast)
+** @param a: The vector to raise to the power
+** @param exp: The vector containing the exponents for each component
+** @returns: The component-wise approximation
+*/
+MVLADEF v2d_t v2d_pow_fast(v2d_t a, v2d_t exp);
+
+/*
+** Approximates e raised to each component of a 3D float vector (see expf_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v3f_t v3f_exp_fast(v3f_t a);
+
+/*
+** Approximates the natural logarithm of each component of a 3D float vector (see logf_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v3f_t v3f_log_fast(v3f_t a);
+
+/*
+** Approximates the sine of each component of a 3D float vector (see sinf_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v3f_t v3f_sin_fast(v3f_t a);
+
+/*
+** Approximates the cosine of each component of a 3D float vector (see cosf_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v3f_t v3f_cos_fast(v3f_t a);
+
+/*
+** Approximates the tangent of each component of a 3D float vector (see tanf_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v3f_t v3f_tan_fast(v3f_t a);
+
+/*
+** Approximates the sine and cosine of each component of a 3D float vector (see sincosf_fast)
+** @param a: The input vector
+** @param s: Receives the approximate sines
+** @param c: Receives the approximate cosines
+** @returns: N/A
+*/
+MVLADEF void v3f_sincos_fast(v3f_t a, v3f_t *s, v3f_t *c);
+
+/*
+** Approximates the square root of each component of a 3D float vector (see sqrtf_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v3f_t v3f_sqrt_fast(v3f_t a);
+
+/*
+** Approximates the reciprocal square root of each component of a 3D float vector (see rsqrtf_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v3f_t v3f_rsqrt_fast(v3f_t a);
+
+/*
+** Approximates each component of a 3D float vector raised to an exponent (see powf_fast)
+** @param a: The vector to raise to the power
+** @param exp: The exponent to apply to each component
+** @returns: The component-wise approximation
+*/
+MVLADEF v3f_t v3f_poww_fast(v3f_t a, float exp);
+
+/*
+** Approximates each component of a 3D float vector raised to the corresponding component of another (see powf_fast)
+** @param a: The vector to raise to the power
+** @param exp: The vector containing the exponents for each component
+** @returns: The component-wise approximation
+*/
+MVLADEF v3f_t v3f_pow_fast(v3f_t a, v3f_t exp);
+
+/*
+** Approximates e raised to each component of a 3D double vector (see expd_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v3d_t v3d_exp_fast(v3d_t a);
+
+/*
+** Approximates the natural logarithm of each component of a 3D double vector (see logd_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v3d_t v3d_log_fast(v3d_t a);
+
+/*
+** Approximates the sine of each component of a 3D double vector (see sind_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v3d_t v3d_sin_fast(v3d_t a);
+
+/*
+** Approximates the cosine of each component of a 3D double vector (see cosd_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v3d_t v3d_cos_fast(v3d_t a);
+
+/*
+** Approximates the tangent of each component of a 3D double vector (see tand_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v3d_t v3d_tan_fast(v3d_t a);
+
+/*
+** Approximates the sine and cosine of each component of a 3D double vector (see sincosd_fast)
+** @param a: The input vector
+** @param s: Receives the approximate sines
+** @param c: Receives the approximate cosines
+** @returns: N/A
+*/
+MVLADEF void v3d_sincos_fast(v3d_t a, v3d_t *s, v3d_t *c);
+
+/*
+** Approximates the square root of each component of a 3D double vector (see sqrtd_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v3d_t v3d_sqrt_fast(v3d_t a);
+
+/*
+** Approximates the reciprocal square root of each component of a 3D double vector (see rsqrtd_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v3d_t v3d_rsqrt_fast(v3d_t a);
+
+/*
+** Approximates each component of a 3D double vector raised to an exponent (see powd_fast)
+** @param a: The vector to raise to the power
+** @param exp: The exponent to apply to each component
+** @returns: The component-wise approximation
+*/
+MVLADEF v3d_t v3d_poww_fast(v3d_t a, double exp);
+
+/*
+** Approximates each component of a 3D double vector raised to the corresponding component of another (see powd_fast)
+** @param a: The vector to raise to the power
+** @param exp: The vector containing the exponents for each component
+** @returns: The component-wise approximation
+*/
+MVLADEF v3d_t v3d_pow_fast(v3d_t a, v3d_t exp);
+
+/*
+** Approximates e raised to each component of a 4D float vector (see expf_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v4f_t v4f_exp_fast(v4f_t a);
+
+/*
+** Approximates the natural logarithm of each component of a 4D float vector (see logf_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v4f_t v4f_log_fast(v4f_t a);
+
+/*
+** Approximates the sine of each component of a 4D float vector (see sinf_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v4f_t v4f_sin_fast(v4f_t a);
+
+/*
+** Approximates the cosine of each component of a 4D float vector (see cosf_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v4f_t v4f_cos_fast(v4f_t a);
+
+/*
+** Approximates the tangent of each component of a 4D float vector (see tanf_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v4f_t v4f_tan_fast(v4f_t a);
+
+/*
+** Approximates the sine and cosine of each component of a 4D float vector (see sincosf_fast)
+** @param a: The input vector
+** @param s: Receives the approximate sines
+** @param c: Receives the approximate cosines
+** @returns: N/A
+*/
+MVLADEF void v4f_sincos_fast(v4f_t a, v4f_t *s, v4f_t *c);
+
+/*
+** Approximates the square root of each component of a 4D float vector (see sqrtf_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v4f_t v4f_sqrt_fast(v4f_t a);
+
+/*
+** Approximates the reciprocal square root of each component of a 4D float vector (see rsqrtf_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v4f_t v4f_rsqrt_fast(v4f_t a);
+
+/*
+** Approximates each component of a 4D float vector raised to an exponent (see powf_fast)
+** @param a: The vector to raise to the power
+** @param exp: The exponent to apply to each component
+** @returns: The component-wise approximation
+*/
+MVLADEF v4f_t v4f_poww_fast(v4f_t a, float exp);
+
+/*
+** Approximates each component of a 4D float vector raised to the corresponding component of another (see powf_fast)
+** @param a: The vector to raise to the power
+** @param exp: The vector containing the exponents for each component
+** @returns: The component-wise approximation
+*/
+MVLADEF v4f_t v4f_pow_fast(v4f_t a, v4f_t exp);
+
+/*
+** Approximates e raised to each component of a 4D double vector (see expd_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v4d_t v4d_exp_fast(v4d_t a);
+
+/*
+** Approximates the natural logarithm of each component of a 4D double vector (see logd_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v4d_t v4d_log_fast(v4d_t a);
+
+/*
+** Approximates the sine of each component of a 4D double vector (see sind_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v4d_t v4d_sin_fast(v4d_t a);
+
+/*
+** Approximates the cosine of each component of a 4D double vector (see cosd_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v4d_t v4d_cos_fast(v4d_t a);
+
+/*
+** Approximates the tangent of each component of a 4D double vector (see tand_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v4d_t v4d_tan_fast(v4d_t a);
+
+/*
+** Approximates the sine and cosine of each component of a 4D double vector (see sincosd_fast)
+** @param a: The input vector
+** @param s: Receives the approximate sines
+** @param c: Receives the approximate cosines
+** @returns: N/A
+*/
+MVLADEF void v4d_sincos_fast(v4d_t a, v4d_t *s, v4d_t *c);
+
+/*
+** Approximates the square root of each component of a 4D double vector (see sqrtd_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v4d_t v4d_sqrt_fast(v4d_t a);
+
+/*
+** Approximates the reciprocal square root of each component of a 4D double vector (see rsqrtd_fast)
+** @param a: The input vector
+** @returns: The component-wise approximation
+*/
+MVLADEF v4d_t v4d_rsqrt_fast(v4d_t a);
+
+/*
+** Approximates each component of a 4D double vector raised to an exponent (see powd_fast)
+** @param a: The vector to raise to the power
+** @param exp: The exponent to apply to each component
+** @returns: The component-wise approximation
+*/
+MVLADEF v4d_t v4d_poww_fast(v4d_t a, double exp);
+
+/*
+** Approximates each component of a 4D double vector raised to the corresponding component of another (see powd_fast)
+** @param a: The vector to raise to the power
+** @param exp: The vector containing the exponents for each component
+** @returns: The component-wise approximation
+*/
+MVLADEF v4d_t v4d_pow_fast(v4d_t a, v4d_t exp);
+
+/*
+** Approximates e raised to each component of an array of 2D float vectors (see expf_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2f_exp_fast_n(const v2f_t *a, v2f_t *out, size_t n);
+
+/*
+** Approximates the natural logarithm of each component of an array of 2D float vectors (see logf_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2f_log_fast_n(const v2f_t *a, v2f_t *out, size_t n);
+
+/*
+** Approximates the sine of each component of an array of 2D float vectors (see sinf_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2f_sin_fast_n(const v2f_t *a, v2f_t *out, size_t n);
+
+/*
+** Approximates the cosine of each component of an array of 2D float vectors (see cosf_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2f_cos_fast_n(const v2f_t *a, v2f_t *out, size_t n);
+
+/*
+** Approximates the tangent of each component of an array of 2D float vectors (see tanf_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2f_tan_fast_n(const v2f_t *a, v2f_t *out, size_t n);
+
+/*
+** Approximates the sine and cosine of each component of an array of 2D float vectors (see sincosf_fast)
+** @param a: The array of vectors
+** @param s: The array receiving the sines (may alias a)
+** @param c: The array receiving the cosines (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2f_sincos_fast_n(const v2f_t *a, v2f_t *s, v2f_t *c, size_t n);
+
+/*
+** Approximates the square root of each component of an array of 2D float vectors (see sqrtf_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2f_sqrt_fast_n(const v2f_t *a, v2f_t *out, size_t n);
+
+/*
+** Approximates the reciprocal square root of each component of an array of 2D float vectors (see rsqrtf_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2f_rsqrt_fast_n(const v2f_t *a, v2f_t *out, size_t n);
+
+/*
+** Approximates each component of an array of 2D float vectors raised to an exponent (see powf_fast)
+** @param a: The array of vectors to raise to the power
+** @param exp: The exponent to apply to each component
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2f_poww_fast_n(const v2f_t *a, float exp, v2f_t *out, size_t n);
+
+/*
+** Approximates each component of an array of 2D float vectors raised to the corresponding component in another array (see powf_fast)
+** @param a: The array of vectors to raise to the power
+** @param exp: The array of vectors containing the exponents
+** @param out: The array receiving the approximations (may alias a or exp)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2f_pow_fast_n(const v2f_t *a, const v2f_t *exp, v2f_t *out, size_t n);
+
+/*
+** Approximates e raised to each component of an array of 2D double vectors (see expd_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2d_exp_fast_n(const v2d_t *a, v2d_t *out, size_t n);
+
+/*
+** Approximates the natural logarithm of each component of an array of 2D double vectors (see logd_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2d_log_fast_n(const v2d_t *a, v2d_t *out, size_t n);
+
+/*
+** Approximates the sine of each component of an array of 2D double vectors (see sind_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2d_sin_fast_n(const v2d_t *a, v2d_t *out, size_t n);
+
+/*
+** Approximates the cosine of each component of an array of 2D double vectors (see cosd_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2d_cos_fast_n(const v2d_t *a, v2d_t *out, size_t n);
+
+/*
+** Approximates the tangent of each component of an array of 2D double vectors (see tand_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2d_tan_fast_n(const v2d_t *a, v2d_t *out, size_t n);
+
+/*
+** Approximates the sine and cosine of each component of an array of 2D double vectors (see sincosd_fast)
+** @param a: The array of vectors
+** @param s: The array receiving the sines (may alias a)
+** @param c: The array receiving the cosines (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2d_sincos_fast_n(const v2d_t *a, v2d_t *s, v2d_t *c, size_t n);
+
+/*
+** Approximates the square root of each component of an array of 2D double vectors (see sqrtd_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2d_sqrt_fast_n(const v2d_t *a, v2d_t *out, size_t n);
+
+/*
+** Approximates the reciprocal square root of each component of an array of 2D double vectors (see rsqrtd_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2d_rsqrt_fast_n(const v2d_t *a, v2d_t *out, size_t n);
+
+/*
+** Approximates each component of an array of 2D double vectors raised to an exponent (see powd_fast)
+** @param a: The array of vectors to raise to the power
+** @param exp: The exponent to apply to each component
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v2d_poww_fast_n(const v2d_t *a, double exp, v2d_t *out, size_t n);
+
+/*
+** Approximates each component of an array of 2D double vectors raised to the corresponding component in another array (see powd_fast)
+** @param a: The array of vectors to raise to the power
+** @param exp: The array of vectors containing the exponents
+** @param out: The array receiving the approximations (may alias a or exp)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v2d_pow_fast_n(const v2d_t *a, const v2d_t *exp, v2d_t *out, size_t n);
+
+/*
+** Approximates e raised to each component of an array of 3D float vectors (see expf_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3f_exp_fast_n(const v3f_t *a, v3f_t *out, size_t n);
+
+/*
+** Approximates the natural logarithm of each component of an array of 3D float vectors (see logf_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3f_log_fast_n(const v3f_t *a, v3f_t *out, size_t n);
+
+/*
+** Approximates the sine of each component of an array of 3D float vectors (see sinf_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3f_sin_fast_n(const v3f_t *a, v3f_t *out, size_t n);
+
+/*
+** Approximates the cosine of each component of an array of 3D float vectors (see cosf_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3f_cos_fast_n(const v3f_t *a, v3f_t *out, size_t n);
+
+/*
+** Approximates the tangent of each component of an array of 3D float vectors (see tanf_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3f_tan_fast_n(const v3f_t *a, v3f_t *out, size_t n);
+
+/*
+** Approximates the sine and cosine of each component of an array of 3D float vectors (see sincosf_fast)
+** @param a: The array of vectors
+** @param s: The array receiving the sines (may alias a)
+** @param c: The array receiving the cosines (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3f_sincos_fast_n(const v3f_t *a, v3f_t *s, v3f_t *c, size_t n);
+
+/*
+** Approximates the square root of each component of an array of 3D float vectors (see sqrtf_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3f_sqrt_fast_n(const v3f_t *a, v3f_t *out, size_t n);
+
+/*
+** Approximates the reciprocal square root of each component of an array of 3D float vectors (see rsqrtf_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3f_rsqrt_fast_n(const v3f_t *a, v3f_t *out, size_t n);
+
+/*
+** Approximates each component of an array of 3D float vectors raised to an exponent (see powf_fast)
+** @param a: The array of vectors to raise to the power
+** @param exp: The exponent to apply to each component
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3f_poww_fast_n(const v3f_t *a, float exp, v3f_t *out, size_t n);
+
+/*
+** Approximates each component of an array of 3D float vectors raised to the corresponding component in another array (see powf_fast)
+** @param a: The array of vectors to raise to the power
+** @param exp: The array of vectors containing the exponents
+** @param out: The array receiving the approximations (may alias a or exp)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3f_pow_fast_n(const v3f_t *a, const v3f_t *exp, v3f_t *out, size_t n);
+
+/*
+** Approximates e raised to each component of an array of 3D double vectors (see expd_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3d_exp_fast_n(const v3d_t *a, v3d_t *out, size_t n);
+
+/*
+** Approximates the natural logarithm of each component of an array of 3D double vectors (see logd_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3d_log_fast_n(const v3d_t *a, v3d_t *out, size_t n);
+
+/*
+** Approximates the sine of each component of an array of 3D double vectors (see sind_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3d_sin_fast_n(const v3d_t *a, v3d_t *out, size_t n);
+
+/*
+** Approximates the cosine of each component of an array of 3D double vectors (see cosd_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3d_cos_fast_n(const v3d_t *a, v3d_t *out, size_t n);
+
+/*
+** Approximates the tangent of each component of an array of 3D double vectors (see tand_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3d_tan_fast_n(const v3d_t *a, v3d_t *out, size_t n);
+
+/*
+** Approximates the sine and cosine of each component of an array of 3D double vectors (see sincosd_fast)
+** @param a: The array of vectors
+** @param s: The array receiving the sines (may alias a)
+** @param c: The array receiving the cosines (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3d_sincos_fast_n(const v3d_t *a, v3d_t *s, v3d_t *c, size_t n);
+
+/*
+** Approximates the square root of each component of an array of 3D double vectors (see sqrtd_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3d_sqrt_fast_n(const v3d_t *a, v3d_t *out, size_t n);
+
+/*
+** Approximates the reciprocal square root of each component of an array of 3D double vectors (see rsqrtd_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3d_rsqrt_fast_n(const v3d_t *a, v3d_t *out, size_t n);
+
+/*
+** Approximates each component of an array of 3D double vectors raised to an exponent (see powd_fast)
+** @param a: The array of vectors to raise to the power
+** @param exp: The exponent to apply to each component
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v3d_poww_fast_n(const v3d_t *a, double exp, v3d_t *out, size_t n);
+
+/*
+** Approximates each component of an array of 3D double vectors raised to the corresponding component in another array (see powd_fast)
+** @param a: The array of vectors to raise to the power
+** @param exp: The array of vectors containing the exponents
+** @param out: The array receiving the approximations (may alias a or exp)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v3d_pow_fast_n(const v3d_t *a, const v3d_t *exp, v3d_t *out, size_t n);
+
+/*
+** Approximates e raised to each component of an array of 4D float vectors (see expf_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4f_exp_fast_n(const v4f_t *a, v4f_t *out, size_t n);
+
+/*
+** Approximates the natural logarithm of each component of an array of 4D float vectors (see logf_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4f_log_fast_n(const v4f_t *a, v4f_t *out, size_t n);
+
+/*
+** Approximates the sine of each component of an array of 4D float vectors (see sinf_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4f_sin_fast_n(const v4f_t *a, v4f_t *out, size_t n);
+
+/*
+** Approximates the cosine of each component of an array of 4D float vectors (see cosf_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4f_cos_fast_n(const v4f_t *a, v4f_t *out, size_t n);
+
+/*
+** Approximates the tangent of each component of an array of 4D float vectors (see tanf_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4f_tan_fast_n(const v4f_t *a, v4f_t *out, size_t n);
+
+/*
+** Approximates the sine and cosine of each component of an array of 4D float vectors (see sincosf_fast)
+** @param a: The array of vectors
+** @param s: The array receiving the sines (may alias a)
+** @param c: The array receiving the cosines (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4f_sincos_fast_n(const v4f_t *a, v4f_t *s, v4f_t *c, size_t n);
+
+/*
+** Approximates the square root of each component of an array of 4D float vectors (see sqrtf_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4f_sqrt_fast_n(const v4f_t *a, v4f_t *out, size_t n);
+
+/*
+** Approximates the reciprocal square root of each component of an array of 4D float vectors (see rsqrtf_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4f_rsqrt_fast_n(const v4f_t *a, v4f_t *out, size_t n);
+
+/*
+** Approximates each component of an array of 4D float vectors raised to an exponent (see powf_fast)
+** @param a: The array of vectors to raise to the power
+** @param exp: The exponent to apply to each component
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4f_poww_fast_n(const v4f_t *a, float exp, v4f_t *out, size_t n);
+
+/*
+** Approximates each component of an array of 4D float vectors raised to the corresponding component in another array (see powf_fast)
+** @param a: The array of vectors to raise to the power
+** @param exp: The array of vectors containing the exponents
+** @param out: The array receiving the approximations (may alias a or exp)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4f_pow_fast_n(const v4f_t *a, const v4f_t *exp, v4f_t *out, size_t n);
+
+/*
+** Approximates e raised to each component of an array of 4D double vectors (see expd_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4d_exp_fast_n(const v4d_t *a, v4d_t *out, size_t n);
+
+/*
+** Approximates the natural logarithm of each component of an array of 4D double vectors (see logd_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4d_log_fast_n(const v4d_t *a, v4d_t *out, size_t n);
+
+/*
+** Approximates the sine of each component of an array of 4D double vectors (see sind_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4d_sin_fast_n(const v4d_t *a, v4d_t *out, size_t n);
+
+/*
+** Approximates the cosine of each component of an array of 4D double vectors (see cosd_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4d_cos_fast_n(const v4d_t *a, v4d_t *out, size_t n);
+
+/*
+** Approximates the tangent of each component of an array of 4D double vectors (see tand_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4d_tan_fast_n(const v4d_t *a, v4d_t *out, size_t n);
+
+/*
+** Approximates the sine and cosine of each component of an array of 4D double vectors (see sincosd_fast)
+** @param a: The array of vectors
+** @param s: The array receiving the sines (may alias a)
+** @param c: The array receiving the cosines (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4d_sincos_fast_n(const v4d_t *a, v4d_t *s, v4d_t *c, size_t n);
+
+/*
+** Approximates the square root of each component of an array of 4D double vectors (see sqrtd_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4d_sqrt_fast_n(const v4d_t *a, v4d_t *out, size_t n);
+
+/*
+** Approximates the reciprocal square root of each component of an array of 4D double vectors (see rsqrtd_fast)
+** @param a: The array of vectors
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4d_rsqrt_fast_n(const v4d_t *a, v4d_t *out, size_t n);
+
+/*
+** Approximates each component of an array of 4D double vectors raised to an exponent (see powd_fast)
+** @param a: The array of vectors to raise to the power
+** @param exp: The exponent to apply to each component
+** @param out: The array receiving the approximations (may alias a)
+** @param n: The number of vectors in the array
+** @returns: N/A
+*/
+MVLADEF void v4d_poww_fast_n(const v4d_t *a, double exp, v4d_t *out, size_t n);
+
+/*
+** Approximates each component of an array of 4D double vectors raised to the corresponding component in another array (see powd_fast)
+** @param a: The array of vectors to raise to the power
+** @param exp: The array of vectors containing the exponents
+** @param out: The array receiving the approximations (may alias a or exp)
+** @param n: The number of vectors in each array
+** @returns: N/A
+*/
+MVLADEF void v4d_pow_fast_n(const v4d_t *a, const v4d_t *exp, v4d_t *out, size_t n);
+
+// -----------------------------------------
+
+/*
+** RANDOM FUNCTION PROTOTYPES
+**
+** Explicit xoshiro256++ generators. A generator is plain data, so giving each
+** thread its own needs no locking; mvla_rng_jump() splits one seed into
+** 2^128 long non-overlapping streams. randf() and randd() draw from a
+** thread-local generator that mvla_srand() seeds.
+**
+** mvla_philox() is counter-based instead: block i of a stream is a pure
+** function of (seed, stream, i), so output is bit-identical however a range is
+** split between threads or calls.
+**
+** The batch samplers run MVLA_RNG_LANES streams at once in SIMD lanes, vector
+** i of a call drawing from lane i % MVLA_RNG_LANES. Each scalar sampler
+** makes the same draws in the same order, so batch output can be replayed
+** one lane at a time (up to the few ulps the fast sin, cos and log allow).
+*/
+
+/*
+** Creates a generator from a 64-bit seed, expanded with splitmix64
+** @param seed: Any value, equal seeds give equal sequences
+** @returns: The seeded generator
+*/
+MVLADEF mvla_rng_t mvla_rng(uint64_t seed);
+
+/*
+** Advances a generator
+** @param rng: The generator
+** @returns: 64 random bits
+*/
+MVLADEF uint64_t mvla_rng_next(mvla_rng_t *rng);
+
+/*
+** Generates a random float in [0, 1) from the top 24 bits of one draw
+** @param rng: The generator
+** @returns: A random float in [0, 1)
+*/
+MVLADEF float mvla_rng_randf(mvla_rng_t *rng);
+
+/*
+** Generates a random double in [0, 1) from the top 53 bits of one draw
+** @param rng: The generator
+** @returns: A random double in [0, 1)
+*/
+MVLADEF double mvla_rng_randd(mvla_rng_t *rng);
+
+/*
+** Advances a generator by 2^128 draws, use it to hand out up to 2^128 streams from one seed
+** @param rng: The generator
+** @returns: N/A
+*/
+MVLADEF void mvla_rng_jump(mvla_rng_t *rng);
+
+/*
+** Advances a generator by 2^192 draws, splitting off 2^64 groups of jump() streams
+** @param rng: The generator
+** @returns: N/A
+*/
+MVLADEF void mvla_rng_long_jump(mvla_rng_t *rng);
+
+/*
+** Seeds the generator randf() and randd() use on the calling thread only, so
+** unlike srand() it must be called on every thread that should follow the
+** seed. An unseeded thread starts from a fixed default seed, jumped once per
+** unseeded thread that drew before it (see mvla_rng_jump)
+** @param seed: The seed, as for mvla_rng
+** @returns: N/A
+*/
+MVLADEF void mvla_srand(uint64_t seed);
+
+/*
+** Splits MVLA_RNG_LANES streams off a generator for the batch samplers: lane
+** l starts where rng stands after l jumps, and rng is left jumped past all of them
+** @param rng: The generator to split, advanced by MVLA_RNG_LANES jumps
+** @returns: The lane set
+*/
+MVLADEF mvla_rng_lanes_t mvla_rng_lanes(mvla_rng_t *rng);
+
+/*
+** Copies one lane out of a lane set, to replay batch output with the scalar samplers
+** @param lanes: The lane set
+** @param lane: The lane, below MVLA_RNG_LANES
+** @returns: The lane's generator
+*/
+MVLADEF mvla_rng_t mvla_rng_lane(const mvla_rng_lanes_t *lanes, int lane);
+
+/*
+** Fills an array with random floats in [0, 1), out[i] drawn from lane i % MVLA_RNG_LANES
+** @param lanes: The lane set
+** @param out: The array to fill
+** @param n: The number of floats
+** @returns: N/A
+*/
+MVLADEF void mvla_rng_fill(mvla_rng_lanes_t *lanes, float *out, size_t n);
+
+/*
+** Generates Philox4x32-10 block number index of a stream. Counter-based, so any
+** block is computed directly from (seed, stream, index) without walking the
+** sequence, which makes split or parallel sampling reproducible
+** @param seed: The key
+** @param stream: The stream, the upper half of the counter
+** @param index: The block within the stream, the lower half of the counter
+** @returns: 128 random bits as four words
+*/
+MVLADEF v4u_t mvla_philox(uint64_t seed, uint64_t stream, uint64_t index);
+
+/*
+** Generates a block as four floats in [0, 1), each from the top 24 bits of a word of mvla_philox
+** @param seed: The key
+** @param stream: The stream
+** @param index: The block within the stream
+** @returns: Four random floats in [0, 1)
+*/
+MVLADEF v4f_t mvla_philox_v4f(uint64_t seed, uint64_t stream, uint64_t index);
+
+/*
+** Generates consecutive Philox blocks, out[i] equal to mvla_philox(seed, stream, first + i)
+** @param seed: The key
+** @param stream: The stream
+** @param first: The index of the first block
+** @param out: The array receiving the blocks
+** @param n: The number of blocks
+** @returns: N/A
+*/
+MVLADEF void mvla_philox_v4u_n(uint64_t seed, uint64_t stream, uint64_t first, v4u_t *out, size_t n);
+
+/*
+** Generates consecutive Philox blocks as floats, out[i] equal to mvla_philox_v4f(seed, stream, first + i)
+** @param seed: The key
+** @param stream: The stream
+** @param first: The index of the first block
+** @param out: The array receiving the floats
+** @param n: The number of blocks
+** @returns: N/A
+*/
+MVLADEF void mvla_philox_v4f_n(uint64_t seed, uint64_t stream, uint64_t first, v4f_t *out, size_t n);
+
+/*
+** Fills floats in [0, 1) from a stream's words, float j of the stream is word
+** j % 4 of block j / 4, so any split of the range gives the same values
+** @param seed: The key
+** @param stream: The stream
+** @param first: The index of the first float within the stream
+** @param out: The array to fill
+** @param n: The number of floats
+** @returns: N/A
+*/
+MVLADEF void mvla_philox_fill(uint64_t seed, uint64_t stream, uint64_t first, float *out, size_t n);
+
+/*
+** Generates a 2D float vector uniform in the box [lo, hi), drawn in x, y order
+** @param rng: The generator
+** @param lo: The lower corner
+** @param hi: The upper corner
+** @returns: The random vector
+*/
+MVLADEF v2f_t v2f_rand_box(mvla_rng_t *rng, v2f_t lo, v2f_t hi);
+
+/*
+** Generates a 3D float vector uniform in the box [lo, hi), drawn in x, y, z order
+** @param rng: The generator
+** @param lo: The lower corner
+** @param hi: The upper corner
+** @returns: The random vector
+*/
+MVLADEF v3f_t v3f_rand_box(mvla_rng_t *rng, v3f_t lo, v3f_t hi);
+
+/*
+** Generates a 4D float vector uniform in the box [lo, hi), drawn in x, y, z, w order
+** @param rng: The generator
+** @param lo: The lower corner
+** @param hi: The upper corner
+** @returns: The random vector
+*/
+MVLADEF v4f_t v4f_rand_box(mvla_rng_t *rng, v4f_t lo, v4f_t hi);
+
+/*
+** Generates a 2D float vector uniform in the unit disk (radius from sqrt of the first draw, angle from the second)
+** @param rng: The generator
+** @returns: The random vector
+*/
+MVLADEF v2f_t v2f_rand_disk(mvla_rng_t *rng);
+
+/*
+** Generates a 3D float vector uniform on the unit sphere (z from the first draw, angle from the second)
+** @param rng: The generator
+** @returns: The random unit vector
+*/
+MVLADEF v3f_t v3f_rand_sphere(mvla_rng_t *rng);
+
+/*
+** Generates a 2D float vector of independent standard normal components (Box-Muller, two draws per pair of components)
+** @param rng: The generator
+** @returns: The random vector
+*/
+MVLADEF v2f_t v2f_rand_gauss(mvla_rng_t *rng);
+
+/*
+** Generates a 3D float vector of independent standard normal components (Box-Muller, two draws per pair of components)
+** @param rng: The generator
+** @returns: The random vector
+*/
+MVLADEF v3f_t v3f_rand_gauss(mvla_rng_t *rng);
+
+/*
+** Generates a 4D float vector of independent standard normal components (Box-Muller, two draws per pair of components)
+** @param rng: The generator
+** @returns: The random vector
+*/
+MVLADEF v4f_t v4f_rand_gauss(mvla_rng_t *rng);
+
+/*
+** Fills an array of 2D float vectors uniform in the box [lo, hi), vector i equals v2f_rand_box on lane i % MVLA_RNG_LANES
+** @param lanes: The lane set
+** @param lo: The lower corner
+** @param hi: The upper corner
+** @param out: The array to fill
+** @param n: The number of vectors
+** @returns: N/A
+*/
+MVLADEF void v2f_rand_box_n(mvla_rng_lanes_t *lanes, v2f_t lo, v2f_t hi, v2f_t *out, size_t n);
+
+/*
+** Fills a 2D float structure-of-arrays buffer uniform in the box [lo, hi), in the same order as v2f_rand_box_n
+** @param lanes: The lane set
+** @param lo: The lower corner
+** @param hi: The upper corner
+** @param out: The buffer, its count is the number of vectors generated
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_rand_box(mvla_rng_lanes_t *lanes, v2f_t lo, v2f_t hi, v2f_soa_t *out);
+
+/*
+** Fills an array of 3D float vectors uniform in the box [lo, hi), vector i equals v3f_rand_box on lane i % MVLA_RNG_LANES
+** @param lanes: The lane set
+** @param lo: The lower corner
+** @param hi: The upper corner
+** @param out: The array to fill
+** @param n: The number of vectors
+** @returns: N/A
+*/
+MVLADEF void v3f_rand_box_n(mvla_rng_lanes_t *lanes, v3f_t lo, v3f_t hi, v3f_t *out, size_t n);
+
+/*
+** Fills a 3D float structure-of-arrays buffer uniform in the box [lo, hi), in the same order as v3f_rand_box_n
+** @param lanes: The lane set
+** @param lo: The lower corner
+** @param hi: The upper corner
+** @param out: The buffer, its count is the number of vectors generated
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_rand_box(mvla_rng_lanes_t *lanes, v3f_t lo, v3f_t hi, v3f_soa_t *out);
+
+/*
+** Fills an array of 4D float vectors uniform in the box [lo, hi), vector i equals v4f_rand_box on lane i % MVLA_RNG_LANES
+** @param lanes: The lane set
+** @param lo: The lower corner
+** @param hi: The upper corner
+** @param out: The array to fill
+** @param n: The number of vectors
+** @returns: N/A
+*/
+MVLADEF void v4f_rand_box_n(mvla_rng_lanes_t *lanes, v4f_t lo, v4f_t hi, v4f_t *out, size_t n);
+
+/*
+** Fills a 4D float structure-of-arrays buffer uniform in the box [lo, hi), in the same order as v4f_rand_box_n
+** @param lanes: The lane set
+** @param lo: The lower corner
+** @param hi: The upper corner
+** @param out: The buffer, its count is the number of vectors generated
+** @returns: N/A
+*/
+MVLADEF void v4f_soa_rand_box(mvla_rng_lanes_t *lanes, v4f_t lo, v4f_t hi, v4f_soa_t *out);
+
+/*
+** Fills an array of 2D float vectors uniform in the unit disk, vector i equals v2f_rand_disk on lane i % MVLA_RNG_LANES
+** @param lanes: The lane set
+** @param out: The array to fill
+** @param n: The number of vectors
+** @returns: N/A
+*/
+MVLADEF void v2f_rand_disk_n(mvla_rng_lanes_t *lanes, v2f_t *out, size_t n);
+
+/*
+** Fills a 2D float structure-of-arrays buffer uniform in the unit disk, in the same order as v2f_rand_disk_n
+** @param lanes: The lane set
+** @param out: The buffer, its count is the number of vectors generated
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_rand_disk(mvla_rng_lanes_t *lanes, v2f_soa_t *out);
+
+/*
+** Fills an array of 3D float vectors uniform on the unit sphere, vector i equals v3f_rand_sphere on lane i % MVLA_RNG_LANES
+** @param lanes: The lane set
+** @param out: The array to fill
+** @param n: The number of vectors
+** @returns: N/A
+*/
+MVLADEF void v3f_rand_sphere_n(mvla_rng_lanes_t *lanes, v3f_t *out, size_t n);
+
+/*
+** Fills a 3D float structure-of-arrays buffer uniform on the unit sphere, in the same order as v3f_rand_sphere_n
+** @param lanes: The lane set
+** @param out: The buffer, its count is the number of vectors generated
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_rand_sphere(mvla_rng_lanes_t *lanes, v3f_soa_t *out);
+
+/*
+** Fills an array of 2D float vectors of standard normal components, vector i equals v2f_rand_gauss on lane i % MVLA_RNG_LANES
+** @param lanes: The lane set
+** @param out: The array to fill
+** @param n: The number of vectors
+** @returns: N/A
+*/
+MVLADEF void v2f_rand_gauss_n(mvla_rng_lanes_t *lanes, v2f_t *out, size_t n);
+
+/*
+** Fills a 2D float structure-of-arrays buffer of standard normal components, in the same order as v2f_rand_gauss_n
+** @param lanes: The lane set
+** @param out: The buffer, its count is the number of vectors generated
+** @returns: N/A
+*/
+MVLADEF void v2f_soa_rand_gauss(mvla_rng_lanes_t *lanes, v2f_soa_t *out);
+
+/*
+** Fills an array of 3D float vectors of standard normal components, vector i equals v3f_rand_gauss on lane i % MVLA_RNG_LANES
+** @param lanes: The lane set
+** @param out: The array to fill
+** @param n: The number of vectors
+** @returns: N/A
+*/
+MVLADEF void v3f_rand_gauss_n(mvla_rng_lanes_t *lanes, v3f_t *out, size_t n);
+
+/*
+** Fills a 3D float structure-of-arrays buffer of standard normal components, in the same order as v3f_rand_gauss_n
+** @param lanes: The lane set
+** @param out: The buffer, its count is the number of vectors generated
+** @returns: N/A
+*/
+MVLADEF void v3f_soa_rand_gauss(mvla_rng_lanes_t *lanes, v3f_soa_t *out);
+
+/*
+** Fills an array of 4D float vectors of standard normal components, vector i equals v4f_rand_gauss on lane i % MVLA_RNG_LANES
+** @param lanes: The lane set
+** @param out: The array to fill
+** @param n: The number of vectors
+** @returns: N/A
+*/
+MVLADEF void v4f_rand_gauss_n(mvla_rng_lanes_t *lanes, v4f_t *out, size_t n);
+
+/*
+** Fills a 4D float structure-of-arrays buffer of standard normal components, in the same order as v4f_rand_gauss_n
+** @param lanes: The lane set
+** @param out: The buffer, its count is the number of vectors generated
+** @returns: N/A
+*/
+MVLADEF void v4f_soa_rand_gauss(mvla_rng_lanes_t *lanes, v4f_soa_t *out);
+
+/*
+** Generates a 2D float vector with components uniform in [0, 1), drawn in x, y order
+** @param rng: The generator
+** @returns: The random vector
+*/
+MVLADEF v2f_t v2f_rand(mvla_rng_t *rng);
+
+/*
+** Generates a 2D double vector with components uniform in [0, 1), drawn in x, y order
+** @param rng: The generator
+** @returns: The random vector
+*/
+MVLADEF v2d_t v2d_rand(mvla_rng_t *rng);
+
+/*
+** Generates a 3D float vector with components uniform in [0, 1), drawn in x, y, z order
+** @param rng: The generator
+** @returns: The random vector
+*/
+MVLADEF v3f_t v3f_rand(mvla_rng_t *rng);
+
+/*
+** Generates a 3D double vector with components uniform in [0, 1), drawn in x, y, z order
+** @param rng: The generator
+** @returns: The random vector
+*/
+MVLADEF v3d_t v3d_rand(mvla_rng_t *rng);
+
+/*
+** Generates a 4D float vector with components uniform in [0, 1), drawn in x, y, z, w order
+** @param rng: The generator
+** @returns: The random vector
+*/
+MVLADEF v4f_t v4f_rand(mvla_rng_t *rng);
+
+/*
+** Generates a 4D double vector with components uniform in [0, 1), drawn in x, y, z, w order
+** @param rng: The generator
+** @returns: The random vector
+*/
+MVLADEF v4d_t v4d_rand(mvla_rng_t *rng);
+
+// -----------------------------------------
+
+/*
+** QUASI-RANDOM FUNCTION PROTOTYPES
+**
+** Low-discrepancy sequences in [0, 1)^d for 2 to 4 dimensions. Point i is a
+** function of i alone, so workers taking disjoint index ranges produce the same
+** points as one call over the whole range. The seed only matters when
+** scrambling, and the same (scramble, seed) gives the same randomized sequence.
+**
+** Sobol uses the Joe-Kuo direction numbers and repeats after 2^32 points. Owen
+** scrambling is the hash-based nested uniform scramble for Sobol and a random
+** digit permutation per tree node for Halton. The R sequences are additive
+** lattices with no digits to scramble, so MVLA_SCRAMBLE_OWEN rotates them like
+** MVLA_SCRAMBLE_SHIFT.
+*/
+
+/*
+** Generates point index of the Sobol sequence as a 2D float vector
+** @param scramble: The randomization to apply
+** @param seed: The seed of the randomization
+** @param index: The index of the point
+** @returns: The point in [0, 1)^2
+*/
+MVLADEF v2f_t v2f_sobol(mvla_scramble_t scramble, uint64_t seed, uint64_t index);
+
+/*
+** Generates consecutive points of the Sobol sequence, out[i] equal to v2f_sobol(scramble, seed, first + i)
+** @param scramble: The randomization to apply
+** @param seed: The seed of the randomization
+** @param first: The index of the first point
+** @param out: The array receiving the points
+** @param n: The number of points
+** @returns: N/A
+*/
+MVLADEF void v2f_sobol_n(mvla_scramble_t scramble, uint64_t seed, uint64_t first, v2f_t *out, size_t n);
+
+/*
+** Generates point index of the Sobol sequence as a 3D float vector
+** @param scramble: The randomization to apply
+** @param seed: The seed of the randomization
+** @param index: The index of the point
+** @returns: The point in [0, 1)^3
+*/
+MVLADEF v3f_t v3f_sobol(mvla_scramble_t scramble, uint64_t seed, uint64_t index);
+
+/*
+** Generates consecutive points of the Sobol sequence, out[i] equal to v3f_sobol(scramble, seed, first + i)
+** @param scramble: The randomization to apply
+** @param seed: The seed of the randomization
+** @param first: The index of the first point
+** @param out: The array receiving the points
+** @param n: The number of points
+** @returns: N/A
+*/
+MVLADEF void v3f_sobol_n(mvla_scramble_t scramble, uint64_t seed, uint64_t first, v3f_t *out, size_t n);
+
+/*
+** Generates point index of the Sobol sequence as a 4D float vector
+** @param scramble: The randomization to apply
+** @param seed: The seed of the randomization
+** @param index: The index of the point
+** @returns: The point in [0, 1)^4
+*/
+MVLADEF v4f_t v4f_sobol(mvla_scramble_t scramble, uint64_t seed, uint64_t index);
+
+/*
+** Generates consecutive points of the Sobol sequence, out[i] equal to v4f_sobol(scramble, seed, first + i)
+** @param scramble: The randomization to apply
+** @param seed: The seed of the randomization
+** @param first: The index of the first point
+** @param out: The array receiving the points
+** @param n: The number of points
+** @returns: N/A
+*/
+MVLADEF void v4f_sobol_n(mvla_scramble_t scramble, uint64_t seed, uint64_t first, v4f_t *out, size_t n);
+
+/*
+** Generates point index of the Halton sequence (bases 2, 3, 5, 7) as a 2D float vector
+** @param scramble: The randomization to apply
+** @param seed: The seed of the randomization
+** @param index: The index of the point
+** @returns: The point in [0, 1)^2
+*/
+MVLADEF v2f_t v2f_halton(mvla_scramble_t scramble, uint64_t seed, uint64_t index);
+
+/*
+** Generates consecutive points of the Halton sequence (bases 2, 3, 5, 7),
+** out[i] equal to v2f_halton(scramble, seed, first + i)
+** @param scramble: The randomization to apply
+** @param seed: The seed of the randomization
+** @param first: The index of the first point
+** @param out: The array receiving the points
+** @param n: The number of points
+** @returns: N/A
+*/
+MVLADEF void v2f_halton_n(mvla_scramble_t scramble, uint64_t seed, uint64_t first, v2f_t *out, size_t n);
+
+/*
+** Generates point index of the Halton sequence (bases 2, 3, 5, 7) as a 3D float vector
+** @param scramble: The randomization to apply
+** @param seed: The seed of the randomization
+** @param index: The index of the point
+** @returns: The point in [0, 1)^3
+*/
+MVLADEF v3f_t v3f_halton(mvla_scramble_t scramble, uint64_t seed, uint64_t index);
+
+/*
+** Generates consecutive points of the Halton sequence (bases 2, 3, 5, 7),
+** out[i] equal to v3f_halton(scramble, seed, first + i)
+** @param scramble: The randomization to apply
+** @param seed: The seed of the randomization
+** @param first: The index of the first point
+** @param out: The array receiving the points
+** @param n: The number of points
+** @returns: N/A
+*/
+MVLADEF void v3f_halton_n(mvla_scramble_t scramble, uint64_t seed, uint64_t first, v3f_t *out, size_t n);
+
+/*
+** Generates point index of the Halton sequence (bases 2, 3, 5, 7) as a 4D float vector
+** @param scramble: The randomization to apply
+** @param seed: The seed of the randomization
+** @param index: The index of the point
+** @returns: The point in [0, 1)^4
+*/
+MVLADEF v4f_t v4f_halton(mvla_scramble_t scramble, uint64_t seed, uint64_t index);
+
+/*
+** Generates consecutive points of the Halton sequence (bases 2, 3, 5, 7),
+** out[i] equal to v4f_halton(scramble, seed, first + i)
+** @param scramble: The randomization to apply
+** @param seed: The seed of the randomization
+** @param first: The index of the first point
+** @param out: The array receiving the points
+** @param n: The number of points
+** @returns: N/A
+*/
+MVLADEF void v4f_halton_n(mvla_scramble_t scramble, uint64_t seed, uint64_t first, v4f_t *out, size_t n);
+
+/*
+** Generates point index of the R2 sequence, frac(0.5 + i * alpha) with alpha from the generalized golden ratio as a 2D float vector
+** @param scramble: The randomization to apply
+** @param seed: The seed of the randomization
+** @param index: The index of the point
+** @returns: The point in [0, 1)^2
+*/
+MVLADEF v2f_t v2f_r2(mvla_scramble_t scramble, uint64_t seed, uint64_t index);
+
+/*
+** Generates consecutive points of the R2 sequence, out[i] equal to v2f_r2(scramble, seed, first + i)
+** @param scramble: The randomization to apply
+** @param seed: The seed of the randomization
+** @param first: The index of the first point
+** @param out: The array receiving the points
+** @param n: The number of points
+** @returns: N/A
+*/
+MVLADEF void v2f_r2_n(mvla_scramble_t scramble, uint64_t seed, uint64_t first, v2f_t *out, size_t n);
+
+/*
+** Generates point index of the R3 sequence, frac(0.5 + i * alpha) with alpha from the generalized golden ratio as a 3D float vector
+** @param scramble: The randomization to apply
+** @param seed: The seed of the randomization
+** @param index: The index of the point
+** @returns: The point in [0, 1)^3
+*/
+MVLADEF v3f_t v3f_r3(mvla_scramble_t scramble, uint64_t seed, uint64_t index);
+
+/*
+** Generates consecutive points of the R3 sequence, out[i] equal to v3f_r3(scramble, seed, first + i)
+** @param scramble: The randomization to apply
+** @param seed: The seed of the randomization
+** @param first: The index of the first point
+** @param out: The array receiving the points
+** @param n: The number of points
+** @returns: N/A
+*/
+MVLADEF void v3f_r3_n(mvla_scramble_t scramble, uint64_t seed, uint64_t first, v3f_t *out, size_t n);
+
+/*
+** Generates point index of the R4 sequence, frac(0.5 + i * alpha) with alpha from the generalized golden ratio as a 4D float vector
+** @param scramble: The randomization to apply
+** @param seed: The seed of the randomization
+** @param index: The index of the point
+** @returns: The point in [0, 1)^4
+*/
+MVLADEF v4f_t v4f_r4(mvla_scramble_t scramble, uint64_t seed, uint64_t index);
+
+/*
+** Generates consecutive points of the R4 sequence, out[i] equal to v4f_r4(scramble, seed, first + i)
+** @param scramble: The randomization to apply
+** @param seed: The seed of the randomization
+** @param first: The index of the first point
+** @param out: The array receiving the points
+** @param n: The number of points
+** @returns: N/A
+*/
+MVLADEF void v4f_r4_n(mvla_scramble_t scramble, uint64_t seed, uint64_t first, v4f_t *out, size_t n);
+
+// -----------------------------------------
+
+#endif // MVLA_H
+
+/*
+** HEADER ONLY IMPLEMENTATION
+*/
+
+#ifdef MVLA_IMPLEMENTATION
+
+// -----------------------------------------
+
+/*
+** PLATFORM INCLUDES
+**
+** OS headers, and standard ones only the implementation needs, stay here so
+** including mvla.h for its declarations only pulls in what they use.
+*/
+
+// localeconv, for text parsing that ignores the current locale
+#include <locale.h>
+
+// large buffers and vector files are mapped straight from the OS where mmap exists
+#if defined(__unix__) || defined(__APPLE__)
+#define MVLA__MMAP
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(MAP_ANONYMOUS)
+#define MVLA__MAP_ANON MAP_ANONYMOUS
+#elif defined(MAP_ANON)
+#define MVLA__MAP_ANON MAP_ANON
+#endif // MAP_ANONYMOUS
+// fseeko takes an off_t, 64 bits wide on 32-bit hosts with _FILE_OFFSET_BITS=64,
+// but stdio only declares it outside strict ISO modes
+#if defined(__APPLE__) || defined(_DEFAULT_SOURCE) || defined(_GNU_SOURCE) ||              \
+    defined(_LARGEFILE_SOURCE) || (defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 200112L) || \
+    (defined(_XOPEN_SOURCE) && _XOPEN_SOURCE >= 500)
+#define MVLA__FSEEKO
+#endif // fseeko
+#endif // __unix__
+
+/*
+** Large batches are split across pthreads where they exist, define
+** MVLA_NO_THREADS to always run on the calling thread (and drop -lpthread).
+*/
+
+#if !defined(MVLA_NO_THREADS) && (defined(__unix__) || defined(__APPLE__))
+#define MVLA_THREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif // MVLA_THREADS
+
+// -----------------------------------------
+
+/*
+** MVLA_FAST_MATH swaps libm for the *_fast functions in every exp, sin, cos,
+** tan, sincos and pow, trading a few ulps of accuracy for speed (see the prototypes
+** of expf_fast and friends for the bounds).
+*/
+
+#ifdef MVLA_FAST_MATH
+#define MVLA__EXPF(x)    expf_fast(x)
+#define MVLA__SINF(x)    sinf_fast(x)
+#define MVLA__COSF(x)    cosf_fast(x)
+#define MVLA__TANF(x)    tanf_fast(x)
+#define MVLA__SINCOSF(x, s, c) sincosf_fast((x), (s), (c))
+#define MVLA__POWF(x, y) powf_fast((x), (y))
+#define MVLA__EXPD(x)    expd_fast(x)
+#define MVLA__SIND(x)    sind_fast(x)
+#define MVLA__COSD(x)    cosd_fast(x)
+#define MVLA__TAND(x)    tand_fast(x)
+#define MVLA__SINCOSD(x, s, c) sincosd_fast((x), (s), (c))
+#define MVLA__POWD(x, y) powd_fast((x), (y))
+#else
+#define MVLA__EXPF(x)    powf(MVLA_E, (x))
+#define MVLA__SINF(x)    sinf(x)
+#define MVLA__COSF(x)    cosf(x)
+#define MVLA__TANF(x)    tanf(x)
+#define MVLA__SINCOSF(x, s, c) (*(s) = sinf(x), *(c) = cosf(x))
+#define MVLA__POWF(x, y) powf((x), (y))
+#define MVLA__EXPD(x)    pow(MVLA_E, (x))
+#define MVLA__SIND(x)    sin(x)
+#define MVLA__COSD(x)    cos(x)
+#define MVLA__TAND(x)    tan(x)
+#define MVLA__SINCOSD(x, s, c) (*(s) = sin(x), *(c) = cos(x))
+#define MVLA__POWD(x, y) pow((x), (y))
+#endif // MVLA_FAST_MATH
+
+// -----------------------------------------
+
+/*
+** SIMD HELPERS
+*/
+
+/*
+** With runtime dispatch the wider tiers are compiled through per-function
+** target attributes rather than the command line, and only run after cpuid
+** says they can.
+*/
+
+#ifdef MVLA_DISPATCH
+#define MVLA__TARGET_AVX    __attribute__((target("avx")))
+#define MVLA__TARGET_AVX2   __attribute__((target("avx2,fma")))
+#define MVLA__TARGET_AVX512 __attribute__((target("avx512f,avx2,fma")))
+#else
+#define MVLA__TARGET_AVX
+#define MVLA__TARGET_AVX2
+#define MVLA__TARGET_AVX512
+#endif // MVLA_DISPATCH
+
+// GCC fuses separate multiply and add intrinsics into FMAs by default
+// (-ffp-contract=fast); kernels whose results must round like the scalar code
+// opt out per function
+#if defined(__GNUC__) && !defined(__clang__)
+#define MVLA__NO_CONTRACT __attribute__((optimize("fp-contract=off")))
+#else
+#define MVLA__NO_CONTRACT
+#endif // __GNUC__
+
+#if defined(MVLA_DISPATCH) || (defined(MVLA_HAS_AVX2) && defined(MVLA_HAS_FMA))
+#define MVLA__TIER_AVX2
+#endif // MVLA__TIER_AVX2
+
+#if defined(MVLA_DISPATCH) || defined(MVLA_HAS_AVX512F)
+#define MVLA__TIER_AVX512
+#endif // MVLA__TIER_AVX512
+
+#ifdef MVLA_HAS_SSE2
+
+// min/max that match fminf/fmaxf when exactly one operand is NaN
+static inline __m128 mvla__mm_min_ps(__m128 a, __m128 b) {
+  __m128 nan = _mm_cmpunord_ps(a, a);
+  __m128 r = _mm_min_ps(b, a);
+  return _mm_or_ps(_mm_and_ps(nan, b), _mm_andnot_ps(nan, r));
+}
+
+static inline __m128 mvla__mm_max_ps(__m128 a, __m128 b) {
+  __m128 nan = _mm_cmpunord_ps(a, a);
+  __m128 r = _mm_max_ps(b, a);
+  return _mm_or_ps(_mm_and_ps(nan, b), _mm_andnot_ps(nan, r));
+}
+
+static inline __m128d mvla__mm_min_pd(__m128d a, __m128d b) {
+  __m128d nan = _mm_cmpunord_pd(a, a);
+  __m128d r = _mm_min_pd(b, a);
+  return _mm_or_pd(_mm_and_pd(nan, b), _mm_andnot_pd(nan, r));
+}
+
+static inline __m128d mvla__mm_max_pd(__m128d a, __m128d b) {
+  __m128d nan = _mm_cmpunord_pd(a, a);
+  __m128d r = _mm_max_pd(b, a);
+  return _mm_or_pd(_mm_and_pd(nan, b), _mm_andnot_pd(nan, r));
+}
+
+// low 32 bits of each product, signed and unsigned alike
+static inline __m128i mvla__mm_mullo_epi32(__m128i a, __m128i b) {
+#ifdef MVLA_HAS_SSE41
+  return _mm_mullo_epi32(a, b);
+#else
+  __m128i even = _mm_mul_epu32(a, b);
+  __m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+#endif // MVLA_HAS_SSE41
+}
+
+static inline __m128i mvla__mm_select_si128(__m128i mask, __m128i a, __m128i b) {
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+static inline __m128i mvla__mm_min_epi32(__m128i a, __m128i b) {
+#ifdef MVLA_HAS_SSE41
+  return _mm_min_epi32(a, b);
+#else
+  return mvla__mm_select_si128(_mm_cmplt_epi32(a, b), a, b);
+#endif // MVLA_HAS_SSE41
+}
+
+static inline __m128i mvla__mm_max_epi32(__m128i a, __m128i b) {
+#ifdef MVLA_HAS_SSE41
+  return _mm_max_epi32(a, b);
+#else
+  return mvla__mm_select_si128(_mm_cmplt_epi32(a, b), b, a);
+#endif // MVLA_HAS_SSE41
+}
+
+// SSE2 only has signed compares, flipping the sign bit orders unsigned values
+static inline __m128i mvla__mm_min_epu32(__m128i a, __m128i b) {
+#ifdef MVLA_HAS_SSE41
+  return _mm_min_epu32(a, b);
+#else
+  __m128i bias = _mm_set1_epi32((int) 0x80000000u);
+  __m128i lt = _mm_cmplt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+  return mvla__mm_select_si128(lt, a, b);
+#endif // MVLA_HAS_SSE41
+}
+
+static inline __m128i mvla__mm_max_epu32(__m128i a, __m128i b) {
+#ifdef MVLA_HAS_SSE41
+  return _mm_max_epu32(a, b);
+#else
+  __m128i bias = _mm_set1_epi32((int) 0x80000000u);
+  __m128i lt = _mm_cmplt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+  return mvla__mm_select_si128(lt, b, a);
+#endif // MVLA_HAS_SSE41
+}
+
+// ((x + y) + z) + w, the same order as the scalar sums
+static inline float mvla__mm_sum_ps(__m128 a) {
+  __m128 y = _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1));
+  __m128 z = _mm_movehl_ps(a, a);
+  __m128 w = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3));
+  return _mm_cvtss_f32(_mm_add_ss(_mm_add_ss(_mm_add_ss(a, y), z), w));
+}
+
+// a * b + c, fused when the build targets FMA
+static inline __m128 mvla__mm_fmadd_ps(__m128 a, __m128 b, __m128 c) {
+#ifdef MVLA_HAS_FMA
+  return _mm_fmadd_ps(a, b, c);
+#else
+  return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif // MVLA_HAS_FMA
+}
+
+static inline __m128d mvla__mm_fmadd_pd(__m128d a, __m128d b, __m128d c) {
+#ifdef MVLA_HAS_FMA
+  return _mm_fmadd_pd(a, b, c);
+#else
+  return _mm_add_pd(_mm_mul_pd(a, b), c);
+#endif // MVLA_HAS_FMA
+}
+
+#endif // MVLA_HAS_SSE2
+
+#ifdef MVLA_HAS_AVX
+
+static inline __m256 mvla__mm256_fmadd_ps(__m256 a, __m256 b, __m256 c) {
+#ifdef MVLA_HAS_FMA
+  return _mm256_fmadd_ps(a, b, c);
+#else
+  return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif // MVLA_HAS_FMA
+}
+
+static inline __m256d mvla__mm256_fmadd_pd(__m256d a, __m256d b, __m256d c) {
+#ifdef MVLA_HAS_FMA
+  return _mm256_fmadd_pd(a, b, c);
+#else
+  return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif // MVLA_HAS_FMA
+}
+
+#endif // MVLA_HAS_AVX
+
+#if defined(MVLA_HAS_AVX) || defined(MVLA__TIER_AVX2)
+
+static inline MVLA__TARGET_AVX __m256 mvla__mm256_min_ps(__m256 a, __m256 b) {
+  return _mm256_blendv_ps(_mm256_min_ps(b, a), b, _mm256_cmp_ps(a, a, _CMP_UNORD_Q));
+}
+
+static inline MVLA__TARGET_AVX __m256 mvla__mm256_max_ps(__m256 a, __m256 b) {
+  return _mm256_blendv_ps(_mm256_max_ps(b, a), b, _mm256_cmp_ps(a, a, _CMP_UNORD_Q));
+}
+
+static inline MVLA__TARGET_AVX __m256d mvla__mm256_min_pd(__m256d a, __m256d b) {
+  return _mm256_blendv_pd(_mm256_min_pd(b, a), b, _mm256_cmp_pd(a, a, _CMP_UNORD_Q));
+}
+
+static inline MVLA__TARGET_AVX __m256d mvla__mm256_max_pd(__m256d a, __m256d b) {
+  return _mm256_blendv_pd(_mm256_max_pd(b, a), b, _mm256_cmp_pd(a, a, _CMP_UNORD_Q));
+}
+
+#endif // MVLA_HAS_AVX || MVLA__TIER_AVX2
+
+#ifdef MVLA__TIER_AVX512
+
+static inline MVLA__TARGET_AVX512 __m512 mvla__mm512_min_ps(__m512 a, __m512 b) {
+  return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a, a, _CMP_UNORD_Q), _mm512_min_ps(b, a), b);
+}
+
+static inline MVLA__TARGET_AVX512 __m512 mvla__mm512_max_ps(__m512 a, __m512 b) {
+  return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a, a, _CMP_UNORD_Q), _mm512_max_ps(b, a), b);
+}
+
+static inline MVLA__TARGET_AVX512 __m512d mvla__mm512_min_pd(__m512d a, __m512d b) {
+  return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(a, a, _CMP_UNORD_Q), _mm512_min_pd(b, a), b);
+}
+
+static inline MVLA__TARGET_AVX512 __m512d mvla__mm512_max_pd(__m512d a, __m512d b) {
+  return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(a, a, _CMP_UNORD_Q), _mm512_max_pd(b, a), b);
+}
+
+#endif // MVLA__TIER_AVX512
+
+// -----------------------------------------
+
+/*
+** randf() and randd() keep one generator per thread, so they take no lock and
+** threads never share a sequence. A thread that never called mvla_srand()
+** starts from the fixed default seed, jumped once for every unseeded thread
+** that drew before it, so the first thread replays the same sequence on every
+** run as rand() did. Without TLS support they fall back to a single global
+** generator that is not thread-safe.
+*/
+
+#if defined(__cplusplus) && __cplusplus >= 201103L
+#define MVLA__THREAD_LOCAL thread_local
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+#define MVLA__THREAD_LOCAL _Thread_local
+#elif defined(_MSC_VER)
+#define MVLA__THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__)
+#define MVLA__THREAD_LOCAL __thread
+#else
+#define MVLA__THREAD_LOCAL
+#endif // MVLA__THREAD_LOCAL
+
+#define MVLA__RNG_DEFAULT_SEED 1
+
+static MVLA__THREAD_LOCAL mvla_rng_t mvla__thread_rng_state;
+static MVLA__THREAD_LOCAL int mvla__thread_rng_seeded = 0;
+static unsigned long mvla__thread_rng_streams = 0;
+
+static inline mvla_rng_t *mvla__thread_rng(void) {
+  if (!mvla__thread_rng_seeded) {
+    unsigned long stream;
+#if defined(__GNUC__)
+    stream = __atomic_fetch_add(&mvla__thread_rng_streams, 1, __ATOMIC_RELAXED);
+#else
+    stream = mvla__thread_rng_streams++;
+#endif // __GNUC__
+    mvla__thread_rng_state = mvla_rng(MVLA__RNG_DEFAULT_SEED);
+    while (stream-- > 0) {
+      mvla_rng_jump(&mvla__thread_rng_state);
+    }
+    mvla__thread_rng_seeded = 1;
+  }
+  return &mvla__thread_rng_state;
+}
+
+MVLAIMPL float randf(void) {
+  return mvla_rng_randf(mvla__thread_rng());
+}
+
+MVLAIMPL double randd(void) {
+  return mvla_rng_randd(mvla__thread_rng());
+}
+
+MVLAIMPL float lerpf(float a, float b, float t) {
+  return a + ((b - a) * t);
+}
+
+MVLAIMPL double lerpd(double a, double b, double t) {
+  return a + ((b - a) * t);
+}
+
+MVLAIMPL signed int mini(signed int a, signed int b) {
+  return (a < b) ? a : b;
+}
+
+MVLAIMPL signed int maxi(signed int a, signed int b) {
+  return (a < b) ? b : a;
+}
+
+MVLAIMPL unsigned int minu(unsigned int a, unsigned int b) {
+  return (a < b) ? a : b;
+}
+
+MVLAIMPL unsigned int maxu(unsigned int a, unsigned int b) {
+  return (a < b) ? b : a;
+}
+
+// a * b + c rounded once where the target has FMA, libm's software fmaf would
+// cost far more than the extra rounding elsewhere
+static inline float mvla__fmaf(float a, float b, float c) {
+#if defined(MVLA_HAS_FMA) || defined(FP_FAST_FMAF)
+  return fmaf(a, b, c);
+#else
+  return a * b + c;
+#endif // MVLA_HAS_FMA || FP_FAST_FMAF
+}
+
+static inline double mvla__fmad(double a, double b, double c) {
+#if defined(MVLA_HAS_FMA) || defined(FP_FAST_FMA)
+  return fma(a, b, c);
+#else
+  return a * b + c;
+#endif // MVLA_HAS_FMA || FP_FAST_FMA
+}
+
+// -----------------------------------------
+
+MVLAIMPL v2i_t v2i(signed int x, signed int y) {
+  v2i_t vec;
+  vec.x = x;
+  vec.y = y;
+  return vec;
+}
+
+MVLAIMPL v2i_t v2ii(signed int x) { 
+  return v2i(x, x); 
+}
+
+MVLAIMPL v2i_t v2i_add(v2i_t a, v2i_t b) {
+  a.x += b.x;
+  a.y += b.y;
+  return a;
+}
+
+MVLAIMPL v2i_t v2i_sub(v2i_t a, v2i_t b) {
+  a.x -= b.x;
+  a.y -= b.y;
+  return a;
+}
+
+MVLAIMPL v2i_t v2i_mul(v2i_t a, v2i_t b) {
+  a.x *= b.x;
+  a.y *= b.y;
+  return a;
+}
+
+MVLAIMPL v2i_t v2i_div(v2i_t a, v2i_t b) {
+  a.x /= b.x;
+  a.y /= b.y;
+  return a;
+}
+
+MVLAIMPL v2i_t v2i_min(v2i_t a, v2i_t b) {
+  a.x = mini(a.x, b.x);
+  a.y = mini(a.y, b.y);
+  return a;
+}
 
 MVLAIMPL v2i_t v2i_max(v2i_t a, v2i_t b) {
   a.x = maxi(a.x, b.x);
@@ -1596,997 +10864,12427 @@ MVLAIMPL v2i_t v2i_max(v2i_t a, v2i_t b) {
   return a;
 }
 
-MVLAIMPL void v2i_print(v2i_t a) {
-  printf("v2i_t(%d, %d)\n", V2_ARGS(a));
+MVLAIMPL void v2i_print(v2i_t a) {
+  char buf[MVLA_FORMAT_MAX];
+  size_t len = v2i_format(a, buf);
+  buf[len] = '\n';
+  fwrite(buf, 1, len + 1, stdout);
+}
+
+MVLAIMPL v2u_t v2u(unsigned int x, unsigned int y) {
+  v2u_t vec;
+  vec.x = x;
+  vec.y = y;
+  return vec;
+}
+
+MVLAIMPL v2u_t v2uu(unsigned int x) { 
+  return v2u(x, x); 
+}
+
+MVLAIMPL v2u_t v2u_add(v2u_t a, v2u_t b) {
+  a.x += b.x;
+  a.y += b.y;
+  return a;
+}
+
+MVLAIMPL v2u_t v2u_sub(v2u_t a, v2u_t b) {
+  a.x -= b.x;
+  a.y -= b.y;
+  return a;
+}
+
+MVLAIMPL v2u_t v2u_mul(v2u_t a, v2u_t b) {
+  a.x *= b.x;
+  a.y *= b.y;
+  return a;
+}
+
+MVLAIMPL v2u_t v2u_div(v2u_t a, v2u_t b) {
+  a.x /= b.x;
+  a.y /= b.y;
+  return a;
+}
+
+MVLAIMPL v2u_t v2u_min(v2u_t a, v2u_t b) {
+  a.x = minu(a.x, b.x);
+  a.y = minu(a.y, b.y);
+  return a;
+}
+
+MVLAIMPL v2u_t v2u_max(v2u_t a, v2u_t b) {
+  a.x = maxu(a.x, b.x);
+  a.y = maxu(a.y, b.y);
+  return a;
+}
+
+MVLAIMPL void v2u_print(v2u_t a) {
+  char buf[MVLA_FORMAT_MAX];
+  size_t len = v2u_format(a, buf);
+  buf[len] = '\n';
+  fwrite(buf, 1, len + 1, stdout);
+}
+
+MVLAIMPL v2f_t v2f(float x, float y) {
+  v2f_t vec;
+  vec.x = x;
+  vec.y = y;
+  return vec;
+}
+
+MVLAIMPL v2f_t v2ff(float x) { 
+  return v2f(x, x); 
+}
+
+MVLAIMPL v2f_t v2f_add(v2f_t a, v2f_t b) {
+  a.x += b.x;
+  a.y += b.y;
+  return a;
+}
+
+MVLAIMPL v2f_t v2f_sub(v2f_t a, v2f_t b) {
+  a.x -= b.x;
+  a.y -= b.y;
+  return a;
+}
+
+MVLAIMPL v2f_t v2f_mul(v2f_t a, v2f_t b) {
+  a.x *= b.x;
+  a.y *= b.y;
+  return a;
+}
+
+MVLAIMPL v2f_t v2f_fma(v2f_t a, v2f_t b, v2f_t c) {
+  a.x = mvla__fmaf(a.x, b.x, c.x);
+  a.y = mvla__fmaf(a.y, b.y, c.y);
+  return a;
+}
+
+MVLAIMPL v2f_t v2f_fms(v2f_t a, v2f_t b, v2f_t c) {
+  a.x = mvla__fmaf(a.x, b.x, -c.x);
+  a.y = mvla__fmaf(a.y, b.y, -c.y);
+  return a;
+}
+
+MVLAIMPL v2f_t v2f_div(v2f_t a, v2f_t b) {
+  a.x /= b.x;
+  a.y /= b.y;
+  return a;
+}
+
+MVLAIMPL v2f_t v2f_min(v2f_t a, v2f_t b) {
+  a.x = fminf(a.x, b.x);
+  a.y = fminf(a.y, b.y);
+  return a;
+}
+
+MVLAIMPL v2f_t v2f_max(v2f_t a, v2f_t b) {
+  a.x = fmaxf(a.x, b.x);
+  a.y = fmaxf(a.y, b.y);
+  return a;
+}
+
+MVLAIMPL v2f_t v2f_sqrt(v2f_t a) {
+  a.x = sqrtf(a.x);
+  a.y = sqrtf(a.y);
+  return a;
+}
+
+MVLAIMPL v2f_t v2f_poww(v2f_t a, float exp) {
+  a.x = MVLA__POWF(a.x, exp);
+  a.y = MVLA__POWF(a.y, exp);
+  return a;
+}
+
+MVLAIMPL v2f_t v2f_pow(v2f_t a, v2f_t exp) {
+  a.x = MVLA__POWF(a.x, exp.x);
+  a.y = MVLA__POWF(a.y, exp.y);
+  return a;
+}
+
+MVLAIMPL v2f_t v2f_exp(v2f_t a) {
+  a.x = MVLA__EXPF(a.x);
+  a.y = MVLA__EXPF(a.y);
+  return a;
+}
+
+MVLAIMPL v2f_t v2f_sin(v2f_t a) {
+  a.x = MVLA__SINF(a.x);
+  a.y = MVLA__SINF(a.y);
+  return a;
+}
+
+MVLAIMPL v2f_t v2f_cos(v2f_t a) {
+  a.x = MVLA__COSF(a.x);
+  a.y = MVLA__COSF(a.y);
+  return a;
+}
+
+MVLAIMPL v2f_t v2f_tan(v2f_t a) {
+  a.x = MVLA__TANF(a.x);
+  a.y = MVLA__TANF(a.y);
+  return a;
+}
+
+MVLAIMPL void v2f_sincos(v2f_t a, v2f_t *s, v2f_t *c) {
+  MVLA__SINCOSF(a.x, &s->x, &c->x);
+  MVLA__SINCOSF(a.y, &s->y, &c->y);
+}
+
+MVLAIMPL float v2f_len(v2f_t a) {
+  return sqrtf(v2f_sqr_len(a));
+}
+
+MVLAIMPL float v2f_sqr_len(v2f_t a) {
+  return a.x * a.x + a.y * a.y;
+}
+
+MVLAIMPL float v2f_dot(v2f_t a, v2f_t b) {
+  return a.x * b.x + a.y * b.y;
+}
+
+MVLAIMPL float v2f_cross(v2f_t a, v2f_t b) {
+  return a.x * b.y - a.y * b.x;
+}
+
+MVLAIMPL v2f_t v2f_normalize(v2f_t a) {
+  float s = v2f_sqr_len(a), l;
+  if (!(s > 0.0f)) {
+    return v2ff(0.0f);
+  }
+  l = sqrtf(s);
+  a.x /= l;
+  a.y /= l;
+  return a;
+}
+
+MVLAIMPL v2f_t v2f_normalize_fast(v2f_t a) {
+  float s = v2f_sqr_len(a), r;
+  if (!(s > 0.0f)) {
+    return v2ff(0.0f);
+  }
+  r = rsqrtf_fast(s);
+  a.x *= r;
+  a.y *= r;
+  return a;
+}
+
+MVLAIMPL float v2f_dist(v2f_t a, v2f_t b) {
+  return v2f_len(v2f_sub(a, b));
+}
+
+MVLAIMPL float v2f_sqr_dist(v2f_t a, v2f_t b) {
+  return v2f_sqr_len(v2f_sub(a, b));
+}
+
+MVLAIMPL v2f_t v2f_project(v2f_t a, v2f_t b) {
+  float bb = v2f_dot(b, b);
+  if (!(bb > 0.0f)) {
+    return v2ff(0.0f);
+  }
+  return v2f_mul(b, v2ff(v2f_dot(a, b) / bb));
+}
+
+MVLAIMPL v2f_t v2f_reflect(v2f_t a, v2f_t n) {
+  return v2f_sub(a, v2f_mul(n, v2ff(2.0f * v2f_dot(a, n))));
+}
+
+MVLAIMPL void v2f_print(v2f_t a) {
+  char buf[MVLA_FORMAT_MAX];
+  size_t len = v2f_format(a, buf);
+  buf[len] = '\n';
+  fwrite(buf, 1, len + 1, stdout);
+}
+
+MVLAIMPL v2d_t v2d(double x, double y) {
+  v2d_t vec;
+#if defined(MVLA_SIMD_SSE)
+  vec.m = _mm_setr_pd(x, y);
+#elif defined(MVLA_SIMD_NEON)
+  double lanes[2] = { x, y };
+  vec.m = vld1q_f64(lanes);
+#else
+  vec.x = x;
+  vec.y = y;
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return vec;
+}
+
+MVLAIMPL v2d_t v2dd(double x) {
+  return v2d(x, x);
+}
+
+MVLAIMPL v2d_t v2d_add(v2d_t a, v2d_t b) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = _mm_add_pd(a.m, b.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vaddq_f64(a.m, b.m);
+#else
+  a.x += b.x;
+  a.y += b.y;
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v2d_t v2d_sub(v2d_t a, v2d_t b) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = _mm_sub_pd(a.m, b.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vsubq_f64(a.m, b.m);
+#else
+  a.x -= b.x;
+  a.y -= b.y;
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v2d_t v2d_mul(v2d_t a, v2d_t b) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = _mm_mul_pd(a.m, b.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vmulq_f64(a.m, b.m);
+#else
+  a.x *= b.x;
+  a.y *= b.y;
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v2d_t v2d_fma(v2d_t a, v2d_t b, v2d_t c) {
+#if defined(MVLA_SIMD_SSE) && defined(MVLA_HAS_FMA)
+  a.m = _mm_fmadd_pd(a.m, b.m, c.m);
+#elif defined(MVLA_SIMD_SSE)
+  a.m = _mm_add_pd(_mm_mul_pd(a.m, b.m), c.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vfmaq_f64(c.m, a.m, b.m);
+#else
+  a.x = mvla__fmad(a.x, b.x, c.x);
+  a.y = mvla__fmad(a.y, b.y, c.y);
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v2d_t v2d_fms(v2d_t a, v2d_t b, v2d_t c) {
+#if defined(MVLA_SIMD_SSE) && defined(MVLA_HAS_FMA)
+  a.m = _mm_fmsub_pd(a.m, b.m, c.m);
+#elif defined(MVLA_SIMD_SSE)
+  a.m = _mm_sub_pd(_mm_mul_pd(a.m, b.m), c.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vfmaq_f64(vnegq_f64(c.m), a.m, b.m);
+#else
+  a.x = mvla__fmad(a.x, b.x, -c.x);
+  a.y = mvla__fmad(a.y, b.y, -c.y);
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v2d_t v2d_div(v2d_t a, v2d_t b) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = _mm_div_pd(a.m, b.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vdivq_f64(a.m, b.m);
+#else
+  a.x /= b.x;
+  a.y /= b.y;
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v2d_t v2d_min(v2d_t a, v2d_t b) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = mvla__mm_min_pd(a.m, b.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vminnmq_f64(a.m, b.m);
+#else
+  a.x = fmin(a.x, b.x);
+  a.y = fmin(a.y, b.y);
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v2d_t v2d_max(v2d_t a, v2d_t b) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = mvla__mm_max_pd(a.m, b.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vmaxnmq_f64(a.m, b.m);
+#else
+  a.x = fmax(a.x, b.x);
+  a.y = fmax(a.y, b.y);
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v2d_t v2d_sqrt(v2d_t a) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = _mm_sqrt_pd(a.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vsqrtq_f64(a.m);
+#else
+  a.x = sqrt(a.x);
+  a.y = sqrt(a.y);
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v2d_t v2d_poww(v2d_t a, double exp) {
+  a.x = MVLA__POWD(a.x, exp);
+  a.y = MVLA__POWD(a.y, exp);
+  return a;
+}
+
+MVLAIMPL v2d_t v2d_pow(v2d_t a, v2d_t exp) {
+  a.x = MVLA__POWD(a.x, exp.x);
+  a.y = MVLA__POWD(a.y, exp.y);
+  return a;
+}
+
+MVLAIMPL v2d_t v2d_exp(v2d_t a) {
+  a.x = MVLA__EXPD(a.x);
+  a.y = MVLA__EXPD(a.y);
+  return a;
+}
+
+MVLAIMPL v2d_t v2d_sin(v2d_t a) {
+  a.x = MVLA__SIND(a.x);
+  a.y = MVLA__SIND(a.y);
+  return a;
+}
+
+MVLAIMPL v2d_t v2d_cos(v2d_t a) {
+  a.x = MVLA__COSD(a.x);
+  a.y = MVLA__COSD(a.y);
+  return a;
+}
+
+MVLAIMPL v2d_t v2d_tan(v2d_t a) {
+  a.x = MVLA__TAND(a.x);
+  a.y = MVLA__TAND(a.y);
+  return a;
+}
+
+MVLAIMPL void v2d_sincos(v2d_t a, v2d_t *s, v2d_t *c) {
+  MVLA__SINCOSD(a.x, &s->x, &c->x);
+  MVLA__SINCOSD(a.y, &s->y, &c->y);
+}
+
+MVLAIMPL double v2d_len(v2d_t a) {
+  return sqrt(v2d_sqr_len(a));
+}
+
+MVLAIMPL double v2d_sqr_len(v2d_t a) {
+#if defined(MVLA_SIMD_SSE)
+  __m128d sq = _mm_mul_pd(a.m, a.m);
+  return _mm_cvtsd_f64(_mm_add_sd(sq, _mm_unpackhi_pd(sq, sq)));
+#elif defined(MVLA_SIMD_NEON)
+  float64x2_t sq = vmulq_f64(a.m, a.m);
+  return vgetq_lane_f64(sq, 0) + vgetq_lane_f64(sq, 1);
+#else
+  return a.x * a.x + a.y * a.y;
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+}
+
+MVLAIMPL double v2d_dot(v2d_t a, v2d_t b) {
+#if defined(MVLA_SIMD_SSE)
+  __m128d prod = _mm_mul_pd(a.m, b.m);
+  return _mm_cvtsd_f64(_mm_add_sd(prod, _mm_unpackhi_pd(prod, prod)));
+#elif defined(MVLA_SIMD_NEON)
+  float64x2_t prod = vmulq_f64(a.m, b.m);
+  return vgetq_lane_f64(prod, 0) + vgetq_lane_f64(prod, 1);
+#else
+  return a.x * b.x + a.y * b.y;
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+}
+
+MVLAIMPL double v2d_cross(v2d_t a, v2d_t b) {
+  return a.x * b.y - a.y * b.x;
+}
+
+MVLAIMPL v2d_t v2d_normalize(v2d_t a) {
+  double s = v2d_sqr_len(a);
+  if (!(s > 0.0)) {
+    return v2dd(0.0);
+  }
+  return v2d_div(a, v2dd(sqrt(s)));
+}
+
+MVLAIMPL v2d_t v2d_normalize_fast(v2d_t a) {
+  double s = v2d_sqr_len(a);
+  if (!(s > 0.0)) {
+    return v2dd(0.0);
+  }
+  return v2d_mul(a, v2dd(rsqrtd_fast(s)));
+}
+
+MVLAIMPL double v2d_dist(v2d_t a, v2d_t b) {
+  return v2d_len(v2d_sub(a, b));
+}
+
+MVLAIMPL double v2d_sqr_dist(v2d_t a, v2d_t b) {
+  return v2d_sqr_len(v2d_sub(a, b));
+}
+
+MVLAIMPL v2d_t v2d_project(v2d_t a, v2d_t b) {
+  double bb = v2d_dot(b, b);
+  if (!(bb > 0.0)) {
+    return v2dd(0.0);
+  }
+  return v2d_mul(b, v2dd(v2d_dot(a, b) / bb));
+}
+
+MVLAIMPL v2d_t v2d_reflect(v2d_t a, v2d_t n) {
+  return v2d_sub(a, v2d_mul(n, v2dd(2.0 * v2d_dot(a, n))));
+}
+
+MVLAIMPL void v2d_print(v2d_t a) {
+  char buf[MVLA_FORMAT_MAX];
+  size_t len = v2d_format(a, buf);
+  buf[len] = '\n';
+  fwrite(buf, 1, len + 1, stdout);
+}
+
+// -----------------------------------------
+
+MVLAIMPL v3i_t v3i(signed int x, signed int y, signed int z) {
+  v3i_t vec;
+  vec.x = x;
+  vec.y = y;
+  vec.z = z;
+  return vec;
+}
+
+MVLAIMPL v3i_t v3ii(signed int x) {
+  return v3i(x, x, x);
+}
+
+MVLAIMPL v3i_t v3i_add(v3i_t a, v3i_t b) {
+  a.x += b.x;
+  a.y += b.y;
+  a.z += b.z;
+  return a;
+}
+
+MVLAIMPL v3i_t v3i_sub(v3i_t a, v3i_t b) {
+  a.x -= b.x;
+  a.y -= b.y;
+  a.z -= b.z;
+  return a;
+}
+
+MVLAIMPL v3i_t v3i_mul(v3i_t a, v3i_t b) {
+  a.x *= b.x;
+  a.y *= b.y;
+  a.z *= b.z;
+  return a;
+}
+
+MVLAIMPL v3i_t v3i_div(v3i_t a, v3i_t b) {
+  a.x /= b.x;
+  a.y /= b.y;
+  a.z /= b.z;
+  return a;
+}
+
+MVLAIMPL v3i_t v3i_min(v3i_t a, v3i_t b) {
+  a.x = mini(a.x, b.x);
+  a.y = mini(a.y, b.y);
+  a.z = mini(a.z, b.z);
+  return a;
+}
+
+MVLAIMPL v3i_t v3i_max(v3i_t a, v3i_t b) {
+  a.x = maxi(a.x, b.x);
+  a.y = maxi(a.y, b.y);
+  a.z = maxi(a.z, b.z);
+  return a;
+}
+
+MVLAIMPL void v3i_print(v3i_t a) {
+  char buf[MVLA_FORMAT_MAX];
+  size_t len = v3i_format(a, buf);
+  buf[len] = '\n';
+  fwrite(buf, 1, len + 1, stdout);
+}
+
+MVLAIMPL v3u_t v3u(unsigned int x, unsigned int y, unsigned int z) {
+  v3u_t vec;
+  vec.x = x;
+  vec.y = y;
+  vec.z = z;
+  return vec;
+}
+
+MVLAIMPL v3u_t v3uu(unsigned int x) {
+  return v3u(x, x, x);
+}
+
+MVLAIMPL v3u_t v3u_add(v3u_t a, v3u_t b) {
+  a.x += b.x;
+  a.y += b.y;
+  a.z += b.z;
+  return a;
+}
+
+MVLAIMPL v3u_t v3u_sub(v3u_t a, v3u_t b) {
+  a.x -= b.x;
+  a.y -= b.y;
+  a.z -= b.z;
+  return a;
+}
+
+MVLAIMPL v3u_t v3u_mul(v3u_t a, v3u_t b) {
+  a.x *= b.x;
+  a.y *= b.y;
+  a.z *= b.z;
+  return a;
+}
+
+MVLAIMPL v3u_t v3u_div(v3u_t a, v3u_t b) {
+  a.x /= b.x;
+  a.y /= b.y;
+  a.z /= b.z;
+  return a;
+}
+
+MVLAIMPL v3u_t v3u_min(v3u_t a, v3u_t b) {
+  a.x = minu(a.x, b.x);
+  a.y = minu(a.y, b.y);
+  a.z = minu(a.z, b.z);
+  return a;
+}
+
+MVLAIMPL v3u_t v3u_max(v3u_t a, v3u_t b) {
+  a.x = maxu(a.x, b.x);
+  a.y = maxu(a.y, b.y);
+  a.z = maxu(a.z, b.z);
+  return a;
+}
+
+MVLAIMPL void v3u_print(v3u_t a) {
+  char buf[MVLA_FORMAT_MAX];
+  size_t len = v3u_format(a, buf);
+  buf[len] = '\n';
+  fwrite(buf, 1, len + 1, stdout);
+}
+
+MVLAIMPL v3f_t v3f(float x, float y, float z) {
+  v3f_t vec;
+  vec.x = x;
+  vec.y = y;
+  vec.z = z;
+  return vec;
+}
+
+MVLAIMPL v3f_t v3ff(float x) {
+  return v3f(x, x, x);
+}
+
+MVLAIMPL v3f_t v3f_add(v3f_t a, v3f_t b) {
+  a.x += b.x;
+  a.y += b.y;
+  a.z += b.z;
+  return a;
+}
+
+MVLAIMPL v3f_t v3f_sub(v3f_t a, v3f_t b) {
+  a.x -= b.x;
+  a.y -= b.y;
+  a.z -= b.z;
+  return a;
+}
+
+MVLAIMPL v3f_t v3f_mul(v3f_t a, v3f_t b) {
+  a.x *= b.x;
+  a.y *= b.y;
+  a.z *= b.z;
+  return a;
+}
+
+MVLAIMPL v3f_t v3f_fma(v3f_t a, v3f_t b, v3f_t c) {
+  a.x = mvla__fmaf(a.x, b.x, c.x);
+  a.y = mvla__fmaf(a.y, b.y, c.y);
+  a.z = mvla__fmaf(a.z, b.z, c.z);
+  return a;
+}
+
+MVLAIMPL v3f_t v3f_fms(v3f_t a, v3f_t b, v3f_t c) {
+  a.x = mvla__fmaf(a.x, b.x, -c.x);
+  a.y = mvla__fmaf(a.y, b.y, -c.y);
+  a.z = mvla__fmaf(a.z, b.z, -c.z);
+  return a;
+}
+
+MVLAIMPL v3f_t v3f_div(v3f_t a, v3f_t b) {
+  a.x /= b.x;
+  a.y /= b.y;
+  a.z /= b.z;
+  return a;
+}
+
+MVLAIMPL v3f_t v3f_min(v3f_t a, v3f_t b) {
+  a.x = fminf(a.x, b.x);
+  a.y = fminf(a.y, b.y);
+  a.z = fminf(a.z, b.z);
+  return a;
+}
+
+MVLAIMPL v3f_t v3f_max(v3f_t a, v3f_t b) {
+  a.x = fmaxf(a.x, b.x);
+  a.y = fmaxf(a.y, b.y);
+  a.z = fmaxf(a.z, b.z);
+  return a;
+}
+
+MVLAIMPL v3f_t v3f_sqrt(v3f_t a) {
+  a.x = sqrtf(a.x);
+  a.y = sqrtf(a.y);
+  a.z = sqrtf(a.z);
+  return a;
+}
+
+MVLAIMPL v3f_t v3f_poww(v3f_t a, float exp) {
+  a.x = MVLA__POWF(a.x, exp);
+  a.y = MVLA__POWF(a.y, exp);
+  a.z = MVLA__POWF(a.z, exp);
+  return a;
+}
+
+MVLAIMPL v3f_t v3f_pow(v3f_t a, v3f_t exp) {
+  a.x = MVLA__POWF(a.x, exp.x);
+  a.y = MVLA__POWF(a.y, exp.y);
+  a.z = MVLA__POWF(a.z, exp.z);
+  return a;
+}
+
+MVLAIMPL v3f_t v3f_exp(v3f_t a) {
+  a.x = MVLA__EXPF(a.x);
+  a.y = MVLA__EXPF(a.y);
+  a.z = MVLA__EXPF(a.z);
+  return a;
+}
+
+MVLAIMPL v3f_t v3f_sin(v3f_t a) {
+  a.x = MVLA__SINF(a.x);
+  a.y = MVLA__SINF(a.y);
+  a.z = MVLA__SINF(a.z);
+  return a;
+}
+
+MVLAIMPL v3f_t v3f_cos(v3f_t a) {
+  a.x = MVLA__COSF(a.x);
+  a.y = MVLA__COSF(a.y);
+  a.z = MVLA__COSF(a.z);
+  return a;
+}
+
+MVLAIMPL v3f_t v3f_tan(v3f_t a) {
+  a.x = MVLA__TANF(a.x);
+  a.y = MVLA__TANF(a.y);
+  a.z = MVLA__TANF(a.z);
+  return a;
+}
+
+MVLAIMPL void v3f_sincos(v3f_t a, v3f_t *s, v3f_t *c) {
+  MVLA__SINCOSF(a.x, &s->x, &c->x);
+  MVLA__SINCOSF(a.y, &s->y, &c->y);
+  MVLA__SINCOSF(a.z, &s->z, &c->z);
+}
+
+MVLAIMPL float v3f_len(v3f_t a) {
+  return sqrtf(v3f_sqr_len(a));
+}
+
+MVLAIMPL float v3f_sqr_len(v3f_t a) {
+  return a.x * a.x + a.y * a.y + a.z * a.z;
+}
+
+MVLAIMPL float v3f_dot(v3f_t a, v3f_t b) {
+  return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+MVLAIMPL v3f_t v3f_cross(v3f_t a, v3f_t b) {
+  return v3f(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+}
+
+MVLAIMPL v3f_t v3f_normalize(v3f_t a) {
+  float s = v3f_sqr_len(a), l;
+  if (!(s > 0.0f)) {
+    return v3ff(0.0f);
+  }
+  l = sqrtf(s);
+  a.x /= l;
+  a.y /= l;
+  a.z /= l;
+  return a;
+}
+
+MVLAIMPL v3f_t v3f_normalize_fast(v3f_t a) {
+  float s = v3f_sqr_len(a), r;
+  if (!(s > 0.0f)) {
+    return v3ff(0.0f);
+  }
+  r = rsqrtf_fast(s);
+  a.x *= r;
+  a.y *= r;
+  a.z *= r;
+  return a;
+}
+
+MVLAIMPL float v3f_dist(v3f_t a, v3f_t b) {
+  return v3f_len(v3f_sub(a, b));
+}
+
+MVLAIMPL float v3f_sqr_dist(v3f_t a, v3f_t b) {
+  return v3f_sqr_len(v3f_sub(a, b));
+}
+
+MVLAIMPL v3f_t v3f_project(v3f_t a, v3f_t b) {
+  float bb = v3f_dot(b, b);
+  if (!(bb > 0.0f)) {
+    return v3ff(0.0f);
+  }
+  return v3f_mul(b, v3ff(v3f_dot(a, b) / bb));
+}
+
+MVLAIMPL v3f_t v3f_reflect(v3f_t a, v3f_t n) {
+  return v3f_sub(a, v3f_mul(n, v3ff(2.0f * v3f_dot(a, n))));
+}
+
+MVLAIMPL void v3f_print(v3f_t a) {
+  char buf[MVLA_FORMAT_MAX];
+  size_t len = v3f_format(a, buf);
+  buf[len] = '\n';
+  fwrite(buf, 1, len + 1, stdout);
+}
+
+MVLAIMPL v3d_t v3d(double x, double y, double z) {
+  v3d_t vec;
+  vec.x = x;
+  vec.y = y;
+  vec.z = z;
+  return vec;
+}
+
+MVLAIMPL v3d_t v3dd(double x) {
+  return v3d(x, x, x);
+}
+
+MVLAIMPL v3d_t v3d_add(v3d_t a, v3d_t b) {
+  a.x += b.x;
+  a.y += b.y;
+  a.z += b.z;
+  return a;
+}
+
+MVLAIMPL v3d_t v3d_sub(v3d_t a, v3d_t b) {
+  a.x -= b.x;
+  a.y -= b.y;
+  a.z -= b.z;
+  return a;
+}
+
+MVLAIMPL v3d_t v3d_mul(v3d_t a, v3d_t b) {
+  a.x *= b.x;
+  a.y *= b.y;
+  a.z *= b.z;
+  return a;
+}
+
+MVLAIMPL v3d_t v3d_fma(v3d_t a, v3d_t b, v3d_t c) {
+  a.x = mvla__fmad(a.x, b.x, c.x);
+  a.y = mvla__fmad(a.y, b.y, c.y);
+  a.z = mvla__fmad(a.z, b.z, c.z);
+  return a;
+}
+
+MVLAIMPL v3d_t v3d_fms(v3d_t a, v3d_t b, v3d_t c) {
+  a.x = mvla__fmad(a.x, b.x, -c.x);
+  a.y = mvla__fmad(a.y, b.y, -c.y);
+  a.z = mvla__fmad(a.z, b.z, -c.z);
+  return a;
+}
+
+MVLAIMPL v3d_t v3d_div(v3d_t a, v3d_t b) {
+  a.x /= b.x;
+  a.y /= b.y;
+  a.z /= b.z;
+  return a;
+}
+
+MVLAIMPL v3d_t v3d_min(v3d_t a, v3d_t b) {
+  a.x = fmin(a.x, b.x);
+  a.y = fmin(a.y, b.y);
+  a.z = fmin(a.z, b.z);
+  return a;
+}
+
+MVLAIMPL v3d_t v3d_max(v3d_t a, v3d_t b) {
+  a.x = fmax(a.x, b.x);
+  a.y = fmax(a.y, b.y);
+  a.z = fmax(a.z, b.z);
+  return a;
+}
+
+MVLAIMPL v3d_t v3d_sqrt(v3d_t a) {
+  a.x = sqrt(a.x);
+  a.y = sqrt(a.y);
+  a.z = sqrt(a.z);
+  return a;
+}
+
+MVLAIMPL v3d_t v3d_poww(v3d_t a, double exp) {
+  a.x = MVLA__POWD(a.x, exp);
+  a.y = MVLA__POWD(a.y, exp);
+  a.z = MVLA__POWD(a.z, exp);
+  return a;
+}
+
+MVLAIMPL v3d_t v3d_pow(v3d_t a, v3d_t exp) {
+  a.x = MVLA__POWD(a.x, exp.x);
+  a.y = MVLA__POWD(a.y, exp.y);
+  a.z = MVLA__POWD(a.z, exp.z);
+  return a;
+}
+
+MVLAIMPL v3d_t v3d_exp(v3d_t a) {
+  a.x = MVLA__EXPD(a.x);
+  a.y = MVLA__EXPD(a.y);
+  a.z = MVLA__EXPD(a.z);
+  return a;
+}
+
+MVLAIMPL v3d_t v3d_sin(v3d_t a) {
+  a.x = MVLA__SIND(a.x);
+  a.y = MVLA__SIND(a.y);
+  a.z = MVLA__SIND(a.z);
+  return a;
+}
+
+MVLAIMPL v3d_t v3d_cos(v3d_t a) {
+  a.x = MVLA__COSD(a.x);
+  a.y = MVLA__COSD(a.y);
+  a.z = MVLA__COSD(a.z);
+  return a;
+}
+
+MVLAIMPL v3d_t v3d_tan(v3d_t a) {
+  a.x = MVLA__TAND(a.x);
+  a.y = MVLA__TAND(a.y);
+  a.z = MVLA__TAND(a.z);
+  return a;
+}
+
+MVLAIMPL void v3d_sincos(v3d_t a, v3d_t *s, v3d_t *c) {
+  MVLA__SINCOSD(a.x, &s->x, &c->x);
+  MVLA__SINCOSD(a.y, &s->y, &c->y);
+  MVLA__SINCOSD(a.z, &s->z, &c->z);
+}
+
+MVLAIMPL double v3d_len(v3d_t a) {
+  return sqrt(v3d_sqr_len(a));
+}
+
+MVLAIMPL double v3d_sqr_len(v3d_t a) {
+  return a.x * a.x + a.y * a.y + a.z * a.z;
+}
+
+MVLAIMPL double v3d_dot(v3d_t a, v3d_t b) {
+  return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+MVLAIMPL v3d_t v3d_cross(v3d_t a, v3d_t b) {
+  return v3d(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+}
+
+MVLAIMPL v3d_t v3d_normalize(v3d_t a) {
+  double s = v3d_sqr_len(a), l;
+  if (!(s > 0.0)) {
+    return v3dd(0.0);
+  }
+  l = sqrt(s);
+  a.x /= l;
+  a.y /= l;
+  a.z /= l;
+  return a;
+}
+
+MVLAIMPL v3d_t v3d_normalize_fast(v3d_t a) {
+  double s = v3d_sqr_len(a), r;
+  if (!(s > 0.0)) {
+    return v3dd(0.0);
+  }
+  r = rsqrtd_fast(s);
+  a.x *= r;
+  a.y *= r;
+  a.z *= r;
+  return a;
+}
+
+MVLAIMPL double v3d_dist(v3d_t a, v3d_t b) {
+  return v3d_len(v3d_sub(a, b));
+}
+
+MVLAIMPL double v3d_sqr_dist(v3d_t a, v3d_t b) {
+  return v3d_sqr_len(v3d_sub(a, b));
+}
+
+MVLAIMPL v3d_t v3d_project(v3d_t a, v3d_t b) {
+  double bb = v3d_dot(b, b);
+  if (!(bb > 0.0)) {
+    return v3dd(0.0);
+  }
+  return v3d_mul(b, v3dd(v3d_dot(a, b) / bb));
+}
+
+MVLAIMPL v3d_t v3d_reflect(v3d_t a, v3d_t n) {
+  return v3d_sub(a, v3d_mul(n, v3dd(2.0 * v3d_dot(a, n))));
+}
+
+MVLAIMPL void v3d_print(v3d_t a) {
+  char buf[MVLA_FORMAT_MAX];
+  size_t len = v3d_format(a, buf);
+  buf[len] = '\n';
+  fwrite(buf, 1, len + 1, stdout);
+}
+
+// -----------------------------------------
+
+MVLAIMPL v4i_t v4i(signed int x, signed int y, signed int z, signed int w) {
+  v4i_t vec;
+#if defined(MVLA_SIMD_SSE)
+  vec.m = _mm_setr_epi32(x, y, z, w);
+#elif defined(MVLA_SIMD_NEON)
+  signed int lanes[4] = { x, y, z, w };
+  vec.m = vld1q_s32(lanes);
+#else
+  vec.x = x;
+  vec.y = y;
+  vec.z = z;
+  vec.w = w;
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return vec;
+}
+
+MVLAIMPL v4i_t v4ii(signed int x) {
+  return v4i(x, x, x, x);
+}
+
+MVLAIMPL v4i_t v4i_add(v4i_t a, v4i_t b) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = _mm_add_epi32(a.m, b.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vaddq_s32(a.m, b.m);
+#else
+  a.x += b.x;
+  a.y += b.y;
+  a.z += b.z;
+  a.w += b.w;
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v4i_t v4i_sub(v4i_t a, v4i_t b) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = _mm_sub_epi32(a.m, b.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vsubq_s32(a.m, b.m);
+#else
+  a.x -= b.x;
+  a.y -= b.y;
+  a.z -= b.z;
+  a.w -= b.w;
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v4i_t v4i_mul(v4i_t a, v4i_t b) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = mvla__mm_mullo_epi32(a.m, b.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vmulq_s32(a.m, b.m);
+#else
+  a.x *= b.x;
+  a.y *= b.y;
+  a.z *= b.z;
+  a.w *= b.w;
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v4i_t v4i_div(v4i_t a, v4i_t b) {
+  a.x /= b.x;
+  a.y /= b.y;
+  a.z /= b.z;
+  a.w /= b.w;
+  return a;
+}
+
+MVLAIMPL v4i_t v4i_min(v4i_t a, v4i_t b) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = mvla__mm_min_epi32(a.m, b.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vminq_s32(a.m, b.m);
+#else
+  a.x = mini(a.x, b.x);
+  a.y = mini(a.y, b.y);
+  a.z = mini(a.z, b.z);
+  a.w = mini(a.w, b.w);
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v4i_t v4i_max(v4i_t a, v4i_t b) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = mvla__mm_max_epi32(a.m, b.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vmaxq_s32(a.m, b.m);
+#else
+  a.x = maxi(a.x, b.x);
+  a.y = maxi(a.y, b.y);
+  a.z = maxi(a.z, b.z);
+  a.w = maxi(a.w, b.w);
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL void v4i_print(v4i_t a) {
+  char buf[MVLA_FORMAT_MAX];
+  size_t len = v4i_format(a, buf);
+  buf[len] = '\n';
+  fwrite(buf, 1, len + 1, stdout);
+}
+
+MVLAIMPL v4u_t v4u(unsigned int x, unsigned int y, unsigned int z, unsigned int w) {
+  v4u_t vec;
+#if defined(MVLA_SIMD_SSE)
+  vec.m = _mm_setr_epi32((int) x, (int) y, (int) z, (int) w);
+#elif defined(MVLA_SIMD_NEON)
+  unsigned int lanes[4] = { x, y, z, w };
+  vec.m = vld1q_u32(lanes);
+#else
+  vec.x = x;
+  vec.y = y;
+  vec.z = z;
+  vec.w = w;
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return vec;
+}
+
+MVLAIMPL v4u_t v4uu(unsigned int x) {
+  return v4u(x, x, x, x);
+}
+
+MVLAIMPL v4u_t v4u_add(v4u_t a, v4u_t b) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = _mm_add_epi32(a.m, b.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vaddq_u32(a.m, b.m);
+#else
+  a.x += b.x;
+  a.y += b.y;
+  a.z += b.z;
+  a.w += b.w;
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v4u_t v4u_sub(v4u_t a, v4u_t b) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = _mm_sub_epi32(a.m, b.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vsubq_u32(a.m, b.m);
+#else
+  a.x -= b.x;
+  a.y -= b.y;
+  a.z -= b.z;
+  a.w -= b.w;
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v4u_t v4u_mul(v4u_t a, v4u_t b) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = mvla__mm_mullo_epi32(a.m, b.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vmulq_u32(a.m, b.m);
+#else
+  a.x *= b.x;
+  a.y *= b.y;
+  a.z *= b.z;
+  a.w *= b.w;
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v4u_t v4u_div(v4u_t a, v4u_t b) {
+  a.x /= b.x;
+  a.y /= b.y;
+  a.z /= b.z;
+  a.w /= b.w;
+  return a;
+}
+
+MVLAIMPL v4u_t v4u_min(v4u_t a, v4u_t b) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = mvla__mm_min_epu32(a.m, b.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vminq_u32(a.m, b.m);
+#else
+  a.x = minu(a.x, b.x);
+  a.y = minu(a.y, b.y);
+  a.z = minu(a.z, b.z);
+  a.w = minu(a.w, b.w);
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v4u_t v4u_max(v4u_t a, v4u_t b) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = mvla__mm_max_epu32(a.m, b.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vmaxq_u32(a.m, b.m);
+#else
+  a.x = maxu(a.x, b.x);
+  a.y = maxu(a.y, b.y);
+  a.z = maxu(a.z, b.z);
+  a.w = maxu(a.w, b.w);
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL void v4u_print(v4u_t a) {
+  char buf[MVLA_FORMAT_MAX];
+  size_t len = v4u_format(a, buf);
+  buf[len] = '\n';
+  fwrite(buf, 1, len + 1, stdout);
+}
+
+MVLAIMPL v4f_t v4f(float x, float y, float z, float w) {
+  v4f_t vec;
+#if defined(MVLA_SIMD_SSE)
+  vec.m = _mm_setr_ps(x, y, z, w);
+#elif defined(MVLA_SIMD_NEON)
+  float lanes[4] = { x, y, z, w };
+  vec.m = vld1q_f32(lanes);
+#else
+  vec.x = x;
+  vec.y = y;
+  vec.z = z;
+  vec.w = w;
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return vec;
+}
+
+MVLAIMPL v4f_t v4ff(float x) { return v4f(x, x, x, x); }
+
+MVLAIMPL v4f_t v4f_add(v4f_t a, v4f_t b) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = _mm_add_ps(a.m, b.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vaddq_f32(a.m, b.m);
+#else
+  a.x += b.x;
+  a.y += b.y;
+  a.z += b.z;
+  a.w += b.w;
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v4f_t v4f_sub(v4f_t a, v4f_t b) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = _mm_sub_ps(a.m, b.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vsubq_f32(a.m, b.m);
+#else
+  a.x -= b.x;
+  a.y -= b.y;
+  a.z -= b.z;
+  a.w -= b.w;
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v4f_t v4f_mul(v4f_t a, v4f_t b) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = _mm_mul_ps(a.m, b.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vmulq_f32(a.m, b.m);
+#else
+  a.x *= b.x;
+  a.y *= b.y;
+  a.z *= b.z;
+  a.w *= b.w;
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v4f_t v4f_fma(v4f_t a, v4f_t b, v4f_t c) {
+#if defined(MVLA_SIMD_SSE) && defined(MVLA_HAS_FMA)
+  a.m = _mm_fmadd_ps(a.m, b.m, c.m);
+#elif defined(MVLA_SIMD_SSE)
+  a.m = _mm_add_ps(_mm_mul_ps(a.m, b.m), c.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vfmaq_f32(c.m, a.m, b.m);
+#else
+  a.x = mvla__fmaf(a.x, b.x, c.x);
+  a.y = mvla__fmaf(a.y, b.y, c.y);
+  a.z = mvla__fmaf(a.z, b.z, c.z);
+  a.w = mvla__fmaf(a.w, b.w, c.w);
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v4f_t v4f_fms(v4f_t a, v4f_t b, v4f_t c) {
+#if defined(MVLA_SIMD_SSE) && defined(MVLA_HAS_FMA)
+  a.m = _mm_fmsub_ps(a.m, b.m, c.m);
+#elif defined(MVLA_SIMD_SSE)
+  a.m = _mm_sub_ps(_mm_mul_ps(a.m, b.m), c.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vfmaq_f32(vnegq_f32(c.m), a.m, b.m);
+#else
+  a.x = mvla__fmaf(a.x, b.x, -c.x);
+  a.y = mvla__fmaf(a.y, b.y, -c.y);
+  a.z = mvla__fmaf(a.z, b.z, -c.z);
+  a.w = mvla__fmaf(a.w, b.w, -c.w);
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v4f_t v4f_div(v4f_t a, v4f_t b) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = _mm_div_ps(a.m, b.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vdivq_f32(a.m, b.m);
+#else
+  a.x /= b.x;
+  a.y /= b.y;
+  a.z /= b.z;
+  a.w /= b.w;
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v4f_t v4f_min(v4f_t a, v4f_t b) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = mvla__mm_min_ps(a.m, b.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vminnmq_f32(a.m, b.m);
+#else
+  a.x = fminf(a.x, b.x);
+  a.y = fminf(a.y, b.y);
+  a.z = fminf(a.z, b.z);
+  a.w = fminf(a.w, b.w);
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v4f_t v4f_max(v4f_t a, v4f_t b) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = mvla__mm_max_ps(a.m, b.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vmaxnmq_f32(a.m, b.m);
+#else
+  a.x = fmaxf(a.x, b.x);
+  a.y = fmaxf(a.y, b.y);
+  a.z = fmaxf(a.z, b.z);
+  a.w = fmaxf(a.w, b.w);
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v4f_t v4f_sqrt(v4f_t a) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = _mm_sqrt_ps(a.m);
+#elif defined(MVLA_SIMD_NEON)
+  a.m = vsqrtq_f32(a.m);
+#else
+  a.x = sqrtf(a.x);
+  a.y = sqrtf(a.y);
+  a.z = sqrtf(a.z);
+  a.w = sqrtf(a.w);
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+  return a;
+}
+
+MVLAIMPL v4f_t v4f_poww(v4f_t a, float exp) {
+  a.x = MVLA__POWF(a.x, exp);
+  a.y = MVLA__POWF(a.y, exp);
+  a.z = MVLA__POWF(a.z, exp);
+  a.w = MVLA__POWF(a.w, exp);
+  return a;
+}
+
+MVLAIMPL v4f_t v4f_pow(v4f_t a, v4f_t exp) {
+  a.x = MVLA__POWF(a.x, exp.x);
+  a.y = MVLA__POWF(a.y, exp.y);
+  a.z = MVLA__POWF(a.z, exp.z);
+  a.w = MVLA__POWF(a.w, exp.w);
+  return a;
+}
+
+MVLAIMPL v4f_t v4f_exp(v4f_t a) {
+  a.x = MVLA__EXPF(a.x);
+  a.y = MVLA__EXPF(a.y);
+  a.z = MVLA__EXPF(a.z);
+  a.w = MVLA__EXPF(a.w);
+  return a;
+}
+
+MVLAIMPL v4f_t v4f_sin(v4f_t a) {
+  a.x = MVLA__SINF(a.x);
+  a.y = MVLA__SINF(a.y);
+  a.z = MVLA__SINF(a.z);
+  a.w = MVLA__SINF(a.w);
+  return a;
+}
+
+MVLAIMPL v4f_t v4f_cos(v4f_t a) {
+  a.x = MVLA__COSF(a.x);
+  a.y = MVLA__COSF(a.y);
+  a.z = MVLA__COSF(a.z);
+  a.w = MVLA__COSF(a.w);
+  return a;
+}
+
+MVLAIMPL v4f_t v4f_tan(v4f_t a) {
+  a.x = MVLA__TANF(a.x);
+  a.y = MVLA__TANF(a.y);
+  a.z = MVLA__TANF(a.z);
+  a.w = MVLA__TANF(a.w);
+  return a;
+}
+
+MVLAIMPL void v4f_sincos(v4f_t a, v4f_t *s, v4f_t *c) {
+  MVLA__SINCOSF(a.x, &s->x, &c->x);
+  MVLA__SINCOSF(a.y, &s->y, &c->y);
+  MVLA__SINCOSF(a.z, &s->z, &c->z);
+  MVLA__SINCOSF(a.w, &s->w, &c->w);
+}
+
+MVLAIMPL float v4f_len(v4f_t a) {
+  return sqrtf(v4f_sqr_len(a));
+}
+
+MVLAIMPL float v4f_sqr_len(v4f_t a) {
+#if defined(MVLA_SIMD_SSE)
+  return mvla__mm_sum_ps(_mm_mul_ps(a.m, a.m));
+#elif defined(MVLA_SIMD_NEON)
+  float32x4_t sq = vmulq_f32(a.m, a.m);
+  return vgetq_lane_f32(sq, 0) + vgetq_lane_f32(sq, 1) + vgetq_lane_f32(sq, 2) + vgetq_lane_f32(sq, 3);
+#else
+  return a.x * a.x + a.y * a.y + a.z * a.z + a.w * a.w;
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+}
+
+MVLAIMPL float v4f_dot(v4f_t a, v4f_t b) {
+#if defined(MVLA_SIMD_SSE)
+  return mvla__mm_sum_ps(_mm_mul_ps(a.m, b.m));
+#elif defined(MVLA_SIMD_NEON)
+  float32x4_t prod = vmulq_f32(a.m, b.m);
+  return vgetq_lane_f32(prod, 0) + vgetq_lane_f32(prod, 1) + vgetq_lane_f32(prod, 2) + vgetq_lane_f32(prod, 3);
+#else
+  return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+#endif // MVLA_SIMD_SSE / MVLA_SIMD_NEON
+}
+
+MVLAIMPL v4f_t v4f_normalize(v4f_t a) {
+  float s = v4f_sqr_len(a);
+  if (!(s > 0.0f)) {
+    return v4ff(0.0f);
+  }
+  return v4f_div(a, v4ff(sqrtf(s)));
+}
+
+MVLAIMPL v4f_t v4f_normalize_fast(v4f_t a) {
+  float s = v4f_sqr_len(a);
+  if (!(s > 0.0f)) {
+    return v4ff(0.0f);
+  }
+  return v4f_mul(a, v4ff(rsqrtf_fast(s)));
+}
+
+MVLAIMPL float v4f_dist(v4f_t a, v4f_t b) {
+  return v4f_len(v4f_sub(a, b));
+}
+
+MVLAIMPL float v4f_sqr_dist(v4f_t a, v4f_t b) {
+  return v4f_sqr_len(v4f_sub(a, b));
+}
+
+MVLAIMPL v4f_t v4f_project(v4f_t a, v4f_t b) {
+  float bb = v4f_dot(b, b);
+  if (!(bb > 0.0f)) {
+    return v4ff(0.0f);
+  }
+  return v4f_mul(b, v4ff(v4f_dot(a, b) / bb));
+}
+
+MVLAIMPL v4f_t v4f_reflect(v4f_t a, v4f_t n) {
+  return v4f_sub(a, v4f_mul(n, v4ff(2.0f * v4f_dot(a, n))));
+}
+
+MVLAIMPL void v4f_print(v4f_t a) {
+  char buf[MVLA_FORMAT_MAX];
+  size_t len = v4f_format(a, buf);
+  buf[len] = '\n';
+  fwrite(buf, 1, len + 1, stdout);
+}
+
+MVLAIMPL v4d_t v4d(double x, double y, double z, double w) {
+  v4d_t vec;
+#if defined(MVLA_SIMD_AVX)
+  vec.m = _mm256_setr_pd(x, y, z, w);
+#else
+  vec.x = x;
+  vec.y = y;
+  vec.z = z;
+  vec.w = w;
+#endif // MVLA_SIMD_AVX
+  return vec;
+}
+
+MVLAIMPL v4d_t v4dd(double x) {
+  return v4d(x, x, x, x);
+}
+
+MVLAIMPL v4d_t v4d_add(v4d_t a, v4d_t b) {
+#if defined(MVLA_SIMD_AVX)
+  a.m = _mm256_add_pd(a.m, b.m);
+#else
+  a.x += b.x;
+  a.y += b.y;
+  a.z += b.z;
+  a.w += b.w;
+#endif // MVLA_SIMD_AVX
+  return a;
+}
+
+MVLAIMPL v4d_t v4d_sub(v4d_t a, v4d_t b) {
+#if defined(MVLA_SIMD_AVX)
+  a.m = _mm256_sub_pd(a.m, b.m);
+#else
+  a.x -= b.x;
+  a.y -= b.y;
+  a.z -= b.z;
+  a.w -= b.w;
+#endif // MVLA_SIMD_AVX
+  return a;
+}
+
+MVLAIMPL v4d_t v4d_mul(v4d_t a, v4d_t b) {
+#if defined(MVLA_SIMD_AVX)
+  a.m = _mm256_mul_pd(a.m, b.m);
+#else
+  a.x *= b.x;
+  a.y *= b.y;
+  a.z *= b.z;
+  a.w *= b.w;
+#endif // MVLA_SIMD_AVX
+  return a;
+}
+
+MVLAIMPL v4d_t v4d_fma(v4d_t a, v4d_t b, v4d_t c) {
+#if defined(MVLA_SIMD_AVX) && defined(MVLA_HAS_FMA)
+  a.m = _mm256_fmadd_pd(a.m, b.m, c.m);
+#elif defined(MVLA_SIMD_AVX)
+  a.m = _mm256_add_pd(_mm256_mul_pd(a.m, b.m), c.m);
+#else
+  a.x = mvla__fmad(a.x, b.x, c.x);
+  a.y = mvla__fmad(a.y, b.y, c.y);
+  a.z = mvla__fmad(a.z, b.z, c.z);
+  a.w = mvla__fmad(a.w, b.w, c.w);
+#endif // MVLA_SIMD_AVX
+  return a;
+}
+
+MVLAIMPL v4d_t v4d_fms(v4d_t a, v4d_t b, v4d_t c) {
+#if defined(MVLA_SIMD_AVX) && defined(MVLA_HAS_FMA)
+  a.m = _mm256_fmsub_pd(a.m, b.m, c.m);
+#elif defined(MVLA_SIMD_AVX)
+  a.m = _mm256_sub_pd(_mm256_mul_pd(a.m, b.m), c.m);
+#else
+  a.x = mvla__fmad(a.x, b.x, -c.x);
+  a.y = mvla__fmad(a.y, b.y, -c.y);
+  a.z = mvla__fmad(a.z, b.z, -c.z);
+  a.w = mvla__fmad(a.w, b.w, -c.w);
+#endif // MVLA_SIMD_AVX
+  return a;
+}
+
+MVLAIMPL v4d_t v4d_div(v4d_t a, v4d_t b) {
+#if defined(MVLA_SIMD_AVX)
+  a.m = _mm256_div_pd(a.m, b.m);
+#else
+  a.x /= b.x;
+  a.y /= b.y;
+  a.z /= b.z;
+  a.w /= b.w;
+#endif // MVLA_SIMD_AVX
+  return a;
+}
+
+MVLAIMPL v4d_t v4d_min(v4d_t a, v4d_t b) {
+#if defined(MVLA_SIMD_AVX)
+  a.m = mvla__mm256_min_pd(a.m, b.m);
+#else
+  a.x = fmin(a.x, b.x);
+  a.y = fmin(a.y, b.y);
+  a.z = fmin(a.z, b.z);
+  a.w = fmin(a.w, b.w);
+#endif // MVLA_SIMD_AVX
+  return a;
+}
+
+MVLAIMPL v4d_t v4d_max(v4d_t a, v4d_t b) {
+#if defined(MVLA_SIMD_AVX)
+  a.m = mvla__mm256_max_pd(a.m, b.m);
+#else
+  a.x = fmax(a.x, b.x);
+  a.y = fmax(a.y, b.y);
+  a.z = fmax(a.z, b.z);
+  a.w = fmax(a.w, b.w);
+#endif // MVLA_SIMD_AVX
+  return a;
+}
+
+MVLAIMPL v4d_t v4d_sqrt(v4d_t a) {
+#if defined(MVLA_SIMD_AVX)
+  a.m = _mm256_sqrt_pd(a.m);
+#else
+  a.x = sqrt(a.x);
+  a.y = sqrt(a.y);
+  a.z = sqrt(a.z);
+  a.w = sqrt(a.w);
+#endif // MVLA_SIMD_AVX
+  return a;
+}
+
+MVLAIMPL v4d_t v4d_poww(v4d_t a, double exp) {
+  a.x = MVLA__POWD(a.x, exp);
+  a.y = MVLA__POWD(a.y, exp);
+  a.z = MVLA__POWD(a.z, exp);
+  a.w = MVLA__POWD(a.w, exp);
+  return a;
+}
+
+MVLAIMPL v4d_t v4d_pow(v4d_t a, v4d_t exp) {
+  a.x = MVLA__POWD(a.x, exp.x);
+  a.y = MVLA__POWD(a.y, exp.y);
+  a.z = MVLA__POWD(a.z, exp.z);
+  a.w = MVLA__POWD(a.w, exp.w);
+  return a;
+}
+
+MVLAIMPL v4d_t v4d_exp(v4d_t a) {
+  a.x = MVLA__EXPD(a.x);
+  a.y = MVLA__EXPD(a.y);
+  a.z = MVLA__EXPD(a.z);
+  a.w = MVLA__EXPD(a.w);
+  return a;
+}
+
+MVLAIMPL v4d_t v4d_sin(v4d_t a) {
+  a.x = MVLA__SIND(a.x);
+  a.y = MVLA__SIND(a.y);
+  a.z = MVLA__SIND(a.z);
+  a.w = MVLA__SIND(a.w);
+  return a;
+}
+
+MVLAIMPL v4d_t v4d_cos(v4d_t a) {
+  a.x = MVLA__COSD(a.x);
+  a.y = MVLA__COSD(a.y);
+  a.z = MVLA__COSD(a.z);
+  a.w = MVLA__COSD(a.w);
+  return a;
+}
+
+MVLAIMPL v4d_t v4d_tan(v4d_t a) {
+  a.x = MVLA__TAND(a.x);
+  a.y = MVLA__TAND(a.y);
+  a.z = MVLA__TAND(a.z);
+  a.w = MVLA__TAND(a.w);
+  return a;
+}
+
+MVLAIMPL void v4d_sincos(v4d_t a, v4d_t *s, v4d_t *c) {
+  MVLA__SINCOSD(a.x, &s->x, &c->x);
+  MVLA__SINCOSD(a.y, &s->y, &c->y);
+  MVLA__SINCOSD(a.z, &s->z, &c->z);
+  MVLA__SINCOSD(a.w, &s->w, &c->w);
+}
+
+MVLAIMPL double v4d_len(v4d_t a) {
+  return sqrt(v4d_sqr_len(a));
+}
+
+MVLAIMPL double v4d_sqr_len(v4d_t a) {
+#if defined(MVLA_SIMD_AVX)
+  __m256d sq = _mm256_mul_pd(a.m, a.m);
+  __m128d lo = _mm256_castpd256_pd128(sq);
+  __m128d hi = _mm256_extractf128_pd(sq, 1);
+  __m128d s = _mm_add_sd(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)), hi);
+  return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(hi, hi)));
+#else
+  return a.x * a.x + a.y * a.y + a.z * a.z + a.w * a.w;
+#endif // MVLA_SIMD_AVX
+}
+
+MVLAIMPL double v4d_dot(v4d_t a, v4d_t b) {
+#if defined(MVLA_SIMD_AVX)
+  __m256d prod = _mm256_mul_pd(a.m, b.m);
+  __m128d lo = _mm256_castpd256_pd128(prod);
+  __m128d hi = _mm256_extractf128_pd(prod, 1);
+  __m128d s = _mm_add_sd(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)), hi);
+  return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(hi, hi)));
+#else
+  return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+#endif // MVLA_SIMD_AVX
+}
+
+MVLAIMPL v4d_t v4d_normalize(v4d_t a) {
+  double s = v4d_sqr_len(a);
+  if (!(s > 0.0)) {
+    return v4dd(0.0);
+  }
+  return v4d_div(a, v4dd(sqrt(s)));
+}
+
+MVLAIMPL v4d_t v4d_normalize_fast(v4d_t a) {
+  double s = v4d_sqr_len(a);
+  if (!(s > 0.0)) {
+    return v4dd(0.0);
+  }
+  return v4d_mul(a, v4dd(rsqrtd_fast(s)));
+}
+
+MVLAIMPL double v4d_dist(v4d_t a, v4d_t b) {
+  return v4d_len(v4d_sub(a, b));
+}
+
+MVLAIMPL double v4d_sqr_dist(v4d_t a, v4d_t b) {
+  return v4d_sqr_len(v4d_sub(a, b));
+}
+
+MVLAIMPL v4d_t v4d_project(v4d_t a, v4d_t b) {
+  double bb = v4d_dot(b, b);
+  if (!(bb > 0.0)) {
+    return v4dd(0.0);
+  }
+  return v4d_mul(b, v4dd(v4d_dot(a, b) / bb));
+}
+
+MVLAIMPL v4d_t v4d_reflect(v4d_t a, v4d_t n) {
+  return v4d_sub(a, v4d_mul(n, v4dd(2.0 * v4d_dot(a, n))));
+}
+
+MVLAIMPL void v4d_print(v4d_t a) {
+  char buf[MVLA_FORMAT_MAX];
+  size_t len = v4d_format(a, buf);
+  buf[len] = '\n';
+  fwrite(buf, 1, len + 1, stdout);
+}
+
+// -----------------------------------------
+
+/*
+** MATRIX FUNCTIONS
+**
+** A matrix is plain contiguous components whatever MVLA_SIMD says, so the
+** 4x4 products load it straight into SSE/AVX/NEON registers: each result
+** column is the left matrix's columns scaled by broadcast components and
+** summed. The other sizes are short enough that the compiler does as well
+** with scalar code.
+*/
+
+// one column of a * b: a's columns scaled by broadcasts of b's column and summed
+#if defined(MVLA_HAS_SSE2)
+static inline __m128 mvla__mm_mat4_col_ps(__m128 a0, __m128 a1, __m128 a2, __m128 a3, __m128 b) {
+  __m128 r = _mm_mul_ps(a0, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 0, 0, 0)));
+  r = mvla__mm_fmadd_ps(a1, _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 1, 1, 1)), r);
+  r = mvla__mm_fmadd_ps(a2, _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 2, 2, 2)), r);
+  return mvla__mm_fmadd_ps(a3, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 3, 3)), r);
+}
+#elif defined(MVLA_HAS_NEON)
+static inline float32x4_t mvla__neon_mat4_col_f32(float32x4_t a0, float32x4_t a1, float32x4_t a2,
+                                                  float32x4_t a3, float32x4_t b) {
+  float32x4_t r = vmulq_laneq_f32(a0, b, 0);
+  r = vfmaq_laneq_f32(r, a1, b, 1);
+  r = vfmaq_laneq_f32(r, a2, b, 2);
+  return vfmaq_laneq_f32(r, a3, b, 3);
+}
+#endif // MVLA_HAS_SSE2 / MVLA_HAS_NEON
+
+#ifdef MVLA_HAS_AVX
+// the same for two columns of b at once
+static inline __m256 mvla__mm256_mat4_col_ps(__m256 a0, __m256 a1, __m256 a2, __m256 a3, __m256 b) {
+  __m256 r = _mm256_mul_ps(a0, _mm256_shuffle_ps(b, b, _MM_SHUFFLE(0, 0, 0, 0)));
+  r = mvla__mm256_fmadd_ps(a1, _mm256_shuffle_ps(b, b, _MM_SHUFFLE(1, 1, 1, 1)), r);
+  r = mvla__mm256_fmadd_ps(a2, _mm256_shuffle_ps(b, b, _MM_SHUFFLE(2, 2, 2, 2)), r);
+  return mvla__mm256_fmadd_ps(a3, _mm256_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 3, 3)), r);
+}
+#endif // MVLA_HAS_AVX
+
+// mat2x2f_t
+
+MVLAIMPL mat2x2f_t mat2x2f(v2f_t c0, v2f_t c1) {
+  mat2x2f_t m;
+  m.c[0] = c0;
+  m.c[1] = c1;
+  return m;
+}
+
+MVLAIMPL mat2x2f_t mat2x2f_identity(void) {
+  return mat2x2f(v2f(1.0f, 0.0f),
+                 v2f(0.0f, 1.0f));
+}
+
+MVLAIMPL v2f_t mat2x2f_mul_v2f(mat2x2f_t m, v2f_t v) {
+  v2f_t r;
+  r.x = m.c[0].x * v.x + m.c[1].x * v.y;
+  r.y = m.c[0].y * v.x + m.c[1].y * v.y;
+  return r;
+}
+
+MVLAIMPL mat2x2f_t mat2x2f_mul(mat2x2f_t a, mat2x2f_t b) {
+  mat2x2f_t r;
+  r.c[0] = mat2x2f_mul_v2f(a, b.c[0]);
+  r.c[1] = mat2x2f_mul_v2f(a, b.c[1]);
+  return r;
+}
+
+MVLAIMPL mat2x2f_t mat2x2f_transpose(mat2x2f_t m) {
+  return mat2x2f(v2f(m.c[0].x, m.c[1].x),
+                 v2f(m.c[0].y, m.c[1].y));
+}
+
+MVLAIMPL float mat2x2f_det(mat2x2f_t m) {
+  return m.c[0].x * m.c[1].y - m.c[1].x * m.c[0].y;
+}
+
+MVLAIMPL mat2x2f_t mat2x2f_inverse(mat2x2f_t m) {
+  float det = mat2x2f_det(m);
+  float inv;
+  if (det == 0.0f) {
+    return mat2x2f(v2ff(0.0f), v2ff(0.0f));
+  }
+  inv = 1.0f / det;
+  return mat2x2f(v2f(m.c[1].y * inv, -m.c[0].y * inv), v2f(-m.c[1].x * inv, m.c[0].x * inv));
+}
+
+MVLAIMPL void mat2x2f_print(mat2x2f_t m) {
+  printf("mat2x2f_t(\n");
+  printf("  %f, %f\n", m.c[0].x, m.c[1].x);
+  printf("  %f, %f\n", m.c[0].y, m.c[1].y);
+  printf(")\n");
+}
+
+// mat2x2d_t
+
+MVLAIMPL mat2x2d_t mat2x2d(v2d_t c0, v2d_t c1) {
+  mat2x2d_t m;
+  m.c[0] = c0;
+  m.c[1] = c1;
+  return m;
+}
+
+MVLAIMPL mat2x2d_t mat2x2d_identity(void) {
+  return mat2x2d(v2d(1.0, 0.0),
+                 v2d(0.0, 1.0));
+}
+
+MVLAIMPL v2d_t mat2x2d_mul_v2d(mat2x2d_t m, v2d_t v) {
+  v2d_t r;
+  r.x = m.c[0].x * v.x + m.c[1].x * v.y;
+  r.y = m.c[0].y * v.x + m.c[1].y * v.y;
+  return r;
+}
+
+MVLAIMPL mat2x2d_t mat2x2d_mul(mat2x2d_t a, mat2x2d_t b) {
+  mat2x2d_t r;
+  r.c[0] = mat2x2d_mul_v2d(a, b.c[0]);
+  r.c[1] = mat2x2d_mul_v2d(a, b.c[1]);
+  return r;
+}
+
+MVLAIMPL mat2x2d_t mat2x2d_transpose(mat2x2d_t m) {
+  return mat2x2d(v2d(m.c[0].x, m.c[1].x),
+                 v2d(m.c[0].y, m.c[1].y));
+}
+
+MVLAIMPL double mat2x2d_det(mat2x2d_t m) {
+  return m.c[0].x * m.c[1].y - m.c[1].x * m.c[0].y;
+}
+
+MVLAIMPL mat2x2d_t mat2x2d_inverse(mat2x2d_t m) {
+  double det = mat2x2d_det(m);
+  double inv;
+  if (det == 0.0) {
+    return mat2x2d(v2dd(0.0), v2dd(0.0));
+  }
+  inv = 1.0 / det;
+  return mat2x2d(v2d(m.c[1].y * inv, -m.c[0].y * inv), v2d(-m.c[1].x * inv, m.c[0].x * inv));
+}
+
+MVLAIMPL void mat2x2d_print(mat2x2d_t m) {
+  printf("mat2x2d_t(\n");
+  printf("  %lf, %lf\n", m.c[0].x, m.c[1].x);
+  printf("  %lf, %lf\n", m.c[0].y, m.c[1].y);
+  printf(")\n");
+}
+
+// mat3x3f_t
+
+MVLAIMPL mat3x3f_t mat3x3f(v3f_t c0, v3f_t c1, v3f_t c2) {
+  mat3x3f_t m;
+  m.c[0] = c0;
+  m.c[1] = c1;
+  m.c[2] = c2;
+  return m;
+}
+
+MVLAIMPL mat3x3f_t mat3x3f_identity(void) {
+  return mat3x3f(v3f(1.0f, 0.0f, 0.0f),
+                 v3f(0.0f, 1.0f, 0.0f),
+                 v3f(0.0f, 0.0f, 1.0f));
+}
+
+MVLAIMPL v3f_t mat3x3f_mul_v3f(mat3x3f_t m, v3f_t v) {
+  v3f_t r;
+  r.x = m.c[0].x * v.x + m.c[1].x * v.y + m.c[2].x * v.z;
+  r.y = m.c[0].y * v.x + m.c[1].y * v.y + m.c[2].y * v.z;
+  r.z = m.c[0].z * v.x + m.c[1].z * v.y + m.c[2].z * v.z;
+  return r;
+}
+
+MVLAIMPL mat3x3f_t mat3x3f_mul(mat3x3f_t a, mat3x3f_t b) {
+  mat3x3f_t r;
+  r.c[0] = mat3x3f_mul_v3f(a, b.c[0]);
+  r.c[1] = mat3x3f_mul_v3f(a, b.c[1]);
+  r.c[2] = mat3x3f_mul_v3f(a, b.c[2]);
+  return r;
+}
+
+MVLAIMPL mat3x3f_t mat3x3f_transpose(mat3x3f_t m) {
+  return mat3x3f(v3f(m.c[0].x, m.c[1].x, m.c[2].x),
+                 v3f(m.c[0].y, m.c[1].y, m.c[2].y),
+                 v3f(m.c[0].z, m.c[1].z, m.c[2].z));
+}
+
+MVLAIMPL float mat3x3f_det(mat3x3f_t m) {
+  return v3f_dot(m.c[0], v3f_cross(m.c[1], m.c[2]));
+}
+
+MVLAIMPL mat3x3f_t mat3x3f_inverse(mat3x3f_t m) {
+  // the rows of the inverse are the cross products of column pairs over det
+  v3f_t r0 = v3f_cross(m.c[1], m.c[2]);
+  v3f_t r1 = v3f_cross(m.c[2], m.c[0]);
+  v3f_t r2 = v3f_cross(m.c[0], m.c[1]);
+  float det = v3f_dot(m.c[0], r0);
+  v3f_t inv;
+  if (det == 0.0f) {
+    return mat3x3f(v3ff(0.0f), v3ff(0.0f), v3ff(0.0f));
+  }
+  inv = v3ff(1.0f / det);
+  return mat3x3f_transpose(mat3x3f(v3f_mul(r0, inv), v3f_mul(r1, inv), v3f_mul(r2, inv)));
+}
+
+MVLAIMPL void mat3x3f_print(mat3x3f_t m) {
+  printf("mat3x3f_t(\n");
+  printf("  %f, %f, %f\n", m.c[0].x, m.c[1].x, m.c[2].x);
+  printf("  %f, %f, %f\n", m.c[0].y, m.c[1].y, m.c[2].y);
+  printf("  %f, %f, %f\n", m.c[0].z, m.c[1].z, m.c[2].z);
+  printf(")\n");
+}
+
+// mat3x3d_t
+
+MVLAIMPL mat3x3d_t mat3x3d(v3d_t c0, v3d_t c1, v3d_t c2) {
+  mat3x3d_t m;
+  m.c[0] = c0;
+  m.c[1] = c1;
+  m.c[2] = c2;
+  return m;
+}
+
+MVLAIMPL mat3x3d_t mat3x3d_identity(void) {
+  return mat3x3d(v3d(1.0, 0.0, 0.0),
+                 v3d(0.0, 1.0, 0.0),
+                 v3d(0.0, 0.0, 1.0));
+}
+
+MVLAIMPL v3d_t mat3x3d_mul_v3d(mat3x3d_t m, v3d_t v) {
+  v3d_t r;
+  r.x = m.c[0].x * v.x + m.c[1].x * v.y + m.c[2].x * v.z;
+  r.y = m.c[0].y * v.x + m.c[1].y * v.y + m.c[2].y * v.z;
+  r.z = m.c[0].z * v.x + m.c[1].z * v.y + m.c[2].z * v.z;
+  return r;
+}
+
+MVLAIMPL mat3x3d_t mat3x3d_mul(mat3x3d_t a, mat3x3d_t b) {
+  mat3x3d_t r;
+  r.c[0] = mat3x3d_mul_v3d(a, b.c[0]);
+  r.c[1] = mat3x3d_mul_v3d(a, b.c[1]);
+  r.c[2] = mat3x3d_mul_v3d(a, b.c[2]);
+  return r;
+}
+
+MVLAIMPL mat3x3d_t mat3x3d_transpose(mat3x3d_t m) {
+  return mat3x3d(v3d(m.c[0].x, m.c[1].x, m.c[2].x),
+                 v3d(m.c[0].y, m.c[1].y, m.c[2].y),
+                 v3d(m.c[0].z, m.c[1].z, m.c[2].z));
+}
+
+MVLAIMPL double mat3x3d_det(mat3x3d_t m) {
+  return v3d_dot(m.c[0], v3d_cross(m.c[1], m.c[2]));
+}
+
+MVLAIMPL mat3x3d_t mat3x3d_inverse(mat3x3d_t m) {
+  // the rows of the inverse are the cross products of column pairs over det
+  v3d_t r0 = v3d_cross(m.c[1], m.c[2]);
+  v3d_t r1 = v3d_cross(m.c[2], m.c[0]);
+  v3d_t r2 = v3d_cross(m.c[0], m.c[1]);
+  double det = v3d_dot(m.c[0], r0);
+  v3d_t inv;
+  if (det == 0.0) {
+    return mat3x3d(v3dd(0.0), v3dd(0.0), v3dd(0.0));
+  }
+  inv = v3dd(1.0 / det);
+  return mat3x3d_transpose(mat3x3d(v3d_mul(r0, inv), v3d_mul(r1, inv), v3d_mul(r2, inv)));
+}
+
+MVLAIMPL void mat3x3d_print(mat3x3d_t m) {
+  printf("mat3x3d_t(\n");
+  printf("  %lf, %lf, %lf\n", m.c[0].x, m.c[1].x, m.c[2].x);
+  printf("  %lf, %lf, %lf\n", m.c[0].y, m.c[1].y, m.c[2].y);
+  printf("  %lf, %lf, %lf\n", m.c[0].z, m.c[1].z, m.c[2].z);
+  printf(")\n");
+}
+
+// mat4x4f_t
+
+MVLAIMPL mat4x4f_t mat4x4f(v4f_t c0, v4f_t c1, v4f_t c2, v4f_t c3) {
+  mat4x4f_t m;
+  m.c[0] = c0;
+  m.c[1] = c1;
+  m.c[2] = c2;
+  m.c[3] = c3;
+  return m;
+}
+
+MVLAIMPL mat4x4f_t mat4x4f_identity(void) {
+  return mat4x4f(v4f(1.0f, 0.0f, 0.0f, 0.0f),
+                 v4f(0.0f, 1.0f, 0.0f, 0.0f),
+                 v4f(0.0f, 0.0f, 1.0f, 0.0f),
+                 v4f(0.0f, 0.0f, 0.0f, 1.0f));
+}
+
+MVLAIMPL v4f_t mat4x4f_mul_v4f(mat4x4f_t m, v4f_t v) {
+  v4f_t r;
+#if defined(MVLA_HAS_SSE2)
+  _mm_storeu_ps(&r.x, mvla__mm_mat4_col_ps(_mm_loadu_ps(&m.c[0].x), _mm_loadu_ps(&m.c[1].x),
+                                           _mm_loadu_ps(&m.c[2].x), _mm_loadu_ps(&m.c[3].x),
+                                           _mm_loadu_ps(&v.x)));
+#elif defined(MVLA_HAS_NEON)
+  vst1q_f32(&r.x, mvla__neon_mat4_col_f32(vld1q_f32(&m.c[0].x), vld1q_f32(&m.c[1].x),
+                                          vld1q_f32(&m.c[2].x), vld1q_f32(&m.c[3].x),
+                                          vld1q_f32(&v.x)));
+#else
+  r.x = m.c[0].x * v.x + m.c[1].x * v.y + m.c[2].x * v.z + m.c[3].x * v.w;
+  r.y = m.c[0].y * v.x + m.c[1].y * v.y + m.c[2].y * v.z + m.c[3].y * v.w;
+  r.z = m.c[0].z * v.x + m.c[1].z * v.y + m.c[2].z * v.z + m.c[3].z * v.w;
+  r.w = m.c[0].w * v.x + m.c[1].w * v.y + m.c[2].w * v.z + m.c[3].w * v.w;
+#endif // MVLA_HAS_SSE2 / MVLA_HAS_NEON
+  return r;
+}
+
+MVLAIMPL mat4x4f_t mat4x4f_mul(mat4x4f_t a, mat4x4f_t b) {
+  mat4x4f_t r;
+#if defined(MVLA_HAS_AVX)
+  // two result columns per register, with a's columns repeated in both halves
+  __m256 a01 = _mm256_loadu_ps(&a.c[0].x), a23 = _mm256_loadu_ps(&a.c[2].x);
+  __m256 a0 = _mm256_permute2f128_ps(a01, a01, 0x00), a1 = _mm256_permute2f128_ps(a01, a01, 0x11);
+  __m256 a2 = _mm256_permute2f128_ps(a23, a23, 0x00), a3 = _mm256_permute2f128_ps(a23, a23, 0x11);
+  _mm256_storeu_ps(&r.c[0].x, mvla__mm256_mat4_col_ps(a0, a1, a2, a3, _mm256_loadu_ps(&b.c[0].x)));
+  _mm256_storeu_ps(&r.c[2].x, mvla__mm256_mat4_col_ps(a0, a1, a2, a3, _mm256_loadu_ps(&b.c[2].x)));
+#elif defined(MVLA_HAS_SSE2)
+  __m128 a0 = _mm_loadu_ps(&a.c[0].x), a1 = _mm_loadu_ps(&a.c[1].x);
+  __m128 a2 = _mm_loadu_ps(&a.c[2].x), a3 = _mm_loadu_ps(&a.c[3].x);
+  _mm_storeu_ps(&r.c[0].x, mvla__mm_mat4_col_ps(a0, a1, a2, a3, _mm_loadu_ps(&b.c[0].x)));
+  _mm_storeu_ps(&r.c[1].x, mvla__mm_mat4_col_ps(a0, a1, a2, a3, _mm_loadu_ps(&b.c[1].x)));
+  _mm_storeu_ps(&r.c[2].x, mvla__mm_mat4_col_ps(a0, a1, a2, a3, _mm_loadu_ps(&b.c[2].x)));
+  _mm_storeu_ps(&r.c[3].x, mvla__mm_mat4_col_ps(a0, a1, a2, a3, _mm_loadu_ps(&b.c[3].x)));
+#elif defined(MVLA_HAS_NEON)
+  float32x4_t a0 = vld1q_f32(&a.c[0].x), a1 = vld1q_f32(&a.c[1].x);
+  float32x4_t a2 = vld1q_f32(&a.c[2].x), a3 = vld1q_f32(&a.c[3].x);
+  vst1q_f32(&r.c[0].x, mvla__neon_mat4_col_f32(a0, a1, a2, a3, vld1q_f32(&b.c[0].x)));
+  vst1q_f32(&r.c[1].x, mvla__neon_mat4_col_f32(a0, a1, a2, a3, vld1q_f32(&b.c[1].x)));
+  vst1q_f32(&r.c[2].x, mvla__neon_mat4_col_f32(a0, a1, a2, a3, vld1q_f32(&b.c[2].x)));
+  vst1q_f32(&r.c[3].x, mvla__neon_mat4_col_f32(a0, a1, a2, a3, vld1q_f32(&b.c[3].x)));
+#else
+  r.c[0] = mat4x4f_mul_v4f(a, b.c[0]);
+  r.c[1] = mat4x4f_mul_v4f(a, b.c[1]);
+  r.c[2] = mat4x4f_mul_v4f(a, b.c[2]);
+  r.c[3] = mat4x4f_mul_v4f(a, b.c[3]);
+#endif // MVLA_HAS_AVX / MVLA_HAS_SSE2 / MVLA_HAS_NEON
+  return r;
+}
+
+MVLAIMPL mat4x4f_t mat4x4f_transpose(mat4x4f_t m) {
+#if defined(MVLA_HAS_SSE2)
+  __m128 c0 = _mm_loadu_ps(&m.c[0].x), c1 = _mm_loadu_ps(&m.c[1].x);
+  __m128 c2 = _mm_loadu_ps(&m.c[2].x), c3 = _mm_loadu_ps(&m.c[3].x);
+  _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+  _mm_storeu_ps(&m.c[0].x, c0);
+  _mm_storeu_ps(&m.c[1].x, c1);
+  _mm_storeu_ps(&m.c[2].x, c2);
+  _mm_storeu_ps(&m.c[3].x, c3);
+  return m;
+#else
+  return mat4x4f(v4f(m.c[0].x, m.c[1].x, m.c[2].x, m.c[3].x),
+                 v4f(m.c[0].y, m.c[1].y, m.c[2].y, m.c[3].y),
+                 v4f(m.c[0].z, m.c[1].z, m.c[2].z, m.c[3].z),
+                 v4f(m.c[0].w, m.c[1].w, m.c[2].w, m.c[3].w));
+#endif // MVLA_HAS_SSE2
+}
+
+MVLAIMPL float mat4x4f_det(mat4x4f_t m) {
+  // Laplace expansion along the 2x2 minors of the first and last column pairs
+  float s0 = m.c[0].x * m.c[1].y - m.c[1].x * m.c[0].y;
+  float s1 = m.c[0].x * m.c[1].z - m.c[1].x * m.c[0].z;
+  float s2 = m.c[0].x * m.c[1].w - m.c[1].x * m.c[0].w;
+  float s3 = m.c[0].y * m.c[1].z - m.c[1].y * m.c[0].z;
+  float s4 = m.c[0].y * m.c[1].w - m.c[1].y * m.c[0].w;
+  float s5 = m.c[0].z * m.c[1].w - m.c[1].z * m.c[0].w;
+  float c5 = m.c[2].z * m.c[3].w - m.c[3].z * m.c[2].w;
+  float c4 = m.c[2].y * m.c[3].w - m.c[3].y * m.c[2].w;
+  float c3 = m.c[2].y * m.c[3].z - m.c[3].y * m.c[2].z;
+  float c2 = m.c[2].x * m.c[3].w - m.c[3].x * m.c[2].w;
+  float c1 = m.c[2].x * m.c[3].z - m.c[3].x * m.c[2].z;
+  float c0 = m.c[2].x * m.c[3].y - m.c[3].x * m.c[2].y;
+  return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+}
+
+MVLAIMPL mat4x4f_t mat4x4f_inverse(mat4x4f_t m) {
+  // the adjugate from the same minors as mat4x4f_det, columns taken as rows
+  // since the inverse of the transpose is the transpose of the inverse
+  float s0 = m.c[0].x * m.c[1].y - m.c[1].x * m.c[0].y;
+  float s1 = m.c[0].x * m.c[1].z - m.c[1].x * m.c[0].z;
+  float s2 = m.c[0].x * m.c[1].w - m.c[1].x * m.c[0].w;
+  float s3 = m.c[0].y * m.c[1].z - m.c[1].y * m.c[0].z;
+  float s4 = m.c[0].y * m.c[1].w - m.c[1].y * m.c[0].w;
+  float s5 = m.c[0].z * m.c[1].w - m.c[1].z * m.c[0].w;
+  float c5 = m.c[2].z * m.c[3].w - m.c[3].z * m.c[2].w;
+  float c4 = m.c[2].y * m.c[3].w - m.c[3].y * m.c[2].w;
+  float c3 = m.c[2].y * m.c[3].z - m.c[3].y * m.c[2].z;
+  float c2 = m.c[2].x * m.c[3].w - m.c[3].x * m.c[2].w;
+  float c1 = m.c[2].x * m.c[3].z - m.c[3].x * m.c[2].z;
+  float c0 = m.c[2].x * m.c[3].y - m.c[3].x * m.c[2].y;
+  float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+  float inv;
+  mat4x4f_t r;
+  if (det == 0.0f) {
+    return mat4x4f(v4ff(0.0f), v4ff(0.0f), v4ff(0.0f), v4ff(0.0f));
+  }
+  inv = 1.0f / det;
+  r.c[0].x = (m.c[1].y * c5 - m.c[1].z * c4 + m.c[1].w * c3) * inv;
+  r.c[0].y = (-m.c[0].y * c5 + m.c[0].z * c4 - m.c[0].w * c3) * inv;
+  r.c[0].z = (m.c[3].y * s5 - m.c[3].z * s4 + m.c[3].w * s3) * inv;
+  r.c[0].w = (-m.c[2].y * s5 + m.c[2].z * s4 - m.c[2].w * s3) * inv;
+  r.c[1].x = (-m.c[1].x * c5 + m.c[1].z * c2 - m.c[1].w * c1) * inv;
+  r.c[1].y = (m.c[0].x * c5 - m.c[0].z * c2 + m.c[0].w * c1) * inv;
+  r.c[1].z = (-m.c[3].x * s5 + m.c[3].z * s2 - m.c[3].w * s1) * inv;
+  r.c[1].w = (m.c[2].x * s5 - m.c[2].z * s2 + m.c[2].w * s1) * inv;
+  r.c[2].x = (m.c[1].x * c4 - m.c[1].y * c2 + m.c[1].w * c0) * inv;
+  r.c[2].y = (-m.c[0].x * c4 + m.c[0].y * c2 - m.c[0].w * c0) * inv;
+  r.c[2].z = (m.c[3].x * s4 - m.c[3].y * s2 + m.c[3].w * s0) * inv;
+  r.c[2].w = (-m.c[2].x * s4 + m.c[2].y * s2 - m.c[2].w * s0) * inv;
+  r.c[3].x = (-m.c[1].x * c3 + m.c[1].y * c1 - m.c[1].z * c0) * inv;
+  r.c[3].y = (m.c[0].x * c3 - m.c[0].y * c1 + m.c[0].z * c0) * inv;
+  r.c[3].z = (-m.c[3].x * s3 + m.c[3].y * s1 - m.c[3].z * s0) * inv;
+  r.c[3].w = (m.c[2].x * s3 - m.c[2].y * s1 + m.c[2].z * s0) * inv;
+  return r;
+}
+
+MVLAIMPL mat4x4f_t mat4x4f_inverse_rigid(mat4x4f_t m) {
+  // the transposed rotation, then the translation rotated back and negated
+  v3f_t t = v3f(m.c[3].x, m.c[3].y, m.c[3].z);
+  return mat4x4f(v4f(m.c[0].x, m.c[1].x, m.c[2].x, 0.0f),
+                 v4f(m.c[0].y, m.c[1].y, m.c[2].y, 0.0f),
+                 v4f(m.c[0].z, m.c[1].z, m.c[2].z, 0.0f),
+                 v4f(-v3f_dot(v3f(m.c[0].x, m.c[0].y, m.c[0].z), t),
+                      -v3f_dot(v3f(m.c[1].x, m.c[1].y, m.c[1].z), t),
+                      -v3f_dot(v3f(m.c[2].x, m.c[2].y, m.c[2].z), t), 1.0f));
+}
+
+MVLAIMPL void mat4x4f_print(mat4x4f_t m) {
+  printf("mat4x4f_t(\n");
+  printf("  %f, %f, %f, %f\n", m.c[0].x, m.c[1].x, m.c[2].x, m.c[3].x);
+  printf("  %f, %f, %f, %f\n", m.c[0].y, m.c[1].y, m.c[2].y, m.c[3].y);
+  printf("  %f, %f, %f, %f\n", m.c[0].z, m.c[1].z, m.c[2].z, m.c[3].z);
+  printf("  %f, %f, %f, %f\n", m.c[0].w, m.c[1].w, m.c[2].w, m.c[3].w);
+  printf(")\n");
+}
+
+// mat4x4d_t
+
+MVLAIMPL mat4x4d_t mat4x4d(v4d_t c0, v4d_t c1, v4d_t c2, v4d_t c3) {
+  mat4x4d_t m;
+  m.c[0] = c0;
+  m.c[1] = c1;
+  m.c[2] = c2;
+  m.c[3] = c3;
+  return m;
+}
+
+MVLAIMPL mat4x4d_t mat4x4d_identity(void) {
+  return mat4x4d(v4d(1.0, 0.0, 0.0, 0.0),
+                 v4d(0.0, 1.0, 0.0, 0.0),
+                 v4d(0.0, 0.0, 1.0, 0.0),
+                 v4d(0.0, 0.0, 0.0, 1.0));
+}
+
+MVLAIMPL v4d_t mat4x4d_mul_v4d(mat4x4d_t m, v4d_t v) {
+#if defined(MVLA_HAS_AVX)
+  v4d_t r;
+  __m256d acc = _mm256_mul_pd(_mm256_loadu_pd(&m.c[0].x), _mm256_broadcast_sd(&v.x));
+  acc = mvla__mm256_fmadd_pd(_mm256_loadu_pd(&m.c[1].x), _mm256_broadcast_sd(&v.y), acc);
+  acc = mvla__mm256_fmadd_pd(_mm256_loadu_pd(&m.c[2].x), _mm256_broadcast_sd(&v.z), acc);
+  acc = mvla__mm256_fmadd_pd(_mm256_loadu_pd(&m.c[3].x), _mm256_broadcast_sd(&v.w), acc);
+  _mm256_storeu_pd(&r.x, acc);
+  return r;
+#elif defined(MVLA_HAS_SSE2)
+  v4d_t r;
+  int j;
+  __m128d lo = _mm_setzero_pd(), hi = _mm_setzero_pd();
+  for (j = 0; j < 4; ++j) {
+    __m128d s = _mm_set1_pd((&v.x)[j]);
+    lo = mvla__mm_fmadd_pd(_mm_loadu_pd(&m.c[j].x), s, lo);
+    hi = mvla__mm_fmadd_pd(_mm_loadu_pd(&m.c[j].z), s, hi);
+  }
+  _mm_storeu_pd(&r.x, lo);
+  _mm_storeu_pd(&r.z, hi);
+  return r;
+#else
+  v4d_t r;
+  r.x = m.c[0].x * v.x + m.c[1].x * v.y + m.c[2].x * v.z + m.c[3].x * v.w;
+  r.y = m.c[0].y * v.x + m.c[1].y * v.y + m.c[2].y * v.z + m.c[3].y * v.w;
+  r.z = m.c[0].z * v.x + m.c[1].z * v.y + m.c[2].z * v.z + m.c[3].z * v.w;
+  r.w = m.c[0].w * v.x + m.c[1].w * v.y + m.c[2].w * v.z + m.c[3].w * v.w;
+  return r;
+#endif // MVLA_HAS_AVX / MVLA_HAS_SSE2
+}
+
+MVLAIMPL mat4x4d_t mat4x4d_mul(mat4x4d_t a, mat4x4d_t b) {
+  mat4x4d_t r;
+  r.c[0] = mat4x4d_mul_v4d(a, b.c[0]);
+  r.c[1] = mat4x4d_mul_v4d(a, b.c[1]);
+  r.c[2] = mat4x4d_mul_v4d(a, b.c[2]);
+  r.c[3] = mat4x4d_mul_v4d(a, b.c[3]);
+  return r;
+}
+
+MVLAIMPL mat4x4d_t mat4x4d_transpose(mat4x4d_t m) {
+  return mat4x4d(v4d(m.c[0].x, m.c[1].x, m.c[2].x, m.c[3].x),
+                 v4d(m.c[0].y, m.c[1].y, m.c[2].y, m.c[3].y),
+                 v4d(m.c[0].z, m.c[1].z, m.c[2].z, m.c[3].z),
+                 v4d(m.c[0].w, m.c[1].w, m.c[2].w, m.c[3].w));
+}
+
+MVLAIMPL double mat4x4d_det(mat4x4d_t m) {
+  // Laplace expansion along the 2x2 minors of the first and last column pairs
+  double s0 = m.c[0].x * m.c[1].y - m.c[1].x * m.c[0].y;
+  double s1 = m.c[0].x * m.c[1].z - m.c[1].x * m.c[0].z;
+  double s2 = m.c[0].x * m.c[1].w - m.c[1].x * m.c[0].w;
+  double s3 = m.c[0].y * m.c[1].z - m.c[1].y * m.c[0].z;
+  double s4 = m.c[0].y * m.c[1].w - m.c[1].y * m.c[0].w;
+  double s5 = m.c[0].z * m.c[1].w - m.c[1].z * m.c[0].w;
+  double c5 = m.c[2].z * m.c[3].w - m.c[3].z * m.c[2].w;
+  double c4 = m.c[2].y * m.c[3].w - m.c[3].y * m.c[2].w;
+  double c3 = m.c[2].y * m.c[3].z - m.c[3].y * m.c[2].z;
+  double c2 = m.c[2].x * m.c[3].w - m.c[3].x * m.c[2].w;
+  double c1 = m.c[2].x * m.c[3].z - m.c[3].x * m.c[2].z;
+  double c0 = m.c[2].x * m.c[3].y - m.c[3].x * m.c[2].y;
+  return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+}
+
+MVLAIMPL mat4x4d_t mat4x4d_inverse(mat4x4d_t m) {
+  // the adjugate from the same minors as mat4x4d_det, columns taken as rows
+  // since the inverse of the transpose is the transpose of the inverse
+  double s0 = m.c[0].x * m.c[1].y - m.c[1].x * m.c[0].y;
+  double s1 = m.c[0].x * m.c[1].z - m.c[1].x * m.c[0].z;
+  double s2 = m.c[0].x * m.c[1].w - m.c[1].x * m.c[0].w;
+  double s3 = m.c[0].y * m.c[1].z - m.c[1].y * m.c[0].z;
+  double s4 = m.c[0].y * m.c[1].w - m.c[1].y * m.c[0].w;
+  double s5 = m.c[0].z * m.c[1].w - m.c[1].z * m.c[0].w;
+  double c5 = m.c[2].z * m.c[3].w - m.c[3].z * m.c[2].w;
+  double c4 = m.c[2].y * m.c[3].w - m.c[3].y * m.c[2].w;
+  double c3 = m.c[2].y * m.c[3].z - m.c[3].y * m.c[2].z;
+  double c2 = m.c[2].x * m.c[3].w - m.c[3].x * m.c[2].w;
+  double c1 = m.c[2].x * m.c[3].z - m.c[3].x * m.c[2].z;
+  double c0 = m.c[2].x * m.c[3].y - m.c[3].x * m.c[2].y;
+  double det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+  double inv;
+  mat4x4d_t r;
+  if (det == 0.0) {
+    return mat4x4d(v4dd(0.0), v4dd(0.0), v4dd(0.0), v4dd(0.0));
+  }
+  inv = 1.0 / det;
+  r.c[0].x = (m.c[1].y * c5 - m.c[1].z * c4 + m.c[1].w * c3) * inv;
+  r.c[0].y = (-m.c[0].y * c5 + m.c[0].z * c4 - m.c[0].w * c3) * inv;
+  r.c[0].z = (m.c[3].y * s5 - m.c[3].z * s4 + m.c[3].w * s3) * inv;
+  r.c[0].w = (-m.c[2].y * s5 + m.c[2].z * s4 - m.c[2].w * s3) * inv;
+  r.c[1].x = (-m.c[1].x * c5 + m.c[1].z * c2 - m.c[1].w * c1) * inv;
+  r.c[1].y = (m.c[0].x * c5 - m.c[0].z * c2 + m.c[0].w * c1) * inv;
+  r.c[1].z = (-m.c[3].x * s5 + m.c[3].z * s2 - m.c[3].w * s1) * inv;
+  r.c[1].w = (m.c[2].x * s5 - m.c[2].z * s2 + m.c[2].w * s1) * inv;
+  r.c[2].x = (m.c[1].x * c4 - m.c[1].y * c2 + m.c[1].w * c0) * inv;
+  r.c[2].y = (-m.c[0].x * c4 + m.c[0].y * c2 - m.c[0].w * c0) * inv;
+  r.c[2].z = (m.c[3].x * s4 - m.c[3].y * s2 + m.c[3].w * s0) * inv;
+  r.c[2].w = (-m.c[2].x * s4 + m.c[2].y * s2 - m.c[2].w * s0) * inv;
+  r.c[3].x = (-m.c[1].x * c3 + m.c[1].y * c1 - m.c[1].z * c0) * inv;
+  r.c[3].y = (m.c[0].x * c3 - m.c[0].y * c1 + m.c[0].z * c0) * inv;
+  r.c[3].z = (-m.c[3].x * s3 + m.c[3].y * s1 - m.c[3].z * s0) * inv;
+  r.c[3].w = (m.c[2].x * s3 - m.c[2].y * s1 + m.c[2].z * s0) * inv;
+  return r;
+}
+
+MVLAIMPL mat4x4d_t mat4x4d_inverse_rigid(mat4x4d_t m) {
+  // the transposed rotation, then the translation rotated back and negated
+  v3d_t t = v3d(m.c[3].x, m.c[3].y, m.c[3].z);
+  return mat4x4d(v4d(m.c[0].x, m.c[1].x, m.c[2].x, 0.0),
+                 v4d(m.c[0].y, m.c[1].y, m.c[2].y, 0.0),
+                 v4d(m.c[0].z, m.c[1].z, m.c[2].z, 0.0),
+                 v4d(-v3d_dot(v3d(m.c[0].x, m.c[0].y, m.c[0].z), t),
+                      -v3d_dot(v3d(m.c[1].x, m.c[1].y, m.c[1].z), t),
+                      -v3d_dot(v3d(m.c[2].x, m.c[2].y, m.c[2].z), t), 1.0));
+}
+
+MVLAIMPL void mat4x4d_print(mat4x4d_t m) {
+  printf("mat4x4d_t(\n");
+  printf("  %lf, %lf, %lf, %lf\n", m.c[0].x, m.c[1].x, m.c[2].x, m.c[3].x);
+  printf("  %lf, %lf, %lf, %lf\n", m.c[0].y, m.c[1].y, m.c[2].y, m.c[3].y);
+  printf("  %lf, %lf, %lf, %lf\n", m.c[0].z, m.c[1].z, m.c[2].z, m.c[3].z);
+  printf("  %lf, %lf, %lf, %lf\n", m.c[0].w, m.c[1].w, m.c[2].w, m.c[3].w);
+  printf(")\n");
+}
+
+// -----------------------------------------
+
+/*
+** BATCH KERNELS
+**
+** Every v*_t is a tightly packed run of its scalar type, so an array of n
+** vectors is also a flat array of n * dim scalars. The component-wise batch
+** functions run over that flat view, which keeps full SIMD registers busy
+** whatever the vector stride is (12 bytes for v3f_t) and leaves at most one
+** register's worth of scalars for the tail loop.
+*/
+
+typedef char mvla__v2i_packed[(sizeof(v2i_t) == 2 * sizeof(signed int)) ? 1 : -1];
+typedef char mvla__v3i_packed[(sizeof(v3i_t) == 3 * sizeof(signed int)) ? 1 : -1];
+typedef char mvla__v4i_packed[(sizeof(v4i_t) == 4 * sizeof(signed int)) ? 1 : -1];
+typedef char mvla__v2u_packed[(sizeof(v2u_t) == 2 * sizeof(unsigned int)) ? 1 : -1];
+typedef char mvla__v3u_packed[(sizeof(v3u_t) == 3 * sizeof(unsigned int)) ? 1 : -1];
+typedef char mvla__v4u_packed[(sizeof(v4u_t) == 4 * sizeof(unsigned int)) ? 1 : -1];
+typedef char mvla__v2f_packed[(sizeof(v2f_t) == 2 * sizeof(float)) ? 1 : -1];
+typedef char mvla__v3f_packed[(sizeof(v3f_t) == 3 * sizeof(float)) ? 1 : -1];
+typedef char mvla__v4f_packed[(sizeof(v4f_t) == 4 * sizeof(float)) ? 1 : -1];
+typedef char mvla__v2d_packed[(sizeof(v2d_t) == 2 * sizeof(double)) ? 1 : -1];
+typedef char mvla__v3d_packed[(sizeof(v3d_t) == 3 * sizeof(double)) ? 1 : -1];
+typedef char mvla__v4d_packed[(sizeof(v4d_t) == 4 * sizeof(double)) ? 1 : -1];
+
+#ifdef MVLA_HAS_SSE2
+
+// (x0 y0 x1 y1) (x2 y2 x3 y3) -> (x0..x3) (y0..y3)
+static inline void mvla__mm_deinterleave2_ps(__m128 m0, __m128 m1, __m128 *x, __m128 *y) {
+  *x = _mm_shuffle_ps(m0, m1, _MM_SHUFFLE(2, 0, 2, 0));
+  *y = _mm_shuffle_ps(m0, m1, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+// (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3) -> (x0..x3) (y0..y3) (z0..z3)
+static inline void mvla__mm_deinterleave3_ps(__m128 m0, __m128 m1, __m128 m2,
+                                             __m128 *x, __m128 *y, __m128 *z) {
+  __m128 t0 = _mm_shuffle_ps(m1, m2, _MM_SHUFFLE(2, 1, 3, 2)); // x2 y2 x3 y3
+  __m128 t1 = _mm_shuffle_ps(m0, m1, _MM_SHUFFLE(1, 0, 2, 1)); // y0 z0 y1 z1
+  *x = _mm_shuffle_ps(m0, t0, _MM_SHUFFLE(2, 0, 3, 0));
+  *y = _mm_shuffle_ps(t1, t0, _MM_SHUFFLE(3, 1, 2, 0));
+  *z = _mm_shuffle_ps(t1, m2, _MM_SHUFFLE(3, 0, 3, 1));
+}
+
+// (x0 y0) (z0 x1) (y1 z1) -> (x0 x1) (y0 y1) (z0 z1)
+static inline void mvla__mm_deinterleave3_pd(__m128d m0, __m128d m1, __m128d m2,
+                                             __m128d *x, __m128d *y, __m128d *z) {
+  *x = _mm_shuffle_pd(m0, m1, 2);
+  *y = _mm_shuffle_pd(m0, m2, 1);
+  *z = _mm_shuffle_pd(m1, m2, 2);
+}
+
+#endif // MVLA_HAS_SSE2
+
+/*
+** Packed operation tables, one per dispatch tier. Every table exposes the same
+** operations so a single kernel body can be stamped out for each tier, with
+** the scalar table (width 1) doubling as the portable fallback.
+*/
+
+#define MVLA__SCALAR_PS_WIDTH       1
+#define MVLA__SCALAR_PS_T           float
+#define MVLA__SCALAR_PS_LOAD(p)     (*(p))
+#define MVLA__SCALAR_PS_STORE(p, v) (*(p) = (v))
+#define MVLA__SCALAR_PS_ADD(a, b)   ((a) + (b))
+#define MVLA__SCALAR_PS_SUB(a, b)   ((a) - (b))
+#define MVLA__SCALAR_PS_MUL(a, b)   ((a) * (b))
+#define MVLA__SCALAR_PS_DIV(a, b)   ((a) / (b))
+#define MVLA__SCALAR_PS_MIN(a, b)   fminf((a), (b))
+#define MVLA__SCALAR_PS_MAX(a, b)   fmaxf((a), (b))
+#define MVLA__SCALAR_PS_SQRT(a)     sqrtf(a)
+#define MVLA__SCALAR_PD_WIDTH       1
+#define MVLA__SCALAR_PD_T           double
+#define MVLA__SCALAR_PD_LOAD(p)     (*(p))
+#define MVLA__SCALAR_PD_STORE(p, v) (*(p) = (v))
+#define MVLA__SCALAR_PD_ADD(a, b)   ((a) + (b))
+#define MVLA__SCALAR_PD_SUB(a, b)   ((a) - (b))
+#define MVLA__SCALAR_PD_MUL(a, b)   ((a) * (b))
+#define MVLA__SCALAR_PD_DIV(a, b)   ((a) / (b))
+#define MVLA__SCALAR_PD_MIN(a, b)   fmin((a), (b))
+#define MVLA__SCALAR_PD_MAX(a, b)   fmax((a), (b))
+#define MVLA__SCALAR_PD_SQRT(a)     sqrt(a)
+#define MVLA__SCALAR_EPI32_WIDTH       1
+#define MVLA__SCALAR_EPI32_LOAD(p)     (*(p))
+#define MVLA__SCALAR_EPI32_STORE(p, v) (*(p) = (v))
+#define MVLA__SCALAR_EPI32_ADD(a, b)   ((a) + (b))
+#define MVLA__SCALAR_EPI32_SUB(a, b)   ((a) - (b))
+#define MVLA__SCALAR_EPI32_MUL(a, b)   ((a) * (b))
+#define MVLA__SCALAR_EPI32_MIN(a, b)   mini((a), (b))
+#define MVLA__SCALAR_EPI32_MAX(a, b)   maxi((a), (b))
+#define MVLA__SCALAR_EPU32_WIDTH       1
+#define MVLA__SCALAR_EPU32_LOAD(p)     (*(p))
+#define MVLA__SCALAR_EPU32_STORE(p, v) (*(p) = (v))
+#define MVLA__SCALAR_EPU32_ADD(a, b)   ((a) + (b))
+#define MVLA__SCALAR_EPU32_SUB(a, b)   ((a) - (b))
+#define MVLA__SCALAR_EPU32_MUL(a, b)   ((a) * (b))
+#define MVLA__SCALAR_EPU32_MIN(a, b)   minu((a), (b))
+#define MVLA__SCALAR_EPU32_MAX(a, b)   maxu((a), (b))
+
+#ifdef MVLA_HAS_SSE2
+#define MVLA__SSE2_PS_WIDTH       4
+#define MVLA__SSE2_PS_T           __m128
+#define MVLA__SSE2_PS_LOAD(p)     _mm_loadu_ps(p)
+#define MVLA__SSE2_PS_STORE(p, v) _mm_storeu_ps((p), (v))
+#define MVLA__SSE2_PS_ADD(a, b)   _mm_add_ps((a), (b))
+#define MVLA__SSE2_PS_SUB(a, b)   _mm_sub_ps((a), (b))
+#define MVLA__SSE2_PS_MUL(a, b)   _mm_mul_ps((a), (b))
+#define MVLA__SSE2_PS_DIV(a, b)   _mm_div_ps((a), (b))
+#define MVLA__SSE2_PS_MIN(a, b)   mvla__mm_min_ps((a), (b))
+#define MVLA__SSE2_PS_MAX(a, b)   mvla__mm_max_ps((a), (b))
+#define MVLA__SSE2_PS_SQRT(a)     _mm_sqrt_ps(a)
+#define MVLA__SSE2_PD_WIDTH       2
+#define MVLA__SSE2_PD_T           __m128d
+#define MVLA__SSE2_PD_LOAD(p)     _mm_loadu_pd(p)
+#define MVLA__SSE2_PD_STORE(p, v) _mm_storeu_pd((p), (v))
+#define MVLA__SSE2_PD_ADD(a, b)   _mm_add_pd((a), (b))
+#define MVLA__SSE2_PD_SUB(a, b)   _mm_sub_pd((a), (b))
+#define MVLA__SSE2_PD_MUL(a, b)   _mm_mul_pd((a), (b))
+#define MVLA__SSE2_PD_DIV(a, b)   _mm_div_pd((a), (b))
+#define MVLA__SSE2_PD_MIN(a, b)   mvla__mm_min_pd((a), (b))
+#define MVLA__SSE2_PD_MAX(a, b)   mvla__mm_max_pd((a), (b))
+#define MVLA__SSE2_PD_SQRT(a)     _mm_sqrt_pd(a)
+#define MVLA__SSE2_EPI32_WIDTH       4
+#define MVLA__SSE2_EPI32_LOAD(p)     _mm_loadu_si128((const __m128i *) (p))
+#define MVLA__SSE2_EPI32_STORE(p, v) _mm_storeu_si128((__m128i *) (p), (v))
+#define MVLA__SSE2_EPI32_ADD(a, b)   _mm_add_epi32((a), (b))
+#define MVLA__SSE2_EPI32_SUB(a, b)   _mm_sub_epi32((a), (b))
+#define MVLA__SSE2_EPI32_MUL(a, b)   mvla__mm_mullo_epi32((a), (b))
+#define MVLA__SSE2_EPI32_MIN(a, b)   mvla__mm_min_epi32((a), (b))
+#define MVLA__SSE2_EPI32_MAX(a, b)   mvla__mm_max_epi32((a), (b))
+#define MVLA__SSE2_EPU32_WIDTH       MVLA__SSE2_EPI32_WIDTH
+#define MVLA__SSE2_EPU32_LOAD(p)     MVLA__SSE2_EPI32_LOAD(p)
+#define MVLA__SSE2_EPU32_STORE(p, v) MVLA__SSE2_EPI32_STORE(p, v)
+#define MVLA__SSE2_EPU32_ADD(a, b)   MVLA__SSE2_EPI32_ADD(a, b)
+#define MVLA__SSE2_EPU32_SUB(a, b)   MVLA__SSE2_EPI32_SUB(a, b)
+#define MVLA__SSE2_EPU32_MUL(a, b)   MVLA__SSE2_EPI32_MUL(a, b)
+#define MVLA__SSE2_EPU32_MIN(a, b)   mvla__mm_min_epu32((a), (b))
+#define MVLA__SSE2_EPU32_MAX(a, b)   mvla__mm_max_epu32((a), (b))
+#endif // MVLA_HAS_SSE2
+
+#ifdef MVLA__TIER_AVX2
+#define MVLA__AVX2_PS_WIDTH       8
+#define MVLA__AVX2_PS_T           __m256
+#define MVLA__AVX2_PS_LOAD(p)     _mm256_loadu_ps(p)
+#define MVLA__AVX2_PS_STORE(p, v) _mm256_storeu_ps((p), (v))
+#define MVLA__AVX2_PS_ADD(a, b)   _mm256_add_ps((a), (b))
+#define MVLA__AVX2_PS_SUB(a, b)   _mm256_sub_ps((a), (b))
+#define MVLA__AVX2_PS_MUL(a, b)   _mm256_mul_ps((a), (b))
+#define MVLA__AVX2_PS_DIV(a, b)   _mm256_div_ps((a), (b))
+#define MVLA__AVX2_PS_MIN(a, b)   mvla__mm256_min_ps((a), (b))
+#define MVLA__AVX2_PS_MAX(a, b)   mvla__mm256_max_ps((a), (b))
+#define MVLA__AVX2_PS_SQRT(a)     _mm256_sqrt_ps(a)
+#define MVLA__AVX2_PD_WIDTH       4
+#define MVLA__AVX2_PD_T           __m256d
+#define MVLA__AVX2_PD_LOAD(p)     _mm256_loadu_pd(p)
+#define MVLA__AVX2_PD_STORE(p, v) _mm256_storeu_pd((p), (v))
+#define MVLA__AVX2_PD_ADD(a, b)   _mm256_add_pd((a), (b))
+#define MVLA__AVX2_PD_SUB(a, b)   _mm256_sub_pd((a), (b))
+#define MVLA__AVX2_PD_MUL(a, b)   _mm256_mul_pd((a), (b))
+#define MVLA__AVX2_PD_DIV(a, b)   _mm256_div_pd((a), (b))
+#define MVLA__AVX2_PD_MIN(a, b)   mvla__mm256_min_pd((a), (b))
+#define MVLA__AVX2_PD_MAX(a, b)   mvla__mm256_max_pd((a), (b))
+#define MVLA__AVX2_PD_SQRT(a)     _mm256_sqrt_pd(a)
+#define MVLA__AVX2_EPI32_WIDTH       8
+#define MVLA__AVX2_EPI32_LOAD(p)     _mm256_loadu_si256((const __m256i *) (p))
+#define MVLA__AVX2_EPI32_STORE(p, v) _mm256_storeu_si256((__m256i *) (p), (v))
+#define MVLA__AVX2_EPI32_ADD(a, b)   _mm256_add_epi32((a), (b))
+#define MVLA__AVX2_EPI32_SUB(a, b)   _mm256_sub_epi32((a), (b))
+#define MVLA__AVX2_EPI32_MUL(a, b)   _mm256_mullo_epi32((a), (b))
+#define MVLA__AVX2_EPI32_MIN(a, b)   _mm256_min_epi32((a), (b))
+#define MVLA__AVX2_EPI32_MAX(a, b)   _mm256_max_epi32((a), (b))
+#define MVLA__AVX2_EPU32_WIDTH       MVLA__AVX2_EPI32_WIDTH
+#define MVLA__AVX2_EPU32_LOAD(p)     MVLA__AVX2_EPI32_LOAD(p)
+#define MVLA__AVX2_EPU32_STORE(p, v) MVLA__AVX2_EPI32_STORE(p, v)
+#define MVLA__AVX2_EPU32_ADD(a, b)   MVLA__AVX2_EPI32_ADD(a, b)
+#define MVLA__AVX2_EPU32_SUB(a, b)   MVLA__AVX2_EPI32_SUB(a, b)
+#define MVLA__AVX2_EPU32_MUL(a, b)   MVLA__AVX2_EPI32_MUL(a, b)
+#define MVLA__AVX2_EPU32_MIN(a, b)   _mm256_min_epu32((a), (b))
+#define MVLA__AVX2_EPU32_MAX(a, b)   _mm256_max_epu32((a), (b))
+#endif // MVLA__TIER_AVX2
+
+#ifdef MVLA__TIER_AVX512
+#define MVLA__AVX512_PS_WIDTH       16
+#define MVLA__AVX512_PS_T           __m512
+#define MVLA__AVX512_PS_LOAD(p)     _mm512_loadu_ps(p)
+#define MVLA__AVX512_PS_STORE(p, v) _mm512_storeu_ps((p), (v))
+#define MVLA__AVX512_PS_ADD(a, b)   _mm512_add_ps((a), (b))
+#define MVLA__AVX512_PS_SUB(a, b)   _mm512_sub_ps((a), (b))
+#define MVLA__AVX512_PS_MUL(a, b)   _mm512_mul_ps((a), (b))
+#define MVLA__AVX512_PS_DIV(a, b)   _mm512_div_ps((a), (b))
+#define MVLA__AVX512_PS_MIN(a, b)   mvla__mm512_min_ps((a), (b))
+#define MVLA__AVX512_PS_MAX(a, b)   mvla__mm512_max_ps((a), (b))
+#define MVLA__AVX512_PS_SQRT(a)     _mm512_sqrt_ps(a)
+#define MVLA__AVX512_PD_WIDTH       8
+#define MVLA__AVX512_PD_T           __m512d
+#define MVLA__AVX512_PD_LOAD(p)     _mm512_loadu_pd(p)
+#define MVLA__AVX512_PD_STORE(p, v) _mm512_storeu_pd((p), (v))
+#define MVLA__AVX512_PD_ADD(a, b)   _mm512_add_pd((a), (b))
+#define MVLA__AVX512_PD_SUB(a, b)   _mm512_sub_pd((a), (b))
+#define MVLA__AVX512_PD_MUL(a, b)   _mm512_mul_pd((a), (b))
+#define MVLA__AVX512_PD_DIV(a, b)   _mm512_div_pd((a), (b))
+#define MVLA__AVX512_PD_MIN(a, b)   mvla__mm512_min_pd((a), (b))
+#define MVLA__AVX512_PD_MAX(a, b)   mvla__mm512_max_pd((a), (b))
+#define MVLA__AVX512_PD_SQRT(a)     _mm512_sqrt_pd(a)
+#define MVLA__AVX512_EPI32_WIDTH       16
+#define MVLA__AVX512_EPI32_LOAD(p)     _mm512_loadu_si512((const void *) (p))
+#define MVLA__AVX512_EPI32_STORE(p, v) _mm512_storeu_si512((void *) (p), (v))
+#define MVLA__AVX512_EPI32_ADD(a, b)   _mm512_add_epi32((a), (b))
+#define MVLA__AVX512_EPI32_SUB(a, b)   _mm512_sub_epi32((a), (b))
+#define MVLA__AVX512_EPI32_MUL(a, b)   _mm512_mullo_epi32((a), (b))
+#define MVLA__AVX512_EPI32_MIN(a, b)   _mm512_min_epi32((a), (b))
+#define MVLA__AVX512_EPI32_MAX(a, b)   _mm512_max_epi32((a), (b))
+#define MVLA__AVX512_EPU32_WIDTH       MVLA__AVX512_EPI32_WIDTH
+#define MVLA__AVX512_EPU32_LOAD(p)     MVLA__AVX512_EPI32_LOAD(p)
+#define MVLA__AVX512_EPU32_STORE(p, v) MVLA__AVX512_EPI32_STORE(p, v)
+#define MVLA__AVX512_EPU32_ADD(a, b)   MVLA__AVX512_EPI32_ADD(a, b)
+#define MVLA__AVX512_EPU32_SUB(a, b)   MVLA__AVX512_EPI32_SUB(a, b)
+#define MVLA__AVX512_EPU32_MUL(a, b)   MVLA__AVX512_EPI32_MUL(a, b)
+#define MVLA__AVX512_EPU32_MIN(a, b)   _mm512_min_epu32((a), (b))
+#define MVLA__AVX512_EPU32_MAX(a, b)   _mm512_max_epu32((a), (b))
+#endif // MVLA__TIER_AVX512
+
+/*
+** Extra operations for the fast math kernels: fused multiply-add and
+** multiply-subtract, bitwise logic, integer lanes of the same width (I) for
+** exponent tricks, an all lanes compare for the domain checks, conversions
+** from float arrays and non-temporal stores (STREAM, aligned to the width).
+** The scalar tier reaches the bits through memcpy.
+*/
+
+static inline unsigned int mvla__f32_bits(float a) {
+  unsigned int i;
+  memcpy(&i, &a, sizeof(i));
+  return i;
+}
+
+static inline float mvla__bits_f32(unsigned int i) {
+  float a;
+  memcpy(&a, &i, sizeof(a));
+  return a;
+}
+
+static inline unsigned long long mvla__f64_bits(double a) {
+  unsigned long long i;
+  memcpy(&i, &a, sizeof(i));
+  return i;
+}
+
+static inline double mvla__bits_f64(unsigned long long i) {
+  double a;
+  memcpy(&a, &i, sizeof(a));
+  return a;
+}
+
+// 1 / sqrt(a) estimate for targets without an instruction, good to ~20 bits
+static inline float mvla__rsqrt_est(float a) {
+  float y = mvla__bits_f32(0x5f3759dfu - (mvla__f32_bits(a) >> 1));
+  y = y * (1.5f - 0.5f * a * y * y);
+  return y * (1.5f - 0.5f * a * y * y);
+}
+
+#define MVLA__SCALAR_PS_I            unsigned int
+#define MVLA__SCALAR_PS_SET1(c)      (c)
+#define MVLA__SCALAR_PS_FMA(a, b, c) ((a) * (b) + (c))
+#define MVLA__SCALAR_PS_FMS(a, b, c) ((a) * (b) - (c))
+#define MVLA__SCALAR_PS_CASTI(a)     mvla__f32_bits(a)
+#define MVLA__SCALAR_PS_CASTF(i)     mvla__bits_f32(i)
+#define MVLA__SCALAR_PS_AND(a, b)    mvla__bits_f32(mvla__f32_bits(a) & mvla__f32_bits(b))
+#define MVLA__SCALAR_PS_OR(a, b)     mvla__bits_f32(mvla__f32_bits(a) | mvla__f32_bits(b))
+#define MVLA__SCALAR_PS_XOR(a, b)    mvla__bits_f32(mvla__f32_bits(a) ^ mvla__f32_bits(b))
+#define MVLA__SCALAR_PS_ANDNOT(a, b) mvla__bits_f32(~mvla__f32_bits(a) & mvla__f32_bits(b))
+#define MVLA__SCALAR_PS_ISET1(c)     ((unsigned int) (c))
+#define MVLA__SCALAR_PS_IADD(a, b)   ((a) + (b))
+#define MVLA__SCALAR_PS_ISUB(a, b)   ((a) - (b))
+#define MVLA__SCALAR_PS_IAND(a, b)   ((a) & (b))
+#define MVLA__SCALAR_PS_IOR(a, b)    ((a) | (b))
+#define MVLA__SCALAR_PS_ISLL(a, n)   ((a) << (n))
+#define MVLA__SCALAR_PS_ISRL(a, n)   ((a) >> (n))
+#define MVLA__SCALAR_PS_ALL_LE(a, b) ((a) <= (b))
+#define MVLA__SCALAR_PS_SEL_POS(s, a) ((s) > 0.0f ? (a) : 0.0f)
+#define MVLA__SCALAR_PS_STREAM(p, v) (*(p) = (v))
+#define MVLA__SCALAR_PS_RSQRT(a)     mvla__rsqrt_est(a)
+#define MVLA__SCALAR_PD_I            unsigned long long
+#define MVLA__SCALAR_PD_SET1(c)      (c)
+#define MVLA__SCALAR_PD_FMA(a, b, c) ((a) * (b) + (c))
+#define MVLA__SCALAR_PD_FMS(a, b, c) ((a) * (b) - (c))
+#define MVLA__SCALAR_PD_CASTI(a)     mvla__f64_bits(a)
+#define MVLA__SCALAR_PD_CASTF(i)     mvla__bits_f64(i)
+#define MVLA__SCALAR_PD_AND(a, b)    mvla__bits_f64(mvla__f64_bits(a) & mvla__f64_bits(b))
+#define MVLA__SCALAR_PD_OR(a, b)     mvla__bits_f64(mvla__f64_bits(a) | mvla__f64_bits(b))
+#define MVLA__SCALAR_PD_XOR(a, b)    mvla__bits_f64(mvla__f64_bits(a) ^ mvla__f64_bits(b))
+#define MVLA__SCALAR_PD_ANDNOT(a, b) mvla__bits_f64(~mvla__f64_bits(a) & mvla__f64_bits(b))
+#define MVLA__SCALAR_PD_ISET1(c)     ((unsigned long long) (c))
+#define MVLA__SCALAR_PD_IADD(a, b)   ((a) + (b))
+#define MVLA__SCALAR_PD_ISUB(a, b)   ((a) - (b))
+#define MVLA__SCALAR_PD_IAND(a, b)   ((a) & (b))
+#define MVLA__SCALAR_PD_IOR(a, b)    ((a) | (b))
+#define MVLA__SCALAR_PD_ISLL(a, n)   ((a) << (n))
+#define MVLA__SCALAR_PD_ISRL(a, n)   ((a) >> (n))
+#define MVLA__SCALAR_PD_IXOR(a, b)   ((a) ^ (b))
+#define MVLA__SCALAR_PD_IMULU32(a, b) (((a) & 0xffffffffULL) * ((b) & 0xffffffffULL))
+#define MVLA__SCALAR_PD_ILOAD(p)     (*(p))
+#define MVLA__SCALAR_PD_ISTORE(p, v) (*(p) = (v))
+#define MVLA__SCALAR_PD_ALL_LE(a, b) ((a) <= (b))
+#define MVLA__SCALAR_PD_SEL_POS(s, a) ((s) > 0.0 ? (a) : 0.0)
+#define MVLA__SCALAR_PD_STREAM(p, v) (*(p) = (v))
+#define MVLA__SCALAR_PD_LOADF(p)     ((double) *(p))
+#define MVLA__SCALAR_PD_STOREF(p, v) (*(p) = (float) (v))
+#define MVLA__SCALAR_PDF_WIDTH    MVLA__SCALAR_PD_WIDTH
+#define MVLA__SCALAR_PDF_LOAD(p)  MVLA__SCALAR_PD_LOADF(p)
+#define MVLA__SCALAR_PDF_STORE(p, v) MVLA__SCALAR_PD_STOREF(p, v)
+
+#ifdef MVLA_HAS_SSE2
+#define MVLA__SSE2_PS_I            __m128i
+#define MVLA__SSE2_PS_SET1(c)      _mm_set1_ps(c)
+#define MVLA__SSE2_PS_FMA(a, b, c) _mm_add_ps(_mm_mul_ps((a), (b)), (c))
+#define MVLA__SSE2_PS_FMS(a, b, c) _mm_sub_ps(_mm_mul_ps((a), (b)), (c))
+#define MVLA__SSE2_PS_CASTI(a)     _mm_castps_si128(a)
+#define MVLA__SSE2_PS_CASTF(i)     _mm_castsi128_ps(i)
+#define MVLA__SSE2_PS_AND(a, b)    _mm_and_ps((a), (b))
+#define MVLA__SSE2_PS_OR(a, b)     _mm_or_ps((a), (b))
+#define MVLA__SSE2_PS_XOR(a, b)    _mm_xor_ps((a), (b))
+#define MVLA__SSE2_PS_ANDNOT(a, b) _mm_andnot_ps((a), (b))
+#define MVLA__SSE2_PS_ISET1(c)     _mm_set1_epi32((int) (c))
+#define MVLA__SSE2_PS_IADD(a, b)   _mm_add_epi32((a), (b))
+#define MVLA__SSE2_PS_ISUB(a, b)   _mm_sub_epi32((a), (b))
+#define MVLA__SSE2_PS_IAND(a, b)   _mm_and_si128((a), (b))
+#define MVLA__SSE2_PS_IOR(a, b)    _mm_or_si128((a), (b))
+#define MVLA__SSE2_PS_ISLL(a, n)   _mm_slli_epi32((a), (n))
+#define MVLA__SSE2_PS_ISRL(a, n)   _mm_srli_epi32((a), (n))
+#define MVLA__SSE2_PS_ALL_LE(a, b) (_mm_movemask_ps(_mm_cmple_ps((a), (b))) == 0xf)
+#define MVLA__SSE2_PS_SEL_POS(s, a) _mm_and_ps(_mm_cmpgt_ps((s), _mm_setzero_ps()), (a))
+#define MVLA__SSE2_PS_STREAM(p, v) _mm_stream_ps((p), (v))
+#define MVLA__SSE2_PS_RSQRT(a)     _mm_rsqrt_ps(a)
+#define MVLA__SSE2_PD_I            __m128i
+#define MVLA__SSE2_PD_SET1(c)      _mm_set1_pd(c)
+#define MVLA__SSE2_PD_FMA(a, b, c) _mm_add_pd(_mm_mul_pd((a), (b)), (c))
+#define MVLA__SSE2_PD_FMS(a, b, c) _mm_sub_pd(_mm_mul_pd((a), (b)), (c))
+#define MVLA__SSE2_PD_CASTI(a)     _mm_castpd_si128(a)
+#define MVLA__SSE2_PD_CASTF(i)     _mm_castsi128_pd(i)
+#define MVLA__SSE2_PD_AND(a, b)    _mm_and_pd((a), (b))
+#define MVLA__SSE2_PD_OR(a, b)     _mm_or_pd((a), (b))
+#define MVLA__SSE2_PD_XOR(a, b)    _mm_xor_pd((a), (b))
+#define MVLA__SSE2_PD_ANDNOT(a, b) _mm_andnot_pd((a), (b))
+#define MVLA__SSE2_PD_ISET1(c)     _mm_set1_epi64x((long long) (c))
+#define MVLA__SSE2_PD_IADD(a, b)   _mm_add_epi64((a), (b))
+#define MVLA__SSE2_PD_ISUB(a, b)   _mm_sub_epi64((a), (b))
+#define MVLA__SSE2_PD_IAND(a, b)   _mm_and_si128((a), (b))
+#define MVLA__SSE2_PD_IOR(a, b)    _mm_or_si128((a), (b))
+#define MVLA__SSE2_PD_ISLL(a, n)   _mm_slli_epi64((a), (n))
+#define MVLA__SSE2_PD_ISRL(a, n)   _mm_srli_epi64((a), (n))
+#define MVLA__SSE2_PD_IXOR(a, b)   _mm_xor_si128((a), (b))
+#define MVLA__SSE2_PD_IMULU32(a, b) _mm_mul_epu32((a), (b))
+#define MVLA__SSE2_PD_ILOAD(p)     _mm_loadu_si128((const __m128i *) (p))
+#define MVLA__SSE2_PD_ISTORE(p, v) _mm_storeu_si128((__m128i *) (p), (v))
+#define MVLA__SSE2_PD_ALL_LE(a, b) (_mm_movemask_pd(_mm_cmple_pd((a), (b))) == 0x3)
+#define MVLA__SSE2_PD_SEL_POS(s, a) _mm_and_pd(_mm_cmpgt_pd((s), _mm_setzero_pd()), (a))
+#define MVLA__SSE2_PD_STREAM(p, v) _mm_stream_pd((p), (v))
+#define MVLA__SSE2_PD_LOADF(p)     _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64((const __m128i *) (p))))
+#define MVLA__SSE2_PD_STOREF(p, v) _mm_storel_epi64((__m128i *) (p), _mm_castps_si128(_mm_cvtpd_ps(v)))
+#define MVLA__SSE2_PDF_WIDTH    MVLA__SSE2_PD_WIDTH
+#define MVLA__SSE2_PDF_LOAD(p)  MVLA__SSE2_PD_LOADF(p)
+#define MVLA__SSE2_PDF_STORE(p, v) MVLA__SSE2_PD_STOREF(p, v)
+#endif // MVLA_HAS_SSE2
+
+#ifdef MVLA__TIER_AVX2
+#define MVLA__AVX2_PS_I            __m256i
+#define MVLA__AVX2_PS_SET1(c)      _mm256_set1_ps(c)
+#define MVLA__AVX2_PS_FMA(a, b, c) _mm256_fmadd_ps((a), (b), (c))
+#define MVLA__AVX2_PS_FMS(a, b, c) _mm256_fmsub_ps((a), (b), (c))
+#define MVLA__AVX2_PS_CASTI(a)     _mm256_castps_si256(a)
+#define MVLA__AVX2_PS_CASTF(i)     _mm256_castsi256_ps(i)
+#define MVLA__AVX2_PS_AND(a, b)    _mm256_and_ps((a), (b))
+#define MVLA__AVX2_PS_OR(a, b)     _mm256_or_ps((a), (b))
+#define MVLA__AVX2_PS_XOR(a, b)    _mm256_xor_ps((a), (b))
+#define MVLA__AVX2_PS_ANDNOT(a, b) _mm256_andnot_ps((a), (b))
+#define MVLA__AVX2_PS_ISET1(c)     _mm256_set1_epi32((int) (c))
+#define MVLA__AVX2_PS_IADD(a, b)   _mm256_add_epi32((a), (b))
+#define MVLA__AVX2_PS_ISUB(a, b)   _mm256_sub_epi32((a), (b))
+#define MVLA__AVX2_PS_IAND(a, b)   _mm256_and_si256((a), (b))
+#define MVLA__AVX2_PS_IOR(a, b)    _mm256_or_si256((a), (b))
+#define MVLA__AVX2_PS_ISLL(a, n)   _mm256_slli_epi32((a), (n))
+#define MVLA__AVX2_PS_ISRL(a, n)   _mm256_srli_epi32((a), (n))
+#define MVLA__AVX2_PS_ALL_LE(a, b) (_mm256_movemask_ps(_mm256_cmp_ps((a), (b), _CMP_LE_OQ)) == 0xff)
+#define MVLA__AVX2_PS_SEL_POS(s, a) _mm256_and_ps(_mm256_cmp_ps((s), _mm256_setzero_ps(), _CMP_GT_OQ), (a))
+#define MVLA__AVX2_PS_STREAM(p, v) _mm256_stream_ps((p), (v))
+#define MVLA__AVX2_PS_RSQRT(a)     _mm256_rsqrt_ps(a)
+#define MVLA__AVX2_PD_I            __m256i
+#define MVLA__AVX2_PD_SET1(c)      _mm256_set1_pd(c)
+#define MVLA__AVX2_PD_FMA(a, b, c) _mm256_fmadd_pd((a), (b), (c))
+#define MVLA__AVX2_PD_FMS(a, b, c) _mm256_fmsub_pd((a), (b), (c))
+#define MVLA__AVX2_PD_CASTI(a)     _mm256_castpd_si256(a)
+#define MVLA__AVX2_PD_CASTF(i)     _mm256_castsi256_pd(i)
+#define MVLA__AVX2_PD_AND(a, b)    _mm256_and_pd((a), (b))
+#define MVLA__AVX2_PD_OR(a, b)     _mm256_or_pd((a), (b))
+#define MVLA__AVX2_PD_XOR(a, b)    _mm256_xor_pd((a), (b))
+#define MVLA__AVX2_PD_ANDNOT(a, b) _mm256_andnot_pd((a), (b))
+#define MVLA__AVX2_PD_ISET1(c)     _mm256_set1_epi64x((long long) (c))
+#define MVLA__AVX2_PD_IADD(a, b)   _mm256_add_epi64((a), (b))
+#define MVLA__AVX2_PD_ISUB(a, b)   _mm256_sub_epi64((a), (b))
+#define MVLA__AVX2_PD_IAND(a, b)   _mm256_and_si256((a), (b))
+#define MVLA__AVX2_PD_IOR(a, b)    _mm256_or_si256((a), (b))
+#define MVLA__AVX2_PD_ISLL(a, n)   _mm256_slli_epi64((a), (n))
+#define MVLA__AVX2_PD_ISRL(a, n)   _mm256_srli_epi64((a), (n))
+#define MVLA__AVX2_PD_IXOR(a, b)   _mm256_xor_si256((a), (b))
+#define MVLA__AVX2_PD_IMULU32(a, b) _mm256_mul_epu32((a), (b))
+#define MVLA__AVX2_PD_ILOAD(p)     _mm256_loadu_si256((const __m256i *) (p))
+#define MVLA__AVX2_PD_ISTORE(p, v) _mm256_storeu_si256((__m256i *) (p), (v))
+#define MVLA__AVX2_PD_ALL_LE(a, b) (_mm256_movemask_pd(_mm256_cmp_pd((a), (b), _CMP_LE_OQ)) == 0xf)
+#define MVLA__AVX2_PD_SEL_POS(s, a) _mm256_and_pd(_mm256_cmp_pd((s), _mm256_setzero_pd(), _CMP_GT_OQ), (a))
+#define MVLA__AVX2_PD_STREAM(p, v) _mm256_stream_pd((p), (v))
+#define MVLA__AVX2_PD_LOADF(p)     _mm256_cvtps_pd(_mm_loadu_ps(p))
+#define MVLA__AVX2_PD_STOREF(p, v) _mm_storeu_ps((p), _mm256_cvtpd_ps(v))
+#define MVLA__AVX2_PDF_WIDTH    MVLA__AVX2_PD_WIDTH
+#define MVLA__AVX2_PDF_LOAD(p)  MVLA__AVX2_PD_LOADF(p)
+#define MVLA__AVX2_PDF_STORE(p, v) MVLA__AVX2_PD_STOREF(p, v)
+#endif // MVLA__TIER_AVX2
+
+#ifdef MVLA__TIER_AVX512
+#define MVLA__AVX512_PS_I            __m512i
+#define MVLA__AVX512_PS_SET1(c)      _mm512_set1_ps(c)
+#define MVLA__AVX512_PS_FMA(a, b, c) _mm512_fmadd_ps((a), (b), (c))
+#define MVLA__AVX512_PS_FMS(a, b, c) _mm512_fmsub_ps((a), (b), (c))
+#define MVLA__AVX512_PS_CASTI(a)     _mm512_castps_si512(a)
+#define MVLA__AVX512_PS_CASTF(i)     _mm512_castsi512_ps(i)
+#define MVLA__AVX512_PS_AND(a, b)    MVLA__AVX512_PS_CASTF(_mm512_and_si512(MVLA__AVX512_PS_CASTI(a), MVLA__AVX512_PS_CASTI(b)))
+#define MVLA__AVX512_PS_OR(a, b)     MVLA__AVX512_PS_CASTF(_mm512_or_si512(MVLA__AVX512_PS_CASTI(a), MVLA__AVX512_PS_CASTI(b)))
+#define MVLA__AVX512_PS_XOR(a, b)    MVLA__AVX512_PS_CASTF(_mm512_xor_si512(MVLA__AVX512_PS_CASTI(a), MVLA__AVX512_PS_CASTI(b)))
+#define MVLA__AVX512_PS_ANDNOT(a, b) MVLA__AVX512_PS_CASTF(_mm512_andnot_si512(MVLA__AVX512_PS_CASTI(a), MVLA__AVX512_PS_CASTI(b)))
+#define MVLA__AVX512_PS_ISET1(c)     _mm512_set1_epi32((int) (c))
+#define MVLA__AVX512_PS_IADD(a, b)   _mm512_add_epi32((a), (b))
+#define MVLA__AVX512_PS_ISUB(a, b)   _mm512_sub_epi32((a), (b))
+#define MVLA__AVX512_PS_IAND(a, b)   _mm512_and_si512((a), (b))
+#define MVLA__AVX512_PS_IOR(a, b)    _mm512_or_si512((a), (b))
+#define MVLA__AVX512_PS_ISLL(a, n)   _mm512_slli_epi32((a), (n))
+#define MVLA__AVX512_PS_ISRL(a, n)   _mm512_srli_epi32((a), (n))
+#define MVLA__AVX512_PS_ALL_LE(a, b) (_mm512_cmp_ps_mask((a), (b), _CMP_LE_OQ) == 0xffff)
+#define MVLA__AVX512_PS_SEL_POS(s, a) _mm512_maskz_mov_ps(_mm512_cmp_ps_mask((s), _mm512_setzero_ps(), _CMP_GT_OQ), (a))
+#define MVLA__AVX512_PS_STREAM(p, v) _mm512_stream_ps((p), (v))
+#define MVLA__AVX512_PS_RSQRT(a)     _mm512_rsqrt14_ps(a)
+#define MVLA__AVX512_PD_I            __m512i
+#define MVLA__AVX512_PD_SET1(c)      _mm512_set1_pd(c)
+#define MVLA__AVX512_PD_FMA(a, b, c) _mm512_fmadd_pd((a), (b), (c))
+#define MVLA__AVX512_PD_FMS(a, b, c) _mm512_fmsub_pd((a), (b), (c))
+#define MVLA__AVX512_PD_CASTI(a)     _mm512_castpd_si512(a)
+#define MVLA__AVX512_PD_CASTF(i)     _mm512_castsi512_pd(i)
+#define MVLA__AVX512_PD_AND(a, b)    MVLA__AVX512_PD_CASTF(_mm512_and_si512(MVLA__AVX512_PD_CASTI(a), MVLA__AVX512_PD_CASTI(b)))
+#define MVLA__AVX512_PD_OR(a, b)     MVLA__AVX512_PD_CASTF(_mm512_or_si512(MVLA__AVX512_PD_CASTI(a), MVLA__AVX512_PD_CASTI(b)))
+#define MVLA__AVX512_PD_XOR(a, b)    MVLA__AVX512_PD_CASTF(_mm512_xor_si512(MVLA__AVX512_PD_CASTI(a), MVLA__AVX512_PD_CASTI(b)))
+#define MVLA__AVX512_PD_ANDNOT(a, b) MVLA__AVX512_PD_CASTF(_mm512_andnot_si512(MVLA__AVX512_PD_CASTI(a), MVLA__AVX512_PD_CASTI(b)))
+#define MVLA__AVX512_PD_ISET1(c)     _mm512_set1_epi64((long long) (c))
+#define MVLA__AVX512_PD_IADD(a, b)   _mm512_add_epi64((a), (b))
+#define MVLA__AVX512_PD_ISUB(a, b)   _mm512_sub_epi64((a), (b))
+#define MVLA__AVX512_PD_IAND(a, b)   _mm512_and_si512((a), (b))
+#define MVLA__AVX512_PD_IOR(a, b)    _mm512_or_si512((a), (b))
+#define MVLA__AVX512_PD_ISLL(a, n)   _mm512_slli_epi64((a), (n))
+#define MVLA__AVX512_PD_ISRL(a, n)   _mm512_srli_epi64((a), (n))
+#define MVLA__AVX512_PD_IXOR(a, b)   _mm512_xor_si512((a), (b))
+#define MVLA__AVX512_PD_IMULU32(a, b) _mm512_mul_epu32((a), (b))
+#define MVLA__AVX512_PD_ILOAD(p)     _mm512_loadu_si512((const void *) (p))
+#define MVLA__AVX512_PD_ISTORE(p, v) _mm512_storeu_si512((void *) (p), (v))
+#define MVLA__AVX512_PD_ALL_LE(a, b) (_mm512_cmp_pd_mask((a), (b), _CMP_LE_OQ) == 0xff)
+#define MVLA__AVX512_PD_SEL_POS(s, a) _mm512_maskz_mov_pd(_mm512_cmp_pd_mask((s), _mm512_setzero_pd(), _CMP_GT_OQ), (a))
+#define MVLA__AVX512_PD_STREAM(p, v) _mm512_stream_pd((p), (v))
+#define MVLA__AVX512_PD_LOADF(p)     _mm512_cvtps_pd(_mm256_loadu_ps(p))
+#define MVLA__AVX512_PD_STOREF(p, v) _mm256_storeu_ps((p), _mm512_cvtpd_ps(v))
+#define MVLA__AVX512_PDF_WIDTH    MVLA__AVX512_PD_WIDTH
+#define MVLA__AVX512_PDF_LOAD(p)  MVLA__AVX512_PD_LOADF(p)
+#define MVLA__AVX512_PDF_STORE(p, v) MVLA__AVX512_PD_STOREF(p, v)
+#endif // MVLA__TIER_AVX512
+
+/*
+** Kernel lists. Each entry is (name, scalar type, table, operation, scalar
+** expression) and is stamped out once per compiled tier as mvla__<name>_<tier>.
+*/
+
+#define MVLA__BINARY_KERNELS(X)                                 \
+  X(i32_add, signed int, EPI32, ADD, a[i] + b[i])               \
+  X(i32_sub, signed int, EPI32, SUB, a[i] - b[i])               \
+  X(i32_mul, signed int, EPI32, MUL, a[i] * b[i])               \
+  X(i32_min, signed int, EPI32, MIN, mini(a[i], b[i]))          \
+  X(i32_max, signed int, EPI32, MAX, maxi(a[i], b[i]))          \
+  X(u32_add, unsigned int, EPU32, ADD, a[i] + b[i])             \
+  X(u32_sub, unsigned int, EPU32, SUB, a[i] - b[i])             \
+  X(u32_mul, unsigned int, EPU32, MUL, a[i] * b[i])             \
+  X(u32_min, unsigned int, EPU32, MIN, minu(a[i], b[i]))        \
+  X(u32_max, unsigned int, EPU32, MAX, maxu(a[i], b[i]))        \
+  X(f32_add, float, PS, ADD, a[i] + b[i])                       \
+  X(f32_sub, float, PS, SUB, a[i] - b[i])                       \
+  X(f32_mul, float, PS, MUL, a[i] * b[i])                       \
+  X(f32_div, float, PS, DIV, a[i] / b[i])                       \
+  X(f32_min, float, PS, MIN, fminf(a[i], b[i]))                 \
+  X(f32_max, float, PS, MAX, fmaxf(a[i], b[i]))                 \
+  X(f64_add, double, PD, ADD, a[i] + b[i])                      \
+  X(f64_sub, double, PD, SUB, a[i] - b[i])                      \
+  X(f64_mul, double, PD, MUL, a[i] * b[i])                      \
+  X(f64_div, double, PD, DIV, a[i] / b[i])                      \
+  X(f64_min, double, PD, MIN, fmin(a[i], b[i]))                 \
+  X(f64_max, double, PD, MAX, fmax(a[i], b[i]))
+
+#define MVLA__UNARY_KERNELS(X)                                  \
+  X(f32_sqrt, float, PS, SQRT, sqrtf(a[i]))                     \
+  X(f64_sqrt, double, PD, SQRT, sqrt(a[i]))
+
+#define MVLA__TERNARY_KERNELS(X)                                \
+  X(f32_fma, float, PS, FMA, mvla__fmaf(a[i], b[i], c[i]))      \
+  X(f32_fms, float, PS, FMS, mvla__fmaf(a[i], b[i], -c[i]))     \
+  X(f64_fma, double, PD, FMA, mvla__fmad(a[i], b[i], c[i]))     \
+  X(f64_fms, double, PD, FMS, mvla__fmad(a[i], b[i], -c[i]))
+
+#define MVLA__FAST_UNARY_KERNELS(X, tier, attr)                 \
+  X(tier, attr, f32_exp_fast, float, PS, exp_ps, expf_fast)     \
+  X(tier, attr, f32_log_fast, float, PS, log_ps, logf_fast)     \
+  X(tier, attr, f32_sin_fast, float, PS, sin_ps, sinf_fast)     \
+  X(tier, attr, f32_cos_fast, float, PS, cos_ps, cosf_fast)     \
+  X(tier, attr, f32_tan_fast, float, PS, tan_ps, tanf_fast)     \
+  X(tier, attr, f32_sqrt_fast, float, PS, sqrt_ps, sqrtf_fast)  \
+  X(tier, attr, f32_rsqrt_fast, float, PS, rsqrt_ps, rsqrtf_fast) \
+  X(tier, attr, f64_exp_fast, double, PD, exp_pd, expd_fast)    \
+  X(tier, attr, f64_log_fast, double, PD, log_pd, logd_fast)    \
+  X(tier, attr, f64_sin_fast, double, PD, sin_pd, sind_fast)    \
+  X(tier, attr, f64_cos_fast, double, PD, cos_pd, cosd_fast)    \
+  X(tier, attr, f64_tan_fast, double, PD, tan_pd, tand_fast)    \
+  X(tier, attr, f64_sqrt_fast, double, PD, sqrt_pd, sqrtd_fast) \
+  X(tier, attr, f64_rsqrt_fast, double, PD, rsqrt_pd, rsqrtd_fast)
+
+// float pow runs in double lanes (PDF loads and stores floats as doubles)
+#define MVLA__FAST_BINARY_KERNELS(X, tier, attr)                \
+  X(tier, attr, f32_pow_fast, float, PDF, powf_pd, powf_fast)   \
+  X(tier, attr, f64_pow_fast, double, PD, pow_pd, powd_fast)
+
+#define MVLA__FAST_SINCOS_KERNELS(X, tier, attr)                \
+  X(tier, attr, f32_sincos_fast, float, PS, sincos_ps, sincosf_fast) \
+  X(tier, attr, f64_sincos_fast, double, PD, sincos_pd, sincosd_fast)
+
+#define MVLA__BINARY_KERNEL(tier, attr, name, T, P, OP, expr)                     \
+  static inline attr void mvla__##name##_##tier(const T *a, const T *b, T *out,   \
+                                                size_t n) {                       \
+    size_t i = 0;                                                                 \
+    for (; i + MVLA__##tier##_##P##_WIDTH <= n; i += MVLA__##tier##_##P##_WIDTH) { \
+      MVLA__##tier##_##P##_STORE(out + i,                                         \
+        MVLA__##tier##_##P##_##OP(MVLA__##tier##_##P##_LOAD(a + i),               \
+                                  MVLA__##tier##_##P##_LOAD(b + i)));             \
+    }                                                                             \
+    for (; i < n; ++i) {                                                          \
+      out[i] = (expr);                                                            \
+    }                                                                             \
+  }
+
+#define MVLA__TERNARY_KERNEL(tier, attr, name, T, P, OP, expr)                    \
+  static inline attr void mvla__##name##_##tier(const T *a, const T *b,           \
+                                                const T *c, T *out, size_t n) {   \
+    size_t i = 0;                                                                 \
+    for (; i + MVLA__##tier##_##P##_WIDTH <= n; i += MVLA__##tier##_##P##_WIDTH) { \
+      MVLA__##tier##_##P##_STORE(out + i,                                         \
+        MVLA__##tier##_##P##_##OP(MVLA__##tier##_##P##_LOAD(a + i),               \
+                                  MVLA__##tier##_##P##_LOAD(b + i),               \
+                                  MVLA__##tier##_##P##_LOAD(c + i)));             \
+    }                                                                             \
+    for (; i < n; ++i) {                                                          \
+      out[i] = (expr);                                                            \
+    }                                                                             \
+  }
+
+#define MVLA__UNARY_KERNEL(tier, attr, name, T, P, OP, expr)                      \
+  static inline attr void mvla__##name##_##tier(const T *a, T *out, size_t n) {   \
+    size_t i = 0;                                                                 \
+    for (; i + MVLA__##tier##_##P##_WIDTH <= n; i += MVLA__##tier##_##P##_WIDTH) { \
+      MVLA__##tier##_##P##_STORE(out + i,                                         \
+        MVLA__##tier##_##P##_##OP(MVLA__##tier##_##P##_LOAD(a + i)));             \
+    }                                                                             \
+    for (; i < n; ++i) {                                                          \
+      out[i] = (expr);                                                            \
+    }                                                                             \
+  }
+
+/*
+** Vertical length kernels over separate component arrays (z and w may be
+** NULL), each lane is one whole vector so no shuffles are needed. Products are
+** summed x, y, z, w in order to match v*_sqr_len.
+*/
+
+#define MVLA__SQR_LEN_KERNEL(tier, attr, name, T, P, SQRT)                        \
+  static inline attr void mvla__##name##_##tier(const T *x, const T *y,           \
+                                                const T *z, const T *w,           \
+                                                T *out, size_t n, int root) {     \
+    size_t i = 0;                                                                 \
+    for (; i + MVLA__##tier##_##P##_WIDTH <= n; i += MVLA__##tier##_##P##_WIDTH) { \
+      MVLA__##tier##_##P##_T vx = MVLA__##tier##_##P##_LOAD(x + i);               \
+      MVLA__##tier##_##P##_T vy = MVLA__##tier##_##P##_LOAD(y + i);               \
+      MVLA__##tier##_##P##_T s = MVLA__##tier##_##P##_ADD(                        \
+        MVLA__##tier##_##P##_MUL(vx, vx), MVLA__##tier##_##P##_MUL(vy, vy));      \
+      if (z != NULL) {                                                            \
+        MVLA__##tier##_##P##_T vz = MVLA__##tier##_##P##_LOAD(z + i);             \
+        s = MVLA__##tier##_##P##_ADD(s, MVLA__##tier##_##P##_MUL(vz, vz));        \
+      }                                                                           \
+      if (w != NULL) {                                                            \
+        MVLA__##tier##_##P##_T vw = MVLA__##tier##_##P##_LOAD(w + i);             \
+        s = MVLA__##tier##_##P##_ADD(s, MVLA__##tier##_##P##_MUL(vw, vw));        \
+      }                                                                           \
+      MVLA__##tier##_##P##_STORE(out + i, root ? MVLA__##tier##_##P##_SQRT(s) : s); \
+    }                                                                             \
+    for (; i < n; ++i) {                                                          \
+      T s = x[i] * x[i] + y[i] * y[i];                                            \
+      if (z != NULL) {                                                            \
+        s += z[i] * z[i];                                                         \
+      }                                                                           \
+      if (w != NULL) {                                                            \
+        s += w[i] * w[i];                                                         \
+      }                                                                           \
+      out[i] = root ? SQRT(s) : s;                                                \
+    }                                                                             \
+  }
+
+/*
+** Geometry kernels over separate component arrays, dims of them per operand
+** (a[2] and a[3] unused below 3 and 4 dimensions). Each lane is one whole
+** vector. One step macro per operation serves both the SIMD loop and the
+** scalar tail, which runs the same step on the scalar tier, and zero length
+** lanes select 0 instead of dividing by zero.
+*/
+
+#define MVLA__GOP(tier, P, OP) MVLA__##tier##_##P##_##OP
+
+#define MVLA__GEOM_DOT_STEP(tier, P, i, a, b, s)                                  \
+  s = MVLA__GOP(tier, P, MUL)(MVLA__GOP(tier, P, LOAD)(a[0] + i),                 \
+                              MVLA__GOP(tier, P, LOAD)(b[0] + i));                \
+  for (c = 1; c < dims; ++c) {                                                    \
+    s = MVLA__GOP(tier, P, ADD)(s, MVLA__GOP(tier, P, MUL)(                       \
+          MVLA__GOP(tier, P, LOAD)(a[c] + i), MVLA__GOP(tier, P, LOAD)(b[c] + i))); \
+  }
+
+#define MVLA__GEOM_NORMALIZE_STEP(tier, P, p, i)                                  \
+  {                                                                               \
+    MVLA__GOP(tier, P, T) s, r;                                                   \
+    MVLA__GEOM_DOT_STEP(tier, P, i, a, a, s)                                      \
+    r = fast ? mvla__rsqrt_##p##_##tier(s) : MVLA__GOP(tier, P, SQRT)(s);         \
+    for (c = 0; c < dims; ++c) {                                                  \
+      MVLA__GOP(tier, P, T) v = MVLA__GOP(tier, P, LOAD)(a[c] + i);               \
+      v = fast ? MVLA__GOP(tier, P, MUL)(v, r) : MVLA__GOP(tier, P, DIV)(v, r);   \
+      MVLA__GOP(tier, P, STORE)(out[c] + i, MVLA__GOP(tier, P, SEL_POS)(s, v));   \
+    }                                                                             \
+  }
+
+#define MVLA__GEOM_CROSS_STEP(tier, P, i)                                         \
+  {                                                                               \
+    MVLA__GOP(tier, P, T) ax = MVLA__GOP(tier, P, LOAD)(a[0] + i);                \
+    MVLA__GOP(tier, P, T) ay = MVLA__GOP(tier, P, LOAD)(a[1] + i);                \
+    MVLA__GOP(tier, P, T) bx = MVLA__GOP(tier, P, LOAD)(b[0] + i);                \
+    MVLA__GOP(tier, P, T) by = MVLA__GOP(tier, P, LOAD)(b[1] + i);                \
+    if (dims == 2) {                                                              \
+      MVLA__GOP(tier, P, STORE)(out[0] + i, MVLA__GOP(tier, P, SUB)(              \
+        MVLA__GOP(tier, P, MUL)(ax, by), MVLA__GOP(tier, P, MUL)(ay, bx)));       \
+    } else {                                                                      \
+      MVLA__GOP(tier, P, T) az = MVLA__GOP(tier, P, LOAD)(a[2] + i);              \
+      MVLA__GOP(tier, P, T) bz = MVLA__GOP(tier, P, LOAD)(b[2] + i);              \
+      MVLA__GOP(tier, P, STORE)(out[0] + i, MVLA__GOP(tier, P, SUB)(              \
+        MVLA__GOP(tier, P, MUL)(ay, bz), MVLA__GOP(tier, P, MUL)(az, by)));       \
+      MVLA__GOP(tier, P, STORE)(out[1] + i, MVLA__GOP(tier, P, SUB)(              \
+        MVLA__GOP(tier, P, MUL)(az, bx), MVLA__GOP(tier, P, MUL)(ax, bz)));       \
+      MVLA__GOP(tier, P, STORE)(out[2] + i, MVLA__GOP(tier, P, SUB)(              \
+        MVLA__GOP(tier, P, MUL)(ax, by), MVLA__GOP(tier, P, MUL)(ay, bx)));       \
+    }                                                                             \
+  }
+
+#define MVLA__GEOM_DIST_STEP(tier, P, i)                                          \
+  {                                                                               \
+    MVLA__GOP(tier, P, T) s = MVLA__GOP(tier, P, SET1)(0), d;                     \
+    for (c = 0; c < dims; ++c) {                                                  \
+      d = MVLA__GOP(tier, P, SUB)(MVLA__GOP(tier, P, LOAD)(a[c] + i),             \
+                                  MVLA__GOP(tier, P, LOAD)(b[c] + i));            \
+      s = c == 0 ? MVLA__GOP(tier, P, MUL)(d, d)                                  \
+                 : MVLA__GOP(tier, P, ADD)(s, MVLA__GOP(tier, P, MUL)(d, d));     \
+    }                                                                             \
+    MVLA__GOP(tier, P, STORE)(out + i, root ? MVLA__GOP(tier, P, SQRT)(s) : s);   \
+  }
+
+#define MVLA__GEOM_PROJECT_STEP(tier, P, i)                                       \
+  {                                                                               \
+    MVLA__GOP(tier, P, T) ab, bb, k;                                              \
+    MVLA__GEOM_DOT_STEP(tier, P, i, a, b, ab)                                     \
+    MVLA__GEOM_DOT_STEP(tier, P, i, b, b, bb)                                     \
+    k = MVLA__GOP(tier, P, DIV)(ab, bb);                                          \
+    for (c = 0; c < dims; ++c) {                                                  \
+      MVLA__GOP(tier, P, T) v = MVLA__GOP(tier, P, MUL)(MVLA__GOP(tier, P, LOAD)(b[c] + i), k); \
+      MVLA__GOP(tier, P, STORE)(out[c] + i, MVLA__GOP(tier, P, SEL_POS)(bb, v));  \
+    }                                                                             \
+  }
+
+#define MVLA__GEOM_REFLECT_STEP(tier, P, i)                                       \
+  {                                                                               \
+    MVLA__GOP(tier, P, T) d;                                                      \
+    MVLA__GEOM_DOT_STEP(tier, P, i, a, b, d)                                      \
+    d = MVLA__GOP(tier, P, ADD)(d, d);                                            \
+    for (c = 0; c < dims; ++c) {                                                  \
+      MVLA__GOP(tier, P, STORE)(out[c] + i, MVLA__GOP(tier, P, SUB)(              \
+        MVLA__GOP(tier, P, LOAD)(a[c] + i),                                       \
+        MVLA__GOP(tier, P, MUL)(d, MVLA__GOP(tier, P, LOAD)(b[c] + i))));         \
+    }                                                                             \
+  }
+
+#define MVLA__GEOM_KERNEL(tier, attr, f, T, P, p)                                 \
+  static inline attr void mvla__##f##_dot_k_##tier(const T *const *a, const T *const *b, \
+                                                   int dims, T *out, size_t n) {  \
+    size_t i = 0;                                                                 \
+    int c;                                                                        \
+    for (; i + MVLA__GOP(tier, P, WIDTH) <= n; i += MVLA__GOP(tier, P, WIDTH)) {  \
+      MVLA__##tier##_##P##_T s;                                                   \
+      MVLA__GEOM_DOT_STEP(tier, P, i, a, b, s)                                    \
+      MVLA__GOP(tier, P, STORE)(out + i, s);                                      \
+    }                                                                             \
+    for (; i < n; ++i) {                                                          \
+      T s;                                                                        \
+      MVLA__GEOM_DOT_STEP(SCALAR, P, i, a, b, s)                                  \
+      out[i] = s;                                                                 \
+    }                                                                             \
+  }                                                                               \
+  static inline attr void mvla__##f##_normalize_k_##tier(const T *const *a, int dims, \
+                                                         T *const *out, size_t n, int fast) { \
+    size_t i = 0;                                                                 \
+    int c;                                                                        \
+    for (; i + MVLA__GOP(tier, P, WIDTH) <= n; i += MVLA__GOP(tier, P, WIDTH)) {  \
+      MVLA__GEOM_NORMALIZE_STEP(tier, P, p, i)                                    \
+    }                                                                             \
+    for (; i < n; ++i) {                                                          \
+      MVLA__GEOM_NORMALIZE_STEP(SCALAR, P, p, i)                                  \
+    }                                                                             \
+  }                                                                               \
+  static inline attr void mvla__##f##_cross_k_##tier(const T *const *a, const T *const *b, \
+                                                     int dims, T *const *out, size_t n) { \
+    size_t i = 0;                                                                 \
+    for (; i + MVLA__GOP(tier, P, WIDTH) <= n; i += MVLA__GOP(tier, P, WIDTH)) {  \
+      MVLA__GEOM_CROSS_STEP(tier, P, i)                                           \
+    }                                                                             \
+    for (; i < n; ++i) {                                                          \
+      MVLA__GEOM_CROSS_STEP(SCALAR, P, i)                                         \
+    }                                                                             \
+  }                                                                               \
+  static inline attr void mvla__##f##_dist_k_##tier(const T *const *a, const T *const *b, \
+                                                    int dims, T *out, size_t n, int root) { \
+    size_t i = 0;                                                                 \
+    int c;                                                                        \
+    for (; i + MVLA__GOP(tier, P, WIDTH) <= n; i += MVLA__GOP(tier, P, WIDTH)) {  \
+      MVLA__GEOM_DIST_STEP(tier, P, i)                                            \
+    }                                                                             \
+    for (; i < n; ++i) {                                                          \
+      MVLA__GEOM_DIST_STEP(SCALAR, P, i)                                          \
+    }                                                                             \
+  }                                                                               \
+  static inline attr void mvla__##f##_project_k_##tier(const T *const *a, const T *const *b, \
+                                                       int dims, T *const *out, size_t n) { \
+    size_t i = 0;                                                                 \
+    int c;                                                                        \
+    for (; i + MVLA__GOP(tier, P, WIDTH) <= n; i += MVLA__GOP(tier, P, WIDTH)) {  \
+      MVLA__GEOM_PROJECT_STEP(tier, P, i)                                         \
+    }                                                                             \
+    for (; i < n; ++i) {                                                          \
+      MVLA__GEOM_PROJECT_STEP(SCALAR, P, i)                                       \
+    }                                                                             \
+  }                                                                               \
+  static inline attr void mvla__##f##_reflect_k_##tier(const T *const *a, const T *const *b, \
+                                                       int dims, T *const *out, size_t n) { \
+    size_t i = 0;                                                                 \
+    int c;                                                                        \
+    for (; i + MVLA__GOP(tier, P, WIDTH) <= n; i += MVLA__GOP(tier, P, WIDTH)) {  \
+      MVLA__GEOM_REFLECT_STEP(tier, P, i)                                         \
+    }                                                                             \
+    for (; i < n; ++i) {                                                          \
+      MVLA__GEOM_REFLECT_STEP(SCALAR, P, i)                                       \
+    }                                                                             \
+  }
+
+#define MVLA__GEOM_KERNELS(X, tier, attr)                                         \
+  X(tier, attr, f32, float, PS, ps)                                               \
+  X(tier, attr, f64, double, PD, pd)
+
+/*
+** Level 1 BLAS kernels over flat arrays. The reductions keep four
+** accumulators to hide the add latency and fold their lanes at the end. The
+** sum of squares runs in double lanes (Q, which is PDF for float input), so
+** float data can't overflow or lose small terms.
+*/
+
+#define MVLA__BLAS1_KERNEL(tier, attr, f, T, P, Q, ABS)                           \
+  static inline attr void mvla__##f##_axpy_k_##tier(T alpha, const T *x, T *y,    \
+                                                    size_t n) {                   \
+    MVLA__##tier##_##P##_T va = MVLA__GOP(tier, P, SET1)(alpha);                  \
+    size_t i = 0;                                                                 \
+    for (; i + MVLA__GOP(tier, P, WIDTH) <= n; i += MVLA__GOP(tier, P, WIDTH)) {  \
+      MVLA__GOP(tier, P, STORE)(y + i, MVLA__GOP(tier, P, FMA)(                   \
+        va, MVLA__GOP(tier, P, LOAD)(x + i), MVLA__GOP(tier, P, LOAD)(y + i)));   \
+    }                                                                             \
+    for (; i < n; ++i) {                                                          \
+      y[i] = alpha * x[i] + y[i];                                                 \
+    }                                                                             \
+  }                                                                               \
+  static inline attr void mvla__##f##_scal_k_##tier(T alpha, const T *x, T *out,  \
+                                                    size_t n) {                   \
+    MVLA__##tier##_##P##_T va = MVLA__GOP(tier, P, SET1)(alpha);                  \
+    size_t i = 0;                                                                 \
+    for (; i + MVLA__GOP(tier, P, WIDTH) <= n; i += MVLA__GOP(tier, P, WIDTH)) {  \
+      MVLA__GOP(tier, P, STORE)(out + i,                                          \
+        MVLA__GOP(tier, P, MUL)(va, MVLA__GOP(tier, P, LOAD)(x + i)));            \
+    }                                                                             \
+    for (; i < n; ++i) {                                                          \
+      out[i] = alpha * x[i];                                                      \
+    }                                                                             \
+  }                                                                               \
+  static inline attr T mvla__##f##_vdot_k_##tier(const T *x, const T *y,          \
+                                                 size_t n) {                      \
+    enum { W = MVLA__GOP(tier, P, WIDTH) };                                       \
+    MVLA__##tier##_##P##_T s0 = MVLA__GOP(tier, P, SET1)((T) 0);                  \
+    MVLA__##tier##_##P##_T s1 = s0, s2 = s0, s3 = s0;                             \
+    T lanes[W], sum = 0;                                                          \
+    size_t i = 0;                                                                 \
+    int k;                                                                        \
+    for (; i + 4 * W <= n; i += 4 * W) {                                          \
+      s0 = MVLA__GOP(tier, P, FMA)(MVLA__GOP(tier, P, LOAD)(x + i),               \
+                                   MVLA__GOP(tier, P, LOAD)(y + i), s0);          \
+      s1 = MVLA__GOP(tier, P, FMA)(MVLA__GOP(tier, P, LOAD)(x + i + W),           \
+                                   MVLA__GOP(tier, P, LOAD)(y + i + W), s1);      \
+      s2 = MVLA__GOP(tier, P, FMA)(MVLA__GOP(tier, P, LOAD)(x + i + 2 * W),       \
+                                   MVLA__GOP(tier, P, LOAD)(y + i + 2 * W), s2);  \
+      s3 = MVLA__GOP(tier, P, FMA)(MVLA__GOP(tier, P, LOAD)(x + i + 3 * W),       \
+                                   MVLA__GOP(tier, P, LOAD)(y + i + 3 * W), s3);  \
+    }                                                                             \
+    for (; i + W <= n; i += W) {                                                  \
+      s0 = MVLA__GOP(tier, P, FMA)(MVLA__GOP(tier, P, LOAD)(x + i),               \
+                                   MVLA__GOP(tier, P, LOAD)(y + i), s0);          \
+    }                                                                             \
+    MVLA__GOP(tier, P, STORE)(lanes, MVLA__GOP(tier, P, ADD)(                     \
+      MVLA__GOP(tier, P, ADD)(s0, s1), MVLA__GOP(tier, P, ADD)(s2, s3)));         \
+    for (k = 0; k < W; ++k) {                                                     \
+      sum += lanes[k];                                                            \
+    }                                                                             \
+    for (; i < n; ++i) {                                                          \
+      sum += x[i] * y[i];                                                         \
+    }                                                                             \
+    return sum;                                                                   \
+  }                                                                               \
+  static inline attr T mvla__##f##_asum_k_##tier(const T *x, size_t n) {          \
+    enum { W = MVLA__GOP(tier, P, WIDTH) };                                       \
+    MVLA__##tier##_##P##_T s0 = MVLA__GOP(tier, P, SET1)((T) 0);                  \
+    MVLA__##tier##_##P##_T s1 = s0, s2 = s0, s3 = s0;                             \
+    MVLA__##tier##_##P##_T sign = MVLA__GOP(tier, P, SET1)((T) -0.0);             \
+    T lanes[W], sum = 0;                                                          \
+    size_t i = 0;                                                                 \
+    int k;                                                                        \
+    for (; i + 4 * W <= n; i += 4 * W) {                                          \
+      s0 = MVLA__GOP(tier, P, ADD)(s0, MVLA__GOP(tier, P, ANDNOT)(                \
+             sign, MVLA__GOP(tier, P, LOAD)(x + i)));                             \
+      s1 = MVLA__GOP(tier, P, ADD)(s1, MVLA__GOP(tier, P, ANDNOT)(                \
+             sign, MVLA__GOP(tier, P, LOAD)(x + i + W)));                         \
+      s2 = MVLA__GOP(tier, P, ADD)(s2, MVLA__GOP(tier, P, ANDNOT)(                \
+             sign, MVLA__GOP(tier, P, LOAD)(x + i + 2 * W)));                     \
+      s3 = MVLA__GOP(tier, P, ADD)(s3, MVLA__GOP(tier, P, ANDNOT)(                \
+             sign, MVLA__GOP(tier, P, LOAD)(x + i + 3 * W)));                     \
+    }                                                                             \
+    for (; i + W <= n; i += W) {                                                  \
+      s0 = MVLA__GOP(tier, P, ADD)(s0, MVLA__GOP(tier, P, ANDNOT)(                \
+             sign, MVLA__GOP(tier, P, LOAD)(x + i)));                             \
+    }                                                                             \
+    MVLA__GOP(tier, P, STORE)(lanes, MVLA__GOP(tier, P, ADD)(                     \
+      MVLA__GOP(tier, P, ADD)(s0, s1), MVLA__GOP(tier, P, ADD)(s2, s3)));         \
+    for (k = 0; k < W; ++k) {                                                     \
+      sum += lanes[k];                                                            \
+    }                                                                             \
+    for (; i < n; ++i) {                                                          \
+      sum += ABS(x[i]);                                                           \
+    }                                                                             \
+    return sum;                                                                   \
+  }                                                                               \
+  static inline attr double mvla__##f##_sumsq_k_##tier(const T *x, size_t n) {    \
+    enum { W = MVLA__GOP(tier, Q, WIDTH) };                                       \
+    MVLA__##tier##_PD_T s0 = MVLA__GOP(tier, PD, SET1)(0.0);                      \
+    MVLA__##tier##_PD_T s1 = s0, s2 = s0, s3 = s0, v;                             \
+    double lanes[W], sum = 0.0;                                                   \
+    size_t i = 0;                                                                 \
+    int k;                                                                        \
+    for (; i + 4 * W <= n; i += 4 * W) {                                          \
+      v = MVLA__GOP(tier, Q, LOAD)(x + i);                                        \
+      s0 = MVLA__GOP(tier, PD, FMA)(v, v, s0);                                    \
+      v = MVLA__GOP(tier, Q, LOAD)(x + i + W);                                    \
+      s1 = MVLA__GOP(tier, PD, FMA)(v, v, s1);                                    \
+      v = MVLA__GOP(tier, Q, LOAD)(x + i + 2 * W);                                \
+      s2 = MVLA__GOP(tier, PD, FMA)(v, v, s2);                                    \
+      v = MVLA__GOP(tier, Q, LOAD)(x + i + 3 * W);                                \
+      s3 = MVLA__GOP(tier, PD, FMA)(v, v, s3);                                    \
+    }                                                                             \
+    for (; i + W <= n; i += W) {                                                  \
+      v = MVLA__GOP(tier, Q, LOAD)(x + i);                                        \
+      s0 = MVLA__GOP(tier, PD, FMA)(v, v, s0);                                    \
+    }                                                                             \
+    MVLA__GOP(tier, PD, STORE)(lanes, MVLA__GOP(tier, PD, ADD)(                   \
+      MVLA__GOP(tier, PD, ADD)(s0, s1), MVLA__GOP(tier, PD, ADD)(s2, s3)));       \
+    for (k = 0; k < W; ++k) {                                                     \
+      sum += lanes[k];                                                            \
+    }                                                                             \
+    for (; i < n; ++i) {                                                          \
+      sum += (double) x[i] * x[i];                                                \
+    }                                                                             \
+    return sum;                                                                   \
+  }
+
+#define MVLA__BLAS1_KERNELS(X, tier, attr)                                        \
+  X(tier, attr, f32, float, PS, PDF, fabsf)                                       \
+  X(tier, attr, f64, double, PD, PD, fabs)
+
+/*
+** Matrix transform kernels over separate component arrays, m is a column-major
+** 4x4. Inputs with 3 dimensions take w as 1. One step macro serves the SIMD
+** loop and the scalar tail, the stores stream when the flag is set and every
+** output array is aligned to the register width.
+*/
+
+#define MVLA__XFORM_STEP(tier, P, i, c, one)                                      \
+  {                                                                               \
+    MVLA__GOP(tier, P, T) x = MVLA__GOP(tier, P, LOAD)(a[0] + i);                 \
+    MVLA__GOP(tier, P, T) y = MVLA__GOP(tier, P, LOAD)(a[1] + i);                 \
+    MVLA__GOP(tier, P, T) z = MVLA__GOP(tier, P, LOAD)(a[2] + i);                 \
+    MVLA__GOP(tier, P, T) w = in_dims == 4 ? MVLA__GOP(tier, P, LOAD)(a[3] + i) : one; \
+    MVLA__GOP(tier, P, T) r[4];                                                   \
+    for (k = 0; k < 4; ++k) {                                                     \
+      r[k] = MVLA__GOP(tier, P, FMA)(c[12 + k], w, MVLA__GOP(tier, P, FMA)(       \
+               c[8 + k], z, MVLA__GOP(tier, P, FMA)(                              \
+                 c[4 + k], y, MVLA__GOP(tier, P, MUL)(c[k], x))));                \
+      if (k == 2 && affine) {                                                     \
+        r[3] = w;                                                                 \
+        break;                                                                    \
+      }                                                                           \
+    }                                                                             \
+    if (divide) {                                                                 \
+      MVLA__GOP(tier, P, T) q = MVLA__GOP(tier, P, DIV)(one, r[3]);               \
+      r[0] = MVLA__GOP(tier, P, MUL)(r[0], q);                                    \
+      r[1] = MVLA__GOP(tier, P, MUL)(r[1], q);                                    \
+      r[2] = MVLA__GOP(tier, P, MUL)(r[2], q);                                    \
+      r[3] = one;                                                                 \
+    }                                                                             \
+    for (k = 0; k < out_dims; ++k) {                                              \
+      if (stream) {                                                               \
+        MVLA__GOP(tier, P, STREAM)(out[k] + i, r[k]);                             \
+      } else {                                                                    \
+        MVLA__GOP(tier, P, STORE)(out[k] + i, r[k]);                              \
+      }                                                                           \
+    }                                                                             \
+  }
+
+#define MVLA__XFORM_KERNEL(tier, attr, f, T, P)                                   \
+  static inline attr void mvla__##f##_xform_k_##tier(const T *m, const T *const *a, \
+                                                     int in_dims, T *const *out,  \
+                                                     int out_dims, size_t n,      \
+                                                     int flags) {                 \
+    MVLA__##tier##_##P##_T c[16], one = MVLA__GOP(tier, P, SET1)((T) 1);          \
+    int affine = (flags & MVLA_XFORM_AFFINE) != 0;                                \
+    int divide = (flags & MVLA_XFORM_DIVIDE) && !(affine && in_dims == 3);        \
+    int stream = (flags & MVLA_XFORM_STREAM) != 0;                                \
+    size_t i = 0;                                                                 \
+    int k;                                                                        \
+    for (k = 0; k < 16; ++k) {                                                    \
+      c[k] = MVLA__GOP(tier, P, SET1)(m[k]);                                      \
+    }                                                                             \
+    for (k = 0; k < out_dims; ++k) {                                              \
+      if ((uintptr_t) out[k] % (MVLA__GOP(tier, P, WIDTH) * sizeof(T)) != 0) {    \
+        stream = 0;                                                               \
+      }                                                                           \
+    }                                                                             \
+    for (; i + MVLA__GOP(tier, P, WIDTH) <= n; i += MVLA__GOP(tier, P, WIDTH)) {  \
+      MVLA__XFORM_STEP(tier, P, i, c, one)                                        \
+    }                                                                             \
+    stream = 0;                                                                   \
+    for (; i < n; ++i) {                                                          \
+      MVLA__XFORM_STEP(SCALAR, P, i, m, (T) 1)                                    \
+    }                                                                             \
+  }                                                                               \
+  static inline attr void mvla__##f##_stream_k_##tier(const T *src, T *dst, size_t n) { \
+    size_t i = 0;                                                                 \
+    for (; i < n && (uintptr_t) (dst + i) % (MVLA__GOP(tier, P, WIDTH) * sizeof(T)) != 0; ++i) { \
+      dst[i] = src[i];                                                            \
+    }                                                                             \
+    for (; i + MVLA__GOP(tier, P, WIDTH) <= n; i += MVLA__GOP(tier, P, WIDTH)) {  \
+      MVLA__GOP(tier, P, STREAM)(dst + i, MVLA__GOP(tier, P, LOAD)(src + i));     \
+    }                                                                             \
+    for (; i < n; ++i) {                                                          \
+      dst[i] = src[i];                                                            \
+    }                                                                             \
+  }
+
+#define MVLA__XFORM_KERNELS(X, tier, attr)                                        \
+  X(tier, attr, f32, float, PS)                                                   \
+  X(tier, attr, f64, double, PD)
+
+// a * b - c * d and a * b - c * d + e * f, the minors and cofactors of the inverses.
+// Left unfused on every tier: a fused a * b - c * d keeps the rounding error of
+// c * d, so equal columns would no longer cancel to the exact zero that flags a
+// singular matrix, and the result would differ from mat4x4f_inverse
+#define MVLA__DET2(tier, P, a, b, c, d)                                           \
+  MVLA__GOP(tier, P, SUB)(MVLA__GOP(tier, P, MUL)(a, b), MVLA__GOP(tier, P, MUL)(c, d))
+#define MVLA__DET3(tier, P, a, b, c, d, e, f)                                     \
+  MVLA__GOP(tier, P, ADD)(MVLA__DET2(tier, P, a, b, c, d), MVLA__GOP(tier, P, MUL)(e, f))
+
+// inverts and takes determinants of matrices held one element per array, one
+// matrix per lane, with the same minors as mat4x4f_inverse; the cofactor signs
+// alternate like a checkerboard. Lanes with a zero determinant are flagged and
+// zeroed afterwards since they are rare
+#define MVLA__INVERSE4_STEP(tier, P, S, i)                                        \
+  {                                                                               \
+    MVLA__GOP(tier, P, T) v[16], r[16], s[6], c[6], d, q, nq;                     \
+    S dv[MVLA__GOP(tier, P, WIDTH)];                                              \
+    for (k = 0; k < 16; ++k) {                                                    \
+      v[k] = MVLA__GOP(tier, P, LOAD)(a[k] + i);                                  \
+    }                                                                             \
+    s[0] = MVLA__DET2(tier, P, v[0], v[5], v[4], v[1]);                           \
+    s[1] = MVLA__DET2(tier, P, v[0], v[6], v[4], v[2]);                           \
+    s[2] = MVLA__DET2(tier, P, v[0], v[7], v[4], v[3]);                           \
+    s[3] = MVLA__DET2(tier, P, v[1], v[6], v[5], v[2]);                           \
+    s[4] = MVLA__DET2(tier, P, v[1], v[7], v[5], v[3]);                           \
+    s[5] = MVLA__DET2(tier, P, v[2], v[7], v[6], v[3]);                           \
+    c[5] = MVLA__DET2(tier, P, v[10], v[15], v[14], v[11]);                       \
+    c[4] = MVLA__DET2(tier, P, v[9], v[15], v[13], v[11]);                        \
+    c[3] = MVLA__DET2(tier, P, v[9], v[14], v[13], v[10]);                        \
+    c[2] = MVLA__DET2(tier, P, v[8], v[15], v[12], v[11]);                        \
+    c[1] = MVLA__DET2(tier, P, v[8], v[14], v[12], v[10]);                        \
+    c[0] = MVLA__DET2(tier, P, v[8], v[13], v[12], v[9]);                         \
+    d = MVLA__DET3(tier, P, s[0], c[5], s[1], c[4], s[2], c[3]);                  \
+    d = MVLA__GOP(tier, P, ADD)(d, MVLA__GOP(tier, P, MUL)(s[3], c[2]));          \
+    d = MVLA__GOP(tier, P, SUB)(d, MVLA__GOP(tier, P, MUL)(s[4], c[1]));          \
+    d = MVLA__GOP(tier, P, ADD)(d, MVLA__GOP(tier, P, MUL)(s[5], c[0]));          \
+    if (out != NULL) {                                                            \
+      q = MVLA__GOP(tier, P, DIV)(MVLA__GOP(tier, P, SET1)((S) 1), d);            \
+      nq = MVLA__GOP(tier, P, SUB)(MVLA__GOP(tier, P, SET1)((S) 0), q);           \
+      r[0] = MVLA__DET3(tier, P, v[5], c[5], v[6], c[4], v[7], c[3]);             \
+      r[1] = MVLA__DET3(tier, P, v[1], c[5], v[2], c[4], v[3], c[3]);             \
+      r[2] = MVLA__DET3(tier, P, v[13], s[5], v[14], s[4], v[15], s[3]);          \
+      r[3] = MVLA__DET3(tier, P, v[9], s[5], v[10], s[4], v[11], s[3]);           \
+      r[4] = MVLA__DET3(tier, P, v[4], c[5], v[6], c[2], v[7], c[1]);             \
+      r[5] = MVLA__DET3(tier, P, v[0], c[5], v[2], c[2], v[3], c[1]);             \
+      r[6] = MVLA__DET3(tier, P, v[12], s[5], v[14], s[2], v[15], s[1]);          \
+      r[7] = MVLA__DET3(tier, P, v[8], s[5], v[10], s[2], v[11], s[1]);           \
+      r[8] = MVLA__DET3(tier, P, v[4], c[4], v[5], c[2], v[7], c[0]);             \
+      r[9] = MVLA__DET3(tier, P, v[0], c[4], v[1], c[2], v[3], c[0]);             \
+      r[10] = MVLA__DET3(tier, P, v[12], s[4], v[13], s[2], v[15], s[0]);         \
+      r[11] = MVLA__DET3(tier, P, v[8], s[4], v[9], s[2], v[11], s[0]);           \
+      r[12] = MVLA__DET3(tier, P, v[4], c[3], v[5], c[1], v[6], c[0]);            \
+      r[13] = MVLA__DET3(tier, P, v[0], c[3], v[1], c[1], v[2], c[0]);            \
+      r[14] = MVLA__DET3(tier, P, v[12], s[3], v[13], s[1], v[14], s[0]);         \
+      r[15] = MVLA__DET3(tier, P, v[8], s[3], v[9], s[1], v[10], s[0]);           \
+      for (k = 0; k < 16; ++k) {                                                  \
+        MVLA__GOP(tier, P, T) e = MVLA__GOP(tier, P, MUL)(r[k], (k / 4 + k) % 2 ? nq : q);\
+        MVLA__GOP(tier, P, STORE)(out[k] + i, e);                                 \
+      }                                                                           \
+    }                                                                             \
+    MVLA__GOP(tier, P, STORE)(dv, d);                                             \
+    for (l = 0; l < MVLA__GOP(tier, P, WIDTH); ++l) {                             \
+      if (det != NULL) {                                                          \
+        det[i + l] = dv[l];                                                       \
+      }                                                                           \
+      if (singular != NULL) {                                                     \
+        singular[i + l] = dv[l] == 0;                                             \
+      }                                                                           \
+      if (dv[l] == 0) {                                                           \
+        ++count;                                                                  \
+        for (k = 0; out != NULL && k < 16; ++k) {                                 \
+          out[k][i + l] = 0;                                                      \
+        }                                                                         \
+      }                                                                           \
+    }                                                                             \
+  }
+
+#define MVLA__INVERSE3_STEP(tier, P, S, i)                                        \
+  {                                                                               \
+    MVLA__GOP(tier, P, T) v[9], r[9], d, q;                                       \
+    S dv[MVLA__GOP(tier, P, WIDTH)];                                              \
+    for (k = 0; k < 9; ++k) {                                                     \
+      v[k] = MVLA__GOP(tier, P, LOAD)(a[k] + i);                                  \
+    }                                                                             \
+    r[0] = MVLA__DET2(tier, P, v[4], v[8], v[5], v[7]);                           \
+    r[1] = MVLA__DET2(tier, P, v[5], v[6], v[3], v[8]);                           \
+    r[2] = MVLA__DET2(tier, P, v[3], v[7], v[4], v[6]);                           \
+    r[3] = MVLA__DET2(tier, P, v[7], v[2], v[8], v[1]);                           \
+    r[4] = MVLA__DET2(tier, P, v[8], v[0], v[6], v[2]);                           \
+    r[5] = MVLA__DET2(tier, P, v[6], v[1], v[7], v[0]);                           \
+    r[6] = MVLA__DET2(tier, P, v[1], v[5], v[2], v[4]);                           \
+    r[7] = MVLA__DET2(tier, P, v[2], v[3], v[0], v[5]);                           \
+    r[8] = MVLA__DET2(tier, P, v[0], v[4], v[1], v[3]);                           \
+    d = MVLA__GOP(tier, P, ADD)(MVLA__GOP(tier, P, MUL)(v[0], r[0]),              \
+                                MVLA__GOP(tier, P, MUL)(v[1], r[1]));             \
+    d = MVLA__GOP(tier, P, ADD)(d, MVLA__GOP(tier, P, MUL)(v[2], r[2]));          \
+    if (out != NULL) {                                                            \
+      q = MVLA__GOP(tier, P, DIV)(MVLA__GOP(tier, P, SET1)((S) 1), d);            \
+      for (k = 0; k < 9; ++k) {                                                   \
+        MVLA__GOP(tier, P, STORE)(out[k % 3 * 3 + k / 3] + i,                     \
+                                  MVLA__GOP(tier, P, MUL)(r[k], q));              \
+      }                                                                           \
+    }                                                                             \
+    MVLA__GOP(tier, P, STORE)(dv, d);                                             \
+    for (l = 0; l < MVLA__GOP(tier, P, WIDTH); ++l) {                             \
+      if (det != NULL) {                                                          \
+        det[i + l] = dv[l];                                                       \
+      }                                                                           \
+      if (singular != NULL) {                                                     \
+        singular[i + l] = dv[l] == 0;                                             \
+      }                                                                           \
+      if (dv[l] == 0) {                                                           \
+        ++count;                                                                  \
+        for (k = 0; out != NULL && k < 9; ++k) {                                  \
+          out[k][i + l] = 0;                                                      \
+        }                                                                         \
+      }                                                                           \
+    }                                                                             \
+  }
+
+// the transposed rotation and the negated, rotated back translation
+#define MVLA__RIGID_STEP(tier, P, S, i)                                           \
+  {                                                                               \
+    MVLA__GOP(tier, P, T) v[16], zero = MVLA__GOP(tier, P, SET1)((S) 0);          \
+    for (k = 0; k < 15; ++k) {                                                    \
+      v[k] = k % 4 == 3 ? zero : MVLA__GOP(tier, P, LOAD)(a[k] + i);              \
+    }                                                                             \
+    for (k = 0; k < 3; ++k) {                                                     \
+      MVLA__GOP(tier, P, T) t = MVLA__GOP(tier, P, MUL)(v[k * 4], v[12]);         \
+      t = MVLA__GOP(tier, P, FMA)(v[k * 4 + 1], v[13], t);                        \
+      t = MVLA__GOP(tier, P, FMA)(v[k * 4 + 2], v[14], t);                        \
+      MVLA__GOP(tier, P, STORE)(out[k] + i, v[k * 4]);                            \
+      MVLA__GOP(tier, P, STORE)(out[k + 4] + i, v[k * 4 + 1]);                    \
+      MVLA__GOP(tier, P, STORE)(out[k + 8] + i, v[k * 4 + 2]);                    \
+      MVLA__GOP(tier, P, STORE)(out[k + 12] + i, MVLA__GOP(tier, P, SUB)(zero, t)); \
+      MVLA__GOP(tier, P, STORE)(out[k * 4 + 3] + i, zero);                        \
+    }                                                                             \
+    MVLA__GOP(tier, P, STORE)(out[15] + i, MVLA__GOP(tier, P, SET1)((S) 1));      \
+  }
+
+#define MVLA__INVERSE_KERNEL(tier, attr, f, T, P)                                 \
+  static inline attr MVLA__NO_CONTRACT size_t mvla__##f##_inverse_k_##tier(const T *const *a, \
+                                                        int dims, T *const *out, T *det, \
+                                                        unsigned char *singular, size_t n) { \
+    size_t i = 0, count = 0, l;                                                   \
+    int k;                                                                        \
+    if (dims == 3) {                                                              \
+      for (; i + MVLA__GOP(tier, P, WIDTH) <= n; i += MVLA__GOP(tier, P, WIDTH)) { \
+        MVLA__INVERSE3_STEP(tier, P, T, i)                                        \
+      }                                                                           \
+      for (; i < n; ++i) {                                                        \
+        MVLA__INVERSE3_STEP(SCALAR, P, T, i)                                      \
+      }                                                                           \
+    } else {                                                                      \
+      for (; i + MVLA__GOP(tier, P, WIDTH) <= n; i += MVLA__GOP(tier, P, WIDTH)) { \
+        MVLA__INVERSE4_STEP(tier, P, T, i)                                        \
+      }                                                                           \
+      for (; i < n; ++i) {                                                        \
+        MVLA__INVERSE4_STEP(SCALAR, P, T, i)                                      \
+      }                                                                           \
+    }                                                                             \
+    return count;                                                                 \
+  }                                                                               \
+  static inline attr void mvla__##f##_rigid_k_##tier(const T *const *a, T *const *out, size_t n) { \
+    size_t i = 0;                                                                 \
+    int k;                                                                        \
+    for (; i + MVLA__GOP(tier, P, WIDTH) <= n; i += MVLA__GOP(tier, P, WIDTH)) {  \
+      MVLA__RIGID_STEP(tier, P, T, i)                                             \
+    }                                                                             \
+    for (; i < n; ++i) {                                                          \
+      MVLA__RIGID_STEP(SCALAR, P, T, i)                                           \
+    }                                                                             \
+  }
+
+#define MVLA__INVERSE_KERNELS(X, tier, attr)                                    \
+  X(tier, attr, f32, float, PS)                                                   \
+  X(tier, attr, f64, double, PD)
+
+// GEMM register tiles are 2 vectors of A by MVLA__GEMM_NR_<tier> columns of B,
+// 12 (24 with AVX-512) accumulators that stay in registers for the whole KC
+// loop. Partial tiles at the edges of C go through a buffer. The GEMV kernel
+// accumulates four columns of A per pass over y
+#define MVLA__GEMM_NR_SCALAR 6
+#define MVLA__GEMM_NR_SSE2   6
+#define MVLA__GEMM_NR_AVX2   6
+#define MVLA__GEMM_NR_AVX512 12
+
+#define MVLA__GEMM_COLS_6(X, tier, P)                                             \
+  X(tier, P, 0)                                                                   \
+  X(tier, P, 1)                                                                   \
+  X(tier, P, 2)                                                                   \
+  X(tier, P, 3)                                                                   \
+  X(tier, P, 4)                                                                   \
+  X(tier, P, 5)
+#define MVLA__GEMM_COLS_12(X, tier, P)                                            \
+  MVLA__GEMM_COLS_6(X, tier, P)                                                   \
+  X(tier, P, 6)                                                                   \
+  X(tier, P, 7)                                                                   \
+  X(tier, P, 8)                                                                   \
+  X(tier, P, 9)                                                                   \
+  X(tier, P, 10)                                                                  \
+  X(tier, P, 11)
+#define MVLA__GEMM_COLS_N(n, X, tier, P) MVLA__GEMM_COLS_##n(X, tier, P)
+#define MVLA__GEMM_COLS(n, X, tier, P) MVLA__GEMM_COLS_N(n, X, tier, P)
+#define MVLA__GEMM_DECL(tier, P, j)                                               \
+  MVLA__GOP(tier, P, T) c0_##j = zero, c1_##j = zero;
+#define MVLA__GEMM_STEP(tier, P, j)                                               \
+  b = MVLA__GOP(tier, P, SET1)(pb[j]);                                            \
+  c0_##j = MVLA__GOP(tier, P, FMA)(a0, b, c0_##j);                                \
+  c1_##j = MVLA__GOP(tier, P, FMA)(a1, b, c1_##j);
+#define MVLA__GEMM_STORE0(tier, P, j)                                             \
+  MVLA__GOP(tier, P, STORE)(c + j * ldc, MVLA__GOP(tier, P, MUL)(va, c0_##j));    \
+  MVLA__GOP(tier, P, STORE)(c + j * ldc + MVLA__GOP(tier, P, WIDTH), MVLA__GOP(tier, P, MUL)(va, c1_##j));
+#define MVLA__GEMM_STORE(tier, P, j)                                              \
+  MVLA__GOP(tier, P, STORE)(c + j * ldc, MVLA__GOP(tier, P, FMA)(                 \
+    vb, MVLA__GOP(tier, P, LOAD)(c + j * ldc), MVLA__GOP(tier, P, MUL)(va, c0_##j))); \
+  MVLA__GOP(tier, P, STORE)(c + j * ldc + MVLA__GOP(tier, P, WIDTH), MVLA__GOP(tier, P, FMA)( \
+    vb, MVLA__GOP(tier, P, LOAD)(c + j * ldc + MVLA__GOP(tier, P, WIDTH)), MVLA__GOP(tier, P, MUL)(va, c1_##j)));
+#define MVLA__GEMM_SPILL(tier, P, j)                                              \
+  MVLA__GOP(tier, P, STORE)(t + j * 2 * MVLA__GOP(tier, P, WIDTH), c0_##j);       \
+  MVLA__GOP(tier, P, STORE)(t + j * 2 * MVLA__GOP(tier, P, WIDTH) + MVLA__GOP(tier, P, WIDTH), c1_##j);
+
+#define MVLA__GEMM_KERNEL(tier, attr, f, T, P)                                    \
+  static inline attr void mvla__##f##_gemm_micro_##tier(size_t kc, const T *pa, const T *pb, \
+                                                       T alpha, T beta, T *c, size_t ldc, \
+                                                       size_t mr, size_t nr) {    \
+    MVLA__##tier##_##P##_T zero = MVLA__GOP(tier, P, SET1)((T) 0), a0, a1, b;     \
+    MVLA__##tier##_##P##_T va = MVLA__GOP(tier, P, SET1)(alpha);                  \
+    MVLA__##tier##_##P##_T vb = MVLA__GOP(tier, P, SET1)(beta);                   \
+    MVLA__GEMM_COLS(MVLA__GEMM_NR_##tier, MVLA__GEMM_DECL, tier, P)               \
+    size_t p, i, j;                                                               \
+    for (p = 0; p < kc; ++p) {                                                    \
+      a0 = MVLA__GOP(tier, P, LOAD)(pa);                                          \
+      a1 = MVLA__GOP(tier, P, LOAD)(pa + MVLA__GOP(tier, P, WIDTH));              \
+      MVLA__GEMM_COLS(MVLA__GEMM_NR_##tier, MVLA__GEMM_STEP, tier, P)             \
+      pa += 2 * MVLA__GOP(tier, P, WIDTH);                                        \
+      pb += MVLA__GEMM_NR_##tier;                                                 \
+    }                                                                             \
+    if (mr == 2 * MVLA__GOP(tier, P, WIDTH) && nr == MVLA__GEMM_NR_##tier && beta == 0) { \
+      MVLA__GEMM_COLS(MVLA__GEMM_NR_##tier, MVLA__GEMM_STORE0, tier, P)           \
+    } else if (mr == 2 * MVLA__GOP(tier, P, WIDTH) && nr == MVLA__GEMM_NR_##tier) { \
+      MVLA__GEMM_COLS(MVLA__GEMM_NR_##tier, MVLA__GEMM_STORE, tier, P)            \
+    } else {                                                                      \
+      T t[MVLA__GEMM_NR_##tier * 2 * MVLA__GOP(tier, P, WIDTH)];                  \
+      MVLA__GEMM_COLS(MVLA__GEMM_NR_##tier, MVLA__GEMM_SPILL, tier, P)            \
+      for (j = 0; j < nr; ++j) {                                                  \
+        for (i = 0; i < mr; ++i) {                                                \
+          T r = alpha * t[j * 2 * MVLA__GOP(tier, P, WIDTH) + i];                 \
+          c[j * ldc + i] = beta == 0 ? r : r + beta * c[j * ldc + i];             \
+        }                                                                         \
+      }                                                                           \
+    }                                                                             \
+  }                                                                               \
+  static inline attr void mvla__##f##_gemv_k_##tier(size_t m, size_t n, T alpha,  \
+                                                    const T *a, size_t lda,       \
+                                                    const T *x, T *y) {           \
+    size_t i, j = 0;                                                              \
+    for (; j + 4 <= n; j += 4) {                                                  \
+      const T *a0 = a + j * lda, *a1 = a0 + lda, *a2 = a1 + lda, *a3 = a2 + lda;  \
+      T x0 = alpha * x[j], x1 = alpha * x[j + 1];                                 \
+      T x2 = alpha * x[j + 2], x3 = alpha * x[j + 3];                             \
+      MVLA__##tier##_##P##_T v0 = MVLA__GOP(tier, P, SET1)(x0);                   \
+      MVLA__##tier##_##P##_T v1 = MVLA__GOP(tier, P, SET1)(x1);                   \
+      MVLA__##tier##_##P##_T v2 = MVLA__GOP(tier, P, SET1)(x2);                   \
+      MVLA__##tier##_##P##_T v3 = MVLA__GOP(tier, P, SET1)(x3);                   \
+      for (i = 0; i + MVLA__GOP(tier, P, WIDTH) <= m; i += MVLA__GOP(tier, P, WIDTH)) { \
+        MVLA__##tier##_##P##_T s = MVLA__GOP(tier, P, LOAD)(y + i);               \
+        s = MVLA__GOP(tier, P, FMA)(v0, MVLA__GOP(tier, P, LOAD)(a0 + i), s);     \
+        s = MVLA__GOP(tier, P, FMA)(v1, MVLA__GOP(tier, P, LOAD)(a1 + i), s);     \
+        s = MVLA__GOP(tier, P, FMA)(v2, MVLA__GOP(tier, P, LOAD)(a2 + i), s);     \
+        s = MVLA__GOP(tier, P, FMA)(v3, MVLA__GOP(tier, P, LOAD)(a3 + i), s);     \
+        MVLA__GOP(tier, P, STORE)(y + i, s);                                      \
+      }                                                                           \
+      for (; i < m; ++i) {                                                        \
+        y[i] += x0 * a0[i] + x1 * a1[i] + x2 * a2[i] + x3 * a3[i];                \
+      }                                                                           \
+    }                                                                             \
+    for (; j < n; ++j) {                                                          \
+      mvla__##f##_axpy_k_##tier(alpha * x[j], a + j * lda, y, m);                 \
+    }                                                                             \
+  }
+
+#define MVLA__GEMM_KERNELS(X, tier, attr)                                         \
+  X(tier, attr, f32, float, PS)                                                   \
+  X(tier, attr, f64, double, PD)
+
+// steps one lane of a lane set the way mvla_rng_randf does
+static inline float mvla__rng_lane_randf(mvla_rng_lanes_t *g, size_t lane) {
+  mvla_rng_t rng;
+  float u;
+  int k;
+  for (k = 0; k < 4; ++k) {
+    rng.s[k] = g->s[k][lane];
+  }
+  u = mvla_rng_randf(&rng);
+  for (k = 0; k < 4; ++k) {
+    g->s[k][lane] = rng.s[k];
+  }
+  return u;
+}
+
+#define MVLA__ROTL64(tier, x, k)                                                  \
+  MVLA__PD(tier, IOR)(MVLA__PD(tier, ISLL)(x, k), MVLA__PD(tier, ISRL)(x, 64 - (k)))
+
+/*
+** Uniform floats for n vectors taking draws each, written component-major as
+** out[d * n + i] (draw d of vector i). Vector i draws from lane i % 8, so the
+** states step in 64-bit lanes and the top 24 bits become a float through the
+** 2^52 exponent trick, exactly like mvla_rng_randf.
+*/
+#define MVLA__RNG_UNIFORM_KERNEL(tier, attr)                                      \
+  static inline attr void mvla__rng_uniform_##tier(mvla_rng_lanes_t *g, float *out, \
+                                                   size_t n, size_t draws) {      \
+    size_t l, i, d, full = n - n % MVLA_RNG_LANES;                                \
+    for (l = 0; l < MVLA_RNG_LANES; l += MVLA__PD(tier, WIDTH)) {                 \
+      MVLA__PD(tier, I) s0 = MVLA__PD(tier, ILOAD)(g->s[0] + l);                  \
+      MVLA__PD(tier, I) s1 = MVLA__PD(tier, ILOAD)(g->s[1] + l);                  \
+      MVLA__PD(tier, I) s2 = MVLA__PD(tier, ILOAD)(g->s[2] + l);                  \
+      MVLA__PD(tier, I) s3 = MVLA__PD(tier, ILOAD)(g->s[3] + l);                  \
+      MVLA__PD(tier, I) r, t;                                                     \
+      for (i = 0; i < full; i += MVLA_RNG_LANES) {                                \
+        for (d = 0; d < draws; ++d) {                                             \
+          r = MVLA__PD(tier, IADD)(MVLA__ROTL64(tier, MVLA__PD(tier, IADD)(s0, s3), 23), s0); \
+          t = MVLA__PD(tier, ISLL)(s1, 17);                                       \
+          s2 = MVLA__PD(tier, IXOR)(s2, s0);                                      \
+          s3 = MVLA__PD(tier, IXOR)(s3, s1);                                      \
+          s1 = MVLA__PD(tier, IXOR)(s1, s2);                                      \
+          s0 = MVLA__PD(tier, IXOR)(s0, s3);                                      \
+          s2 = MVLA__PD(tier, IXOR)(s2, t);                                       \
+          s3 = MVLA__ROTL64(tier, s3, 45);                                        \
+          r = MVLA__PD(tier, IOR)(MVLA__PD(tier, ISRL)(r, 40),                    \
+                                  MVLA__PD(tier, ISET1)(UINT64_C(0x4330000000000000))); \
+          MVLA__PD(tier, STOREF)(out + d * n + i + l, MVLA__PD(tier, MUL)(        \
+            MVLA__PD(tier, SUB)(MVLA__PD(tier, CASTF)(r), MVLA__PD(tier, SET1)(4503599627370496.0)), \
+            MVLA__PD(tier, SET1)(5.9604644775390625e-8)));                        \
+        }                                                                         \
+      }                                                                           \
+      MVLA__PD(tier, ISTORE)(g->s[0] + l, s0);                                    \
+      MVLA__PD(tier, ISTORE)(g->s[1] + l, s1);                                    \
+      MVLA__PD(tier, ISTORE)(g->s[2] + l, s2);                                    \
+      MVLA__PD(tier, ISTORE)(g->s[3] + l, s3);                                    \
+    }                                                                             \
+    for (i = full; i < n; ++i) {                                                  \
+      for (d = 0; d < draws; ++d) {                                               \
+        out[d * n + i] = mvla__rng_lane_randf(g, i % MVLA_RNG_LANES);             \
+      }                                                                           \
+    }                                                                             \
+  }
+
+#define MVLA__PHILOX_M0 UINT64_C(0xd2511f53)
+#define MVLA__PHILOX_M1 UINT64_C(0xcd9e8d57)
+#define MVLA__PHILOX_W0 UINT64_C(0x9e3779b9)
+#define MVLA__PHILOX_W1 UINT64_C(0xbb67ae85)
+
+// Philox4x32-10 on counter (index, stream) under key seed, as in Random123
+static inline void mvla__philox_block(uint64_t seed, uint64_t stream, uint64_t index,
+                                      unsigned int out[4]) {
+  uint64_t c0 = index & 0xffffffffu, c1 = index >> 32;
+  uint64_t c2 = stream & 0xffffffffu, c3 = stream >> 32;
+  uint64_t k0 = seed & 0xffffffffu, k1 = seed >> 32;
+  int r;
+  for (r = 0; r < 10; ++r) {
+    uint64_t p0 = MVLA__PHILOX_M0 * c0;
+    uint64_t p1 = MVLA__PHILOX_M1 * c2;
+    c0 = ((p1 >> 32) ^ c1 ^ k0) & 0xffffffffu;
+    c1 = p1 & 0xffffffffu;
+    c2 = ((p0 >> 32) ^ c3 ^ k1) & 0xffffffffu;
+    c3 = p0 & 0xffffffffu;
+    k0 = (k0 + MVLA__PHILOX_W0) & 0xffffffffu;
+    k1 = (k1 + MVLA__PHILOX_W1) & 0xffffffffu;
+  }
+  out[0] = (unsigned int) c0;
+  out[1] = (unsigned int) c1;
+  out[2] = (unsigned int) c2;
+  out[3] = (unsigned int) c3;
+}
+
+static const uint64_t mvla__lane_index[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+
+/*
+** Philox blocks first .. first + n - 1 into out[4 * i + k]. Each 32-bit word
+** sits in a 64-bit lane so the 32x32 -> 64 multiplies map onto mul_epu32,
+** one block per lane.
+*/
+#define MVLA__PHILOX_KERNEL(tier, attr)                                           \
+  static inline attr void mvla__philox_##tier(uint64_t seed, uint64_t stream,     \
+                                              uint64_t first, unsigned int *out,  \
+                                              size_t n) {                         \
+    const MVLA__PD(tier, I) lo = MVLA__PD(tier, ISET1)(UINT64_C(0xffffffff));     \
+    const MVLA__PD(tier, I) m0 = MVLA__PD(tier, ISET1)(MVLA__PHILOX_M0);          \
+    const MVLA__PD(tier, I) m1 = MVLA__PD(tier, ISET1)(MVLA__PHILOX_M1);          \
+    uint64_t words[4][8];                                                         \
+    size_t i = 0, l;                                                              \
+    int r, k;                                                                     \
+    for (; i + MVLA__PD(tier, WIDTH) <= n; i += MVLA__PD(tier, WIDTH)) {          \
+      MVLA__PD(tier, I) idx = MVLA__PD(tier, IADD)(MVLA__PD(tier, ISET1)(first + i), \
+                                                   MVLA__PD(tier, ILOAD)(mvla__lane_index)); \
+      MVLA__PD(tier, I) c0 = MVLA__PD(tier, IAND)(idx, lo);                       \
+      MVLA__PD(tier, I) c1 = MVLA__PD(tier, ISRL)(idx, 32);                       \
+      MVLA__PD(tier, I) c2 = MVLA__PD(tier, ISET1)(stream & 0xffffffffu);         \
+      MVLA__PD(tier, I) c3 = MVLA__PD(tier, ISET1)(stream >> 32);                 \
+      uint64_t k0 = seed & 0xffffffffu, k1 = seed >> 32;                          \
+      for (r = 0; r < 10; ++r) {                                                  \
+        MVLA__PD(tier, I) p0 = MVLA__PD(tier, IMULU32)(m0, c0);                   \
+        MVLA__PD(tier, I) p1 = MVLA__PD(tier, IMULU32)(m1, c2);                   \
+        c0 = MVLA__PD(tier, IXOR)(MVLA__PD(tier, IXOR)(MVLA__PD(tier, ISRL)(p1, 32), c1), \
+                                  MVLA__PD(tier, ISET1)(k0));                     \
+        c1 = MVLA__PD(tier, IAND)(p1, lo);                                        \
+        c2 = MVLA__PD(tier, IXOR)(MVLA__PD(tier, IXOR)(MVLA__PD(tier, ISRL)(p0, 32), c3), \
+                                  MVLA__PD(tier, ISET1)(k1));                     \
+        c3 = MVLA__PD(tier, IAND)(p0, lo);                                        \
+        k0 = (k0 + MVLA__PHILOX_W0) & 0xffffffffu;                                \
+        k1 = (k1 + MVLA__PHILOX_W1) & 0xffffffffu;                                \
+      }                                                                           \
+      MVLA__PD(tier, ISTORE)(words[0], c0);                                       \
+      MVLA__PD(tier, ISTORE)(words[1], c1);                                       \
+      MVLA__PD(tier, ISTORE)(words[2], c2);                                       \
+      MVLA__PD(tier, ISTORE)(words[3], c3);                                       \
+      for (l = 0; l < MVLA__PD(tier, WIDTH); ++l) {                               \
+        for (k = 0; k < 4; ++k) {                                                 \
+          out[4 * (i + l) + k] = (unsigned int) words[k][l];                      \
+        }                                                                         \
+      }                                                                           \
+    }                                                                             \
+    for (; i < n; ++i) {                                                          \
+      mvla__philox_block(seed, stream, first + i, out + 4 * i);                   \
+    }                                                                             \
+  }
+
+#define MVLA__FAST_UNARY_KERNEL(tier, attr, name, T, P, fn, sfn)                  \
+  static inline attr void mvla__##name##_##tier(const T *a, T *out, size_t n) {   \
+    size_t i = 0;                                                                 \
+    for (; i + MVLA__##tier##_##P##_WIDTH <= n; i += MVLA__##tier##_##P##_WIDTH) { \
+      MVLA__##tier##_##P##_STORE(out + i, mvla__##fn##_##tier(MVLA__##tier##_##P##_LOAD(a + i))); \
+    }                                                                             \
+    for (; i < n; ++i) {                                                          \
+      out[i] = sfn(a[i]);                                                         \
+    }                                                                             \
+  }
+
+#define MVLA__FAST_BINARY_KERNEL(tier, attr, name, T, P, fn, sfn)                 \
+  static inline attr void mvla__##name##_##tier(const T *a, const T *b, T *out,   \
+                                                size_t n) {                       \
+    size_t i = 0;                                                                 \
+    for (; i + MVLA__##tier##_##P##_WIDTH <= n; i += MVLA__##tier##_##P##_WIDTH) { \
+      MVLA__##tier##_##P##_STORE(out + i,                                         \
+        mvla__##fn##_##tier(MVLA__##tier##_##P##_LOAD(a + i),                     \
+                            MVLA__##tier##_##P##_LOAD(b + i)));                   \
+    }                                                                             \
+    for (; i < n; ++i) {                                                          \
+      out[i] = sfn(a[i], b[i]);                                                   \
+    }                                                                             \
+  }
+
+#define MVLA__FAST_SINCOS_KERNEL(tier, attr, name, T, P, fn, sfn)                 \
+  static inline attr void mvla__##name##_##tier(const T *a, T *s, T *c, size_t n) { \
+    size_t i = 0;                                                                 \
+    for (; i + MVLA__##tier##_##P##_WIDTH <= n; i += MVLA__##tier##_##P##_WIDTH) { \
+      MVLA__##tier##_##P##_T vs, vc;                                              \
+      mvla__##fn##_##tier(MVLA__##tier##_##P##_LOAD(a + i), &vs, &vc);            \
+      MVLA__##tier##_##P##_STORE(s + i, vs);                                      \
+      MVLA__##tier##_##P##_STORE(c + i, vc);                                      \
+    }                                                                             \
+    for (; i < n; ++i) {                                                          \
+      sfn(a[i], s + i, c + i);                                                    \
+    }                                                                             \
+  }
+
+
+// libm stand-ins with the shape the fast math fallbacks expect
+static inline float mvla__rsqrtf(float a) {
+  return 1.0f / sqrtf(a);
+}
+
+static inline double mvla__powf_d(double a, double b) {
+  return (double) powf((float) a, (float) b);
+}
+
+/*
+** Fast math kernels, written once against the operation tables and stamped
+** out per tier. Each reduces the argument with a shifter constant (adding
+** 1.5 * 2^23 or 2^52 rounds to an integer whose bits land in the low
+** mantissa) and evaluates a short polynomial. Lanes outside the domain the
+** polynomial is accurate on (including NaN and inf) send the whole register
+** through libm instead, so every input gets an answer within the documented
+** error bound.
+*/
+
+#define MVLA__PS(tier, OP) MVLA__##tier##_PS_##OP
+#define MVLA__PD(tier, OP) MVLA__##tier##_PD_##OP
+
+#define MVLA__FAST_FALLBACK(tier, P, S, v, fn)                                    \
+  do {                                                                            \
+    S t_[MVLA__##tier##_##P##_WIDTH];                                             \
+    int i_;                                                                       \
+    MVLA__##tier##_##P##_STORE(t_, v);                                            \
+    for (i_ = 0; i_ < MVLA__##tier##_##P##_WIDTH; ++i_) {                         \
+      t_[i_] = fn(t_[i_]);                                                        \
+    }                                                                             \
+    return MVLA__##tier##_##P##_LOAD(t_);                                         \
+  } while (0)
+
+#define MVLA__FAST_FALLBACK2(tier, P, S, v, w, fn)                                \
+  do {                                                                            \
+    S t_[MVLA__##tier##_##P##_WIDTH], u_[MVLA__##tier##_##P##_WIDTH];             \
+    int i_;                                                                       \
+    MVLA__##tier##_##P##_STORE(t_, v);                                            \
+    MVLA__##tier##_##P##_STORE(u_, w);                                            \
+    for (i_ = 0; i_ < MVLA__##tier##_##P##_WIDTH; ++i_) {                         \
+      t_[i_] = fn(t_[i_], u_[i_]);                                                \
+    }                                                                             \
+    return MVLA__##tier##_##P##_LOAD(t_);                                         \
+  } while (0)
+
+#define MVLA__FAST_SINCOS_FALLBACK(tier, P, S, v, s, c, sinfn, cosfn)             \
+  do {                                                                            \
+    S t_[MVLA__##tier##_##P##_WIDTH], u_[MVLA__##tier##_##P##_WIDTH];             \
+    int i_;                                                                       \
+    MVLA__##tier##_##P##_STORE(t_, v);                                            \
+    for (i_ = 0; i_ < MVLA__##tier##_##P##_WIDTH; ++i_) {                         \
+      u_[i_] = cosfn(t_[i_]);                                                     \
+      t_[i_] = sinfn(t_[i_]);                                                     \
+    }                                                                             \
+    *(s) = MVLA__##tier##_##P##_LOAD(t_);                                         \
+    *(c) = MVLA__##tier##_##P##_LOAD(u_);                                         \
+    return;                                                                       \
+  } while (0)
+
+// e^x = 2^k * e^r with |r| <= ln(2) / 2, Cephes expf polynomial
+#define MVLA__EXP_PS(tier, attr)                                                  \
+  static inline attr MVLA__PS(tier, T) mvla__exp_ps_##tier(MVLA__PS(tier, T) x) { \
+    MVLA__PS(tier, T) t, k, r, p;                                                 \
+    if (!(MVLA__PS(tier, ALL_LE)(MVLA__PS(tier, SET1)(-87.3f), x) &&              \
+          MVLA__PS(tier, ALL_LE)(x, MVLA__PS(tier, SET1)(88.3f)))) {              \
+      MVLA__FAST_FALLBACK(tier, PS, float, x, expf);                              \
+    }                                                                             \
+    t = MVLA__PS(tier, FMA)(x, MVLA__PS(tier, SET1)(1.44269504088896341f),        \
+                            MVLA__PS(tier, SET1)(12582912.0f));                   \
+    k = MVLA__PS(tier, SUB)(t, MVLA__PS(tier, SET1)(12582912.0f));                \
+    r = MVLA__PS(tier, FMA)(k, MVLA__PS(tier, SET1)(-0.693359375f), x);           \
+    r = MVLA__PS(tier, FMA)(k, MVLA__PS(tier, SET1)(2.12194440e-4f), r);          \
+    p = MVLA__PS(tier, SET1)(1.9875691500e-4f);                                   \
+    p = MVLA__PS(tier, FMA)(p, r, MVLA__PS(tier, SET1)(1.3981999507e-3f));        \
+    p = MVLA__PS(tier, FMA)(p, r, MVLA__PS(tier, SET1)(8.3334519073e-3f));        \
+    p = MVLA__PS(tier, FMA)(p, r, MVLA__PS(tier, SET1)(4.1665795894e-2f));        \
+    p = MVLA__PS(tier, FMA)(p, r, MVLA__PS(tier, SET1)(1.6666665459e-1f));        \
+    p = MVLA__PS(tier, FMA)(p, r, MVLA__PS(tier, SET1)(5.0000001201e-1f));        \
+    p = MVLA__PS(tier, FMA)(MVLA__PS(tier, MUL)(p, r), r,                         \
+                            MVLA__PS(tier, ADD)(r, MVLA__PS(tier, SET1)(1.0f)));  \
+    return MVLA__PS(tier, MUL)(p, MVLA__PS(tier, CASTF)(MVLA__PS(tier, ISLL)(     \
+      MVLA__PS(tier, IADD)(MVLA__PS(tier, CASTI)(t), MVLA__PS(tier, ISET1)(127)), 23))); \
+  }
+
+/*
+** ln(x) = e * ln(2) + ln(m) with m in [sqrt(2) / 2, sqrt(2)), found by
+** subtracting the bits of sqrt(2) / 2 so no compare is needed. The exponent
+** is biased positive so a logical shift and a 2^23 magic number convert it.
+** Cephes logf polynomial
+*/
+#define MVLA__LOG_PS(tier, attr)                                                  \
+  static inline attr MVLA__PS(tier, T) mvla__log_ps_##tier(MVLA__PS(tier, T) x) { \
+    MVLA__PS(tier, I) u;                                                          \
+    MVLA__PS(tier, T) e, f, z, p;                                                 \
+    if (!(MVLA__PS(tier, ALL_LE)(MVLA__PS(tier, SET1)(1.17549435e-38f), x) &&     \
+          MVLA__PS(tier, ALL_LE)(x, MVLA__PS(tier, SET1)(3.40282347e+38f)))) {    \
+      MVLA__FAST_FALLBACK(tier, PS, float, x, logf);                              \
+    }                                                                             \
+    u = MVLA__PS(tier, ISUB)(MVLA__PS(tier, CASTI)(x), MVLA__PS(tier, ISET1)(0x3f3504f3)); \
+    e = MVLA__PS(tier, SUB)(MVLA__PS(tier, CASTF)(MVLA__PS(tier, IOR)(            \
+          MVLA__PS(tier, ISRL)(MVLA__PS(tier, IADD)(u, MVLA__PS(tier, ISET1)(0x40000000)), 23), \
+          MVLA__PS(tier, ISET1)(0x4b000000))), MVLA__PS(tier, SET1)(8388736.0f));  \
+    f = MVLA__PS(tier, CASTF)(MVLA__PS(tier, IADD)(                               \
+          MVLA__PS(tier, IAND)(u, MVLA__PS(tier, ISET1)(0x007fffff)),             \
+          MVLA__PS(tier, ISET1)(0x3f3504f3)));                                    \
+    f = MVLA__PS(tier, SUB)(f, MVLA__PS(tier, SET1)(1.0f));                       \
+    z = MVLA__PS(tier, MUL)(f, f);                                                \
+    p = MVLA__PS(tier, SET1)(7.0376836292e-2f);                                   \
+    p = MVLA__PS(tier, FMA)(p, f, MVLA__PS(tier, SET1)(-1.1514610310e-1f));       \
+    p = MVLA__PS(tier, FMA)(p, f, MVLA__PS(tier, SET1)(1.1676998740e-1f));        \
+    p = MVLA__PS(tier, FMA)(p, f, MVLA__PS(tier, SET1)(-1.2420140846e-1f));       \
+    p = MVLA__PS(tier, FMA)(p, f, MVLA__PS(tier, SET1)(1.4249322787e-1f));        \
+    p = MVLA__PS(tier, FMA)(p, f, MVLA__PS(tier, SET1)(-1.6668057665e-1f));       \
+    p = MVLA__PS(tier, FMA)(p, f, MVLA__PS(tier, SET1)(2.0000714765e-1f));        \
+    p = MVLA__PS(tier, FMA)(p, f, MVLA__PS(tier, SET1)(-2.4999993993e-1f));       \
+    p = MVLA__PS(tier, FMA)(p, f, MVLA__PS(tier, SET1)(3.3333331174e-1f));        \
+    p = MVLA__PS(tier, MUL)(MVLA__PS(tier, MUL)(p, f), z);                        \
+    p = MVLA__PS(tier, FMA)(e, MVLA__PS(tier, SET1)(-2.12194440e-4f), p);         \
+    p = MVLA__PS(tier, FMA)(z, MVLA__PS(tier, SET1)(-0.5f), p);                   \
+    return MVLA__PS(tier, FMA)(e, MVLA__PS(tier, SET1)(0.693359375f),             \
+                               MVLA__PS(tier, ADD)(f, p));                        \
+  }
+
+/*
+** x = j * pi / 2 + r with |r| <= pi / 4, pi / 2 split in four so j * P1 to
+** j * P3 are exact for |x| <= 8192. Both Cephes polynomials are evaluated and
+** the quadrant (j & 3) picks and negates them per lane.
+*/
+#define MVLA__SINCOS_PS(tier, attr)                                               \
+  static inline attr void mvla__sincos_ps_##tier(MVLA__PS(tier, T) x,             \
+                                                 MVLA__PS(tier, T) *s,            \
+                                                 MVLA__PS(tier, T) *c) {          \
+    MVLA__PS(tier, I) q;                                                          \
+    MVLA__PS(tier, T) t, j, r, z, sp, cp, swap;                                   \
+    if (!MVLA__PS(tier, ALL_LE)(MVLA__PS(tier, ANDNOT)(MVLA__PS(tier, SET1)(-0.0f), x), \
+                                MVLA__PS(tier, SET1)(8192.0f))) {                 \
+      MVLA__FAST_SINCOS_FALLBACK(tier, PS, float, x, s, c, sinf, cosf);           \
+    }                                                                             \
+    t = MVLA__PS(tier, FMA)(x, MVLA__PS(tier, SET1)(0.636619772367581343f),       \
+                            MVLA__PS(tier, SET1)(12582912.0f));                   \
+    j = MVLA__PS(tier, SUB)(t, MVLA__PS(tier, SET1)(12582912.0f));                \
+    r = MVLA__PS(tier, FMA)(j, MVLA__PS(tier, SET1)(-1.5703125f), x);             \
+    r = MVLA__PS(tier, FMA)(j, MVLA__PS(tier, SET1)(-4.837512969970703125e-4f), r); \
+    r = MVLA__PS(tier, FMA)(j, MVLA__PS(tier, SET1)(-7.549533620476722717e-8f), r); \
+    r = MVLA__PS(tier, FMA)(j, MVLA__PS(tier, SET1)(-2.563344068257089592e-12f), r); \
+    z = MVLA__PS(tier, MUL)(r, r);                                                \
+    sp = MVLA__PS(tier, SET1)(-1.9515295891e-4f);                                 \
+    sp = MVLA__PS(tier, FMA)(sp, z, MVLA__PS(tier, SET1)(8.3321608736e-3f));      \
+    sp = MVLA__PS(tier, FMA)(sp, z, MVLA__PS(tier, SET1)(-1.6666654611e-1f));     \
+    sp = MVLA__PS(tier, FMA)(MVLA__PS(tier, MUL)(sp, z), r, r);                   \
+    cp = MVLA__PS(tier, SET1)(2.443315711809948e-5f);                             \
+    cp = MVLA__PS(tier, FMA)(cp, z, MVLA__PS(tier, SET1)(-1.388731625493765e-3f)); \
+    cp = MVLA__PS(tier, FMA)(cp, z, MVLA__PS(tier, SET1)(4.166664568298827e-2f)); \
+    cp = MVLA__PS(tier, FMA)(MVLA__PS(tier, MUL)(cp, z), z,                       \
+           MVLA__PS(tier, FMA)(z, MVLA__PS(tier, SET1)(-0.5f), MVLA__PS(tier, SET1)(1.0f))); \
+    q = MVLA__PS(tier, CASTI)(t);                                                 \
+    swap = MVLA__PS(tier, CASTF)(MVLA__PS(tier, ISUB)(MVLA__PS(tier, ISET1)(0),   \
+             MVLA__PS(tier, IAND)(q, MVLA__PS(tier, ISET1)(1))));                 \
+    *s = MVLA__PS(tier, OR)(MVLA__PS(tier, AND)(swap, cp), MVLA__PS(tier, ANDNOT)(swap, sp)); \
+    *c = MVLA__PS(tier, OR)(MVLA__PS(tier, AND)(swap, sp), MVLA__PS(tier, ANDNOT)(swap, cp)); \
+    *s = MVLA__PS(tier, XOR)(*s, MVLA__PS(tier, CASTF)(MVLA__PS(tier, ISLL)(      \
+           MVLA__PS(tier, IAND)(q, MVLA__PS(tier, ISET1)(2)), 30)));              \
+    *c = MVLA__PS(tier, XOR)(*c, MVLA__PS(tier, CASTF)(MVLA__PS(tier, ISLL)(      \
+           MVLA__PS(tier, IAND)(MVLA__PS(tier, IADD)(q, MVLA__PS(tier, ISET1)(1)), \
+                                MVLA__PS(tier, ISET1)(2)), 30)));                 \
+  }
+
+/*
+** sqrt(x) and 1 / sqrt(x) from the hardware estimate (12 bits on SSE and AVX,
+** 14 on AVX-512) and one Newton-Raphson step
+*/
+#define MVLA__RSQRT_PS(tier, attr)                                                \
+  static inline attr MVLA__PS(tier, T) mvla__rsqrt_ps_##tier(MVLA__PS(tier, T) x) { \
+    MVLA__PS(tier, T) y;                                                          \
+    if (!(MVLA__PS(tier, ALL_LE)(MVLA__PS(tier, SET1)(1.17549435e-38f), x) &&     \
+          MVLA__PS(tier, ALL_LE)(x, MVLA__PS(tier, SET1)(3.40282347e+38f)))) {    \
+      MVLA__FAST_FALLBACK(tier, PS, float, x, mvla__rsqrtf);                      \
+    }                                                                             \
+    y = MVLA__PS(tier, RSQRT)(x);                                                 \
+    return MVLA__PS(tier, FMA)(MVLA__PS(tier, MUL)(MVLA__PS(tier, SET1)(0.5f), y), \
+             MVLA__PS(tier, SUB)(MVLA__PS(tier, SET1)(1.0f),                      \
+               MVLA__PS(tier, MUL)(x, MVLA__PS(tier, MUL)(y, y))), y);            \
+  }                                                                               \
+  static inline attr MVLA__PS(tier, T) mvla__sqrt_ps_##tier(MVLA__PS(tier, T) x) { \
+    MVLA__PS(tier, T) y, s;                                                       \
+    if (!(MVLA__PS(tier, ALL_LE)(MVLA__PS(tier, SET1)(1.17549435e-38f), x) &&     \
+          MVLA__PS(tier, ALL_LE)(x, MVLA__PS(tier, SET1)(1.0e38f)))) {            \
+      MVLA__FAST_FALLBACK(tier, PS, float, x, sqrtf);                             \
+    }                                                                             \
+    y = MVLA__PS(tier, RSQRT)(x);                                                 \
+    s = MVLA__PS(tier, MUL)(x, y);                                                \
+    return MVLA__PS(tier, FMA)(MVLA__PS(tier, MUL)(MVLA__PS(tier, SET1)(0.5f), y), \
+             MVLA__PS(tier, SUB)(x, MVLA__PS(tier, MUL)(s, s)), s);               \
+  }
+
+// fdlibm exp, |r| <= ln(2) / 2 with r carried as hi - lo
+#define MVLA__EXP_PD(tier, attr)                                                  \
+  static inline attr MVLA__PD(tier, T) mvla__exp_pd_##tier(MVLA__PD(tier, T) x) { \
+    MVLA__PD(tier, T) t, k, hi, lo, r, z, p, y;                                   \
+    if (!(MVLA__PD(tier, ALL_LE)(MVLA__PD(tier, SET1)(-708.0), x) &&              \
+          MVLA__PD(tier, ALL_LE)(x, MVLA__PD(tier, SET1)(709.0)))) {              \
+      MVLA__FAST_FALLBACK(tier, PD, double, x, exp);                              \
+    }                                                                             \
+    t = MVLA__PD(tier, FMA)(x, MVLA__PD(tier, SET1)(1.44269504088896338700e+00),  \
+                            MVLA__PD(tier, SET1)(6755399441055744.0));            \
+    k = MVLA__PD(tier, SUB)(t, MVLA__PD(tier, SET1)(6755399441055744.0));         \
+    hi = MVLA__PD(tier, FMA)(k, MVLA__PD(tier, SET1)(-6.93147180369123816490e-01), x); \
+    lo = MVLA__PD(tier, MUL)(k, MVLA__PD(tier, SET1)(1.90821492927058770002e-10)); \
+    r = MVLA__PD(tier, SUB)(hi, lo);                                              \
+    z = MVLA__PD(tier, MUL)(r, r);                                                \
+    p = MVLA__PD(tier, SET1)(4.13813679705723846039e-08);                         \
+    p = MVLA__PD(tier, FMA)(p, z, MVLA__PD(tier, SET1)(-1.65339022054652515390e-06)); \
+    p = MVLA__PD(tier, FMA)(p, z, MVLA__PD(tier, SET1)(6.61375632143793436117e-05)); \
+    p = MVLA__PD(tier, FMA)(p, z, MVLA__PD(tier, SET1)(-2.77777777770155933842e-03)); \
+    p = MVLA__PD(tier, FMA)(p, z, MVLA__PD(tier, SET1)(1.66666666666666019037e-01)); \
+    p = MVLA__PD(tier, SUB)(r, MVLA__PD(tier, MUL)(z, p));                        \
+    y = MVLA__PD(tier, DIV)(MVLA__PD(tier, MUL)(r, p),                            \
+                            MVLA__PD(tier, SUB)(MVLA__PD(tier, SET1)(2.0), p));   \
+    y = MVLA__PD(tier, SUB)(MVLA__PD(tier, SET1)(1.0),                            \
+          MVLA__PD(tier, SUB)(MVLA__PD(tier, SUB)(lo, y), hi));                   \
+    return MVLA__PD(tier, MUL)(y, MVLA__PD(tier, CASTF)(MVLA__PD(tier, ISLL)(     \
+      MVLA__PD(tier, IADD)(MVLA__PD(tier, CASTI)(t), MVLA__PD(tier, ISET1)(1023)), 52))); \
+  }
+
+// fdlibm log with the same reduction as the float form
+#define MVLA__LOG_PD(tier, attr)                                                  \
+  static inline attr MVLA__PD(tier, T) mvla__log_pd_##tier(MVLA__PD(tier, T) x) { \
+    MVLA__PD(tier, I) u;                                                          \
+    MVLA__PD(tier, T) e, f, s, z, w, t1, t2, hfsq;                                \
+    if (!(MVLA__PD(tier, ALL_LE)(MVLA__PD(tier, SET1)(2.2250738585072014e-308), x) && \
+          MVLA__PD(tier, ALL_LE)(x, MVLA__PD(tier, SET1)(1.7976931348623157e+308)))) { \
+      MVLA__FAST_FALLBACK(tier, PD, double, x, log);                              \
+    }                                                                             \
+    u = MVLA__PD(tier, ISUB)(MVLA__PD(tier, CASTI)(x),                            \
+                             MVLA__PD(tier, ISET1)(0x3fe6a09e667f3bcdULL));       \
+    e = MVLA__PD(tier, SUB)(MVLA__PD(tier, CASTF)(MVLA__PD(tier, IOR)(            \
+          MVLA__PD(tier, ISRL)(MVLA__PD(tier, IADD)(u, MVLA__PD(tier, ISET1)(0x4000000000000000ULL)), 52), \
+          MVLA__PD(tier, ISET1)(0x4330000000000000ULL))),                         \
+          MVLA__PD(tier, SET1)(4503599627371520.0));                              \
+    f = MVLA__PD(tier, CASTF)(MVLA__PD(tier, IADD)(                               \
+          MVLA__PD(tier, IAND)(u, MVLA__PD(tier, ISET1)(0x000fffffffffffffULL)),  \
+          MVLA__PD(tier, ISET1)(0x3fe6a09e667f3bcdULL)));                         \
+    f = MVLA__PD(tier, SUB)(f, MVLA__PD(tier, SET1)(1.0));                        \
+    s = MVLA__PD(tier, DIV)(f, MVLA__PD(tier, ADD)(MVLA__PD(tier, SET1)(2.0), f)); \
+    z = MVLA__PD(tier, MUL)(s, s);                                                \
+    w = MVLA__PD(tier, MUL)(z, z);                                                \
+    t1 = MVLA__PD(tier, FMA)(w, MVLA__PD(tier, SET1)(1.531383769920937332e-01),   \
+                             MVLA__PD(tier, SET1)(2.222219843214978396e-01));     \
+    t1 = MVLA__PD(tier, FMA)(w, t1, MVLA__PD(tier, SET1)(3.999999999940941908e-01)); \
+    t1 = MVLA__PD(tier, MUL)(w, t1);                                              \
+    t2 = MVLA__PD(tier, FMA)(w, MVLA__PD(tier, SET1)(1.479819860511658591e-01),   \
+                             MVLA__PD(tier, SET1)(1.818357216161805012e-01));     \
+    t2 = MVLA__PD(tier, FMA)(w, t2, MVLA__PD(tier, SET1)(2.857142874366239149e-01)); \
+    t2 = MVLA__PD(tier, FMA)(w, t2, MVLA__PD(tier, SET1)(6.666666666666735130e-01)); \
+    t2 = MVLA__PD(tier, MUL)(z, t2);                                              \
+    hfsq = MVLA__PD(tier, MUL)(MVLA__PD(tier, SET1)(0.5), MVLA__PD(tier, MUL)(f, f)); \
+    t1 = MVLA__PD(tier, FMA)(s, MVLA__PD(tier, ADD)(hfsq, MVLA__PD(tier, ADD)(t2, t1)), \
+           MVLA__PD(tier, MUL)(e, MVLA__PD(tier, SET1)(1.90821492927058770002e-10))); \
+    return MVLA__PD(tier, SUB)(                                                   \
+      MVLA__PD(tier, MUL)(e, MVLA__PD(tier, SET1)(6.93147180369123816490e-01)),   \
+      MVLA__PD(tier, SUB)(MVLA__PD(tier, SUB)(hfsq, t1), f));                     \
+  }
+
+// fdlibm kernel polynomials, pi / 2 split in three for |x| <= 65536
+#define MVLA__SINCOS_PD(tier, attr)                                               \
+  static inline attr void mvla__sincos_pd_##tier(MVLA__PD(tier, T) x,             \
+                                                 MVLA__PD(tier, T) *s,            \
+                                                 MVLA__PD(tier, T) *c) {          \
+    MVLA__PD(tier, I) q;                                                          \
+    MVLA__PD(tier, T) t, j, r, z, hz, w, sp, cp, swap;                            \
+    if (!MVLA__PD(tier, ALL_LE)(MVLA__PD(tier, ANDNOT)(MVLA__PD(tier, SET1)(-0.0), x), \
+                                MVLA__PD(tier, SET1)(65536.0))) {                 \
+      MVLA__FAST_SINCOS_FALLBACK(tier, PD, double, x, s, c, sin, cos);           \
+    }                                                                             \
+    t = MVLA__PD(tier, FMA)(x, MVLA__PD(tier, SET1)(6.36619772367581382433e-01),  \
+                            MVLA__PD(tier, SET1)(6755399441055744.0));            \
+    j = MVLA__PD(tier, SUB)(t, MVLA__PD(tier, SET1)(6755399441055744.0));         \
+    r = MVLA__PD(tier, FMA)(j, MVLA__PD(tier, SET1)(-1.57079632673412561417e+00), x); \
+    r = MVLA__PD(tier, FMA)(j, MVLA__PD(tier, SET1)(-6.07710050630396597660e-11), r); \
+    r = MVLA__PD(tier, FMA)(j, MVLA__PD(tier, SET1)(-2.02226624879595063154e-21), r); \
+    z = MVLA__PD(tier, MUL)(r, r);                                                \
+    sp = MVLA__PD(tier, SET1)(1.58969099521155010221e-10);                        \
+    sp = MVLA__PD(tier, FMA)(sp, z, MVLA__PD(tier, SET1)(-2.50507602534068634195e-08)); \
+    sp = MVLA__PD(tier, FMA)(sp, z, MVLA__PD(tier, SET1)(2.75573137070700676789e-06)); \
+    sp = MVLA__PD(tier, FMA)(sp, z, MVLA__PD(tier, SET1)(-1.98412698298579493134e-04)); \
+    sp = MVLA__PD(tier, FMA)(sp, z, MVLA__PD(tier, SET1)(8.33333333332248946124e-03)); \
+    sp = MVLA__PD(tier, FMA)(sp, z, MVLA__PD(tier, SET1)(-1.66666666666666324348e-01)); \
+    sp = MVLA__PD(tier, FMA)(MVLA__PD(tier, MUL)(sp, z), r, r);                   \
+    cp = MVLA__PD(tier, SET1)(-1.13596475577881948265e-11);                       \
+    cp = MVLA__PD(tier, FMA)(cp, z, MVLA__PD(tier, SET1)(2.08757232129817482790e-09)); \
+    cp = MVLA__PD(tier, FMA)(cp, z, MVLA__PD(tier, SET1)(-2.75573143513906633035e-07)); \
+    cp = MVLA__PD(tier, FMA)(cp, z, MVLA__PD(tier, SET1)(2.48015872894767294178e-05)); \
+    cp = MVLA__PD(tier, FMA)(cp, z, MVLA__PD(tier, SET1)(-1.38888888888741095749e-03)); \
+    cp = MVLA__PD(tier, FMA)(cp, z, MVLA__PD(tier, SET1)(4.16666666666666019037e-02)); \
+    hz = MVLA__PD(tier, MUL)(z, MVLA__PD(tier, SET1)(0.5));                       \
+    w = MVLA__PD(tier, SUB)(MVLA__PD(tier, SET1)(1.0), hz);                       \
+    cp = MVLA__PD(tier, ADD)(w, MVLA__PD(tier, FMA)(MVLA__PD(tier, MUL)(z, z), cp, \
+           MVLA__PD(tier, SUB)(MVLA__PD(tier, SUB)(MVLA__PD(tier, SET1)(1.0), w), hz))); \
+    q = MVLA__PD(tier, CASTI)(t);                                                 \
+    swap = MVLA__PD(tier, CASTF)(MVLA__PD(tier, ISUB)(MVLA__PD(tier, ISET1)(0),   \
+             MVLA__PD(tier, IAND)(q, MVLA__PD(tier, ISET1)(1))));                 \
+    *s = MVLA__PD(tier, OR)(MVLA__PD(tier, AND)(swap, cp), MVLA__PD(tier, ANDNOT)(swap, sp)); \
+    *c = MVLA__PD(tier, OR)(MVLA__PD(tier, AND)(swap, sp), MVLA__PD(tier, ANDNOT)(swap, cp)); \
+    *s = MVLA__PD(tier, XOR)(*s, MVLA__PD(tier, CASTF)(MVLA__PD(tier, ISLL)(      \
+           MVLA__PD(tier, IAND)(q, MVLA__PD(tier, ISET1)(2)), 62)));              \
+    *c = MVLA__PD(tier, XOR)(*c, MVLA__PD(tier, CASTF)(MVLA__PD(tier, ISLL)(      \
+           MVLA__PD(tier, IAND)(MVLA__PD(tier, IADD)(q, MVLA__PD(tier, ISET1)(1)), \
+                                MVLA__PD(tier, ISET1)(2)), 62)));                 \
+  }
+
+/*
+** x^y = e^(y * ln(x)) for positive finite x and finite y. The float form runs
+** in double lanes so the product keeps enough bits, the double form loses
+** about |y * ln(x)| ulps to it.
+*/
+#define MVLA__POW_PD(tier, attr)                                                  \
+  static inline attr MVLA__PD(tier, T) mvla__pow_pd_##tier(MVLA__PD(tier, T) x,   \
+                                                           MVLA__PD(tier, T) y) { \
+    if (!(MVLA__PD(tier, ALL_LE)(MVLA__PD(tier, SET1)(2.2250738585072014e-308), x) && \
+          MVLA__PD(tier, ALL_LE)(x, MVLA__PD(tier, SET1)(1.7976931348623157e+308)) && \
+          MVLA__PD(tier, ALL_LE)(MVLA__PD(tier, ANDNOT)(MVLA__PD(tier, SET1)(-0.0), y), \
+                                 MVLA__PD(tier, SET1)(1.7976931348623157e+308)))) { \
+      MVLA__FAST_FALLBACK2(tier, PD, double, x, y, pow);                          \
+    }                                                                             \
+    return mvla__exp_pd_##tier(MVLA__PD(tier, MUL)(y, mvla__log_pd_##tier(x)));   \
+  }                                                                               \
+  static inline attr MVLA__PD(tier, T) mvla__powf_pd_##tier(MVLA__PD(tier, T) x,  \
+                                                            MVLA__PD(tier, T) y) { \
+    if (!(MVLA__PD(tier, ALL_LE)(MVLA__PD(tier, SET1)(1.4e-45), x) &&             \
+          MVLA__PD(tier, ALL_LE)(x, MVLA__PD(tier, SET1)(3.40282347e+38)) &&      \
+          MVLA__PD(tier, ALL_LE)(MVLA__PD(tier, ANDNOT)(MVLA__PD(tier, SET1)(-0.0), y), \
+                                 MVLA__PD(tier, SET1)(3.40282347e+38)))) {        \
+      MVLA__FAST_FALLBACK2(tier, PD, double, x, y, mvla__powf_d);                 \
+    }                                                                             \
+    return mvla__exp_pd_##tier(MVLA__PD(tier, MUL)(y, mvla__log_pd_##tier(x)));   \
+  }
+
+#define MVLA__FAST_MATH_TIER(tier, attr)                                          \
+  MVLA__EXP_PS(tier, attr)                                                        \
+  MVLA__LOG_PS(tier, attr)                                                        \
+  MVLA__SINCOS_PS(tier, attr)                                                     \
+  MVLA__RSQRT_PS(tier, attr)                                                      \
+  MVLA__EXP_PD(tier, attr)                                                        \
+  MVLA__LOG_PD(tier, attr)                                                        \
+  MVLA__SINCOS_PD(tier, attr)                                                     \
+  MVLA__POW_PD(tier, attr)                                                        \
+  static inline attr MVLA__PS(tier, T) mvla__sin_ps_##tier(MVLA__PS(tier, T) x) { \
+    MVLA__PS(tier, T) s, c;                                                       \
+    mvla__sincos_ps_##tier(x, &s, &c);                                            \
+    return s;                                                                     \
+  }                                                                               \
+  static inline attr MVLA__PS(tier, T) mvla__cos_ps_##tier(MVLA__PS(tier, T) x) { \
+    MVLA__PS(tier, T) s, c;                                                       \
+    mvla__sincos_ps_##tier(x, &s, &c);                                            \
+    return c;                                                                     \
+  }                                                                               \
+  static inline attr MVLA__PS(tier, T) mvla__tan_ps_##tier(MVLA__PS(tier, T) x) { \
+    MVLA__PS(tier, T) s, c;                                                       \
+    mvla__sincos_ps_##tier(x, &s, &c);                                            \
+    return MVLA__PS(tier, DIV)(s, c);                                             \
+  }                                                                               \
+  static inline attr MVLA__PD(tier, T) mvla__sin_pd_##tier(MVLA__PD(tier, T) x) { \
+    MVLA__PD(tier, T) s, c;                                                       \
+    mvla__sincos_pd_##tier(x, &s, &c);                                            \
+    return s;                                                                     \
+  }                                                                               \
+  static inline attr MVLA__PD(tier, T) mvla__cos_pd_##tier(MVLA__PD(tier, T) x) { \
+    MVLA__PD(tier, T) s, c;                                                       \
+    mvla__sincos_pd_##tier(x, &s, &c);                                            \
+    return c;                                                                     \
+  }                                                                               \
+  static inline attr MVLA__PD(tier, T) mvla__tan_pd_##tier(MVLA__PD(tier, T) x) { \
+    MVLA__PD(tier, T) s, c;                                                       \
+    mvla__sincos_pd_##tier(x, &s, &c);                                            \
+    return MVLA__PD(tier, DIV)(s, c);                                             \
+  }                                                                               \
+  static inline attr MVLA__PD(tier, T) mvla__sqrt_pd_##tier(MVLA__PD(tier, T) x) { \
+    return MVLA__PD(tier, SQRT)(x);                                               \
+  }                                                                               \
+  static inline attr MVLA__PD(tier, T) mvla__rsqrt_pd_##tier(MVLA__PD(tier, T) x) { \
+    return MVLA__PD(tier, DIV)(MVLA__PD(tier, SET1)(1.0), MVLA__PD(tier, SQRT)(x)); \
+  }
+
+#define MVLA__DEFINE_TIER(tier, attr)                                             \
+  MVLA__SQR_LEN_KERNEL(tier, attr, f32_sqr_len_k, float, PS, sqrtf)               \
+  MVLA__SQR_LEN_KERNEL(tier, attr, f64_sqr_len_k, double, PD, sqrt)               \
+  MVLA__RNG_UNIFORM_KERNEL(tier, attr)                                            \
+  MVLA__PHILOX_KERNEL(tier, attr)                                                 \
+  MVLA__FAST_MATH_TIER(tier, attr)                                                \
+  MVLA__FAST_UNARY_KERNELS(MVLA__FAST_UNARY_KERNEL, tier, attr)                   \
+  MVLA__FAST_BINARY_KERNELS(MVLA__FAST_BINARY_KERNEL, tier, attr)                 \
+  MVLA__FAST_SINCOS_KERNELS(MVLA__FAST_SINCOS_KERNEL, tier, attr)                 \
+  MVLA__GEOM_KERNELS(MVLA__GEOM_KERNEL, tier, attr)                               \
+  MVLA__BLAS1_KERNELS(MVLA__BLAS1_KERNEL, tier, attr)                             \
+  MVLA__XFORM_KERNELS(MVLA__XFORM_KERNEL, tier, attr)                             \
+  MVLA__INVERSE_KERNELS(MVLA__INVERSE_KERNEL, tier, attr)                         \
+  MVLA__GEMM_KERNELS(MVLA__GEMM_KERNEL, tier, attr)
+
+#define MVLA__X(name, T, P, OP, expr) MVLA__BINARY_KERNEL(SCALAR, , name, T, P, OP, expr)
+MVLA__BINARY_KERNELS(MVLA__X)
+#undef MVLA__X
+#define MVLA__X(name, T, P, OP, expr) MVLA__UNARY_KERNEL(SCALAR, , name, T, P, OP, expr)
+MVLA__UNARY_KERNELS(MVLA__X)
+#undef MVLA__X
+#define MVLA__X(name, T, P, OP, expr) MVLA__TERNARY_KERNEL(SCALAR, , name, T, P, OP, expr)
+MVLA__TERNARY_KERNELS(MVLA__X)
+#undef MVLA__X
+MVLA__DEFINE_TIER(SCALAR, )
+
+#ifdef MVLA_HAS_SSE2
+#define MVLA__X(name, T, P, OP, expr) MVLA__BINARY_KERNEL(SSE2, , name, T, P, OP, expr)
+MVLA__BINARY_KERNELS(MVLA__X)
+#undef MVLA__X
+#define MVLA__X(name, T, P, OP, expr) MVLA__UNARY_KERNEL(SSE2, , name, T, P, OP, expr)
+MVLA__UNARY_KERNELS(MVLA__X)
+#undef MVLA__X
+#define MVLA__X(name, T, P, OP, expr) MVLA__TERNARY_KERNEL(SSE2, , name, T, P, OP, expr)
+MVLA__TERNARY_KERNELS(MVLA__X)
+#undef MVLA__X
+MVLA__DEFINE_TIER(SSE2, )
+#endif // MVLA_HAS_SSE2
+
+#ifdef MVLA__TIER_AVX2
+#define MVLA__X(name, T, P, OP, expr) MVLA__BINARY_KERNEL(AVX2, MVLA__TARGET_AVX2, name, T, P, OP, expr)
+MVLA__BINARY_KERNELS(MVLA__X)
+#undef MVLA__X
+#define MVLA__X(name, T, P, OP, expr) MVLA__UNARY_KERNEL(AVX2, MVLA__TARGET_AVX2, name, T, P, OP, expr)
+MVLA__UNARY_KERNELS(MVLA__X)
+#undef MVLA__X
+#define MVLA__X(name, T, P, OP, expr) MVLA__TERNARY_KERNEL(AVX2, MVLA__TARGET_AVX2, name, T, P, OP, expr)
+MVLA__TERNARY_KERNELS(MVLA__X)
+#undef MVLA__X
+MVLA__DEFINE_TIER(AVX2, MVLA__TARGET_AVX2)
+#endif // MVLA__TIER_AVX2
+
+#ifdef MVLA__TIER_AVX512
+#define MVLA__X(name, T, P, OP, expr) MVLA__BINARY_KERNEL(AVX512, MVLA__TARGET_AVX512, name, T, P, OP, expr)
+MVLA__BINARY_KERNELS(MVLA__X)
+#undef MVLA__X
+#define MVLA__X(name, T, P, OP, expr) MVLA__UNARY_KERNEL(AVX512, MVLA__TARGET_AVX512, name, T, P, OP, expr)
+MVLA__UNARY_KERNELS(MVLA__X)
+#undef MVLA__X
+#define MVLA__X(name, T, P, OP, expr) MVLA__TERNARY_KERNEL(AVX512, MVLA__TARGET_AVX512, name, T, P, OP, expr)
+MVLA__TERNARY_KERNELS(MVLA__X)
+#undef MVLA__X
+MVLA__DEFINE_TIER(AVX512, MVLA__TARGET_AVX512)
+#endif // MVLA__TIER_AVX512
+
+/*
+** Length kernels over interleaved vectors reduce across components, so they
+** can't use the flat view. Instead a few vectors are loaded at once and
+** transposed in registers into one register per component, giving one output
+** lane per vector. Shuffles dominate here, so the SSE2 forms serve every tier.
+*/
+
+#define MVLA__AOS_SQR_LEN_SCALAR(V, T)                                            \
+  static inline void mvla__##V##_sqr_len_SCALAR(const V##_t *a, T *out, size_t n, int root) { \
+    size_t i;                                                                     \
+    for (i = 0; i < n; ++i) {                                                     \
+      out[i] = root ? V##_len(a[i]) : V##_sqr_len(a[i]);                          \
+    }                                                                             \
+  }
+
+MVLA__AOS_SQR_LEN_SCALAR(v2f, float)
+MVLA__AOS_SQR_LEN_SCALAR(v3f, float)
+MVLA__AOS_SQR_LEN_SCALAR(v4f, float)
+MVLA__AOS_SQR_LEN_SCALAR(v2d, double)
+MVLA__AOS_SQR_LEN_SCALAR(v3d, double)
+MVLA__AOS_SQR_LEN_SCALAR(v4d, double)
+
+#ifdef MVLA_HAS_SSE2
+
+static inline void mvla__v2f_sqr_len_SSE2(const v2f_t *a, float *out, size_t n, int root) {
+  const float *p = (const float *) a;
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 x, y, s;
+    mvla__mm_deinterleave2_ps(_mm_loadu_ps(p + 2 * i), _mm_loadu_ps(p + 2 * i + 4), &x, &y);
+    s = _mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y));
+    _mm_storeu_ps(out + i, root ? _mm_sqrt_ps(s) : s);
+  }
+  mvla__v2f_sqr_len_SCALAR(a + i, out + i, n - i, root);
+}
+
+static inline void mvla__v3f_sqr_len_SSE2(const v3f_t *a, float *out, size_t n, int root) {
+  const float *p = (const float *) a;
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 x, y, z, s;
+    mvla__mm_deinterleave3_ps(_mm_loadu_ps(p + 3 * i), _mm_loadu_ps(p + 3 * i + 4),
+                              _mm_loadu_ps(p + 3 * i + 8), &x, &y, &z);
+    s = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+    _mm_storeu_ps(out + i, root ? _mm_sqrt_ps(s) : s);
+  }
+  mvla__v3f_sqr_len_SCALAR(a + i, out + i, n - i, root);
+}
+
+static inline void mvla__v4f_sqr_len_SSE2(const v4f_t *a, float *out, size_t n, int root) {
+  const float *p = (const float *) a;
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 x = _mm_loadu_ps(p + 4 * i);
+    __m128 y = _mm_loadu_ps(p + 4 * i + 4);
+    __m128 z = _mm_loadu_ps(p + 4 * i + 8);
+    __m128 w = _mm_loadu_ps(p + 4 * i + 12);
+    __m128 s;
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+    s = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)),
+                              _mm_mul_ps(z, z)), _mm_mul_ps(w, w));
+    _mm_storeu_ps(out + i, root ? _mm_sqrt_ps(s) : s);
+  }
+  mvla__v4f_sqr_len_SCALAR(a + i, out + i, n - i, root);
+}
+
+static inline void mvla__v2d_sqr_len_SSE2(const v2d_t *a, double *out, size_t n, int root) {
+  const double *p = (const double *) a;
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    __m128d m0 = _mm_loadu_pd(p + 2 * i);
+    __m128d m1 = _mm_loadu_pd(p + 2 * i + 2);
+    __m128d x = _mm_unpacklo_pd(m0, m1);
+    __m128d y = _mm_unpackhi_pd(m0, m1);
+    __m128d s = _mm_add_pd(_mm_mul_pd(x, x), _mm_mul_pd(y, y));
+    _mm_storeu_pd(out + i, root ? _mm_sqrt_pd(s) : s);
+  }
+  mvla__v2d_sqr_len_SCALAR(a + i, out + i, n - i, root);
+}
+
+static inline void mvla__v3d_sqr_len_SSE2(const v3d_t *a, double *out, size_t n, int root) {
+  const double *p = (const double *) a;
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    __m128d x, y, z, s;
+    mvla__mm_deinterleave3_pd(_mm_loadu_pd(p + 3 * i), _mm_loadu_pd(p + 3 * i + 2),
+                              _mm_loadu_pd(p + 3 * i + 4), &x, &y, &z);
+    s = _mm_add_pd(_mm_add_pd(_mm_mul_pd(x, x), _mm_mul_pd(y, y)), _mm_mul_pd(z, z));
+    _mm_storeu_pd(out + i, root ? _mm_sqrt_pd(s) : s);
+  }
+  mvla__v3d_sqr_len_SCALAR(a + i, out + i, n - i, root);
+}
+
+static inline void mvla__v4d_sqr_len_SSE2(const v4d_t *a, double *out, size_t n, int root) {
+  const double *p = (const double *) a;
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    __m128d m0 = _mm_loadu_pd(p + 4 * i);
+    __m128d m1 = _mm_loadu_pd(p + 4 * i + 2);
+    __m128d m2 = _mm_loadu_pd(p + 4 * i + 4);
+    __m128d m3 = _mm_loadu_pd(p + 4 * i + 6);
+    __m128d x = _mm_unpacklo_pd(m0, m2);
+    __m128d y = _mm_unpackhi_pd(m0, m2);
+    __m128d z = _mm_unpacklo_pd(m1, m3);
+    __m128d w = _mm_unpackhi_pd(m1, m3);
+    __m128d s = _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(x, x), _mm_mul_pd(y, y)),
+                                      _mm_mul_pd(z, z)), _mm_mul_pd(w, w));
+    _mm_storeu_pd(out + i, root ? _mm_sqrt_pd(s) : s);
+  }
+  mvla__v4d_sqr_len_SCALAR(a + i, out + i, n - i, root);
+}
+
+#endif // MVLA_HAS_SSE2
+
+#define MVLA__AOS_SQR_LEN_KERNELS(X)                            \
+  X(v2f, float)                                                 \
+  X(v3f, float)                                                 \
+  X(v4f, float)                                                 \
+  X(v2d, double)                                                \
+  X(v3d, double)                                                \
+  X(v4d, double)
+
+// -----------------------------------------
+
+/*
+** MEMORY
+**
+** mvla__aligned_alloc asks the current allocator for a little more than it
+** needs and keeps the allocator's free function and user pointer just below
+** the block it returns, so mvla__aligned_free never looks at the current one.
+*/
+
+typedef struct mvla__block {
+  void (*free)(void *user, void *ptr);
+  void *user;
+  void *raw;
+} mvla__block_t;
+
+static void *mvla__default_alloc(void *user, size_t size, size_t align) {
+#ifdef MVLA_ALIGNED_ALLOC
+  (void) user;
+  if (align == 0 || (align & (align - 1)) != 0) {
+    return NULL;
+  }
+  return MVLA_ALIGNED_ALLOC(size, align);
+#else
+  // over-allocates and stashes the malloc pointer just below the aligned block
+  void *raw;
+  void **aligned;
+  (void) user;
+  if (align == 0 || (align & (align - 1)) != 0 || size > (size_t) -1 - align - sizeof(void *)) {
+    return NULL;
+  }
+  raw = MVLA_MALLOC(size + align + sizeof(void *));
+  if (raw == NULL) {
+    return NULL;
+  }
+  aligned = (void **) (((size_t) raw + sizeof(void *) + align - 1) & ~(align - 1));
+  aligned[-1] = raw;
+  return aligned;
+#endif // MVLA_ALIGNED_ALLOC
+}
+
+static void mvla__default_free(void *user, void *ptr) {
+  (void) user;
+#ifdef MVLA_ALIGNED_ALLOC
+  MVLA_ALIGNED_FREE(ptr);
+#else
+  MVLA_FREE(((void **) ptr)[-1]);
+#endif // MVLA_ALIGNED_ALLOC
+}
+
+static mvla_allocator_t mvla__allocator = { mvla__default_alloc, mvla__default_free, NULL };
+
+MVLAIMPL void mvla_allocator_set(const mvla_allocator_t *allocator) {
+  if (allocator == NULL) {
+    mvla__allocator.alloc = mvla__default_alloc;
+    mvla__allocator.free = mvla__default_free;
+    mvla__allocator.user = NULL;
+  } else {
+    mvla__allocator = *allocator;
+  }
+}
+
+MVLAIMPL mvla_allocator_t mvla_allocator_get(void) {
+  return mvla__allocator;
+}
+
+static inline void *mvla__aligned_alloc(size_t size, size_t align) {
+  size_t pad;
+  unsigned char *raw;
+  mvla__block_t *block;
+  align = align < sizeof(void *) ? sizeof(void *) : align;
+  pad = (sizeof(mvla__block_t) + align - 1) & ~(align - 1);
+  if (size > (size_t) -1 - pad) {
+    return NULL;
+  }
+  raw = (unsigned char *) mvla__allocator.alloc(mvla__allocator.user, size + pad, align);
+  if (raw == NULL) {
+    return NULL;
+  }
+  block = (mvla__block_t *) (raw + pad) - 1;
+  block->free = mvla__allocator.free;
+  block->user = mvla__allocator.user;
+  block->raw = raw;
+  return raw + pad;
+}
+
+static inline void mvla__aligned_free(void *ptr) {
+  if (ptr != NULL) {
+    mvla__block_t *block = (mvla__block_t *) ptr - 1;
+    block->free(block->user, block->raw);
+  }
+}
+
+// mvla_arena_t
+
+MVLAIMPL mvla_arena_t mvla_arena_alloc(size_t size) {
+  mvla_arena_t arena;
+  arena.base = (unsigned char *) MVLA_MALLOC(size);
+  arena.size = arena.base == NULL ? 0 : size;
+  arena.used = 0;
+  arena.owned = 1;
+  return arena;
+}
+
+MVLAIMPL mvla_arena_t mvla_arena_wrap(void *buffer, size_t size) {
+  mvla_arena_t arena;
+  arena.base = (unsigned char *) buffer;
+  arena.size = size;
+  arena.used = 0;
+  arena.owned = 0;
+  return arena;
+}
+
+MVLAIMPL void mvla_arena_free(mvla_arena_t *arena) {
+  if (arena->owned && arena->base != NULL) {
+    MVLA_FREE(arena->base);
+  }
+  arena->base = NULL;
+  arena->size = 0;
+  arena->used = 0;
+}
+
+MVLAIMPL void *mvla_arena_push(mvla_arena_t *arena, size_t size, size_t align) {
+  size_t pad, room;
+  if (arena->base == NULL || align == 0 || (align & (align - 1)) != 0) {
+    return NULL;
+  }
+  pad = (0 - ((size_t) arena->base + arena->used)) & (align - 1);
+  room = arena->size - arena->used;
+  if (pad > room || size > room - pad) {
+    return NULL;
+  }
+  arena->used += pad + size;
+  return arena->base + arena->used - size;
+}
+
+MVLAIMPL size_t mvla_arena_mark(const mvla_arena_t *arena) {
+  return arena->used;
+}
+
+MVLAIMPL void mvla_arena_reset(mvla_arena_t *arena, size_t mark) {
+  arena->used = mark < arena->used ? mark : arena->used;
+}
+
+static void *mvla__arena_alloc(void *user, size_t size, size_t align) {
+  return mvla_arena_push((mvla_arena_t *) user, size, align);
+}
+
+static void mvla__arena_free(void *user, void *ptr) {
+  (void) user;
+  (void) ptr;
+}
+
+MVLAIMPL mvla_allocator_t mvla_arena_allocator(mvla_arena_t *arena) {
+  mvla_allocator_t allocator;
+  allocator.alloc = mvla__arena_alloc;
+  allocator.free = mvla__arena_free;
+  allocator.user = arena;
+  return allocator;
+}
+
+// mvla_buffer_t
+
+// maps size bytes 2MB aligned, 0 if no mapping of a backing up to best works
+static int mvla__buffer_map(mvla_buffer_t *buffer, size_t size, mvla_pages_t best) {
+#if defined(MVLA__MAP_ANON)
+  size_t huge = MVLA_HUGE_PAGE_SIZE, len, lead;
+  unsigned char *p;
+  if (size == 0 || size > (size_t) -1 - 2 * huge) {
+    return 0;
+  }
+  len = (size + huge - 1) & ~(huge - 1);
+#ifdef MAP_HUGETLB
+  if (best >= MVLA_PAGES_HUGE) {
+    p = (unsigned char *) mmap(NULL, len, PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MVLA__MAP_ANON | MAP_HUGETLB, -1, 0);
+    if (p != (unsigned char *) MAP_FAILED) {
+      buffer->data = p;
+      buffer->mapped = len;
+      buffer->pages = MVLA_PAGES_HUGE;
+      return 1;
+    }
+  }
+#endif // MAP_HUGETLB
+  if (best < MVLA_PAGES_SMALL) {
+    return 0;
+  }
+  // one extra huge page, trimmed so the buffer starts on a huge page boundary
+  p = (unsigned char *) mmap(NULL, len + huge, PROT_READ | PROT_WRITE, MAP_PRIVATE | MVLA__MAP_ANON,
+                             -1, 0);
+  if (p == (unsigned char *) MAP_FAILED) {
+    return 0;
+  }
+  lead = (((size_t) p + huge - 1) & ~(huge - 1)) - (size_t) p;
+  if (lead > 0) {
+    munmap(p, lead);
+  }
+  if (lead < huge) {
+    munmap(p + lead + len, huge - lead);
+  }
+  buffer->data = p + lead;
+  buffer->mapped = len;
+  buffer->pages = MVLA_PAGES_SMALL;
+#ifdef MADV_HUGEPAGE
+  if (best >= MVLA_PAGES_TRANSPARENT && madvise(buffer->data, len, MADV_HUGEPAGE) == 0) {
+    buffer->pages = MVLA_PAGES_TRANSPARENT;
+  }
+#endif // MADV_HUGEPAGE
+#ifdef MADV_NOHUGEPAGE
+  if (best == MVLA_PAGES_SMALL) {
+    madvise(buffer->data, len, MADV_NOHUGEPAGE);
+  }
+#endif // MADV_NOHUGEPAGE
+  return 1;
+#else
+  (void) buffer;
+  (void) size;
+  (void) best;
+  return 0;
+#endif // MVLA__MAP_ANON
+}
+
+static void mvla__buffer_unmap(void *data, size_t mapped) {
+#if defined(MVLA__MAP_ANON)
+  munmap(data, mapped);
+#else
+  (void) data;
+  (void) mapped;
+#endif // MVLA__MAP_ANON
+}
+
+MVLAIMPL mvla_buffer_t mvla_buffer_alloc(size_t size, mvla_pages_t best) {
+  mvla_buffer_t buffer;
+  buffer.data = NULL;
+  buffer.size = size;
+  buffer.mapped = 0;
+  buffer.pages = MVLA_PAGES_HEAP;
+  if (!mvla__buffer_map(&buffer, size, best)) {
+    buffer.data = size == 0 ? NULL : mvla__default_alloc(NULL, size, MVLA_SOA_ALIGN);
+    buffer.size = buffer.data == NULL ? 0 : size;
+  }
+  return buffer;
+}
+
+MVLAIMPL void mvla_buffer_free(mvla_buffer_t *buffer) {
+  if (buffer->data != NULL && buffer->pages == MVLA_PAGES_HEAP) {
+    mvla__default_free(NULL, buffer->data);
+  } else if (buffer->data != NULL) {
+    mvla__buffer_unmap(buffer->data, buffer->mapped);
+  }
+  buffer->data = NULL;
+  buffer->size = 0;
+  buffer->mapped = 0;
+  buffer->pages = MVLA_PAGES_HEAP;
+}
+
+MVLAIMPL size_t mvla_buffer_huge_bytes(const mvla_buffer_t *buffer) {
+  size_t total = 0;
+#if defined(__linux__)
+  size_t lo = (size_t) buffer->data, hi = lo + buffer->size, start = 0, end = 0;
+  char line[256];
+  FILE *smaps;
+  unsigned long a, b, kb;
+  if (buffer->data == NULL || buffer->pages == MVLA_PAGES_HUGE) {
+    return buffer->data == NULL ? 0 : buffer->mapped;
+  }
+  if ((smaps = fopen("/proc/self/smaps", "r")) == NULL) {
+    return 0;
+  }
+  // mapping headers are "start-end perms ...", AnonHugePages counts its 2MB pages
+  while (fgets(line, sizeof(line), smaps) != NULL) {
+    if (sscanf(line, "%lx-%lx ", &a, &b) == 2) {
+      start = (size_t) a;
+      end = (size_t) b;
+    } else if (start < hi && end > lo && sscanf(line, "AnonHugePages: %lu kB", &kb) == 1) {
+      total += (size_t) kb * 1024;
+    }
+  }
+  fclose(smaps);
+  total = total < buffer->size ? total : buffer->size;
+#else
+  if (buffer->data != NULL && buffer->pages == MVLA_PAGES_HUGE) {
+    total = buffer->mapped;
+  }
+#endif // __linux__
+  return total;
+}
+
+MVLAIMPL const char *mvla_pages_name(mvla_pages_t pages) {
+  switch (pages) {
+    case MVLA_PAGES_HEAP:        return "heap";
+    case MVLA_PAGES_SMALL:       return "small";
+    case MVLA_PAGES_TRANSPARENT: return "transparent";
+    case MVLA_PAGES_HUGE:        return "huge";
+  }
+  return "unknown";
+}
+
+// big blocks keep their mapping just below the pointer handed out, small
+// ones the default allocator's block with no mapping
+typedef struct mvla__pages_head {
+  void *raw;
+  size_t mapped;
+} mvla__pages_head_t;
+
+static const mvla_pages_t mvla__pages_best[] = {
+  MVLA_PAGES_HEAP, MVLA_PAGES_SMALL, MVLA_PAGES_TRANSPARENT, MVLA_PAGES_HUGE
+};
+
+static void *mvla__pages_alloc(void *user, size_t size, size_t align) {
+  size_t pad = (sizeof(mvla__pages_head_t) + align - 1) & ~(align - 1);
+  mvla_buffer_t buffer;
+  mvla__pages_head_t *head;
+  unsigned char *raw;
+  if (size > (size_t) -1 - pad) {
+    return NULL;
+  }
+  buffer.mapped = 0;
+  if (size >= MVLA_HUGE_PAGE_SIZE && align <= MVLA_HUGE_PAGE_SIZE &&
+      mvla__buffer_map(&buffer, size + pad, *(const mvla_pages_t *) user)) {
+    raw = (unsigned char *) buffer.data;
+  } else if ((raw = (unsigned char *) mvla__default_alloc(NULL, size + pad, align)) == NULL) {
+    return NULL;
+  }
+  head = (mvla__pages_head_t *) (raw + pad) - 1;
+  head->raw = raw;
+  head->mapped = buffer.mapped;
+  return raw + pad;
+}
+
+static void mvla__pages_free(void *user, void *ptr) {
+  mvla__pages_head_t *head = (mvla__pages_head_t *) ptr - 1;
+  (void) user;
+  if (head->mapped > 0) {
+    mvla__buffer_unmap(head->raw, head->mapped);
+  } else {
+    mvla__default_free(NULL, head->raw);
+  }
+}
+
+MVLAIMPL mvla_allocator_t mvla_pages_allocator(mvla_pages_t best) {
+  mvla_allocator_t allocator;
+  allocator.alloc = mvla__pages_alloc;
+  allocator.free = mvla__pages_free;
+  allocator.user = (void *) &mvla__pages_best[best <= MVLA_PAGES_HUGE ? best : MVLA_PAGES_HUGE];
+  return allocator;
+}
+
+// -----------------------------------------
+
+/*
+** FILES
+*/
+
+#define MVLA__FILE_ORDER 0x01020304u
+#define MVLA__FILE_VERSION 1u
+#define MVLA__FILE_OFFSET 4096u
+
+// the first bytes of a vector file, the rest of the first page is zero
+typedef struct mvla__file_header {
+  char magic[4];
+  uint32_t order, version, type, layout, align;
+  uint64_t count, stride, offset, checksum, reserved;
+} mvla__file_header_t;
+
+static size_t mvla__type_scalar(mvla_type_t type) {
+  switch ((unsigned) type & 0xff) {
+    case 1: case 2: case 3: return 4;
+    case 4:                 return 8;
+  }
+  return 0;
+}
+
+MVLAIMPL size_t mvla_type_components(mvla_type_t type) {
+  size_t components = (unsigned) type >> 8;
+  if (mvla__type_scalar(type) == 0 || (unsigned) type > 0xffff) {
+    return 0;
+  }
+  switch (components) {
+    case 1: case 2: case 3: case 4: case 9: case 16: return components;
+  }
+  return 0;
+}
+
+MVLAIMPL size_t mvla_type_size(mvla_type_t type) {
+  return mvla_type_components(type) * mvla__type_scalar(type);
+}
+
+MVLAIMPL const char *mvla_file_status_name(mvla_file_status_t status) {
+  switch (status) {
+    case MVLA_FILE_OK:           return "ok";
+    case MVLA_FILE_ERR_IO:       return "i/o error";
+    case MVLA_FILE_ERR_FORMAT:   return "not a vector file";
+    case MVLA_FILE_ERR_CHECKSUM: return "checksum mismatch";
+    case MVLA_FILE_ERR_MEMORY:   return "out of memory";
+    case MVLA_FILE_ERR_ARG:      return "invalid argument";
+  }
+  return "unknown";
+}
+
+// Fletcher's sums over 32-bit words: sum[0] adds the words, sum[1] the running sum[0]
+static void mvla__fletcher(uint64_t sum[2], const unsigned char *p, size_t bytes) {
+  uint64_t a = sum[0], b = sum[1];
+  uint32_t w[4];
+  size_t i, n = bytes / 4;
+  for (i = 0; i + 4 <= n; i += 4, p += 16) {
+    memcpy(w, p, 16);
+    b += 4 * a + 4 * (uint64_t) w[0] + 3 * (uint64_t) w[1] + 2 * (uint64_t) w[2] + w[3];
+    a += (uint64_t) w[0] + w[1] + w[2] + w[3];
+  }
+  for (; i < n; ++i, p += 4) {
+    memcpy(w, p, 4);
+    a += w[0];
+    b += a;
+  }
+  sum[0] = a;
+  sum[1] = b;
+}
+
+// the checksum of the payload from the sums of each component array (one for
+// AoS), with the zero padding between SoA arrays joined in
+static uint64_t mvla__file_checksum(uint64_t sum[][2], size_t arrays, uint64_t bytes,
+                                    uint64_t stride) {
+  uint64_t a = 0, b = 0, words = bytes / 4;
+  size_t c;
+  for (c = 0; c < arrays; ++c) {
+    b += words * a + sum[c][1];
+    a += sum[c][0];
+    if (c + 1 < arrays) {
+      b += (stride - bytes) / 4 * a;
+    }
+  }
+  return (b << 32) | (a & 0xffffffffu);
+}
+
+static int mvla__fseek(FILE *file, uint64_t pos) {
+#if defined(_WIN32)
+  return _fseeki64(file, (__int64) pos, SEEK_SET);
+#elif defined(MVLA__FSEEKO)
+  off_t at = (off_t) pos;
+  return (at < 0 || (uint64_t) at != pos) ? -1 : fseeko(file, at, SEEK_SET);
+#else
+  long at = (long) pos;
+  return (at < 0 || (uint64_t) at != pos) ? -1 : fseek(file, at, SEEK_SET);
+#endif // _WIN32
+}
+
+MVLAIMPL mvla_file_status_t mvla_writer_open(mvla_writer_t *writer, const char *path, mvla_type_t type,
+                                             mvla_layout_t layout, size_t count) {
+  unsigned char zero[MVLA__FILE_OFFSET];
+  size_t scalar = mvla__type_scalar(type);
+  memset(writer, 0, sizeof(*writer));
+  writer->type = type;
+  writer->layout = layout;
+  writer->count = layout == MVLA_LAYOUT_SOA ? count : 0;
+  if (mvla_type_components(type) == 0 || (layout != MVLA_LAYOUT_AOS && layout != MVLA_LAYOUT_SOA)) {
+    return writer->status = MVLA_FILE_ERR_ARG;
+  }
+  if (layout == MVLA_LAYOUT_SOA) {
+    if (count > ((size_t) -1 - MVLA_SOA_ALIGN) / scalar / mvla_type_components(type)) {
+      return writer->status = MVLA_FILE_ERR_MEMORY;
+    }
+    writer->stride = (count * scalar + MVLA_SOA_ALIGN - 1) & ~((size_t) MVLA_SOA_ALIGN - 1);
+  }
+  if ((writer->file = fopen(path, "wb")) == NULL) {
+    return writer->status = MVLA_FILE_ERR_IO;
+  }
+  // the header goes in last, once the count and checksum are known
+  memset(zero, 0, sizeof(zero));
+  if (fwrite(zero, 1, sizeof(zero), writer->file) != sizeof(zero)) {
+    writer->status = MVLA_FILE_ERR_IO;
+  }
+  return writer->status;
+}
+
+// appends n elements given as one pointer per component, step bytes apart
+static mvla_file_status_t mvla__writer_put(mvla_writer_t *writer, const unsigned char *const *src,
+                                           size_t step, size_t n) {
+  uint64_t chunk[512];
+  unsigned char *out = (unsigned char *) chunk;
+  size_t scalar = mvla__type_scalar(writer->type), components = mvla_type_components(writer->type);
+  size_t size = scalar * components, c, i, k, done, take;
+  if (writer->file == NULL || writer->status != MVLA_FILE_OK) {
+    return writer->file == NULL ? MVLA_FILE_ERR_ARG : writer->status;
+  }
+  if (writer->layout == MVLA_LAYOUT_AOS) {
+    for (c = 1; c < components && src[c] == src[0] + c * scalar; ++c) {}
+    if (c == components && step == size) {
+      // already whole elements back to back
+      if (fwrite(src[0], size, n, writer->file) != n) {
+        return writer->status = MVLA_FILE_ERR_IO;
+      }
+      mvla__fletcher(writer->sum[0], src[0], n * size);
+    }
+    for (done = 0; done < n && (c < components || step != size); done += take) {
+      take = n - done < sizeof(chunk) / size ? n - done : sizeof(chunk) / size;
+      for (i = 0; i < take; ++i) {
+        for (k = 0; k < components; ++k) {
+          memcpy(out + i * size + k * scalar, src[k] + (done + i) * step, scalar);
+        }
+      }
+      if (fwrite(out, size, take, writer->file) != take) {
+        return writer->status = MVLA_FILE_ERR_IO;
+      }
+      mvla__fletcher(writer->sum[0], out, take * size);
+    }
+    writer->written += n;
+    return MVLA_FILE_OK;
+  }
+  if (n > writer->count - writer->written) {
+    return writer->status = MVLA_FILE_ERR_ARG;
+  }
+  for (c = 0; c < components && n > 0; ++c) {
+    if (mvla__fseek(writer->file, MVLA__FILE_OFFSET + (uint64_t) c * writer->stride +
+                                      (uint64_t) writer->written * scalar) != 0) {
+      return writer->status = MVLA_FILE_ERR_IO;
+    }
+    if (step == scalar) {
+      if (fwrite(src[c], scalar, n, writer->file) != n) {
+        return writer->status = MVLA_FILE_ERR_IO;
+      }
+      mvla__fletcher(writer->sum[c], src[c], n * scalar);
+      continue;
+    }
+    for (done = 0; done < n; done += take) {
+      take = n - done < sizeof(chunk) / scalar ? n - done : sizeof(chunk) / scalar;
+      for (i = 0; i < take; ++i) {
+        memcpy(out + i * scalar, src[c] + (done + i) * step, scalar);
+      }
+      if (fwrite(out, scalar, take, writer->file) != take) {
+        return writer->status = MVLA_FILE_ERR_IO;
+      }
+      mvla__fletcher(writer->sum[c], out, take * scalar);
+    }
+  }
+  writer->written += n;
+  return MVLA_FILE_OK;
+}
+
+MVLAIMPL mvla_file_status_t mvla_writer_write(mvla_writer_t *writer, const void *elements, size_t n) {
+  const unsigned char *src[16];
+  size_t scalar = mvla__type_scalar(writer->type), components = mvla_type_components(writer->type);
+  size_t c;
+  for (c = 0; c < components; ++c) {
+    src[c] = (const unsigned char *) elements + c * scalar;
+  }
+  return mvla__writer_put(writer, src, scalar * components, n);
+}
+
+MVLAIMPL mvla_file_status_t mvla_writer_write_soa(mvla_writer_t *writer, const void *const *components, size_t n) {
+  const unsigned char *src[16];
+  size_t c;
+  for (c = 0; c < mvla_type_components(writer->type); ++c) {
+    src[c] = (const unsigned char *) components[c];
+  }
+  return mvla__writer_put(writer, src, mvla__type_scalar(writer->type), n);
+}
+
+MVLAIMPL mvla_file_status_t mvla_writer_close(mvla_writer_t *writer) {
+  mvla__file_header_t header;
+  size_t scalar = mvla__type_scalar(writer->type), components = mvla_type_components(writer->type);
+  mvla_file_status_t status = writer->status;
+  if (writer->file == NULL) {
+    return status == MVLA_FILE_OK ? MVLA_FILE_ERR_ARG : status;
+  }
+  if (status == MVLA_FILE_OK && writer->layout == MVLA_LAYOUT_SOA && writer->written != writer->count) {
+    status = MVLA_FILE_ERR_ARG;
+  }
+  if (status == MVLA_FILE_OK) {
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "MVLA", 4);
+    header.order = MVLA__FILE_ORDER;
+    header.version = MVLA__FILE_VERSION;
+    header.type = (uint32_t) writer->type;
+    header.layout = (uint32_t) writer->layout;
+    header.align = MVLA_SOA_ALIGN;
+    header.count = writer->written;
+    header.offset = MVLA__FILE_OFFSET;
+    if (writer->layout == MVLA_LAYOUT_AOS) {
+      header.stride = (uint64_t) writer->written * scalar * components;
+      header.checksum = mvla__file_checksum(writer->sum, 1, header.stride, header.stride);
+    } else {
+      header.stride = writer->stride;
+      header.checksum = mvla__file_checksum(writer->sum, components,
+                                            (uint64_t) writer->count * scalar, header.stride);
+    }
+    if (mvla__fseek(writer->file, 0) != 0 ||
+        fwrite(&header, sizeof(header), 1, writer->file) != 1) {
+      status = MVLA_FILE_ERR_IO;
+    }
+  }
+  if (fclose(writer->file) != 0 && status == MVLA_FILE_OK) {
+    status = MVLA_FILE_ERR_IO;
+  }
+  writer->file = NULL;
+  return writer->status = status;
+}
+
+// checks the header of a file loaded into base and points data at the payload
+static mvla_file_status_t mvla__file_check(mvla_file_t *file, int flags) {
+  mvla__file_header_t header;
+  uint64_t sum[16][2], bytes, room;
+  size_t scalar, components, c;
+  memcpy(&header, file->base, sizeof(header));
+  scalar = mvla__type_scalar((mvla_type_t) header.type);
+  components = mvla_type_components((mvla_type_t) header.type);
+  if (memcmp(header.magic, "MVLA", 4) != 0 || header.order != MVLA__FILE_ORDER ||
+      header.version != MVLA__FILE_VERSION || components == 0 ||
+      (header.layout != MVLA_LAYOUT_AOS && header.layout != MVLA_LAYOUT_SOA) ||
+      header.align == 0 || (header.align & (header.align - 1)) != 0 ||
+      header.offset < sizeof(header) || header.offset > file->size ||
+      header.offset % header.align != 0 || header.offset % 8 != 0) {
+    return MVLA_FILE_ERR_FORMAT;
+  }
+  // every term is held against the space left after the offset by division, so a
+  // crafted header cannot wrap the sum back inside the file
+  room = file->size - header.offset;
+  if (header.count > room / scalar) {
+    return MVLA_FILE_ERR_FORMAT;
+  }
+  bytes = header.count * scalar;
+  if (header.layout == MVLA_LAYOUT_AOS) {
+    if (bytes > room / components) {
+      return MVLA_FILE_ERR_FORMAT;
+    }
+    bytes *= components;
+    components = 1;
+    if (header.stride != bytes) {
+      return MVLA_FILE_ERR_FORMAT;
+    }
+  } else if (header.stride < bytes || header.stride % header.align != 0 ||
+             (header.stride != 0 && components - 1 > (room - bytes) / header.stride)) {
+    return MVLA_FILE_ERR_FORMAT;
+  }
+  file->data = (unsigned char *) file->base + header.offset;
+  file->type = (mvla_type_t) header.type;
+  file->layout = (mvla_layout_t) header.layout;
+  file->count = (size_t) header.count;
+  file->stride = (size_t) header.stride;
+  if (flags & MVLA_FILE_VERIFY) {
+    for (c = 0; c < components; ++c) {
+      sum[c][0] = 0;
+      sum[c][1] = 0;
+      mvla__fletcher(sum[c], (unsigned char *) file->data + c * file->stride, (size_t) bytes);
+    }
+    if (mvla__file_checksum(sum, components, bytes, header.stride) != header.checksum) {
+      return MVLA_FILE_ERR_CHECKSUM;
+    }
+  }
+  return MVLA_FILE_OK;
+}
+
+MVLAIMPL mvla_file_status_t mvla_file_open(mvla_file_t *file, const char *path, int flags) {
+  mvla_file_status_t status;
+#if defined(MVLA__MMAP)
+  struct stat st;
+  void *base;
+  int fd;
+  memset(file, 0, sizeof(*file));
+  if ((fd = open(path, O_RDONLY)) < 0) {
+    return MVLA_FILE_ERR_IO;
+  }
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    return MVLA_FILE_ERR_IO;
+  }
+  if ((uint64_t) st.st_size < sizeof(mvla__file_header_t) || (uint64_t) st.st_size > (size_t) -1) {
+    close(fd);
+    return (uint64_t) st.st_size > (size_t) -1 ? MVLA_FILE_ERR_MEMORY : MVLA_FILE_ERR_FORMAT;
+  }
+  // writable but private, so callers can use the arrays in place without touching the file
+  base = mmap(NULL, (size_t) st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED) {
+    return MVLA_FILE_ERR_IO;
+  }
+  file->base = base;
+  file->size = (size_t) st.st_size;
+  file->mapped = 1;
+#else
+  FILE *in;
+  long size;
+  memset(file, 0, sizeof(*file));
+  if ((in = fopen(path, "rb")) == NULL) {
+    return MVLA_FILE_ERR_IO;
+  }
+  if (fseek(in, 0, SEEK_END) != 0 || (size = ftell(in)) < 0 || fseek(in, 0, SEEK_SET) != 0) {
+    fclose(in);
+    return MVLA_FILE_ERR_IO;
+  }
+  if ((size_t) size < sizeof(mvla__file_header_t)) {
+    fclose(in);
+    return MVLA_FILE_ERR_FORMAT;
+  }
+  if ((file->base = mvla__aligned_alloc((size_t) size, MVLA__FILE_OFFSET)) == NULL) {
+    fclose(in);
+    return MVLA_FILE_ERR_MEMORY;
+  }
+  file->size = (size_t) size;
+  if (fread(file->base, 1, file->size, in) != file->size) {
+    fclose(in);
+    mvla_file_close(file);
+    return MVLA_FILE_ERR_IO;
+  }
+  fclose(in);
+#endif // MVLA__MMAP
+  if ((status = mvla__file_check(file, flags)) != MVLA_FILE_OK) {
+    mvla_file_close(file);
+  }
+  return status;
+}
+
+MVLAIMPL void *mvla_file_component(const mvla_file_t *file, size_t component) {
+  size_t scalar = mvla__type_scalar(file->type);
+  if (file->data == NULL || component >= mvla_type_components(file->type)) {
+    return NULL;
+  }
+  return (unsigned char *) file->data +
+         component * (file->layout == MVLA_LAYOUT_SOA ? file->stride : scalar);
+}
+
+MVLAIMPL void mvla_file_close(mvla_file_t *file) {
+#if defined(MVLA__MMAP)
+  if (file->base != NULL) {
+    munmap(file->base, file->size);
+  }
+#else
+  mvla__aligned_free(file->base);
+#endif // MVLA__MMAP
+  memset(file, 0, sizeof(*file));
+}
+
+// -----------------------------------------
+
+/*
+** TEXT
+**
+** Floats are formatted with Grisu3 (Loitsch 2010): the value and the edges of
+** the interval rounding to it are scaled by a cached power of ten into 64-bit
+** fixed point, and digits are generated until they land inside the interval.
+** For the few inputs Grisu3 can't decide (about 0.5%) the shortest %.*e
+** rendering that reads back is searched for instead. Parsing guesses the
+** double nearest m * 10^e in floating point and corrects the guess against
+** its neighbors' midpoints in 256-bit integers; floats are rounded from that
+** double unless it sits exactly on a float midpoint. Eight digits at a time
+** are checked and converted in one 64-bit word.
+*/
+
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || \
+    defined(_M_X64) || defined(_M_IX86) || defined(_M_ARM64)
+#define MVLA__LITTLE_ENDIAN
+#endif // __BYTE_ORDER__
+
+// longest formatted scalar plus its separator
+#define MVLA__TEXT_SCALAR 25
+
+typedef struct mvla__diy {
+  uint64_t f;
+  int e;
+} mvla__diy_t;
+
+// 10^k for k = -348, -340, ..., 340 as f * 2^e with f normalized
+static const uint64_t mvla__pow10_f[87] = {
+  0xfa8fd5a0081c0288ull, 0xbaaee17fa23ebf76ull, 0x8b16fb203055ac76ull,
+  0xcf42894a5dce35eaull, 0x9a6bb0aa55653b2dull, 0xe61acf033d1a45dfull,
+  0xab70fe17c79ac6caull, 0xff77b1fcbebcdc4full, 0xbe5691ef416bd60cull,
+  0x8dd01fad907ffc3cull, 0xd3515c2831559a83ull, 0x9d71ac8fada6c9b5ull,
+  0xea9c227723ee8bcbull, 0xaecc49914078536dull, 0x823c12795db6ce57ull,
+  0xc21094364dfb5637ull, 0x9096ea6f3848984full, 0xd77485cb25823ac7ull,
+  0xa086cfcd97bf97f4ull, 0xef340a98172aace5ull, 0xb23867fb2a35b28eull,
+  0x84c8d4dfd2c63f3bull, 0xc5dd44271ad3cdbaull, 0x936b9fcebb25c996ull,
+  0xdbac6c247d62a584ull, 0xa3ab66580d5fdaf6ull, 0xf3e2f893dec3f126ull,
+  0xb5b5ada8aaff80b8ull, 0x87625f056c7c4a8bull, 0xc9bcff6034c13053ull,
+  0x964e858c91ba2655ull, 0xdff9772470297ebdull, 0xa6dfbd9fb8e5b88full,
+  0xf8a95fcf88747d94ull, 0xb94470938fa89bcfull, 0x8a08f0f8bf0f156bull,
+  0xcdb02555653131b6ull, 0x993fe2c6d07b7facull, 0xe45c10c42a2b3b06ull,
+  0xaa242499697392d3ull, 0xfd87b5f28300ca0eull, 0xbce5086492111aebull,
+  0x8cbccc096f5088ccull, 0xd1b71758e219652cull, 0x9c40000000000000ull,
+  0xe8d4a51000000000ull, 0xad78ebc5ac620000ull, 0x813f3978f8940984ull,
+  0xc097ce7bc90715b3ull, 0x8f7e32ce7bea5c70ull, 0xd5d238a4abe98068ull,
+  0x9f4f2726179a2245ull, 0xed63a231d4c4fb27ull, 0xb0de65388cc8ada8ull,
+  0x83c7088e1aab65dbull, 0xc45d1df942711d9aull, 0x924d692ca61be758ull,
+  0xda01ee641a708deaull, 0xa26da3999aef774aull, 0xf209787bb47d6b85ull,
+  0xb454e4a179dd1877ull, 0x865b86925b9bc5c2ull, 0xc83553c5c8965d3dull,
+  0x952ab45cfa97a0b3ull, 0xde469fbd99a05fe3ull, 0xa59bc234db398c25ull,
+  0xf6c69a72a3989f5cull, 0xb7dcbf5354e9beceull, 0x88fcf317f22241e2ull,
+  0xcc20ce9bd35c78a5ull, 0x98165af37b2153dfull, 0xe2a0b5dc971f303aull,
+  0xa8d9d1535ce3b396ull, 0xfb9b7cd9a4a7443cull, 0xbb764c4ca7a44410ull,
+  0x8bab8eefb6409c1aull, 0xd01fef10a657842cull, 0x9b10a4e5e9913129ull,
+  0xe7109bfba19c0c9dull, 0xac2820d9623bf429ull, 0x80444b5e7aa7cf85ull,
+  0xbf21e44003acdd2dull, 0x8e679c2f5e44ff8full, 0xd433179d9c8cb841ull,
+  0x9e19db92b4e31ba9ull, 0xeb96bf6ebadf77d9ull, 0xaf87023b9bf0ee6bull
+};
+
+static const short mvla__pow10_e[87] = {
+  -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927,
+  -901, -874, -847, -821, -794, -768, -741, -715, -688, -661, -635, -608,
+  -582, -555, -529, -502, -475, -449, -422, -396, -369, -343, -316, -289,
+  -263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30,
+  56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+  375, 402, 428, 455, 481, 508, 534, 561, 588, 614, 641, 667,
+  694, 720, 747, 774, 800, 827, 853, 880, 907, 933, 960, 986,
+  1013, 1039, 1066
+};
+
+static const double mvla__pow10_d[28] = {
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11, 1e12, 1e13,
+  1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22, 1e23, 1e24, 1e25, 1e26, 1e27
+};
+
+static mvla__diy_t mvla__diy_norm(mvla__diy_t x) {
+  while (!(x.f >> 63)) {
+    x.f <<= 1;
+    x.e--;
+  }
+  return x;
+}
+
+// the upper 64 bits of the product, rounded
+static mvla__diy_t mvla__diy_mul(mvla__diy_t x, mvla__diy_t y) {
+  uint64_t a = x.f >> 32, b = x.f & 0xffffffffu, c = y.f >> 32, d = y.f & 0xffffffffu;
+  uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+  uint64_t mid = (bd >> 32) + (ad & 0xffffffffu) + (bc & 0xffffffffu) + ((uint64_t) 1 << 31);
+  mvla__diy_t r;
+  r.f = ac + (ad >> 32) + (bc >> 32) + (mid >> 32);
+  r.e = x.e + y.e + 64;
+  return r;
+}
+
+// moves the last digit towards w while it stays safely inside the interval,
+// 0 when the digits can't be proven closest
+static int mvla__grisu_weed(char *buf, int len, uint64_t dist, uint64_t delta, uint64_t rest,
+                            uint64_t ten_kappa, uint64_t unit) {
+  uint64_t small = dist - unit, big = dist + unit;
+  while (rest < small && delta - rest >= ten_kappa &&
+         (rest + ten_kappa < small || small - rest >= rest + ten_kappa - small)) {
+    buf[len - 1]--;
+    rest += ten_kappa;
+  }
+  if (rest < big && delta - rest >= ten_kappa &&
+      (rest + ten_kappa < big || big - rest > rest + ten_kappa - big)) {
+    return 0;
+  }
+  return 2 * unit <= rest && rest <= delta - 4 * unit;
+}
+
+static int mvla__grisu_digits(mvla__diy_t low, mvla__diy_t w, mvla__diy_t high, char *buf, int *len,
+                              int *kappa) {
+  static const uint32_t powers[10] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+  };
+  uint64_t unit = 1, too_high = high.f + unit, delta = too_high - (low.f - unit);
+  uint64_t one = (uint64_t) 1 << -w.e, fractionals = too_high & (one - 1), rest;
+  uint32_t integrals = (uint32_t) (too_high >> -w.e), digit, x;
+  char low_first[10];
+  // the integral digits by constant divisions, lowest first
+  for (*kappa = 0, x = integrals; x > 0; x /= 10) {
+    low_first[(*kappa)++] = (char) (x % 10);
+  }
+  *len = 0;
+  while (*kappa > 0) {
+    digit = (uint32_t) low_first[--*kappa];
+    buf[(*len)++] = (char) ('0' + digit);
+    integrals -= digit * powers[*kappa];
+    rest = ((uint64_t) integrals << -w.e) + fractionals;
+    if (rest < delta) {
+      return mvla__grisu_weed(buf, *len, too_high - w.f, delta, rest, (uint64_t) powers[*kappa] << -w.e,
+                              unit);
+    }
+  }
+  for (;;) {
+    fractionals *= 10;
+    unit *= 10;
+    delta *= 10;
+    buf[(*len)++] = (char) ('0' + (fractionals >> -w.e));
+    fractionals &= one - 1;
+    --*kappa;
+    if (fractionals < delta) {
+      return mvla__grisu_weed(buf, *len, (too_high - w.f) * unit, delta, fractionals, one, unit);
+    }
+  }
+}
+
+// shortest digits of f * 2^e, 0 if Grisu3 can't tell
+static int mvla__grisu3(uint64_t f, int e, int lower_closer, char *buf, int *len, int *exp10) {
+  mvla__diy_t w, plus, minus, ten;
+  int k, index, kappa, ok;
+  w.f = f;
+  w.e = e;
+  plus.f = (f << 1) + 1;
+  plus.e = e - 1;
+  minus.f = lower_closer ? (f << 2) - 1 : (f << 1) - 1;
+  minus.e = lower_closer ? e - 2 : e - 1;
+  w = mvla__diy_norm(w);
+  plus = mvla__diy_norm(plus);
+  minus.f <<= minus.e - plus.e;
+  minus.e = plus.e;
+  // a cached power putting the scaled exponent in [-60, -32]
+  k = (int) ceil((-60 - (w.e + 64) + 63) * 0.30102999566398114);
+  index = (348 + k - 1) / 8 + 1;
+  ten.f = mvla__pow10_f[index];
+  ten.e = mvla__pow10_e[index];
+  ok = mvla__grisu_digits(mvla__diy_mul(minus, ten), mvla__diy_mul(w, ten), mvla__diy_mul(plus, ten),
+                          buf, len, &kappa);
+  *exp10 = kappa - (index * 8 - 348);
+  return ok;
+}
+
+// a little-endian 256-bit integer, for comparing decimals with binary midpoints
+typedef struct mvla__big {
+  uint32_t w[8];
+} mvla__big_t;
+
+static void mvla__big_set(mvla__big_t *a, uint64_t v) {
+  memset(a, 0, sizeof(*a));
+  a->w[0] = (uint32_t) v;
+  a->w[1] = (uint32_t) (v >> 32);
+}
+
+static void mvla__big_mul(mvla__big_t *a, uint32_t m) {
+  uint64_t carry = 0;
+  int i;
+  for (i = 0; i < 8; ++i) {
+    carry += (uint64_t) a->w[i] * m;
+    a->w[i] = (uint32_t) carry;
+    carry >>= 32;
+  }
+}
+
+static void mvla__big_pow5(mvla__big_t *a, int q) {
+  uint32_t m = 1;
+  for (; q >= 13; q -= 13) {
+    mvla__big_mul(a, 1220703125u);
+  }
+  while (q-- > 0) {
+    m *= 5;
+  }
+  mvla__big_mul(a, m);
+}
+
+static void mvla__big_shl(mvla__big_t *a, int s) {
+  int words = s / 32, bits = s % 32, i;
+  for (i = 7; i >= 0; --i) {
+    uint32_t hi = i - words >= 0 ? a->w[i - words] : 0;
+    uint32_t lo = i - words - 1 >= 0 ? a->w[i - words - 1] : 0;
+    a->w[i] = bits ? (hi << bits) | (lo >> (32 - bits)) : hi;
+  }
+}
+
+// compares m * 10^e with n * 2^k, for values within a few ulps of each other
+static int mvla__big_cmp(uint64_t m, int e, uint64_t n, int k) {
+  mvla__big_t a, b;
+  int i;
+  mvla__big_set(&a, m);
+  mvla__big_set(&b, n);
+  if (e >= 0) {
+    mvla__big_pow5(&a, e);
+    k -= e;
+  } else {
+    mvla__big_pow5(&b, -e);
+    k -= e;
+  }
+  if (k > 128 || k < -128) {
+    return k > 0 ? -1 : 1;
+  }
+  mvla__big_shl(k >= 0 ? &b : &a, k >= 0 ? k : -k);
+  for (i = 7; i >= 0; --i) {
+    if (a.w[i] != b.w[i]) {
+      return a.w[i] < b.w[i] ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+// the double nearest m * 10^e, 0 if e is too far out to do exactly here
+static int mvla__decimal_d(uint64_t m, int e, double *out) {
+  uint64_t n;
+  double d;
+  int ex, k, c;
+  if (m == 0) {
+    *out = 0.0;
+    return 1;
+  }
+  if (m <= (uint64_t) 1 << 53 && e >= -22 && e <= 22) {
+    // both exact, so one rounding
+    *out = e >= 0 ? (double) m * mvla__pow10_d[e] : (double) m / mvla__pow10_d[-e];
+    return 1;
+  }
+  if (e < -27 || e > 27) {
+    return 0;
+  }
+  d = e >= 0 ? (double) m * mvla__pow10_d[e] : (double) m / mvla__pow10_d[-e];
+  for (;;) {
+    n = (uint64_t) ldexp(frexp(d, &ex), 53);
+    k = ex - 53;
+    c = mvla__big_cmp(m, e, 2 * n + 1, k - 1);
+    if (c > 0 || (c == 0 && (n & 1))) {
+      d = nextafter(d, HUGE_VAL);
+      continue;
+    }
+    c = n == (uint64_t) 1 << 52 ? mvla__big_cmp(m, e, 4 * n - 1, k - 2)
+                                : mvla__big_cmp(m, e, 2 * n - 1, k - 1);
+    if (c < 0 || (c == 0 && (n & 1))) {
+      d = nextafter(d, 0.0);
+      continue;
+    }
+    *out = d;
+    return 1;
+  }
+}
+
+// the float nearest m * 10^e, rounded from the nearest double unless that
+// lands exactly between two floats
+static int mvla__decimal_f(uint64_t m, int e, float *out) {
+  uint64_t bits;
+  double d;
+  if (!mvla__decimal_d(m, e, &d) || d > FLT_MAX) {
+    return 0;
+  }
+  memcpy(&bits, &d, sizeof(bits));
+  if (d != 0.0 && (bits & 0x1fffffff) == 0x10000000) {
+    return 0;
+  }
+  *out = (float) d;
+  return 1;
+}
+
+// the shortest %.*e rendering that reads back, for what Grisu3 gives up on
+static void mvla__shortest_slow(double a, int single, char *buf, int *len, int *exp10) {
+  char tmp[40];
+  uint64_t m;
+  int digits, i, e;
+  double d;
+  float f;
+  for (digits = 1; digits <= 17; ++digits) {
+    snprintf(tmp, sizeof(tmp), "%.*e", digits - 1, a);
+    for (i = 0, *len = 0, m = 0; tmp[i] != 'e' && tmp[i] != '\0'; ++i) {
+      if (tmp[i] >= '0' && tmp[i] <= '9') {
+        buf[(*len)++] = tmp[i];
+        m = m * 10 + (uint64_t) (tmp[i] - '0');
+      }
+    }
+    e = atoi(tmp + i + 1) - (*len - 1);
+    if (single ? (mvla__decimal_f(m, e, &f) ? f == (float) a
+                                            : strtof(tmp, NULL) == (float) a)
+               : (mvla__decimal_d(m, e, &d) ? d == a : strtod(tmp, NULL) == a)) {
+      break;
+    }
+  }
+  while (*len > 1 && buf[*len - 1] == '0') {
+    --*len;
+    ++e;
+  }
+  *exp10 = e;
+}
+
+// writes digits * 10^exp10 plainly or with an exponent, like Python's repr
+static size_t mvla__format_digits(char *out, int negative, const char *digits, int len, int exp10) {
+  int point = len + exp10, i, e;
+  size_t n = 0;
+  if (negative) {
+    out[n++] = '-';
+  }
+  if (point > 0 && point <= 16) {
+    for (i = 0; i < len || i < point; ++i) {
+      if (i == point) {
+        out[n++] = '.';
+      }
+      out[n++] = i < len ? digits[i] : '0';
+    }
+  } else if (point > -4 && point <= 0) {
+    out[n++] = '0';
+    out[n++] = '.';
+    for (i = point; i < 0; ++i) {
+      out[n++] = '0';
+    }
+    for (i = 0; i < len; ++i) {
+      out[n++] = digits[i];
+    }
+  } else {
+    out[n++] = digits[0];
+    if (len > 1) {
+      out[n++] = '.';
+    }
+    for (i = 1; i < len; ++i) {
+      out[n++] = digits[i];
+    }
+    out[n++] = 'e';
+    e = point - 1;
+    if (e < 0) {
+      out[n++] = '-';
+      e = -e;
+    }
+    if (e >= 100) {
+      out[n++] = (char) ('0' + e / 100);
+    }
+    if (e >= 10) {
+      out[n++] = (char) ('0' + e / 10 % 10);
+    }
+    out[n++] = (char) ('0' + e % 10);
+  }
+  return n;
+}
+
+static size_t mvla__format_real(char *out, double a, int single) {
+  char digits[24];
+  uint64_t bits, f;
+  int len, exp10, biased, e, negative;
+  if (a != a) {
+    memcpy(out, "nan", 3);
+    return 3;
+  }
+  negative = signbit(a) != 0;
+  if (a == 0.0 || a == HUGE_VAL || a == -HUGE_VAL) {
+    if (negative) {
+      *out++ = '-';
+    }
+    memcpy(out, a == 0.0 ? "0" : "inf", a == 0.0 ? 1 : 3);
+    return (size_t) negative + (a == 0.0 ? 1 : 3);
+  }
+  if (single) {
+    float v = (float) a;
+    uint32_t b;
+    memcpy(&b, &v, sizeof(b));
+    biased = (int) (b >> 23 & 0xff);
+    f = b & 0x7fffff;
+    e = biased ? biased - 150 : -149;
+    bits = f;
+    f |= biased ? (uint64_t) 1 << 23 : 0;
+  } else {
+    memcpy(&bits, &a, sizeof(bits));
+    biased = (int) (bits >> 52 & 0x7ff);
+    bits &= ((uint64_t) 1 << 52) - 1;
+    f = bits | (biased ? (uint64_t) 1 << 52 : 0);
+    e = biased ? biased - 1075 : -1074;
+  }
+  if (!mvla__grisu3(f, e, bits == 0 && biased > 1, digits, &len, &exp10)) {
+    mvla__shortest_slow(negative ? -a : a, single, digits, &len, &exp10);
+  }
+  return mvla__format_digits(out, negative, digits, len, exp10);
+}
+
+static size_t mvla__format_uint(char *out, int negative, uint32_t a) {
+  char tmp[10];
+  size_t n = 0, len = 0;
+  if (negative) {
+    out[n++] = '-';
+  }
+  do {
+    tmp[len++] = (char) ('0' + a % 10);
+    a /= 10;
+  } while (a > 0);
+  while (len > 0) {
+    out[n++] = tmp[--len];
+  }
+  return n;
+}
+
+// one scalar of the given kind (the low byte of an mvla_type_t)
+static size_t mvla__format_scalar(char *out, unsigned kind, const unsigned char *src) {
+  int32_t i;
+  uint32_t u;
+  float f;
+  double d;
+  switch (kind) {
+    case 1:
+      memcpy(&i, src, sizeof(i));
+      return mvla__format_uint(out, i < 0, i < 0 ? 0u - (uint32_t) i : (uint32_t) i);
+    case 2:
+      memcpy(&u, src, sizeof(u));
+      return mvla__format_uint(out, 0, u);
+    case 3:
+      memcpy(&f, src, sizeof(f));
+      return mvla__format_real(out, f, 1);
+    default:
+      memcpy(&d, src, sizeof(d));
+      return mvla__format_real(out, d, 0);
+  }
+}
+
+static size_t mvla__format_row(char *out, mvla_type_t type, const void *a, const char *sep,
+                               size_t sep_len) {
+  const unsigned char *src = (const unsigned char *) a;
+  size_t scalar = mvla__type_scalar(type), components = mvla_type_components(type), n = 0, c;
+  for (c = 0; c < components; ++c) {
+    if (c > 0) {
+      memcpy(out + n, sep, sep_len);
+      n += sep_len;
+    }
+    n += mvla__format_scalar(out + n, (unsigned) type & 0xff, src + c * scalar);
+  }
+  return n;
+}
+
+static size_t mvla__format_vec(char *buf, const char *name, mvla_type_t type, const void *a) {
+  size_t n = strlen(name);
+  memcpy(buf, name, n);
+  n += mvla__format_row(buf + n, type, a, ", ", 2);
+  buf[n++] = ')';
+  buf[n] = '\0';
+  return n;
+}
+
+MVLAIMPL size_t v2i_format(v2i_t a, char *buf) {
+  return mvla__format_vec(buf, "v2i_t(", MVLA_TYPE_V2I, &a);
+}
+
+MVLAIMPL size_t v2u_format(v2u_t a, char *buf) {
+  return mvla__format_vec(buf, "v2u_t(", MVLA_TYPE_V2U, &a);
+}
+
+MVLAIMPL size_t v2f_format(v2f_t a, char *buf) {
+  return mvla__format_vec(buf, "v2f_t(", MVLA_TYPE_V2F, &a);
+}
+
+MVLAIMPL size_t v2d_format(v2d_t a, char *buf) {
+  return mvla__format_vec(buf, "v2d_t(", MVLA_TYPE_V2D, &a);
+}
+
+MVLAIMPL size_t v3i_format(v3i_t a, char *buf) {
+  return mvla__format_vec(buf, "v3i_t(", MVLA_TYPE_V3I, &a);
+}
+
+MVLAIMPL size_t v3u_format(v3u_t a, char *buf) {
+  return mvla__format_vec(buf, "v3u_t(", MVLA_TYPE_V3U, &a);
+}
+
+MVLAIMPL size_t v3f_format(v3f_t a, char *buf) {
+  return mvla__format_vec(buf, "v3f_t(", MVLA_TYPE_V3F, &a);
+}
+
+MVLAIMPL size_t v3d_format(v3d_t a, char *buf) {
+  return mvla__format_vec(buf, "v3d_t(", MVLA_TYPE_V3D, &a);
+}
+
+MVLAIMPL size_t v4i_format(v4i_t a, char *buf) {
+  return mvla__format_vec(buf, "v4i_t(", MVLA_TYPE_V4I, &a);
+}
+
+MVLAIMPL size_t v4u_format(v4u_t a, char *buf) {
+  return mvla__format_vec(buf, "v4u_t(", MVLA_TYPE_V4U, &a);
+}
+
+MVLAIMPL size_t v4f_format(v4f_t a, char *buf) {
+  return mvla__format_vec(buf, "v4f_t(", MVLA_TYPE_V4F, &a);
+}
+
+MVLAIMPL size_t v4d_format(v4d_t a, char *buf) {
+  return mvla__format_vec(buf, "v4d_t(", MVLA_TYPE_V4D, &a);
+}
+
+MVLAIMPL size_t mvla_formatf(float a, char *buf) {
+  size_t n = mvla__format_real(buf, a, 1);
+  buf[n] = '\0';
+  return n;
+}
+
+MVLAIMPL size_t mvla_formatd(double a, char *buf) {
+  size_t n = mvla__format_real(buf, a, 0);
+  buf[n] = '\0';
+  return n;
+}
+
+MVLAIMPL size_t mvla_format_n(mvla_type_t type, const void *a, size_t n, char *buf, size_t cap,
+                              size_t *len) {
+  size_t size = mvla_type_size(type), line = mvla_type_components(type) * MVLA__TEXT_SCALAR + 1;
+  size_t pos = 0, i;
+  for (i = 0; size > 0 && i < n && cap - pos >= line; ++i) {
+    pos += mvla__format_row(buf + pos, type, (const unsigned char *) a + i * size, ",", 1);
+    buf[pos++] = '\n';
+  }
+  *len = pos;
+  return i;
+}
+
+static int mvla__is_sep(char c) {
+  return c == ',' || c == ' ' || c == '\t' || c == ';' || c == '\r';
+}
+
+static int mvla__is_digit(char c) {
+  return (unsigned) (c - '0') < 10;
+}
+
+// 8 digits at p as one number, 0 if they aren't all digits
+static int mvla__digits8(const char *p, uint32_t *value) {
+#if defined(MVLA__LITTLE_ENDIAN)
+  uint64_t v;
+  memcpy(&v, p, sizeof(v));
+  if (((v & 0xf0f0f0f0f0f0f0f0u) | (((v + 0x0606060606060606u) & 0xf0f0f0f0f0f0f0f0u) >> 4)) !=
+      0x3333333333333333u) {
+    return 0;
+  }
+  v -= 0x3030303030303030u;
+  v = v * 10 + (v >> 8);
+  v = ((v & 0x000000ff000000ffu) * (100 + ((uint64_t) 1000000 << 32)) +
+       ((v >> 16 & 0x000000ff000000ffu) * (1 + ((uint64_t) 10000 << 32)))) >> 32;
+  *value = (uint32_t) v;
+  return 1;
+#else
+  (void) p;
+  (void) value;
+  return 0;
+#endif // MVLA__LITTLE_ENDIAN
+}
+
+// hands a token the fast path can't do exactly to strtod, in the C notation
+// whatever the locale
+static const char *mvla__parse_slow(const char *p, const char *end, int single, void *out) {
+  char tmp[128], point = localeconv()->decimal_point[0], *stop;
+  size_t n = 0;
+  float f;
+  double d;
+  for (; p + n < end && !mvla__is_sep(p[n]) && p[n] != '\n'; ++n) {
+    if (n + 1 >= sizeof(tmp)) {
+      return NULL;
+    }
+    tmp[n] = p[n] == '.' ? point : p[n];
+  }
+  tmp[n] = '\0';
+  if (single) {
+    f = strtof(tmp, &stop);
+    memcpy(out, &f, sizeof(f));
+  } else {
+    d = strtod(tmp, &stop);
+    memcpy(out, &d, sizeof(d));
+  }
+  return n > 0 && stop == tmp + n ? p + n : NULL;
+}
+
+static const char *mvla__parse_real(const char *p, const char *end, int single, void *out) {
+  const char *start = p;
+  uint64_t m = 0;
+  uint32_t eight;
+  int negative = 0, digits = 0, any = 0, more = 0, e = 0, exponent = 0, exp_negative = 0, point;
+  double d;
+  float f;
+  if (p < end && (*p == '-' || *p == '+')) {
+    negative = *p++ == '-';
+  }
+  for (point = 0; point < 2; ++point) {
+    if (point && (p == end || *p != '.')) {
+      break;
+    }
+    p += point;
+    while (end - p >= 8 && digits <= 11 && mvla__digits8(p, &eight)) {
+      m = m * 100000000 + eight;
+      digits += 8;
+      e -= point * 8;
+      any = 1;
+      p += 8;
+    }
+    for (; p < end && mvla__is_digit(*p); ++p) {
+      any = 1;
+      if (digits < 19) {
+        m = m * 10 + (uint64_t) (*p - '0');
+        digits += m != 0;
+        e -= point;
+      } else {
+        more = 1;
+        e += !point;
+      }
+    }
+  }
+  if (any && p < end && (*p == 'e' || *p == 'E')) {
+    if (++p < end && (*p == '-' || *p == '+')) {
+      exp_negative = *p++ == '-';
+    }
+    if (p == end || !mvla__is_digit(*p)) {
+      return NULL;
+    }
+    for (; p < end && mvla__is_digit(*p); ++p) {
+      exponent = exponent < 100000 ? exponent * 10 + (*p - '0') : exponent;
+    }
+    e += exp_negative ? -exponent : exponent;
+  }
+  // long mantissas, far exponents, float ties and words like nan and inf
+  if (!any || more) {
+    return mvla__parse_slow(start, end, single, out);
+  }
+  if (single) {
+    if (!mvla__decimal_f(m, e, &f)) {
+      return mvla__parse_slow(start, end, single, out);
+    }
+    f = negative ? -f : f;
+    memcpy(out, &f, sizeof(f));
+  } else {
+    if (!mvla__decimal_d(m, e, &d)) {
+      return mvla__parse_slow(start, end, single, out);
+    }
+    d = negative ? -d : d;
+    memcpy(out, &d, sizeof(d));
+  }
+  return p;
+}
+
+static const char *mvla__parse_int(const char *p, const char *end, int is_signed, void *out) {
+  uint64_t v = 0, limit = is_signed ? (uint64_t) 1 << 31 : 0xffffffffu;
+  uint32_t u;
+  int negative = 0, digits = 0;
+  if (p < end && (*p == '-' || *p == '+')) {
+    negative = *p++ == '-';
+  }
+  for (; p < end && mvla__is_digit(*p); ++p, ++digits) {
+    v = v < ((uint64_t) 1 << 33) ? v * 10 + (uint64_t) (*p - '0') : v;
+  }
+  if (digits == 0 || v > limit - (is_signed && !negative) || (negative && !is_signed && v != 0)) {
+    return NULL;
+  }
+  u = negative ? 0u - (uint32_t) v : (uint32_t) v;
+  memcpy(out, &u, sizeof(u));
+  return p;
+}
+
+MVLAIMPL size_t mvla_parse_n(mvla_type_t type, const char *text, size_t len, void *out, size_t n,
+                             size_t *used) {
+  const char *p = text, *end = text + len, *line;
+  unsigned char *dst = (unsigned char *) out;
+  size_t scalar = mvla__type_scalar(type), components = mvla_type_components(type), count = 0, c;
+  unsigned kind = (unsigned) type & 0xff;
+  while (components > 0 && count < n) {
+    for (line = p; p < end && mvla__is_sep(*p); ++p) {}
+    if (p < end && *p == '\n') {
+      ++p;
+      continue;
+    }
+    if (p == end) {
+      break;
+    }
+    for (c = 0; c < components && p != NULL; ++c) {
+      if (c > 0 && (p == end || !mvla__is_sep(*p))) {
+        p = NULL;
+        break;
+      }
+      for (; p < end && mvla__is_sep(*p); ++p) {}
+      p = kind >= 3 ? mvla__parse_real(p, end, kind == 3, dst + c * scalar)
+                    : mvla__parse_int(p, end, kind == 1, dst + c * scalar);
+    }
+    for (; p != NULL && p < end && mvla__is_sep(*p); ++p) {}
+    if (p == NULL || (p < end && *p != '\n')) {
+      p = line;
+      break;
+    }
+    p += p < end;
+    dst += scalar * components;
+    ++count;
+  }
+  *used = (size_t) (p - text);
+  return count;
+}
+
+static mvla_file_status_t mvla__dump(mvla_type_t type, const void *a, size_t n,
+                                     int (*put)(void *ctx, const char *buf, size_t len), void *ctx) {
+  size_t size = mvla_type_size(type), line = mvla_type_components(type) * MVLA__TEXT_SCALAR + 1;
+  size_t cap, done, k, len;
+  char *buf;
+  if (size == 0) {
+    return MVLA_FILE_ERR_ARG;
+  }
+  // the whole dump in one buffer when it fits in a chunk, whole lines of a chunk otherwise
+  cap = n < MVLA_DUMP_CHUNK / line ? n * line : MVLA_DUMP_CHUNK / line * line;
+  cap = cap > line ? cap : line;
+  if ((buf = (char *) mvla__aligned_alloc(cap, MVLA_SOA_ALIGN)) == NULL) {
+    return MVLA_FILE_ERR_MEMORY;
+  }
+  for (done = 0; done < n; done += k) {
+    k = mvla_format_n(type, (const unsigned char *) a + done * size, n - done, buf, cap, &len);
+    if (!put(ctx, buf, len)) {
+      mvla__aligned_free(buf);
+      return MVLA_FILE_ERR_IO;
+    }
+  }
+  mvla__aligned_free(buf);
+  return MVLA_FILE_OK;
+}
+
+static int mvla__dump_file(void *ctx, const char *buf, size_t len) {
+  return fwrite(buf, 1, len, (FILE *) ctx) == len;
+}
+
+MVLAIMPL mvla_file_status_t mvla_dump_n(mvla_type_t type, const void *a, size_t n, FILE *file) {
+  return mvla__dump(type, a, n, mvla__dump_file, file);
+}
+
+#if defined(MVLA__MMAP)
+static int mvla__dump_fd(void *ctx, const char *buf, size_t len) {
+  ssize_t wrote;
+  while (len > 0) {
+    if ((wrote = write(*(int *) ctx, buf, len)) < 0 && errno != EINTR) {
+      return 0;
+    }
+    buf += wrote > 0 ? (size_t) wrote : 0;
+    len -= wrote > 0 ? (size_t) wrote : 0;
+  }
+  return 1;
+}
+
+MVLAIMPL mvla_file_status_t mvla_dump_fd(mvla_type_t type, const void *a, size_t n, int fd) {
+  return mvla__dump(type, a, n, mvla__dump_fd, &fd);
+}
+#endif // MVLA__MMAP
+
+// -----------------------------------------
+
+/*
+** THREADING
+**
+** The pool keeps mvla_threads_get() - 1 workers, each with a deque of tasks;
+** deque 0 belongs to every thread outside the pool. A task is a range of one
+** loop. Whoever takes a task halves it on grain boundaries, pushing the upper
+** halves onto its own deque, until it's under two grains, then runs it. Owners
+** pop their newest task (the smallest, hot in cache) and thieves take the
+** oldest (the largest). A thread waiting on its loop takes tasks like a
+** worker and sleeps with them when there are none; the last range of a loop
+** wakes everyone. The deques are short and locked, loops are split
+** coarsely enough that the locks never show. A full deque just stops the
+** splitting, so nothing here can fail once the pool is up; without a pool
+** loops run inline.
+*/
+
+// ranges at least this many elements long per task in the batch functions
+#define MVLA__GRAIN (((size_t) MVLA_PARALLEL_GRAIN + 63) & ~(size_t) 63)
+
+static int mvla__threads = 0;
+static mvla_executor_t mvla__executor = { NULL, NULL };
+
+#ifdef MVLA_THREADS
+
+#define MVLA__DEQUE_CAP 256
+
+typedef struct mvla__pool_job {
+  mvla_range_fn_t fn;
+  void *ctx;
+  size_t grain, remaining;
+} mvla__pool_job_t;
+
+typedef struct mvla__task {
+  mvla__pool_job_t *job;
+  size_t begin, end;
+} mvla__task_t;
+
+typedef struct mvla__deque {
+  pthread_mutex_t lock;
+  size_t head, tail; // the owner works at the tail, thieves at the head
+  mvla__task_t tasks[MVLA__DEQUE_CAP];
+  struct mvla__pool *pool;
+  size_t index;
+} mvla__deque_t;
+
+typedef struct mvla__pool {
+  pthread_mutex_t lock;
+  pthread_cond_t wake;
+  size_t queued, sleeping, count, started;
+  int stop;
+  pthread_t *threads;
+  mvla__deque_t *deques;
+} mvla__pool_t;
+
+static mvla__pool_t *mvla__pool = NULL;
+static pthread_mutex_t mvla__pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static MVLA__THREAD_LOCAL size_t mvla__pool_self = 0;
+
+static int mvla__deque_push(mvla__deque_t *d, const mvla__task_t *task) {
+  int ok;
+  pthread_mutex_lock(&d->lock);
+  ok = d->tail - d->head < MVLA__DEQUE_CAP;
+  if (ok) {
+    d->tasks[d->tail++ % MVLA__DEQUE_CAP] = *task;
+  }
+  pthread_mutex_unlock(&d->lock);
+  return ok;
+}
+
+static int mvla__deque_pop(mvla__deque_t *d, mvla__task_t *task, int steal) {
+  int ok;
+  pthread_mutex_lock(&d->lock);
+  ok = d->tail != d->head;
+  if (ok) {
+    *task = steal ? d->tasks[d->head++ % MVLA__DEQUE_CAP] : d->tasks[--d->tail % MVLA__DEQUE_CAP];
+  }
+  pthread_mutex_unlock(&d->lock);
+  return ok;
+}
+
+static int mvla__pool_take(mvla__pool_t *pool, mvla__task_t *task) {
+  size_t self = mvla__pool_self, k;
+  for (k = 0; k < pool->count; ++k) {
+    if (mvla__deque_pop(&pool->deques[(self + k) % pool->count], task, k > 0)) {
+      __atomic_sub_fetch(&pool->queued, 1, __ATOMIC_ACQ_REL);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static void mvla__pool_exec(mvla__pool_t *pool, mvla__task_t task) {
+  mvla__pool_job_t *job = task.job;
+  while (task.end - task.begin >= 2 * job->grain) {
+    mvla__task_t rest = task;
+    rest.begin = task.begin + (task.end - task.begin) / job->grain / 2 * job->grain;
+    if (!mvla__deque_push(&pool->deques[mvla__pool_self], &rest)) {
+      break;
+    }
+    __atomic_add_fetch(&pool->queued, 1, __ATOMIC_ACQ_REL);
+    pthread_mutex_lock(&pool->lock);
+    if (pool->sleeping > 0) {
+      pthread_cond_signal(&pool->wake);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    task.end = rest.begin;
+  }
+  job->fn(job->ctx, task.begin, task.end);
+  if (__atomic_sub_fetch(&job->remaining, task.end - task.begin, __ATOMIC_ACQ_REL) == 0) {
+    pthread_mutex_lock(&pool->lock);
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+  }
+}
+
+static void *mvla__pool_main(void *arg) {
+  mvla__deque_t *deque = (mvla__deque_t *) arg;
+  mvla__pool_t *pool = deque->pool;
+  mvla__task_t task;
+  int stop = 0;
+  mvla__pool_self = deque->index;
+  while (!stop) {
+    if (mvla__pool_take(pool, &task)) {
+      mvla__pool_exec(pool, task);
+      continue;
+    }
+    pthread_mutex_lock(&pool->lock);
+    while (!pool->stop && __atomic_load_n(&pool->queued, __ATOMIC_ACQUIRE) == 0) {
+      ++pool->sleeping;
+      pthread_cond_wait(&pool->wake, &pool->lock);
+      --pool->sleeping;
+    }
+    stop = pool->stop;
+    pthread_mutex_unlock(&pool->lock);
+  }
+  return NULL;
+}
+
+// joins the workers and frees the pool, which must be idle
+static void mvla__pool_free(mvla__pool_t *pool) {
+  size_t k;
+  pthread_mutex_lock(&pool->lock);
+  pool->stop = 1;
+  pthread_cond_broadcast(&pool->wake);
+  pthread_mutex_unlock(&pool->lock);
+  for (k = 0; k < pool->started; ++k) {
+    pthread_join(pool->threads[k], NULL);
+  }
+  for (k = 0; k < pool->count; ++k) {
+    pthread_mutex_destroy(&pool->deques[k].lock);
+  }
+  pthread_cond_destroy(&pool->wake);
+  pthread_mutex_destroy(&pool->lock);
+  MVLA_FREE(pool->threads);
+  MVLA_FREE(pool->deques);
+  MVLA_FREE(pool);
+}
+
+// starts up to workers threads, NULL if none could be
+static mvla__pool_t *mvla__pool_new(size_t workers) {
+  mvla__pool_t *pool = (mvla__pool_t *) MVLA_MALLOC(sizeof(*pool));
+  size_t k;
+  if (pool == NULL) {
+    return NULL;
+  }
+  memset(pool, 0, sizeof(*pool));
+  pool->count = workers + 1;
+  pool->threads = (pthread_t *) MVLA_MALLOC(workers * sizeof(*pool->threads));
+  pool->deques = (mvla__deque_t *) MVLA_MALLOC(pool->count * sizeof(*pool->deques));
+  if (pool->threads == NULL || pool->deques == NULL) {
+    if (pool->threads != NULL) {
+      MVLA_FREE(pool->threads);
+    }
+    if (pool->deques != NULL) {
+      MVLA_FREE(pool->deques);
+    }
+    MVLA_FREE(pool);
+    return NULL;
+  }
+  memset(pool->deques, 0, pool->count * sizeof(*pool->deques));
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init(&pool->wake, NULL);
+  for (k = 0; k < pool->count; ++k) {
+    pthread_mutex_init(&pool->deques[k].lock, NULL);
+    pool->deques[k].pool = pool;
+    pool->deques[k].index = k;
+  }
+  while (pool->started < workers &&
+         pthread_create(&pool->threads[pool->started], NULL, mvla__pool_main,
+                        &pool->deques[pool->started + 1]) == 0) {
+    ++pool->started;
+  }
+  if (pool->started == 0) {
+    mvla__pool_free(pool);
+    return NULL;
+  }
+  return pool;
+}
+
+static mvla__pool_t *mvla__pool_get(void) {
+  mvla__pool_t *pool = __atomic_load_n(&mvla__pool, __ATOMIC_ACQUIRE);
+  if (pool == NULL && mvla_threads_get() > 1) {
+    pthread_mutex_lock(&mvla__pool_lock);
+    if (mvla__pool == NULL) {
+      __atomic_store_n(&mvla__pool, mvla__pool_new((size_t) mvla_threads_get() - 1),
+                       __ATOMIC_RELEASE);
+    }
+    pool = mvla__pool;
+    pthread_mutex_unlock(&mvla__pool_lock);
+  }
+  return pool;
+}
+
+static void mvla__pool_stop(void) {
+  pthread_mutex_lock(&mvla__pool_lock);
+  if (mvla__pool != NULL) {
+    mvla__pool_free(mvla__pool);
+    __atomic_store_n(&mvla__pool, NULL, __ATOMIC_RELEASE);
+  }
+  pthread_mutex_unlock(&mvla__pool_lock);
+}
+
+static void mvla__pool_run(mvla__pool_t *pool, size_t n, size_t grain, mvla_range_fn_t fn,
+                           void *ctx) {
+  mvla__pool_job_t job;
+  mvla__task_t task;
+  job.fn = fn;
+  job.ctx = ctx;
+  job.grain = grain;
+  job.remaining = n;
+  task.job = &job;
+  task.begin = 0;
+  task.end = n;
+  mvla__pool_exec(pool, task);
+  while (__atomic_load_n(&job.remaining, __ATOMIC_ACQUIRE) != 0) {
+    if (mvla__pool_take(pool, &task)) {
+      mvla__pool_exec(pool, task);
+      continue;
+    }
+    pthread_mutex_lock(&pool->lock);
+    while (__atomic_load_n(&job.remaining, __ATOMIC_ACQUIRE) != 0 &&
+           __atomic_load_n(&pool->queued, __ATOMIC_ACQUIRE) == 0) {
+      ++pool->sleeping;
+      pthread_cond_wait(&pool->wake, &pool->lock);
+      --pool->sleeping;
+    }
+    // a push may have woken this thread instead of a worker
+    if (__atomic_load_n(&pool->queued, __ATOMIC_ACQUIRE) != 0 && pool->sleeping > 0) {
+      pthread_cond_signal(&pool->wake);
+    }
+    pthread_mutex_unlock(&pool->lock);
+  }
+}
+
+#endif // MVLA_THREADS
+
+MVLAIMPL void mvla_threads_set(int n) {
+#ifdef MVLA_THREADS
+  mvla__pool_stop();
+#endif // MVLA_THREADS
+  mvla__threads = n < 0 ? 0 : n;
+}
+
+MVLAIMPL int mvla_threads_get(void) {
+#ifdef MVLA_THREADS
+  static int cpus = 0;
+  if (mvla__threads > 0) {
+    return mvla__threads;
+  }
+  if (cpus == 0) {
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    cpus = online > 0 ? (int) online : 1;
+  }
+  return cpus;
+#else
+  return 1;
+#endif // MVLA_THREADS
+}
+
+MVLAIMPL void mvla_executor_set(const mvla_executor_t *executor) {
+#ifdef MVLA_THREADS
+  mvla__pool_stop();
+#endif // MVLA_THREADS
+  mvla__executor.run = executor == NULL ? NULL : executor->run;
+  mvla__executor.user = executor == NULL ? NULL : executor->user;
+}
+
+typedef struct mvla__chunks {
+  mvla_range_fn_t fn;
+  void *ctx;
+  size_t n, grain;
+} mvla__chunks_t;
+
+static void mvla__chunks_task(void *ctx, size_t index) {
+  mvla__chunks_t *chunks = (mvla__chunks_t *) ctx;
+  size_t begin = index * chunks->grain;
+  chunks->fn(chunks->ctx, begin,
+             chunks->n - begin < chunks->grain ? chunks->n : begin + chunks->grain);
+}
+
+MVLAIMPL void mvla_parallel_for(size_t n, size_t grain, mvla_range_fn_t fn, void *ctx) {
+#ifdef MVLA_THREADS
+  mvla__pool_t *pool;
+#endif // MVLA_THREADS
+  grain = grain == 0 ? 1 : grain;
+  if (n <= grain) {
+    fn(ctx, 0, n);
+  } else if (mvla__executor.run != NULL) {
+    mvla__chunks_t chunks;
+    chunks.fn = fn;
+    chunks.ctx = ctx;
+    chunks.n = n;
+    chunks.grain = grain;
+    mvla__executor.run(mvla__executor.user, (n + grain - 1) / grain, mvla__chunks_task, &chunks);
+#ifdef MVLA_THREADS
+  } else if ((pool = mvla__pool_get()) != NULL) {
+    mvla__pool_run(pool, n, grain, fn, ctx);
+#endif // MVLA_THREADS
+  } else {
+    fn(ctx, 0, n);
+  }
+}
+
+// the batch functions split from MVLA_PARALLEL_GRAIN elements on, in ranges
+// starting on multiples of 64 so aligned outputs stay aligned
+static void mvla__parallel_for(size_t n, mvla_range_fn_t fn, void *ctx) {
+  mvla_parallel_for(n, MVLA__GRAIN, fn, ctx);
+}
+
+// runs fn once per slot in [0, parts), each slot on one thread at a time so it
+// can own a scratch buffer
+static void mvla__parallel_run(size_t parts, mvla_range_fn_t fn, void *ctx) {
+  mvla_parallel_for(parts, 1, fn, ctx);
+}
+
+// orders non-temporal stores before whatever the caller does next
+static inline void mvla__sfence(void) {
+#ifdef MVLA_HAS_SSE2
+  _mm_sfence();
+#endif // MVLA_HAS_SSE2
+}
+
+// -----------------------------------------
+
+/*
+** RUNTIME DISPATCH
+**
+** The kernels above are reached through one table of function pointers that
+** is bound on first use to the best tier the CPU supports, or to the tier
+** named by the MVLA_TIER environment variable (scalar, sse2, avx2, avx512).
+** Where threads are available the first binding goes through pthread_once,
+** so any number of threads may make the first batch call together.
+** mvla_tier_set() rebinds it without that guard, which is meant for tests and
+** benchmarks and must not run while kernels are executing on any thread,
+** pool workers included.
+*/
+
+typedef struct mvla__kernels {
+#define MVLA__X(name, T, P, OP, expr) void (*name)(const T *, const T *, T *, size_t);
+  MVLA__BINARY_KERNELS(MVLA__X)
+#undef MVLA__X
+#define MVLA__X(name, T, P, OP, expr) void (*name)(const T *, T *, size_t);
+  MVLA__UNARY_KERNELS(MVLA__X)
+#undef MVLA__X
+#define MVLA__X(name, T, P, OP, expr) void (*name)(const T *, const T *, const T *, T *, size_t);
+  MVLA__TERNARY_KERNELS(MVLA__X)
+#undef MVLA__X
+#define MVLA__X(V, T) void (*V##_sqr_len)(const V##_t *, T *, size_t, int);
+  MVLA__AOS_SQR_LEN_KERNELS(MVLA__X)
+#undef MVLA__X
+#define MVLA__X(tier, attr, name, T, P, fn, sfn) void (*name)(const T *, T *, size_t);
+  MVLA__FAST_UNARY_KERNELS(MVLA__X, , )
+#undef MVLA__X
+#define MVLA__X(tier, attr, name, T, P, fn, sfn) void (*name)(const T *, const T *, T *, size_t);
+  MVLA__FAST_BINARY_KERNELS(MVLA__X, , )
+#undef MVLA__X
+#define MVLA__X(tier, attr, name, T, P, fn, sfn) void (*name)(const T *, T *, T *, size_t);
+  MVLA__FAST_SINCOS_KERNELS(MVLA__X, , )
+#undef MVLA__X
+#define MVLA__X(tier, attr, f, T, P, p)                                           \
+  void (*f##_dot_k)(const T *const *, const T *const *, int, T *, size_t);        \
+  void (*f##_normalize_k)(const T *const *, int, T *const *, size_t, int);        \
+  void (*f##_cross_k)(const T *const *, const T *const *, int, T *const *, size_t); \
+  void (*f##_dist_k)(const T *const *, const T *const *, int, T *, size_t, int);  \
+  void (*f##_project_k)(const T *const *, const T *const *, int, T *const *, size_t); \
+  void (*f##_reflect_k)(const T *const *, const T *const *, int, T *const *, size_t);
+  MVLA__GEOM_KERNELS(MVLA__X, , )
+#undef MVLA__X
+#define MVLA__X(tier, attr, f, T, P, Q, ABS)                                      \
+  void (*f##_axpy_k)(T, const T *, T *, size_t);                                  \
+  void (*f##_scal_k)(T, const T *, T *, size_t);                                  \
+  T (*f##_vdot_k)(const T *, const T *, size_t);                                  \
+  T (*f##_asum_k)(const T *, size_t);                                             \
+  double (*f##_sumsq_k)(const T *, size_t);
+  MVLA__BLAS1_KERNELS(MVLA__X, , )
+#undef MVLA__X
+#define MVLA__X(tier, attr, f, T, P)                                              \
+  void (*f##_xform_k)(const T *, const T *const *, int, T *const *, int, size_t, int); \
+  void (*f##_stream_k)(const T *, T *, size_t);
+  MVLA__XFORM_KERNELS(MVLA__X, , )
+#undef MVLA__X
+#define MVLA__X(tier, attr, f, T, P)                                              \
+  size_t (*f##_inverse_k)(const T *const *, int, T *const *, T *, unsigned char *, size_t); \
+  void (*f##_rigid_k)(const T *const *, T *const *, size_t);
+  MVLA__INVERSE_KERNELS(MVLA__X, , )
+#undef MVLA__X
+#define MVLA__X(tier, attr, f, T, P)                                              \
+  void (*f##_gemm_micro)(size_t, const T *, const T *, T, T, T *, size_t, size_t, size_t); \
+  size_t f##_gemm_mr, f##_gemm_nr;                                                \
+  void (*f##_gemv_k)(size_t, size_t, T, const T *, size_t, const T *, T *);
+  MVLA__GEMM_KERNELS(MVLA__X, , )
+#undef MVLA__X
+  void (*f32_sqr_len_k)(const float *, const float *, const float *, const float *,
+                        float *, size_t, int);
+  void (*f64_sqr_len_k)(const double *, const double *, const double *, const double *,
+                        double *, size_t, int);
+  void (*rng_uniform)(mvla_rng_lanes_t *, float *, size_t, size_t);
+  void (*philox)(uint64_t, uint64_t, uint64_t, unsigned int *, size_t);
+  mvla_tier_t tier;
+} mvla__kernels_t;
+
+static mvla__kernels_t mvla__kernels;
+static int mvla__kernels_bound = 0;
+#if defined(MVLA_THREADS)
+// pool workers and user threads may all make the first batch call at once
+static pthread_once_t mvla__kernels_once = PTHREAD_ONCE_INIT;
+#endif // MVLA_THREADS
+
+#define MVLA__BIND_TIER(k, tier, aos)                                             \
+  do {                                                                            \
+    MVLA__BINARY_KERNELS(MVLA__BIND_X_##tier)                                     \
+    MVLA__UNARY_KERNELS(MVLA__BIND_X_##tier)                                      \
+    MVLA__TERNARY_KERNELS(MVLA__BIND_X_##tier)                                    \
+    MVLA__AOS_SQR_LEN_KERNELS(MVLA__BIND_AOS_##aos)                               \
+    MVLA__FAST_UNARY_KERNELS(MVLA__BIND_FAST, tier, )                             \
+    MVLA__FAST_BINARY_KERNELS(MVLA__BIND_FAST, tier, )                            \
+    MVLA__FAST_SINCOS_KERNELS(MVLA__BIND_FAST, tier, )                            \
+    MVLA__GEOM_KERNELS(MVLA__BIND_GEOM, tier, )                                   \
+    MVLA__BLAS1_KERNELS(MVLA__BIND_BLAS1, tier, )                                 \
+    MVLA__XFORM_KERNELS(MVLA__BIND_XFORM, tier, )                                 \
+    MVLA__INVERSE_KERNELS(MVLA__BIND_INVERSE, tier, )                             \
+    MVLA__GEMM_KERNELS(MVLA__BIND_GEMM, tier, )                                   \
+    (k)->f32_sqr_len_k = mvla__f32_sqr_len_k_##tier;                              \
+    (k)->f64_sqr_len_k = mvla__f64_sqr_len_k_##tier;                              \
+    (k)->rng_uniform = mvla__rng_uniform_##tier;                                  \
+    (k)->philox = mvla__philox_##tier;                                            \
+  } while (0)
+
+#define MVLA__BIND_X_SCALAR(name, T, P, OP, expr) mvla__kernels.name = mvla__##name##_SCALAR;
+#define MVLA__BIND_X_SSE2(name, T, P, OP, expr) mvla__kernels.name = mvla__##name##_SSE2;
+#define MVLA__BIND_X_AVX2(name, T, P, OP, expr) mvla__kernels.name = mvla__##name##_AVX2;
+#define MVLA__BIND_X_AVX512(name, T, P, OP, expr) mvla__kernels.name = mvla__##name##_AVX512;
+#define MVLA__BIND_AOS_SCALAR(V, T) mvla__kernels.V##_sqr_len = mvla__##V##_sqr_len_SCALAR;
+#define MVLA__BIND_AOS_SSE2(V, T) mvla__kernels.V##_sqr_len = mvla__##V##_sqr_len_SSE2;
+#define MVLA__BIND_FAST(tier, attr, name, T, P, fn, sfn) mvla__kernels.name = mvla__##name##_##tier;
+#define MVLA__BIND_GEOM(tier, attr, f, T, P, p)                                   \
+  mvla__kernels.f##_dot_k = mvla__##f##_dot_k_##tier;                             \
+  mvla__kernels.f##_normalize_k = mvla__##f##_normalize_k_##tier;                 \
+  mvla__kernels.f##_cross_k = mvla__##f##_cross_k_##tier;                         \
+  mvla__kernels.f##_dist_k = mvla__##f##_dist_k_##tier;                           \
+  mvla__kernels.f##_project_k = mvla__##f##_project_k_##tier;                     \
+  mvla__kernels.f##_reflect_k = mvla__##f##_reflect_k_##tier;
+#define MVLA__BIND_BLAS1(tier, attr, f, T, P, Q, ABS)                             \
+  mvla__kernels.f##_axpy_k = mvla__##f##_axpy_k_##tier;                           \
+  mvla__kernels.f##_scal_k = mvla__##f##_scal_k_##tier;                           \
+  mvla__kernels.f##_vdot_k = mvla__##f##_vdot_k_##tier;                           \
+  mvla__kernels.f##_asum_k = mvla__##f##_asum_k_##tier;                           \
+  mvla__kernels.f##_sumsq_k = mvla__##f##_sumsq_k_##tier;
+#define MVLA__BIND_XFORM(tier, attr, f, T, P)                                     \
+  mvla__kernels.f##_xform_k = mvla__##f##_xform_k_##tier;                         \
+  mvla__kernels.f##_stream_k = mvla__##f##_stream_k_##tier;
+#define MVLA__BIND_INVERSE(tier, attr, f, T, P)                                   \
+  mvla__kernels.f##_inverse_k = mvla__##f##_inverse_k_##tier;                     \
+  mvla__kernels.f##_rigid_k = mvla__##f##_rigid_k_##tier;
+#define MVLA__BIND_GEMM(tier, attr, f, T, P)                                      \
+  mvla__kernels.f##_gemm_micro = mvla__##f##_gemm_micro_##tier;                   \
+  mvla__kernels.f##_gemm_mr = 2 * MVLA__GOP(tier, P, WIDTH);                      \
+  mvla__kernels.f##_gemm_nr = MVLA__GEMM_NR_##tier;                               \
+  mvla__kernels.f##_gemv_k = mvla__##f##_gemv_k_##tier;
+
+static inline mvla_tier_t mvla__tier_compiled(void) {
+#if defined(MVLA__TIER_AVX512)
+  return MVLA_TIER_AVX512;
+#elif defined(MVLA__TIER_AVX2)
+  return MVLA_TIER_AVX2;
+#elif defined(MVLA_HAS_SSE2)
+  return MVLA_TIER_SSE2;
+#else
+  return MVLA_TIER_SCALAR;
+#endif // MVLA__TIER_*
+}
+
+static inline void mvla__bind_tier(mvla_tier_t tier) {
+  switch (tier) {
+#ifdef MVLA__TIER_AVX512
+    case MVLA_TIER_AVX512:
+      MVLA__BIND_TIER(&mvla__kernels, AVX512, SSE2);
+      break;
+#endif // MVLA__TIER_AVX512
+#ifdef MVLA__TIER_AVX2
+    case MVLA_TIER_AVX2:
+      MVLA__BIND_TIER(&mvla__kernels, AVX2, SSE2);
+      break;
+#endif // MVLA__TIER_AVX2
+#ifdef MVLA_HAS_SSE2
+    case MVLA_TIER_SSE2:
+      MVLA__BIND_TIER(&mvla__kernels, SSE2, SSE2);
+      break;
+#endif // MVLA_HAS_SSE2
+    default:
+      tier = MVLA_TIER_SCALAR;
+      MVLA__BIND_TIER(&mvla__kernels, SCALAR, SCALAR);
+      break;
+  }
+  mvla__kernels.tier = tier;
+  mvla__kernels_bound = 1;
+}
+
+MVLAIMPL mvla_tier_t mvla_tier_detect(void) {
+  mvla_tier_t best = mvla__tier_compiled();
+#if defined(MVLA_DISPATCH)
+  __builtin_cpu_init();
+  if (best >= MVLA_TIER_AVX512 && __builtin_cpu_supports("avx512f")) {
+    return MVLA_TIER_AVX512;
+  }
+  if (best >= MVLA_TIER_AVX2 && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return MVLA_TIER_AVX2;
+  }
+  return (best >= MVLA_TIER_SSE2 && __builtin_cpu_supports("sse2")) ? MVLA_TIER_SSE2 : MVLA_TIER_SCALAR;
+#else
+  // without dispatch the binary already requires everything it was built for
+  return best;
+#endif // MVLA_DISPATCH
+}
+
+MVLAIMPL mvla_tier_t mvla_tier_set(mvla_tier_t tier) {
+  mvla_tier_t best = mvla_tier_detect();
+  mvla__bind_tier(tier < best ? tier : best);
+  return mvla__kernels.tier;
+}
+
+// binds the table on first use unless mvla_tier_set() already did
+static void mvla__kernels_init(void) {
+  const char *env = getenv("MVLA_TIER");
+  mvla_tier_t tier;
+  if (mvla__kernels_bound) {
+    return;
+  }
+  tier = mvla_tier_detect();
+  if (env != NULL) {
+    if (strcmp(env, "scalar") == 0) {
+      tier = MVLA_TIER_SCALAR;
+    } else if (strcmp(env, "sse2") == 0) {
+      tier = MVLA_TIER_SSE2;
+    } else if (strcmp(env, "avx2") == 0) {
+      tier = MVLA_TIER_AVX2;
+    } else if (strcmp(env, "avx512") == 0) {
+      tier = MVLA_TIER_AVX512;
+    }
+  }
+  mvla_tier_set(tier);
+}
+
+MVLAIMPL mvla_tier_t mvla_tier_get(void) {
+#if defined(MVLA_THREADS)
+  pthread_once(&mvla__kernels_once, mvla__kernels_init);
+#else
+  if (!mvla__kernels_bound) {
+    mvla__kernels_init();
+  }
+#endif // MVLA_THREADS
+  return mvla__kernels.tier;
+}
+
+MVLAIMPL const char *mvla_tier_name(mvla_tier_t tier) {
+  switch (tier) {
+    case MVLA_TIER_SCALAR: return "scalar";
+    case MVLA_TIER_SSE2:   return "sse2";
+    case MVLA_TIER_AVX2:   return "avx2";
+    case MVLA_TIER_AVX512: return "avx512";
+  }
+  return "unknown";
+}
+
+static inline const mvla__kernels_t *mvla__kernels_get(void) {
+  mvla_tier_get();
+  return &mvla__kernels;
+}
+
+// entry points used by the batch functions, named after the kernel lists. Past
+// one grain the arrays are split across threads, each range offsetting every
+// argument by its start
+typedef struct mvla__map_job {
+  const void *a, *b, *c;
+  void *out, *out2;
+  double s;
+  int flag;
+} mvla__map_job_t;
+
+#define MVLA__X(name, T, P, OP, expr)                                             \
+  static void mvla__##name##_range(void *ctx, size_t begin, size_t end) {         \
+    mvla__map_job_t *job = (mvla__map_job_t *) ctx;                               \
+    mvla__kernels_get()->name((const T *) job->a + begin, (const T *) job->b + begin, \
+                              (T *) job->out + begin, end - begin);               \
+  }                                                                               \
+  static inline void mvla__##name(const T *a, const T *b, T *out, size_t n) {     \
+    mvla__map_job_t job;                                                          \
+    if (n <= MVLA__GRAIN) {                                                       \
+      mvla__kernels_get()->name(a, b, out, n);                                    \
+      return;                                                                     \
+    }                                                                             \
+    job.a = a;                                                                    \
+    job.b = b;                                                                    \
+    job.out = out;                                                                \
+    mvla__parallel_for(n, mvla__##name##_range, &job);                            \
+  }
+MVLA__BINARY_KERNELS(MVLA__X)
+#undef MVLA__X
+#define MVLA__X(name, T, P, OP, expr)                                             \
+  static void mvla__##name##_range(void *ctx, size_t begin, size_t end) {         \
+    mvla__map_job_t *job = (mvla__map_job_t *) ctx;                               \
+    mvla__kernels_get()->name((const T *) job->a + begin, (T *) job->out + begin, \
+                              end - begin);                                       \
+  }                                                                               \
+  static inline void mvla__##name(const T *a, T *out, size_t n) {                 \
+    mvla__map_job_t job;                                                          \
+    if (n <= MVLA__GRAIN) {                                                       \
+      mvla__kernels_get()->name(a, out, n);                                       \
+      return;                                                                     \
+    }                                                                             \
+    job.a = a;                                                                    \
+    job.out = out;                                                                \
+    mvla__parallel_for(n, mvla__##name##_range, &job);                            \
+  }
+MVLA__UNARY_KERNELS(MVLA__X)
+#undef MVLA__X
+#define MVLA__X(name, T, P, OP, expr)                                             \
+  static void mvla__##name##_range(void *ctx, size_t begin, size_t end) {         \
+    mvla__map_job_t *job = (mvla__map_job_t *) ctx;                               \
+    mvla__kernels_get()->name((const T *) job->a + begin, (const T *) job->b + begin, \
+                              (const T *) job->c + begin, (T *) job->out + begin, \
+                              end - begin);                                       \
+  }                                                                               \
+  static inline void mvla__##name(const T *a, const T *b, const T *c, T *out,     \
+                                  size_t n) {                                     \
+    mvla__map_job_t job;                                                          \
+    if (n <= MVLA__GRAIN) {                                                       \
+      mvla__kernels_get()->name(a, b, c, out, n);                                 \
+      return;                                                                     \
+    }                                                                             \
+    job.a = a;                                                                    \
+    job.b = b;                                                                    \
+    job.c = c;                                                                    \
+    job.out = out;                                                                \
+    mvla__parallel_for(n, mvla__##name##_range, &job);                            \
+  }
+MVLA__TERNARY_KERNELS(MVLA__X)
+#undef MVLA__X
+#define MVLA__X(V, T)                                                             \
+  static void mvla__##V##_sqr_len_range(void *ctx, size_t begin, size_t end) {    \
+    mvla__map_job_t *job = (mvla__map_job_t *) ctx;                               \
+    mvla__kernels_get()->V##_sqr_len((const V##_t *) job->a + begin, (T *) job->out + begin, \
+                                     end - begin, job->flag);                     \
+  }                                                                               \
+  static inline void mvla__##V##_sqr_len(const V##_t *a, T *out, size_t n, int root) { \
+    mvla__map_job_t job;                                                          \
+    if (n <= MVLA__GRAIN) {                                                       \
+      mvla__kernels_get()->V##_sqr_len(a, out, n, root);                          \
+      return;                                                                     \
+    }                                                                             \
+    job.a = a;                                                                    \
+    job.out = out;                                                                \
+    job.flag = root;                                                              \
+    mvla__parallel_for(n, mvla__##V##_sqr_len_range, &job);                       \
+  }
+MVLA__AOS_SQR_LEN_KERNELS(MVLA__X)
+#undef MVLA__X
+#define MVLA__X(tier, attr, name, T, P, fn, sfn)                                  \
+  static void mvla__##name##_range(void *ctx, size_t begin, size_t end) {         \
+    mvla__map_job_t *job = (mvla__map_job_t *) ctx;                               \
+    mvla__kernels_get()->name((const T *) job->a + begin, (T *) job->out + begin, \
+                              end - begin);                                       \
+  }                                                                               \
+  static inline void mvla__##name(const T *a, T *out, size_t n) {                 \
+    mvla__map_job_t job;                                                          \
+    if (n <= MVLA__GRAIN) {                                                       \
+      mvla__kernels_get()->name(a, out, n);                                       \
+      return;                                                                     \
+    }                                                                             \
+    job.a = a;                                                                    \
+    job.out = out;                                                                \
+    mvla__parallel_for(n, mvla__##name##_range, &job);                            \
+  }
+MVLA__FAST_UNARY_KERNELS(MVLA__X, , )
+#undef MVLA__X
+#define MVLA__X(tier, attr, name, T, P, fn, sfn)                                  \
+  static void mvla__##name##_range(void *ctx, size_t begin, size_t end) {         \
+    mvla__map_job_t *job = (mvla__map_job_t *) ctx;                               \
+    mvla__kernels_get()->name((const T *) job->a + begin, (const T *) job->b + begin, \
+                              (T *) job->out + begin, end - begin);               \
+  }                                                                               \
+  static inline void mvla__##name(const T *a, const T *b, T *out, size_t n) {     \
+    mvla__map_job_t job;                                                          \
+    if (n <= MVLA__GRAIN) {                                                       \
+      mvla__kernels_get()->name(a, b, out, n);                                    \
+      return;                                                                     \
+    }                                                                             \
+    job.a = a;                                                                    \
+    job.b = b;                                                                    \
+    job.out = out;                                                                \
+    mvla__parallel_for(n, mvla__##name##_range, &job);                            \
+  }
+MVLA__FAST_BINARY_KERNELS(MVLA__X, , )
+#undef MVLA__X
+#define MVLA__X(tier, attr, name, T, P, fn, sfn)                                  \
+  static void mvla__##name##_range(void *ctx, size_t begin, size_t end) {         \
+    mvla__map_job_t *job = (mvla__map_job_t *) ctx;                               \
+    mvla__kernels_get()->name((const T *) job->a + begin, (T *) job->out + begin, \
+                              (T *) job->out2 + begin, end - begin);              \
+  }                                                                               \
+  static inline void mvla__##name(const T *a, T *s, T *c, size_t n) {             \
+    mvla__map_job_t job;                                                          \
+    if (n <= MVLA__GRAIN) {                                                       \
+      mvla__kernels_get()->name(a, s, c, n);                                      \
+      return;                                                                     \
+    }                                                                             \
+    job.a = a;                                                                    \
+    job.out = s;                                                                  \
+    job.out2 = c;                                                                 \
+    mvla__parallel_for(n, mvla__##name##_range, &job);                            \
+  }
+MVLA__FAST_SINCOS_KERNELS(MVLA__X, , )
+#undef MVLA__X
+#define MVLA__X(tier, attr, f, T, P, p)                                           \
+  static inline void mvla__##f##_dot_k(const T *const *a, const T *const *b, int dims, \
+                                       T *out, size_t n) {                        \
+    mvla__kernels_get()->f##_dot_k(a, b, dims, out, n);                           \
+  }                                                                               \
+  static inline void mvla__##f##_normalize_k(const T *const *a, int dims, T *const *out, \
+                                             size_t n, int fast) {                \
+    mvla__kernels_get()->f##_normalize_k(a, dims, out, n, fast);                  \
+  }                                                                               \
+  static inline void mvla__##f##_cross_k(const T *const *a, const T *const *b, int dims, \
+                                         T *const *out, size_t n) {               \
+    mvla__kernels_get()->f##_cross_k(a, b, dims, out, n);                         \
+  }                                                                               \
+  static inline void mvla__##f##_dist_k(const T *const *a, const T *const *b, int dims, \
+                                        T *out, size_t n, int root) {             \
+    mvla__kernels_get()->f##_dist_k(a, b, dims, out, n, root);                    \
+  }                                                                               \
+  static inline void mvla__##f##_project_k(const T *const *a, const T *const *b, int dims, \
+                                           T *const *out, size_t n) {             \
+    mvla__kernels_get()->f##_project_k(a, b, dims, out, n);                       \
+  }                                                                               \
+  static inline void mvla__##f##_reflect_k(const T *const *a, const T *const *b, int dims, \
+                                           T *const *out, size_t n) {             \
+    mvla__kernels_get()->f##_reflect_k(a, b, dims, out, n);                       \
+  }
+MVLA__GEOM_KERNELS(MVLA__X, , )
+#undef MVLA__X
+// reductions past one grain sum per MVLA__GRAIN chunk in double, then the
+// chunks in order, so the result doesn't depend on the thread count
+typedef struct mvla__reduce_job {
+  const void *x, *y;
+  double *partial;
+} mvla__reduce_job_t;
+
+static int mvla__reduce(size_t n, mvla_range_fn_t fn, const void *x, const void *y,
+                        double *sum) {
+  mvla__reduce_job_t job;
+  double local[64];
+  size_t k, chunks = (n + MVLA__GRAIN - 1) / MVLA__GRAIN;
+  job.x = x;
+  job.y = y;
+  job.partial = chunks <= 64 ? local : (double *) MVLA_MALLOC(chunks * sizeof(double));
+  if (job.partial == NULL) {
+    return 0;
+  }
+  mvla__parallel_for(n, fn, &job);
+  *sum = 0.0;
+  for (k = 0; k < chunks; ++k) {
+    *sum += job.partial[k];
+  }
+  if (job.partial != local) {
+    MVLA_FREE(job.partial);
+  }
+  return 1;
+}
+
+#define MVLA__X(tier, attr, f, T, P, Q, ABS)                                      \
+  static void mvla__##f##_axpy_range(void *ctx, size_t begin, size_t end) {       \
+    mvla__map_job_t *job = (mvla__map_job_t *) ctx;                               \
+    mvla__kernels_get()->f##_axpy_k((T) job->s, (const T *) job->a + begin,       \
+                                    (T *) job->out + begin, end - begin);         \
+  }                                                                               \
+  static inline void mvla__##f##_axpy_k(T alpha, const T *x, T *y, size_t n) {    \
+    mvla__map_job_t job;                                                          \
+    if (n <= MVLA__GRAIN) {                                                       \
+      mvla__kernels_get()->f##_axpy_k(alpha, x, y, n);                            \
+      return;                                                                     \
+    }                                                                             \
+    job.s = alpha;                                                                \
+    job.a = x;                                                                    \
+    job.out = y;                                                                  \
+    mvla__parallel_for(n, mvla__##f##_axpy_range, &job);                          \
+  }                                                                               \
+  static void mvla__##f##_scal_range(void *ctx, size_t begin, size_t end) {       \
+    mvla__map_job_t *job = (mvla__map_job_t *) ctx;                               \
+    mvla__kernels_get()->f##_scal_k((T) job->s, (const T *) job->a + begin,       \
+                                    (T *) job->out + begin, end - begin);         \
+  }                                                                               \
+  static inline void mvla__##f##_scal_k(T alpha, const T *x, T *out, size_t n) {  \
+    mvla__map_job_t job;                                                          \
+    if (n <= MVLA__GRAIN) {                                                       \
+      mvla__kernels_get()->f##_scal_k(alpha, x, out, n);                          \
+      return;                                                                     \
+    }                                                                             \
+    job.s = alpha;                                                                \
+    job.a = x;                                                                    \
+    job.out = out;                                                                \
+    mvla__parallel_for(n, mvla__##f##_scal_range, &job);                          \
+  }                                                                               \
+  static void mvla__##f##_vdot_range(void *ctx, size_t begin, size_t end) {       \
+    mvla__reduce_job_t *job = (mvla__reduce_job_t *) ctx;                         \
+    const T *x = (const T *) job->x, *y = (const T *) job->y;                     \
+    for (; begin < end; begin += MVLA__GRAIN) {                                   \
+      job->partial[begin / MVLA__GRAIN] = mvla__kernels_get()->f##_vdot_k(        \
+        x + begin, y + begin, end - begin < MVLA__GRAIN ? end - begin : MVLA__GRAIN); \
+    }                                                                             \
+  }                                                                               \
+  static inline T mvla__##f##_vdot_k(const T *x, const T *y, size_t n) {          \
+    double sum;                                                                   \
+    if (n > MVLA__GRAIN && mvla__reduce(n, mvla__##f##_vdot_range, x, y, &sum)) { \
+      return (T) sum;                                                             \
+    }                                                                             \
+    return mvla__kernels_get()->f##_vdot_k(x, y, n);                              \
+  }                                                                               \
+  static void mvla__##f##_asum_range(void *ctx, size_t begin, size_t end) {       \
+    mvla__reduce_job_t *job = (mvla__reduce_job_t *) ctx;                         \
+    const T *x = (const T *) job->x;                                              \
+    for (; begin < end; begin += MVLA__GRAIN) {                                   \
+      job->partial[begin / MVLA__GRAIN] = mvla__kernels_get()->f##_asum_k(        \
+        x + begin, end - begin < MVLA__GRAIN ? end - begin : MVLA__GRAIN);        \
+    }                                                                             \
+  }                                                                               \
+  static inline T mvla__##f##_asum_k(const T *x, size_t n) {                      \
+    double sum;                                                                   \
+    if (n > MVLA__GRAIN && mvla__reduce(n, mvla__##f##_asum_range, x, NULL, &sum)) { \
+      return (T) sum;                                                             \
+    }                                                                             \
+    return mvla__kernels_get()->f##_asum_k(x, n);                                 \
+  }                                                                               \
+  static void mvla__##f##_sumsq_range(void *ctx, size_t begin, size_t end) {      \
+    mvla__reduce_job_t *job = (mvla__reduce_job_t *) ctx;                         \
+    const T *x = (const T *) job->x;                                              \
+    for (; begin < end; begin += MVLA__GRAIN) {                                   \
+      job->partial[begin / MVLA__GRAIN] = mvla__kernels_get()->f##_sumsq_k(       \
+        x + begin, end - begin < MVLA__GRAIN ? end - begin : MVLA__GRAIN);        \
+    }                                                                             \
+  }                                                                               \
+  static inline double mvla__##f##_sumsq_k(const T *x, size_t n) {                \
+    double sum;                                                                   \
+    if (n > MVLA__GRAIN && mvla__reduce(n, mvla__##f##_sumsq_range, x, NULL, &sum)) { \
+      return sum;                                                                 \
+    }                                                                             \
+    return mvla__kernels_get()->f##_sumsq_k(x, n);                                \
+  }
+MVLA__BLAS1_KERNELS(MVLA__X, , )
+#undef MVLA__X
+#define MVLA__X(tier, attr, f, T, P)                                              \
+  static inline void mvla__##f##_xform_k(const T *m, const T *const *a, int in_dims, \
+                                         T *const *out, int out_dims, size_t n,   \
+                                         int flags) {                             \
+    mvla__kernels_get()->f##_xform_k(m, a, in_dims, out, out_dims, n, flags);     \
+  }                                                                               \
+  static inline void mvla__##f##_stream_k(const T *src, T *dst, size_t n) {       \
+    mvla__kernels_get()->f##_stream_k(src, dst, n);                               \
+  }
+MVLA__XFORM_KERNELS(MVLA__X, , )
+#undef MVLA__X
+#define MVLA__X(tier, attr, f, T, P)                                              \
+  static inline size_t mvla__##f##_inverse_k(const T *const *a, int dims, T *const *out, \
+                                             T *det, unsigned char *singular,     \
+                                             size_t n) {                          \
+    return mvla__kernels_get()->f##_inverse_k(a, dims, out, det, singular, n);    \
+  }                                                                               \
+  static inline void mvla__##f##_rigid_k(const T *const *a, T *const *out, size_t n) { \
+    mvla__kernels_get()->f##_rigid_k(a, out, n);                                  \
+  }
+MVLA__INVERSE_KERNELS(MVLA__X, , )
+#undef MVLA__X
+
+static inline void mvla__f32_sqr_len_k(const float *x, const float *y, const float *z,
+                                       const float *w, float *out, size_t n, int root) {
+  mvla__kernels_get()->f32_sqr_len_k(x, y, z, w, out, n, root);
+}
+
+static inline void mvla__f64_sqr_len_k(const double *x, const double *y, const double *z,
+                                       const double *w, double *out, size_t n, int root) {
+  mvla__kernels_get()->f64_sqr_len_k(x, y, z, w, out, n, root);
+}
+
+static inline void mvla__rng_uniform(mvla_rng_lanes_t *g, float *out, size_t n, size_t draws) {
+  mvla__kernels_get()->rng_uniform(g, out, n, draws);
+}
+
+static inline void mvla__philox(uint64_t seed, uint64_t stream, uint64_t first,
+                                unsigned int *out, size_t n) {
+  mvla__kernels_get()->philox(seed, stream, first, out, n);
+}
+
+/*
+** Integer division and the libm backed functions have no SIMD form, they
+** still save the call and struct copy per vector.
+*/
+
+#define MVLA__SCALAR_BINARY_KERNEL(name, T, expr)                                 \
+  static inline void name(const T *a, const T *b, T *out, size_t n) {             \
+    size_t i;                                                                     \
+    for (i = 0; i < n; ++i) {                                                     \
+      out[i] = (expr);                                                            \
+    }                                                                             \
+  }
+
+#define MVLA__SCALAR_UNARY_KERNEL(name, T, expr)                                  \
+  static inline void name(const T *a, T *out, size_t n) {                         \
+    size_t i;                                                                     \
+    for (i = 0; i < n; ++i) {                                                     \
+      out[i] = (expr);                                                            \
+    }                                                                             \
+  }
+
+MVLA__SCALAR_BINARY_KERNEL(mvla__i32_div, signed int, a[i] / b[i])
+MVLA__SCALAR_BINARY_KERNEL(mvla__u32_div, unsigned int, a[i] / b[i])
+#ifdef MVLA_FAST_MATH
+
+// the libm backed batch functions run the dispatched fast kernels instead
+#define MVLA__FAST_ALIAS_UNARY(name, T)                                           \
+  static inline void mvla__##name(const T *a, T *out, size_t n) {                 \
+    mvla__##name##_fast(a, out, n);                                               \
+  }
+
+#define MVLA__FAST_ALIAS_BINARY(name, T)                                          \
+  static inline void mvla__##name(const T *a, const T *b, T *out, size_t n) {     \
+    mvla__##name##_fast(a, b, out, n);                                            \
+  }
+
+MVLA__FAST_ALIAS_BINARY(f32_pow, float)
+MVLA__FAST_ALIAS_UNARY(f32_exp, float)
+MVLA__FAST_ALIAS_UNARY(f32_sin, float)
+MVLA__FAST_ALIAS_UNARY(f32_cos, float)
+MVLA__FAST_ALIAS_UNARY(f32_tan, float)
+MVLA__FAST_ALIAS_BINARY(f64_pow, double)
+MVLA__FAST_ALIAS_UNARY(f64_exp, double)
+MVLA__FAST_ALIAS_UNARY(f64_sin, double)
+MVLA__FAST_ALIAS_UNARY(f64_cos, double)
+MVLA__FAST_ALIAS_UNARY(f64_tan, double)
+
+static inline void mvla__f32_sincos(const float *a, float *s, float *c, size_t n) {
+  mvla__f32_sincos_fast(a, s, c, n);
+}
+
+static inline void mvla__f64_sincos(const double *a, double *s, double *c, size_t n) {
+  mvla__f64_sincos_fast(a, s, c, n);
+}
+
+#else
+
+MVLA__SCALAR_BINARY_KERNEL(mvla__f32_pow, float, powf(a[i], b[i]))
+MVLA__SCALAR_UNARY_KERNEL(mvla__f32_exp, float, powf(MVLA_E, a[i]))
+MVLA__SCALAR_UNARY_KERNEL(mvla__f32_sin, float, sinf(a[i]))
+MVLA__SCALAR_UNARY_KERNEL(mvla__f32_cos, float, cosf(a[i]))
+MVLA__SCALAR_UNARY_KERNEL(mvla__f32_tan, float, tanf(a[i]))
+MVLA__SCALAR_BINARY_KERNEL(mvla__f64_pow, double, pow(a[i], b[i]))
+MVLA__SCALAR_UNARY_KERNEL(mvla__f64_exp, double, pow(MVLA_E, a[i]))
+MVLA__SCALAR_UNARY_KERNEL(mvla__f64_sin, double, sin(a[i]))
+MVLA__SCALAR_UNARY_KERNEL(mvla__f64_cos, double, cos(a[i]))
+MVLA__SCALAR_UNARY_KERNEL(mvla__f64_tan, double, tan(a[i]))
+
+static inline void mvla__f32_sincos(const float *a, float *s, float *c, size_t n) {
+  size_t i;
+  for (i = 0; i < n; ++i) {
+    float x = a[i];
+    s[i] = sinf(x);
+    c[i] = cosf(x);
+  }
+}
+
+static inline void mvla__f64_sincos(const double *a, double *s, double *c, size_t n) {
+  size_t i;
+  for (i = 0; i < n; ++i) {
+    double x = a[i];
+    s[i] = sin(x);
+    c[i] = cos(x);
+  }
+}
+
+#endif // MVLA_FAST_MATH
+
+static inline void mvla__f32_poww(const float *a, float exp, float *out, size_t n) {
+  size_t i;
+  for (i = 0; i < n; ++i) {
+    out[i] = MVLA__POWF(a[i], exp);
+  }
+}
+
+static inline void mvla__f64_poww(const double *a, double exp, double *out, size_t n) {
+  size_t i;
+  for (i = 0; i < n; ++i) {
+    out[i] = MVLA__POWD(a[i], exp);
+  }
+}
+
+static inline void mvla__f32_poww_fast(const float *a, float exp, float *out, size_t n) {
+  size_t i;
+  for (i = 0; i < n; ++i) {
+    out[i] = powf_fast(a[i], exp);
+  }
+}
+
+static inline void mvla__f64_poww_fast(const double *a, double exp, double *out, size_t n) {
+  size_t i;
+  for (i = 0; i < n; ++i) {
+    out[i] = powd_fast(a[i], exp);
+  }
+}
+
+// -----------------------------------------
+
+MVLAIMPL void v2i_add_n(const v2i_t *a, const v2i_t *b, v2i_t *out, size_t n) {
+  mvla__i32_add((const signed int *) a, (const signed int *) b, (signed int *) out, n * 2);
+}
+
+MVLAIMPL void v2i_sub_n(const v2i_t *a, const v2i_t *b, v2i_t *out, size_t n) {
+  mvla__i32_sub((const signed int *) a, (const signed int *) b, (signed int *) out, n * 2);
+}
+
+MVLAIMPL void v2i_mul_n(const v2i_t *a, const v2i_t *b, v2i_t *out, size_t n) {
+  mvla__i32_mul((const signed int *) a, (const signed int *) b, (signed int *) out, n * 2);
+}
+
+MVLAIMPL void v2i_div_n(const v2i_t *a, const v2i_t *b, v2i_t *out, size_t n) {
+  mvla__i32_div((const signed int *) a, (const signed int *) b, (signed int *) out, n * 2);
+}
+
+MVLAIMPL void v2i_min_n(const v2i_t *a, const v2i_t *b, v2i_t *out, size_t n) {
+  mvla__i32_min((const signed int *) a, (const signed int *) b, (signed int *) out, n * 2);
+}
+
+MVLAIMPL void v2i_max_n(const v2i_t *a, const v2i_t *b, v2i_t *out, size_t n) {
+  mvla__i32_max((const signed int *) a, (const signed int *) b, (signed int *) out, n * 2);
+}
+
+MVLAIMPL void v2u_add_n(const v2u_t *a, const v2u_t *b, v2u_t *out, size_t n) {
+  mvla__u32_add((const unsigned int *) a, (const unsigned int *) b, (unsigned int *) out, n * 2);
+}
+
+MVLAIMPL void v2u_sub_n(const v2u_t *a, const v2u_t *b, v2u_t *out, size_t n) {
+  mvla__u32_sub((const unsigned int *) a, (const unsigned int *) b, (unsigned int *) out, n * 2);
+}
+
+MVLAIMPL void v2u_mul_n(const v2u_t *a, const v2u_t *b, v2u_t *out, size_t n) {
+  mvla__u32_mul((const unsigned int *) a, (const unsigned int *) b, (unsigned int *) out, n * 2);
+}
+
+MVLAIMPL void v2u_div_n(const v2u_t *a, const v2u_t *b, v2u_t *out, size_t n) {
+  mvla__u32_div((const unsigned int *) a, (const unsigned int *) b, (unsigned int *) out, n * 2);
+}
+
+MVLAIMPL void v2u_min_n(const v2u_t *a, const v2u_t *b, v2u_t *out, size_t n) {
+  mvla__u32_min((const unsigned int *) a, (const unsigned int *) b, (unsigned int *) out, n * 2);
+}
+
+MVLAIMPL void v2u_max_n(const v2u_t *a, const v2u_t *b, v2u_t *out, size_t n) {
+  mvla__u32_max((const unsigned int *) a, (const unsigned int *) b, (unsigned int *) out, n * 2);
+}
+
+MVLAIMPL void v2f_add_n(const v2f_t *a, const v2f_t *b, v2f_t *out, size_t n) {
+  mvla__f32_add((const float *) a, (const float *) b, (float *) out, n * 2);
+}
+
+MVLAIMPL void v2f_sub_n(const v2f_t *a, const v2f_t *b, v2f_t *out, size_t n) {
+  mvla__f32_sub((const float *) a, (const float *) b, (float *) out, n * 2);
+}
+
+MVLAIMPL void v2f_mul_n(const v2f_t *a, const v2f_t *b, v2f_t *out, size_t n) {
+  mvla__f32_mul((const float *) a, (const float *) b, (float *) out, n * 2);
+}
+
+MVLAIMPL void v2f_fma_n(const v2f_t *a, const v2f_t *b, const v2f_t *c, v2f_t *out, size_t n) {
+  mvla__f32_fma((const float *) a, (const float *) b, (const float *) c, (float *) out, n * 2);
+}
+
+MVLAIMPL void v2f_fms_n(const v2f_t *a, const v2f_t *b, const v2f_t *c, v2f_t *out, size_t n) {
+  mvla__f32_fms((const float *) a, (const float *) b, (const float *) c, (float *) out, n * 2);
+}
+
+MVLAIMPL void v2f_div_n(const v2f_t *a, const v2f_t *b, v2f_t *out, size_t n) {
+  mvla__f32_div((const float *) a, (const float *) b, (float *) out, n * 2);
+}
+
+MVLAIMPL void v2f_min_n(const v2f_t *a, const v2f_t *b, v2f_t *out, size_t n) {
+  mvla__f32_min((const float *) a, (const float *) b, (float *) out, n * 2);
+}
+
+MVLAIMPL void v2f_max_n(const v2f_t *a, const v2f_t *b, v2f_t *out, size_t n) {
+  mvla__f32_max((const float *) a, (const float *) b, (float *) out, n * 2);
+}
+
+MVLAIMPL void v2f_poww_n(const v2f_t *a, float exp, v2f_t *out, size_t n) {
+  mvla__f32_poww((const float *) a, exp, (float *) out, n * 2);
+}
+
+MVLAIMPL void v2f_pow_n(const v2f_t *a, const v2f_t *exp, v2f_t *out, size_t n) {
+  mvla__f32_pow((const float *) a, (const float *) exp, (float *) out, n * 2);
+}
+
+MVLAIMPL void v2f_sqrt_n(const v2f_t *a, v2f_t *out, size_t n) {
+  mvla__f32_sqrt((const float *) a, (float *) out, n * 2);
+}
+
+MVLAIMPL void v2f_exp_n(const v2f_t *a, v2f_t *out, size_t n) {
+  mvla__f32_exp((const float *) a, (float *) out, n * 2);
+}
+
+MVLAIMPL void v2f_sin_n(const v2f_t *a, v2f_t *out, size_t n) {
+  mvla__f32_sin((const float *) a, (float *) out, n * 2);
+}
+
+MVLAIMPL void v2f_cos_n(const v2f_t *a, v2f_t *out, size_t n) {
+  mvla__f32_cos((const float *) a, (float *) out, n * 2);
+}
+
+MVLAIMPL void v2f_tan_n(const v2f_t *a, v2f_t *out, size_t n) {
+  mvla__f32_tan((const float *) a, (float *) out, n * 2);
+}
+
+MVLAIMPL void v2f_sincos_n(const v2f_t *a, v2f_t *s, v2f_t *c, size_t n) {
+  mvla__f32_sincos((const float *) a, (float *) s, (float *) c, n * 2);
+}
+
+MVLAIMPL void v2f_len_n(const v2f_t *a, float *out, size_t n) {
+  mvla__v2f_sqr_len(a, out, n, 1);
+}
+
+MVLAIMPL void v2f_sqr_len_n(const v2f_t *a, float *out, size_t n) {
+  mvla__v2f_sqr_len(a, out, n, 0);
+}
+
+MVLAIMPL void v2d_add_n(const v2d_t *a, const v2d_t *b, v2d_t *out, size_t n) {
+  mvla__f64_add((const double *) a, (const double *) b, (double *) out, n * 2);
+}
+
+MVLAIMPL void v2d_sub_n(const v2d_t *a, const v2d_t *b, v2d_t *out, size_t n) {
+  mvla__f64_sub((const double *) a, (const double *) b, (double *) out, n * 2);
+}
+
+MVLAIMPL void v2d_mul_n(const v2d_t *a, const v2d_t *b, v2d_t *out, size_t n) {
+  mvla__f64_mul((const double *) a, (const double *) b, (double *) out, n * 2);
+}
+
+MVLAIMPL void v2d_fma_n(const v2d_t *a, const v2d_t *b, const v2d_t *c, v2d_t *out, size_t n) {
+  mvla__f64_fma((const double *) a, (const double *) b, (const double *) c, (double *) out, n * 2);
+}
+
+MVLAIMPL void v2d_fms_n(const v2d_t *a, const v2d_t *b, const v2d_t *c, v2d_t *out, size_t n) {
+  mvla__f64_fms((const double *) a, (const double *) b, (const double *) c, (double *) out, n * 2);
+}
+
+MVLAIMPL void v2d_div_n(const v2d_t *a, const v2d_t *b, v2d_t *out, size_t n) {
+  mvla__f64_div((const double *) a, (const double *) b, (double *) out, n * 2);
+}
+
+MVLAIMPL void v2d_min_n(const v2d_t *a, const v2d_t *b, v2d_t *out, size_t n) {
+  mvla__f64_min((const double *) a, (const double *) b, (double *) out, n * 2);
+}
+
+MVLAIMPL void v2d_max_n(const v2d_t *a, const v2d_t *b, v2d_t *out, size_t n) {
+  mvla__f64_max((const double *) a, (const double *) b, (double *) out, n * 2);
+}
+
+MVLAIMPL void v2d_poww_n(const v2d_t *a, double exp, v2d_t *out, size_t n) {
+  mvla__f64_poww((const double *) a, exp, (double *) out, n * 2);
+}
+
+MVLAIMPL void v2d_pow_n(const v2d_t *a, const v2d_t *exp, v2d_t *out, size_t n) {
+  mvla__f64_pow((const double *) a, (const double *) exp, (double *) out, n * 2);
+}
+
+MVLAIMPL void v2d_sqrt_n(const v2d_t *a, v2d_t *out, size_t n) {
+  mvla__f64_sqrt((const double *) a, (double *) out, n * 2);
+}
+
+MVLAIMPL void v2d_exp_n(const v2d_t *a, v2d_t *out, size_t n) {
+  mvla__f64_exp((const double *) a, (double *) out, n * 2);
+}
+
+MVLAIMPL void v2d_sin_n(const v2d_t *a, v2d_t *out, size_t n) {
+  mvla__f64_sin((const double *) a, (double *) out, n * 2);
+}
+
+MVLAIMPL void v2d_cos_n(const v2d_t *a, v2d_t *out, size_t n) {
+  mvla__f64_cos((const double *) a, (double *) out, n * 2);
+}
+
+MVLAIMPL void v2d_tan_n(const v2d_t *a, v2d_t *out, size_t n) {
+  mvla__f64_tan((const double *) a, (double *) out, n * 2);
+}
+
+MVLAIMPL void v2d_sincos_n(const v2d_t *a, v2d_t *s, v2d_t *c, size_t n) {
+  mvla__f64_sincos((const double *) a, (double *) s, (double *) c, n * 2);
+}
+
+MVLAIMPL void v2d_len_n(const v2d_t *a, double *out, size_t n) {
+  mvla__v2d_sqr_len(a, out, n, 1);
+}
+
+MVLAIMPL void v2d_sqr_len_n(const v2d_t *a, double *out, size_t n) {
+  mvla__v2d_sqr_len(a, out, n, 0);
+}
+
+MVLAIMPL void v3i_add_n(const v3i_t *a, const v3i_t *b, v3i_t *out, size_t n) {
+  mvla__i32_add((const signed int *) a, (const signed int *) b, (signed int *) out, n * 3);
+}
+
+MVLAIMPL void v3i_sub_n(const v3i_t *a, const v3i_t *b, v3i_t *out, size_t n) {
+  mvla__i32_sub((const signed int *) a, (const signed int *) b, (signed int *) out, n * 3);
+}
+
+MVLAIMPL void v3i_mul_n(const v3i_t *a, const v3i_t *b, v3i_t *out, size_t n) {
+  mvla__i32_mul((const signed int *) a, (const signed int *) b, (signed int *) out, n * 3);
+}
+
+MVLAIMPL void v3i_div_n(const v3i_t *a, const v3i_t *b, v3i_t *out, size_t n) {
+  mvla__i32_div((const signed int *) a, (const signed int *) b, (signed int *) out, n * 3);
+}
+
+MVLAIMPL void v3i_min_n(const v3i_t *a, const v3i_t *b, v3i_t *out, size_t n) {
+  mvla__i32_min((const signed int *) a, (const signed int *) b, (signed int *) out, n * 3);
+}
+
+MVLAIMPL void v3i_max_n(const v3i_t *a, const v3i_t *b, v3i_t *out, size_t n) {
+  mvla__i32_max((const signed int *) a, (const signed int *) b, (signed int *) out, n * 3);
+}
+
+MVLAIMPL void v3u_add_n(const v3u_t *a, const v3u_t *b, v3u_t *out, size_t n) {
+  mvla__u32_add((const unsigned int *) a, (const unsigned int *) b, (unsigned int *) out, n * 3);
+}
+
+MVLAIMPL void v3u_sub_n(const v3u_t *a, const v3u_t *b, v3u_t *out, size_t n) {
+  mvla__u32_sub((const unsigned int *) a, (const unsigned int *) b, (unsigned int *) out, n * 3);
+}
+
+MVLAIMPL void v3u_mul_n(const v3u_t *a, const v3u_t *b, v3u_t *out, size_t n) {
+  mvla__u32_mul((const unsigned int *) a, (const unsigned int *) b, (unsigned int *) out, n * 3);
+}
+
+MVLAIMPL void v3u_div_n(const v3u_t *a, const v3u_t *b, v3u_t *out, size_t n) {
+  mvla__u32_div((const unsigned int *) a, (const unsigned int *) b, (unsigned int *) out, n * 3);
+}
+
+MVLAIMPL void v3u_min_n(const v3u_t *a, const v3u_t *b, v3u_t *out, size_t n) {
+  mvla__u32_min((const unsigned int *) a, (const unsigned int *) b, (unsigned int *) out, n * 3);
+}
+
+MVLAIMPL void v3u_max_n(const v3u_t *a, const v3u_t *b, v3u_t *out, size_t n) {
+  mvla__u32_max((const unsigned int *) a, (const unsigned int *) b, (unsigned int *) out, n * 3);
+}
+
+MVLAIMPL void v3f_add_n(const v3f_t *a, const v3f_t *b, v3f_t *out, size_t n) {
+  mvla__f32_add((const float *) a, (const float *) b, (float *) out, n * 3);
+}
+
+MVLAIMPL void v3f_sub_n(const v3f_t *a, const v3f_t *b, v3f_t *out, size_t n) {
+  mvla__f32_sub((const float *) a, (const float *) b, (float *) out, n * 3);
+}
+
+MVLAIMPL void v3f_mul_n(const v3f_t *a, const v3f_t *b, v3f_t *out, size_t n) {
+  mvla__f32_mul((const float *) a, (const float *) b, (float *) out, n * 3);
+}
+
+MVLAIMPL void v3f_fma_n(const v3f_t *a, const v3f_t *b, const v3f_t *c, v3f_t *out, size_t n) {
+  mvla__f32_fma((const float *) a, (const float *) b, (const float *) c, (float *) out, n * 3);
+}
+
+MVLAIMPL void v3f_fms_n(const v3f_t *a, const v3f_t *b, const v3f_t *c, v3f_t *out, size_t n) {
+  mvla__f32_fms((const float *) a, (const float *) b, (const float *) c, (float *) out, n * 3);
+}
+
+MVLAIMPL void v3f_div_n(const v3f_t *a, const v3f_t *b, v3f_t *out, size_t n) {
+  mvla__f32_div((const float *) a, (const float *) b, (float *) out, n * 3);
+}
+
+MVLAIMPL void v3f_min_n(const v3f_t *a, const v3f_t *b, v3f_t *out, size_t n) {
+  mvla__f32_min((const float *) a, (const float *) b, (float *) out, n * 3);
+}
+
+MVLAIMPL void v3f_max_n(const v3f_t *a, const v3f_t *b, v3f_t *out, size_t n) {
+  mvla__f32_max((const float *) a, (const float *) b, (float *) out, n * 3);
+}
+
+MVLAIMPL void v3f_poww_n(const v3f_t *a, float exp, v3f_t *out, size_t n) {
+  mvla__f32_poww((const float *) a, exp, (float *) out, n * 3);
+}
+
+MVLAIMPL void v3f_pow_n(const v3f_t *a, const v3f_t *exp, v3f_t *out, size_t n) {
+  mvla__f32_pow((const float *) a, (const float *) exp, (float *) out, n * 3);
+}
+
+MVLAIMPL void v3f_sqrt_n(const v3f_t *a, v3f_t *out, size_t n) {
+  mvla__f32_sqrt((const float *) a, (float *) out, n * 3);
+}
+
+MVLAIMPL void v3f_exp_n(const v3f_t *a, v3f_t *out, size_t n) {
+  mvla__f32_exp((const float *) a, (float *) out, n * 3);
+}
+
+MVLAIMPL void v3f_sin_n(const v3f_t *a, v3f_t *out, size_t n) {
+  mvla__f32_sin((const float *) a, (float *) out, n * 3);
+}
+
+MVLAIMPL void v3f_cos_n(const v3f_t *a, v3f_t *out, size_t n) {
+  mvla__f32_cos((const float *) a, (float *) out, n * 3);
+}
+
+MVLAIMPL void v3f_tan_n(const v3f_t *a, v3f_t *out, size_t n) {
+  mvla__f32_tan((const float *) a, (float *) out, n * 3);
+}
+
+MVLAIMPL void v3f_sincos_n(const v3f_t *a, v3f_t *s, v3f_t *c, size_t n) {
+  mvla__f32_sincos((const float *) a, (float *) s, (float *) c, n * 3);
+}
+
+MVLAIMPL void v3f_len_n(const v3f_t *a, float *out, size_t n) {
+  mvla__v3f_sqr_len(a, out, n, 1);
+}
+
+MVLAIMPL void v3f_sqr_len_n(const v3f_t *a, float *out, size_t n) {
+  mvla__v3f_sqr_len(a, out, n, 0);
+}
+
+MVLAIMPL void v3d_add_n(const v3d_t *a, const v3d_t *b, v3d_t *out, size_t n) {
+  mvla__f64_add((const double *) a, (const double *) b, (double *) out, n * 3);
+}
+
+MVLAIMPL void v3d_sub_n(const v3d_t *a, const v3d_t *b, v3d_t *out, size_t n) {
+  mvla__f64_sub((const double *) a, (const double *) b, (double *) out, n * 3);
+}
+
+MVLAIMPL void v3d_mul_n(const v3d_t *a, const v3d_t *b, v3d_t *out, size_t n) {
+  mvla__f64_mul((const double *) a, (const double *) b, (double *) out, n * 3);
+}
+
+MVLAIMPL void v3d_fma_n(const v3d_t *a, const v3d_t *b, const v3d_t *c, v3d_t *out, size_t n) {
+  mvla__f64_fma((const double *) a, (const double *) b, (const double *) c, (double *) out, n * 3);
+}
+
+MVLAIMPL void v3d_fms_n(const v3d_t *a, const v3d_t *b, const v3d_t *c, v3d_t *out, size_t n) {
+  mvla__f64_fms((const double *) a, (const double *) b, (const double *) c, (double *) out, n * 3);
+}
+
+MVLAIMPL void v3d_div_n(const v3d_t *a, const v3d_t *b, v3d_t *out, size_t n) {
+  mvla__f64_div((const double *) a, (const double *) b, (double *) out, n * 3);
+}
+
+MVLAIMPL void v3d_min_n(const v3d_t *a, const v3d_t *b, v3d_t *out, size_t n) {
+  mvla__f64_min((const double *) a, (const double *) b, (double *) out, n * 3);
+}
+
+MVLAIMPL void v3d_max_n(const v3d_t *a, const v3d_t *b, v3d_t *out, size_t n) {
+  mvla__f64_max((const double *) a, (const double *) b, (double *) out, n * 3);
+}
+
+MVLAIMPL void v3d_poww_n(const v3d_t *a, double exp, v3d_t *out, size_t n) {
+  mvla__f64_poww((const double *) a, exp, (double *) out, n * 3);
+}
+
+MVLAIMPL void v3d_pow_n(const v3d_t *a, const v3d_t *exp, v3d_t *out, size_t n) {
+  mvla__f64_pow((const double *) a, (const double *) exp, (double *) out, n * 3);
+}
+
+MVLAIMPL void v3d_sqrt_n(const v3d_t *a, v3d_t *out, size_t n) {
+  mvla__f64_sqrt((const double *) a, (double *) out, n * 3);
+}
+
+MVLAIMPL void v3d_exp_n(const v3d_t *a, v3d_t *out, size_t n) {
+  mvla__f64_exp((const double *) a, (double *) out, n * 3);
+}
+
+MVLAIMPL void v3d_sin_n(const v3d_t *a, v3d_t *out, size_t n) {
+  mvla__f64_sin((const double *) a, (double *) out, n * 3);
+}
+
+MVLAIMPL void v3d_cos_n(const v3d_t *a, v3d_t *out, size_t n) {
+  mvla__f64_cos((const double *) a, (double *) out, n * 3);
+}
+
+MVLAIMPL void v3d_tan_n(const v3d_t *a, v3d_t *out, size_t n) {
+  mvla__f64_tan((const double *) a, (double *) out, n * 3);
+}
+
+MVLAIMPL void v3d_sincos_n(const v3d_t *a, v3d_t *s, v3d_t *c, size_t n) {
+  mvla__f64_sincos((const double *) a, (double *) s, (double *) c, n * 3);
+}
+
+MVLAIMPL void v3d_len_n(const v3d_t *a, double *out, size_t n) {
+  mvla__v3d_sqr_len(a, out, n, 1);
+}
+
+MVLAIMPL void v3d_sqr_len_n(const v3d_t *a, double *out, size_t n) {
+  mvla__v3d_sqr_len(a, out, n, 0);
+}
+
+MVLAIMPL void v4i_add_n(const v4i_t *a, const v4i_t *b, v4i_t *out, size_t n) {
+  mvla__i32_add((const signed int *) a, (const signed int *) b, (signed int *) out, n * 4);
+}
+
+MVLAIMPL void v4i_sub_n(const v4i_t *a, const v4i_t *b, v4i_t *out, size_t n) {
+  mvla__i32_sub((const signed int *) a, (const signed int *) b, (signed int *) out, n * 4);
+}
+
+MVLAIMPL void v4i_mul_n(const v4i_t *a, const v4i_t *b, v4i_t *out, size_t n) {
+  mvla__i32_mul((const signed int *) a, (const signed int *) b, (signed int *) out, n * 4);
+}
+
+MVLAIMPL void v4i_div_n(const v4i_t *a, const v4i_t *b, v4i_t *out, size_t n) {
+  mvla__i32_div((const signed int *) a, (const signed int *) b, (signed int *) out, n * 4);
+}
+
+MVLAIMPL void v4i_min_n(const v4i_t *a, const v4i_t *b, v4i_t *out, size_t n) {
+  mvla__i32_min((const signed int *) a, (const signed int *) b, (signed int *) out, n * 4);
+}
+
+MVLAIMPL void v4i_max_n(const v4i_t *a, const v4i_t *b, v4i_t *out, size_t n) {
+  mvla__i32_max((const signed int *) a, (const signed int *) b, (signed int *) out, n * 4);
+}
+
+MVLAIMPL void v4u_add_n(const v4u_t *a, const v4u_t *b, v4u_t *out, size_t n) {
+  mvla__u32_add((const unsigned int *) a, (const unsigned int *) b, (unsigned int *) out, n * 4);
+}
+
+MVLAIMPL void v4u_sub_n(const v4u_t *a, const v4u_t *b, v4u_t *out, size_t n) {
+  mvla__u32_sub((const unsigned int *) a, (const unsigned int *) b, (unsigned int *) out, n * 4);
+}
+
+MVLAIMPL void v4u_mul_n(const v4u_t *a, const v4u_t *b, v4u_t *out, size_t n) {
+  mvla__u32_mul((const unsigned int *) a, (const unsigned int *) b, (unsigned int *) out, n * 4);
+}
+
+MVLAIMPL void v4u_div_n(const v4u_t *a, const v4u_t *b, v4u_t *out, size_t n) {
+  mvla__u32_div((const unsigned int *) a, (const unsigned int *) b, (unsigned int *) out, n * 4);
+}
+
+MVLAIMPL void v4u_min_n(const v4u_t *a, const v4u_t *b, v4u_t *out, size_t n) {
+  mvla__u32_min((const unsigned int *) a, (const unsigned int *) b, (unsigned int *) out, n * 4);
+}
+
+MVLAIMPL void v4u_max_n(const v4u_t *a, const v4u_t *b, v4u_t *out, size_t n) {
+  mvla__u32_max((const unsigned int *) a, (const unsigned int *) b, (unsigned int *) out, n * 4);
+}
+
+MVLAIMPL void v4f_add_n(const v4f_t *a, const v4f_t *b, v4f_t *out, size_t n) {
+  mvla__f32_add((const float *) a, (const float *) b, (float *) out, n * 4);
+}
+
+MVLAIMPL void v4f_sub_n(const v4f_t *a, const v4f_t *b, v4f_t *out, size_t n) {
+  mvla__f32_sub((const float *) a, (const float *) b, (float *) out, n * 4);
+}
+
+MVLAIMPL void v4f_mul_n(const v4f_t *a, const v4f_t *b, v4f_t *out, size_t n) {
+  mvla__f32_mul((const float *) a, (const float *) b, (float *) out, n * 4);
+}
+
+MVLAIMPL void v4f_fma_n(const v4f_t *a, const v4f_t *b, const v4f_t *c, v4f_t *out, size_t n) {
+  mvla__f32_fma((const float *) a, (const float *) b, (const float *) c, (float *) out, n * 4);
+}
+
+MVLAIMPL void v4f_fms_n(const v4f_t *a, const v4f_t *b, const v4f_t *c, v4f_t *out, size_t n) {
+  mvla__f32_fms((const float *) a, (const float *) b, (const float *) c, (float *) out, n * 4);
+}
+
+MVLAIMPL void v4f_div_n(const v4f_t *a, const v4f_t *b, v4f_t *out, size_t n) {
+  mvla__f32_div((const float *) a, (const float *) b, (float *) out, n * 4);
+}
+
+MVLAIMPL void v4f_min_n(const v4f_t *a, const v4f_t *b, v4f_t *out, size_t n) {
+  mvla__f32_min((const float *) a, (const float *) b, (float *) out, n * 4);
+}
+
+MVLAIMPL void v4f_max_n(const v4f_t *a, const v4f_t *b, v4f_t *out, size_t n) {
+  mvla__f32_max((const float *) a, (const float *) b, (float *) out, n * 4);
+}
+
+MVLAIMPL void v4f_poww_n(const v4f_t *a, float exp, v4f_t *out, size_t n) {
+  mvla__f32_poww((const float *) a, exp, (float *) out, n * 4);
+}
+
+MVLAIMPL void v4f_pow_n(const v4f_t *a, const v4f_t *exp, v4f_t *out, size_t n) {
+  mvla__f32_pow((const float *) a, (const float *) exp, (float *) out, n * 4);
+}
+
+MVLAIMPL void v4f_sqrt_n(const v4f_t *a, v4f_t *out, size_t n) {
+  mvla__f32_sqrt((const float *) a, (float *) out, n * 4);
+}
+
+MVLAIMPL void v4f_exp_n(const v4f_t *a, v4f_t *out, size_t n) {
+  mvla__f32_exp((const float *) a, (float *) out, n * 4);
+}
+
+MVLAIMPL void v4f_sin_n(const v4f_t *a, v4f_t *out, size_t n) {
+  mvla__f32_sin((const float *) a, (float *) out, n * 4);
+}
+
+MVLAIMPL void v4f_cos_n(const v4f_t *a, v4f_t *out, size_t n) {
+  mvla__f32_cos((const float *) a, (float *) out, n * 4);
+}
+
+MVLAIMPL void v4f_tan_n(const v4f_t *a, v4f_t *out, size_t n) {
+  mvla__f32_tan((const float *) a, (float *) out, n * 4);
+}
+
+MVLAIMPL void v4f_sincos_n(const v4f_t *a, v4f_t *s, v4f_t *c, size_t n) {
+  mvla__f32_sincos((const float *) a, (float *) s, (float *) c, n * 4);
+}
+
+MVLAIMPL void v4f_len_n(const v4f_t *a, float *out, size_t n) {
+  mvla__v4f_sqr_len(a, out, n, 1);
+}
+
+MVLAIMPL void v4f_sqr_len_n(const v4f_t *a, float *out, size_t n) {
+  mvla__v4f_sqr_len(a, out, n, 0);
+}
+
+MVLAIMPL void v4d_add_n(const v4d_t *a, const v4d_t *b, v4d_t *out, size_t n) {
+  mvla__f64_add((const double *) a, (const double *) b, (double *) out, n * 4);
+}
+
+MVLAIMPL void v4d_sub_n(const v4d_t *a, const v4d_t *b, v4d_t *out, size_t n) {
+  mvla__f64_sub((const double *) a, (const double *) b, (double *) out, n * 4);
+}
+
+MVLAIMPL void v4d_mul_n(const v4d_t *a, const v4d_t *b, v4d_t *out, size_t n) {
+  mvla__f64_mul((const double *) a, (const double *) b, (double *) out, n * 4);
+}
+
+MVLAIMPL void v4d_fma_n(const v4d_t *a, const v4d_t *b, const v4d_t *c, v4d_t *out, size_t n) {
+  mvla__f64_fma((const double *) a, (const double *) b, (const double *) c, (double *) out, n * 4);
+}
+
+MVLAIMPL void v4d_fms_n(const v4d_t *a, const v4d_t *b, const v4d_t *c, v4d_t *out, size_t n) {
+  mvla__f64_fms((const double *) a, (const double *) b, (const double *) c, (double *) out, n * 4);
+}
+
+MVLAIMPL void v4d_div_n(const v4d_t *a, const v4d_t *b, v4d_t *out, size_t n) {
+  mvla__f64_div((const double *) a, (const double *) b, (double *) out, n * 4);
+}
+
+MVLAIMPL void v4d_min_n(const v4d_t *a, const v4d_t *b, v4d_t *out, size_t n) {
+  mvla__f64_min((const double *) a, (const double *) b, (double *) out, n * 4);
+}
+
+MVLAIMPL void v4d_max_n(const v4d_t *a, const v4d_t *b, v4d_t *out, size_t n) {
+  mvla__f64_max((const double *) a, (const double *) b, (double *) out, n * 4);
+}
+
+MVLAIMPL void v4d_poww_n(const v4d_t *a, double exp, v4d_t *out, size_t n) {
+  mvla__f64_poww((const double *) a, exp, (double *) out, n * 4);
+}
+
+MVLAIMPL void v4d_pow_n(const v4d_t *a, const v4d_t *exp, v4d_t *out, size_t n) {
+  mvla__f64_pow((const double *) a, (const double *) exp, (double *) out, n * 4);
+}
+
+MVLAIMPL void v4d_sqrt_n(const v4d_t *a, v4d_t *out, size_t n) {
+  mvla__f64_sqrt((const double *) a, (double *) out, n * 4);
+}
+
+MVLAIMPL void v4d_exp_n(const v4d_t *a, v4d_t *out, size_t n) {
+  mvla__f64_exp((const double *) a, (double *) out, n * 4);
+}
+
+MVLAIMPL void v4d_sin_n(const v4d_t *a, v4d_t *out, size_t n) {
+  mvla__f64_sin((const double *) a, (double *) out, n * 4);
+}
+
+MVLAIMPL void v4d_cos_n(const v4d_t *a, v4d_t *out, size_t n) {
+  mvla__f64_cos((const double *) a, (double *) out, n * 4);
+}
+
+MVLAIMPL void v4d_tan_n(const v4d_t *a, v4d_t *out, size_t n) {
+  mvla__f64_tan((const double *) a, (double *) out, n * 4);
+}
+
+MVLAIMPL void v4d_sincos_n(const v4d_t *a, v4d_t *s, v4d_t *c, size_t n) {
+  mvla__f64_sincos((const double *) a, (double *) s, (double *) c, n * 4);
+}
+
+MVLAIMPL void v4d_len_n(const v4d_t *a, double *out, size_t n) {
+  mvla__v4d_sqr_len(a, out, n, 1);
+}
+
+MVLAIMPL void v4d_sqr_len_n(const v4d_t *a, double *out, size_t n) {
+  mvla__v4d_sqr_len(a, out, n, 0);
+}
+
+// -----------------------------------------
+
+/*
+** STRUCTURE-OF-ARRAYS KERNELS
+*/
+
+// bytes per component array, rounded up so every array starts aligned
+static inline size_t mvla__soa_stride(size_t n, size_t size) {
+  return (n * size + MVLA_SOA_ALIGN - 1) & ~((size_t) MVLA_SOA_ALIGN - 1);
+}
+
+// vertical length kernels over the component arrays, dispatched per tier
+static inline void mvla__f32_sqr_len2(const float *x, const float *y, float *out, size_t n, int root) {
+  mvla__f32_sqr_len_k(x, y, NULL, NULL, out, n, root);
+}
+
+static inline void mvla__f32_sqr_len3(const float *x, const float *y, const float *z,
+                                      float *out, size_t n, int root) {
+  mvla__f32_sqr_len_k(x, y, z, NULL, out, n, root);
+}
+
+static inline void mvla__f32_sqr_len4(const float *x, const float *y, const float *z,
+                                      const float *w, float *out, size_t n, int root) {
+  mvla__f32_sqr_len_k(x, y, z, w, out, n, root);
+}
+
+static inline void mvla__f64_sqr_len2(const double *x, const double *y, double *out, size_t n, int root) {
+  mvla__f64_sqr_len_k(x, y, NULL, NULL, out, n, root);
+}
+
+static inline void mvla__f64_sqr_len3(const double *x, const double *y, const double *z,
+                                      double *out, size_t n, int root) {
+  mvla__f64_sqr_len_k(x, y, z, NULL, out, n, root);
+}
+
+static inline void mvla__f64_sqr_len4(const double *x, const double *y, const double *z,
+                                      const double *w, double *out, size_t n, int root) {
+  mvla__f64_sqr_len_k(x, y, z, w, out, n, root);
+}
+
+// -----------------------------------------
+
+MVLAIMPL v2i_soa_t v2i_soa_alloc(size_t n) {
+  v2i_soa_t soa;
+  size_t stride = mvla__soa_stride(n, sizeof(signed int));
+  char *base = (char *) mvla__aligned_alloc(stride * 2, MVLA_SOA_ALIGN);
+  if (base == NULL) {
+    soa.x = NULL;
+    soa.y = NULL;
+    soa.count = 0;
+    return soa;
+  }
+  soa.x = (signed int *) (base + stride * 0);
+  soa.y = (signed int *) (base + stride * 1);
+  soa.count = n;
+  return soa;
+}
+
+MVLAIMPL void v2i_soa_free(v2i_soa_t *soa) {
+  mvla__aligned_free(soa->x);
+  soa->x = NULL;
+  soa->y = NULL;
+  soa->count = 0;
+}
+
+MVLAIMPL v2i_t v2i_soa_get(const v2i_soa_t *soa, size_t i) {
+  return v2i(soa->x[i], soa->y[i]);
+}
+
+MVLAIMPL void v2i_soa_set(v2i_soa_t *soa, size_t i, v2i_t a) {
+  soa->x[i] = a.x;
+  soa->y[i] = a.y;
+}
+
+MVLAIMPL void v2i_soa_add(const v2i_soa_t *a, const v2i_soa_t *b, v2i_soa_t *out) {
+  mvla__i32_add(a->x, b->x, out->x, a->count);
+  mvla__i32_add(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL void v2i_soa_sub(const v2i_soa_t *a, const v2i_soa_t *b, v2i_soa_t *out) {
+  mvla__i32_sub(a->x, b->x, out->x, a->count);
+  mvla__i32_sub(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL void v2i_soa_mul(const v2i_soa_t *a, const v2i_soa_t *b, v2i_soa_t *out) {
+  mvla__i32_mul(a->x, b->x, out->x, a->count);
+  mvla__i32_mul(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL void v2i_soa_div(const v2i_soa_t *a, const v2i_soa_t *b, v2i_soa_t *out) {
+  mvla__i32_div(a->x, b->x, out->x, a->count);
+  mvla__i32_div(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL void v2i_soa_min(const v2i_soa_t *a, const v2i_soa_t *b, v2i_soa_t *out) {
+  mvla__i32_min(a->x, b->x, out->x, a->count);
+  mvla__i32_min(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL void v2i_soa_max(const v2i_soa_t *a, const v2i_soa_t *b, v2i_soa_t *out) {
+  mvla__i32_max(a->x, b->x, out->x, a->count);
+  mvla__i32_max(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL v2u_soa_t v2u_soa_alloc(size_t n) {
+  v2u_soa_t soa;
+  size_t stride = mvla__soa_stride(n, sizeof(unsigned int));
+  char *base = (char *) mvla__aligned_alloc(stride * 2, MVLA_SOA_ALIGN);
+  if (base == NULL) {
+    soa.x = NULL;
+    soa.y = NULL;
+    soa.count = 0;
+    return soa;
+  }
+  soa.x = (unsigned int *) (base + stride * 0);
+  soa.y = (unsigned int *) (base + stride * 1);
+  soa.count = n;
+  return soa;
+}
+
+MVLAIMPL void v2u_soa_free(v2u_soa_t *soa) {
+  mvla__aligned_free(soa->x);
+  soa->x = NULL;
+  soa->y = NULL;
+  soa->count = 0;
+}
+
+MVLAIMPL v2u_t v2u_soa_get(const v2u_soa_t *soa, size_t i) {
+  return v2u(soa->x[i], soa->y[i]);
+}
+
+MVLAIMPL void v2u_soa_set(v2u_soa_t *soa, size_t i, v2u_t a) {
+  soa->x[i] = a.x;
+  soa->y[i] = a.y;
+}
+
+MVLAIMPL void v2u_soa_add(const v2u_soa_t *a, const v2u_soa_t *b, v2u_soa_t *out) {
+  mvla__u32_add(a->x, b->x, out->x, a->count);
+  mvla__u32_add(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL void v2u_soa_sub(const v2u_soa_t *a, const v2u_soa_t *b, v2u_soa_t *out) {
+  mvla__u32_sub(a->x, b->x, out->x, a->count);
+  mvla__u32_sub(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL void v2u_soa_mul(const v2u_soa_t *a, const v2u_soa_t *b, v2u_soa_t *out) {
+  mvla__u32_mul(a->x, b->x, out->x, a->count);
+  mvla__u32_mul(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL void v2u_soa_div(const v2u_soa_t *a, const v2u_soa_t *b, v2u_soa_t *out) {
+  mvla__u32_div(a->x, b->x, out->x, a->count);
+  mvla__u32_div(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL void v2u_soa_min(const v2u_soa_t *a, const v2u_soa_t *b, v2u_soa_t *out) {
+  mvla__u32_min(a->x, b->x, out->x, a->count);
+  mvla__u32_min(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL void v2u_soa_max(const v2u_soa_t *a, const v2u_soa_t *b, v2u_soa_t *out) {
+  mvla__u32_max(a->x, b->x, out->x, a->count);
+  mvla__u32_max(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL v2f_soa_t v2f_soa_alloc(size_t n) {
+  v2f_soa_t soa;
+  size_t stride = mvla__soa_stride(n, sizeof(float));
+  char *base = (char *) mvla__aligned_alloc(stride * 2, MVLA_SOA_ALIGN);
+  if (base == NULL) {
+    soa.x = NULL;
+    soa.y = NULL;
+    soa.count = 0;
+    return soa;
+  }
+  soa.x = (float *) (base + stride * 0);
+  soa.y = (float *) (base + stride * 1);
+  soa.count = n;
+  return soa;
+}
+
+MVLAIMPL void v2f_soa_free(v2f_soa_t *soa) {
+  mvla__aligned_free(soa->x);
+  soa->x = NULL;
+  soa->y = NULL;
+  soa->count = 0;
+}
+
+MVLAIMPL v2f_t v2f_soa_get(const v2f_soa_t *soa, size_t i) {
+  return v2f(soa->x[i], soa->y[i]);
+}
+
+MVLAIMPL void v2f_soa_set(v2f_soa_t *soa, size_t i, v2f_t a) {
+  soa->x[i] = a.x;
+  soa->y[i] = a.y;
+}
+
+MVLAIMPL void v2f_soa_add(const v2f_soa_t *a, const v2f_soa_t *b, v2f_soa_t *out) {
+  mvla__f32_add(a->x, b->x, out->x, a->count);
+  mvla__f32_add(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL void v2f_soa_sub(const v2f_soa_t *a, const v2f_soa_t *b, v2f_soa_t *out) {
+  mvla__f32_sub(a->x, b->x, out->x, a->count);
+  mvla__f32_sub(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL void v2f_soa_mul(const v2f_soa_t *a, const v2f_soa_t *b, v2f_soa_t *out) {
+  mvla__f32_mul(a->x, b->x, out->x, a->count);
+  mvla__f32_mul(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL void v2f_soa_div(const v2f_soa_t *a, const v2f_soa_t *b, v2f_soa_t *out) {
+  mvla__f32_div(a->x, b->x, out->x, a->count);
+  mvla__f32_div(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL void v2f_soa_min(const v2f_soa_t *a, const v2f_soa_t *b, v2f_soa_t *out) {
+  mvla__f32_min(a->x, b->x, out->x, a->count);
+  mvla__f32_min(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL void v2f_soa_max(const v2f_soa_t *a, const v2f_soa_t *b, v2f_soa_t *out) {
+  mvla__f32_max(a->x, b->x, out->x, a->count);
+  mvla__f32_max(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL void v2f_soa_pow(const v2f_soa_t *a, const v2f_soa_t *b, v2f_soa_t *out) {
+  mvla__f32_pow(a->x, b->x, out->x, a->count);
+  mvla__f32_pow(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL void v2f_soa_sqrt(const v2f_soa_t *a, v2f_soa_t *out) {
+  mvla__f32_sqrt(a->x, out->x, a->count);
+  mvla__f32_sqrt(a->y, out->y, a->count);
+}
+
+MVLAIMPL void v2f_soa_exp(const v2f_soa_t *a, v2f_soa_t *out) {
+  mvla__f32_exp(a->x, out->x, a->count);
+  mvla__f32_exp(a->y, out->y, a->count);
+}
+
+MVLAIMPL void v2f_soa_sin(const v2f_soa_t *a, v2f_soa_t *out) {
+  mvla__f32_sin(a->x, out->x, a->count);
+  mvla__f32_sin(a->y, out->y, a->count);
+}
+
+MVLAIMPL void v2f_soa_cos(const v2f_soa_t *a, v2f_soa_t *out) {
+  mvla__f32_cos(a->x, out->x, a->count);
+  mvla__f32_cos(a->y, out->y, a->count);
+}
+
+MVLAIMPL void v2f_soa_tan(const v2f_soa_t *a, v2f_soa_t *out) {
+  mvla__f32_tan(a->x, out->x, a->count);
+  mvla__f32_tan(a->y, out->y, a->count);
+}
+
+MVLAIMPL void v2f_soa_sincos(const v2f_soa_t *a, v2f_soa_t *s, v2f_soa_t *c) {
+  mvla__f32_sincos(a->x, s->x, c->x, a->count);
+  mvla__f32_sincos(a->y, s->y, c->y, a->count);
+}
+
+MVLAIMPL void v2f_soa_len(const v2f_soa_t *a, float *out) {
+  mvla__f32_sqr_len2(a->x, a->y, out, a->count, 1);
+}
+
+MVLAIMPL void v2f_soa_sqr_len(const v2f_soa_t *a, float *out) {
+  mvla__f32_sqr_len2(a->x, a->y, out, a->count, 0);
+}
+
+MVLAIMPL v2d_soa_t v2d_soa_alloc(size_t n) {
+  v2d_soa_t soa;
+  size_t stride = mvla__soa_stride(n, sizeof(double));
+  char *base = (char *) mvla__aligned_alloc(stride * 2, MVLA_SOA_ALIGN);
+  if (base == NULL) {
+    soa.x = NULL;
+    soa.y = NULL;
+    soa.count = 0;
+    return soa;
+  }
+  soa.x = (double *) (base + stride * 0);
+  soa.y = (double *) (base + stride * 1);
+  soa.count = n;
+  return soa;
+}
+
+MVLAIMPL void v2d_soa_free(v2d_soa_t *soa) {
+  mvla__aligned_free(soa->x);
+  soa->x = NULL;
+  soa->y = NULL;
+  soa->count = 0;
+}
+
+MVLAIMPL v2d_t v2d_soa_get(const v2d_soa_t *soa, size_t i) {
+  return v2d(soa->x[i], soa->y[i]);
+}
+
+MVLAIMPL void v2d_soa_set(v2d_soa_t *soa, size_t i, v2d_t a) {
+  soa->x[i] = a.x;
+  soa->y[i] = a.y;
+}
+
+MVLAIMPL void v2d_soa_add(const v2d_soa_t *a, const v2d_soa_t *b, v2d_soa_t *out) {
+  mvla__f64_add(a->x, b->x, out->x, a->count);
+  mvla__f64_add(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL void v2d_soa_sub(const v2d_soa_t *a, const v2d_soa_t *b, v2d_soa_t *out) {
+  mvla__f64_sub(a->x, b->x, out->x, a->count);
+  mvla__f64_sub(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL void v2d_soa_mul(const v2d_soa_t *a, const v2d_soa_t *b, v2d_soa_t *out) {
+  mvla__f64_mul(a->x, b->x, out->x, a->count);
+  mvla__f64_mul(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL void v2d_soa_div(const v2d_soa_t *a, const v2d_soa_t *b, v2d_soa_t *out) {
+  mvla__f64_div(a->x, b->x, out->x, a->count);
+  mvla__f64_div(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL void v2d_soa_min(const v2d_soa_t *a, const v2d_soa_t *b, v2d_soa_t *out) {
+  mvla__f64_min(a->x, b->x, out->x, a->count);
+  mvla__f64_min(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL void v2d_soa_max(const v2d_soa_t *a, const v2d_soa_t *b, v2d_soa_t *out) {
+  mvla__f64_max(a->x, b->x, out->x, a->count);
+  mvla__f64_max(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL void v2d_soa_pow(const v2d_soa_t *a, const v2d_soa_t *b, v2d_soa_t *out) {
+  mvla__f64_pow(a->x, b->x, out->x, a->count);
+  mvla__f64_pow(a->y, b->y, out->y, a->count);
+}
+
+MVLAIMPL void v2d_soa_sqrt(const v2d_soa_t *a, v2d_soa_t *out) {
+  mvla__f64_sqrt(a->x, out->x, a->count);
+  mvla__f64_sqrt(a->y, out->y, a->count);
+}
+
+MVLAIMPL void v2d_soa_exp(const v2d_soa_t *a, v2d_soa_t *out) {
+  mvla__f64_exp(a->x, out->x, a->count);
+  mvla__f64_exp(a->y, out->y, a->count);
+}
+
+MVLAIMPL void v2d_soa_sin(const v2d_soa_t *a, v2d_soa_t *out) {
+  mvla__f64_sin(a->x, out->x, a->count);
+  mvla__f64_sin(a->y, out->y, a->count);
+}
+
+MVLAIMPL void v2d_soa_cos(const v2d_soa_t *a, v2d_soa_t *out) {
+  mvla__f64_cos(a->x, out->x, a->count);
+  mvla__f64_cos(a->y, out->y, a->count);
+}
+
+MVLAIMPL void v2d_soa_tan(const v2d_soa_t *a, v2d_soa_t *out) {
+  mvla__f64_tan(a->x, out->x, a->count);
+  mvla__f64_tan(a->y, out->y, a->count);
+}
+
+MVLAIMPL void v2d_soa_sincos(const v2d_soa_t *a, v2d_soa_t *s, v2d_soa_t *c) {
+  mvla__f64_sincos(a->x, s->x, c->x, a->count);
+  mvla__f64_sincos(a->y, s->y, c->y, a->count);
+}
+
+MVLAIMPL void v2d_soa_len(const v2d_soa_t *a, double *out) {
+  mvla__f64_sqr_len2(a->x, a->y, out, a->count, 1);
+}
+
+MVLAIMPL void v2d_soa_sqr_len(const v2d_soa_t *a, double *out) {
+  mvla__f64_sqr_len2(a->x, a->y, out, a->count, 0);
+}
+
+MVLAIMPL v3i_soa_t v3i_soa_alloc(size_t n) {
+  v3i_soa_t soa;
+  size_t stride = mvla__soa_stride(n, sizeof(signed int));
+  char *base = (char *) mvla__aligned_alloc(stride * 3, MVLA_SOA_ALIGN);
+  if (base == NULL) {
+    soa.x = NULL;
+    soa.y = NULL;
+    soa.z = NULL;
+    soa.count = 0;
+    return soa;
+  }
+  soa.x = (signed int *) (base + stride * 0);
+  soa.y = (signed int *) (base + stride * 1);
+  soa.z = (signed int *) (base + stride * 2);
+  soa.count = n;
+  return soa;
+}
+
+MVLAIMPL void v3i_soa_free(v3i_soa_t *soa) {
+  mvla__aligned_free(soa->x);
+  soa->x = NULL;
+  soa->y = NULL;
+  soa->z = NULL;
+  soa->count = 0;
+}
+
+MVLAIMPL v3i_t v3i_soa_get(const v3i_soa_t *soa, size_t i) {
+  return v3i(soa->x[i], soa->y[i], soa->z[i]);
+}
+
+MVLAIMPL void v3i_soa_set(v3i_soa_t *soa, size_t i, v3i_t a) {
+  soa->x[i] = a.x;
+  soa->y[i] = a.y;
+  soa->z[i] = a.z;
+}
+
+MVLAIMPL void v3i_soa_add(const v3i_soa_t *a, const v3i_soa_t *b, v3i_soa_t *out) {
+  mvla__i32_add(a->x, b->x, out->x, a->count);
+  mvla__i32_add(a->y, b->y, out->y, a->count);
+  mvla__i32_add(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL void v3i_soa_sub(const v3i_soa_t *a, const v3i_soa_t *b, v3i_soa_t *out) {
+  mvla__i32_sub(a->x, b->x, out->x, a->count);
+  mvla__i32_sub(a->y, b->y, out->y, a->count);
+  mvla__i32_sub(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL void v3i_soa_mul(const v3i_soa_t *a, const v3i_soa_t *b, v3i_soa_t *out) {
+  mvla__i32_mul(a->x, b->x, out->x, a->count);
+  mvla__i32_mul(a->y, b->y, out->y, a->count);
+  mvla__i32_mul(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL void v3i_soa_div(const v3i_soa_t *a, const v3i_soa_t *b, v3i_soa_t *out) {
+  mvla__i32_div(a->x, b->x, out->x, a->count);
+  mvla__i32_div(a->y, b->y, out->y, a->count);
+  mvla__i32_div(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL void v3i_soa_min(const v3i_soa_t *a, const v3i_soa_t *b, v3i_soa_t *out) {
+  mvla__i32_min(a->x, b->x, out->x, a->count);
+  mvla__i32_min(a->y, b->y, out->y, a->count);
+  mvla__i32_min(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL void v3i_soa_max(const v3i_soa_t *a, const v3i_soa_t *b, v3i_soa_t *out) {
+  mvla__i32_max(a->x, b->x, out->x, a->count);
+  mvla__i32_max(a->y, b->y, out->y, a->count);
+  mvla__i32_max(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL v3u_soa_t v3u_soa_alloc(size_t n) {
+  v3u_soa_t soa;
+  size_t stride = mvla__soa_stride(n, sizeof(unsigned int));
+  char *base = (char *) mvla__aligned_alloc(stride * 3, MVLA_SOA_ALIGN);
+  if (base == NULL) {
+    soa.x = NULL;
+    soa.y = NULL;
+    soa.z = NULL;
+    soa.count = 0;
+    return soa;
+  }
+  soa.x = (unsigned int *) (base + stride * 0);
+  soa.y = (unsigned int *) (base + stride * 1);
+  soa.z = (unsigned int *) (base + stride * 2);
+  soa.count = n;
+  return soa;
+}
+
+MVLAIMPL void v3u_soa_free(v3u_soa_t *soa) {
+  mvla__aligned_free(soa->x);
+  soa->x = NULL;
+  soa->y = NULL;
+  soa->z = NULL;
+  soa->count = 0;
+}
+
+MVLAIMPL v3u_t v3u_soa_get(const v3u_soa_t *soa, size_t i) {
+  return v3u(soa->x[i], soa->y[i], soa->z[i]);
+}
+
+MVLAIMPL void v3u_soa_set(v3u_soa_t *soa, size_t i, v3u_t a) {
+  soa->x[i] = a.x;
+  soa->y[i] = a.y;
+  soa->z[i] = a.z;
+}
+
+MVLAIMPL void v3u_soa_add(const v3u_soa_t *a, const v3u_soa_t *b, v3u_soa_t *out) {
+  mvla__u32_add(a->x, b->x, out->x, a->count);
+  mvla__u32_add(a->y, b->y, out->y, a->count);
+  mvla__u32_add(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL void v3u_soa_sub(const v3u_soa_t *a, const v3u_soa_t *b, v3u_soa_t *out) {
+  mvla__u32_sub(a->x, b->x, out->x, a->count);
+  mvla__u32_sub(a->y, b->y, out->y, a->count);
+  mvla__u32_sub(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL void v3u_soa_mul(const v3u_soa_t *a, const v3u_soa_t *b, v3u_soa_t *out) {
+  mvla__u32_mul(a->x, b->x, out->x, a->count);
+  mvla__u32_mul(a->y, b->y, out->y, a->count);
+  mvla__u32_mul(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL void v3u_soa_div(const v3u_soa_t *a, const v3u_soa_t *b, v3u_soa_t *out) {
+  mvla__u32_div(a->x, b->x, out->x, a->count);
+  mvla__u32_div(a->y, b->y, out->y, a->count);
+  mvla__u32_div(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL void v3u_soa_min(const v3u_soa_t *a, const v3u_soa_t *b, v3u_soa_t *out) {
+  mvla__u32_min(a->x, b->x, out->x, a->count);
+  mvla__u32_min(a->y, b->y, out->y, a->count);
+  mvla__u32_min(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL void v3u_soa_max(const v3u_soa_t *a, const v3u_soa_t *b, v3u_soa_t *out) {
+  mvla__u32_max(a->x, b->x, out->x, a->count);
+  mvla__u32_max(a->y, b->y, out->y, a->count);
+  mvla__u32_max(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL v3f_soa_t v3f_soa_alloc(size_t n) {
+  v3f_soa_t soa;
+  size_t stride = mvla__soa_stride(n, sizeof(float));
+  char *base = (char *) mvla__aligned_alloc(stride * 3, MVLA_SOA_ALIGN);
+  if (base == NULL) {
+    soa.x = NULL;
+    soa.y = NULL;
+    soa.z = NULL;
+    soa.count = 0;
+    return soa;
+  }
+  soa.x = (float *) (base + stride * 0);
+  soa.y = (float *) (base + stride * 1);
+  soa.z = (float *) (base + stride * 2);
+  soa.count = n;
+  return soa;
+}
+
+MVLAIMPL void v3f_soa_free(v3f_soa_t *soa) {
+  mvla__aligned_free(soa->x);
+  soa->x = NULL;
+  soa->y = NULL;
+  soa->z = NULL;
+  soa->count = 0;
+}
+
+MVLAIMPL v3f_t v3f_soa_get(const v3f_soa_t *soa, size_t i) {
+  return v3f(soa->x[i], soa->y[i], soa->z[i]);
+}
+
+MVLAIMPL void v3f_soa_set(v3f_soa_t *soa, size_t i, v3f_t a) {
+  soa->x[i] = a.x;
+  soa->y[i] = a.y;
+  soa->z[i] = a.z;
+}
+
+MVLAIMPL void v3f_soa_add(const v3f_soa_t *a, const v3f_soa_t *b, v3f_soa_t *out) {
+  mvla__f32_add(a->x, b->x, out->x, a->count);
+  mvla__f32_add(a->y, b->y, out->y, a->count);
+  mvla__f32_add(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL void v3f_soa_sub(const v3f_soa_t *a, const v3f_soa_t *b, v3f_soa_t *out) {
+  mvla__f32_sub(a->x, b->x, out->x, a->count);
+  mvla__f32_sub(a->y, b->y, out->y, a->count);
+  mvla__f32_sub(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL void v3f_soa_mul(const v3f_soa_t *a, const v3f_soa_t *b, v3f_soa_t *out) {
+  mvla__f32_mul(a->x, b->x, out->x, a->count);
+  mvla__f32_mul(a->y, b->y, out->y, a->count);
+  mvla__f32_mul(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL void v3f_soa_div(const v3f_soa_t *a, const v3f_soa_t *b, v3f_soa_t *out) {
+  mvla__f32_div(a->x, b->x, out->x, a->count);
+  mvla__f32_div(a->y, b->y, out->y, a->count);
+  mvla__f32_div(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL void v3f_soa_min(const v3f_soa_t *a, const v3f_soa_t *b, v3f_soa_t *out) {
+  mvla__f32_min(a->x, b->x, out->x, a->count);
+  mvla__f32_min(a->y, b->y, out->y, a->count);
+  mvla__f32_min(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL void v3f_soa_max(const v3f_soa_t *a, const v3f_soa_t *b, v3f_soa_t *out) {
+  mvla__f32_max(a->x, b->x, out->x, a->count);
+  mvla__f32_max(a->y, b->y, out->y, a->count);
+  mvla__f32_max(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL void v3f_soa_pow(const v3f_soa_t *a, const v3f_soa_t *b, v3f_soa_t *out) {
+  mvla__f32_pow(a->x, b->x, out->x, a->count);
+  mvla__f32_pow(a->y, b->y, out->y, a->count);
+  mvla__f32_pow(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL void v3f_soa_sqrt(const v3f_soa_t *a, v3f_soa_t *out) {
+  mvla__f32_sqrt(a->x, out->x, a->count);
+  mvla__f32_sqrt(a->y, out->y, a->count);
+  mvla__f32_sqrt(a->z, out->z, a->count);
+}
+
+MVLAIMPL void v3f_soa_exp(const v3f_soa_t *a, v3f_soa_t *out) {
+  mvla__f32_exp(a->x, out->x, a->count);
+  mvla__f32_exp(a->y, out->y, a->count);
+  mvla__f32_exp(a->z, out->z, a->count);
+}
+
+MVLAIMPL void v3f_soa_sin(const v3f_soa_t *a, v3f_soa_t *out) {
+  mvla__f32_sin(a->x, out->x, a->count);
+  mvla__f32_sin(a->y, out->y, a->count);
+  mvla__f32_sin(a->z, out->z, a->count);
+}
+
+MVLAIMPL void v3f_soa_cos(const v3f_soa_t *a, v3f_soa_t *out) {
+  mvla__f32_cos(a->x, out->x, a->count);
+  mvla__f32_cos(a->y, out->y, a->count);
+  mvla__f32_cos(a->z, out->z, a->count);
+}
+
+MVLAIMPL void v3f_soa_tan(const v3f_soa_t *a, v3f_soa_t *out) {
+  mvla__f32_tan(a->x, out->x, a->count);
+  mvla__f32_tan(a->y, out->y, a->count);
+  mvla__f32_tan(a->z, out->z, a->count);
+}
+
+MVLAIMPL void v3f_soa_sincos(const v3f_soa_t *a, v3f_soa_t *s, v3f_soa_t *c) {
+  mvla__f32_sincos(a->x, s->x, c->x, a->count);
+  mvla__f32_sincos(a->y, s->y, c->y, a->count);
+  mvla__f32_sincos(a->z, s->z, c->z, a->count);
+}
+
+MVLAIMPL void v3f_soa_len(const v3f_soa_t *a, float *out) {
+  mvla__f32_sqr_len3(a->x, a->y, a->z, out, a->count, 1);
+}
+
+MVLAIMPL void v3f_soa_sqr_len(const v3f_soa_t *a, float *out) {
+  mvla__f32_sqr_len3(a->x, a->y, a->z, out, a->count, 0);
+}
+
+MVLAIMPL v3d_soa_t v3d_soa_alloc(size_t n) {
+  v3d_soa_t soa;
+  size_t stride = mvla__soa_stride(n, sizeof(double));
+  char *base = (char *) mvla__aligned_alloc(stride * 3, MVLA_SOA_ALIGN);
+  if (base == NULL) {
+    soa.x = NULL;
+    soa.y = NULL;
+    soa.z = NULL;
+    soa.count = 0;
+    return soa;
+  }
+  soa.x = (double *) (base + stride * 0);
+  soa.y = (double *) (base + stride * 1);
+  soa.z = (double *) (base + stride * 2);
+  soa.count = n;
+  return soa;
+}
+
+MVLAIMPL void v3d_soa_free(v3d_soa_t *soa) {
+  mvla__aligned_free(soa->x);
+  soa->x = NULL;
+  soa->y = NULL;
+  soa->z = NULL;
+  soa->count = 0;
+}
+
+MVLAIMPL v3d_t v3d_soa_get(const v3d_soa_t *soa, size_t i) {
+  return v3d(soa->x[i], soa->y[i], soa->z[i]);
+}
+
+MVLAIMPL void v3d_soa_set(v3d_soa_t *soa, size_t i, v3d_t a) {
+  soa->x[i] = a.x;
+  soa->y[i] = a.y;
+  soa->z[i] = a.z;
+}
+
+MVLAIMPL void v3d_soa_add(const v3d_soa_t *a, const v3d_soa_t *b, v3d_soa_t *out) {
+  mvla__f64_add(a->x, b->x, out->x, a->count);
+  mvla__f64_add(a->y, b->y, out->y, a->count);
+  mvla__f64_add(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL void v3d_soa_sub(const v3d_soa_t *a, const v3d_soa_t *b, v3d_soa_t *out) {
+  mvla__f64_sub(a->x, b->x, out->x, a->count);
+  mvla__f64_sub(a->y, b->y, out->y, a->count);
+  mvla__f64_sub(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL void v3d_soa_mul(const v3d_soa_t *a, const v3d_soa_t *b, v3d_soa_t *out) {
+  mvla__f64_mul(a->x, b->x, out->x, a->count);
+  mvla__f64_mul(a->y, b->y, out->y, a->count);
+  mvla__f64_mul(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL void v3d_soa_div(const v3d_soa_t *a, const v3d_soa_t *b, v3d_soa_t *out) {
+  mvla__f64_div(a->x, b->x, out->x, a->count);
+  mvla__f64_div(a->y, b->y, out->y, a->count);
+  mvla__f64_div(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL void v3d_soa_min(const v3d_soa_t *a, const v3d_soa_t *b, v3d_soa_t *out) {
+  mvla__f64_min(a->x, b->x, out->x, a->count);
+  mvla__f64_min(a->y, b->y, out->y, a->count);
+  mvla__f64_min(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL void v3d_soa_max(const v3d_soa_t *a, const v3d_soa_t *b, v3d_soa_t *out) {
+  mvla__f64_max(a->x, b->x, out->x, a->count);
+  mvla__f64_max(a->y, b->y, out->y, a->count);
+  mvla__f64_max(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL void v3d_soa_pow(const v3d_soa_t *a, const v3d_soa_t *b, v3d_soa_t *out) {
+  mvla__f64_pow(a->x, b->x, out->x, a->count);
+  mvla__f64_pow(a->y, b->y, out->y, a->count);
+  mvla__f64_pow(a->z, b->z, out->z, a->count);
+}
+
+MVLAIMPL void v3d_soa_sqrt(const v3d_soa_t *a, v3d_soa_t *out) {
+  mvla__f64_sqrt(a->x, out->x, a->count);
+  mvla__f64_sqrt(a->y, out->y, a->count);
+  mvla__f64_sqrt(a->z, out->z, a->count);
+}
+
+MVLAIMPL void v3d_soa_exp(const v3d_soa_t *a, v3d_soa_t *out) {
+  mvla__f64_exp(a->x, out->x, a->count);
+  mvla__f64_exp(a->y, out->y, a->count);
+  mvla__f64_exp(a->z, out->z, a->count);
+}
+
+MVLAIMPL void v3d_soa_sin(const v3d_soa_t *a, v3d_soa_t *out) {
+  mvla__f64_sin(a->x, out->x, a->count);
+  mvla__f64_sin(a->y, out->y, a->count);
+  mvla__f64_sin(a->z, out->z, a->count);
+}
+
+MVLAIMPL void v3d_soa_cos(const v3d_soa_t *a, v3d_soa_t *out) {
+  mvla__f64_cos(a->x, out->x, a->count);
+  mvla__f64_cos(a->y, out->y, a->count);
+  mvla__f64_cos(a->z, out->z, a->count);
+}
+
+MVLAIMPL void v3d_soa_tan(const v3d_soa_t *a, v3d_soa_t *out) {
+  mvla__f64_tan(a->x, out->x, a->count);
+  mvla__f64_tan(a->y, out->y, a->count);
+  mvla__f64_tan(a->z, out->z, a->count);
+}
+
+MVLAIMPL void v3d_soa_sincos(const v3d_soa_t *a, v3d_soa_t *s, v3d_soa_t *c) {
+  mvla__f64_sincos(a->x, s->x, c->x, a->count);
+  mvla__f64_sincos(a->y, s->y, c->y, a->count);
+  mvla__f64_sincos(a->z, s->z, c->z, a->count);
+}
+
+MVLAIMPL void v3d_soa_len(const v3d_soa_t *a, double *out) {
+  mvla__f64_sqr_len3(a->x, a->y, a->z, out, a->count, 1);
+}
+
+MVLAIMPL void v3d_soa_sqr_len(const v3d_soa_t *a, double *out) {
+  mvla__f64_sqr_len3(a->x, a->y, a->z, out, a->count, 0);
+}
+
+MVLAIMPL v4i_soa_t v4i_soa_alloc(size_t n) {
+  v4i_soa_t soa;
+  size_t stride = mvla__soa_stride(n, sizeof(signed int));
+  char *base = (char *) mvla__aligned_alloc(stride * 4, MVLA_SOA_ALIGN);
+  if (base == NULL) {
+    soa.x = NULL;
+    soa.y = NULL;
+    soa.z = NULL;
+    soa.w = NULL;
+    soa.count = 0;
+    return soa;
+  }
+  soa.x = (signed int *) (base + stride * 0);
+  soa.y = (signed int *) (base + stride * 1);
+  soa.z = (signed int *) (base + stride * 2);
+  soa.w = (signed int *) (base + stride * 3);
+  soa.count = n;
+  return soa;
+}
+
+MVLAIMPL void v4i_soa_free(v4i_soa_t *soa) {
+  mvla__aligned_free(soa->x);
+  soa->x = NULL;
+  soa->y = NULL;
+  soa->z = NULL;
+  soa->w = NULL;
+  soa->count = 0;
+}
+
+MVLAIMPL v4i_t v4i_soa_get(const v4i_soa_t *soa, size_t i) {
+  return v4i(soa->x[i], soa->y[i], soa->z[i], soa->w[i]);
+}
+
+MVLAIMPL void v4i_soa_set(v4i_soa_t *soa, size_t i, v4i_t a) {
+  soa->x[i] = a.x;
+  soa->y[i] = a.y;
+  soa->z[i] = a.z;
+  soa->w[i] = a.w;
+}
+
+MVLAIMPL void v4i_soa_add(const v4i_soa_t *a, const v4i_soa_t *b, v4i_soa_t *out) {
+  mvla__i32_add(a->x, b->x, out->x, a->count);
+  mvla__i32_add(a->y, b->y, out->y, a->count);
+  mvla__i32_add(a->z, b->z, out->z, a->count);
+  mvla__i32_add(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL void v4i_soa_sub(const v4i_soa_t *a, const v4i_soa_t *b, v4i_soa_t *out) {
+  mvla__i32_sub(a->x, b->x, out->x, a->count);
+  mvla__i32_sub(a->y, b->y, out->y, a->count);
+  mvla__i32_sub(a->z, b->z, out->z, a->count);
+  mvla__i32_sub(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL void v4i_soa_mul(const v4i_soa_t *a, const v4i_soa_t *b, v4i_soa_t *out) {
+  mvla__i32_mul(a->x, b->x, out->x, a->count);
+  mvla__i32_mul(a->y, b->y, out->y, a->count);
+  mvla__i32_mul(a->z, b->z, out->z, a->count);
+  mvla__i32_mul(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL void v4i_soa_div(const v4i_soa_t *a, const v4i_soa_t *b, v4i_soa_t *out) {
+  mvla__i32_div(a->x, b->x, out->x, a->count);
+  mvla__i32_div(a->y, b->y, out->y, a->count);
+  mvla__i32_div(a->z, b->z, out->z, a->count);
+  mvla__i32_div(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL void v4i_soa_min(const v4i_soa_t *a, const v4i_soa_t *b, v4i_soa_t *out) {
+  mvla__i32_min(a->x, b->x, out->x, a->count);
+  mvla__i32_min(a->y, b->y, out->y, a->count);
+  mvla__i32_min(a->z, b->z, out->z, a->count);
+  mvla__i32_min(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL void v4i_soa_max(const v4i_soa_t *a, const v4i_soa_t *b, v4i_soa_t *out) {
+  mvla__i32_max(a->x, b->x, out->x, a->count);
+  mvla__i32_max(a->y, b->y, out->y, a->count);
+  mvla__i32_max(a->z, b->z, out->z, a->count);
+  mvla__i32_max(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL v4u_soa_t v4u_soa_alloc(size_t n) {
+  v4u_soa_t soa;
+  size_t stride = mvla__soa_stride(n, sizeof(unsigned int));
+  char *base = (char *) mvla__aligned_alloc(stride * 4, MVLA_SOA_ALIGN);
+  if (base == NULL) {
+    soa.x = NULL;
+    soa.y = NULL;
+    soa.z = NULL;
+    soa.w = NULL;
+    soa.count = 0;
+    return soa;
+  }
+  soa.x = (unsigned int *) (base + stride * 0);
+  soa.y = (unsigned int *) (base + stride * 1);
+  soa.z = (unsigned int *) (base + stride * 2);
+  soa.w = (unsigned int *) (base + stride * 3);
+  soa.count = n;
+  return soa;
+}
+
+MVLAIMPL void v4u_soa_free(v4u_soa_t *soa) {
+  mvla__aligned_free(soa->x);
+  soa->x = NULL;
+  soa->y = NULL;
+  soa->z = NULL;
+  soa->w = NULL;
+  soa->count = 0;
+}
+
+MVLAIMPL v4u_t v4u_soa_get(const v4u_soa_t *soa, size_t i) {
+  return v4u(soa->x[i], soa->y[i], soa->z[i], soa->w[i]);
+}
+
+MVLAIMPL void v4u_soa_set(v4u_soa_t *soa, size_t i, v4u_t a) {
+  soa->x[i] = a.x;
+  soa->y[i] = a.y;
+  soa->z[i] = a.z;
+  soa->w[i] = a.w;
+}
+
+MVLAIMPL void v4u_soa_add(const v4u_soa_t *a, const v4u_soa_t *b, v4u_soa_t *out) {
+  mvla__u32_add(a->x, b->x, out->x, a->count);
+  mvla__u32_add(a->y, b->y, out->y, a->count);
+  mvla__u32_add(a->z, b->z, out->z, a->count);
+  mvla__u32_add(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL void v4u_soa_sub(const v4u_soa_t *a, const v4u_soa_t *b, v4u_soa_t *out) {
+  mvla__u32_sub(a->x, b->x, out->x, a->count);
+  mvla__u32_sub(a->y, b->y, out->y, a->count);
+  mvla__u32_sub(a->z, b->z, out->z, a->count);
+  mvla__u32_sub(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL void v4u_soa_mul(const v4u_soa_t *a, const v4u_soa_t *b, v4u_soa_t *out) {
+  mvla__u32_mul(a->x, b->x, out->x, a->count);
+  mvla__u32_mul(a->y, b->y, out->y, a->count);
+  mvla__u32_mul(a->z, b->z, out->z, a->count);
+  mvla__u32_mul(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL void v4u_soa_div(const v4u_soa_t *a, const v4u_soa_t *b, v4u_soa_t *out) {
+  mvla__u32_div(a->x, b->x, out->x, a->count);
+  mvla__u32_div(a->y, b->y, out->y, a->count);
+  mvla__u32_div(a->z, b->z, out->z, a->count);
+  mvla__u32_div(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL void v4u_soa_min(const v4u_soa_t *a, const v4u_soa_t *b, v4u_soa_t *out) {
+  mvla__u32_min(a->x, b->x, out->x, a->count);
+  mvla__u32_min(a->y, b->y, out->y, a->count);
+  mvla__u32_min(a->z, b->z, out->z, a->count);
+  mvla__u32_min(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL void v4u_soa_max(const v4u_soa_t *a, const v4u_soa_t *b, v4u_soa_t *out) {
+  mvla__u32_max(a->x, b->x, out->x, a->count);
+  mvla__u32_max(a->y, b->y, out->y, a->count);
+  mvla__u32_max(a->z, b->z, out->z, a->count);
+  mvla__u32_max(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL v4f_soa_t v4f_soa_alloc(size_t n) {
+  v4f_soa_t soa;
+  size_t stride = mvla__soa_stride(n, sizeof(float));
+  char *base = (char *) mvla__aligned_alloc(stride * 4, MVLA_SOA_ALIGN);
+  if (base == NULL) {
+    soa.x = NULL;
+    soa.y = NULL;
+    soa.z = NULL;
+    soa.w = NULL;
+    soa.count = 0;
+    return soa;
+  }
+  soa.x = (float *) (base + stride * 0);
+  soa.y = (float *) (base + stride * 1);
+  soa.z = (float *) (base + stride * 2);
+  soa.w = (float *) (base + stride * 3);
+  soa.count = n;
+  return soa;
+}
+
+MVLAIMPL void v4f_soa_free(v4f_soa_t *soa) {
+  mvla__aligned_free(soa->x);
+  soa->x = NULL;
+  soa->y = NULL;
+  soa->z = NULL;
+  soa->w = NULL;
+  soa->count = 0;
+}
+
+MVLAIMPL v4f_t v4f_soa_get(const v4f_soa_t *soa, size_t i) {
+  return v4f(soa->x[i], soa->y[i], soa->z[i], soa->w[i]);
+}
+
+MVLAIMPL void v4f_soa_set(v4f_soa_t *soa, size_t i, v4f_t a) {
+  soa->x[i] = a.x;
+  soa->y[i] = a.y;
+  soa->z[i] = a.z;
+  soa->w[i] = a.w;
+}
+
+MVLAIMPL void v4f_soa_add(const v4f_soa_t *a, const v4f_soa_t *b, v4f_soa_t *out) {
+  mvla__f32_add(a->x, b->x, out->x, a->count);
+  mvla__f32_add(a->y, b->y, out->y, a->count);
+  mvla__f32_add(a->z, b->z, out->z, a->count);
+  mvla__f32_add(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL void v4f_soa_sub(const v4f_soa_t *a, const v4f_soa_t *b, v4f_soa_t *out) {
+  mvla__f32_sub(a->x, b->x, out->x, a->count);
+  mvla__f32_sub(a->y, b->y, out->y, a->count);
+  mvla__f32_sub(a->z, b->z, out->z, a->count);
+  mvla__f32_sub(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL void v4f_soa_mul(const v4f_soa_t *a, const v4f_soa_t *b, v4f_soa_t *out) {
+  mvla__f32_mul(a->x, b->x, out->x, a->count);
+  mvla__f32_mul(a->y, b->y, out->y, a->count);
+  mvla__f32_mul(a->z, b->z, out->z, a->count);
+  mvla__f32_mul(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL void v4f_soa_div(const v4f_soa_t *a, const v4f_soa_t *b, v4f_soa_t *out) {
+  mvla__f32_div(a->x, b->x, out->x, a->count);
+  mvla__f32_div(a->y, b->y, out->y, a->count);
+  mvla__f32_div(a->z, b->z, out->z, a->count);
+  mvla__f32_div(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL void v4f_soa_min(const v4f_soa_t *a, const v4f_soa_t *b, v4f_soa_t *out) {
+  mvla__f32_min(a->x, b->x, out->x, a->count);
+  mvla__f32_min(a->y, b->y, out->y, a->count);
+  mvla__f32_min(a->z, b->z, out->z, a->count);
+  mvla__f32_min(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL void v4f_soa_max(const v4f_soa_t *a, const v4f_soa_t *b, v4f_soa_t *out) {
+  mvla__f32_max(a->x, b->x, out->x, a->count);
+  mvla__f32_max(a->y, b->y, out->y, a->count);
+  mvla__f32_max(a->z, b->z, out->z, a->count);
+  mvla__f32_max(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL void v4f_soa_pow(const v4f_soa_t *a, const v4f_soa_t *b, v4f_soa_t *out) {
+  mvla__f32_pow(a->x, b->x, out->x, a->count);
+  mvla__f32_pow(a->y, b->y, out->y, a->count);
+  mvla__f32_pow(a->z, b->z, out->z, a->count);
+  mvla__f32_pow(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL void v4f_soa_sqrt(const v4f_soa_t *a, v4f_soa_t *out) {
+  mvla__f32_sqrt(a->x, out->x, a->count);
+  mvla__f32_sqrt(a->y, out->y, a->count);
+  mvla__f32_sqrt(a->z, out->z, a->count);
+  mvla__f32_sqrt(a->w, out->w, a->count);
+}
+
+MVLAIMPL void v4f_soa_exp(const v4f_soa_t *a, v4f_soa_t *out) {
+  mvla__f32_exp(a->x, out->x, a->count);
+  mvla__f32_exp(a->y, out->y, a->count);
+  mvla__f32_exp(a->z, out->z, a->count);
+  mvla__f32_exp(a->w, out->w, a->count);
+}
+
+MVLAIMPL void v4f_soa_sin(const v4f_soa_t *a, v4f_soa_t *out) {
+  mvla__f32_sin(a->x, out->x, a->count);
+  mvla__f32_sin(a->y, out->y, a->count);
+  mvla__f32_sin(a->z, out->z, a->count);
+  mvla__f32_sin(a->w, out->w, a->count);
+}
+
+MVLAIMPL void v4f_soa_cos(const v4f_soa_t *a, v4f_soa_t *out) {
+  mvla__f32_cos(a->x, out->x, a->count);
+  mvla__f32_cos(a->y, out->y, a->count);
+  mvla__f32_cos(a->z, out->z, a->count);
+  mvla__f32_cos(a->w, out->w, a->count);
+}
+
+MVLAIMPL void v4f_soa_tan(const v4f_soa_t *a, v4f_soa_t *out) {
+  mvla__f32_tan(a->x, out->x, a->count);
+  mvla__f32_tan(a->y, out->y, a->count);
+  mvla__f32_tan(a->z, out->z, a->count);
+  mvla__f32_tan(a->w, out->w, a->count);
+}
+
+MVLAIMPL void v4f_soa_sincos(const v4f_soa_t *a, v4f_soa_t *s, v4f_soa_t *c) {
+  mvla__f32_sincos(a->x, s->x, c->x, a->count);
+  mvla__f32_sincos(a->y, s->y, c->y, a->count);
+  mvla__f32_sincos(a->z, s->z, c->z, a->count);
+  mvla__f32_sincos(a->w, s->w, c->w, a->count);
+}
+
+MVLAIMPL void v4f_soa_len(const v4f_soa_t *a, float *out) {
+  mvla__f32_sqr_len4(a->x, a->y, a->z, a->w, out, a->count, 1);
+}
+
+MVLAIMPL void v4f_soa_sqr_len(const v4f_soa_t *a, float *out) {
+  mvla__f32_sqr_len4(a->x, a->y, a->z, a->w, out, a->count, 0);
+}
+
+MVLAIMPL v4d_soa_t v4d_soa_alloc(size_t n) {
+  v4d_soa_t soa;
+  size_t stride = mvla__soa_stride(n, sizeof(double));
+  char *base = (char *) mvla__aligned_alloc(stride * 4, MVLA_SOA_ALIGN);
+  if (base == NULL) {
+    soa.x = NULL;
+    soa.y = NULL;
+    soa.z = NULL;
+    soa.w = NULL;
+    soa.count = 0;
+    return soa;
+  }
+  soa.x = (double *) (base + stride * 0);
+  soa.y = (double *) (base + stride * 1);
+  soa.z = (double *) (base + stride * 2);
+  soa.w = (double *) (base + stride * 3);
+  soa.count = n;
+  return soa;
+}
+
+MVLAIMPL void v4d_soa_free(v4d_soa_t *soa) {
+  mvla__aligned_free(soa->x);
+  soa->x = NULL;
+  soa->y = NULL;
+  soa->z = NULL;
+  soa->w = NULL;
+  soa->count = 0;
+}
+
+MVLAIMPL v4d_t v4d_soa_get(const v4d_soa_t *soa, size_t i) {
+  return v4d(soa->x[i], soa->y[i], soa->z[i], soa->w[i]);
+}
+
+MVLAIMPL void v4d_soa_set(v4d_soa_t *soa, size_t i, v4d_t a) {
+  soa->x[i] = a.x;
+  soa->y[i] = a.y;
+  soa->z[i] = a.z;
+  soa->w[i] = a.w;
+}
+
+MVLAIMPL void v4d_soa_add(const v4d_soa_t *a, const v4d_soa_t *b, v4d_soa_t *out) {
+  mvla__f64_add(a->x, b->x, out->x, a->count);
+  mvla__f64_add(a->y, b->y, out->y, a->count);
+  mvla__f64_add(a->z, b->z, out->z, a->count);
+  mvla__f64_add(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL void v4d_soa_sub(const v4d_soa_t *a, const v4d_soa_t *b, v4d_soa_t *out) {
+  mvla__f64_sub(a->x, b->x, out->x, a->count);
+  mvla__f64_sub(a->y, b->y, out->y, a->count);
+  mvla__f64_sub(a->z, b->z, out->z, a->count);
+  mvla__f64_sub(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL void v4d_soa_mul(const v4d_soa_t *a, const v4d_soa_t *b, v4d_soa_t *out) {
+  mvla__f64_mul(a->x, b->x, out->x, a->count);
+  mvla__f64_mul(a->y, b->y, out->y, a->count);
+  mvla__f64_mul(a->z, b->z, out->z, a->count);
+  mvla__f64_mul(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL void v4d_soa_div(const v4d_soa_t *a, const v4d_soa_t *b, v4d_soa_t *out) {
+  mvla__f64_div(a->x, b->x, out->x, a->count);
+  mvla__f64_div(a->y, b->y, out->y, a->count);
+  mvla__f64_div(a->z, b->z, out->z, a->count);
+  mvla__f64_div(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL void v4d_soa_min(const v4d_soa_t *a, const v4d_soa_t *b, v4d_soa_t *out) {
+  mvla__f64_min(a->x, b->x, out->x, a->count);
+  mvla__f64_min(a->y, b->y, out->y, a->count);
+  mvla__f64_min(a->z, b->z, out->z, a->count);
+  mvla__f64_min(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL void v4d_soa_max(const v4d_soa_t *a, const v4d_soa_t *b, v4d_soa_t *out) {
+  mvla__f64_max(a->x, b->x, out->x, a->count);
+  mvla__f64_max(a->y, b->y, out->y, a->count);
+  mvla__f64_max(a->z, b->z, out->z, a->count);
+  mvla__f64_max(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL void v4d_soa_pow(const v4d_soa_t *a, const v4d_soa_t *b, v4d_soa_t *out) {
+  mvla__f64_pow(a->x, b->x, out->x, a->count);
+  mvla__f64_pow(a->y, b->y, out->y, a->count);
+  mvla__f64_pow(a->z, b->z, out->z, a->count);
+  mvla__f64_pow(a->w, b->w, out->w, a->count);
+}
+
+MVLAIMPL void v4d_soa_sqrt(const v4d_soa_t *a, v4d_soa_t *out) {
+  mvla__f64_sqrt(a->x, out->x, a->count);
+  mvla__f64_sqrt(a->y, out->y, a->count);
+  mvla__f64_sqrt(a->z, out->z, a->count);
+  mvla__f64_sqrt(a->w, out->w, a->count);
+}
+
+MVLAIMPL void v4d_soa_exp(const v4d_soa_t *a, v4d_soa_t *out) {
+  mvla__f64_exp(a->x, out->x, a->count);
+  mvla__f64_exp(a->y, out->y, a->count);
+  mvla__f64_exp(a->z, out->z, a->count);
+  mvla__f64_exp(a->w, out->w, a->count);
+}
+
+MVLAIMPL void v4d_soa_sin(const v4d_soa_t *a, v4d_soa_t *out) {
+  mvla__f64_sin(a->x, out->x, a->count);
+  mvla__f64_sin(a->y, out->y, a->count);
+  mvla__f64_sin(a->z, out->z, a->count);
+  mvla__f64_sin(a->w, out->w, a->count);
+}
+
+MVLAIMPL void v4d_soa_cos(const v4d_soa_t *a, v4d_soa_t *out) {
+  mvla__f64_cos(a->x, out->x, a->count);
+  mvla__f64_cos(a->y, out->y, a->count);
+  mvla__f64_cos(a->z, out->z, a->count);
+  mvla__f64_cos(a->w, out->w, a->count);
+}
+
+MVLAIMPL void v4d_soa_tan(const v4d_soa_t *a, v4d_soa_t *out) {
+  mvla__f64_tan(a->x, out->x, a->count);
+  mvla__f64_tan(a->y, out->y, a->count);
+  mvla__f64_tan(a->z, out->z, a->count);
+  mvla__f64_tan(a->w, out->w, a->count);
+}
+
+MVLAIMPL void v4d_soa_sincos(const v4d_soa_t *a, v4d_soa_t *s, v4d_soa_t *c) {
+  mvla__f64_sincos(a->x, s->x, c->x, a->count);
+  mvla__f64_sincos(a->y, s->y, c->y, a->count);
+  mvla__f64_sincos(a->z, s->z, c->z, a->count);
+  mvla__f64_sincos(a->w, s->w, c->w, a->count);
+}
+
+MVLAIMPL void v4d_soa_len(const v4d_soa_t *a, double *out) {
+  mvla__f64_sqr_len4(a->x, a->y, a->z, a->w, out, a->count, 1);
+}
+
+MVLAIMPL void v4d_soa_sqr_len(const v4d_soa_t *a, double *out) {
+  mvla__f64_sqr_len4(a->x, a->y, a->z, a->w, out, a->count, 0);
+}
+
+// -----------------------------------------
+
+/*
+** LAYOUT CONVERSION KERNELS
+**
+** AoS <-> SoA and v3 <-> padded v4 conversions only move bits, so one set of
+** kernels serves every 32-bit scalar type (signed, unsigned, float) through
+** the float shuffle unit, and one more serves doubles. A few vectors at a time
+** are transposed in registers, the leftovers are copied one scalar at a time.
+*/
+
+#define MVLA__W32(p, i) ((unsigned char *) (p) + 4 * (i))
+#define MVLA__W32C(p, i) ((const unsigned char *) (p) + 4 * (i))
+
+#ifdef MVLA_HAS_SSE2
+
+// (x0..x3) (y0..y3) (z0..z3) -> (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3)
+static inline void mvla__mm_interleave3_ps(__m128 x, __m128 y, __m128 z,
+                                           __m128 *m0, __m128 *m1, __m128 *m2) {
+  __m128 xy0 = _mm_unpacklo_ps(x, y);                          // x0 y0 x1 y1
+  __m128 xy1 = _mm_unpackhi_ps(x, y);                          // x2 y2 x3 y3
+  __m128 t0 = _mm_shuffle_ps(z, xy0, _MM_SHUFFLE(2, 2, 0, 0)); // z0 z0 x1 x1
+  __m128 t1 = _mm_shuffle_ps(xy0, z, _MM_SHUFFLE(1, 1, 3, 3)); // y1 y1 z1 z1
+  __m128 t2 = _mm_shuffle_ps(z, xy1, _MM_SHUFFLE(3, 2, 3, 2)); // z2 z3 x3 y3
+  *m0 = _mm_shuffle_ps(xy0, t0, _MM_SHUFFLE(2, 0, 1, 0));
+  *m1 = _mm_shuffle_ps(t1, xy1, _MM_SHUFFLE(1, 0, 2, 0));
+  *m2 = _mm_shuffle_ps(t2, t2, _MM_SHUFFLE(1, 3, 2, 0));
+}
+
+// (x0 x1) (y0 y1) (z0 z1) -> (x0 y0) (z0 x1) (y1 z1)
+static inline void mvla__mm_interleave3_pd(__m128d x, __m128d y, __m128d z,
+                                           __m128d *m0, __m128d *m1, __m128d *m2) {
+  *m0 = _mm_unpacklo_pd(x, y);
+  *m1 = _mm_shuffle_pd(z, x, 2);
+  *m2 = _mm_unpackhi_pd(y, z);
+}
+
+#endif // MVLA_HAS_SSE2
+
+static inline void mvla__w32_aos2_to_soa(const void *a, void *x, void *y, size_t n) {
+  size_t i = 0;
+#ifdef MVLA_HAS_SSE2
+  const float *p = (const float *) a;
+  for (; i + 4 <= n; i += 4) {
+    __m128 vx, vy;
+    mvla__mm_deinterleave2_ps(_mm_loadu_ps(p + 2 * i), _mm_loadu_ps(p + 2 * i + 4), &vx, &vy);
+    _mm_storeu_ps((float *) MVLA__W32(x, i), vx);
+    _mm_storeu_ps((float *) MVLA__W32(y, i), vy);
+  }
+#endif // MVLA_HAS_SSE2
+  for (; i < n; ++i) {
+    memcpy(MVLA__W32(x, i), MVLA__W32C(a, 2 * i), 4);
+    memcpy(MVLA__W32(y, i), MVLA__W32C(a, 2 * i + 1), 4);
+  }
+}
+
+static inline void mvla__w32_soa_to_aos2(const void *x, const void *y, void *out, size_t n) {
+  size_t i = 0;
+#ifdef MVLA_HAS_SSE2
+  float *p = (float *) out;
+  for (; i + 4 <= n; i += 4) {
+    __m128 vx = _mm_loadu_ps((const float *) MVLA__W32C(x, i));
+    __m128 vy = _mm_loadu_ps((const float *) MVLA__W32C(y, i));
+    _mm_storeu_ps(p + 2 * i, _mm_unpacklo_ps(vx, vy));
+    _mm_storeu_ps(p + 2 * i + 4, _mm_unpackhi_ps(vx, vy));
+  }
+#endif // MVLA_HAS_SSE2
+  for (; i < n; ++i) {
+    memcpy(MVLA__W32(out, 2 * i), MVLA__W32C(x, i), 4);
+    memcpy(MVLA__W32(out, 2 * i + 1), MVLA__W32C(y, i), 4);
+  }
+}
+
+static inline void mvla__w32_aos3_to_soa(const void *a, void *x, void *y, void *z, size_t n) {
+  size_t i = 0;
+#ifdef MVLA_HAS_SSE2
+  const float *p = (const float *) a;
+  for (; i + 4 <= n; i += 4) {
+    __m128 vx, vy, vz;
+    mvla__mm_deinterleave3_ps(_mm_loadu_ps(p + 3 * i), _mm_loadu_ps(p + 3 * i + 4),
+                              _mm_loadu_ps(p + 3 * i + 8), &vx, &vy, &vz);
+    _mm_storeu_ps((float *) MVLA__W32(x, i), vx);
+    _mm_storeu_ps((float *) MVLA__W32(y, i), vy);
+    _mm_storeu_ps((float *) MVLA__W32(z, i), vz);
+  }
+#endif // MVLA_HAS_SSE2
+  for (; i < n; ++i) {
+    memcpy(MVLA__W32(x, i), MVLA__W32C(a, 3 * i), 4);
+    memcpy(MVLA__W32(y, i), MVLA__W32C(a, 3 * i + 1), 4);
+    memcpy(MVLA__W32(z, i), MVLA__W32C(a, 3 * i + 2), 4);
+  }
+}
+
+static inline void mvla__w32_soa_to_aos3(const void *x, const void *y, const void *z,
+                                         void *out, size_t n) {
+  size_t i = 0;
+#ifdef MVLA_HAS_SSE2
+  float *p = (float *) out;
+  for (; i + 4 <= n; i += 4) {
+    __m128 m0, m1, m2;
+    mvla__mm_interleave3_ps(_mm_loadu_ps((const float *) MVLA__W32C(x, i)),
+                            _mm_loadu_ps((const float *) MVLA__W32C(y, i)),
+                            _mm_loadu_ps((const float *) MVLA__W32C(z, i)), &m0, &m1, &m2);
+    _mm_storeu_ps(p + 3 * i, m0);
+    _mm_storeu_ps(p + 3 * i + 4, m1);
+    _mm_storeu_ps(p + 3 * i + 8, m2);
+  }
+#endif // MVLA_HAS_SSE2
+  for (; i < n; ++i) {
+    memcpy(MVLA__W32(out, 3 * i), MVLA__W32C(x, i), 4);
+    memcpy(MVLA__W32(out, 3 * i + 1), MVLA__W32C(y, i), 4);
+    memcpy(MVLA__W32(out, 3 * i + 2), MVLA__W32C(z, i), 4);
+  }
+}
+
+static inline void mvla__w32_aos4_to_soa(const void *a, void *x, void *y, void *z, void *w, size_t n) {
+  size_t i = 0;
+#ifdef MVLA_HAS_SSE2
+  const float *p = (const float *) a;
+  for (; i + 4 <= n; i += 4) {
+    __m128 vx = _mm_loadu_ps(p + 4 * i);
+    __m128 vy = _mm_loadu_ps(p + 4 * i + 4);
+    __m128 vz = _mm_loadu_ps(p + 4 * i + 8);
+    __m128 vw = _mm_loadu_ps(p + 4 * i + 12);
+    _MM_TRANSPOSE4_PS(vx, vy, vz, vw);
+    _mm_storeu_ps((float *) MVLA__W32(x, i), vx);
+    _mm_storeu_ps((float *) MVLA__W32(y, i), vy);
+    _mm_storeu_ps((float *) MVLA__W32(z, i), vz);
+    _mm_storeu_ps((float *) MVLA__W32(w, i), vw);
+  }
+#endif // MVLA_HAS_SSE2
+  for (; i < n; ++i) {
+    memcpy(MVLA__W32(x, i), MVLA__W32C(a, 4 * i), 4);
+    memcpy(MVLA__W32(y, i), MVLA__W32C(a, 4 * i + 1), 4);
+    memcpy(MVLA__W32(z, i), MVLA__W32C(a, 4 * i + 2), 4);
+    memcpy(MVLA__W32(w, i), MVLA__W32C(a, 4 * i + 3), 4);
+  }
+}
+
+static inline void mvla__w32_soa_to_aos4(const void *x, const void *y, const void *z,
+                                         const void *w, void *out, size_t n) {
+  size_t i = 0;
+#ifdef MVLA_HAS_SSE2
+  float *p = (float *) out;
+  for (; i + 4 <= n; i += 4) {
+    __m128 vx = _mm_loadu_ps((const float *) MVLA__W32C(x, i));
+    __m128 vy = _mm_loadu_ps((const float *) MVLA__W32C(y, i));
+    __m128 vz = _mm_loadu_ps((const float *) MVLA__W32C(z, i));
+    __m128 vw = _mm_loadu_ps((const float *) MVLA__W32C(w, i));
+    _MM_TRANSPOSE4_PS(vx, vy, vz, vw);
+    _mm_storeu_ps(p + 4 * i, vx);
+    _mm_storeu_ps(p + 4 * i + 4, vy);
+    _mm_storeu_ps(p + 4 * i + 8, vz);
+    _mm_storeu_ps(p + 4 * i + 12, vw);
+  }
+#endif // MVLA_HAS_SSE2
+  for (; i < n; ++i) {
+    memcpy(MVLA__W32(out, 4 * i), MVLA__W32C(x, i), 4);
+    memcpy(MVLA__W32(out, 4 * i + 1), MVLA__W32C(y, i), 4);
+    memcpy(MVLA__W32(out, 4 * i + 2), MVLA__W32C(z, i), 4);
+    memcpy(MVLA__W32(out, 4 * i + 3), MVLA__W32C(w, i), 4);
+  }
+}
+
+// v3 -> v4 with a constant w, pad points to the 4 bytes of w
+static inline void mvla__w32_pad3(const void *a, const void *pad, void *out, size_t n) {
+  size_t i = 0;
+#ifdef MVLA_HAS_SSE2
+  const float *p = (const float *) a;
+  float *q = (float *) out;
+  __m128 w = _mm_load1_ps((const float *) pad);
+  for (; i + 4 <= n; i += 4) {
+    __m128 m0 = _mm_loadu_ps(p + 3 * i);                           // x0 y0 z0 x1
+    __m128 m1 = _mm_loadu_ps(p + 3 * i + 4);                       // y1 z1 x2 y2
+    __m128 m2 = _mm_loadu_ps(p + 3 * i + 8);                       // z2 x3 y3 z3
+    __m128 t0 = _mm_shuffle_ps(m0, w, _MM_SHUFFLE(0, 0, 2, 2));    // z0 z0 w  w
+    __m128 t1 = _mm_shuffle_ps(m0, m1, _MM_SHUFFLE(0, 0, 3, 3));   // x1 x1 y1 y1
+    __m128 t2 = _mm_shuffle_ps(m1, w, _MM_SHUFFLE(0, 0, 1, 1));    // z1 z1 w  w
+    __m128 t3 = _mm_shuffle_ps(m2, w, _MM_SHUFFLE(0, 0, 0, 0));    // z2 z2 w  w
+    __m128 t4 = _mm_shuffle_ps(m2, w, _MM_SHUFFLE(0, 0, 3, 3));    // z3 z3 w  w
+    _mm_storeu_ps(q + 4 * i, _mm_shuffle_ps(m0, t0, _MM_SHUFFLE(2, 0, 1, 0)));
+    _mm_storeu_ps(q + 4 * i + 4, _mm_shuffle_ps(t1, t2, _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm_storeu_ps(q + 4 * i + 8, _mm_shuffle_ps(m1, t3, _MM_SHUFFLE(2, 0, 3, 2)));
+    _mm_storeu_ps(q + 4 * i + 12, _mm_shuffle_ps(m2, t4, _MM_SHUFFLE(2, 0, 2, 1)));
+  }
+#endif // MVLA_HAS_SSE2
+  for (; i < n; ++i) {
+    memcpy(MVLA__W32(out, 4 * i), MVLA__W32C(a, 3 * i), 12);
+    memcpy(MVLA__W32(out, 4 * i + 3), pad, 4);
+  }
+}
+
+static inline void mvla__w32_unpad4(const void *a, void *out, size_t n) {
+  size_t i = 0;
+#ifdef MVLA_HAS_SSE2
+  const float *p = (const float *) a;
+  float *q = (float *) out;
+  for (; i + 4 <= n; i += 4) {
+    __m128 q0 = _mm_loadu_ps(p + 4 * i);
+    __m128 q1 = _mm_loadu_ps(p + 4 * i + 4);
+    __m128 q2 = _mm_loadu_ps(p + 4 * i + 8);
+    __m128 q3 = _mm_loadu_ps(p + 4 * i + 12);
+    __m128 t0 = _mm_shuffle_ps(q0, q1, _MM_SHUFFLE(0, 0, 2, 2));   // z0 z0 x1 x1
+    __m128 t1 = _mm_shuffle_ps(q2, q3, _MM_SHUFFLE(0, 0, 2, 2));   // z2 z2 x3 x3
+    _mm_storeu_ps(q + 3 * i, _mm_shuffle_ps(q0, t0, _MM_SHUFFLE(2, 0, 1, 0)));
+    _mm_storeu_ps(q + 3 * i + 4, _mm_shuffle_ps(q1, q2, _MM_SHUFFLE(1, 0, 2, 1)));
+    _mm_storeu_ps(q + 3 * i + 8, _mm_shuffle_ps(t1, q3, _MM_SHUFFLE(2, 1, 2, 0)));
+  }
+#endif // MVLA_HAS_SSE2
+  for (; i < n; ++i) {
+    memcpy(MVLA__W32(out, 3 * i), MVLA__W32C(a, 4 * i), 12);
+  }
+}
+
+static inline void mvla__f64_aos2_to_soa(const double *a, double *x, double *y, size_t n) {
+  size_t i = 0;
+#ifdef MVLA_HAS_SSE2
+  for (; i + 2 <= n; i += 2) {
+    __m128d m0 = _mm_loadu_pd(a + 2 * i);
+    __m128d m1 = _mm_loadu_pd(a + 2 * i + 2);
+    _mm_storeu_pd(x + i, _mm_unpacklo_pd(m0, m1));
+    _mm_storeu_pd(y + i, _mm_unpackhi_pd(m0, m1));
+  }
+#endif // MVLA_HAS_SSE2
+  for (; i < n; ++i) {
+    x[i] = a[2 * i];
+    y[i] = a[2 * i + 1];
+  }
+}
+
+static inline void mvla__f64_soa_to_aos2(const double *x, const double *y, double *out, size_t n) {
+  size_t i = 0;
+#ifdef MVLA_HAS_SSE2
+  for (; i + 2 <= n; i += 2) {
+    __m128d vx = _mm_loadu_pd(x + i);
+    __m128d vy = _mm_loadu_pd(y + i);
+    _mm_storeu_pd(out + 2 * i, _mm_unpacklo_pd(vx, vy));
+    _mm_storeu_pd(out + 2 * i + 2, _mm_unpackhi_pd(vx, vy));
+  }
+#endif // MVLA_HAS_SSE2
+  for (; i < n; ++i) {
+    out[2 * i] = x[i];
+    out[2 * i + 1] = y[i];
+  }
+}
+
+static inline void mvla__f64_aos3_to_soa(const double *a, double *x, double *y, double *z, size_t n) {
+  size_t i = 0;
+#ifdef MVLA_HAS_SSE2
+  for (; i + 2 <= n; i += 2) {
+    __m128d vx, vy, vz;
+    mvla__mm_deinterleave3_pd(_mm_loadu_pd(a + 3 * i), _mm_loadu_pd(a + 3 * i + 2),
+                              _mm_loadu_pd(a + 3 * i + 4), &vx, &vy, &vz);
+    _mm_storeu_pd(x + i, vx);
+    _mm_storeu_pd(y + i, vy);
+    _mm_storeu_pd(z + i, vz);
+  }
+#endif // MVLA_HAS_SSE2
+  for (; i < n; ++i) {
+    x[i] = a[3 * i];
+    y[i] = a[3 * i + 1];
+    z[i] = a[3 * i + 2];
+  }
+}
+
+static inline void mvla__f64_soa_to_aos3(const double *x, const double *y, const double *z,
+                                         double *out, size_t n) {
+  size_t i = 0;
+#ifdef MVLA_HAS_SSE2
+  for (; i + 2 <= n; i += 2) {
+    __m128d m0, m1, m2;
+    mvla__mm_interleave3_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i), _mm_loadu_pd(z + i),
+                            &m0, &m1, &m2);
+    _mm_storeu_pd(out + 3 * i, m0);
+    _mm_storeu_pd(out + 3 * i + 2, m1);
+    _mm_storeu_pd(out + 3 * i + 4, m2);
+  }
+#endif // MVLA_HAS_SSE2
+  for (; i < n; ++i) {
+    out[3 * i] = x[i];
+    out[3 * i + 1] = y[i];
+    out[3 * i + 2] = z[i];
+  }
+}
+
+static inline void mvla__f64_aos4_to_soa(const double *a, double *x, double *y, double *z,
+                                         double *w, size_t n) {
+  size_t i = 0;
+#ifdef MVLA_HAS_SSE2
+  for (; i + 2 <= n; i += 2) {
+    __m128d m0 = _mm_loadu_pd(a + 4 * i);     // x0 y0
+    __m128d m1 = _mm_loadu_pd(a + 4 * i + 2); // z0 w0
+    __m128d m2 = _mm_loadu_pd(a + 4 * i + 4); // x1 y1
+    __m128d m3 = _mm_loadu_pd(a + 4 * i + 6); // z1 w1
+    _mm_storeu_pd(x + i, _mm_unpacklo_pd(m0, m2));
+    _mm_storeu_pd(y + i, _mm_unpackhi_pd(m0, m2));
+    _mm_storeu_pd(z + i, _mm_unpacklo_pd(m1, m3));
+    _mm_storeu_pd(w + i, _mm_unpackhi_pd(m1, m3));
+  }
+#endif // MVLA_HAS_SSE2
+  for (; i < n; ++i) {
+    x[i] = a[4 * i];
+    y[i] = a[4 * i + 1];
+    z[i] = a[4 * i + 2];
+    w[i] = a[4 * i + 3];
+  }
+}
+
+static inline void mvla__f64_soa_to_aos4(const double *x, const double *y, const double *z,
+                                         const double *w, double *out, size_t n) {
+  size_t i = 0;
+#ifdef MVLA_HAS_SSE2
+  for (; i + 2 <= n; i += 2) {
+    __m128d vx = _mm_loadu_pd(x + i);
+    __m128d vy = _mm_loadu_pd(y + i);
+    __m128d vz = _mm_loadu_pd(z + i);
+    __m128d vw = _mm_loadu_pd(w + i);
+    _mm_storeu_pd(out + 4 * i, _mm_unpacklo_pd(vx, vy));
+    _mm_storeu_pd(out + 4 * i + 2, _mm_unpacklo_pd(vz, vw));
+    _mm_storeu_pd(out + 4 * i + 4, _mm_unpackhi_pd(vx, vy));
+    _mm_storeu_pd(out + 4 * i + 6, _mm_unpackhi_pd(vz, vw));
+  }
+#endif // MVLA_HAS_SSE2
+  for (; i < n; ++i) {
+    out[4 * i] = x[i];
+    out[4 * i + 1] = y[i];
+    out[4 * i + 2] = z[i];
+    out[4 * i + 3] = w[i];
+  }
+}
+
+static inline void mvla__f64_pad3(const double *a, double pad, double *out, size_t n) {
+  size_t i = 0;
+#ifdef MVLA_HAS_SSE2
+  __m128d w = _mm_set1_pd(pad);
+  for (; i + 2 <= n; i += 2) {
+    __m128d m0 = _mm_loadu_pd(a + 3 * i);     // x0 y0
+    __m128d m1 = _mm_loadu_pd(a + 3 * i + 2); // z0 x1
+    __m128d m2 = _mm_loadu_pd(a + 3 * i + 4); // y1 z1
+    _mm_storeu_pd(out + 4 * i, m0);
+    _mm_storeu_pd(out + 4 * i + 2, _mm_move_sd(w, m1));
+    _mm_storeu_pd(out + 4 * i + 4, _mm_shuffle_pd(m1, m2, 1));
+    _mm_storeu_pd(out + 4 * i + 6, _mm_unpackhi_pd(m2, w));
+  }
+#endif // MVLA_HAS_SSE2
+  for (; i < n; ++i) {
+    out[4 * i] = a[3 * i];
+    out[4 * i + 1] = a[3 * i + 1];
+    out[4 * i + 2] = a[3 * i + 2];
+    out[4 * i + 3] = pad;
+  }
+}
+
+static inline void mvla__f64_unpad4(const double *a, double *out, size_t n) {
+  size_t i = 0;
+#ifdef MVLA_HAS_SSE2
+  for (; i + 2 <= n; i += 2) {
+    __m128d q0 = _mm_loadu_pd(a + 4 * i);     // x0 y0
+    __m128d q1 = _mm_loadu_pd(a + 4 * i + 2); // z0 w0
+    __m128d q2 = _mm_loadu_pd(a + 4 * i + 4); // x1 y1
+    __m128d q3 = _mm_loadu_pd(a + 4 * i + 6); // z1 w1
+    _mm_storeu_pd(out + 3 * i, q0);
+    _mm_storeu_pd(out + 3 * i + 2, _mm_shuffle_pd(q1, q2, 0));
+    _mm_storeu_pd(out + 3 * i + 4, _mm_shuffle_pd(q2, q3, 1));
+  }
+#endif // MVLA_HAS_SSE2
+  for (; i < n; ++i) {
+    out[3 * i] = a[4 * i];
+    out[3 * i + 1] = a[4 * i + 1];
+    out[3 * i + 2] = a[4 * i + 2];
+  }
+}
+
+// -----------------------------------------
+
+MVLAIMPL void v2i_soa_from_aos(v2i_soa_t *soa, const v2i_t *a) {
+  mvla__w32_aos2_to_soa(a, soa->x, soa->y, soa->count);
+}
+
+MVLAIMPL void v2i_soa_to_aos(const v2i_soa_t *soa, v2i_t *out) {
+  mvla__w32_soa_to_aos2(soa->x, soa->y, out, soa->count);
+}
+
+MVLAIMPL void v3i_soa_from_aos(v3i_soa_t *soa, const v3i_t *a) {
+  mvla__w32_aos3_to_soa(a, soa->x, soa->y, soa->z, soa->count);
+}
+
+MVLAIMPL void v3i_soa_to_aos(const v3i_soa_t *soa, v3i_t *out) {
+  mvla__w32_soa_to_aos3(soa->x, soa->y, soa->z, out, soa->count);
+}
+
+MVLAIMPL void v4i_soa_from_aos(v4i_soa_t *soa, const v4i_t *a) {
+  mvla__w32_aos4_to_soa(a, soa->x, soa->y, soa->z, soa->w, soa->count);
+}
+
+MVLAIMPL void v4i_soa_to_aos(const v4i_soa_t *soa, v4i_t *out) {
+  mvla__w32_soa_to_aos4(soa->x, soa->y, soa->z, soa->w, out, soa->count);
+}
+
+MVLAIMPL void v3i_pad_n(const v3i_t *a, signed int w, v4i_t *out, size_t n) {
+  mvla__w32_pad3(a, &w, out, n);
+}
+
+MVLAIMPL void v4i_unpad_n(const v4i_t *a, v3i_t *out, size_t n) {
+  mvla__w32_unpad4(a, out, n);
+}
+
+MVLAIMPL void v2u_soa_from_aos(v2u_soa_t *soa, const v2u_t *a) {
+  mvla__w32_aos2_to_soa(a, soa->x, soa->y, soa->count);
+}
+
+MVLAIMPL void v2u_soa_to_aos(const v2u_soa_t *soa, v2u_t *out) {
+  mvla__w32_soa_to_aos2(soa->x, soa->y, out, soa->count);
+}
+
+MVLAIMPL void v3u_soa_from_aos(v3u_soa_t *soa, const v3u_t *a) {
+  mvla__w32_aos3_to_soa(a, soa->x, soa->y, soa->z, soa->count);
+}
+
+MVLAIMPL void v3u_soa_to_aos(const v3u_soa_t *soa, v3u_t *out) {
+  mvla__w32_soa_to_aos3(soa->x, soa->y, soa->z, out, soa->count);
+}
+
+MVLAIMPL void v4u_soa_from_aos(v4u_soa_t *soa, const v4u_t *a) {
+  mvla__w32_aos4_to_soa(a, soa->x, soa->y, soa->z, soa->w, soa->count);
+}
+
+MVLAIMPL void v4u_soa_to_aos(const v4u_soa_t *soa, v4u_t *out) {
+  mvla__w32_soa_to_aos4(soa->x, soa->y, soa->z, soa->w, out, soa->count);
+}
+
+MVLAIMPL void v3u_pad_n(const v3u_t *a, unsigned int w, v4u_t *out, size_t n) {
+  mvla__w32_pad3(a, &w, out, n);
+}
+
+MVLAIMPL void v4u_unpad_n(const v4u_t *a, v3u_t *out, size_t n) {
+  mvla__w32_unpad4(a, out, n);
+}
+
+MVLAIMPL void v2f_soa_from_aos(v2f_soa_t *soa, const v2f_t *a) {
+  mvla__w32_aos2_to_soa(a, soa->x, soa->y, soa->count);
+}
+
+MVLAIMPL void v2f_soa_to_aos(const v2f_soa_t *soa, v2f_t *out) {
+  mvla__w32_soa_to_aos2(soa->x, soa->y, out, soa->count);
+}
+
+MVLAIMPL void v3f_soa_from_aos(v3f_soa_t *soa, const v3f_t *a) {
+  mvla__w32_aos3_to_soa(a, soa->x, soa->y, soa->z, soa->count);
+}
+
+MVLAIMPL void v3f_soa_to_aos(const v3f_soa_t *soa, v3f_t *out) {
+  mvla__w32_soa_to_aos3(soa->x, soa->y, soa->z, out, soa->count);
+}
+
+MVLAIMPL void v4f_soa_from_aos(v4f_soa_t *soa, const v4f_t *a) {
+  mvla__w32_aos4_to_soa(a, soa->x, soa->y, soa->z, soa->w, soa->count);
+}
+
+MVLAIMPL void v4f_soa_to_aos(const v4f_soa_t *soa, v4f_t *out) {
+  mvla__w32_soa_to_aos4(soa->x, soa->y, soa->z, soa->w, out, soa->count);
+}
+
+MVLAIMPL void v3f_pad_n(const v3f_t *a, float w, v4f_t *out, size_t n) {
+  mvla__w32_pad3(a, &w, out, n);
+}
+
+MVLAIMPL void v4f_unpad_n(const v4f_t *a, v3f_t *out, size_t n) {
+  mvla__w32_unpad4(a, out, n);
+}
+
+MVLAIMPL void v2d_soa_from_aos(v2d_soa_t *soa, const v2d_t *a) {
+  mvla__f64_aos2_to_soa((const double *) a, soa->x, soa->y, soa->count);
+}
+
+MVLAIMPL void v2d_soa_to_aos(const v2d_soa_t *soa, v2d_t *out) {
+  mvla__f64_soa_to_aos2(soa->x, soa->y, (double *) out, soa->count);
+}
+
+MVLAIMPL void v3d_soa_from_aos(v3d_soa_t *soa, const v3d_t *a) {
+  mvla__f64_aos3_to_soa((const double *) a, soa->x, soa->y, soa->z, soa->count);
+}
+
+MVLAIMPL void v3d_soa_to_aos(const v3d_soa_t *soa, v3d_t *out) {
+  mvla__f64_soa_to_aos3(soa->x, soa->y, soa->z, (double *) out, soa->count);
+}
+
+MVLAIMPL void v4d_soa_from_aos(v4d_soa_t *soa, const v4d_t *a) {
+  mvla__f64_aos4_to_soa((const double *) a, soa->x, soa->y, soa->z, soa->w, soa->count);
+}
+
+MVLAIMPL void v4d_soa_to_aos(const v4d_soa_t *soa, v4d_t *out) {
+  mvla__f64_soa_to_aos4(soa->x, soa->y, soa->z, soa->w, (double *) out, soa->count);
+}
+
+MVLAIMPL void v3d_pad_n(const v3d_t *a, double w, v4d_t *out, size_t n) {
+  mvla__f64_pad3((const double *) a, w, (double *) out, n);
+}
+
+MVLAIMPL void v4d_unpad_n(const v4d_t *a, v3d_t *out, size_t n) {
+  mvla__f64_unpad4((const double *) a, (double *) out, n);
+}
+
+// -----------------------------------------
+
+/*
+** GEOMETRY FUNCTIONS
+**
+** The AoS batch forms work in chunks: each operand chunk is transposed into
+** component arrays, the geometry kernel runs over them, and vector results
+** are transposed back, so out may alias the inputs. The SoA forms run the
+** kernels on the buffers directly.
+*/
+
+#define MVLA__GEOM_CHUNK 256
+
+typedef enum mvla__geom_op {
+  MVLA__GEOM_DOT,
+  MVLA__GEOM_CROSS,
+  MVLA__GEOM_NORMALIZE,
+  MVLA__GEOM_NORMALIZE_FAST,
+  MVLA__GEOM_DIST,
+  MVLA__GEOM_SQR_DIST,
+  MVLA__GEOM_PROJECT,
+  MVLA__GEOM_REFLECT
+} mvla__geom_op_t;
+
+#define MVLA__GEOM_BATCH(f, T, w)                                                 \
+  static inline void mvla__##f##_geom_split(const T *a, int dims,                 \
+                                            T (*t)[MVLA__GEOM_CHUNK], size_t n) { \
+    switch (dims) {                                                               \
+      case 2: mvla__##w##_aos2_to_soa(a, t[0], t[1], n); break;                   \
+      case 3: mvla__##w##_aos3_to_soa(a, t[0], t[1], t[2], n); break;             \
+      default: mvla__##w##_aos4_to_soa(a, t[0], t[1], t[2], t[3], n); break;      \
+    }                                                                             \
+  }                                                                               \
+  static inline void mvla__##f##_geom_merge(T (*t)[MVLA__GEOM_CHUNK], int dims,   \
+                                            T *out, size_t n) {                   \
+    switch (dims) {                                                               \
+      case 2: mvla__##w##_soa_to_aos2(t[0], t[1], out, n); break;                 \
+      case 3: mvla__##w##_soa_to_aos3(t[0], t[1], t[2], out, n); break;           \
+      default: mvla__##w##_soa_to_aos4(t[0], t[1], t[2], t[3], out, n); break;    \
+    }                                                                             \
+  }                                                                               \
+  static void mvla__##f##_geom(mvla__geom_op_t op, const T *const *a, const T *const *b, \
+                               int dims, T *const *out, size_t n) {               \
+    switch (op) {                                                                 \
+      case MVLA__GEOM_DOT: mvla__##f##_dot_k(a, b, dims, out[0], n); break;       \
+      case MVLA__GEOM_CROSS: mvla__##f##_cross_k(a, b, dims, out, n); break;      \
+      case MVLA__GEOM_NORMALIZE: mvla__##f##_normalize_k(a, dims, out, n, 0); break; \
+      case MVLA__GEOM_NORMALIZE_FAST: mvla__##f##_normalize_k(a, dims, out, n, 1); break; \
+      case MVLA__GEOM_DIST: mvla__##f##_dist_k(a, b, dims, out[0], n, 1); break;  \
+      case MVLA__GEOM_SQR_DIST: mvla__##f##_dist_k(a, b, dims, out[0], n, 0); break; \
+      case MVLA__GEOM_PROJECT: mvla__##f##_project_k(a, b, dims, out, n); break;  \
+      case MVLA__GEOM_REFLECT: mvla__##f##_reflect_k(a, b, dims, out, n); break;  \
+    }                                                                             \
+  }                                                                               \
+  static void mvla__##f##_geom_n(mvla__geom_op_t op, const T *a, const T *b, int dims, \
+                                 T *out, size_t n) {                              \
+    T ta[4][MVLA__GEOM_CHUNK], tb[4][MVLA__GEOM_CHUNK], to[4][MVLA__GEOM_CHUNK];  \
+    const T *pa[4] = {ta[0], ta[1], ta[2], ta[3]};                                \
+    const T *pb[4] = {tb[0], tb[1], tb[2], tb[3]};                                \
+    T *po[4] = {to[0], to[1], to[2], to[3]};                                      \
+    int vec = !(op == MVLA__GEOM_DOT || op == MVLA__GEOM_DIST ||                  \
+                op == MVLA__GEOM_SQR_DIST || (op == MVLA__GEOM_CROSS && dims == 2)); \
+    size_t off = 0;                                                               \
+    while (off < n) {                                                             \
+      size_t m = n - off < MVLA__GEOM_CHUNK ? n - off : MVLA__GEOM_CHUNK;         \
+      mvla__##f##_geom_split(a + off * dims, dims, ta, m);                        \
+      if (b != NULL) {                                                            \
+        mvla__##f##_geom_split(b + off * dims, dims, tb, m);                      \
+      }                                                                           \
+      if (vec) {                                                                  \
+        mvla__##f##_geom(op, pa, pb, dims, po, m);                                \
+        mvla__##f##_geom_merge(to, dims, out + off * dims, m);                    \
+      } else {                                                                    \
+        T *so[1];                                                                 \
+        so[0] = out + off;                                                        \
+        mvla__##f##_geom(op, pa, pb, dims, so, m);                                \
+      }                                                                           \
+      off += m;                                                                   \
+    }                                                                             \
+  }
+
+MVLA__GEOM_BATCH(f32, float, w32)
+MVLA__GEOM_BATCH(f64, double, f64)
+
+MVLAIMPL void v2f_dot_n(const v2f_t *a, const v2f_t *b, float *out, size_t n) {
+  mvla__f32_geom_n(MVLA__GEOM_DOT, (const float *) a, (const float *) b, 2, out, n);
+}
+
+MVLAIMPL void v2f_cross_n(const v2f_t *a, const v2f_t *b, float *out, size_t n) {
+  mvla__f32_geom_n(MVLA__GEOM_CROSS, (const float *) a, (const float *) b, 2, out, n);
+}
+
+MVLAIMPL void v2f_normalize_n(const v2f_t *a, v2f_t *out, size_t n) {
+  mvla__f32_geom_n(MVLA__GEOM_NORMALIZE, (const float *) a, NULL, 2, (float *) out, n);
+}
+
+MVLAIMPL void v2f_normalize_fast_n(const v2f_t *a, v2f_t *out, size_t n) {
+  mvla__f32_geom_n(MVLA__GEOM_NORMALIZE_FAST, (const float *) a, NULL, 2, (float *) out, n);
+}
+
+MVLAIMPL void v2f_dist_n(const v2f_t *a, const v2f_t *b, float *out, size_t n) {
+  mvla__f32_geom_n(MVLA__GEOM_DIST, (const float *) a, (const float *) b, 2, out, n);
+}
+
+MVLAIMPL void v2f_sqr_dist_n(const v2f_t *a, const v2f_t *b, float *out, size_t n) {
+  mvla__f32_geom_n(MVLA__GEOM_SQR_DIST, (const float *) a, (const float *) b, 2, out, n);
+}
+
+MVLAIMPL void v2f_project_n(const v2f_t *a, const v2f_t *b, v2f_t *out, size_t n) {
+  mvla__f32_geom_n(MVLA__GEOM_PROJECT, (const float *) a, (const float *) b, 2, (float *) out, n);
+}
+
+MVLAIMPL void v2f_reflect_n(const v2f_t *a, const v2f_t *n, v2f_t *out, size_t count) {
+  mvla__f32_geom_n(MVLA__GEOM_REFLECT, (const float *) a, (const float *) n, 2, (float *) out, count);
+}
+
+MVLAIMPL void v2f_soa_dot(const v2f_soa_t *a, const v2f_soa_t *b, float *out) {
+  const float *pa[4] = {a->x, a->y, NULL, NULL}, *pb[4] = {b->x, b->y, NULL, NULL};
+  mvla__f32_dot_k(pa, pb, 2, out, a->count);
+}
+
+MVLAIMPL void v2f_soa_cross(const v2f_soa_t *a, const v2f_soa_t *b, float *out) {
+  const float *pa[4] = {a->x, a->y, NULL, NULL}, *pb[4] = {b->x, b->y, NULL, NULL};
+  float *po[1];
+  po[0] = out;
+  mvla__f32_cross_k(pa, pb, 2, po, a->count);
+}
+
+MVLAIMPL void v2f_soa_normalize(const v2f_soa_t *a, v2f_soa_t *out) {
+  const float *pa[4] = {a->x, a->y, NULL, NULL};
+  float *po[4] = {out->x, out->y, NULL, NULL};
+  mvla__f32_normalize_k(pa, 2, po, a->count, 0);
+}
+
+MVLAIMPL void v2f_soa_normalize_fast(const v2f_soa_t *a, v2f_soa_t *out) {
+  const float *pa[4] = {a->x, a->y, NULL, NULL};
+  float *po[4] = {out->x, out->y, NULL, NULL};
+  mvla__f32_normalize_k(pa, 2, po, a->count, 1);
+}
+
+MVLAIMPL void v2d_dot_n(const v2d_t *a, const v2d_t *b, double *out, size_t n) {
+  mvla__f64_geom_n(MVLA__GEOM_DOT, (const double *) a, (const double *) b, 2, out, n);
+}
+
+MVLAIMPL void v2d_cross_n(const v2d_t *a, const v2d_t *b, double *out, size_t n) {
+  mvla__f64_geom_n(MVLA__GEOM_CROSS, (const double *) a, (const double *) b, 2, out, n);
+}
+
+MVLAIMPL void v2d_normalize_n(const v2d_t *a, v2d_t *out, size_t n) {
+  mvla__f64_geom_n(MVLA__GEOM_NORMALIZE, (const double *) a, NULL, 2, (double *) out, n);
+}
+
+MVLAIMPL void v2d_normalize_fast_n(const v2d_t *a, v2d_t *out, size_t n) {
+  mvla__f64_geom_n(MVLA__GEOM_NORMALIZE_FAST, (const double *) a, NULL, 2, (double *) out, n);
+}
+
+MVLAIMPL void v2d_dist_n(const v2d_t *a, const v2d_t *b, double *out, size_t n) {
+  mvla__f64_geom_n(MVLA__GEOM_DIST, (const double *) a, (const double *) b, 2, out, n);
+}
+
+MVLAIMPL void v2d_sqr_dist_n(const v2d_t *a, const v2d_t *b, double *out, size_t n) {
+  mvla__f64_geom_n(MVLA__GEOM_SQR_DIST, (const double *) a, (const double *) b, 2, out, n);
+}
+
+MVLAIMPL void v2d_project_n(const v2d_t *a, const v2d_t *b, v2d_t *out, size_t n) {
+  mvla__f64_geom_n(MVLA__GEOM_PROJECT, (const double *) a, (const double *) b, 2, (double *) out, n);
+}
+
+MVLAIMPL void v2d_reflect_n(const v2d_t *a, const v2d_t *n, v2d_t *out, size_t count) {
+  mvla__f64_geom_n(MVLA__GEOM_REFLECT, (const double *) a, (const double *) n, 2, (double *) out, count);
+}
+
+MVLAIMPL void v2d_soa_dot(const v2d_soa_t *a, const v2d_soa_t *b, double *out) {
+  const double *pa[4] = {a->x, a->y, NULL, NULL}, *pb[4] = {b->x, b->y, NULL, NULL};
+  mvla__f64_dot_k(pa, pb, 2, out, a->count);
+}
+
+MVLAIMPL void v2d_soa_cross(const v2d_soa_t *a, const v2d_soa_t *b, double *out) {
+  const double *pa[4] = {a->x, a->y, NULL, NULL}, *pb[4] = {b->x, b->y, NULL, NULL};
+  double *po[1];
+  po[0] = out;
+  mvla__f64_cross_k(pa, pb, 2, po, a->count);
+}
+
+MVLAIMPL void v2d_soa_normalize(const v2d_soa_t *a, v2d_soa_t *out) {
+  const double *pa[4] = {a->x, a->y, NULL, NULL};
+  double *po[4] = {out->x, out->y, NULL, NULL};
+  mvla__f64_normalize_k(pa, 2, po, a->count, 0);
+}
+
+MVLAIMPL void v2d_soa_normalize_fast(const v2d_soa_t *a, v2d_soa_t *out) {
+  const double *pa[4] = {a->x, a->y, NULL, NULL};
+  double *po[4] = {out->x, out->y, NULL, NULL};
+  mvla__f64_normalize_k(pa, 2, po, a->count, 1);
+}
+
+MVLAIMPL void v3f_dot_n(const v3f_t *a, const v3f_t *b, float *out, size_t n) {
+  mvla__f32_geom_n(MVLA__GEOM_DOT, (const float *) a, (const float *) b, 3, out, n);
+}
+
+MVLAIMPL void v3f_cross_n(const v3f_t *a, const v3f_t *b, v3f_t *out, size_t n) {
+  mvla__f32_geom_n(MVLA__GEOM_CROSS, (const float *) a, (const float *) b, 3, (float *) out, n);
+}
+
+MVLAIMPL void v3f_normalize_n(const v3f_t *a, v3f_t *out, size_t n) {
+  mvla__f32_geom_n(MVLA__GEOM_NORMALIZE, (const float *) a, NULL, 3, (float *) out, n);
+}
+
+MVLAIMPL void v3f_normalize_fast_n(const v3f_t *a, v3f_t *out, size_t n) {
+  mvla__f32_geom_n(MVLA__GEOM_NORMALIZE_FAST, (const float *) a, NULL, 3, (float *) out, n);
+}
+
+MVLAIMPL void v3f_dist_n(const v3f_t *a, const v3f_t *b, float *out, size_t n) {
+  mvla__f32_geom_n(MVLA__GEOM_DIST, (const float *) a, (const float *) b, 3, out, n);
+}
+
+MVLAIMPL void v3f_sqr_dist_n(const v3f_t *a, const v3f_t *b, float *out, size_t n) {
+  mvla__f32_geom_n(MVLA__GEOM_SQR_DIST, (const float *) a, (const float *) b, 3, out, n);
+}
+
+MVLAIMPL void v3f_project_n(const v3f_t *a, const v3f_t *b, v3f_t *out, size_t n) {
+  mvla__f32_geom_n(MVLA__GEOM_PROJECT, (const float *) a, (const float *) b, 3, (float *) out, n);
+}
+
+MVLAIMPL void v3f_reflect_n(const v3f_t *a, const v3f_t *n, v3f_t *out, size_t count) {
+  mvla__f32_geom_n(MVLA__GEOM_REFLECT, (const float *) a, (const float *) n, 3, (float *) out, count);
+}
+
+MVLAIMPL void v3f_soa_dot(const v3f_soa_t *a, const v3f_soa_t *b, float *out) {
+  const float *pa[4] = {a->x, a->y, a->z, NULL}, *pb[4] = {b->x, b->y, b->z, NULL};
+  mvla__f32_dot_k(pa, pb, 3, out, a->count);
+}
+
+MVLAIMPL void v3f_soa_cross(const v3f_soa_t *a, const v3f_soa_t *b, v3f_soa_t *out) {
+  const float *pa[4] = {a->x, a->y, a->z, NULL}, *pb[4] = {b->x, b->y, b->z, NULL};
+  float *po[4] = {out->x, out->y, out->z, NULL};
+  mvla__f32_cross_k(pa, pb, 3, po, a->count);
+}
+
+MVLAIMPL void v3f_soa_normalize(const v3f_soa_t *a, v3f_soa_t *out) {
+  const float *pa[4] = {a->x, a->y, a->z, NULL};
+  float *po[4] = {out->x, out->y, out->z, NULL};
+  mvla__f32_normalize_k(pa, 3, po, a->count, 0);
+}
+
+MVLAIMPL void v3f_soa_normalize_fast(const v3f_soa_t *a, v3f_soa_t *out) {
+  const float *pa[4] = {a->x, a->y, a->z, NULL};
+  float *po[4] = {out->x, out->y, out->z, NULL};
+  mvla__f32_normalize_k(pa, 3, po, a->count, 1);
+}
+
+MVLAIMPL void v3d_dot_n(const v3d_t *a, const v3d_t *b, double *out, size_t n) {
+  mvla__f64_geom_n(MVLA__GEOM_DOT, (const double *) a, (const double *) b, 3, out, n);
+}
+
+MVLAIMPL void v3d_cross_n(const v3d_t *a, const v3d_t *b, v3d_t *out, size_t n) {
+  mvla__f64_geom_n(MVLA__GEOM_CROSS, (const double *) a, (const double *) b, 3, (double *) out, n);
+}
+
+MVLAIMPL void v3d_normalize_n(const v3d_t *a, v3d_t *out, size_t n) {
+  mvla__f64_geom_n(MVLA__GEOM_NORMALIZE, (const double *) a, NULL, 3, (double *) out, n);
+}
+
+MVLAIMPL void v3d_normalize_fast_n(const v3d_t *a, v3d_t *out, size_t n) {
+  mvla__f64_geom_n(MVLA__GEOM_NORMALIZE_FAST, (const double *) a, NULL, 3, (double *) out, n);
+}
+
+MVLAIMPL void v3d_dist_n(const v3d_t *a, const v3d_t *b, double *out, size_t n) {
+  mvla__f64_geom_n(MVLA__GEOM_DIST, (const double *) a, (const double *) b, 3, out, n);
+}
+
+MVLAIMPL void v3d_sqr_dist_n(const v3d_t *a, const v3d_t *b, double *out, size_t n) {
+  mvla__f64_geom_n(MVLA__GEOM_SQR_DIST, (const double *) a, (const double *) b, 3, out, n);
+}
+
+MVLAIMPL void v3d_project_n(const v3d_t *a, const v3d_t *b, v3d_t *out, size_t n) {
+  mvla__f64_geom_n(MVLA__GEOM_PROJECT, (const double *) a, (const double *) b, 3, (double *) out, n);
+}
+
+MVLAIMPL void v3d_reflect_n(const v3d_t *a, const v3d_t *n, v3d_t *out, size_t count) {
+  mvla__f64_geom_n(MVLA__GEOM_REFLECT, (const double *) a, (const double *) n, 3, (double *) out, count);
+}
+
+MVLAIMPL void v3d_soa_dot(const v3d_soa_t *a, const v3d_soa_t *b, double *out) {
+  const double *pa[4] = {a->x, a->y, a->z, NULL}, *pb[4] = {b->x, b->y, b->z, NULL};
+  mvla__f64_dot_k(pa, pb, 3, out, a->count);
+}
+
+MVLAIMPL void v3d_soa_cross(const v3d_soa_t *a, const v3d_soa_t *b, v3d_soa_t *out) {
+  const double *pa[4] = {a->x, a->y, a->z, NULL}, *pb[4] = {b->x, b->y, b->z, NULL};
+  double *po[4] = {out->x, out->y, out->z, NULL};
+  mvla__f64_cross_k(pa, pb, 3, po, a->count);
+}
+
+MVLAIMPL void v3d_soa_normalize(const v3d_soa_t *a, v3d_soa_t *out) {
+  const double *pa[4] = {a->x, a->y, a->z, NULL};
+  double *po[4] = {out->x, out->y, out->z, NULL};
+  mvla__f64_normalize_k(pa, 3, po, a->count, 0);
+}
+
+MVLAIMPL void v3d_soa_normalize_fast(const v3d_soa_t *a, v3d_soa_t *out) {
+  const double *pa[4] = {a->x, a->y, a->z, NULL};
+  double *po[4] = {out->x, out->y, out->z, NULL};
+  mvla__f64_normalize_k(pa, 3, po, a->count, 1);
+}
+
+MVLAIMPL void v4f_dot_n(const v4f_t *a, const v4f_t *b, float *out, size_t n) {
+  mvla__f32_geom_n(MVLA__GEOM_DOT, (const float *) a, (const float *) b, 4, out, n);
+}
+
+MVLAIMPL void v4f_normalize_n(const v4f_t *a, v4f_t *out, size_t n) {
+  mvla__f32_geom_n(MVLA__GEOM_NORMALIZE, (const float *) a, NULL, 4, (float *) out, n);
+}
+
+MVLAIMPL void v4f_normalize_fast_n(const v4f_t *a, v4f_t *out, size_t n) {
+  mvla__f32_geom_n(MVLA__GEOM_NORMALIZE_FAST, (const float *) a, NULL, 4, (float *) out, n);
+}
+
+MVLAIMPL void v4f_dist_n(const v4f_t *a, const v4f_t *b, float *out, size_t n) {
+  mvla__f32_geom_n(MVLA__GEOM_DIST, (const float *) a, (const float *) b, 4, out, n);
+}
+
+MVLAIMPL void v4f_sqr_dist_n(const v4f_t *a, const v4f_t *b, float *out, size_t n) {
+  mvla__f32_geom_n(MVLA__GEOM_SQR_DIST, (const float *) a, (const float *) b, 4, out, n);
+}
+
+MVLAIMPL void v4f_project_n(const v4f_t *a, const v4f_t *b, v4f_t *out, size_t n) {
+  mvla__f32_geom_n(MVLA__GEOM_PROJECT, (const float *) a, (const float *) b, 4, (float *) out, n);
+}
+
+MVLAIMPL void v4f_reflect_n(const v4f_t *a, const v4f_t *n, v4f_t *out, size_t count) {
+  mvla__f32_geom_n(MVLA__GEOM_REFLECT, (const float *) a, (const float *) n, 4, (float *) out, count);
+}
+
+MVLAIMPL void v4f_soa_dot(const v4f_soa_t *a, const v4f_soa_t *b, float *out) {
+  const float *pa[4] = {a->x, a->y, a->z, a->w}, *pb[4] = {b->x, b->y, b->z, b->w};
+  mvla__f32_dot_k(pa, pb, 4, out, a->count);
+}
+
+MVLAIMPL void v4f_soa_normalize(const v4f_soa_t *a, v4f_soa_t *out) {
+  const float *pa[4] = {a->x, a->y, a->z, a->w};
+  float *po[4] = {out->x, out->y, out->z, out->w};
+  mvla__f32_normalize_k(pa, 4, po, a->count, 0);
+}
+
+MVLAIMPL void v4f_soa_normalize_fast(const v4f_soa_t *a, v4f_soa_t *out) {
+  const float *pa[4] = {a->x, a->y, a->z, a->w};
+  float *po[4] = {out->x, out->y, out->z, out->w};
+  mvla__f32_normalize_k(pa, 4, po, a->count, 1);
+}
+
+MVLAIMPL void v4d_dot_n(const v4d_t *a, const v4d_t *b, double *out, size_t n) {
+  mvla__f64_geom_n(MVLA__GEOM_DOT, (const double *) a, (const double *) b, 4, out, n);
+}
+
+MVLAIMPL void v4d_normalize_n(const v4d_t *a, v4d_t *out, size_t n) {
+  mvla__f64_geom_n(MVLA__GEOM_NORMALIZE, (const double *) a, NULL, 4, (double *) out, n);
+}
+
+MVLAIMPL void v4d_normalize_fast_n(const v4d_t *a, v4d_t *out, size_t n) {
+  mvla__f64_geom_n(MVLA__GEOM_NORMALIZE_FAST, (const double *) a, NULL, 4, (double *) out, n);
+}
+
+MVLAIMPL void v4d_dist_n(const v4d_t *a, const v4d_t *b, double *out, size_t n) {
+  mvla__f64_geom_n(MVLA__GEOM_DIST, (const double *) a, (const double *) b, 4, out, n);
+}
+
+MVLAIMPL void v4d_sqr_dist_n(const v4d_t *a, const v4d_t *b, double *out, size_t n) {
+  mvla__f64_geom_n(MVLA__GEOM_SQR_DIST, (const double *) a, (const double *) b, 4, out, n);
+}
+
+MVLAIMPL void v4d_project_n(const v4d_t *a, const v4d_t *b, v4d_t *out, size_t n) {
+  mvla__f64_geom_n(MVLA__GEOM_PROJECT, (const double *) a, (const double *) b, 4, (double *) out, n);
+}
+
+MVLAIMPL void v4d_reflect_n(const v4d_t *a, const v4d_t *n, v4d_t *out, size_t count) {
+  mvla__f64_geom_n(MVLA__GEOM_REFLECT, (const double *) a, (const double *) n, 4, (double *) out, count);
+}
+
+MVLAIMPL void v4d_soa_dot(const v4d_soa_t *a, const v4d_soa_t *b, double *out) {
+  const double *pa[4] = {a->x, a->y, a->z, a->w}, *pb[4] = {b->x, b->y, b->z, b->w};
+  mvla__f64_dot_k(pa, pb, 4, out, a->count);
+}
+
+MVLAIMPL void v4d_soa_normalize(const v4d_soa_t *a, v4d_soa_t *out) {
+  const double *pa[4] = {a->x, a->y, a->z, a->w};
+  double *po[4] = {out->x, out->y, out->z, out->w};
+  mvla__f64_normalize_k(pa, 4, po, a->count, 0);
+}
+
+MVLAIMPL void v4d_soa_normalize_fast(const v4d_soa_t *a, v4d_soa_t *out) {
+  const double *pa[4] = {a->x, a->y, a->z, a->w};
+  double *po[4] = {out->x, out->y, out->z, out->w};
+  mvla__f64_normalize_k(pa, 4, po, a->count, 1);
+}
+
+// -----------------------------------------
+
+/*
+** MATRIX BATCH FUNCTIONS
+**
+** The AoS transforms reuse the geometry chunking: transpose a chunk into
+** component arrays, run the transform kernel and transpose back. Streaming
+** outputs are transposed into the chunk buffer instead and copied out with
+** non-temporal stores. Threads each take a range of whole vectors.
+*/
+
+#define MVLA__XFORM_BATCH(f, T)                                                   \
+  typedef struct mvla__##f##_xform_job {                                          \
+    const T *m;                                                                   \
+    const T *a[4];                                                                \
+    T *out[4];                                                                    \
+    int in_dims, out_dims, flags, soa;                                            \
+  } mvla__##f##_xform_job_t;                                                      \
+  static void mvla__##f##_xform_range(void *ctx, size_t begin, size_t end) {      \
+    const mvla__##f##_xform_job_t *job = (const mvla__##f##_xform_job_t *) ctx;   \
+    int stream = (job->flags & MVLA_XFORM_STREAM) != 0;                           \
+    int k;                                                                        \
+    if (job->soa) {                                                               \
+      const T *pa[4];                                                             \
+      T *po[4];                                                                   \
+      for (k = 0; k < 4; ++k) {                                                   \
+        pa[k] = job->a[k] != NULL ? job->a[k] + begin : NULL;                     \
+        po[k] = job->out[k] != NULL ? job->out[k] + begin : NULL;                 \
+      }                                                                           \
+      mvla__##f##_xform_k(job->m, pa, job->in_dims, po, job->out_dims,            \
+                          end - begin, job->flags);                               \
+    } else {                                                                      \
+      T ta[4][MVLA__GEOM_CHUNK], to[4][MVLA__GEOM_CHUNK];                         \
+      const T *pa[4] = {ta[0], ta[1], ta[2], ta[3]};                              \
+      T *po[4] = {to[0], to[1], to[2], to[3]};                                    \
+      size_t off;                                                                 \
+      for (off = begin; off < end;) {                                             \
+        size_t n = end - off < MVLA__GEOM_CHUNK ? end - off : MVLA__GEOM_CHUNK;   \
+        T *out = job->out[0] + off * job->out_dims;                               \
+        const T *in = job->a[0] + off * job->in_dims;                             \
+        mvla__##f##_geom_split(in, job->in_dims, ta, n);                          \
+        mvla__##f##_xform_k(job->m, pa, job->in_dims, po, job->out_dims, n,       \
+                            job->flags & ~MVLA_XFORM_STREAM);                     \
+        if (stream) {                                                             \
+          mvla__##f##_geom_merge(to, job->out_dims, (T *) ta, n);                 \
+          mvla__##f##_stream_k((const T *) ta, out, n * job->out_dims);           \
+        } else {                                                                  \
+          mvla__##f##_geom_merge(to, job->out_dims, out, n);                      \
+        }                                                                         \
+        off += n;                                                                 \
+      }                                                                           \
+    }                                                                             \
+    if (stream) {                                                                 \
+      mvla__sfence();                                                             \
+    }                                                                             \
+  }                                                                               \
+  static void mvla__##f##_xform(mvla__##f##_xform_job_t *job, const T *m,         \
+                                size_t n) {                                       \
+    job->m = m;                                                                   \
+    if (m[3] == 0 && m[7] == 0 && m[11] == 0 && m[15] == 1) {                     \
+      job->flags |= MVLA_XFORM_AFFINE;                                            \
+    }                                                                             \
+    mvla__parallel_for(n, mvla__##f##_xform_range, job);                          \
+  }
+
+MVLA__XFORM_BATCH(f32, float)
+MVLA__XFORM_BATCH(f64, double)
+
+// matrix arrays run through the SoA inverse kernels in chunks, gathered into
+// one array per element and scattered back
+#define MVLA__MAT_CHUNK 64
+
+// one array per element of each matrix, four 4x4 float matrices a column at a
+// time in registers
+static inline void mvla__f32_mat_split(const float *a, int nn, float (*t)[MVLA__MAT_CHUNK],
+                                       size_t n) {
+  size_t i = 0;
+  int k;
+#ifdef MVLA_HAS_SSE2
+  for (; nn == 16 && i + 4 <= n; i += 4) {
+    for (k = 0; k < 4; ++k) {
+      __m128 c0 = _mm_loadu_ps(a + i * 16 + k * 4);
+      __m128 c1 = _mm_loadu_ps(a + i * 16 + k * 4 + 16);
+      __m128 c2 = _mm_loadu_ps(a + i * 16 + k * 4 + 32);
+      __m128 c3 = _mm_loadu_ps(a + i * 16 + k * 4 + 48);
+      _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+      _mm_storeu_ps(t[k * 4] + i, c0);
+      _mm_storeu_ps(t[k * 4 + 1] + i, c1);
+      _mm_storeu_ps(t[k * 4 + 2] + i, c2);
+      _mm_storeu_ps(t[k * 4 + 3] + i, c3);
+    }
+  }
+#endif // MVLA_HAS_SSE2
+  for (; i < n; ++i) {
+    for (k = 0; k < nn; ++k) {
+      t[k][i] = a[i * nn + k];
+    }
+  }
+}
+
+static inline void mvla__f32_mat_merge(float (*t)[MVLA__MAT_CHUNK], int nn, float *out,
+                                       size_t n) {
+  size_t i = 0;
+  int k;
+#ifdef MVLA_HAS_SSE2
+  for (; nn == 16 && i + 4 <= n; i += 4) {
+    for (k = 0; k < 4; ++k) {
+      __m128 r0 = _mm_loadu_ps(t[k * 4] + i);
+      __m128 r1 = _mm_loadu_ps(t[k * 4 + 1] + i);
+      __m128 r2 = _mm_loadu_ps(t[k * 4 + 2] + i);
+      __m128 r3 = _mm_loadu_ps(t[k * 4 + 3] + i);
+      _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+      _mm_storeu_ps(out + i * 16 + k * 4, r0);
+      _mm_storeu_ps(out + i * 16 + k * 4 + 16, r1);
+      _mm_storeu_ps(out + i * 16 + k * 4 + 32, r2);
+      _mm_storeu_ps(out + i * 16 + k * 4 + 48, r3);
+    }
+  }
+#endif // MVLA_HAS_SSE2
+  for (; i < n; ++i) {
+    for (k = 0; k < nn; ++k) {
+      out[i * nn + k] = t[k][i];
+    }
+  }
+}
+
+static inline void mvla__f64_mat_split(const double *a, int nn, double (*t)[MVLA__MAT_CHUNK],
+                                       size_t n) {
+  size_t i;
+  int k;
+  for (i = 0; i < n; ++i) {
+    for (k = 0; k < nn; ++k) {
+      t[k][i] = a[i * nn + k];
+    }
+  }
+}
+
+static inline void mvla__f64_mat_merge(double (*t)[MVLA__MAT_CHUNK], int nn, double *out,
+                                       size_t n) {
+  size_t i;
+  int k;
+  for (i = 0; i < n; ++i) {
+    for (k = 0; k < nn; ++k) {
+      out[i * nn + k] = t[k][i];
+    }
+  }
+}
+
+#define MVLA__MAT_BATCH(f, T)                                                     \
+  static size_t mvla__##f##_mat_batch(const T *a, int dims, T *out, T *det,       \
+                                      unsigned char *singular, size_t n, int rigid) { \
+    T ta[16][MVLA__MAT_CHUNK], to[16][MVLA__MAT_CHUNK];                           \
+    const T *pa[16];                                                              \
+    T *po[16];                                                                    \
+    size_t off, count = 0;                                                        \
+    int nn = dims * dims, k;                                                      \
+    for (k = 0; k < 16; ++k) {                                                    \
+      pa[k] = ta[k];                                                              \
+      po[k] = to[k];                                                              \
+    }                                                                             \
+    for (off = 0; off < n; off += MVLA__MAT_CHUNK) {                              \
+      size_t m = n - off < MVLA__MAT_CHUNK ? n - off : MVLA__MAT_CHUNK;           \
+      mvla__##f##_mat_split(a + off * nn, nn, ta, m);                             \
+      if (rigid) {                                                                \
+        mvla__##f##_rigid_k(pa, po, m);                                           \
+      } else {                                                                    \
+        count += mvla__##f##_inverse_k(pa, dims, out != NULL ? po : NULL,         \
+                                       det != NULL ? det + off : NULL,            \
+                                       singular != NULL ? singular + off : NULL, m); \
+      }                                                                           \
+      if (out != NULL) {                                                          \
+        mvla__##f##_mat_merge(to, nn, out + off * nn, m);                         \
+      }                                                                           \
+    }                                                                             \
+    return count;                                                                 \
+  }
+
+MVLA__MAT_BATCH(f32, float)
+MVLA__MAT_BATCH(f64, double)
+
+MVLAIMPL void mat4x4f_transform_v3f_n(mat4x4f_t m, const v3f_t *a, v3f_t *out, size_t n, int flags) {
+  mvla__f32_xform_job_t job = {NULL, {NULL, NULL, NULL, NULL}, {NULL, NULL, NULL, NULL}, 3, 3, 0, 0};
+  job.a[0] = (const float *) a;
+  job.out[0] = (float *) out;
+  job.flags = flags;
+  mvla__f32_xform(&job, &m.c[0].x, n);
+}
+
+MVLAIMPL void mat4x4f_transform_v4f_n(mat4x4f_t m, const v4f_t *a, v4f_t *out, size_t n, int flags) {
+  mvla__f32_xform_job_t job = {NULL, {NULL, NULL, NULL, NULL}, {NULL, NULL, NULL, NULL}, 4, 4, 0, 0};
+  job.a[0] = (const float *) a;
+  job.out[0] = (float *) out;
+  job.flags = flags;
+  mvla__f32_xform(&job, &m.c[0].x, n);
+}
+
+MVLAIMPL void mat4x4f_transform_v3f_soa(mat4x4f_t m, const v3f_soa_t *a, v3f_soa_t *out, int flags) {
+  mvla__f32_xform_job_t job = {NULL, {NULL, NULL, NULL, NULL}, {NULL, NULL, NULL, NULL}, 3, 3, 0, 1};
+  job.a[0] = a->x;
+  job.a[1] = a->y;
+  job.a[2] = a->z;
+  job.out[0] = out->x;
+  job.out[1] = out->y;
+  job.out[2] = out->z;
+  job.flags = flags;
+  mvla__f32_xform(&job, &m.c[0].x, a->count);
+}
+
+MVLAIMPL void mat4x4f_transform_v4f_soa(mat4x4f_t m, const v4f_soa_t *a, v4f_soa_t *out, int flags) {
+  mvla__f32_xform_job_t job = {NULL, {NULL, NULL, NULL, NULL}, {NULL, NULL, NULL, NULL}, 4, 4, 0, 1};
+  job.a[0] = a->x;
+  job.a[1] = a->y;
+  job.a[2] = a->z;
+  job.a[3] = a->w;
+  job.out[0] = out->x;
+  job.out[1] = out->y;
+  job.out[2] = out->z;
+  job.out[3] = out->w;
+  job.flags = flags;
+  mvla__f32_xform(&job, &m.c[0].x, a->count);
+}
+
+MVLAIMPL void mat4x4d_transform_v3d_n(mat4x4d_t m, const v3d_t *a, v3d_t *out, size_t n, int flags) {
+  mvla__f64_xform_job_t job = {NULL, {NULL, NULL, NULL, NULL}, {NULL, NULL, NULL, NULL}, 3, 3, 0, 0};
+  job.a[0] = (const double *) a;
+  job.out[0] = (double *) out;
+  job.flags = flags;
+  mvla__f64_xform(&job, &m.c[0].x, n);
+}
+
+MVLAIMPL void mat4x4d_transform_v4d_n(mat4x4d_t m, const v4d_t *a, v4d_t *out, size_t n, int flags) {
+  mvla__f64_xform_job_t job = {NULL, {NULL, NULL, NULL, NULL}, {NULL, NULL, NULL, NULL}, 4, 4, 0, 0};
+  job.a[0] = (const double *) a;
+  job.out[0] = (double *) out;
+  job.flags = flags;
+  mvla__f64_xform(&job, &m.c[0].x, n);
+}
+
+MVLAIMPL void mat4x4d_transform_v3d_soa(mat4x4d_t m, const v3d_soa_t *a, v3d_soa_t *out, int flags) {
+  mvla__f64_xform_job_t job = {NULL, {NULL, NULL, NULL, NULL}, {NULL, NULL, NULL, NULL}, 3, 3, 0, 1};
+  job.a[0] = a->x;
+  job.a[1] = a->y;
+  job.a[2] = a->z;
+  job.out[0] = out->x;
+  job.out[1] = out->y;
+  job.out[2] = out->z;
+  job.flags = flags;
+  mvla__f64_xform(&job, &m.c[0].x, a->count);
+}
+
+MVLAIMPL void mat4x4d_transform_v4d_soa(mat4x4d_t m, const v4d_soa_t *a, v4d_soa_t *out, int flags) {
+  mvla__f64_xform_job_t job = {NULL, {NULL, NULL, NULL, NULL}, {NULL, NULL, NULL, NULL}, 4, 4, 0, 1};
+  job.a[0] = a->x;
+  job.a[1] = a->y;
+  job.a[2] = a->z;
+  job.a[3] = a->w;
+  job.out[0] = out->x;
+  job.out[1] = out->y;
+  job.out[2] = out->z;
+  job.out[3] = out->w;
+  job.flags = flags;
+  mvla__f64_xform(&job, &m.c[0].x, a->count);
+}
+
+// mat3x3f_t
+
+MVLAIMPL mat3x3f_soa_t mat3x3f_soa_alloc(size_t n) {
+  mat3x3f_soa_t soa;
+  size_t stride = mvla__soa_stride(n, sizeof(float));
+  char *base = (char *) mvla__aligned_alloc(stride * 9, MVLA_SOA_ALIGN);
+  int k;
+  for (k = 0; k < 9; ++k) {
+    soa.m[k] = base == NULL ? NULL : (float *) (base + stride * k);
+  }
+  soa.count = base == NULL ? 0 : n;
+  return soa;
+}
+
+MVLAIMPL void mat3x3f_soa_free(mat3x3f_soa_t *soa) {
+  int k;
+  mvla__aligned_free(soa->m[0]);
+  for (k = 0; k < 9; ++k) {
+    soa->m[k] = NULL;
+  }
+  soa->count = 0;
+}
+
+MVLAIMPL mat3x3f_t mat3x3f_soa_get(const mat3x3f_soa_t *soa, size_t i) {
+  mat3x3f_t m;
+  float *e = &m.c[0].x;
+  int k;
+  for (k = 0; k < 9; ++k) {
+    e[k] = soa->m[k][i];
+  }
+  return m;
+}
+
+MVLAIMPL void mat3x3f_soa_set(mat3x3f_soa_t *soa, size_t i, mat3x3f_t m) {
+  const float *e = &m.c[0].x;
+  int k;
+  for (k = 0; k < 9; ++k) {
+    soa->m[k][i] = e[k];
+  }
+}
+
+MVLAIMPL void mat3x3f_soa_det(const mat3x3f_soa_t *a, float *out) {
+  mvla__f32_inverse_k((const float *const *) a->m, 3, NULL, out, NULL, a->count);
+}
+
+MVLAIMPL size_t mat3x3f_soa_inverse(const mat3x3f_soa_t *a, mat3x3f_soa_t *out, unsigned char *singular) {
+  return mvla__f32_inverse_k((const float *const *) a->m, 3, out->m, NULL, singular, a->count);
+}
+
+MVLAIMPL void mat3x3f_det_n(const mat3x3f_t *a, float *out, size_t n) {
+  mvla__f32_mat_batch((const float *) a, 3, NULL, out, NULL, n, 0);
+}
+
+MVLAIMPL size_t mat3x3f_inverse_n(const mat3x3f_t *a, mat3x3f_t *out, size_t n, unsigned char *singular) {
+  return mvla__f32_mat_batch((const float *) a, 3, (float *) out, NULL, singular, n, 0);
+}
+
+// mat3x3d_t
+
+MVLAIMPL mat3x3d_soa_t mat3x3d_soa_alloc(size_t n) {
+  mat3x3d_soa_t soa;
+  size_t stride = mvla__soa_stride(n, sizeof(double));
+  char *base = (char *) mvla__aligned_alloc(stride * 9, MVLA_SOA_ALIGN);
+  int k;
+  for (k = 0; k < 9; ++k) {
+    soa.m[k] = base == NULL ? NULL : (double *) (base + stride * k);
+  }
+  soa.count = base == NULL ? 0 : n;
+  return soa;
+}
+
+MVLAIMPL void mat3x3d_soa_free(mat3x3d_soa_t *soa) {
+  int k;
+  mvla__aligned_free(soa->m[0]);
+  for (k = 0; k < 9; ++k) {
+    soa->m[k] = NULL;
+  }
+  soa->count = 0;
+}
+
+MVLAIMPL mat3x3d_t mat3x3d_soa_get(const mat3x3d_soa_t *soa, size_t i) {
+  mat3x3d_t m;
+  double *e = &m.c[0].x;
+  int k;
+  for (k = 0; k < 9; ++k) {
+    e[k] = soa->m[k][i];
+  }
+  return m;
+}
+
+MVLAIMPL void mat3x3d_soa_set(mat3x3d_soa_t *soa, size_t i, mat3x3d_t m) {
+  const double *e = &m.c[0].x;
+  int k;
+  for (k = 0; k < 9; ++k) {
+    soa->m[k][i] = e[k];
+  }
+}
+
+MVLAIMPL void mat3x3d_soa_det(const mat3x3d_soa_t *a, double *out) {
+  mvla__f64_inverse_k((const double *const *) a->m, 3, NULL, out, NULL, a->count);
+}
+
+MVLAIMPL size_t mat3x3d_soa_inverse(const mat3x3d_soa_t *a, mat3x3d_soa_t *out, unsigned char *singular) {
+  return mvla__f64_inverse_k((const double *const *) a->m, 3, out->m, NULL, singular, a->count);
+}
+
+MVLAIMPL void mat3x3d_det_n(const mat3x3d_t *a, double *out, size_t n) {
+  mvla__f64_mat_batch((const double *) a, 3, NULL, out, NULL, n, 0);
+}
+
+MVLAIMPL size_t mat3x3d_inverse_n(const mat3x3d_t *a, mat3x3d_t *out, size_t n, unsigned char *singular) {
+  return mvla__f64_mat_batch((const double *) a, 3, (double *) out, NULL, singular, n, 0);
+}
+
+// mat4x4f_t
+
+MVLAIMPL mat4x4f_soa_t mat4x4f_soa_alloc(size_t n) {
+  mat4x4f_soa_t soa;
+  size_t stride = mvla__soa_stride(n, sizeof(float));
+  char *base = (char *) mvla__aligned_alloc(stride * 16, MVLA_SOA_ALIGN);
+  int k;
+  for (k = 0; k < 16; ++k) {
+    soa.m[k] = base == NULL ? NULL : (float *) (base + stride * k);
+  }
+  soa.count = base == NULL ? 0 : n;
+  return soa;
+}
+
+MVLAIMPL void mat4x4f_soa_free(mat4x4f_soa_t *soa) {
+  int k;
+  mvla__aligned_free(soa->m[0]);
+  for (k = 0; k < 16; ++k) {
+    soa->m[k] = NULL;
+  }
+  soa->count = 0;
+}
+
+MVLAIMPL mat4x4f_t mat4x4f_soa_get(const mat4x4f_soa_t *soa, size_t i) {
+  mat4x4f_t m;
+  float *e = &m.c[0].x;
+  int k;
+  for (k = 0; k < 16; ++k) {
+    e[k] = soa->m[k][i];
+  }
+  return m;
+}
+
+MVLAIMPL void mat4x4f_soa_set(mat4x4f_soa_t *soa, size_t i, mat4x4f_t m) {
+  const float *e = &m.c[0].x;
+  int k;
+  for (k = 0; k < 16; ++k) {
+    soa->m[k][i] = e[k];
+  }
+}
+
+MVLAIMPL void mat4x4f_soa_det(const mat4x4f_soa_t *a, float *out) {
+  mvla__f32_inverse_k((const float *const *) a->m, 4, NULL, out, NULL, a->count);
+}
+
+MVLAIMPL size_t mat4x4f_soa_inverse(const mat4x4f_soa_t *a, mat4x4f_soa_t *out, unsigned char *singular) {
+  return mvla__f32_inverse_k((const float *const *) a->m, 4, out->m, NULL, singular, a->count);
+}
+
+MVLAIMPL void mat4x4f_soa_inverse_rigid(const mat4x4f_soa_t *a, mat4x4f_soa_t *out) {
+  mvla__f32_rigid_k((const float *const *) a->m, out->m, a->count);
+}
+
+MVLAIMPL void mat4x4f_det_n(const mat4x4f_t *a, float *out, size_t n) {
+  mvla__f32_mat_batch((const float *) a, 4, NULL, out, NULL, n, 0);
+}
+
+MVLAIMPL size_t mat4x4f_inverse_n(const mat4x4f_t *a, mat4x4f_t *out, size_t n, unsigned char *singular) {
+  return mvla__f32_mat_batch((const float *) a, 4, (float *) out, NULL, singular, n, 0);
+}
+
+MVLAIMPL void mat4x4f_inverse_rigid_n(const mat4x4f_t *a, mat4x4f_t *out, size_t n) {
+  mvla__f32_mat_batch((const float *) a, 4, (float *) out, NULL, NULL, n, 1);
+}
+
+// mat4x4d_t
+
+MVLAIMPL mat4x4d_soa_t mat4x4d_soa_alloc(size_t n) {
+  mat4x4d_soa_t soa;
+  size_t stride = mvla__soa_stride(n, sizeof(double));
+  char *base = (char *) mvla__aligned_alloc(stride * 16, MVLA_SOA_ALIGN);
+  int k;
+  for (k = 0; k < 16; ++k) {
+    soa.m[k] = base == NULL ? NULL : (double *) (base + stride * k);
+  }
+  soa.count = base == NULL ? 0 : n;
+  return soa;
+}
+
+MVLAIMPL void mat4x4d_soa_free(mat4x4d_soa_t *soa) {
+  int k;
+  mvla__aligned_free(soa->m[0]);
+  for (k = 0; k < 16; ++k) {
+    soa->m[k] = NULL;
+  }
+  soa->count = 0;
+}
+
+MVLAIMPL mat4x4d_t mat4x4d_soa_get(const mat4x4d_soa_t *soa, size_t i) {
+  mat4x4d_t m;
+  double *e = &m.c[0].x;
+  int k;
+  for (k = 0; k < 16; ++k) {
+    e[k] = soa->m[k][i];
+  }
+  return m;
+}
+
+MVLAIMPL void mat4x4d_soa_set(mat4x4d_soa_t *soa, size_t i, mat4x4d_t m) {
+  const double *e = &m.c[0].x;
+  int k;
+  for (k = 0; k < 16; ++k) {
+    soa->m[k][i] = e[k];
+  }
+}
+
+MVLAIMPL void mat4x4d_soa_det(const mat4x4d_soa_t *a, double *out) {
+  mvla__f64_inverse_k((const double *const *) a->m, 4, NULL, out, NULL, a->count);
+}
+
+MVLAIMPL size_t mat4x4d_soa_inverse(const mat4x4d_soa_t *a, mat4x4d_soa_t *out, unsigned char *singular) {
+  return mvla__f64_inverse_k((const double *const *) a->m, 4, out->m, NULL, singular, a->count);
+}
+
+MVLAIMPL void mat4x4d_soa_inverse_rigid(const mat4x4d_soa_t *a, mat4x4d_soa_t *out) {
+  mvla__f64_rigid_k((const double *const *) a->m, out->m, a->count);
+}
+
+MVLAIMPL void mat4x4d_det_n(const mat4x4d_t *a, double *out, size_t n) {
+  mvla__f64_mat_batch((const double *) a, 4, NULL, out, NULL, n, 0);
+}
+
+MVLAIMPL size_t mat4x4d_inverse_n(const mat4x4d_t *a, mat4x4d_t *out, size_t n, unsigned char *singular) {
+  return mvla__f64_mat_batch((const double *) a, 4, (double *) out, NULL, singular, n, 0);
+}
+
+MVLAIMPL void mat4x4d_inverse_rigid_n(const mat4x4d_t *a, mat4x4d_t *out, size_t n) {
+  mvla__f64_mat_batch((const double *) a, 4, (double *) out, NULL, NULL, n, 1);
+}
+
+// -----------------------------------------
+
+/*
+** DYNAMIC VECTOR FUNCTIONS
+*/
+
+// mvla_vecf_t
+
+MVLAIMPL mvla_vecf_t mvla_vecf_alloc(size_t len) {
+  mvla_vecf_t v;
+  v.data = (float *) mvla__aligned_alloc(len * sizeof(float), MVLA_SOA_ALIGN);
+  v.len = v.data == NULL ? 0 : len;
+  return v;
+}
+
+MVLAIMPL mvla_vecf_t mvla_vecf_wrap(float *data, size_t len) {
+  mvla_vecf_t v;
+  v.data = data;
+  v.len = len;
+  return v;
+}
+
+MVLAIMPL void mvla_vecf_free(mvla_vecf_t *v) {
+  mvla__aligned_free(v->data);
+  v->data = NULL;
+  v->len = 0;
+}
+
+MVLAIMPL void mvla_vecf_fill(mvla_vecf_t *v, float value) {
+  size_t i;
+  for (i = 0; i < v->len; ++i) {
+    v->data[i] = value;
+  }
+}
+
+MVLAIMPL void mvla_vecf_add(const mvla_vecf_t *a, const mvla_vecf_t *b, mvla_vecf_t *out) {
+  mvla__f32_add(a->data, b->data, out->data, a->len);
+}
+
+MVLAIMPL void mvla_vecf_sub(const mvla_vecf_t *a, const mvla_vecf_t *b, mvla_vecf_t *out) {
+  mvla__f32_sub(a->data, b->data, out->data, a->len);
+}
+
+MVLAIMPL void mvla_vecf_mul(const mvla_vecf_t *a, const mvla_vecf_t *b, mvla_vecf_t *out) {
+  mvla__f32_mul(a->data, b->data, out->data, a->len);
+}
+
+MVLAIMPL void mvla_vecf_div(const mvla_vecf_t *a, const mvla_vecf_t *b, mvla_vecf_t *out) {
+  mvla__f32_div(a->data, b->data, out->data, a->len);
+}
+
+MVLAIMPL void mvla_vecf_min(const mvla_vecf_t *a, const mvla_vecf_t *b, mvla_vecf_t *out) {
+  mvla__f32_min(a->data, b->data, out->data, a->len);
+}
+
+MVLAIMPL void mvla_vecf_max(const mvla_vecf_t *a, const mvla_vecf_t *b, mvla_vecf_t *out) {
+  mvla__f32_max(a->data, b->data, out->data, a->len);
+}
+
+MVLAIMPL void mvla_vecf_sqrt(const mvla_vecf_t *a, mvla_vecf_t *out) {
+  mvla__f32_sqrt(a->data, out->data, a->len);
+}
+
+MVLAIMPL void mvla_vecf_exp(const mvla_vecf_t *a, mvla_vecf_t *out) {
+  mvla__f32_exp(a->data, out->data, a->len);
+}
+
+MVLAIMPL void mvla_vecf_scale(const mvla_vecf_t *a, float s, mvla_vecf_t *out) {
+  mvla__f32_scal_k(s, a->data, out->data, a->len);
+}
+
+MVLAIMPL float mvla_vecf_dot(const mvla_vecf_t *a, const mvla_vecf_t *b) {
+  return dotf_n(a->data, b->data, a->len);
+}
+
+MVLAIMPL float mvla_vecf_len(const mvla_vecf_t *a) {
+  return nrm2f_n(a->data, a->len);
+}
+
+MVLAIMPL float mvla_vecf_sqr_len(const mvla_vecf_t *a) {
+  return (float) mvla__f32_sumsq_k(a->data, a->len);
+}
+
+// mvla_vecd_t
+
+MVLAIMPL mvla_vecd_t mvla_vecd_alloc(size_t len) {
+  mvla_vecd_t v;
+  v.data = (double *) mvla__aligned_alloc(len * sizeof(double), MVLA_SOA_ALIGN);
+  v.len = v.data == NULL ? 0 : len;
+  return v;
+}
+
+MVLAIMPL mvla_vecd_t mvla_vecd_wrap(double *data, size_t len) {
+  mvla_vecd_t v;
+  v.data = data;
+  v.len = len;
+  return v;
+}
+
+MVLAIMPL void mvla_vecd_free(mvla_vecd_t *v) {
+  mvla__aligned_free(v->data);
+  v->data = NULL;
+  v->len = 0;
+}
+
+MVLAIMPL void mvla_vecd_fill(mvla_vecd_t *v, double value) {
+  size_t i;
+  for (i = 0; i < v->len; ++i) {
+    v->data[i] = value;
+  }
+}
+
+MVLAIMPL void mvla_vecd_add(const mvla_vecd_t *a, const mvla_vecd_t *b, mvla_vecd_t *out) {
+  mvla__f64_add(a->data, b->data, out->data, a->len);
+}
+
+MVLAIMPL void mvla_vecd_sub(const mvla_vecd_t *a, const mvla_vecd_t *b, mvla_vecd_t *out) {
+  mvla__f64_sub(a->data, b->data, out->data, a->len);
+}
+
+MVLAIMPL void mvla_vecd_mul(const mvla_vecd_t *a, const mvla_vecd_t *b, mvla_vecd_t *out) {
+  mvla__f64_mul(a->data, b->data, out->data, a->len);
+}
+
+MVLAIMPL void mvla_vecd_div(const mvla_vecd_t *a, const mvla_vecd_t *b, mvla_vecd_t *out) {
+  mvla__f64_div(a->data, b->data, out->data, a->len);
+}
+
+MVLAIMPL void mvla_vecd_min(const mvla_vecd_t *a, const mvla_vecd_t *b, mvla_vecd_t *out) {
+  mvla__f64_min(a->data, b->data, out->data, a->len);
+}
+
+MVLAIMPL void mvla_vecd_max(const mvla_vecd_t *a, const mvla_vecd_t *b, mvla_vecd_t *out) {
+  mvla__f64_max(a->data, b->data, out->data, a->len);
+}
+
+MVLAIMPL void mvla_vecd_sqrt(const mvla_vecd_t *a, mvla_vecd_t *out) {
+  mvla__f64_sqrt(a->data, out->data, a->len);
+}
+
+MVLAIMPL void mvla_vecd_exp(const mvla_vecd_t *a, mvla_vecd_t *out) {
+  mvla__f64_exp(a->data, out->data, a->len);
+}
+
+MVLAIMPL void mvla_vecd_scale(const mvla_vecd_t *a, double s, mvla_vecd_t *out) {
+  mvla__f64_scal_k(s, a->data, out->data, a->len);
+}
+
+MVLAIMPL double mvla_vecd_dot(const mvla_vecd_t *a, const mvla_vecd_t *b) {
+  return dotd_n(a->data, b->data, a->len);
+}
+
+MVLAIMPL double mvla_vecd_len(const mvla_vecd_t *a) {
+  return nrm2d_n(a->data, a->len);
+}
+
+MVLAIMPL double mvla_vecd_sqr_len(const mvla_vecd_t *a) {
+  return (double) mvla__f64_sumsq_k(a->data, a->len);
+}
+
+// -----------------------------------------
+
+/*
+** DENSE MATRIX FUNCTIONS
+**
+** The GEMM driver loops over NC wide panels of B and KC deep slices of the
+** product, packs each KC x NC panel of B into slivers of NR columns, then each
+** MC x KC block of A into slivers of MR rows, and runs the micro-kernel for
+** every MR x NR tile of the block. Packing zero pads partial slivers so only
+** the stores of edge tiles are special. If the pack buffers can't be
+** allocated it falls back to the plain triple loop.
+**
+** With threads, every thread packs a share of the B panel into one buffer
+** they all read, then the MC row blocks times NC / nb column strips of the
+** panel are dealt out as contiguous runs, at least four per thread so uneven
+** grids still balance. Each thread packs its row block of A into its own
+** buffer once per run. Threads are only used past MVLA__GEMM_GRAIN
+** multiply-adds per thread and panel. Every tile sums in the same order
+** whatever the thread count, so the result doesn't depend on it.
+**
+** GEMV splits the rows of y (the columns of A when transposed) across
+** threads past MVLA__GEMV_GRAIN elements of A per thread. Without transpose
+** it walks MVLA__GEMV_ROWS rows at a time so that stretch of y stays in L1
+** while the kernel streams four columns of A through it.
+*/
+
+#define MVLA__GEMM_GRAIN ((size_t) MVLA_PARALLEL_GRAIN * 64)
+#define MVLA__GEMV_GRAIN ((size_t) MVLA_PARALLEL_GRAIN * 8)
+#define MVLA__GEMV_ROWS 2048
+
+// op(A)(i, p) = a[i * rs + p * cs], an mc x kc block into slivers of mr rows
+#define MVLA__GEMM_PACK(f, T)                                                     \
+  static void mvla__##f##_gemm_pack_a(const T *a, size_t rs, size_t cs, size_t mc, \
+                                      size_t kc, size_t mr, T *pa) {             \
+    size_t ir, p, r;                                                              \
+    for (ir = 0; ir < mc; ir += mr) {                                             \
+      size_t m = mc - ir < mr ? mc - ir : mr;                                     \
+      for (p = 0; p < kc; ++p) {                                                  \
+        const T *src = a + ir * rs + p * cs;                                      \
+        for (r = 0; r < m; ++r) {                                                 \
+          *pa++ = src[r * rs];                                                    \
+        }                                                                         \
+        for (; r < mr; ++r) {                                                     \
+          *pa++ = 0;                                                              \
+        }                                                                         \
+      }                                                                           \
+    }                                                                             \
+  }                                                                               \
+  static void mvla__##f##_gemm_pack_b(const T *b, size_t rs, size_t cs, size_t kc, \
+                                      size_t nc, size_t nr, T *pb) {             \
+    size_t jr, p, q;                                                              \
+    for (jr = 0; jr < nc; jr += nr) {                                             \
+      size_t n = nc - jr < nr ? nc - jr : nr;                                     \
+      for (p = 0; p < kc; ++p) {                                                  \
+        const T *src = b + p * rs + jr * cs;                                      \
+        for (q = 0; q < n; ++q) {                                                 \
+          *pb++ = src[q * cs];                                                    \
+        }                                                                         \
+        for (; q < nr; ++q) {                                                     \
+          *pb++ = 0;                                                              \
+        }                                                                         \
+      }                                                                           \
+    }                                                                             \
+  }
+
+MVLA__GEMM_PACK(f32, float)
+MVLA__GEMM_PACK(f64, double)
+
+#define MVLA__GEMM_DRIVER(f, T)                                                   \
+  typedef struct mvla__##f##_gemm_job {                                           \
+    const mvla__kernels_t *kern;                                                  \
+    const T *a, *b;                                                               \
+    T *c, *pa, *pb;                                                               \
+    size_t ars, acs, brs, bcs, ldc, m, kc, nc, mr, nr, mcb, pa_len;               \
+    size_t parts, mb, nb, ncw;                                                    \
+    T alpha, beta;                                                                \
+  } mvla__##f##_gemm_job_t;                                                       \
+  static void mvla__##f##_gemm_pack_range(void *ctx, size_t begin, size_t end) {  \
+    mvla__##f##_gemm_job_t *job = (mvla__##f##_gemm_job_t *) ctx;                 \
+    size_t slivers = (job->nc + job->nr - 1) / job->nr;                           \
+    size_t j0 = slivers * begin / job->parts * job->nr;                           \
+    size_t j1 = slivers * end / job->parts * job->nr;                             \
+    if (j1 > job->nc) {                                                           \
+      j1 = job->nc;                                                               \
+    }                                                                             \
+    if (j0 < j1) {                                                                \
+      mvla__##f##_gemm_pack_b(job->b + j0 * job->bcs, job->brs, job->bcs, job->kc, j1 - j0, \
+                              job->nr, job->pb + j0 * job->kc);                   \
+    }                                                                             \
+  }                                                                               \
+  static void mvla__##f##_gemm_tile_range(void *ctx, size_t begin, size_t end) {  \
+    mvla__##f##_gemm_job_t *job = (mvla__##f##_gemm_job_t *) ctx;                 \
+    size_t units = job->mb * job->nb;                                             \
+    size_t u = units * begin / job->parts, u1 = units * end / job->parts;         \
+    size_t last = (size_t) -1, kc = job->kc, mr = job->mr, nr = job->nr;          \
+    T *pa = job->pa + begin * job->pa_len;                                        \
+    for (; u < u1; ++u) {                                                         \
+      size_t ib = u / job->nb, ic = ib * job->mcb, jr = u % job->nb * job->ncw;   \
+      size_t mc = job->m - ic < job->mcb ? job->m - ic : job->mcb;                \
+      size_t jend = job->nc - jr < job->ncw ? job->nc : jr + job->ncw;            \
+      size_t ir;                                                                  \
+      if (ib != last) {                                                           \
+        mvla__##f##_gemm_pack_a(job->a + ic * job->ars, job->ars, job->acs, mc, kc, mr, pa); \
+        last = ib;                                                                \
+      }                                                                           \
+      for (; jr < jend; jr += nr) {                                               \
+        for (ir = 0; ir < mc; ir += mr) {                                         \
+          job->kern->f##_gemm_micro(kc, pa + ir * kc, job->pb + jr * kc, job->alpha, \
+                                    job->beta, job->c + jr * job->ldc + ic + ir, job->ldc, \
+                                    mc - ir < mr ? mc - ir : mr,                  \
+                                    jend - jr < nr ? jend - jr : nr);             \
+        }                                                                         \
+      }                                                                           \
+    }                                                                             \
+  }                                                                               \
+  static void mvla__##f##_gemm(int ta, int tb, size_t m, size_t n, size_t k, T alpha, \
+                               const T *a, size_t lda, const T *b, size_t ldb,    \
+                               T beta, T *c, size_t ldc) {                        \
+    mvla__##f##_gemm_job_t job;                                                   \
+    size_t mr, nr, mcb, ncb, kcb, i, j, p, jc, pc, slivers;                       \
+    if (m == 0 || n == 0) {                                                       \
+      return;                                                                     \
+    }                                                                             \
+    if (k == 0 || alpha == 0) {                                                   \
+      for (j = 0; j < n; ++j) {                                                   \
+        for (i = 0; i < m; ++i) {                                                 \
+          c[j * ldc + i] = beta == 0 ? 0 : beta * c[j * ldc + i];                 \
+        }                                                                         \
+      }                                                                           \
+      return;                                                                     \
+    }                                                                             \
+    job.kern = mvla__kernels_get();                                               \
+    mr = job.mr = job.kern->f##_gemm_mr;                                          \
+    nr = job.nr = job.kern->f##_gemm_nr;                                          \
+    mcb = job.mcb = MVLA_GEMM_MC > mr ? MVLA_GEMM_MC / mr * mr : mr;              \
+    ncb = MVLA_GEMM_NC > nr ? MVLA_GEMM_NC / nr * nr : nr;                        \
+    kcb = k < MVLA_GEMM_KC ? k : MVLA_GEMM_KC;                                    \
+    if (ncb > (n + nr - 1) / nr * nr) {                                           \
+      ncb = (n + nr - 1) / nr * nr;                                               \
+    }                                                                             \
+    job.ars = ta ? lda : 1;                                                       \
+    job.acs = ta ? 1 : lda;                                                       \
+    job.brs = tb ? ldb : 1;                                                       \
+    job.bcs = tb ? 1 : ldb;                                                       \
+    job.ldc = ldc;                                                                \
+    job.m = m;                                                                    \
+    job.alpha = alpha;                                                            \
+    job.pa_len = mvla__soa_stride(mcb * kcb, sizeof(T)) / sizeof(T);              \
+    job.parts = (size_t) mvla_threads_get();                                      \
+    if (m * ncb * kcb / MVLA__GEMM_GRAIN < job.parts) {                           \
+      job.parts = m * ncb * kcb / MVLA__GEMM_GRAIN > 0 ? m * ncb * kcb / MVLA__GEMM_GRAIN : 1; \
+    }                                                                             \
+    job.pa = (T *) mvla__aligned_alloc(job.parts * job.pa_len * sizeof(T), MVLA_SOA_ALIGN); \
+    job.pb = (T *) mvla__aligned_alloc(kcb * ncb * sizeof(T), MVLA_SOA_ALIGN);    \
+    if (job.pa == NULL || job.pb == NULL) {                                       \
+      mvla__aligned_free(job.pa);                                                 \
+      mvla__aligned_free(job.pb);                                                 \
+      for (j = 0; j < n; ++j) {                                                   \
+        for (i = 0; i < m; ++i) {                                                 \
+          T sum = 0;                                                              \
+          for (p = 0; p < k; ++p) {                                               \
+            sum += a[i * job.ars + p * job.acs] * b[p * job.brs + j * job.bcs];   \
+          }                                                                       \
+          c[j * ldc + i] = beta == 0 ? alpha * sum : alpha * sum + beta * c[j * ldc + i]; \
+        }                                                                         \
+      }                                                                           \
+      return;                                                                     \
+    }                                                                             \
+    job.mb = (m + mcb - 1) / mcb;                                                 \
+    for (jc = 0; jc < n; jc += ncb) {                                             \
+      job.nc = n - jc < ncb ? n - jc : ncb;                                       \
+      slivers = (job.nc + nr - 1) / nr;                                           \
+      job.nb = 1;                                                                 \
+      if (job.parts > 1 && job.mb < 4 * job.parts) {                              \
+        job.nb = (4 * job.parts + job.mb - 1) / job.mb;                           \
+        if (job.nb > slivers / 4) {                                               \
+          job.nb = slivers / 4 > 0 ? slivers / 4 : 1;                             \
+        }                                                                         \
+      }                                                                           \
+      job.ncw = (slivers + job.nb - 1) / job.nb * nr;                             \
+      job.nb = (job.nc + job.ncw - 1) / job.ncw;                                  \
+      job.c = c + jc * ldc;                                                       \
+      for (pc = 0; pc < k; pc += kcb) {                                           \
+        job.kc = k - pc < kcb ? k - pc : kcb;                                     \
+        job.beta = pc == 0 ? beta : 1;                                            \
+        job.a = a + pc * job.acs;                                                 \
+        job.b = b + pc * job.brs + jc * job.bcs;                                  \
+        mvla__parallel_run(job.parts, mvla__##f##_gemm_pack_range, &job);         \
+        mvla__parallel_run(job.parts, mvla__##f##_gemm_tile_range, &job);         \
+      }                                                                           \
+    }                                                                             \
+    mvla__aligned_free(job.pa);                                                   \
+    mvla__aligned_free(job.pb);                                                   \
+  }
+
+MVLA__GEMM_DRIVER(f32, float)
+MVLA__GEMM_DRIVER(f64, double)
+
+#define MVLA__GEMV_DRIVER(f, T)                                                   \
+  typedef struct mvla__##f##_gemv_job {                                           \
+    const mvla__kernels_t *kern;                                                  \
+    const T *a, *x;                                                               \
+    T *y;                                                                         \
+    size_t m, n, lda, parts;                                                      \
+    T alpha, beta;                                                                \
+    int trans;                                                                    \
+  } mvla__##f##_gemv_job_t;                                                       \
+  static void mvla__##f##_gemv_range(void *ctx, size_t begin, size_t end) {       \
+    mvla__##f##_gemv_job_t *job = (mvla__##f##_gemv_job_t *) ctx;                 \
+    size_t len = job->trans ? job->n : job->m, i, j;                              \
+    size_t lo = len * begin / job->parts, hi = len * end / job->parts;            \
+    if (job->trans) {                                                             \
+      for (j = lo; j < hi; ++j) {                                                 \
+        T dot = job->alpha * job->kern->f##_vdot_k(job->a + j * job->lda, job->x, job->m); \
+        job->y[j] = job->beta == 0 ? dot : dot + job->beta * job->y[j];           \
+      }                                                                           \
+      return;                                                                     \
+    }                                                                             \
+    lo = begin == 0 ? 0 : lo & ~(size_t) 15;                                      \
+    hi = end == job->parts ? len : hi & ~(size_t) 15;                             \
+    for (i = lo; i < hi; i += MVLA__GEMV_ROWS) {                                  \
+      size_t rows = hi - i < MVLA__GEMV_ROWS ? hi - i : MVLA__GEMV_ROWS;          \
+      if (job->beta == 0) {                                                       \
+        memset(job->y + i, 0, rows * sizeof(T));                                  \
+      } else if (job->beta != 1) {                                                \
+        job->kern->f##_scal_k(job->beta, job->y + i, job->y + i, rows);           \
+      }                                                                           \
+      job->kern->f##_gemv_k(rows, job->n, job->alpha, job->a + i, job->lda, job->x, job->y + i); \
+    }                                                                             \
+  }                                                                               \
+  static void mvla__##f##_gemv(int trans, size_t m, size_t n, T alpha, const T *a, \
+                               size_t lda, const T *x, T beta, T *y) {            \
+    mvla__##f##_gemv_job_t job;                                                   \
+    job.kern = mvla__kernels_get();                                               \
+    job.a = a;                                                                    \
+    job.x = x;                                                                    \
+    job.y = y;                                                                    \
+    job.m = m;                                                                    \
+    job.n = n;                                                                    \
+    job.lda = lda;                                                                \
+    job.alpha = alpha;                                                            \
+    job.beta = beta;                                                              \
+    job.trans = trans;                                                            \
+    job.parts = (size_t) mvla_threads_get();                                      \
+    if (m * n / MVLA__GEMV_GRAIN < job.parts) {                                   \
+      job.parts = m * n / MVLA__GEMV_GRAIN > 0 ? m * n / MVLA__GEMV_GRAIN : 1;    \
+    }                                                                             \
+    mvla__parallel_run(job.parts, mvla__##f##_gemv_range, &job);                  \
+  }
+
+MVLA__GEMV_DRIVER(f32, float)
+MVLA__GEMV_DRIVER(f64, double)
+
+MVLAIMPL void gemmf(mvla_trans_t transa, mvla_trans_t transb, size_t m, size_t n, size_t k,
+                    float alpha, const float *a, size_t lda, const float *b, size_t ldb,
+                    float beta, float *c, size_t ldc) {
+  mvla__f32_gemm(transa == MVLA_TRANS, transb == MVLA_TRANS, m, n, k, alpha, a, lda, b, ldb,
+                beta, c, ldc);
+}
+
+MVLAIMPL void gemvf(mvla_trans_t trans, size_t m, size_t n, float alpha, const float *a,
+                    size_t lda, const float *x, float beta, float *y) {
+  mvla__f32_gemv(trans == MVLA_TRANS, m, n, alpha, a, lda, x, beta, y);
+}
+
+// mvla_matf_t
+
+MVLAIMPL mvla_matf_t mvla_matf_alloc(size_t rows, size_t cols) {
+  mvla_matf_t m;
+  size_t stride = mvla__soa_stride(rows, sizeof(float));
+  // a wrapped stride or size would report the full shape over a small buffer
+  if (rows > ((size_t) -1 - MVLA_SOA_ALIGN) / sizeof(float) ||
+      (stride != 0 && cols > (size_t) -1 / stride)) {
+    m.data = NULL;
+    m.rows = 0;
+    m.cols = 0;
+    m.ld = 0;
+    return m;
+  }
+  m.data = (float *) mvla__aligned_alloc(stride * cols, MVLA_SOA_ALIGN);
+  m.rows = m.data == NULL ? 0 : rows;
+  m.cols = m.data == NULL ? 0 : cols;
+  m.ld = stride / sizeof(float);
+  return m;
+}
+
+MVLAIMPL mvla_matf_t mvla_matf_wrap(float *data, size_t rows, size_t cols, size_t ld) {
+  mvla_matf_t m;
+  m.data = data;
+  m.rows = rows;
+  m.cols = cols;
+  m.ld = ld;
+  return m;
+}
+
+MVLAIMPL void mvla_matf_free(mvla_matf_t *m) {
+  mvla__aligned_free(m->data);
+  m->data = NULL;
+  m->rows = 0;
+  m->cols = 0;
+}
+
+MVLAIMPL float mvla_matf_get(const mvla_matf_t *m, size_t i, size_t j) {
+  return m->data[j * m->ld + i];
+}
+
+MVLAIMPL void mvla_matf_set(mvla_matf_t *m, size_t i, size_t j, float value) {
+  m->data[j * m->ld + i] = value;
+}
+
+MVLAIMPL void mvla_matf_gemm(mvla_trans_t transa, mvla_trans_t transb, float alpha, const mvla_matf_t *a,
+                         const mvla_matf_t *b, float beta, mvla_matf_t *c) {
+  size_t k = transa == MVLA_TRANS ? a->rows : a->cols;
+  gemmf(transa, transb, c->rows, c->cols, k, alpha, a->data, a->ld, b->data, b->ld, beta,
+        c->data, c->ld);
+}
+
+MVLAIMPL void mvla_matf_gemv(mvla_trans_t trans, float alpha, const mvla_matf_t *a,
+                         const mvla_vecf_t *x, float beta, mvla_vecf_t *y) {
+  gemvf(trans, a->rows, a->cols, alpha, a->data, a->ld, x->data, beta, y->data);
+}
+
+MVLAIMPL void gemmd(mvla_trans_t transa, mvla_trans_t transb, size_t m, size_t n, size_t k,
+                    double alpha, const double *a, size_t lda, const double *b, size_t ldb,
+                    double beta, double *c, size_t ldc) {
+  mvla__f64_gemm(transa == MVLA_TRANS, transb == MVLA_TRANS, m, n, k, alpha, a, lda, b, ldb,
+                beta, c, ldc);
+}
+
+MVLAIMPL void gemvd(mvla_trans_t trans, size_t m, size_t n, double alpha, const double *a,
+                    size_t lda, const double *x, double beta, double *y) {
+  mvla__f64_gemv(trans == MVLA_TRANS, m, n, alpha, a, lda, x, beta, y);
+}
+
+// mvla_matd_t
+
+MVLAIMPL mvla_matd_t mvla_matd_alloc(size_t rows, size_t cols) {
+  mvla_matd_t m;
+  size_t stride = mvla__soa_stride(rows, sizeof(double));
+  // a wrapped stride or size would report the full shape over a small buffer
+  if (rows > ((size_t) -1 - MVLA_SOA_ALIGN) / sizeof(double) ||
+      (stride != 0 && cols > (size_t) -1 / stride)) {
+    m.data = NULL;
+    m.rows = 0;
+    m.cols = 0;
+    m.ld = 0;
+    return m;
+  }
+  m.data = (double *) mvla__aligned_alloc(stride * cols, MVLA_SOA_ALIGN);
+  m.rows = m.data == NULL ? 0 : rows;
+  m.cols = m.data == NULL ? 0 : cols;
+  m.ld = stride / sizeof(double);
+  return m;
+}
+
+MVLAIMPL mvla_matd_t mvla_matd_wrap(double *data, size_t rows, size_t cols, size_t ld) {
+  mvla_matd_t m;
+  m.data = data;
+  m.rows = rows;
+  m.cols = cols;
+  m.ld = ld;
+  return m;
+}
+
+MVLAIMPL void mvla_matd_free(mvla_matd_t *m) {
+  mvla__aligned_free(m->data);
+  m->data = NULL;
+  m->rows = 0;
+  m->cols = 0;
+}
+
+MVLAIMPL double mvla_matd_get(const mvla_matd_t *m, size_t i, size_t j) {
+  return m->data[j * m->ld + i];
+}
+
+MVLAIMPL void mvla_matd_set(mvla_matd_t *m, size_t i, size_t j, double value) {
+  m->data[j * m->ld + i] = value;
+}
+
+MVLAIMPL void mvla_matd_gemm(mvla_trans_t transa, mvla_trans_t transb, double alpha, const mvla_matd_t *a,
+                         const mvla_matd_t *b, double beta, mvla_matd_t *c) {
+  size_t k = transa == MVLA_TRANS ? a->rows : a->cols;
+  gemmd(transa, transb, c->rows, c->cols, k, alpha, a->data, a->ld, b->data, b->ld, beta,
+        c->data, c->ld);
+}
+
+MVLAIMPL void mvla_matd_gemv(mvla_trans_t trans, double alpha, const mvla_matd_t *a,
+                         const mvla_vecd_t *x, double beta, mvla_vecd_t *y) {
+  gemvd(trans, a->rows, a->cols, alpha, a->data, a->ld, x->data, beta, y->data);
+}
+
+// -----------------------------------------
+
+/*
+** LEVEL 1 BLAS FUNCTIONS
+**
+** The vector forms are the flat forms over n * dims components. The float
+** norm sums squares in double so it can't overflow, the double norm only
+** rescales by the largest magnitude when the plain sum overflowed or fell
+** into the denormals.
+*/
+
+MVLAIMPL void axpyf_n(float alpha, const float *x, float *y, size_t n) {
+  mvla__f32_axpy_k(alpha, x, y, n);
+}
+
+MVLAIMPL void scalf_n(float alpha, float *x, size_t n) {
+  mvla__f32_scal_k(alpha, x, x, n);
+}
+
+MVLAIMPL float dotf_n(const float *x, const float *y, size_t n) {
+  return mvla__f32_vdot_k(x, y, n);
+}
+
+MVLAIMPL float nrm2f_n(const float *x, size_t n) {
+  return (float) sqrt(mvla__f32_sumsq_k(x, n));
+}
+
+MVLAIMPL float asumf_n(const float *x, size_t n) {
+  return mvla__f32_asum_k(x, n);
+}
+
+MVLAIMPL void axpyd_n(double alpha, const double *x, double *y, size_t n) {
+  mvla__f64_axpy_k(alpha, x, y, n);
+}
+
+MVLAIMPL void scald_n(double alpha, double *x, size_t n) {
+  mvla__f64_scal_k(alpha, x, x, n);
+}
+
+MVLAIMPL double dotd_n(const double *x, const double *y, size_t n) {
+  return mvla__f64_vdot_k(x, y, n);
+}
+
+MVLAIMPL double nrm2d_n(const double *x, size_t n) {
+  double sum = mvla__f64_sumsq_k(x, n);
+  double scale = 0.0;
+  size_t i;
+  if (sum >= DBL_MIN && sum <= DBL_MAX) {
+    return sqrt(sum);
+  }
+  if (isnan(sum)) {
+    return sum;
+  }
+  for (i = 0; i < n; ++i) {
+    scale = fmax(scale, fabs(x[i]));
+  }
+  if (scale == 0.0 || isinf(scale)) {
+    return scale;
+  }
+  sum = 0.0;
+  for (i = 0; i < n; ++i) {
+    double t = x[i] / scale;
+    sum += t * t;
+  }
+  return scale * sqrt(sum);
+}
+
+MVLAIMPL double asumd_n(const double *x, size_t n) {
+  return mvla__f64_asum_k(x, n);
+}
+
+// v2f_t
+
+MVLAIMPL void v2f_axpy_n(float alpha, const v2f_t *x, v2f_t *y, size_t n) {
+  axpyf_n(alpha, (const float *) x, (float *) y, n * 2);
+}
+
+MVLAIMPL void v2f_scal_n(float alpha, v2f_t *x, size_t n) {
+  scalf_n(alpha, (float *) x, n * 2);
+}
+
+MVLAIMPL float v2f_dot_sum_n(const v2f_t *x, const v2f_t *y, size_t n) {
+  return dotf_n((const float *) x, (const float *) y, n * 2);
+}
+
+MVLAIMPL float v2f_nrm2_n(const v2f_t *x, size_t n) {
+  return nrm2f_n((const float *) x, n * 2);
+}
+
+MVLAIMPL float v2f_asum_n(const v2f_t *x, size_t n) {
+  return asumf_n((const float *) x, n * 2);
+}
+
+// v2d_t
+
+MVLAIMPL void v2d_axpy_n(double alpha, const v2d_t *x, v2d_t *y, size_t n) {
+  axpyd_n(alpha, (const double *) x, (double *) y, n * 2);
+}
+
+MVLAIMPL void v2d_scal_n(double alpha, v2d_t *x, size_t n) {
+  scald_n(alpha, (double *) x, n * 2);
+}
+
+MVLAIMPL double v2d_dot_sum_n(const v2d_t *x, const v2d_t *y, size_t n) {
+  return dotd_n((const double *) x, (const double *) y, n * 2);
+}
+
+MVLAIMPL double v2d_nrm2_n(const v2d_t *x, size_t n) {
+  return nrm2d_n((const double *) x, n * 2);
+}
+
+MVLAIMPL double v2d_asum_n(const v2d_t *x, size_t n) {
+  return asumd_n((const double *) x, n * 2);
+}
+
+// v3f_t
+
+MVLAIMPL void v3f_axpy_n(float alpha, const v3f_t *x, v3f_t *y, size_t n) {
+  axpyf_n(alpha, (const float *) x, (float *) y, n * 3);
+}
+
+MVLAIMPL void v3f_scal_n(float alpha, v3f_t *x, size_t n) {
+  scalf_n(alpha, (float *) x, n * 3);
+}
+
+MVLAIMPL float v3f_dot_sum_n(const v3f_t *x, const v3f_t *y, size_t n) {
+  return dotf_n((const float *) x, (const float *) y, n * 3);
+}
+
+MVLAIMPL float v3f_nrm2_n(const v3f_t *x, size_t n) {
+  return nrm2f_n((const float *) x, n * 3);
+}
+
+MVLAIMPL float v3f_asum_n(const v3f_t *x, size_t n) {
+  return asumf_n((const float *) x, n * 3);
+}
+
+// v3d_t
+
+MVLAIMPL void v3d_axpy_n(double alpha, const v3d_t *x, v3d_t *y, size_t n) {
+  axpyd_n(alpha, (const double *) x, (double *) y, n * 3);
+}
+
+MVLAIMPL void v3d_scal_n(double alpha, v3d_t *x, size_t n) {
+  scald_n(alpha, (double *) x, n * 3);
+}
+
+MVLAIMPL double v3d_dot_sum_n(const v3d_t *x, const v3d_t *y, size_t n) {
+  return dotd_n((const double *) x, (const double *) y, n * 3);
+}
+
+MVLAIMPL double v3d_nrm2_n(const v3d_t *x, size_t n) {
+  return nrm2d_n((const double *) x, n * 3);
+}
+
+MVLAIMPL double v3d_asum_n(const v3d_t *x, size_t n) {
+  return asumd_n((const double *) x, n * 3);
+}
+
+// v4f_t
+
+MVLAIMPL void v4f_axpy_n(float alpha, const v4f_t *x, v4f_t *y, size_t n) {
+  axpyf_n(alpha, (const float *) x, (float *) y, n * 4);
+}
+
+MVLAIMPL void v4f_scal_n(float alpha, v4f_t *x, size_t n) {
+  scalf_n(alpha, (float *) x, n * 4);
+}
+
+MVLAIMPL float v4f_dot_sum_n(const v4f_t *x, const v4f_t *y, size_t n) {
+  return dotf_n((const float *) x, (const float *) y, n * 4);
+}
+
+MVLAIMPL float v4f_nrm2_n(const v4f_t *x, size_t n) {
+  return nrm2f_n((const float *) x, n * 4);
+}
+
+MVLAIMPL float v4f_asum_n(const v4f_t *x, size_t n) {
+  return asumf_n((const float *) x, n * 4);
+}
+
+// v4d_t
+
+MVLAIMPL void v4d_axpy_n(double alpha, const v4d_t *x, v4d_t *y, size_t n) {
+  axpyd_n(alpha, (const double *) x, (double *) y, n * 4);
+}
+
+MVLAIMPL void v4d_scal_n(double alpha, v4d_t *x, size_t n) {
+  scald_n(alpha, (double *) x, n * 4);
+}
+
+MVLAIMPL double v4d_dot_sum_n(const v4d_t *x, const v4d_t *y, size_t n) {
+  return dotd_n((const double *) x, (const double *) y, n * 4);
+}
+
+MVLAIMPL double v4d_nrm2_n(const v4d_t *x, size_t n) {
+  return nrm2d_n((const double *) x, n * 4);
+}
+
+MVLAIMPL double v4d_asum_n(const v4d_t *x, size_t n) {
+  return asumd_n((const double *) x, n * 4);
+}
+
+// -----------------------------------------
+
+/*
+** FAST MATH FUNCTIONS
+**
+** The scalar forms run the scalar tier of the fast math kernels, the batch
+** forms go through the dispatch table over the flat scalar view.
+*/
+
+MVLAIMPL float expf_fast(float a) {
+  return mvla__exp_ps_SCALAR(a);
+}
+
+MVLAIMPL float logf_fast(float a) {
+  return mvla__log_ps_SCALAR(a);
+}
+
+MVLAIMPL float sinf_fast(float a) {
+  return mvla__sin_ps_SCALAR(a);
+}
+
+MVLAIMPL float cosf_fast(float a) {
+  return mvla__cos_ps_SCALAR(a);
+}
+
+MVLAIMPL float tanf_fast(float a) {
+  return mvla__tan_ps_SCALAR(a);
+}
+
+MVLAIMPL void sincosf_fast(float a, float *s, float *c) {
+  mvla__sincos_ps_SCALAR(a, s, c);
+}
+
+MVLAIMPL float sqrtf_fast(float a) {
+  return mvla__sqrt_ps_SCALAR(a);
+}
+
+MVLAIMPL float rsqrtf_fast(float a) {
+  return mvla__rsqrt_ps_SCALAR(a);
+}
+
+MVLAIMPL float powf_fast(float a, float b) {
+  return (float) mvla__powf_pd_SCALAR(a, b);
+}
+
+MVLAIMPL double expd_fast(double a) {
+  return mvla__exp_pd_SCALAR(a);
+}
+
+MVLAIMPL double logd_fast(double a) {
+  return mvla__log_pd_SCALAR(a);
+}
+
+MVLAIMPL double sind_fast(double a) {
+  return mvla__sin_pd_SCALAR(a);
+}
+
+MVLAIMPL double cosd_fast(double a) {
+  return mvla__cos_pd_SCALAR(a);
+}
+
+MVLAIMPL double tand_fast(double a) {
+  return mvla__tan_pd_SCALAR(a);
+}
+
+MVLAIMPL void sincosd_fast(double a, double *s, double *c) {
+  mvla__sincos_pd_SCALAR(a, s, c);
+}
+
+MVLAIMPL double sqrtd_fast(double a) {
+  return mvla__sqrt_pd_SCALAR(a);
+}
+
+MVLAIMPL double rsqrtd_fast(double a) {
+  return mvla__rsqrt_pd_SCALAR(a);
+}
+
+MVLAIMPL double powd_fast(double a, double b) {
+  return mvla__pow_pd_SCALAR(a, b);
+}
+
+MVLAIMPL v2f_t v2f_exp_fast(v2f_t a) {
+  a.x = expf_fast(a.x);
+  a.y = expf_fast(a.y);
+  return a;
+}
+
+MVLAIMPL v2f_t v2f_log_fast(v2f_t a) {
+  a.x = logf_fast(a.x);
+  a.y = logf_fast(a.y);
+  return a;
 }
 
-MVLAIMPL v2u_t v2u(unsigned int x, unsigned int y) {
-  v2u_t vec;
-  vec.x = x;
-  vec.y = y;
-  return vec;
+MVLAIMPL v2f_t v2f_sin_fast(v2f_t a) {
+  a.x = sinf_fast(a.x);
+  a.y = sinf_fast(a.y);
+  return a;
 }
 
-MVLAIMPL v2u_t v2uu(unsigned int x) { 
-  return v2u(x, x); 
+MVLAIMPL v2f_t v2f_cos_fast(v2f_t a) {
+  a.x = cosf_fast(a.x);
+  a.y = cosf_fast(a.y);
+  return a;
 }
 
-MVLAIMPL v2u_t v2u_add(v2u_t a, v2u_t b) {
-  a.x += b.x;
-  a.y += b.y;
+MVLAIMPL v2f_t v2f_tan_fast(v2f_t a) {
+  a.x = tanf_fast(a.x);
+  a.y = tanf_fast(a.y);
   return a;
 }
 
-MVLAIMPL v2u_t v2u_sub(v2u_t a, v2u_t b) {
-  a.x -= b.x;
-  a.y -= b.y;
+MVLAIMPL void v2f_sincos_fast(v2f_t a, v2f_t *s, v2f_t *c) {
+  sincosf_fast(a.x, &s->x, &c->x);
+  sincosf_fast(a.y, &s->y, &c->y);
+}
+
+MVLAIMPL v2f_t v2f_sqrt_fast(v2f_t a) {
+  a.x = sqrtf_fast(a.x);
+  a.y = sqrtf_fast(a.y);
   return a;
 }
 
-MVLAIMPL v2u_t v2u_mul(v2u_t a, v2u_t b) {
-  a.x *= b.x;
-  a.y *= b.y;
+MVLAIMPL v2f_t v2f_rsqrt_fast(v2f_t a) {
+  a.x = rsqrtf_fast(a.x);
+  a.y = rsqrtf_fast(a.y);
   return a;
 }
 
-MVLAIMPL v2u_t v2u_div(v2u_t a, v2u_t b) {
-  a.x /= b.x;
-  a.y /= b.y;
+MVLAIMPL v2f_t v2f_poww_fast(v2f_t a, float exp) {
+  a.x = powf_fast(a.x, exp);
+  a.y = powf_fast(a.y, exp);
   return a;
 }
 
-MVLAIMPL v2u_t v2u_min(v2u_t a, v2u_t b) {
-  a.x = minu(a.x, b.x);
-  a.y = minu(a.y, b.y);
+MVLAIMPL v2f_t v2f_pow_fast(v2f_t a, v2f_t exp) {
+  a.x = powf_fast(a.x, exp.x);
+  a.y = powf_fast(a.y, exp.y);
   return a;
 }
 
-MVLAIMPL v2u_t v2u_max(v2u_t a, v2u_t b) {
-  a.x = maxu(a.x, b.x);
-  a.y = maxu(a.y, b.y);
+MVLAIMPL v2d_t v2d_exp_fast(v2d_t a) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = mvla__exp_pd_SSE2(a.m);
+#else
+  a.x = expd_fast(a.x);
+  a.y = expd_fast(a.y);
+#endif // MVLA_SIMD_SSE
   return a;
 }
 
-MVLAIMPL void v2u_print(v2u_t a) {
-  printf("v2u_t(%u, %u)\n", V2_ARGS(a));
+MVLAIMPL v2d_t v2d_log_fast(v2d_t a) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = mvla__log_pd_SSE2(a.m);
+#else
+  a.x = logd_fast(a.x);
+  a.y = logd_fast(a.y);
+#endif // MVLA_SIMD_SSE
+  return a;
 }
 
-MVLAIMPL v2f_t v2f(float x, float y) {
-  v2f_t vec;
-  vec.x = x;
-  vec.y = y;
-  return vec;
+MVLAIMPL v2d_t v2d_sin_fast(v2d_t a) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = mvla__sin_pd_SSE2(a.m);
+#else
+  a.x = sind_fast(a.x);
+  a.y = sind_fast(a.y);
+#endif // MVLA_SIMD_SSE
+  return a;
 }
 
-MVLAIMPL v2f_t v2ff(float x) { 
-  return v2f(x, x); 
+MVLAIMPL v2d_t v2d_cos_fast(v2d_t a) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = mvla__cos_pd_SSE2(a.m);
+#else
+  a.x = cosd_fast(a.x);
+  a.y = cosd_fast(a.y);
+#endif // MVLA_SIMD_SSE
+  return a;
 }
 
-MVLAIMPL v2f_t v2f_add(v2f_t a, v2f_t b) {
-  a.x += b.x;
-  a.y += b.y;
+MVLAIMPL v2d_t v2d_tan_fast(v2d_t a) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = mvla__tan_pd_SSE2(a.m);
+#else
+  a.x = tand_fast(a.x);
+  a.y = tand_fast(a.y);
+#endif // MVLA_SIMD_SSE
   return a;
 }
 
-MVLAIMPL v2f_t v2f_sub(v2f_t a, v2f_t b) {
-  a.x -= b.x;
-  a.y -= b.y;
+MVLAIMPL void v2d_sincos_fast(v2d_t a, v2d_t *s, v2d_t *c) {
+#if defined(MVLA_SIMD_SSE)
+  mvla__sincos_pd_SSE2(a.m, &s->m, &c->m);
+#else
+  sincosd_fast(a.x, &s->x, &c->x);
+  sincosd_fast(a.y, &s->y, &c->y);
+#endif // MVLA_SIMD_SSE
+}
+
+MVLAIMPL v2d_t v2d_sqrt_fast(v2d_t a) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = mvla__sqrt_pd_SSE2(a.m);
+#else
+  a.x = sqrtd_fast(a.x);
+  a.y = sqrtd_fast(a.y);
+#endif // MVLA_SIMD_SSE
   return a;
 }
 
-MVLAIMPL v2f_t v2f_mul(v2f_t a, v2f_t b) {
-  a.x *= b.x;
-  a.y *= b.y;
+MVLAIMPL v2d_t v2d_rsqrt_fast(v2d_t a) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = mvla__rsqrt_pd_SSE2(a.m);
+#else
+  a.x = rsqrtd_fast(a.x);
+  a.y = rsqrtd_fast(a.y);
+#endif // MVLA_SIMD_SSE
   return a;
 }
 
-MVLAIMPL v2f_t v2f_div(v2f_t a, v2f_t b) {
-  a.x /= b.x;
-  a.y /= b.y;
+MVLAIMPL v2d_t v2d_poww_fast(v2d_t a, double exp) {
+  a.x = powd_fast(a.x, exp);
+  a.y = powd_fast(a.y, exp);
   return a;
 }
 
-MVLAIMPL v2f_t v2f_min(v2f_t a, v2f_t b) {
-  a.x = fminf(a.x, b.x);
-  a.y = fminf(a.y, b.y);
+MVLAIMPL v2d_t v2d_pow_fast(v2d_t a, v2d_t exp) {
+  a.x = powd_fast(a.x, exp.x);
+  a.y = powd_fast(a.y, exp.y);
   return a;
 }
 
-MVLAIMPL v2f_t v2f_max(v2f_t a, v2f_t b) {
-  a.x = fmaxf(a.x, b.x);
-  a.y = fmaxf(a.y, b.y);
+MVLAIMPL v3f_t v3f_exp_fast(v3f_t a) {
+  a.x = expf_fast(a.x);
+  a.y = expf_fast(a.y);
+  a.z = expf_fast(a.z);
   return a;
 }
 
-MVLAIMPL v2f_t v2f_sqrt(v2f_t a) {
-  a.x = sqrtf(a.x);
-  a.y = sqrtf(a.y);
+MVLAIMPL v3f_t v3f_log_fast(v3f_t a) {
+  a.x = logf_fast(a.x);
+  a.y = logf_fast(a.y);
+  a.z = logf_fast(a.z);
   return a;
 }
 
-MVLAIMPL v2f_t v2f_poww(v2f_t a, float exp) {
-  a.x = powf(a.x, exp);
-  a.y = powf(a.y, exp);
+MVLAIMPL v3f_t v3f_sin_fast(v3f_t a) {
+  a.x = sinf_fast(a.x);
+  a.y = sinf_fast(a.y);
+  a.z = sinf_fast(a.z);
   return a;
 }
 
-MVLAIMPL v2f_t v2f_pow(v2f_t a, v2f_t exp) {
-  a.x = powf(a.x, exp.x);
-  a.y = powf(a.y, exp.y);
+MVLAIMPL v3f_t v3f_cos_fast(v3f_t a) {
+  a.x = cosf_fast(a.x);
+  a.y = cosf_fast(a.y);
+  a.z = cosf_fast(a.z);
   return a;
 }
 
-MVLAIMPL v2f_t v2f_exp(v2f_t a) {
-  a.x = powf(MVLA_E, a.x);
-  a.y = powf(MVLA_E, a.y);
+MVLAIMPL v3f_t v3f_tan_fast(v3f_t a) {
+  a.x = tanf_fast(a.x);
+  a.y = tanf_fast(a.y);
+  a.z = tanf_fast(a.z);
   return a;
 }
 
-MVLAIMPL v2f_t v2f_sin(v2f_t a) {
-  a.x = sinf(a.x);
-  a.y = sinf(a.y);
+MVLAIMPL void v3f_sincos_fast(v3f_t a, v3f_t *s, v3f_t *c) {
+  sincosf_fast(a.x, &s->x, &c->x);
+  sincosf_fast(a.y, &s->y, &c->y);
+  sincosf_fast(a.z, &s->z, &c->z);
+}
+
+MVLAIMPL v3f_t v3f_sqrt_fast(v3f_t a) {
+  a.x = sqrtf_fast(a.x);
+  a.y = sqrtf_fast(a.y);
+  a.z = sqrtf_fast(a.z);
+  return a;
+}
+
+MVLAIMPL v3f_t v3f_rsqrt_fast(v3f_t a) {
+  a.x = rsqrtf_fast(a.x);
+  a.y = rsqrtf_fast(a.y);
+  a.z = rsqrtf_fast(a.z);
+  return a;
+}
+
+MVLAIMPL v3f_t v3f_poww_fast(v3f_t a, float exp) {
+  a.x = powf_fast(a.x, exp);
+  a.y = powf_fast(a.y, exp);
+  a.z = powf_fast(a.z, exp);
+  return a;
+}
+
+MVLAIMPL v3f_t v3f_pow_fast(v3f_t a, v3f_t exp) {
+  a.x = powf_fast(a.x, exp.x);
+  a.y = powf_fast(a.y, exp.y);
+  a.z = powf_fast(a.z, exp.z);
+  return a;
+}
+
+MVLAIMPL v3d_t v3d_exp_fast(v3d_t a) {
+  a.x = expd_fast(a.x);
+  a.y = expd_fast(a.y);
+  a.z = expd_fast(a.z);
+  return a;
+}
+
+MVLAIMPL v3d_t v3d_log_fast(v3d_t a) {
+  a.x = logd_fast(a.x);
+  a.y = logd_fast(a.y);
+  a.z = logd_fast(a.z);
+  return a;
+}
+
+MVLAIMPL v3d_t v3d_sin_fast(v3d_t a) {
+  a.x = sind_fast(a.x);
+  a.y = sind_fast(a.y);
+  a.z = sind_fast(a.z);
+  return a;
+}
+
+MVLAIMPL v3d_t v3d_cos_fast(v3d_t a) {
+  a.x = cosd_fast(a.x);
+  a.y = cosd_fast(a.y);
+  a.z = cosd_fast(a.z);
+  return a;
+}
+
+MVLAIMPL v3d_t v3d_tan_fast(v3d_t a) {
+  a.x = tand_fast(a.x);
+  a.y = tand_fast(a.y);
+  a.z = tand_fast(a.z);
+  return a;
+}
+
+MVLAIMPL void v3d_sincos_fast(v3d_t a, v3d_t *s, v3d_t *c) {
+  sincosd_fast(a.x, &s->x, &c->x);
+  sincosd_fast(a.y, &s->y, &c->y);
+  sincosd_fast(a.z, &s->z, &c->z);
+}
+
+MVLAIMPL v3d_t v3d_sqrt_fast(v3d_t a) {
+  a.x = sqrtd_fast(a.x);
+  a.y = sqrtd_fast(a.y);
+  a.z = sqrtd_fast(a.z);
+  return a;
+}
+
+MVLAIMPL v3d_t v3d_rsqrt_fast(v3d_t a) {
+  a.x = rsqrtd_fast(a.x);
+  a.y = rsqrtd_fast(a.y);
+  a.z = rsqrtd_fast(a.z);
+  return a;
+}
+
+MVLAIMPL v3d_t v3d_poww_fast(v3d_t a, double exp) {
+  a.x = powd_fast(a.x, exp);
+  a.y = powd_fast(a.y, exp);
+  a.z = powd_fast(a.z, exp);
+  return a;
+}
+
+MVLAIMPL v3d_t v3d_pow_fast(v3d_t a, v3d_t exp) {
+  a.x = powd_fast(a.x, exp.x);
+  a.y = powd_fast(a.y, exp.y);
+  a.z = powd_fast(a.z, exp.z);
+  return a;
+}
+
+MVLAIMPL v4f_t v4f_exp_fast(v4f_t a) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = mvla__exp_ps_SSE2(a.m);
+#else
+  a.x = expf_fast(a.x);
+  a.y = expf_fast(a.y);
+  a.z = expf_fast(a.z);
+  a.w = expf_fast(a.w);
+#endif // MVLA_SIMD_SSE
+  return a;
+}
+
+MVLAIMPL v4f_t v4f_log_fast(v4f_t a) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = mvla__log_ps_SSE2(a.m);
+#else
+  a.x = logf_fast(a.x);
+  a.y = logf_fast(a.y);
+  a.z = logf_fast(a.z);
+  a.w = logf_fast(a.w);
+#endif // MVLA_SIMD_SSE
+  return a;
+}
+
+MVLAIMPL v4f_t v4f_sin_fast(v4f_t a) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = mvla__sin_ps_SSE2(a.m);
+#else
+  a.x = sinf_fast(a.x);
+  a.y = sinf_fast(a.y);
+  a.z = sinf_fast(a.z);
+  a.w = sinf_fast(a.w);
+#endif // MVLA_SIMD_SSE
+  return a;
+}
+
+MVLAIMPL v4f_t v4f_cos_fast(v4f_t a) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = mvla__cos_ps_SSE2(a.m);
+#else
+  a.x = cosf_fast(a.x);
+  a.y = cosf_fast(a.y);
+  a.z = cosf_fast(a.z);
+  a.w = cosf_fast(a.w);
+#endif // MVLA_SIMD_SSE
+  return a;
+}
+
+MVLAIMPL v4f_t v4f_tan_fast(v4f_t a) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = mvla__tan_ps_SSE2(a.m);
+#else
+  a.x = tanf_fast(a.x);
+  a.y = tanf_fast(a.y);
+  a.z = tanf_fast(a.z);
+  a.w = tanf_fast(a.w);
+#endif // MVLA_SIMD_SSE
+  return a;
+}
+
+MVLAIMPL void v4f_sincos_fast(v4f_t a, v4f_t *s, v4f_t *c) {
+#if defined(MVLA_SIMD_SSE)
+  mvla__sincos_ps_SSE2(a.m, &s->m, &c->m);
+#else
+  sincosf_fast(a.x, &s->x, &c->x);
+  sincosf_fast(a.y, &s->y, &c->y);
+  sincosf_fast(a.z, &s->z, &c->z);
+  sincosf_fast(a.w, &s->w, &c->w);
+#endif // MVLA_SIMD_SSE
+}
+
+MVLAIMPL v4f_t v4f_sqrt_fast(v4f_t a) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = mvla__sqrt_ps_SSE2(a.m);
+#else
+  a.x = sqrtf_fast(a.x);
+  a.y = sqrtf_fast(a.y);
+  a.z = sqrtf_fast(a.z);
+  a.w = sqrtf_fast(a.w);
+#endif // MVLA_SIMD_SSE
+  return a;
+}
+
+MVLAIMPL v4f_t v4f_rsqrt_fast(v4f_t a) {
+#if defined(MVLA_SIMD_SSE)
+  a.m = mvla__rsqrt_ps_SSE2(a.m);
+#else
+  a.x = rsqrtf_fast(a.x);
+  a.y = rsqrtf_fast(a.y);
+  a.z = rsqrtf_fast(a.z);
+  a.w = rsqrtf_fast(a.w);
+#endif // MVLA_SIMD_SSE
+  return a;
+}
+
+MVLAIMPL v4f_t v4f_poww_fast(v4f_t a, float exp) {
+  a.x = powf_fast(a.x, exp);
+  a.y = powf_fast(a.y, exp);
+  a.z = powf_fast(a.z, exp);
+  a.w = powf_fast(a.w, exp);
+  return a;
+}
+
+MVLAIMPL v4f_t v4f_pow_fast(v4f_t a, v4f_t exp) {
+  a.x = powf_fast(a.x, exp.x);
+  a.y = powf_fast(a.y, exp.y);
+  a.z = powf_fast(a.z, exp.z);
+  a.w = powf_fast(a.w, exp.w);
+  return a;
+}
+
+MVLAIMPL v4d_t v4d_exp_fast(v4d_t a) {
+  a.x = expd_fast(a.x);
+  a.y = expd_fast(a.y);
+  a.z = expd_fast(a.z);
+  a.w = expd_fast(a.w);
+  return a;
+}
+
+MVLAIMPL v4d_t v4d_log_fast(v4d_t a) {
+  a.x = logd_fast(a.x);
+  a.y = logd_fast(a.y);
+  a.z = logd_fast(a.z);
+  a.w = logd_fast(a.w);
+  return a;
+}
+
+MVLAIMPL v4d_t v4d_sin_fast(v4d_t a) {
+  a.x = sind_fast(a.x);
+  a.y = sind_fast(a.y);
+  a.z = sind_fast(a.z);
+  a.w = sind_fast(a.w);
+  return a;
+}
+
+MVLAIMPL v4d_t v4d_cos_fast(v4d_t a) {
+  a.x = cosd_fast(a.x);
+  a.y = cosd_fast(a.y);
+  a.z = cosd_fast(a.z);
+  a.w = cosd_fast(a.w);
+  return a;
+}
+
+MVLAIMPL v4d_t v4d_tan_fast(v4d_t a) {
+  a.x = tand_fast(a.x);
+  a.y = tand_fast(a.y);
+  a.z = tand_fast(a.z);
+  a.w = tand_fast(a.w);
+  return a;
+}
+
+MVLAIMPL void v4d_sincos_fast(v4d_t a, v4d_t *s, v4d_t *c) {
+  sincosd_fast(a.x, &s->x, &c->x);
+  sincosd_fast(a.y, &s->y, &c->y);
+  sincosd_fast(a.z, &s->z, &c->z);
+  sincosd_fast(a.w, &s->w, &c->w);
+}
+
+MVLAIMPL v4d_t v4d_sqrt_fast(v4d_t a) {
+  a.x = sqrtd_fast(a.x);
+  a.y = sqrtd_fast(a.y);
+  a.z = sqrtd_fast(a.z);
+  a.w = sqrtd_fast(a.w);
+  return a;
+}
+
+MVLAIMPL v4d_t v4d_rsqrt_fast(v4d_t a) {
+  a.x = rsqrtd_fast(a.x);
+  a.y = rsqrtd_fast(a.y);
+  a.z = rsqrtd_fast(a.z);
+  a.w = rsqrtd_fast(a.w);
+  return a;
+}
+
+MVLAIMPL v4d_t v4d_poww_fast(v4d_t a, double exp) {
+  a.x = powd_fast(a.x, exp);
+  a.y = powd_fast(a.y, exp);
+  a.z = powd_fast(a.z, exp);
+  a.w = powd_fast(a.w, exp);
+  return a;
+}
+
+MVLAIMPL v4d_t v4d_pow_fast(v4d_t a, v4d_t exp) {
+  a.x = powd_fast(a.x, exp.x);
+  a.y = powd_fast(a.y, exp.y);
+  a.z = powd_fast(a.z, exp.z);
+  a.w = powd_fast(a.w, exp.w);
   return a;
 }
 
-MVLAIMPL v2f_t v2f_cos(v2f_t a) {
-  a.x = cosf(a.x);
-  a.y = cosf(a.y);
-  return a;
+MVLAIMPL void v2f_exp_fast_n(const v2f_t *a, v2f_t *out, size_t n) {
+  mvla__f32_exp_fast((const float *) a, (float *) out, n * 2);
+}
+
+MVLAIMPL void v2f_log_fast_n(const v2f_t *a, v2f_t *out, size_t n) {
+  mvla__f32_log_fast((const float *) a, (float *) out, n * 2);
+}
+
+MVLAIMPL void v2f_sin_fast_n(const v2f_t *a, v2f_t *out, size_t n) {
+  mvla__f32_sin_fast((const float *) a, (float *) out, n * 2);
+}
+
+MVLAIMPL void v2f_cos_fast_n(const v2f_t *a, v2f_t *out, size_t n) {
+  mvla__f32_cos_fast((const float *) a, (float *) out, n * 2);
+}
+
+MVLAIMPL void v2f_tan_fast_n(const v2f_t *a, v2f_t *out, size_t n) {
+  mvla__f32_tan_fast((const float *) a, (float *) out, n * 2);
+}
+
+MVLAIMPL void v2f_sincos_fast_n(const v2f_t *a, v2f_t *s, v2f_t *c, size_t n) {
+  mvla__f32_sincos_fast((const float *) a, (float *) s, (float *) c, n * 2);
+}
+
+MVLAIMPL void v2f_sqrt_fast_n(const v2f_t *a, v2f_t *out, size_t n) {
+  mvla__f32_sqrt_fast((const float *) a, (float *) out, n * 2);
+}
+
+MVLAIMPL void v2f_rsqrt_fast_n(const v2f_t *a, v2f_t *out, size_t n) {
+  mvla__f32_rsqrt_fast((const float *) a, (float *) out, n * 2);
+}
+
+MVLAIMPL void v2f_poww_fast_n(const v2f_t *a, float exp, v2f_t *out, size_t n) {
+  mvla__f32_poww_fast((const float *) a, exp, (float *) out, n * 2);
 }
 
-MVLAIMPL v2f_t v2f_tan(v2f_t a) {
-  a.x = tanf(a.x);
-  a.y = tanf(a.y);
-  return a;
+MVLAIMPL void v2f_pow_fast_n(const v2f_t *a, const v2f_t *exp, v2f_t *out, size_t n) {
+  mvla__f32_pow_fast((const float *) a, (const float *) exp, (float *) out, n * 2);
 }
 
-MVLAIMPL float v2f_len(v2f_t a) {
-  return sqrtf(v2f_sqr_len(a));
+MVLAIMPL void v2d_exp_fast_n(const v2d_t *a, v2d_t *out, size_t n) {
+  mvla__f64_exp_fast((const double *) a, (double *) out, n * 2);
 }
 
-MVLAIMPL float v2f_sqr_len(v2f_t a) {
-  return a.x * a.x + a.y * a.y;
+MVLAIMPL void v2d_log_fast_n(const v2d_t *a, v2d_t *out, size_t n) {
+  mvla__f64_log_fast((const double *) a, (double *) out, n * 2);
 }
 
-MVLAIMPL void v2f_print(v2f_t a) {
-  printf("v2f_t(%f, %f)\n", V2_ARGS(a));
+MVLAIMPL void v2d_sin_fast_n(const v2d_t *a, v2d_t *out, size_t n) {
+  mvla__f64_sin_fast((const double *) a, (double *) out, n * 2);
 }
 
-MVLAIMPL v2d_t v2d(double x, double y) {
-  v2d_t vec;
-  vec.x = x;
-  vec.y = y;
-  return vec;
+MVLAIMPL void v2d_cos_fast_n(const v2d_t *a, v2d_t *out, size_t n) {
+  mvla__f64_cos_fast((const double *) a, (double *) out, n * 2);
 }
 
-MVLAIMPL v2d_t v2dd(double x) {
-  return v2d(x, x);
+MVLAIMPL void v2d_tan_fast_n(const v2d_t *a, v2d_t *out, size_t n) {
+  mvla__f64_tan_fast((const double *) a, (double *) out, n * 2);
 }
 
-MVLAIMPL v2d_t v2d_add(v2d_t a, v2d_t b) {
-  a.x += b.x;
-  a.y += b.y;
-  return a;
+MVLAIMPL void v2d_sincos_fast_n(const v2d_t *a, v2d_t *s, v2d_t *c, size_t n) {
+  mvla__f64_sincos_fast((const double *) a, (double *) s, (double *) c, n * 2);
 }
 
-MVLAIMPL v2d_t v2d_sub(v2d_t a, v2d_t b) {
-  a.x -= b.x;
-  a.y -= b.y;
-  return a;
+MVLAIMPL void v2d_sqrt_fast_n(const v2d_t *a, v2d_t *out, size_t n) {
+  mvla__f64_sqrt_fast((const double *) a, (double *) out, n * 2);
 }
 
-MVLAIMPL v2d_t v2d_mul(v2d_t a, v2d_t b) {
-  a.x *= b.x;
-  a.y *= b.y;
-  return a;
+MVLAIMPL void v2d_rsqrt_fast_n(const v2d_t *a, v2d_t *out, size_t n) {
+  mvla__f64_rsqrt_fast((const double *) a, (double *) out, n * 2);
 }
 
-MVLAIMPL v2d_t v2d_div(v2d_t a, v2d_t b) {
-  a.x /= b.x;
-  a.y /= b.y;
-  return a;
+MVLAIMPL void v2d_poww_fast_n(const v2d_t *a, double exp, v2d_t *out, size_t n) {
+  mvla__f64_poww_fast((const double *) a, exp, (double *) out, n * 2);
 }
 
-MVLAIMPL v2d_t v2d_min(v2d_t a, v2d_t b) {
-  a.x = fmin(a.x, b.x);
-  a.y = fmin(a.y, b.y);
-  return a;
+MVLAIMPL void v2d_pow_fast_n(const v2d_t *a, const v2d_t *exp, v2d_t *out, size_t n) {
+  mvla__f64_pow_fast((const double *) a, (const double *) exp, (double *) out, n * 2);
 }
 
-MVLAIMPL v2d_t v2d_max(v2d_t a, v2d_t b) {
-  a.x = fmax(a.x, b.x);
-  a.y = fmax(a.y, b.y);
-  return a;
+MVLAIMPL void v3f_exp_fast_n(const v3f_t *a, v3f_t *out, size_t n) {
+  mvla__f32_exp_fast((const float *) a, (float *) out, n * 3);
 }
 
-MVLAIMPL v2d_t v2d_sqrt(v2d_t a) {
-  a.x = sqrt(a.x);
-  a.y = sqrt(a.y);
-  return a;
+MVLAIMPL void v3f_log_fast_n(const v3f_t *a, v3f_t *out, size_t n) {
+  mvla__f32_log_fast((const float *) a, (float *) out, n * 3);
 }
 
-MVLAIMPL v2d_t v2d_poww(v2d_t a, double exp) {
-  a.x = pow(a.x, exp);
-  a.y = pow(a.y, exp);
-  return a;
+MVLAIMPL void v3f_sin_fast_n(const v3f_t *a, v3f_t *out, size_t n) {
+  mvla__f32_sin_fast((const float *) a, (float *) out, n * 3);
 }
 
-MVLAIMPL v2d_t v2d_pow(v2d_t a, v2d_t exp) {
-  a.x = pow(a.x, exp.x);
-  a.y = pow(a.y, exp.y);
-  return a;
+MVLAIMPL void v3f_cos_fast_n(const v3f_t *a, v3f_t *out, size_t n) {
+  mvla__f32_cos_fast((const float *) a, (float *) out, n * 3);
 }
 
-MVLAIMPL v2d_t v2d_exp(v2d_t a) {
-  a.x = pow(MVLA_E, a.x);
-  a.y = pow(MVLA_E, a.y);
-  return a;
+MVLAIMPL void v3f_tan_fast_n(const v3f_t *a, v3f_t *out, size_t n) {
+  mvla__f32_tan_fast((const float *) a, (float *) out, n * 3);
 }
 
-MVLAIMPL v2d_t v2d_sin(v2d_t a) {
-  a.x = sin(a.x);
-  a.y = sin(a.y);
-  return a;
+MVLAIMPL void v3f_sincos_fast_n(const v3f_t *a, v3f_t *s, v3f_t *c, size_t n) {
+  mvla__f32_sincos_fast((const float *) a, (float *) s, (float *) c, n * 3);
 }
 
-MVLAIMPL v2d_t v2d_cos(v2d_t a) {
-  a.x = cos(a.x);
-  a.y = cos(a.y);
-  return a;
+MVLAIMPL void v3f_sqrt_fast_n(const v3f_t *a, v3f_t *out, size_t n) {
+  mvla__f32_sqrt_fast((const float *) a, (float *) out, n * 3);
 }
 
-MVLAIMPL v2d_t v2d_tan(v2d_t a) {
-  a.x = tan(a.x);
-  a.y = tan(a.y);
-  return a;
+MVLAIMPL void v3f_rsqrt_fast_n(const v3f_t *a, v3f_t *out, size_t n) {
+  mvla__f32_rsqrt_fast((const float *) a, (float *) out, n * 3);
 }
 
-MVLAIMPL double v2d_len(v2d_t a) {
-  return sqrt(v2d_sqr_len(a));
+MVLAIMPL void v3f_poww_fast_n(const v3f_t *a, float exp, v3f_t *out, size_t n) {
+  mvla__f32_poww_fast((const float *) a, exp, (float *) out, n * 3);
 }
 
-MVLAIMPL double v2d_sqr_len(v2d_t a) {
-  return a.x * a.x + a.y * a.y;
+MVLAIMPL void v3f_pow_fast_n(const v3f_t *a, const v3f_t *exp, v3f_t *out, size_t n) {
+  mvla__f32_pow_fast((const float *) a, (const float *) exp, (float *) out, n * 3);
 }
 
-MVLAIMPL void v2d_print(v2d_t a) {
-  printf("v2d_t(%lf, %lf)\n", V2_ARGS(a));
+MVLAIMPL void v3d_exp_fast_n(const v3d_t *a, v3d_t *out, size_t n) {
+  mvla__f64_exp_fast((const double *) a, (double *) out, n * 3);
 }
 
-// -----------------------------------------
+MVLAIMPL void v3d_log_fast_n(const v3d_t *a, v3d_t *out, size_t n) {
+  mvla__f64_log_fast((const double *) a, (double *) out, n * 3);
+}
 
-MVLAIMPL v3i_t v3i(signed int x, signed int y, signed int z) {
-  v3i_t vec;
-  vec.x = x;
-  vec.y = y;
-  vec.z = z;
-  return vec;
+MVLAIMPL void v3d_sin_fast_n(const v3d_t *a, v3d_t *out, size_t n) {
+  mvla__f64_sin_fast((const double *) a, (double *) out, n * 3);
 }
 
-MVLAIMPL v3i_t v3ii(signed int x) {
-  return v3i(x, x, x);
+MVLAIMPL void v3d_cos_fast_n(const v3d_t *a, v3d_t *out, size_t n) {
+  mvla__f64_cos_fast((const double *) a, (double *) out, n * 3);
 }
 
-MVLAIMPL v3i_t v3i_add(v3i_t a, v3i_t b) {
-  a.x += b.x;
-  a.y += b.y;
-  a.z += b.z;
-  return a;
+MVLAIMPL void v3d_tan_fast_n(const v3d_t *a, v3d_t *out, size_t n) {
+  mvla__f64_tan_fast((const double *) a, (double *) out, n * 3);
 }
 
-MVLAIMPL v3i_t v3i_sub(v3i_t a, v3i_t b) {
-  a.x -= b.x;
-  a.y -= b.y;
-  a.z -= b.z;
-  return a;
+MVLAIMPL void v3d_sincos_fast_n(const v3d_t *a, v3d_t *s, v3d_t *c, size_t n) {
+  mvla__f64_sincos_fast((const double *) a, (double *) s, (double *) c, n * 3);
 }
 
-MVLAIMPL v3i_t v3i_mul(v3i_t a, v3i_t b) {
-  a.x *= b.x;
-  a.y *= b.y;
-  a.z *= b.z;
-  return a;
+MVLAIMPL void v3d_sqrt_fast_n(const v3d_t *a, v3d_t *out, size_t n) {
+  mvla__f64_sqrt_fast((const double *) a, (double *) out, n * 3);
 }
 
-MVLAIMPL v3i_t v3i_div(v3i_t a, v3i_t b) {
-  a.x /= b.x;
-  a.y /= b.y;
-  a.z /= b.z;
-  return a;
+MVLAIMPL void v3d_rsqrt_fast_n(const v3d_t *a, v3d_t *out, size_t n) {
+  mvla__f64_rsqrt_fast((const double *) a, (double *) out, n * 3);
 }
 
-MVLAIMPL v3i_t v3i_min(v3i_t a, v3i_t b) {
-  a.x = mini(a.x, b.x);
-  a.y = mini(a.y, b.y);
-  a.z = mini(a.z, b.z);
-  return a;
+MVLAIMPL void v3d_poww_fast_n(const v3d_t *a, double exp, v3d_t *out, size_t n) {
+  mvla__f64_poww_fast((const double *) a, exp, (double *) out, n * 3);
 }
 
-MVLAIMPL v3i_t v3i_max(v3i_t a, v3i_t b) {
-  a.x = maxi(a.x, b.x);
-  a.y = maxi(a.y, b.y);
-  a.z = maxi(a.z, b.z);
-  return a;
+MVLAIMPL void v3d_pow_fast_n(const v3d_t *a, const v3d_t *exp, v3d_t *out, size_t n) {
+  mvla__f64_pow_fast((const double *) a, (const double *) exp, (double *) out, n * 3);
 }
 
-MVLAIMPL void v3i_print(v3i_t a) {
-  printf("v3i_t(%d, %d, %d)\n", V3_ARGS(a));
+MVLAIMPL void v4f_exp_fast_n(const v4f_t *a, v4f_t *out, size_t n) {
+  mvla__f32_exp_fast((const float *) a, (float *) out, n * 4);
 }
 
-MVLAIMPL v3u_t v3u(unsigned int x, unsigned int y, unsigned int z) {
-  v3u_t vec;
-  vec.x = x;
-  vec.y = y;
-  vec.z = z;
-  return vec;
+MVLAIMPL void v4f_log_fast_n(const v4f_t *a, v4f_t *out, size_t n) {
+  mvla__f32_log_fast((const float *) a, (float *) out, n * 4);
 }
 
-MVLAIMPL v3u_t v3uu(unsigned int x) {
-  return v3u(x, x, x);
+MVLAIMPL void v4f_sin_fast_n(const v4f_t *a, v4f_t *out, size_t n) {
+  mvla__f32_sin_fast((const float *) a, (float *) out, n * 4);
 }
 
-MVLAIMPL v3u_t v3u_add(v3u_t a, v3u_t b) {
-  a.x += b.x;
-  a.y += b.y;
-  a.z += b.z;
-  return a;
+MVLAIMPL void v4f_cos_fast_n(const v4f_t *a, v4f_t *out, size_t n) {
+  mvla__f32_cos_fast((const float *) a, (float *) out, n * 4);
 }
 
-MVLAIMPL v3u_t v3u_sub(v3u_t a, v3u_t b) {
-  a.x -= b.x;
-  a.y -= b.y;
-  a.z -= b.z;
-  return a;
+MVLAIMPL void v4f_tan_fast_n(const v4f_t *a, v4f_t *out, size_t n) {
+  mvla__f32_tan_fast((const float *) a, (float *) out, n * 4);
 }
 
-MVLAIMPL v3u_t v3u_mul(v3u_t a, v3u_t b) {
-  a.x *= b.x;
-  a.y *= b.y;
-  a.z *= b.z;
-  return a;
+MVLAIMPL void v4f_sincos_fast_n(const v4f_t *a, v4f_t *s, v4f_t *c, size_t n) {
+  mvla__f32_sincos_fast((const float *) a, (float *) s, (float *) c, n * 4);
 }
 
-MVLAIMPL v3u_t v3u_div(v3u_t a, v3u_t b) {
-  a.x /= b.x;
-  a.y /= b.y;
-  a.z /= b.z;
-  return a;
+MVLAIMPL void v4f_sqrt_fast_n(const v4f_t *a, v4f_t *out, size_t n) {
+  mvla__f32_sqrt_fast((const float *) a, (float *) out, n * 4);
 }
 
-MVLAIMPL v3u_t v3u_min(v3u_t a, v3u_t b) {
-  a.x = minu(a.x, b.x);
-  a.y = minu(a.y, b.y);
-  a.z = minu(a.z, b.z);
-  return a;
+MVLAIMPL void v4f_rsqrt_fast_n(const v4f_t *a, v4f_t *out, size_t n) {
+  mvla__f32_rsqrt_fast((const float *) a, (float *) out, n * 4);
 }
 
-MVLAIMPL v3u_t v3u_max(v3u_t a, v3u_t b) {
-  a.x = maxu(a.x, b.x);
-  a.y = maxu(a.y, b.y);
-  a.z = maxu(a.z, b.z);
-  return a;
+MVLAIMPL void v4f_poww_fast_n(const v4f_t *a, float exp, v4f_t *out, size_t n) {
+  mvla__f32_poww_fast((const float *) a, exp, (float *) out, n * 4);
 }
 
-MVLAIMPL void v3u_print(v3u_t a) {
-  printf("v3u_t(%u, %u, %u)\n", V3_ARGS(a));
+MVLAIMPL void v4f_pow_fast_n(const v4f_t *a, const v4f_t *exp, v4f_t *out, size_t n) {
+  mvla__f32_pow_fast((const float *) a, (const float *) exp, (float *) out, n * 4);
 }
 
-MVLAIMPL v3f_t v3f(float x, float y, float z) {
-  v3f_t vec;
-  vec.x = x;
-  vec.y = y;
-  vec.z = z;
-  return vec;
+MVLAIMPL void v4d_exp_fast_n(const v4d_t *a, v4d_t *out, size_t n) {
+  mvla__f64_exp_fast((const double *) a, (double *) out, n * 4);
 }
 
-MVLAIMPL v3f_t v3ff(float x) {
-  return v3f(x, x, x);
+MVLAIMPL void v4d_log_fast_n(const v4d_t *a, v4d_t *out, size_t n) {
+  mvla__f64_log_fast((const double *) a, (double *) out, n * 4);
 }
 
-MVLAIMPL v3f_t v3f_add(v3f_t a, v3f_t b) {
-  a.x += b.x;
-  a.y += b.y;
-  a.z += b.z;
-  return a;
+MVLAIMPL void v4d_sin_fast_n(const v4d_t *a, v4d_t *out, size_t n) {
+  mvla__f64_sin_fast((const double *) a, (double *) out, n * 4);
 }
 
-MVLAIMPL v3f_t v3f_sub(v3f_t a, v3f_t b) {
-  a.x -= b.x;
-  a.y -= b.y;
-  a.z -= b.z;
-  return a;
+MVLAIMPL void v4d_cos_fast_n(const v4d_t *a, v4d_t *out, size_t n) {
+  mvla__f64_cos_fast((const double *) a, (double *) out, n * 4);
 }
 
-MVLAIMPL v3f_t v3f_mul(v3f_t a, v3f_t b) {
-  a.x *= b.x;
-  a.y *= b.y;
-  a.z *= b.z;
-  return a;
+MVLAIMPL void v4d_tan_fast_n(const v4d_t *a, v4d_t *out, size_t n) {
+  mvla__f64_tan_fast((const double *) a, (double *) out, n * 4);
 }
 
-MVLAIMPL v3f_t v3f_div(v3f_t a, v3f_t b) {
-  a.x /= b.x;
-  a.y /= b.y;
-  a.z /= b.z;
-  return a;
+MVLAIMPL void v4d_sincos_fast_n(const v4d_t *a, v4d_t *s, v4d_t *c, size_t n) {
+  mvla__f64_sincos_fast((const double *) a, (double *) s, (double *) c, n * 4);
 }
 
-MVLAIMPL v3f_t v3f_min(v3f_t a, v3f_t b) {
-  a.x = fminf(a.x, b.x);
-  a.y = fminf(a.y, b.y);
-  a.z = fminf(a.z, b.z);
-  return a;
+MVLAIMPL void v4d_sqrt_fast_n(const v4d_t *a, v4d_t *out, size_t n) {
+  mvla__f64_sqrt_fast((const double *) a, (double *) out, n * 4);
 }
 
-MVLAIMPL v3f_t v3f_max(v3f_t a, v3f_t b) {
-  a.x = fmaxf(a.x, b.x);
-  a.y = fmaxf(a.y, b.y);
-  a.z = fmaxf(a.z, b.z);
-  return a;
+MVLAIMPL void v4d_rsqrt_fast_n(const v4d_t *a, v4d_t *out, size_t n) {
+  mvla__f64_rsqrt_fast((const double *) a, (double *) out, n * 4);
 }
 
-MVLAIMPL v3f_t v3f_sqrt(v3f_t a) {
-  a.x = sqrtf(a.x);
-  a.y = sqrtf(a.y);
-  a.z = sqrtf(a.z);
-  return a;
+MVLAIMPL void v4d_poww_fast_n(const v4d_t *a, double exp, v4d_t *out, size_t n) {
+  mvla__f64_poww_fast((const double *) a, exp, (double *) out, n * 4);
 }
 
-MVLAIMPL v3f_t v3f_poww(v3f_t a, float exp) {
-  a.x = powf(a.x, exp);
-  a.y = powf(a.y, exp);
-  a.z = powf(a.z, exp);
-  return a;
+MVLAIMPL void v4d_pow_fast_n(const v4d_t *a, const v4d_t *exp, v4d_t *out, size_t n) {
+  mvla__f64_pow_fast((const double *) a, (const double *) exp, (double *) out, n * 4);
 }
 
-MVLAIMPL v3f_t v3f_pow(v3f_t a, v3f_t exp) {
-  a.x = powf(a.x, exp.x);
-  a.y = powf(a.y, exp.y);
-  a.z = powf(a.z, exp.z);
-  return a;
+// -----------------------------------------
+
+/*
+** RANDOM FUNCTIONS
+*/
+
+static inline uint64_t mvla__rotl64(uint64_t x, int k) {
+  return (x << k) | (x >> (64 - k));
 }
 
-MVLAIMPL v3f_t v3f_exp(v3f_t a) {
-  a.x = powf(MVLA_E, a.x);
-  a.y = powf(MVLA_E, a.y);
-  a.z = powf(MVLA_E, a.z);
-  return a;
+static inline uint64_t mvla__splitmix64(uint64_t *x) {
+  uint64_t z = (*x += UINT64_C(0x9e3779b97f4a7c15));
+  z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+  z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+  return z ^ (z >> 31);
 }
 
-MVLAIMPL v3f_t v3f_sin(v3f_t a) {
-  a.x = sinf(a.x);
-  a.y = sinf(a.y);
-  a.z = sinf(a.z);
-  return a;
+static inline void mvla__rng_jump(mvla_rng_t *rng, const uint64_t poly[4]) {
+  uint64_t t[4] = {0, 0, 0, 0};
+  int i, b;
+  for (i = 0; i < 4; ++i) {
+    for (b = 0; b < 64; ++b) {
+      if (poly[i] & (UINT64_C(1) << b)) {
+        t[0] ^= rng->s[0];
+        t[1] ^= rng->s[1];
+        t[2] ^= rng->s[2];
+        t[3] ^= rng->s[3];
+      }
+      mvla_rng_next(rng);
+    }
+  }
+  memcpy(rng->s, t, sizeof(t));
 }
 
-MVLAIMPL v3f_t v3f_cos(v3f_t a) {
-  a.x = cosf(a.x);
-  a.y = cosf(a.y);
-  a.z = cosf(a.z);
-  return a;
+MVLAIMPL mvla_rng_t mvla_rng(uint64_t seed) {
+  mvla_rng_t rng;
+  // splitmix64 never yields four zeros in a row, so the state is valid
+  rng.s[0] = mvla__splitmix64(&seed);
+  rng.s[1] = mvla__splitmix64(&seed);
+  rng.s[2] = mvla__splitmix64(&seed);
+  rng.s[3] = mvla__splitmix64(&seed);
+  return rng;
 }
 
-MVLAIMPL v3f_t v3f_tan(v3f_t a) {
-  a.x = tanf(a.x);
-  a.y = tanf(a.y);
-  a.z = tanf(a.z);
-  return a;
+MVLAIMPL uint64_t mvla_rng_next(mvla_rng_t *rng) {
+  uint64_t *s = rng->s;
+  uint64_t r = mvla__rotl64(s[0] + s[3], 23) + s[0];
+  uint64_t t = s[1] << 17;
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = mvla__rotl64(s[3], 45);
+  return r;
 }
 
-MVLAIMPL float v3f_len(v3f_t a) {
-  return sqrtf(v3f_sqr_len(a));
+MVLAIMPL float mvla_rng_randf(mvla_rng_t *rng) {
+  return (float) (mvla_rng_next(rng) >> 40) * 5.9604644775390625e-8f; // 2^-24
 }
 
-MVLAIMPL float v3f_sqr_len(v3f_t a) {
-  return a.x * a.x + a.y * a.y + a.z * a.z;
+MVLAIMPL double mvla_rng_randd(mvla_rng_t *rng) {
+  return (double) (mvla_rng_next(rng) >> 11) * 1.1102230246251565e-16; // 2^-53
 }
 
-MVLAIMPL void v3f_print(v3f_t a) {
-  printf("v3f_t(%f, %f, %f)\n", V3_ARGS(a));
+MVLAIMPL void mvla_rng_jump(mvla_rng_t *rng) {
+  static const uint64_t poly[4] = {
+    UINT64_C(0x180ec6d33cfd0aba), UINT64_C(0xd5a61266f0c9392c),
+    UINT64_C(0xa9582618e03fc9aa), UINT64_C(0x39abdc4529b1661c)
+  };
+  mvla__rng_jump(rng, poly);
 }
 
-MVLAIMPL v3d_t v3d(double x, double y, double z) {
-  v3d_t vec;
-  vec.x = x;
-  vec.y = y;
-  vec.z = z;
-  return vec;
+MVLAIMPL void mvla_rng_long_jump(mvla_rng_t *rng) {
+  static const uint64_t poly[4] = {
+    UINT64_C(0x76e15d3efefdcbbf), UINT64_C(0xc5004e441c522fb3),
+    UINT64_C(0x77710069854ee241), UINT64_C(0x39109bb02acbe635)
+  };
+  mvla__rng_jump(rng, poly);
 }
 
-MVLAIMPL v3d_t v3dd(double x) {
-  return v3d(x, x, x);
+MVLAIMPL void mvla_srand(uint64_t seed) {
+  // assigned directly so seeding never claims one of the default streams
+  mvla__thread_rng_state = mvla_rng(seed);
+  mvla__thread_rng_seeded = 1;
 }
 
-MVLAIMPL v3d_t v3d_add(v3d_t a, v3d_t b) {
-  a.x += b.x;
-  a.y += b.y;
-  a.z += b.z;
+MVLAIMPL v2f_t v2f_rand(mvla_rng_t *rng) {
+  v2f_t a;
+  a.x = mvla_rng_randf(rng);
+  a.y = mvla_rng_randf(rng);
   return a;
 }
 
-MVLAIMPL v3d_t v3d_sub(v3d_t a, v3d_t b) {
-  a.x -= b.x;
-  a.y -= b.y;
-  a.z -= b.z;
+MVLAIMPL v2d_t v2d_rand(mvla_rng_t *rng) {
+  v2d_t a;
+  a.x = mvla_rng_randd(rng);
+  a.y = mvla_rng_randd(rng);
   return a;
 }
 
-MVLAIMPL v3d_t v3d_mul(v3d_t a, v3d_t b) {
-  a.x *= b.x;
-  a.y *= b.y;
-  a.z *= b.z;
+MVLAIMPL v3f_t v3f_rand(mvla_rng_t *rng) {
+  v3f_t a;
+  a.x = mvla_rng_randf(rng);
+  a.y = mvla_rng_randf(rng);
+  a.z = mvla_rng_randf(rng);
   return a;
 }
 
-MVLAIMPL v3d_t v3d_div(v3d_t a, v3d_t b) {
-  a.x /= b.x;
-  a.y /= b.y;
-  a.z /= b.z;
+MVLAIMPL v3d_t v3d_rand(mvla_rng_t *rng) {
+  v3d_t a;
+  a.x = mvla_rng_randd(rng);
+  a.y = mvla_rng_randd(rng);
+  a.z = mvla_rng_randd(rng);
   return a;
 }
 
-MVLAIMPL v3d_t v3d_min(v3d_t a, v3d_t b) {
-  a.x = fmin(a.x, b.x);
-  a.y = fmin(a.y, b.y);
-  a.z = fmin(a.z, b.z);
+MVLAIMPL v4f_t v4f_rand(mvla_rng_t *rng) {
+  v4f_t a;
+  a.x = mvla_rng_randf(rng);
+  a.y = mvla_rng_randf(rng);
+  a.z = mvla_rng_randf(rng);
+  a.w = mvla_rng_randf(rng);
   return a;
 }
 
-MVLAIMPL v3d_t v3d_max(v3d_t a, v3d_t b) {
-  a.x = fmax(a.x, b.x);
-  a.y = fmax(a.y, b.y);
-  a.z = fmax(a.z, b.z);
+MVLAIMPL v4d_t v4d_rand(mvla_rng_t *rng) {
+  v4d_t a;
+  a.x = mvla_rng_randd(rng);
+  a.y = mvla_rng_randd(rng);
+  a.z = mvla_rng_randd(rng);
+  a.w = mvla_rng_randd(rng);
   return a;
 }
 
-MVLAIMPL v3d_t v3d_sqrt(v3d_t a) {
-  a.x = sqrt(a.x);
-  a.y = sqrt(a.y);
-  a.z = sqrt(a.z);
-  return a;
+MVLAIMPL mvla_rng_lanes_t mvla_rng_lanes(mvla_rng_t *rng) {
+  mvla_rng_lanes_t lanes;
+  int l, k;
+  for (l = 0; l < MVLA_RNG_LANES; ++l) {
+    for (k = 0; k < 4; ++k) {
+      lanes.s[k][l] = rng->s[k];
+    }
+    mvla_rng_jump(rng);
+  }
+  return lanes;
 }
 
-MVLAIMPL v3d_t v3d_poww(v3d_t a, double exp) {
-  a.x = pow(a.x, exp);
-  a.y = pow(a.y, exp);
-  a.z = pow(a.z, exp);
+MVLAIMPL mvla_rng_t mvla_rng_lane(const mvla_rng_lanes_t *lanes, int lane) {
+  mvla_rng_t rng;
+  int k;
+  for (k = 0; k < 4; ++k) {
+    rng.s[k] = lanes->s[k][lane];
+  }
+  return rng;
+}
+
+MVLAIMPL void mvla_rng_fill(mvla_rng_lanes_t *lanes, float *out, size_t n) {
+  mvla__rng_uniform(lanes, out, n, 1);
+}
+
+#define MVLA__TWO_PI_F 6.28318530717958647692f
+
+MVLAIMPL v2f_t v2f_rand_box(mvla_rng_t *rng, v2f_t lo, v2f_t hi) {
+  v2f_t a;
+  a.x = lo.x + (hi.x - lo.x) * mvla_rng_randf(rng);
+  a.y = lo.y + (hi.y - lo.y) * mvla_rng_randf(rng);
   return a;
 }
 
-MVLAIMPL v3d_t v3d_pow(v3d_t a, v3d_t exp) {
-  a.x = pow(a.x, exp.x);
-  a.y = pow(a.y, exp.y);
-  a.z = pow(a.z, exp.z);
+MVLAIMPL v3f_t v3f_rand_box(mvla_rng_t *rng, v3f_t lo, v3f_t hi) {
+  v3f_t a;
+  a.x = lo.x + (hi.x - lo.x) * mvla_rng_randf(rng);
+  a.y = lo.y + (hi.y - lo.y) * mvla_rng_randf(rng);
+  a.z = lo.z + (hi.z - lo.z) * mvla_rng_randf(rng);
   return a;
 }
 
-MVLAIMPL v3d_t v3d_exp(v3d_t a) {
-  a.x = pow(MVLA_E, a.x);
-  a.y = pow(MVLA_E, a.y);
-  a.z = pow(MVLA_E, a.z);
+MVLAIMPL v4f_t v4f_rand_box(mvla_rng_t *rng, v4f_t lo, v4f_t hi) {
+  v4f_t a;
+  a.x = lo.x + (hi.x - lo.x) * mvla_rng_randf(rng);
+  a.y = lo.y + (hi.y - lo.y) * mvla_rng_randf(rng);
+  a.z = lo.z + (hi.z - lo.z) * mvla_rng_randf(rng);
+  a.w = lo.w + (hi.w - lo.w) * mvla_rng_randf(rng);
   return a;
 }
 
-MVLAIMPL v3d_t v3d_sin(v3d_t a) {
-  a.x = sin(a.x);
-  a.y = sin(a.y);
-  a.z = sin(a.z);
+MVLAIMPL v2f_t v2f_rand_disk(mvla_rng_t *rng) {
+  float r = sqrtf(mvla_rng_randf(rng));
+  float s, c;
+  sincosf_fast(MVLA__TWO_PI_F * mvla_rng_randf(rng), &s, &c);
+  return v2f(r * c, r * s);
+}
+
+MVLAIMPL v3f_t v3f_rand_sphere(mvla_rng_t *rng) {
+  float z = 1.0f - 2.0f * mvla_rng_randf(rng);
+  float r = sqrtf((1.0f - z) * (1.0f + z));
+  float s, c;
+  sincosf_fast(MVLA__TWO_PI_F * mvla_rng_randf(rng), &s, &c);
+  return v3f(r * c, r * s, z);
+}
+
+// one Box-Muller pair from two draws
+static inline void mvla__rand_gauss_pair(mvla_rng_t *rng, float *a, float *b) {
+  float r = sqrtf(-2.0f * logf_fast(1.0f - mvla_rng_randf(rng)));
+  float s, c;
+  sincosf_fast(MVLA__TWO_PI_F * mvla_rng_randf(rng), &s, &c);
+  *a = r * c;
+  *b = r * s;
+}
+
+MVLAIMPL v2f_t v2f_rand_gauss(mvla_rng_t *rng) {
+  v2f_t a;
+  mvla__rand_gauss_pair(rng, &a.x, &a.y);
   return a;
 }
 
-MVLAIMPL v3d_t v3d_cos(v3d_t a) {
-  a.x = cos(a.x);
-  a.y = cos(a.y);
-  a.z = cos(a.z);
+MVLAIMPL v3f_t v3f_rand_gauss(mvla_rng_t *rng) {
+  v3f_t a;
+  float unused;
+  mvla__rand_gauss_pair(rng, &a.x, &a.y);
+  mvla__rand_gauss_pair(rng, &a.z, &unused);
   return a;
 }
 
-MVLAIMPL v3d_t v3d_tan(v3d_t a) {
-  a.x = tan(a.x);
-  a.y = tan(a.y);
-  a.z = tan(a.z);
+MVLAIMPL v4f_t v4f_rand_gauss(mvla_rng_t *rng) {
+  v4f_t a;
+  mvla__rand_gauss_pair(rng, &a.x, &a.y);
+  mvla__rand_gauss_pair(rng, &a.z, &a.w);
   return a;
 }
 
-MVLAIMPL double v3d_len(v3d_t a) {
-  return sqrt(v3d_sqr_len(a));
-}
+/*
+** The batch samplers work in chunks: the lanes fill one array per draw, the
+** transform runs over those arrays with the dispatched kernels and leaves
+** component d in array d, which is then interleaved or copied out.
+*/
 
-MVLAIMPL double v3d_sqr_len(v3d_t a) {
-  return a.x * a.x + a.y * a.y + a.z * a.z;
+#define MVLA__RAND_CHUNK 256
+
+typedef enum mvla__rand_kind {
+  MVLA__RAND_BOX,
+  MVLA__RAND_DISK,
+  MVLA__RAND_SPHERE,
+  MVLA__RAND_GAUSS
+} mvla__rand_kind_t;
+
+static inline void mvla__rand_chunk(mvla_rng_lanes_t *lanes, mvla__rand_kind_t kind,
+                                    const float *lo, const float *hi, size_t dims,
+                                    float *u, float *t, size_t m) {
+  size_t d, i;
+  switch (kind) {
+    case MVLA__RAND_BOX:
+      mvla__rng_uniform(lanes, u, m, dims);
+      for (d = 0; d < dims; ++d) {
+        float *c = u + d * m;
+        float base = lo[d], size = hi[d] - lo[d];
+        for (i = 0; i < m; ++i) {
+          c[i] = base + size * c[i];
+        }
+      }
+      break;
+    case MVLA__RAND_DISK:
+      mvla__rng_uniform(lanes, u, m, 2);
+      mvla__f32_sqrt(u, u, m);
+      for (i = 0; i < m; ++i) {
+        u[m + i] *= MVLA__TWO_PI_F;
+      }
+      mvla__f32_sincos_fast(u + m, u + m, t, m);
+      for (i = 0; i < m; ++i) {
+        float r = u[i];
+        u[i] = r * t[i];
+        u[m + i] = r * u[m + i];
+      }
+      break;
+    case MVLA__RAND_SPHERE:
+      mvla__rng_uniform(lanes, u, m, 2);
+      for (i = 0; i < m; ++i) {
+        float z = 1.0f - 2.0f * u[i];
+        u[2 * m + i] = z;
+        u[i] = (1.0f - z) * (1.0f + z);
+        u[m + i] *= MVLA__TWO_PI_F;
+      }
+      mvla__f32_sqrt(u, u, m);
+      mvla__f32_sincos_fast(u + m, u + m, t, m);
+      for (i = 0; i < m; ++i) {
+        float r = u[i];
+        u[i] = r * t[i];
+        u[m + i] = r * u[m + i];
+      }
+      break;
+    case MVLA__RAND_GAUSS:
+      mvla__rng_uniform(lanes, u, m, (dims + 1) & ~(size_t) 1);
+      for (d = 0; d < dims; d += 2) {
+        float *a = u + d * m, *b = u + (d + 1) * m;
+        for (i = 0; i < m; ++i) {
+          a[i] = 1.0f - a[i];
+          b[i] *= MVLA__TWO_PI_F;
+        }
+        mvla__f32_log_fast(a, a, m);
+        for (i = 0; i < m; ++i) {
+          a[i] *= -2.0f;
+        }
+        mvla__f32_sqrt(a, a, m);
+        mvla__f32_sincos_fast(b, b, t, m);
+        for (i = 0; i < m; ++i) {
+          float r = a[i];
+          a[i] = r * t[i];
+          b[i] = r * b[i];
+        }
+      }
+      break;
+  }
 }
 
-MVLAIMPL void v3d_print(v3d_t a) {
-  printf("v3d_t(%lf, %lf, %lf)\n", V3_ARGS(a));
+// writes n vectors to aos when it isn't NULL, to the soa component arrays otherwise
+static inline void mvla__rand_n(mvla_rng_lanes_t *lanes, mvla__rand_kind_t kind,
+                                const float *lo, const float *hi, size_t dims,
+                                float *aos, float *const *soa, size_t n) {
+  float u[4 * MVLA__RAND_CHUNK], t[MVLA__RAND_CHUNK];
+  size_t off = 0, d;
+  while (off < n) {
+    size_t m = n - off < MVLA__RAND_CHUNK ? n - off : MVLA__RAND_CHUNK;
+    mvla__rand_chunk(lanes, kind, lo, hi, dims, u, t, m);
+    if (aos != NULL) {
+      float *p = aos + off * dims;
+      if (dims == 2) {
+        mvla__w32_soa_to_aos2(u, u + m, p, m);
+      } else if (dims == 3) {
+        mvla__w32_soa_to_aos3(u, u + m, u + 2 * m, p, m);
+      } else {
+        mvla__w32_soa_to_aos4(u, u + m, u + 2 * m, u + 3 * m, p, m);
+      }
+    } else {
+      for (d = 0; d < dims; ++d) {
+        memcpy(soa[d] + off, u + d * m, m * sizeof(float));
+      }
+    }
+    off += m;
+  }
 }
 
-// -----------------------------------------
-
-MVLAIMPL v4i_t v4i(signed int x, signed int y, signed int z, signed int w) {
-  v4i_t vec;
-  vec.x = x;
-  vec.y = y;
-  vec.z = z;
-  vec.w = w;
-  return vec;
+MVLAIMPL v4u_t mvla_philox(uint64_t seed, uint64_t stream, uint64_t index) {
+  unsigned int w[4];
+  mvla__philox_block(seed, stream, index, w);
+  return v4u(w[0], w[1], w[2], w[3]);
 }
 
-MVLAIMPL v4i_t v4ii(signed int x) {
-  return v4i(x, x, x, x);
+// top 24 bits of a word, the randf convention for 32-bit draws
+static inline float mvla__u32_unitf(unsigned int w) {
+  return (float) (w >> 8) * 5.9604644775390625e-8f;
 }
 
-MVLAIMPL v4i_t v4i_add(v4i_t a, v4i_t b) {
-  a.x += b.x;
-  a.y += b.y;
-  a.z += b.z;
-  a.w += b.w;
-  return a;
+MVLAIMPL v4f_t mvla_philox_v4f(uint64_t seed, uint64_t stream, uint64_t index) {
+  unsigned int w[4];
+  mvla__philox_block(seed, stream, index, w);
+  return v4f(mvla__u32_unitf(w[0]), mvla__u32_unitf(w[1]),
+             mvla__u32_unitf(w[2]), mvla__u32_unitf(w[3]));
 }
 
-MVLAIMPL v4i_t v4i_sub(v4i_t a, v4i_t b) {
-  a.x -= b.x;
-  a.y -= b.y;
-  a.z -= b.z;
-  a.w -= b.w;
-  return a;
+MVLAIMPL void mvla_philox_v4u_n(uint64_t seed, uint64_t stream, uint64_t first, v4u_t *out, size_t n) {
+  mvla__philox(seed, stream, first, (unsigned int *) out, n);
 }
 
-MVLAIMPL v4i_t v4i_mul(v4i_t a, v4i_t b) {
-  a.x *= b.x;
-  a.y *= b.y;
-  a.z *= b.z;
-  a.w *= b.w;
-  return a;
+MVLAIMPL void mvla_philox_v4f_n(uint64_t seed, uint64_t stream, uint64_t first, v4f_t *out, size_t n) {
+  unsigned int w[4 * MVLA__RAND_CHUNK];
+  float *f = (float *) out;
+  size_t i;
+  while (n > 0) {
+    size_t m = n < MVLA__RAND_CHUNK ? n : MVLA__RAND_CHUNK;
+    mvla__philox(seed, stream, first, w, m);
+    for (i = 0; i < 4 * m; ++i) {
+      f[i] = mvla__u32_unitf(w[i]);
+    }
+    f += 4 * m;
+    first += m;
+    n -= m;
+  }
 }
 
-MVLAIMPL v4i_t v4i_div(v4i_t a, v4i_t b) {
-  a.x /= b.x;
-  a.y /= b.y;
-  a.z /= b.z;
-  a.w /= b.w;
-  return a;
+MVLAIMPL void mvla_philox_fill(uint64_t seed, uint64_t stream, uint64_t first, float *out, size_t n) {
+  unsigned int w[4];
+  size_t i;
+  // finish a block the range starts inside of, then whole blocks, then the rest
+  while (n > 0 && first % 4 != 0) {
+    mvla__philox_block(seed, stream, first / 4, w);
+    *out++ = mvla__u32_unitf(w[first % 4]);
+    ++first;
+    --n;
+  }
+  mvla_philox_v4f_n(seed, stream, first / 4, (v4f_t *) out, n / 4);
+  out += n - n % 4;
+  first += n - n % 4;
+  mvla__philox_block(seed, stream, first / 4, w);
+  for (i = 0; i < n % 4; ++i) {
+    out[i] = mvla__u32_unitf(w[i]);
+  }
 }
 
-MVLAIMPL v4i_t v4i_min(v4i_t a, v4i_t b) {
-  a.x = mini(a.x, b.x);
-  a.y = mini(a.y, b.y);
-  a.z = mini(a.z, b.z);
-  a.w = mini(a.w, b.w);
-  return a;
+MVLAIMPL void v2f_rand_box_n(mvla_rng_lanes_t *lanes, v2f_t lo, v2f_t hi, v2f_t *out, size_t n) {
+  mvla__rand_n(lanes, MVLA__RAND_BOX, &lo.x, &hi.x, 2, (float *) out, NULL, n);
 }
 
-MVLAIMPL v4i_t v4i_max(v4i_t a, v4i_t b) {
-  a.x = maxi(a.x, b.x);
-  a.y = maxi(a.y, b.y);
-  a.z = maxi(a.z, b.z);
-  a.w = maxi(a.w, b.w);
-  return a;
+MVLAIMPL void v2f_soa_rand_box(mvla_rng_lanes_t *lanes, v2f_t lo, v2f_t hi, v2f_soa_t *out) {
+  float *const comps[2] = {out->x, out->y};
+  mvla__rand_n(lanes, MVLA__RAND_BOX, &lo.x, &hi.x, 2, NULL, comps, out->count);
 }
 
-MVLAIMPL void v4i_print(v4i_t a) {
-  printf("v4i_t(%d, %d, %d, %d)\n", V4_ARGS(a));
+MVLAIMPL void v3f_rand_box_n(mvla_rng_lanes_t *lanes, v3f_t lo, v3f_t hi, v3f_t *out, size_t n) {
+  mvla__rand_n(lanes, MVLA__RAND_BOX, &lo.x, &hi.x, 3, (float *) out, NULL, n);
 }
 
-MVLAIMPL v4u_t v4u(unsigned int x, unsigned int y, unsigned int z, unsigned int w) {
-  v4u_t vec;
-  vec.x = x;
-  vec.y = y;
-  vec.z = z;
-  vec.w = w;
-  return vec;
+MVLAIMPL void v3f_soa_rand_box(mvla_rng_lanes_t *lanes, v3f_t lo, v3f_t hi, v3f_soa_t *out) {
+  float *const comps[3] = {out->x, out->y, out->z};
+  mvla__rand_n(lanes, MVLA__RAND_BOX, &lo.x, &hi.x, 3, NULL, comps, out->count);
 }
 
-MVLAIMPL v4u_t v4uu(unsigned int x) {
-  return v4u(x, x, x, x);
+MVLAIMPL void v4f_rand_box_n(mvla_rng_lanes_t *lanes, v4f_t lo, v4f_t hi, v4f_t *out, size_t n) {
+  mvla__rand_n(lanes, MVLA__RAND_BOX, &lo.x, &hi.x, 4, (float *) out, NULL, n);
 }
 
-MVLAIMPL v4u_t v4u_add(v4u_t a, v4u_t b) {
-  a.x += b.x;
-  a.y += b.y;
-  a.z += b.z;
-  a.w += b.w;
-  return a;
+MVLAIMPL void v4f_soa_rand_box(mvla_rng_lanes_t *lanes, v4f_t lo, v4f_t hi, v4f_soa_t *out) {
+  float *const comps[4] = {out->x, out->y, out->z, out->w};
+  mvla__rand_n(lanes, MVLA__RAND_BOX, &lo.x, &hi.x, 4, NULL, comps, out->count);
 }
 
-MVLAIMPL v4u_t v4u_sub(v4u_t a, v4u_t b) {
-  a.x -= b.x;
-  a.y -= b.y;
-  a.z -= b.z;
-  a.w -= b.w;
-  return a;
+MVLAIMPL void v2f_rand_disk_n(mvla_rng_lanes_t *lanes, v2f_t *out, size_t n) {
+  mvla__rand_n(lanes, MVLA__RAND_DISK, NULL, NULL, 2, (float *) out, NULL, n);
 }
 
-MVLAIMPL v4u_t v4u_mul(v4u_t a, v4u_t b) {
-  a.x *= b.x;
-  a.y *= b.y;
-  a.z *= b.z;
-  a.w *= b.w;
-  return a;
+MVLAIMPL void v2f_soa_rand_disk(mvla_rng_lanes_t *lanes, v2f_soa_t *out) {
+  float *const comps[2] = {out->x, out->y};
+  mvla__rand_n(lanes, MVLA__RAND_DISK, NULL, NULL, 2, NULL, comps, out->count);
 }
 
-MVLAIMPL v4u_t v4u_div(v4u_t a, v4u_t b) {
-  a.x /= b.x;
-  a.y /= b.y;
-  a.z /= b.z;
-  a.w /= b.w;
-  return a;
+MVLAIMPL void v3f_rand_sphere_n(mvla_rng_lanes_t *lanes, v3f_t *out, size_t n) {
+  mvla__rand_n(lanes, MVLA__RAND_SPHERE, NULL, NULL, 3, (float *) out, NULL, n);
 }
 
-MVLAIMPL v4u_t v4u_min(v4u_t a, v4u_t b) {
-  a.x = minu(a.x, b.x);
-  a.y = minu(a.y, b.y);
-  a.z = minu(a.z, b.z);
-  a.w = minu(a.w, b.w);
-  return a;
+MVLAIMPL void v3f_soa_rand_sphere(mvla_rng_lanes_t *lanes, v3f_soa_t *out) {
+  float *const comps[3] = {out->x, out->y, out->z};
+  mvla__rand_n(lanes, MVLA__RAND_SPHERE, NULL, NULL, 3, NULL, comps, out->count);
 }
 
-MVLAIMPL v4u_t v4u_max(v4u_t a, v4u_t b) {
-  a.x = maxu(a.x, b.x);
-  a.y = maxu(a.y, b.y);
-  a.z = maxu(a.z, b.z);
-  a.w = maxu(a.w, b.w);
-  return a;
+MVLAIMPL void v2f_rand_gauss_n(mvla_rng_lanes_t *lanes, v2f_t *out, size_t n) {
+  mvla__rand_n(lanes, MVLA__RAND_GAUSS, NULL, NULL, 2, (float *) out, NULL, n);
 }
 
-MVLAIMPL void v4u_print(v4u_t a) {
-  printf("v4u_t(%u, %u, %u, %u)\n", V4_ARGS(a));
+MVLAIMPL void v2f_soa_rand_gauss(mvla_rng_lanes_t *lanes, v2f_soa_t *out) {
+  float *const comps[2] = {out->x, out->y};
+  mvla__rand_n(lanes, MVLA__RAND_GAUSS, NULL, NULL, 2, NULL, comps, out->count);
 }
 
-MVLAIMPL v4f_t v4f(float x, float y, float z, float w) {
-  v4f_t vec;
-  vec.x = x;
-  vec.y = y;
-  vec.z = z;
-  vec.w = w;
-  return vec;
+MVLAIMPL void v3f_rand_gauss_n(mvla_rng_lanes_t *lanes, v3f_t *out, size_t n) {
+  mvla__rand_n(lanes, MVLA__RAND_GAUSS, NULL, NULL, 3, (float *) out, NULL, n);
 }
 
-MVLAIMPL v4f_t v4ff(float x) { return v4f(x, x, x, x); }
-
-MVLAIMPL v4f_t v4f_add(v4f_t a, v4f_t b) {
-  a.x += b.x;
-  a.y += b.y;
-  a.z += b.z;
-  a.w += b.w;
-  return a;
+MVLAIMPL void v3f_soa_rand_gauss(mvla_rng_lanes_t *lanes, v3f_soa_t *out) {
+  float *const comps[3] = {out->x, out->y, out->z};
+  mvla__rand_n(lanes, MVLA__RAND_GAUSS, NULL, NULL, 3, NULL, comps, out->count);
 }
 
-MVLAIMPL v4f_t v4f_sub(v4f_t a, v4f_t b) {
-  a.x -= b.x;
-  a.y -= b.y;
-  a.z -= b.z;
-  a.w -= b.w;
-  return a;
+MVLAIMPL void v4f_rand_gauss_n(mvla_rng_lanes_t *lanes, v4f_t *out, size_t n) {
+  mvla__rand_n(lanes, MVLA__RAND_GAUSS, NULL, NULL, 4, (float *) out, NULL, n);
 }
 
-MVLAIMPL v4f_t v4f_mul(v4f_t a, v4f_t b) {
-  a.x *= b.x;
-  a.y *= b.y;
-  a.z *= b.z;
-  a.w *= b.w;
-  return a;
+MVLAIMPL void v4f_soa_rand_gauss(mvla_rng_lanes_t *lanes, v4f_soa_t *out) {
+  float *const comps[4] = {out->x, out->y, out->z, out->w};
+  mvla__rand_n(lanes, MVLA__RAND_GAUSS, NULL, NULL, 4, NULL, comps, out->count);
 }
 
-MVLAIMPL v4f_t v4f_div(v4f_t a, v4f_t b) {
-  a.x /= b.x;
-  a.y /= b.y;
-  a.z /= b.z;
-  a.w /= b.w;
-  return a;
-}
+// -----------------------------------------
 
-MVLAIMPL v4f_t v4f_min(v4f_t a, v4f_t b) {
-  a.x = fminf(a.x, b.x);
-  a.y = fminf(a.y, b.y);
-  a.z = fminf(a.z, b.z);
-  a.w = fminf(a.w, b.w);
-  return a;
-}
+/*
+** QUASI-RANDOM FUNCTIONS
+*/
 
-MVLAIMPL v4f_t v4f_max(v4f_t a, v4f_t b) {
-  a.x = fmaxf(a.x, b.x);
-  a.y = fmaxf(a.y, b.y);
-  a.z = fmaxf(a.z, b.z);
-  a.w = fmaxf(a.w, b.w);
-  return a;
+typedef enum mvla__qrng_kind {
+  MVLA__QRNG_SOBOL,
+  MVLA__QRNG_HALTON,
+  MVLA__QRNG_RD
+} mvla__qrng_kind_t;
+
+// Joe-Kuo direction numbers, dimension 0 is the van der Corput sequence
+static const uint32_t mvla__sobol_v[4][32] = {
+  {
+    0x80000000, 0x40000000, 0x20000000, 0x10000000, 0x08000000, 0x04000000, 0x02000000, 0x01000000,
+    0x00800000, 0x00400000, 0x00200000, 0x00100000, 0x00080000, 0x00040000, 0x00020000, 0x00010000,
+    0x00008000, 0x00004000, 0x00002000, 0x00001000, 0x00000800, 0x00000400, 0x00000200, 0x00000100,
+    0x00000080, 0x00000040, 0x00000020, 0x00000010, 0x00000008, 0x00000004, 0x00000002, 0x00000001
+  },
+  {
+    0x80000000, 0xc0000000, 0xa0000000, 0xf0000000, 0x88000000, 0xcc000000, 0xaa000000, 0xff000000,
+    0x80800000, 0xc0c00000, 0xa0a00000, 0xf0f00000, 0x88880000, 0xcccc0000, 0xaaaa0000, 0xffff0000,
+    0x80008000, 0xc000c000, 0xa000a000, 0xf000f000, 0x88008800, 0xcc00cc00, 0xaa00aa00, 0xff00ff00,
+    0x80808080, 0xc0c0c0c0, 0xa0a0a0a0, 0xf0f0f0f0, 0x88888888, 0xcccccccc, 0xaaaaaaaa, 0xffffffff
+  },
+  {
+    0x80000000, 0xc0000000, 0x60000000, 0x90000000, 0xe8000000, 0x5c000000, 0x8e000000, 0xc5000000,
+    0x68800000, 0x9cc00000, 0xee600000, 0x55900000, 0x80680000, 0xc09c0000, 0x60ee0000, 0x90550000,
+    0xe8808000, 0x5cc0c000, 0x8e606000, 0xc5909000, 0x6868e800, 0x9c9c5c00, 0xeeee8e00, 0x5555c500,
+    0x8000e880, 0xc0005cc0, 0x60008e60, 0x9000c590, 0xe8006868, 0x5c009c9c, 0x8e00eeee, 0xc5005555
+  },
+  {
+    0x80000000, 0xc0000000, 0x20000000, 0x50000000, 0xf8000000, 0x74000000, 0xa2000000, 0x93000000,
+    0xd8800000, 0x25400000, 0x59e00000, 0xe6d00000, 0x78080000, 0xb40c0000, 0x82020000, 0xc3050000,
+    0x208f8000, 0x51474000, 0xfbea2000, 0x75d93000, 0xa0858800, 0x914e5400, 0xdbe79e00, 0x25db6d00,
+    0x58800080, 0xe54000c0, 0x79e00020, 0xb6d00050, 0x800800f8, 0xc00c0074, 0x200200a2, 0x50050093
+  }
+};
+
+// 1 / g^k as 0.64 fixed point, g the real root of x^(d + 1) = x + 1
+static const uint64_t mvla__rd_alpha[3][4] = {
+  {UINT64_C(0xc13fa9a902a6328f), UINT64_C(0x91e10da5c79e7b1c)},
+  {UINT64_C(0xd1b54a32d192ed03), UINT64_C(0xabc98388fb8fac02), UINT64_C(0x8cb92ba72f3d8dd7)},
+  {UINT64_C(0xdb4f0b9175ae2165), UINT64_C(0xbbe0563303a4615f), UINT64_C(0xa0f2ec75a1fe1575),
+   UINT64_C(0x89e182857d9ed688)}
+};
+
+static inline uint64_t mvla__qrng_hash(uint64_t seed, uint64_t k) {
+  uint64_t x = seed ^ (k * UINT64_C(0xd6e8feb86659fd93));
+  return mvla__splitmix64(&x);
 }
 
-MVLAIMPL v4f_t v4f_sqrt(v4f_t a) {
-  a.x = sqrtf(a.x);
-  a.y = sqrtf(a.y);
-  a.z = sqrtf(a.z);
-  a.w = sqrtf(a.w);
-  return a;
+// lowbias32 integer hash
+static inline uint32_t mvla__hash32(uint32_t x) {
+  x ^= x >> 16;
+  x *= 0x7feb352du;
+  x ^= x >> 15;
+  x *= 0x846ca68bu;
+  x ^= x >> 16;
+  return x;
 }
 
-MVLAIMPL v4f_t v4f_poww(v4f_t a, float exp) {
-  a.x = powf(a.x, exp);
-  a.y = powf(a.y, exp);
-  a.z = powf(a.z, exp);
-  a.w = powf(a.w, exp);
-  return a;
+static inline int mvla__ctz32(uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctz(x);
+#else
+  int k = 0;
+  while ((x & 1u) == 0) {
+    x >>= 1;
+    ++k;
+  }
+  return k;
+#endif
 }
 
-MVLAIMPL v4f_t v4f_pow(v4f_t a, v4f_t exp) {
-  a.x = powf(a.x, exp.x);
-  a.y = powf(a.y, exp.y);
-  a.z = powf(a.z, exp.z);
-  a.w = powf(a.w, exp.w);
-  return a;
+static inline uint32_t mvla__reverse32(uint32_t x) {
+  x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+  x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+  x = ((x >> 4) & 0x0f0f0f0fu) | ((x & 0x0f0f0f0fu) << 4);
+  x = ((x >> 8) & 0x00ff00ffu) | ((x & 0x00ff00ffu) << 8);
+  return (x >> 16) | (x << 16);
 }
 
-MVLAIMPL v4f_t v4f_exp(v4f_t a) {
-  a.x = powf(MVLA_E, a.x);
-  a.y = powf(MVLA_E, a.y);
-  a.z = powf(MVLA_E, a.z);
-  a.w = powf(MVLA_E, a.w);
-  return a;
+// hash-based Owen scramble (Burley 2020): each bit flips by a hash of the bits above it
+static inline uint32_t mvla__owen32(uint32_t x, uint32_t seed) {
+  x = mvla__reverse32(x);
+  x += seed;
+  x ^= x * 0x6c50b47cu;
+  x ^= x * 0xb82f1e52u;
+  x ^= x * 0xc7afe638u;
+  x ^= x * 0x8d22f6e6u;
+  return mvla__reverse32(x);
 }
 
-MVLAIMPL v4f_t v4f_sin(v4f_t a) {
-  a.x = sinf(a.x);
-  a.y = sinf(a.y);
-  a.z = sinf(a.z);
-  a.w = sinf(a.w);
-  return a;
+static inline uint32_t mvla__sobol_point(uint32_t i, int d) {
+  uint32_t x = 0;
+  int k;
+  for (k = 0; i != 0; i >>= 1, ++k) {
+    if (i & 1u) {
+      x ^= mvla__sobol_v[d][k];
+    }
+  }
+  return x;
 }
 
-MVLAIMPL v4f_t v4f_cos(v4f_t a) {
-  a.x = cosf(a.x);
-  a.y = cosf(a.y);
-  a.z = cosf(a.z);
-  a.w = cosf(a.w);
-  return a;
+// base, index digits kept (base^digits <= 2^63) and base^digits, per Halton dimension
+static const uint64_t mvla__halton_base[4][3] = {
+  {2, 63, UINT64_C(9223372036854775808)},
+  {3, 39, UINT64_C(4052555153018976267)},
+  {5, 27, UINT64_C(7450580596923828125)},
+  {7, 22, UINT64_C(3909821048582988049)}
+};
+
+// digits the Owen scramble permutes, enough for 24 bits in each base, and base^digits
+static const uint32_t mvla__halton_owen_digits[4][2] = {
+  {24, 16777216}, {16, 43046721}, {11, 48828125}, {9, 40353607}
+};
+
+/*
+** Index counter for one Halton dimension. The radical inverse is kept as the
+** integer rev over base^digits, so stepping the counter is exact and a batch
+** matches points computed one at a time.
+*/
+typedef struct mvla__halton {
+  uint64_t rev;          // the index digits reversed
+  uint64_t w[63];        // weight of index digit j in rev
+  unsigned char dig[63]; // index digits, least significant first
+  double scale;          // 2^32 / base^digits
+} mvla__halton_t;
+
+static void mvla__halton_init(mvla__halton_t *h, int d, uint64_t i) {
+  const uint64_t b = mvla__halton_base[d][0], size = mvla__halton_base[d][2];
+  const unsigned int digits = (unsigned int) mvla__halton_base[d][1];
+  unsigned int j;
+  i %= size;
+  h->rev = 0;
+  for (j = 0; j < digits; ++j) {
+    h->w[j] = (j == 0 ? size : h->w[j - 1]) / b;
+    h->dig[j] = (unsigned char) (i % b);
+    h->rev += h->dig[j] * h->w[j];
+    i /= b;
+  }
+  h->scale = 4294967296.0 / (double) size;
 }
 
-MVLAIMPL v4f_t v4f_tan(v4f_t a) {
-  a.x = tanf(a.x);
-  a.y = tanf(a.y);
-  a.z = tanf(a.z);
-  a.w = tanf(a.w);
-  return a;
+static inline void mvla__halton_next(mvla__halton_t *h, int d) {
+  const unsigned int b = (unsigned int) mvla__halton_base[d][0];
+  const unsigned int digits = (unsigned int) mvla__halton_base[d][1];
+  unsigned int j;
+  for (j = 0; j < digits; ++j) {
+    if (++h->dig[j] < b) {
+      h->rev += h->w[j];
+      return;
+    }
+    h->dig[j] = 0;
+    h->rev -= (b - 1) * h->w[j];
+  }
 }
 
-MVLAIMPL float v4f_len(v4f_t a) {
-  return sqrtf(v4f_sqr_len(a));
+// radical inverse as 0.32 fixed point
+static inline uint32_t mvla__halton_fixed(const mvla__halton_t *h) {
+  double x = (double) h->rev * h->scale;
+  return x < 4294967296.0 ? (uint32_t) x : UINT32_MAX;
 }
 
-MVLAIMPL float v4f_sqr_len(v4f_t a) {
-  return a.x * a.x + a.y * a.y + a.z * a.z + a.w * a.w;
+/*
+** Owen scrambled radical inverse as 0.32 fixed point. The digit at each level
+** goes through a permutation hashed from the digits before it, continuing past
+** the digits of the index so leading zeros scramble too.
+*/
+static inline uint32_t mvla__halton_owen(const mvla__halton_t *h, int d, uint64_t seed) {
+  const unsigned int b = (unsigned int) mvla__halton_base[d][0];
+  uint32_t node = 1, rev = 0;
+  unsigned int k;
+  for (k = 0; k < mvla__halton_owen_digits[d][0]; ++k) {
+    unsigned int p[7] = {0, 1, 2, 3, 4, 5, 6}, digit = h->dig[k], j;
+    uint32_t bits = mvla__hash32(node ^ (uint32_t) seed);
+    // Fisher-Yates, each draw the integer part of bits * (j + 1) / 2^32, the fraction kept for the next
+    for (j = b - 1; j > 0; --j) {
+      uint64_t m = (uint64_t) bits * (j + 1);
+      unsigned int t = (unsigned int) (m >> 32), s = p[j];
+      bits = (uint32_t) m;
+      p[j] = p[t];
+      p[t] = s;
+    }
+    node = node * b + digit;
+    rev = rev * b + p[digit];
+  }
+  return (uint32_t) ((double) rev * (4294967296.0 / mvla__halton_owen_digits[d][1]));
 }
 
-MVLAIMPL void v4f_print(v4f_t a) {
-  printf("v4f_t(%f, %f, %f, %f)\n", V4_ARGS(a));
+// points first .. first + n - 1 into out[i * dims + d]
+static void mvla__qrng_n(mvla__qrng_kind_t kind, mvla_scramble_t scramble, uint64_t seed,
+                         uint64_t first, int dims, float *out, size_t n) {
+  const uint64_t *alpha = mvla__rd_alpha[dims - 2];
+  uint64_t key[4], rd[4];
+  uint32_t x[4], shift[4], flip[4][32];
+  mvla__halton_t halton[4];
+  size_t i;
+  int d, k;
+  for (d = 0; d < dims; ++d) {
+    key[d] = mvla__qrng_hash(seed, (uint64_t) d);
+    shift[d] = scramble == MVLA_SCRAMBLE_SHIFT || (scramble == MVLA_SCRAMBLE_OWEN && kind == MVLA__QRNG_RD)
+                 ? (uint32_t) (key[d] >> 32)
+                 : 0;
+  }
+  switch (kind) {
+    case MVLA__QRNG_SOBOL:
+      // going from i to i + 1 flips bits 0 .. ctz(i + 1), so x changes by a prefix xor of v
+      for (d = 0; d < dims; ++d) {
+        x[d] = mvla__sobol_point((uint32_t) first, d);
+        flip[d][0] = mvla__sobol_v[d][0];
+        for (k = 1; k < 32; ++k) {
+          flip[d][k] = flip[d][k - 1] ^ mvla__sobol_v[d][k];
+        }
+      }
+      for (i = 0; i < n; ++i) {
+        uint32_t next = (uint32_t) (first + i + 1);
+        k = next != 0 ? mvla__ctz32(next) : 31;
+        for (d = 0; d < dims; ++d) {
+          uint32_t q = scramble == MVLA_SCRAMBLE_OWEN ? mvla__owen32(x[d], (uint32_t) key[d]) : x[d];
+          out[i * dims + d] = mvla__u32_unitf(q + shift[d]);
+          x[d] ^= flip[d][k];
+        }
+      }
+      break;
+    case MVLA__QRNG_HALTON:
+      for (d = 0; d < dims; ++d) {
+        mvla__halton_init(&halton[d], d, first);
+      }
+      for (i = 0; i < n; ++i) {
+        for (d = 0; d < dims; ++d) {
+          uint32_t q = scramble == MVLA_SCRAMBLE_OWEN ? mvla__halton_owen(&halton[d], d, key[d])
+                                                      : mvla__halton_fixed(&halton[d]);
+          out[i * dims + d] = mvla__u32_unitf(q + shift[d]);
+          mvla__halton_next(&halton[d], d);
+        }
+      }
+      break;
+    case MVLA__QRNG_RD:
+      // fixed point wraps modulo 1 for free
+      for (d = 0; d < dims; ++d) {
+        rd[d] = UINT64_C(0x8000000000000000) + first * alpha[d];
+      }
+      for (i = 0; i < n; ++i) {
+        for (d = 0; d < dims; ++d) {
+          out[i * dims + d] = mvla__u32_unitf((uint32_t) (rd[d] >> 32) + shift[d]);
+          rd[d] += alpha[d];
+        }
+      }
+      break;
+  }
 }
 
-MVLAIMPL v4d_t v4d(double x, double y, double z, double w) {
-  v4d_t vec;
-  vec.x = x;
-  vec.y = y;
-  vec.z = z;
-  vec.w = w;
-  return vec;
+MVLAIMPL v2f_t v2f_sobol(mvla_scramble_t scramble, uint64_t seed, uint64_t index) {
+  v2f_t r;
+  mvla__qrng_n(MVLA__QRNG_SOBOL, scramble, seed, index, 2, (float *) &r, 1);
+  return r;
 }
 
-MVLAIMPL v4d_t v4dd(double x) {
-  return v4d(x, x, x, x);
+MVLAIMPL void v2f_sobol_n(mvla_scramble_t scramble, uint64_t seed, uint64_t first, v2f_t *out, size_t n) {
+  mvla__qrng_n(MVLA__QRNG_SOBOL, scramble, seed, first, 2, (float *) out, n);
 }
 
-MVLAIMPL v4d_t v4d_add(v4d_t a, v4d_t b) {
-  a.x += b.x;
-  a.y += b.y;
-  a.z += b.z;
-  a.w += b.w;
-  return a;
+MVLAIMPL v3f_t v3f_sobol(mvla_scramble_t scramble, uint64_t seed, uint64_t index) {
+  v3f_t r;
+  mvla__qrng_n(MVLA__QRNG_SOBOL, scramble, seed, index, 3, (float *) &r, 1);
+  return r;
 }
 
-MVLAIMPL v4d_t v4d_sub(v4d_t a, v4d_t b) {
-  a.x -= b.x;
-  a.y -= b.y;
-  a.z -= b.z;
-  a.w -= b.w;
-  return a;
+MVLAIMPL void v3f_sobol_n(mvla_scramble_t scramble, uint64_t seed, uint64_t first, v3f_t *out, size_t n) {
+  mvla__qrng_n(MVLA__QRNG_SOBOL, scramble, seed, first, 3, (float *) out, n);
 }
 
-MVLAIMPL v4d_t v4d_mul(v4d_t a, v4d_t b) {
-  a.x *= b.x;
-  a.y *= b.y;
-  a.z *= b.z;
-  a.w *= b.w;
-  return a;
+MVLAIMPL v4f_t v4f_sobol(mvla_scramble_t scramble, uint64_t seed, uint64_t index) {
+  v4f_t r;
+  mvla__qrng_n(MVLA__QRNG_SOBOL, scramble, seed, index, 4, (float *) &r, 1);
+  return r;
 }
 
-MVLAIMPL v4d_t v4d_div(v4d_t a, v4d_t b) {
-  a.x /= b.x;
-  a.y /= b.y;
-  a.z /= b.z;
-  a.w /= b.w;
-  return a;
+MVLAIMPL void v4f_sobol_n(mvla_scramble_t scramble, uint64_t seed, uint64_t first, v4f_t *out, size_t n) {
+  mvla__qrng_n(MVLA__QRNG_SOBOL, scramble, seed, first, 4, (float *) out, n);
 }
 
-MVLAIMPL v4d_t v4d_min(v4d_t a, v4d_t b) {
-  a.x = fmin(a.x, b.x);
-  a.y = fmin(a.y, b.y);
-  a.z = fmin(a.z, b.z);
-  a.w = fmin(a.w, b.w);
-  return a;
+MVLAIMPL v2f_t v2f_halton(mvla_scramble_t scramble, uint64_t seed, uint64_t index) {
+  v2f_t r;
+  mvla__qrng_n(MVLA__QRNG_HALTON, scramble, seed, index, 2, (float *) &r, 1);
+  return r;
 }
 
-MVLAIMPL v4d_t v4d_max(v4d_t a, v4d_t b) {
-  a.x = fmax(a.x, b.x);
-  a.y = fmax(a.y, b.y);
-  a.z = fmax(a.z, b.z);
-  a.w = fmax(a.w, b.w);
-  return a;
+MVLAIMPL void v2f_halton_n(mvla_scramble_t scramble, uint64_t seed, uint64_t first, v2f_t *out, size_t n) {
+  mvla__qrng_n(MVLA__QRNG_HALTON, scramble, seed, first, 2, (float *) out, n);
 }
 
-MVLAIMPL v4d_t v4d_sqrt(v4d_t a) {
-  a.x = sqrt(a.x);
-  a.y = sqrt(a.y);
-  a.z = sqrt(a.z);
-  a.w = sqrt(a.w);
-  return a;
+MVLAIMPL v3f_t v3f_halton(mvla_scramble_t scramble, uint64_t seed, uint64_t index) {
+  v3f_t r;
+  mvla__qrng_n(MVLA__QRNG_HALTON, scramble, seed, index, 3, (float *) &r, 1);
+  return r;
 }
 
-MVLAIMPL v4d_t v4d_poww(v4d_t a, double exp) {
-  a.x = pow(a.x, exp);
-  a.y = pow(a.y, exp);
-  a.z = pow(a.z, exp);
-  a.w = pow(a.w, exp);
-  return a;
+MVLAIMPL void v3f_halton_n(mvla_scramble_t scramble, uint64_t seed, uint64_t first, v3f_t *out, size_t n) {
+  mvla__qrng_n(MVLA__QRNG_HALTON, scramble, seed, first, 3, (float *) out, n);
 }
 
-MVLAIMPL v4d_t v4d_pow(v4d_t a, v4d_t exp) {
-  a.x = pow(a.x, exp.x);
-  a.y = pow(a.y, exp.y);
-  a.z = pow(a.z, exp.z);
-  a.w = pow(a.w, exp.w);
-  return a;
+MVLAIMPL v4f_t v4f_halton(mvla_scramble_t scramble, uint64_t seed, uint64_t index) {
+  v4f_t r;
+  mvla__qrng_n(MVLA__QRNG_HALTON, scramble, seed, index, 4, (float *) &r, 1);
+  return r;
 }
 
-MVLAIMPL v4d_t v4d_exp(v4d_t a) {
-  a.x = pow(MVLA_E, a.x);
-  a.y = pow(MVLA_E, a.y);
-  a.z = pow(MVLA_E, a.z);
-  a.w = pow(MVLA_E, a.w);
-  return a;
+MVLAIMPL void v4f_halton_n(mvla_scramble_t scramble, uint64_t seed, uint64_t first, v4f_t *out, size_t n) {
+  mvla__qrng_n(MVLA__QRNG_HALTON, scramble, seed, first, 4, (float *) out, n);
 }
 
-MVLAIMPL v4d_t v4d_sin(v4d_t a) {
-  a.x = sin(a.x);
-  a.y = sin(a.y);
-  a.z = sin(a.z);
-  a.w = sin(a.w);
-  return a;
+MVLAIMPL v2f_t v2f_r2(mvla_scramble_t scramble, uint64_t seed, uint64_t index) {
+  v2f_t r;
+  mvla__qrng_n(MVLA__QRNG_RD, scramble, seed, index, 2, (float *) &r, 1);
+  return r;
 }
 
-MVLAIMPL v4d_t v4d_cos(v4d_t a) {
-  a.x = cos(a.x);
-  a.y = cos(a.y);
-  a.z = cos(a.z);
-  a.w = cos(a.w);
-  return a;
+MVLAIMPL void v2f_r2_n(mvla_scramble_t scramble, uint64_t seed, uint64_t first, v2f_t *out, size_t n) {
+  mvla__qrng_n(MVLA__QRNG_RD, scramble, seed, first, 2, (float *) out, n);
 }
 
-MVLAIMPL v4d_t v4d_tan(v4d_t a) {
-  a.x = tan(a.x);
-  a.y = tan(a.y);
-  a.z = tan(a.z);
-  a.w = tan(a.w);
-  return a;
+MVLAIMPL v3f_t v3f_r3(mvla_scramble_t scramble, uint64_t seed, uint64_t index) {
+  v3f_t r;
+  mvla__qrng_n(MVLA__QRNG_RD, scramble, seed, index, 3, (float *) &r, 1);
+  return r;
 }
 
-MVLAIMPL double v4d_len(v4d_t a) {
-  return sqrt(v4d_sqr_len(a));
+MVLAIMPL void v3f_r3_n(mvla_scramble_t scramble, uint64_t seed, uint64_t first, v3f_t *out, size_t n) {
+  mvla__qrng_n(MVLA__QRNG_RD, scramble, seed, first, 3, (float *) out, n);
 }
 
-MVLAIMPL double v4d_sqr_len(v4d_t a) {
-  return a.x * a.x + a.y * a.y + a.z * a.z + a.w * a.w;
+MVLAIMPL v4f_t v4f_r4(mvla_scramble_t scramble, uint64_t seed, uint64_t index) {
+  v4f_t r;
+  mvla__qrng_n(MVLA__QRNG_RD, scramble, seed, index, 4, (float *) &r, 1);
+  return r;
 }
 
-MVLAIMPL void v4d_print(v4d_t a) {
-  printf("v4d_t(%lf, %lf, %lf, %lf)\n", V4_ARGS(a));
+MVLAIMPL void v4f_r4_n(mvla_scramble_t scramble, uint64_t seed, uint64_t first, v4f_t *out, size_t n) {
+  mvla__qrng_n(MVLA__QRNG_RD, scramble, seed, first, 4, (float *) out, n);
 }
 
 // -----------------------------------------
@@ -2596,10 +23294,3 @@ MVLAIMPL void v4d_print(v4d_t a) {
 #ifdef __cplusplus
 }
 #endif // __cplusplus
-
-/*
-** TODO:
-** - still missing the M (matrix) in MVLA... should implement mat2x2f_t, etc
-** - implement a way to choose an allocator (ie... preprocessor defs to pick a 
-**   malloc definition)
-*/
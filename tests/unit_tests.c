@@ -473,6 +473,12 @@ void test_v3f(void) {
   ALWAYS_ASSERT(approxf(vec_tan.y, tanf(M_PI_4)));
   ALWAYS_ASSERT(vec_tan.z < -100000.0f); // to -infinity and beyond
 
+  // v3f_sincos
+  v3f_t vec_s, vec_c;
+  v3f_sincos(v3f(0.0f, M_PI_2, -2.5f), &vec_s, &vec_c);
+  ALWAYS_ASSERT(approxf(vec_s.x, 0.0f) && approxf(vec_s.y, 1.0f) && approxf(vec_s.z, sinf(-2.5f)));
+  ALWAYS_ASSERT(approxf(vec_c.x, 1.0f) && approxf(vec_c.y, 0.0f) && approxf(vec_c.z, cosf(-2.5f)));
+
   // v3f_len
   float length = v3f_len(v3f(3.0f, 4.0f, 12.0f));
   ALWAYS_ASSERT(approxf(length, 13.0f));
@@ -480,6 +486,33 @@ void test_v3f(void) {
   // v3f_sqr_len
   float vec_sqr_len = v3f_sqr_len(v3f(3.0f, 4.0f, 12.0f));
   ALWAYS_ASSERT(approxf(vec_sqr_len, 169.0f));
+
+  // v3f_dot, v3f_cross
+  ALWAYS_ASSERT(approxf(v3f_dot(veca, vecb), 94.5f));
+  v3f_t vec_cross = v3f_cross(v3f(1.0f, 0.0f, 0.0f), v3f(0.0f, 1.0f, 0.0f));
+  ALWAYS_ASSERT(vec_cross.x == 0.0f && vec_cross.y == 0.0f && vec_cross.z == 1.0f);
+  vec_cross = v3f_cross(veca, vecb);
+  ALWAYS_ASSERT(approxf(v3f_dot(vec_cross, veca), 0.0f) && approxf(v3f_dot(vec_cross, vecb), 0.0f));
+
+  // v3f_normalize, v3f_normalize_fast
+  v3f_t vec_unit = v3f_normalize(v3f(3.0f, 4.0f, 12.0f));
+  ALWAYS_ASSERT(approxf(vec_unit.x, 3.0f / 13.0f) && approxf(vec_unit.z, 12.0f / 13.0f));
+  vec_unit = v3f_normalize_fast(v3f(3.0f, 4.0f, 12.0f));
+  ALWAYS_ASSERT(approxf(vec_unit.x, 3.0f / 13.0f) && approxf(vec_unit.z, 12.0f / 13.0f));
+  vec_unit = v3f_normalize(v3f(0.0f, 0.0f, 0.0f));
+  ALWAYS_ASSERT(vec_unit.x == 0.0f && vec_unit.y == 0.0f && vec_unit.z == 0.0f);
+
+  // v3f_dist, v3f_sqr_dist
+  ALWAYS_ASSERT(approxf(v3f_dist(v3f(1.0f, 1.0f, 1.0f), v3f(4.0f, 5.0f, 13.0f)), 13.0f));
+  ALWAYS_ASSERT(approxf(v3f_sqr_dist(v3f(1.0f, 1.0f, 1.0f), v3f(4.0f, 5.0f, 13.0f)), 169.0f));
+
+  // v3f_project, v3f_reflect
+  v3f_t vec_proj = v3f_project(v3f(2.0f, 3.0f, 4.0f), v3f(0.0f, 2.0f, 0.0f));
+  ALWAYS_ASSERT(approxf(vec_proj.x, 0.0f) && approxf(vec_proj.y, 3.0f) && approxf(vec_proj.z, 0.0f));
+  vec_proj = v3f_project(veca, v3f(0.0f, 0.0f, 0.0f));
+  ALWAYS_ASSERT(vec_proj.x == 0.0f && vec_proj.y == 0.0f && vec_proj.z == 0.0f);
+  v3f_t vec_refl = v3f_reflect(v3f(1.0f, -1.0f, 2.0f), v3f(0.0f, 1.0f, 0.0f));
+  ALWAYS_ASSERT(approxf(vec_refl.x, 1.0f) && approxf(vec_refl.y, 1.0f) && approxf(vec_refl.z, 2.0f));
 }
 
 void test_v3d(void) {
@@ -513,6 +546,18 @@ void test_v3d(void) {
   ALWAYS_ASSERT(approxd(vec_prod.y, 31.5));
   ALWAYS_ASSERT(approxd(vec_prod.z, 38.5));
 
+  // v3d_fma
+  v3d_t vec_fma = v3d_fma(veca, vecb, v3d(1.0, 2.0, 3.0));
+  ALWAYS_ASSERT(approxd(vec_fma.x, 25.5));
+  ALWAYS_ASSERT(approxd(vec_fma.y, 33.5));
+  ALWAYS_ASSERT(approxd(vec_fma.z, 41.5));
+
+  // v3d_fms
+  v3d_t vec_fms = v3d_fms(veca, vecb, v3d(1.0, 2.0, 3.0));
+  ALWAYS_ASSERT(approxd(vec_fms.x, 23.5));
+  ALWAYS_ASSERT(approxd(vec_fms.y, 29.5));
+  ALWAYS_ASSERT(approxd(vec_fms.z, 35.5));
+
   // v3d_div
   v3d_t vec_div = v3d_div(veca, v3d(1.0, 2.0, 5.5));
   ALWAYS_ASSERT(approxd(vec_div.x, 3.5));
@@ -741,6 +786,20 @@ void test_v4f(void) {
   ALWAYS_ASSERT(approxf(vec_prod.z, 15.0f));
   ALWAYS_ASSERT(approxf(vec_prod.w, 20.0f));
 
+  // v4f_fma
+  v4f_t vec_fma = v4f_fma(veca, vecb, v4f(0.5f, -1.0f, 2.0f, -20.0f));
+  ALWAYS_ASSERT(approxf(vec_fma.x, 5.5f));
+  ALWAYS_ASSERT(approxf(vec_fma.y, 9.0f));
+  ALWAYS_ASSERT(approxf(vec_fma.z, 17.0f));
+  ALWAYS_ASSERT(approxf(vec_fma.w, 0.0f));
+
+  // v4f_fms
+  v4f_t vec_fms = v4f_fms(veca, vecb, v4f(0.5f, -1.0f, 2.0f, -20.0f));
+  ALWAYS_ASSERT(approxf(vec_fms.x, 4.5f));
+  ALWAYS_ASSERT(approxf(vec_fms.y, 11.0f));
+  ALWAYS_ASSERT(approxf(vec_fms.z, 13.0f));
+  ALWAYS_ASSERT(approxf(vec_fms.w, 40.0f));
+
   // v4f_div
   v4f_t vec_div = v4f_div(vecb, v4f(1.0f, 2.0f, 5.0f, 4.0f));
   ALWAYS_ASSERT(approxf(vec_div.x, 5.0f));
@@ -935,11 +994,1895 @@ void test_v4d(void) {
   ALWAYS_ASSERT(approxd(vec_sqr_len, 4.0));
 }
 
+void test_v4_storage(void) {
+  v4f_t fs[2];
+  v4u_t ua = v4u(0x80000001u, 1, 0xffffffffu, 7);
+  v4u_t ub = v4u(2, 0x90000000u, 0, 7);
+  v4i_t ia = v4i(-5, 6, -2147483647 / 2, 20000);
+  v4i_t ib = v4i(3, -6, 2, 20000);
+
+#if defined(MVLA_SIMD_SSE) || defined(MVLA_SIMD_NEON)
+  ALWAYS_ASSERT(((size_t) &fs[1] % 16) == 0);
+#endif // MVLA_SIMD_SSE || MVLA_SIMD_NEON
+  ALWAYS_ASSERT(sizeof(fs[0]) == 4 * sizeof(float));
+
+  // component access through the union
+  fs[0] = v4f(1.0f, 2.0f, 3.0f, 4.0f);
+  fs[0].z = 9.0f;
+  ALWAYS_ASSERT(fs[0].x == 1.0f && fs[0].y == 2.0f && fs[0].z == 9.0f && fs[0].w == 4.0f);
+
+  // v4f_min / v4f_max with a NaN operand follow fminf / fmaxf
+  fs[1] = v4f_min(v4f(NAN, 1.0f, 2.0f, NAN), v4f(5.0f, NAN, 1.0f, -1.0f));
+  ALWAYS_ASSERT(fs[1].x == 5.0f && fs[1].y == 1.0f && fs[1].z == 1.0f && fs[1].w == -1.0f);
+  fs[1] = v4f_max(v4f(NAN, 1.0f, 2.0f, NAN), v4f(5.0f, NAN, 1.0f, -1.0f));
+  ALWAYS_ASSERT(fs[1].x == 5.0f && fs[1].y == 1.0f && fs[1].z == 2.0f && fs[1].w == -1.0f);
+
+  // v4u_min / v4u_max compare unsigned across the sign bit
+  v4u_t umin = v4u_min(ua, ub);
+  v4u_t umax = v4u_max(ua, ub);
+  ALWAYS_ASSERT(umin.x == 2 && umin.y == 1 && umin.z == 0 && umin.w == 7);
+  ALWAYS_ASSERT(umax.x == 0x80000001u && umax.y == 0x90000000u && umax.z == 0xffffffffu);
+
+  // v4u_mul keeps the low 32 bits
+  v4u_t uprod = v4u_mul(ua, ub);
+  ALWAYS_ASSERT(uprod.x == 2 && uprod.y == 0x90000000u && uprod.z == 0 && uprod.w == 49);
+
+  // v4i_mul / v4i_min / v4i_max with negative lanes
+  v4i_t iprod = v4i_mul(ia, ib);
+  ALWAYS_ASSERT(iprod.x == -15 && iprod.y == -36 && iprod.z == -2147483646 && iprod.w == 400000000);
+  v4i_t imin = v4i_min(ia, ib);
+  ALWAYS_ASSERT(imin.x == -5 && imin.y == -6 && imin.z == -2147483647 / 2 && imin.w == 20000);
+  v4i_t imax = v4i_max(ia, ib);
+  ALWAYS_ASSERT(imax.x == 3 && imax.y == 6 && imax.z == 2 && imax.w == 20000);
+
+  // v4d_t and v2d_t storage
+  v4d_t ds[2];
+  v2d_t d2[2];
+#if defined(MVLA_SIMD_AVX)
+  ALWAYS_ASSERT(((size_t) &ds[1] % 32) == 0);
+#endif // MVLA_SIMD_AVX
+  ALWAYS_ASSERT(sizeof(ds[0]) == 4 * sizeof(double) && sizeof(d2[0]) == 2 * sizeof(double));
+
+  // v4d_min / v2d_max with a NaN operand follow fmin / fmax
+  ds[0] = v4d_min(v4d(NAN, 1.0, 2.0, NAN), v4d(5.0, NAN, 1.0, -1.0));
+  ALWAYS_ASSERT(ds[0].x == 5.0 && ds[0].y == 1.0 && ds[0].z == 1.0 && ds[0].w == -1.0);
+  d2[0] = v2d_max(v2d(NAN, 3.0), v2d(1.0, NAN));
+  ALWAYS_ASSERT(d2[0].x == 1.0 && d2[0].y == 3.0);
+
+  // v4d_sqr_len / v2d_sqr_len sum in component order
+  ds[1] = v4d(1e16, 1.0, -1e16, 1.0);
+  ALWAYS_ASSERT(v4d_sqr_len(ds[1]) == ds[1].x * ds[1].x + ds[1].y * ds[1].y + ds[1].z * ds[1].z + ds[1].w * ds[1].w);
+  d2[1] = v2d(0.1, 0.7);
+  ALWAYS_ASSERT(v2d_sqr_len(d2[1]) == d2[1].x * d2[1].x + d2[1].y * d2[1].y);
+}
+
 void test_v4(void) {
   test_v4i();
   test_v4u();
   test_v4f();
   test_v4d();
+  test_v4_storage();
+}
+
+void test_mat4f(void) {
+  mat4x4f_t a = mat4x4f(v4f(2.0f, 0.0f, 1.0f, 0.5f), v4f(-1.0f, 3.0f, 0.0f, 2.0f),
+                        v4f(0.0f, 1.0f, 4.0f, -2.0f), v4f(1.0f, -1.0f, 2.0f, 3.0f));
+  mat4x4f_t b = mat4x4f(v4f(1.0f, 2.0f, 3.0f, 4.0f), v4f(0.5f, -1.0f, 0.0f, 2.0f),
+                        v4f(-3.0f, 1.0f, 1.0f, 0.0f), v4f(2.0f, 2.0f, -1.0f, 1.0f));
+  const float *pa = &a.c[0].x, *pb = &b.c[0].x;
+  int i, j, k;
+
+  // mat4x4f_mul against the textbook triple loop (column-major, pa[col * 4 + row])
+  mat4x4f_t ab = mat4x4f_mul(a, b);
+  for (j = 0; j < 4; ++j) {
+    for (i = 0; i < 4; ++i) {
+      float e = 0.0f;
+      for (k = 0; k < 4; ++k) {
+        e += pa[k * 4 + i] * pb[j * 4 + k];
+      }
+      ALWAYS_ASSERT(approxf((&ab.c[j].x)[i], e));
+    }
+  }
+
+  // mat4x4f_mul_v4f matches the product applied one matrix at a time
+  v4f_t v = v4f(0.5f, -2.0f, 1.5f, 1.0f);
+  v4f_t r = mat4x4f_mul_v4f(ab, v), e = mat4x4f_mul_v4f(a, mat4x4f_mul_v4f(b, v));
+  ALWAYS_ASSERT(approxf(r.x, e.x) && approxf(r.y, e.y) && approxf(r.z, e.z) && approxf(r.w, e.w));
+  r = mat4x4f_mul_v4f(a, v);
+  ALWAYS_ASSERT(approxf(r.x, 4.0f) && approxf(r.y, -5.5f) && approxf(r.z, 8.5f) && approxf(r.w, -3.75f));
+
+  // mat4x4f_transpose
+  mat4x4f_t t = mat4x4f_transpose(a);
+  ALWAYS_ASSERT(t.c[0].y == -1.0f && t.c[1].x == 0.0f && t.c[3].z == -2.0f && t.c[2].w == 2.0f);
+
+  // mat4x4f_det, including det(ab) = det(a) det(b)
+  ALWAYS_ASSERT(approxf(mat4x4f_det(mat4x4f_identity()), 1.0f));
+  ALWAYS_ASSERT(fabsf(mat4x4f_det(ab) - mat4x4f_det(a) * mat4x4f_det(b)) < 1e-3f);
+  ALWAYS_ASSERT(approxf(mat4x4f_det(t), mat4x4f_det(a)));
+
+  // mat4x4f_inverse
+  mat4x4f_t id = mat4x4f_mul(a, mat4x4f_inverse(a));
+  for (j = 0; j < 4; ++j) {
+    for (i = 0; i < 4; ++i) {
+      ALWAYS_ASSERT(fabsf((&id.c[j].x)[i] - (i == j ? 1.0f : 0.0f)) < 1e-5f);
+    }
+  }
+  t = mat4x4f_inverse(mat4x4f(a.c[0], a.c[1], a.c[0], a.c[3]));
+  ALWAYS_ASSERT(t.c[0].x == 0.0f && t.c[2].z == 0.0f && t.c[3].w == 0.0f);
+}
+
+void test_mat4d(void) {
+  mat4x4d_t a = mat4x4d(v4d(2.0, 0.0, 1.0, 0.5), v4d(-1.0, 3.0, 0.0, 2.0),
+                        v4d(0.0, 1.0, 4.0, -2.0), v4d(1.0, -1.0, 2.0, 3.0));
+  mat4x4d_t id = mat4x4d_mul(mat4x4d_inverse(a), a);
+  v4d_t r = mat4x4d_mul_v4d(a, v4d(0.5, -2.0, 1.5, 1.0));
+  int i, j;
+  ALWAYS_ASSERT(approxd(r.x, 4.0) && approxd(r.y, -5.5) && approxd(r.z, 8.5) && approxd(r.w, -3.75));
+  for (j = 0; j < 4; ++j) {
+    for (i = 0; i < 4; ++i) {
+      ALWAYS_ASSERT(approxd((&id.c[j].x)[i], i == j ? 1.0 : 0.0));
+    }
+  }
+  ALWAYS_ASSERT(approxd(mat4x4d_det(a), mat4x4d_det(mat4x4d_transpose(a))));
+}
+
+void test_mat3(void) {
+  mat3x3f_t a = mat3x3f(v3f(2.0f, 0.0f, 1.0f), v3f(-1.0f, 3.0f, 0.0f), v3f(0.0f, 1.0f, 4.0f));
+  mat3x3f_t id = mat3x3f_mul(a, mat3x3f_inverse(a));
+  v3f_t r = mat3x3f_mul_v3f(a, v3f(1.0f, 2.0f, 3.0f));
+  mat3x3d_t b = mat3x3d(v3d(1.0, 0.0, 5.0), v3d(2.0, 1.0, 6.0), v3d(3.0, 4.0, 0.0));
+  mat3x3d_t bi = mat3x3d_inverse(b);
+  ALWAYS_ASSERT(approxf(r.x, 0.0f) && approxf(r.y, 9.0f) && approxf(r.z, 13.0f));
+  ALWAYS_ASSERT(approxf(mat3x3f_det(a), 23.0f));
+  ALWAYS_ASSERT(approxf(id.c[0].x, 1.0f) && approxf(id.c[1].y, 1.0f) && approxf(id.c[2].z, 1.0f));
+  ALWAYS_ASSERT(approxf(id.c[0].y, 0.0f) && approxf(id.c[2].x, 0.0f) && approxf(id.c[1].z, 0.0f));
+
+  // the textbook example with integer inverse [-24 18 5; 20 -15 -4; -5 4 1]
+  ALWAYS_ASSERT(approxd(mat3x3d_det(b), 1.0));
+  ALWAYS_ASSERT(approxd(bi.c[0].x, -24.0) && approxd(bi.c[1].x, 18.0) && approxd(bi.c[2].x, 5.0));
+  ALWAYS_ASSERT(approxd(bi.c[0].y, 20.0) && approxd(bi.c[1].y, -15.0) && approxd(bi.c[2].y, -4.0));
+  ALWAYS_ASSERT(approxd(bi.c[0].z, -5.0) && approxd(bi.c[1].z, 4.0) && approxd(bi.c[2].z, 1.0));
+}
+
+void test_mat2(void) {
+  mat2x2f_t a = mat2x2f(v2f(4.0f, 2.0f), v2f(7.0f, 6.0f));
+  mat2x2f_t ai = mat2x2f_inverse(a);
+  mat2x2d_t b = mat2x2d_mul(mat2x2d(v2d(1.0, 3.0), v2d(2.0, 4.0)), mat2x2d_identity());
+  v2d_t r = mat2x2d_mul_v2d(mat2x2d_transpose(b), v2d(1.0, 1.0));
+  ALWAYS_ASSERT(approxf(mat2x2f_det(a), 10.0f));
+  ALWAYS_ASSERT(approxf(ai.c[0].x, 0.6f) && approxf(ai.c[0].y, -0.2f));
+  ALWAYS_ASSERT(approxf(ai.c[1].x, -0.7f) && approxf(ai.c[1].y, 0.4f));
+  ALWAYS_ASSERT(approxd(r.x, 4.0) && approxd(r.y, 6.0));
+  ALWAYS_ASSERT(mat2x2d_inverse(mat2x2d(v2d(1.0, 2.0), v2d(2.0, 4.0))).c[1].y == 0.0);
+}
+
+void test_mat_batch(void) {
+  mat4x4f_t a[37], inv[37], rigid[37];
+  mat4x4f_soa_t soa = mat4x4f_soa_alloc(37);
+  mat3x3d_t b[11], bi[11];
+  mat4x4d_t dup4d[11], dup4di[11];
+  mat3x3f_t dup3f[37], dup3fi[37];
+  unsigned char singular[37];
+  float det[37];
+  double detd[11];
+  int i, k;
+  for (i = 0; i < 37; ++i) {
+    float c = cosf(0.1f * i), s = sinf(0.1f * i);
+    a[i] = mat4x4f(v4f(2.0f + 0.25f * i, 0.0f, 1.0f, 0.5f), v4f(-1.0f, 3.0f, 0.0f, 2.0f),
+                   v4f(0.0f, 1.0f, 4.0f, -2.0f), v4f(1.0f, -1.0f, 2.0f, 3.0f - 0.125f * i));
+    if (i % 10 == 3) {
+      a[i].c[2] = a[i].c[1];
+    }
+    rigid[i] = mat4x4f(v4f(c, s, 0.0f, 0.0f), v4f(-s, c, 0.0f, 0.0f),
+                       v4f(0.0f, 0.0f, 1.0f, 0.0f), v4f(1.0f, -2.0f, 0.5f * i, 1.0f));
+    mat4x4f_soa_set(&soa, i, a[i]);
+  }
+
+  // mat4x4f_inverse_n and mat4x4f_det_n against the single matrix forms
+  ALWAYS_ASSERT(mat4x4f_inverse_n(a, inv, 37, singular) == 4);
+  mat4x4f_det_n(a, det, 37);
+  for (i = 0; i < 37; ++i) {
+    mat4x4f_t e = mat4x4f_inverse(a[i]);
+    ALWAYS_ASSERT(singular[i] == (i % 10 == 3) && approxf(det[i], mat4x4f_det(a[i])));
+    for (k = 0; k < 16; ++k) {
+      ALWAYS_ASSERT(approxf((&inv[i].c[0].x)[k], (&e.c[0].x)[k]));
+    }
+  }
+
+  // mat4x4f_soa_inverse in place
+  ALWAYS_ASSERT(mat4x4f_soa_inverse(&soa, &soa, NULL) == 4);
+  for (i = 0; i < 37; ++i) {
+    mat4x4f_t m = mat4x4f_soa_get(&soa, i);
+    for (k = 0; k < 16; ++k) {
+      ALWAYS_ASSERT((&m.c[0].x)[k] == (&inv[i].c[0].x)[k]);
+    }
+  }
+  mat4x4f_soa_det(&soa, det);
+  ALWAYS_ASSERT(approxf(det[0] * mat4x4f_det(a[0]), 1.0f) && det[3] == 0.0f);
+
+  // the rigid inverses match the general ones
+  mat4x4f_inverse_rigid_n(rigid, inv, 37);
+  for (i = 0; i < 37; ++i) {
+    mat4x4f_t e = mat4x4f_inverse(rigid[i]), r = mat4x4f_inverse_rigid(rigid[i]);
+    mat4x4f_soa_set(&soa, i, rigid[i]);
+    for (k = 0; k < 16; ++k) {
+      ALWAYS_ASSERT(approxf((&inv[i].c[0].x)[k], (&e.c[0].x)[k]));
+      ALWAYS_ASSERT(approxf((&r.c[0].x)[k], (&e.c[0].x)[k]));
+    }
+  }
+  mat4x4f_soa_inverse_rigid(&soa, &soa);
+  for (i = 0; i < 37; ++i) {
+    mat4x4f_t m = mat4x4f_soa_get(&soa, i);
+    for (k = 0; k < 16; ++k) {
+      ALWAYS_ASSERT((&m.c[0].x)[k] == (&inv[i].c[0].x)[k]);
+    }
+  }
+
+  // mat3x3d_inverse_n in place and mat3x3d_det_n
+  for (i = 0; i < 11; ++i) {
+    b[i] = bi[i] = mat3x3d(v3d(1.0, 0.0, 5.0 + i), v3d(2.0, 1.0, 6.0), v3d(3.0, 4.0 + i, 0.0));
+  }
+  ALWAYS_ASSERT(mat3x3d_inverse_n(bi, bi, 11, NULL) == 0);
+  mat3x3d_det_n(b, detd, 11);
+  for (i = 0; i < 11; ++i) {
+    mat3x3d_t e = mat3x3d_inverse(b[i]);
+    ALWAYS_ASSERT(approxd(detd[i], mat3x3d_det(b[i])));
+    for (k = 0; k < 9; ++k) {
+      ALWAYS_ASSERT(approxd((&bi[i].c[0].x)[k], (&e.c[0].x)[k]));
+    }
+  }
+
+  // a repeated column cancels to an exact zero determinant even when the
+  // products of the entries round
+  for (i = 0; i < 37; ++i) {
+    float *m4 = &a[i].c[0].x, *m3 = &dup3f[i].c[0].x;
+    for (k = 0; k < 16; ++k) {
+      // the diagonal keeps the matrices without a repeated column well conditioned
+      m4[k] = 0.1f * (float) ((i * 7 + k * k * 3 + k) % 29 + 1) + (k % 5 == 0 ? 4.0f : 0.0f);
+      if (i < 11) {
+        (&dup4d[i].c[0].x)[k] = 0.1 * ((i * 5 + k * k * 3 + k) % 31 + 1) + (k % 5 == 0 ? 4.0 : 0.0);
+      }
+      if (k < 9) {
+        m3[k] = 0.1f * (float) ((i * 11 + k * k * 5 + k) % 23 + 1) + (k % 4 == 0 ? 4.0f : 0.0f);
+      }
+    }
+    if (i % 2 == 1) {
+      a[i].c[1] = a[i].c[0];
+      dup3f[i].c[2] = dup3f[i].c[1];
+      if (i < 11) {
+        dup4d[i].c[1] = dup4d[i].c[0];
+      }
+    }
+  }
+  ALWAYS_ASSERT(mat4x4f_inverse_n(a, inv, 37, singular) == 18);
+  for (i = 0; i < 37; ++i) {
+    mat4x4f_t e = mat4x4f_inverse(a[i]);
+    ALWAYS_ASSERT(singular[i] == (i % 2 == 1));
+    for (k = 0; k < 16; ++k) {
+      ALWAYS_ASSERT(i % 2 == 1 ? (&inv[i].c[0].x)[k] == 0.0f
+                               : approxf((&inv[i].c[0].x)[k], (&e.c[0].x)[k]));
+    }
+  }
+  ALWAYS_ASSERT(mat4x4d_inverse_n(dup4d, dup4di, 11, singular) == 5);
+  for (i = 0; i < 11; ++i) {
+    ALWAYS_ASSERT(singular[i] == (i % 2 == 1));
+    for (k = 0; k < 16; ++k) {
+      ALWAYS_ASSERT(i % 2 == 0 || (&dup4di[i].c[0].x)[k] == 0.0);
+    }
+  }
+  ALWAYS_ASSERT(mat3x3f_inverse_n(dup3f, dup3fi, 37, singular) == 18);
+  for (i = 0; i < 37; ++i) {
+    mat3x3f_t e = mat3x3f_inverse(dup3f[i]);
+    ALWAYS_ASSERT(singular[i] == (i % 2 == 1));
+    for (k = 0; k < 9; ++k) {
+      ALWAYS_ASSERT(i % 2 == 1 ? (&dup3fi[i].c[0].x)[k] == 0.0f
+                               : approxf((&dup3fi[i].c[0].x)[k], (&e.c[0].x)[k]));
+    }
+  }
+  mat4x4f_soa_free(&soa);
+}
+
+void test_mat(void) {
+  test_mat2();
+  test_mat3();
+  test_mat4f();
+  test_mat4d();
+  test_mat_batch();
+}
+
+void test_batch_v3f(void) {
+  v3f_t a[11], b[11], out[11];
+  float lens[11];
+  size_t i;
+  for (i = 0; i < 11; ++i) {
+    a[i] = v3f(i + 1.0f, i * 0.5f, -(float) i);
+    b[i] = v3f(2.0f, i + 3.0f, 0.25f);
+  }
+
+  // v3f_add_n (11 vectors = 33 floats, exercises the tail)
+  v3f_add_n(a, b, out, 11);
+  for (i = 0; i < 11; ++i) {
+    v3f_t e = v3f_add(a[i], b[i]);
+    ALWAYS_ASSERT(out[i].x == e.x && out[i].y == e.y && out[i].z == e.z);
+  }
+
+  // v3f_min_n
+  v3f_min_n(a, b, out, 11);
+  for (i = 0; i < 11; ++i) {
+    v3f_t e = v3f_min(a[i], b[i]);
+    ALWAYS_ASSERT(out[i].x == e.x && out[i].y == e.y && out[i].z == e.z);
+  }
+
+  // v3f_div_n in place
+  v3f_div_n(out, b, out, 11);
+  for (i = 0; i < 11; ++i) {
+    v3f_t e = v3f_div(v3f_min(a[i], b[i]), b[i]);
+    ALWAYS_ASSERT(out[i].x == e.x && out[i].y == e.y && out[i].z == e.z);
+  }
+
+  // v3f_len_n
+  v3f_len_n(a, lens, 11);
+  for (i = 0; i < 11; ++i) {
+    ALWAYS_ASSERT(lens[i] == v3f_len(a[i]));
+  }
+
+  // v3f_sqr_len_n
+  v3f_sqr_len_n(a, lens, 11);
+  for (i = 0; i < 11; ++i) {
+    ALWAYS_ASSERT(lens[i] == v3f_sqr_len(a[i]));
+  }
+
+  // zero length batches are a no-op
+  v3f_sqrt_n(a, out, 0);
+}
+
+void test_batch_v4d(void) {
+  v4d_t a[5], out[5], s[5], c[5];
+  double lens[5];
+  size_t i;
+  for (i = 0; i < 5; ++i) {
+    a[i] = v4d(i * 0.3, 1.0 + i, -2.0 * i, 0.5);
+  }
+
+  // v4d_sin_n
+  v4d_sin_n(a, out, 5);
+  for (i = 0; i < 5; ++i) {
+    v4d_t e = v4d_sin(a[i]);
+    ALWAYS_ASSERT(out[i].x == e.x && out[i].y == e.y && out[i].z == e.z && out[i].w == e.w);
+  }
+
+  // v4d_sincos_n, cosines written over a copy of the input
+  for (i = 0; i < 5; ++i) {
+    c[i] = a[i];
+  }
+  v4d_sincos_n(c, s, c, 5);
+  for (i = 0; i < 5; ++i) {
+    v4d_t es = v4d_sin(a[i]), ec = v4d_cos(a[i]);
+    ALWAYS_ASSERT(s[i].x == es.x && s[i].y == es.y && s[i].z == es.z && s[i].w == es.w);
+    ALWAYS_ASSERT(c[i].x == ec.x && c[i].y == ec.y && c[i].z == ec.z && c[i].w == ec.w);
+  }
+
+  // v4d_max_n
+  v4d_max_n(a, out, out, 5);
+  for (i = 0; i < 5; ++i) {
+    v4d_t e = v4d_max(a[i], v4d_sin(a[i]));
+    ALWAYS_ASSERT(out[i].x == e.x && out[i].y == e.y && out[i].z == e.z && out[i].w == e.w);
+  }
+
+  // v4d_poww_n
+  v4d_poww_n(a, 2.0, out, 5);
+  for (i = 0; i < 5; ++i) {
+    v4d_t e = v4d_poww(a[i], 2.0);
+    ALWAYS_ASSERT(out[i].x == e.x && out[i].y == e.y && out[i].z == e.z && out[i].w == e.w);
+  }
+
+  // v4d_len_n
+  v4d_len_n(a, lens, 5);
+  for (i = 0; i < 5; ++i) {
+    ALWAYS_ASSERT(lens[i] == v4d_len(a[i]));
+  }
+}
+
+void test_batch_int(void) {
+  v2i_t a[7], b[7], out[7];
+  v3u_t c[5], d[5], uout[5];
+  size_t i;
+  for (i = 0; i < 7; ++i) {
+    a[i] = v2i((int) i - 3, 2 * (int) i);
+    b[i] = v2i(3, -(int) i);
+  }
+  for (i = 0; i < 5; ++i) {
+    c[i] = v3u(i, 10 - i, 7);
+    d[i] = v3u(2, i + 1, 3);
+  }
+
+  // v2i_mul_n
+  v2i_mul_n(a, b, out, 7);
+  for (i = 0; i < 7; ++i) {
+    v2i_t e = v2i_mul(a[i], b[i]);
+    ALWAYS_ASSERT(out[i].x == e.x && out[i].y == e.y);
+  }
+
+  // v2i_max_n
+  v2i_max_n(a, b, out, 7);
+  for (i = 0; i < 7; ++i) {
+    v2i_t e = v2i_max(a[i], b[i]);
+    ALWAYS_ASSERT(out[i].x == e.x && out[i].y == e.y);
+  }
+
+  // v3u_div_n
+  v3u_div_n(c, d, uout, 5);
+  for (i = 0; i < 5; ++i) {
+    v3u_t e = v3u_div(c[i], d[i]);
+    ALWAYS_ASSERT(uout[i].x == e.x && uout[i].y == e.y && uout[i].z == e.z);
+  }
+
+  // v3u_sub_n
+  v3u_sub_n(d, c, uout, 5);
+  for (i = 0; i < 5; ++i) {
+    v3u_t e = v3u_sub(d[i], c[i]);
+    ALWAYS_ASSERT(uout[i].x == e.x && uout[i].y == e.y && uout[i].z == e.z);
+  }
+}
+
+void test_batch_geom(void) {
+  v3f_t a[300], b[300], out[300], e;
+  v2d_t c[37], d[37], outd[37];
+  v4f_t q[37], outq[37];
+  float f[300];
+  double g[37];
+  size_t i;
+  for (i = 0; i < 300; ++i) {
+    a[i] = v3f(i * 0.25f - 30.0f, 1.0f + i % 7, -(float) (i % 5));
+    b[i] = v3f(0.5f, (float) (i % 3), i * 0.125f);
+  }
+  for (i = 0; i < 37; ++i) {
+    c[i] = v2d(i - 18.0, 0.5 * i);
+    d[i] = v2d(1.0, i % 4 - 2.0);
+    q[i] = v4f((float) i, -1.0f, 0.5f * i, 2.0f);
+  }
+  a[3] = v3f(0.0f, 0.0f, 0.0f);
+  b[5] = v3f(0.0f, 0.0f, 0.0f);
+
+  // 300 vectors cross the chunk size and leave a tail for every tier
+  v3f_dot_n(a, b, f, 300);
+  for (i = 0; i < 300; ++i) {
+    ALWAYS_ASSERT(approxf(f[i] / 1000.0f, v3f_dot(a[i], b[i]) / 1000.0f));
+  }
+  v3f_dist_n(a, b, f, 300);
+  for (i = 0; i < 300; ++i) {
+    ALWAYS_ASSERT(approxf(f[i] / 100.0f, v3f_dist(a[i], b[i]) / 100.0f));
+  }
+  v3f_cross_n(a, b, out, 300);
+  for (i = 0; i < 300; ++i) {
+    e = v3f_cross(a[i], b[i]);
+    ALWAYS_ASSERT(approxf(out[i].x, e.x) && approxf(out[i].y, e.y) && approxf(out[i].z, e.z));
+  }
+  v3f_project_n(a, b, out, 300);
+  for (i = 0; i < 300; ++i) {
+    e = v3f_project(a[i], b[i]);
+    ALWAYS_ASSERT(approxf(out[i].x, e.x) && approxf(out[i].y, e.y) && approxf(out[i].z, e.z));
+  }
+  v3f_normalize_fast_n(a, out, 300);
+  for (i = 0; i < 300; ++i) {
+    e = v3f_normalize(a[i]);
+    ALWAYS_ASSERT(approxf(out[i].x, e.x) && approxf(out[i].y, e.y) && approxf(out[i].z, e.z));
+  }
+
+  // in place, reflecting off the normalized b
+  v3f_normalize_n(b, b, 300);
+  ALWAYS_ASSERT(b[5].x == 0.0f && b[5].y == 0.0f && b[5].z == 0.0f);
+  ALWAYS_ASSERT(approxf(v3f_len(b[7]), 1.0f));
+  for (i = 0; i < 300; ++i) {
+    out[i] = a[i];
+  }
+  v3f_reflect_n(out, b, out, 300);
+  for (i = 0; i < 300; ++i) {
+    e = v3f_reflect(a[i], b[i]);
+    ALWAYS_ASSERT(approxf(out[i].x / 100.0f, e.x / 100.0f) && approxf(out[i].z / 100.0f, e.z / 100.0f));
+  }
+
+  // v2d_cross_n, v2d_normalize_n, v4f_sqr_dist_n, v4f_normalize_n
+  v2d_cross_n(c, d, g, 37);
+  v2d_normalize_n(c, outd, 37);
+  for (i = 0; i < 37; ++i) {
+    v2d_t n = v2d_normalize(c[i]);
+    ALWAYS_ASSERT(approxd(g[i], v2d_cross(c[i], d[i])));
+    ALWAYS_ASSERT(approxd(outd[i].x, n.x) && approxd(outd[i].y, n.y));
+  }
+  v4f_sqr_dist_n(q, q + 1, f, 36);
+  v4f_normalize_n(q, outq, 37);
+  for (i = 0; i < 36; ++i) {
+    v4f_t n = v4f_normalize(q[i]);
+    ALWAYS_ASSERT(approxf(f[i], v4f_sqr_dist(q[i], q[i + 1])));
+    ALWAYS_ASSERT(approxf(outq[i].x, n.x) && approxf(outq[i].w, n.w));
+  }
+}
+
+void test_batch_blas(void) {
+  float x[37], y[37], e[37];
+  double xd[37], big[3] = {1e300, 1e300, -1e300}, tiny[2] = {3e-200, -4e-200};
+  double dot = 0.0, asum = 0.0, sq = 0.0;
+  v3f_t a[9], b[9], c[9], out[9];
+  size_t i;
+  for (i = 0; i < 37; ++i) {
+    x[i] = (float) (i % 7) - 3.25f;
+    y[i] = e[i] = 0.5f * i - 4.0f;
+    xd[i] = x[i];
+  }
+
+  // axpyf_n
+  axpyf_n(2.0f, x, y, 37);
+  for (i = 0; i < 37; ++i) {
+    ALWAYS_ASSERT(approxf(y[i], 2.0f * x[i] + e[i]));
+  }
+
+  // scalf_n
+  scalf_n(-0.5f, y, 37);
+  for (i = 0; i < 37; ++i) {
+    ALWAYS_ASSERT(approxf(y[i], -0.5f * (2.0f * x[i] + e[i])));
+    dot += (double) x[i] * y[i];
+    asum += fabs(x[i]);
+    sq += (double) x[i] * x[i];
+  }
+
+  // dotf_n, asumf_n and nrm2f_n
+  ALWAYS_ASSERT(fabs(dotf_n(x, y, 37) - dot) < 1e-4);
+  ALWAYS_ASSERT(fabs(asumf_n(x, 37) - asum) < 1e-4);
+  ALWAYS_ASSERT(fabs(nrm2f_n(x, 37) - sqrt(sq)) < 1e-4);
+  ALWAYS_ASSERT(dotf_n(x, y, 0) == 0.0f);
+
+  // the double forms, nrm2d_n rescaling past overflow and underflow
+  ALWAYS_ASSERT(fabs(nrm2d_n(xd, 37) - sqrt(sq)) < 1e-12);
+  ALWAYS_ASSERT(fabs(asumd_n(xd, 37) - asum) < 1e-12);
+  ALWAYS_ASSERT(fabs(nrm2d_n(big, 3) / (sqrt(3.0) * 1e300) - 1.0) < 1e-12);
+  ALWAYS_ASSERT(fabs(nrm2d_n(tiny, 2) / 5e-200 - 1.0) < 1e-12);
+  ALWAYS_ASSERT(nrm2d_n(xd, 0) == 0.0);
+
+  // v3f_fma_n and v3f_fms_n, written over c
+  for (i = 0; i < 9; ++i) {
+    a[i] = v3f(x[i], x[i + 9], x[i + 18]);
+    b[i] = v3f(e[i], e[i + 9], e[i + 18]);
+    c[i] = v3f(0.25f * i, -1.0f, 3.0f);
+  }
+  v3f_fma_n(a, b, c, out, 9);
+  v3f_fms_n(a, b, c, c, 9);
+  for (i = 0; i < 9; ++i) {
+    v3f_t ea = v3f_fma(a[i], b[i], v3f(0.25f * i, -1.0f, 3.0f));
+    v3f_t es = v3f_fms(a[i], b[i], v3f(0.25f * i, -1.0f, 3.0f));
+    ALWAYS_ASSERT(approxf(out[i].x, ea.x) && approxf(out[i].y, ea.y) && approxf(out[i].z, ea.z));
+    ALWAYS_ASSERT(approxf(c[i].x, es.x) && approxf(c[i].y, es.y) && approxf(c[i].z, es.z));
+  }
+
+  // v3f_axpy_n, v3f_scal_n and the reductions
+  for (i = 0; i < 9; ++i) {
+    out[i] = b[i];
+  }
+  v3f_axpy_n(-1.5f, a, out, 9);
+  v3f_scal_n(2.0f, out, 9);
+  dot = asum = sq = 0.0;
+  for (i = 0; i < 9; ++i) {
+    v3f_t ex = v3f_mul(v3f_add(v3f_mul(v3ff(-1.5f), a[i]), b[i]), v3ff(2.0f));
+    ALWAYS_ASSERT(approxf(out[i].x, ex.x) && approxf(out[i].y, ex.y) && approxf(out[i].z, ex.z));
+    dot += v3f_dot(a[i], out[i]);
+    asum += fabs(out[i].x) + fabs(out[i].y) + fabs(out[i].z);
+    sq += v3f_sqr_len(out[i]);
+  }
+  ALWAYS_ASSERT(fabs(v3f_dot_sum_n(a, out, 9) - dot) < 1e-3);
+  ALWAYS_ASSERT(fabs(v3f_asum_n(out, 9) - asum) < 1e-3);
+  ALWAYS_ASSERT(fabs(v3f_nrm2_n(out, 9) - sqrt(sq)) < 1e-4);
+}
+
+void test_batch_xform(void) {
+  mat4x4f_t m = mat4x4f(v4f(0.0f, 2.0f, 0.0f, 0.0f), v4f(-1.0f, 0.0f, 0.0f, 0.0f),
+                        v4f(0.0f, 0.0f, 3.0f, 0.0f), v4f(1.0f, -2.0f, 0.5f, 1.0f));
+  mat4x4f_t p = m;
+  mat4x4d_t md = mat4x4d(v4d(1.0, 0.0, 0.0, 0.5), v4d(0.0, 1.0, 0.0, 0.0),
+                         v4d(0.0, 0.0, 1.0, -0.25), v4d(2.0, 0.0, 0.0, 1.0));
+  v3f_t a3[301], o3[301];
+  v4f_t a4[301], o4[301];
+  v4d_t ad[19];
+  v3f_soa_t s3 = v3f_soa_alloc(301);
+  v3f_soa_t so = v3f_soa_alloc(301);
+  size_t n = 100000, i;
+  v4f_t *big = (v4f_t *) malloc(n * sizeof(v4f_t));
+  v4f_t *bo = (v4f_t *) malloc(n * sizeof(v4f_t));
+  p.c[0].w = 0.25f;
+  p.c[3].w = 2.0f;
+  for (i = 0; i < 301; ++i) {
+    a3[i] = v3f(0.5f * i, 1.0f - i, (float) (i % 5));
+    a4[i] = v4f(a3[i].x, a3[i].y, a3[i].z, 1.0f + (i % 3));
+    s3.x[i] = a3[i].x;
+    s3.y[i] = a3[i].y;
+    s3.z[i] = a3[i].z;
+  }
+  for (i = 0; i < 19; ++i) {
+    ad[i] = v4d(i, -2.0 * i, 1.0, 1.0);
+  }
+
+  // mat4x4f_transform_v3f_n against mat4x4f_mul_v4f, affine and projective with divide
+  mat4x4f_transform_v3f_n(m, a3, o3, 301, 0);
+  for (i = 0; i < 301; ++i) {
+    v4f_t e = mat4x4f_mul_v4f(m, v4f(a3[i].x, a3[i].y, a3[i].z, 1.0f));
+    ALWAYS_ASSERT(approxf(o3[i].x, e.x) && approxf(o3[i].y, e.y) && approxf(o3[i].z, e.z));
+  }
+  mat4x4f_transform_v3f_n(p, a3, o3, 301, MVLA_XFORM_DIVIDE);
+  for (i = 0; i < 301; ++i) {
+    v4f_t e = mat4x4f_mul_v4f(p, v4f(a3[i].x, a3[i].y, a3[i].z, 1.0f));
+    ALWAYS_ASSERT(approxf(o3[i].x, e.x / e.w) && approxf(o3[i].y, e.y / e.w) && approxf(o3[i].z, e.z / e.w));
+  }
+
+  // mat4x4f_transform_v4f_n, divided and streamed in place
+  mat4x4f_transform_v4f_n(p, a4, o4, 301, 0);
+  mat4x4f_transform_v4f_n(p, a4, a4, 301, MVLA_XFORM_DIVIDE | MVLA_XFORM_STREAM);
+  for (i = 0; i < 301; ++i) {
+    v4f_t e = o4[i];
+    ALWAYS_ASSERT(approxf(a4[i].x, e.x / e.w) && approxf(a4[i].y, e.y / e.w) && approxf(a4[i].z, e.z / e.w));
+    ALWAYS_ASSERT(a4[i].w == 1.0f);
+  }
+
+  // mat4x4f_transform_v3f_soa, the forced 3x4 path ignores the bottom row
+  mat4x4f_transform_v3f_soa(p, &s3, &so, MVLA_XFORM_AFFINE | MVLA_XFORM_STREAM);
+  mat4x4f_transform_v3f_soa(m, &s3, &s3, 0);
+  for (i = 0; i < 301; ++i) {
+    v4f_t e = mat4x4f_mul_v4f(m, v4f(a3[i].x, a3[i].y, a3[i].z, 1.0f));
+    ALWAYS_ASSERT(approxf(so.x[i], e.x) && approxf(so.y[i], e.y) && approxf(so.z[i], e.z));
+    ALWAYS_ASSERT(so.x[i] == s3.x[i] && so.y[i] == s3.y[i] && so.z[i] == s3.z[i]);
+  }
+
+  // mat4x4d_transform_v4d_n
+  mat4x4d_transform_v4d_n(md, ad, ad, 19, MVLA_XFORM_DIVIDE);
+  for (i = 0; i < 19; ++i) {
+    double w = 0.5 * i - 0.25 + 1.0;
+    ALWAYS_ASSERT(fabs(ad[i].x - (i + 2.0) / w) < 1e-12 && fabs(ad[i].y + 2.0 * i / w) < 1e-12);
+    ALWAYS_ASSERT(ad[i].w == 1.0);
+  }
+
+  // split across threads
+  for (i = 0; i < n; ++i) {
+    big[i] = v4f((float) (i % 1000), 1.0f, -0.5f * (i % 7), 1.0f);
+  }
+  mvla_threads_set(4);
+  mat4x4f_transform_v4f_n(m, big, bo, n, MVLA_XFORM_STREAM);
+  mvla_threads_set(0);
+  for (i = 0; i < n; ++i) {
+    v4f_t e = mat4x4f_mul_v4f(m, big[i]);
+    ALWAYS_ASSERT(bo[i].x == e.x && bo[i].y == e.y && bo[i].z == e.z && bo[i].w == e.w);
+  }
+  free(big);
+  free(bo);
+  v3f_soa_free(&s3);
+  v3f_soa_free(&so);
+}
+
+void test_vecf(void) {
+  mvla_vecf_t a = mvla_vecf_alloc(1003), b = mvla_vecf_alloc(1003), out = mvla_vecf_alloc(1003);
+  mvla_vecf_t view;
+  double dot = 0.0, sq = 0.0;
+  size_t i;
+  ALWAYS_ASSERT(a.len == 1003 && (uintptr_t) a.data % MVLA_SOA_ALIGN == 0);
+  for (i = 0; i < a.len; ++i) {
+    a.data[i] = 0.01f * (float) (i % 97) + 0.5f;
+    b.data[i] = (float) (i % 13) - 6.5f;
+    dot += (double) a.data[i] * b.data[i];
+    sq += (double) a.data[i] * a.data[i];
+  }
+
+  // the element-wise operations, some in place
+  mvla_vecf_add(&a, &b, &out);
+  ALWAYS_ASSERT(approxf(out.data[1002], a.data[1002] + b.data[1002]));
+  mvla_vecf_sub(&a, &b, &out);
+  ALWAYS_ASSERT(approxf(out.data[17], a.data[17] - b.data[17]));
+  mvla_vecf_mul(&a, &b, &out);
+  ALWAYS_ASSERT(approxf(out.data[500], a.data[500] * b.data[500]));
+  mvla_vecf_div(&b, &a, &out);
+  ALWAYS_ASSERT(approxf(out.data[999], b.data[999] / a.data[999]));
+  mvla_vecf_min(&a, &b, &out);
+  ALWAYS_ASSERT(out.data[6] == b.data[6] && out.data[12] == a.data[12]);
+  mvla_vecf_max(&a, &b, &out);
+  ALWAYS_ASSERT(out.data[6] == a.data[6] && out.data[12] == b.data[12]);
+  mvla_vecf_sqrt(&a, &out);
+  ALWAYS_ASSERT(approxf(out.data[1001], sqrtf(a.data[1001])));
+  mvla_vecf_exp(&a, &out);
+  ALWAYS_ASSERT(approxf(out.data[3], expf(a.data[3])));
+  mvla_vecf_scale(&a, -2.0f, &out);
+  ALWAYS_ASSERT(out.data[1002] == -2.0f * a.data[1002]);
+
+  // the reductions
+  ALWAYS_ASSERT(fabs(mvla_vecf_dot(&a, &b) - dot) < 1e-2);
+  ALWAYS_ASSERT(fabs(mvla_vecf_sqr_len(&a) - sq) < 1e-2);
+  ALWAYS_ASSERT(fabs(mvla_vecf_len(&a) - sqrt(sq)) < 1e-4);
+
+  // a wrapped view and fill
+  view = mvla_vecf_wrap(b.data + 1, 5);
+  mvla_vecf_fill(&view, 2.5f);
+  mvla_vecf_scale(&view, 2.0f, &view);
+  ALWAYS_ASSERT(b.data[0] == -6.5f && b.data[1] == 5.0f && b.data[5] == 5.0f && b.data[6] == -0.5f);
+
+  mvla_vecf_free(&a);
+  mvla_vecf_free(&b);
+  mvla_vecf_free(&out);
+  ALWAYS_ASSERT(a.data == NULL && a.len == 0);
+}
+
+void test_vecd(void) {
+  double buf[7] = {3.0, 4.0, 0.0, 1.0, -2.0, 2.0, 0.5};
+  mvla_vecd_t a = mvla_vecd_wrap(buf, 7), out = mvla_vecd_alloc(7);
+  mvla_vecd_mul(&a, &a, &out);
+  mvla_vecd_sqrt(&out, &out);
+  ALWAYS_ASSERT(out.data[0] == 3.0 && out.data[4] == 2.0 && out.data[6] == 0.5);
+  ALWAYS_ASSERT(approxd(mvla_vecd_sqr_len(&a), 34.25));
+  ALWAYS_ASSERT(approxd(mvla_vecd_len(&a), sqrt(34.25)));
+  ALWAYS_ASSERT(approxd(mvla_vecd_dot(&a, &out), 9.0 + 16.0 + 1.0 - 4.0 + 4.0 + 0.25));
+  mvla_vecd_free(&out);
+}
+
+void test_vec(void) {
+  test_vecf();
+  test_vecd();
+}
+
+// the textbook triple loop on column-major storage
+void gemm_ref(int ta, int tb, size_t m, size_t n, size_t k, double alpha, const double *a,
+              size_t lda, const double *b, size_t ldb, double beta, double *c, size_t ldc) {
+  size_t i, j, p;
+  for (j = 0; j < n; ++j) {
+    for (i = 0; i < m; ++i) {
+      double sum = 0.0;
+      for (p = 0; p < k; ++p) {
+        sum += (ta ? a[i * lda + p] : a[p * lda + i]) * (tb ? b[p * ldb + j] : b[j * ldb + p]);
+      }
+      c[j * ldc + i] = alpha * sum + beta * c[j * ldc + i];
+    }
+  }
+}
+
+void test_gemm(void) {
+  // sizes past one MC block and one KC slice with partial micro-tiles
+  size_t m = 203, n = 29, k = 300, i, j;
+  int ta, tb;
+  double *a = (double *) malloc(300 * 300 * sizeof(double));
+  double *b = (double *) malloc(300 * 300 * sizeof(double));
+  double *c = (double *) malloc(210 * 29 * sizeof(double));
+  double *e = (double *) malloc(210 * 29 * sizeof(double));
+  mvla_matf_t fa = mvla_matf_alloc(13, 7), fb = mvla_matf_alloc(13, 5), fc = mvla_matf_alloc(7, 5);
+  for (i = 0; i < 300 * 300; ++i) {
+    a[i] = (double) (i % 17) * 0.125 - 1.0;
+    b[i] = (double) (i % 11) * 0.25 - 1.25;
+  }
+  for (ta = 0; ta < 2; ++ta) {
+    for (tb = 0; tb < 2; ++tb) {
+      for (i = 0; i < 210 * 29; ++i) {
+        c[i] = e[i] = (double) (i % 5);
+      }
+      gemmd(ta ? MVLA_TRANS : MVLA_NO_TRANS, tb ? MVLA_TRANS : MVLA_NO_TRANS, m, n, k, 1.5,
+            a, 300, b, 300, -0.5, c, 210);
+      gemm_ref(ta, tb, m, n, k, 1.5, a, 300, b, 300, -0.5, e, 210);
+      for (i = 0; i < 210 * 29; ++i) {
+        ALWAYS_ASSERT(fabs(c[i] - e[i]) < 1e-9);
+      }
+    }
+  }
+
+  // beta 0 never reads C
+  for (i = 0; i < 210 * 29; ++i) {
+    c[i] = NAN;
+  }
+  gemmd(MVLA_NO_TRANS, MVLA_NO_TRANS, 37, 29, 3, 1.0, a, 300, b, 300, 0.0, c, 210);
+  ALWAYS_ASSERT(c[0] == a[0] * b[0] + a[300] * b[1] + a[600] * b[2]);
+  for (j = 0; j < 29; ++j) {
+    for (i = 0; i < 37; ++i) {
+      ALWAYS_ASSERT(!isnan(c[j * 210 + i]));
+    }
+  }
+
+  // mvla_matf_gemm, c = a^T b
+  for (j = 0; j < 7; ++j) {
+    for (i = 0; i < 13; ++i) {
+      mvla_matf_set(&fa, i, j, (float) (i + j) * 0.5f);
+    }
+  }
+  for (j = 0; j < 5; ++j) {
+    for (i = 0; i < 13; ++i) {
+      mvla_matf_set(&fb, i, j, i == j ? 1.0f : 0.0f);
+    }
+  }
+  ALWAYS_ASSERT(fa.ld % 16 == 0 && fa.rows == 13 && fa.cols == 7);
+  mvla_matf_gemm(MVLA_TRANS, MVLA_NO_TRANS, 2.0f, &fa, &fb, 0.0f, &fc);
+  for (j = 0; j < 5; ++j) {
+    for (i = 0; i < 7; ++i) {
+      ALWAYS_ASSERT(mvla_matf_get(&fc, i, j) == (float) (i + j));
+    }
+  }
+
+  free(a);
+  free(b);
+  free(c);
+  free(e);
+  mvla_matf_free(&fa);
+  mvla_matf_free(&fb);
+  mvla_matf_free(&fc);
+
+  // shapes whose size overflows come back empty instead of wrapping
+  fa = mvla_matf_alloc(1024, (size_t) -1 / 1024);
+  ALWAYS_ASSERT(fa.data == NULL && fa.rows == 0 && fa.cols == 0);
+  fa = mvla_matf_alloc((size_t) -1 / 2, 1);
+  ALWAYS_ASSERT(fa.data == NULL && fa.rows == 0 && fa.cols == 0);
+}
+
+void test_gemv(void) {
+  size_t m = 3001, n = 301, i, j;
+  int t;
+  double *a = (double *) malloc(3008 * 301 * sizeof(double));
+  double *x = (double *) malloc(3001 * sizeof(double));
+  double *y = (double *) malloc(3001 * sizeof(double));
+  double *e = (double *) malloc(3001 * sizeof(double));
+  mvla_matd_t ma = mvla_matd_alloc(3, 2);
+  mvla_vecd_t vx = mvla_vecd_alloc(2), vy = mvla_vecd_alloc(3);
+  for (i = 0; i < 3008 * 301; ++i) {
+    a[i] = (double) (i % 13) * 0.25 - 1.5;
+  }
+  for (i = 0; i < m; ++i) {
+    x[i] = (double) (i % 7) - 3.0;
+  }
+  for (t = 0; t < 2; ++t) {
+    size_t rows = t ? n : m, cols = t ? m : n;
+    for (i = 0; i < rows; ++i) {
+      double sum = 0.0;
+      for (j = 0; j < cols; ++j) {
+        sum += (t ? a[i * 3008 + j] : a[j * 3008 + i]) * x[j];
+      }
+      y[i] = (double) (i % 3);
+      e[i] = 2.0 * sum - 0.5 * y[i];
+    }
+    gemvd(t ? MVLA_TRANS : MVLA_NO_TRANS, m, n, 2.0, a, 3008, x, -0.5, y);
+    for (i = 0; i < rows; ++i) {
+      ALWAYS_ASSERT(fabs(y[i] - e[i]) < 1e-9);
+    }
+
+    // beta 0 never reads y
+    for (i = 0; i < rows; ++i) {
+      y[i] = NAN;
+    }
+    gemvd(t ? MVLA_TRANS : MVLA_NO_TRANS, m, n, 2.0, a, 3008, x, 0.0, y);
+    for (i = 0; i < rows; ++i) {
+      ALWAYS_ASSERT(fabs(y[i] - e[i] - 0.5 * (double) (i % 3)) < 1e-9);
+    }
+  }
+
+  // mvla_matd_gemv
+  for (j = 0; j < 2; ++j) {
+    for (i = 0; i < 3; ++i) {
+      mvla_matd_set(&ma, i, j, (double) (i * 2 + j));
+    }
+  }
+  vx.data[0] = 1.0;
+  vx.data[1] = -1.0;
+  mvla_matd_gemv(MVLA_NO_TRANS, 1.0, &ma, &vx, 0.0, &vy);
+  ALWAYS_ASSERT(vy.data[0] == -1.0 && vy.data[1] == -1.0 && vy.data[2] == -1.0);
+
+  free(a);
+  free(x);
+  free(y);
+  free(e);
+  mvla_matd_free(&ma);
+  mvla_vecd_free(&vx);
+  mvla_vecd_free(&vy);
+}
+
+void test_dense_threads(void) {
+  // the same bits for any thread count, grids with partial blocks and strips
+  size_t n = 401, i;
+  float *a = (float *) malloc(2048 * 512 * sizeof(float));
+  float *b = (float *) malloc(401 * 401 * sizeof(float));
+  float *c1 = (float *) malloc(401 * 401 * sizeof(float));
+  float *c4 = (float *) malloc(401 * 401 * sizeof(float));
+  for (i = 0; i < 2048 * 512; ++i) {
+    a[i] = (float) (i % 19) * 0.0625f - 0.5f;
+  }
+  for (i = 0; i < n * n; ++i) {
+    b[i] = (float) (i % 23) * 0.125f - 1.0f;
+    c1[i] = c4[i] = (float) (i % 3);
+  }
+  mvla_threads_set(1);
+  gemmf(MVLA_NO_TRANS, MVLA_TRANS, n, n, n, 1.0f, a, n, b, n, 0.5f, c1, n);
+  gemvf(MVLA_NO_TRANS, 2045, 512, 1.0f, a, 2048, b, 0.0f, c1 + 3);
+  gemvf(MVLA_TRANS, 2045, 512, 1.0f, a, 2048, b, 2.0f, c1 + 2048);
+  mvla_threads_set(4);
+  gemmf(MVLA_NO_TRANS, MVLA_TRANS, n, n, n, 1.0f, a, n, b, n, 0.5f, c4, n);
+  gemvf(MVLA_NO_TRANS, 2045, 512, 1.0f, a, 2048, b, 0.0f, c4 + 3);
+  gemvf(MVLA_TRANS, 2045, 512, 1.0f, a, 2048, b, 2.0f, c4 + 2048);
+  mvla_threads_set(0);
+  ALWAYS_ASSERT(memcmp(c1, c4, n * n * sizeof(float)) == 0);
+  free(a);
+  free(b);
+  free(c1);
+  free(c4);
+}
+
+typedef struct mark_ctx {
+  unsigned char *marks;
+  size_t grain;
+  int misaligned;
+} mark_ctx_t;
+
+void mark_range(void *ctx, size_t begin, size_t end) {
+  mark_ctx_t *m = (mark_ctx_t *) ctx;
+  if (begin % m->grain != 0) {
+    m->misaligned = 1;
+  }
+  for (; begin < end; ++begin) {
+    ++m->marks[begin];
+  }
+}
+
+void nested_range(void *ctx, size_t begin, size_t end) {
+  mark_ctx_t *m = (mark_ctx_t *) ctx;
+  for (; begin < end; ++begin) {
+    mark_ctx_t inner = *m;
+    inner.marks = m->marks + begin * 100;
+    inner.grain = 7;
+    mvla_parallel_for(100, 7, mark_range, &inner);
+  }
+}
+
+void serial_executor(void *user, size_t count, mvla_task_fn_t task, void *ctx) {
+  size_t i;
+  ++*(int *) user;
+  for (i = count; i-- > 0;) {
+    task(ctx, i);
+  }
+}
+
+void test_threads(void) {
+  size_t n = 100000, i;
+  unsigned char *marks = (unsigned char *) calloc(n, 1);
+  float *x = (float *) malloc(n * sizeof(float));
+  float *y = (float *) malloc(n * sizeof(float));
+  mark_ctx_t m;
+  mvla_executor_t ex;
+  int calls = 0;
+  float dot, asum;
+  m.marks = marks;
+  m.grain = 1000;
+  m.misaligned = 0;
+
+  // every index once, ranges on grain boundaries, nested loops
+  mvla_threads_set(4);
+  mvla_parallel_for(n, 1000, mark_range, &m);
+  mvla_parallel_for(1000, 3, nested_range, &m);
+  for (i = 0; i < n; ++i) {
+    ALWAYS_ASSERT(marks[i] == 2);
+  }
+  ALWAYS_ASSERT(!m.misaligned);
+
+  // an executor gets one task per grain
+  ex.run = serial_executor;
+  ex.user = &calls;
+  mvla_executor_set(&ex);
+  mvla_parallel_for(n, 1000, mark_range, &m);
+  mvla_parallel_for(1000, 1000, mark_range, &m);
+  mvla_executor_set(NULL);
+  ALWAYS_ASSERT(calls == 1 && marks[0] == 4 && marks[n - 1] == 3 && !m.misaligned);
+
+  // reductions and maps give the same result for any thread count
+  for (i = 0; i < n; ++i) {
+    x[i] = (float) (i % 13) * 0.1f - 0.6f;
+    y[i] = (float) (i % 7) * 0.5f;
+  }
+  dot = dotf_n(x, y, n);
+  asum = asumf_n(x, n);
+  mvla_threads_set(1);
+  ALWAYS_ASSERT(dot == dotf_n(x, y, n) && asum == asumf_n(x, n));
+  mvla_threads_set(3);
+  v4f_mul_n((const v4f_t *) x, (const v4f_t *) y, (v4f_t *) x, n / 4);
+  for (i = 0; i < n; ++i) {
+    ALWAYS_ASSERT(x[i] == ((float) (i % 13) * 0.1f - 0.6f) * y[i]);
+  }
+  mvla_threads_set(0);
+
+  free(marks);
+  free(x);
+  free(y);
+}
+
+typedef struct counting {
+  int allocs, frees;
+} counting_t;
+
+void *counting_alloc(void *user, size_t size, size_t align) {
+  void *p = NULL;
+  ++((counting_t *) user)->allocs;
+  return posix_memalign(&p, align, size) == 0 ? p : NULL;
+}
+
+void counting_free(void *user, void *ptr) {
+  ++((counting_t *) user)->frees;
+  free(ptr);
+}
+
+void test_memory(void) {
+  counting_t count = { 0, 0 };
+  mvla_allocator_t counter = { counting_alloc, counting_free, &count };
+  mvla_arena_t arena = mvla_arena_alloc(1 << 16);
+  unsigned char buffer[256];
+  mvla_arena_t small = mvla_arena_wrap(buffer, sizeof(buffer));
+  mvla_vecf_t v, w;
+  v3f_soa_t soa;
+  size_t mark;
+  char *p, *q;
+
+  // blocks go back to the allocator that made them
+  mvla_allocator_set(&counter);
+  v = mvla_vecf_alloc(100);
+  soa = v3f_soa_alloc(10);
+  ALWAYS_ASSERT(count.allocs == 2 && ((size_t) v.data % MVLA_SOA_ALIGN) == 0);
+  mvla_allocator_set(NULL);
+  w = mvla_vecf_alloc(100);
+  mvla_vecf_free(&v);
+  v3f_soa_free(&soa);
+  mvla_vecf_free(&w);
+  ALWAYS_ASSERT(count.allocs == 2 && count.frees == 2);
+  ALWAYS_ASSERT(mvla_allocator_get().alloc != counting_alloc);
+
+  // mark and reset
+  ALWAYS_ASSERT(arena.base != NULL && arena.size == 1 << 16);
+  p = (char *) mvla_arena_push(&arena, 10, 1);
+  mark = mvla_arena_mark(&arena);
+  q = (char *) mvla_arena_push(&arena, 100, 64);
+  ALWAYS_ASSERT(p == (char *) arena.base && ((size_t) q % 64) == 0 && q >= p + 10);
+  mvla_arena_reset(&arena, mark);
+  ALWAYS_ASSERT(mvla_arena_mark(&arena) == 10 && mvla_arena_push(&arena, 100, 64) == q);
+  mvla_arena_reset(&arena, 0);
+  ALWAYS_ASSERT(mvla_arena_push(&arena, 1 << 16, 1) == arena.base);
+  ALWAYS_ASSERT(mvla_arena_push(&arena, 1, 1) == NULL);
+  mvla_arena_reset(&arena, 0);
+
+  // alignments that are not powers of two and sizes that would wrap are refused
+  ALWAYS_ASSERT(mvla_arena_push(&arena, 8, 0) == NULL && mvla_arena_push(&arena, 8, 24) == NULL);
+  ALWAYS_ASSERT(mvla_arena_push(&arena, (size_t) -1, 64) == NULL && mvla_arena_mark(&arena) == 0);
+  counter = mvla_allocator_get();
+  ALWAYS_ASSERT(counter.alloc(counter.user, 8, 24) == NULL && counter.alloc(counter.user, 8, 0) == NULL);
+  ALWAYS_ASSERT(counter.alloc(counter.user, (size_t) -1 - 8, 64) == NULL);
+
+  // an arena as the allocator, full arenas fail the allocation
+  counter = mvla_arena_allocator(&small);
+  mvla_allocator_set(&counter);
+  v = mvla_vecf_alloc(16);
+  w = mvla_vecf_alloc(64);
+  mvla_allocator_set(NULL);
+  ALWAYS_ASSERT(v.data != NULL && v.len == 16 && w.data == NULL && w.len == 0);
+  ALWAYS_ASSERT((unsigned char *) v.data > buffer && (unsigned char *) v.data < buffer + sizeof(buffer));
+  mvla_vecf_free(&v);
+  mvla_arena_reset(&small, 0);
+  ALWAYS_ASSERT(mvla_arena_mark(&small) == 0);
+
+  mvla_arena_free(&arena);
+  mvla_arena_free(&small);
+  ALWAYS_ASSERT(arena.base == NULL && small.base == NULL);
+}
+
+void test_pages(void) {
+  mvla_buffer_t big = mvla_buffer_alloc(MVLA_HUGE_PAGE_SIZE * 3 + 100, MVLA_PAGES_HUGE);
+  mvla_buffer_t small = mvla_buffer_alloc(MVLA_HUGE_PAGE_SIZE, MVLA_PAGES_SMALL);
+  mvla_buffer_t heap = mvla_buffer_alloc(1000, MVLA_PAGES_HEAP);
+  mvla_allocator_t pages = mvla_pages_allocator(MVLA_PAGES_TRANSPARENT);
+  mvla_vecf_t v, w;
+  unsigned char *p;
+
+  // whatever backing was granted, the buffer is whole and writable
+  ALWAYS_ASSERT(big.data != NULL && big.size == MVLA_HUGE_PAGE_SIZE * 3 + 100);
+  ALWAYS_ASSERT(small.data != NULL && small.pages <= MVLA_PAGES_SMALL);
+  ALWAYS_ASSERT(heap.data != NULL && heap.pages == MVLA_PAGES_HEAP && heap.mapped == 0);
+  ALWAYS_ASSERT(((size_t) heap.data % MVLA_SOA_ALIGN) == 0);
+  if (big.pages != MVLA_PAGES_HEAP) {
+    ALWAYS_ASSERT(((size_t) big.data % MVLA_HUGE_PAGE_SIZE) == 0 && big.mapped >= big.size);
+  }
+  p = (unsigned char *) big.data;
+  memset(p, 0xab, big.size);
+  ALWAYS_ASSERT(p[0] == 0xab && p[big.size - 1] == 0xab);
+  ALWAYS_ASSERT(mvla_buffer_huge_bytes(&big) <= big.size);
+  ALWAYS_ASSERT(mvla_buffer_huge_bytes(&heap) <= heap.size);
+  ALWAYS_ASSERT(strcmp(mvla_pages_name(MVLA_PAGES_TRANSPARENT), "transparent") == 0);
+  mvla_buffer_free(&big);
+  mvla_buffer_free(&small);
+  mvla_buffer_free(&heap);
+  ALWAYS_ASSERT(big.data == NULL && big.size == 0 && small.data == NULL && heap.data == NULL);
+
+  // large vectors come from mappings, small ones from the heap
+  mvla_allocator_set(&pages);
+  v = mvla_vecf_alloc(MVLA_HUGE_PAGE_SIZE);
+  w = mvla_vecf_alloc(10);
+  mvla_allocator_set(NULL);
+  ALWAYS_ASSERT(v.data != NULL && w.data != NULL && ((size_t) v.data % MVLA_SOA_ALIGN) == 0);
+  v.data[0] = 1.0f;
+  v.data[v.len - 1] = 2.0f;
+  w.data[9] = 3.0f;
+  ALWAYS_ASSERT(v.data[0] + v.data[v.len - 1] + w.data[9] == 6.0f);
+  mvla_vecf_free(&v);
+  mvla_vecf_free(&w);
+}
+
+void test_file(void) {
+  const char *path = "mvla_test_file.tmp";
+  v3f_t a[1000];
+  v4d_t d[37];
+  v3f_soa_t soa = v3f_soa_alloc(1000);
+  const void *components[3];
+  mvla_writer_t writer;
+  mvla_file_t file;
+  FILE *raw;
+  uint64_t wrap[3]; // count, stride and offset as they sit in the header
+  float *x, *z;
+  size_t i;
+  for (i = 0; i < 1000; ++i) {
+    a[i] = v3f(i + 0.5f, -(float) i, 3.0f * i);
+  }
+  for (i = 0; i < 37; ++i) {
+    d[i] = v4d(i, 1.0 / (i + 1), -2.0 * i, 0.25);
+  }
+  v3f_soa_from_aos(&soa, a);
+  ALWAYS_ASSERT(mvla_type_size(MVLA_TYPE_V3F) == sizeof(v3f_t));
+  ALWAYS_ASSERT(mvla_type_size(MVLA_TYPE_MAT4X4D) == sizeof(mat4x4d_t));
+  ALWAYS_ASSERT(mvla_type_components((mvla_type_t) 0x0503) == 0);
+
+  // AoS in uneven chunks, loaded zero-copy and verified
+  ALWAYS_ASSERT(mvla_writer_open(&writer, path, MVLA_TYPE_V3F, MVLA_LAYOUT_AOS, 0) == MVLA_FILE_OK);
+  ALWAYS_ASSERT(mvla_writer_write(&writer, a, 1) == MVLA_FILE_OK);
+  ALWAYS_ASSERT(mvla_writer_write(&writer, a + 1, 600) == MVLA_FILE_OK);
+  ALWAYS_ASSERT(mvla_writer_write(&writer, a + 601, 399) == MVLA_FILE_OK);
+  ALWAYS_ASSERT(mvla_writer_close(&writer) == MVLA_FILE_OK);
+  ALWAYS_ASSERT(mvla_file_open(&file, path, MVLA_FILE_VERIFY) == MVLA_FILE_OK);
+  ALWAYS_ASSERT(file.type == MVLA_TYPE_V3F && file.layout == MVLA_LAYOUT_AOS && file.count == 1000);
+  ALWAYS_ASSERT(((size_t) file.data % MVLA_SOA_ALIGN) == 0);
+  ALWAYS_ASSERT(memcmp(file.data, a, sizeof(a)) == 0);
+  ALWAYS_ASSERT(*(float *) mvla_file_component(&file, 2) == a[0].z);
+  ALWAYS_ASSERT(mvla_file_component(&file, 3) == NULL);
+  mvla_file_close(&file);
+  ALWAYS_ASSERT(file.data == NULL);
+
+  // SoA from whole elements and AoS from component arrays
+  ALWAYS_ASSERT(mvla_writer_open(&writer, path, MVLA_TYPE_V3F, MVLA_LAYOUT_SOA, 1000) == MVLA_FILE_OK);
+  ALWAYS_ASSERT(mvla_writer_write(&writer, a, 999) == MVLA_FILE_OK);
+  ALWAYS_ASSERT(mvla_writer_write(&writer, a + 999, 1) == MVLA_FILE_OK);
+  ALWAYS_ASSERT(mvla_writer_close(&writer) == MVLA_FILE_OK);
+  ALWAYS_ASSERT(mvla_file_open(&file, path, MVLA_FILE_VERIFY) == MVLA_FILE_OK);
+  x = (float *) mvla_file_component(&file, 0);
+  z = (float *) mvla_file_component(&file, 2);
+  ALWAYS_ASSERT(file.layout == MVLA_LAYOUT_SOA && ((size_t) z % MVLA_SOA_ALIGN) == 0);
+  ALWAYS_ASSERT(memcmp(x, soa.x, 1000 * sizeof(float)) == 0 && memcmp(z, soa.z, 1000 * sizeof(float)) == 0);
+  mvla_file_close(&file);
+  components[0] = soa.x;
+  components[1] = soa.y;
+  components[2] = soa.z;
+  ALWAYS_ASSERT(mvla_writer_open(&writer, path, MVLA_TYPE_V3F, MVLA_LAYOUT_AOS, 0) == MVLA_FILE_OK);
+  ALWAYS_ASSERT(mvla_writer_write_soa(&writer, components, 1000) == MVLA_FILE_OK);
+  ALWAYS_ASSERT(mvla_writer_close(&writer) == MVLA_FILE_OK);
+  ALWAYS_ASSERT(mvla_file_open(&file, path, MVLA_FILE_VERIFY) == MVLA_FILE_OK);
+  ALWAYS_ASSERT(memcmp(file.data, a, sizeof(a)) == 0);
+  mvla_file_close(&file);
+
+  // SoA writers need exactly the count they were opened with
+  ALWAYS_ASSERT(mvla_writer_open(&writer, path, MVLA_TYPE_V4D, MVLA_LAYOUT_SOA, 36) == MVLA_FILE_OK);
+  ALWAYS_ASSERT(mvla_writer_write(&writer, d, 37) == MVLA_FILE_ERR_ARG);
+  ALWAYS_ASSERT(mvla_writer_close(&writer) == MVLA_FILE_ERR_ARG);
+  ALWAYS_ASSERT(mvla_file_open(&file, path, 0) == MVLA_FILE_ERR_FORMAT);
+  ALWAYS_ASSERT(mvla_writer_open(&writer, path, MVLA_TYPE_V4D, MVLA_LAYOUT_AOS, 0) == MVLA_FILE_OK);
+  ALWAYS_ASSERT(mvla_writer_write(&writer, d, 37) == MVLA_FILE_OK);
+  ALWAYS_ASSERT(mvla_writer_close(&writer) == MVLA_FILE_OK);
+
+  // a flipped payload bit only shows when verifying
+  raw = fopen(path, "r+b");
+  ALWAYS_ASSERT(raw != NULL && fseek(raw, 4096 + 100, SEEK_SET) == 0 && fputc(0x55, raw) != EOF);
+  fclose(raw);
+  ALWAYS_ASSERT(mvla_file_open(&file, path, MVLA_FILE_VERIFY) == MVLA_FILE_ERR_CHECKSUM);
+  ALWAYS_ASSERT(mvla_file_open(&file, path, 0) == MVLA_FILE_OK);
+  ALWAYS_ASSERT(file.count == 37 && ((v4d_t *) file.data)[36].w == 0.25);
+  mvla_file_close(&file);
+
+  // an offset that wraps offset + size back inside the file is rejected
+  wrap[0] = 1024;
+  wrap[1] = 1024 * sizeof(v4d_t);
+  wrap[2] = (uint64_t) 0 - wrap[1];
+  raw = fopen(path, "r+b");
+  ALWAYS_ASSERT(raw != NULL && fseek(raw, 24, SEEK_SET) == 0 && fwrite(wrap, sizeof(wrap), 1, raw) == 1);
+  fclose(raw);
+  ALWAYS_ASSERT(mvla_file_open(&file, path, 0) == MVLA_FILE_ERR_FORMAT);
+  ALWAYS_ASSERT(mvla_file_open(&file, path, MVLA_FILE_VERIFY) == MVLA_FILE_ERR_FORMAT);
+  remove(path);
+  ALWAYS_ASSERT(mvla_file_open(&file, path, 0) == MVLA_FILE_ERR_IO);
+  ALWAYS_ASSERT(mvla_writer_open(&writer, path, (mvla_type_t) 7, MVLA_LAYOUT_AOS, 0) == MVLA_FILE_ERR_ARG);
+  ALWAYS_ASSERT(strcmp(mvla_file_status_name(MVLA_FILE_ERR_CHECKSUM), "checksum mismatch") == 0);
+  v3f_soa_free(&soa);
+}
+
+void test_text(void) {
+  static const char text[] = "1.5, -2, 3e2\n\n  4;5\t6.25\r\n0.1 1e-7 -0\n7,8\n9,9,9\n";
+  v3f_t a[4], back[3];
+  v2d_t d[3], dback[3];
+  v4i_t ints[2];
+  char buf[MVLA_FORMAT_MAX], dump[256];
+  size_t used, len;
+  FILE *file;
+
+  // shortest round trips, plain or with an exponent like Python's repr
+  ALWAYS_ASSERT(mvla_formatd(0.1, buf) == 3 && strcmp(buf, "0.1") == 0);
+  ALWAYS_ASSERT(mvla_formatf(0.1f, buf) == 3 && strcmp(buf, "0.1") == 0);
+  ALWAYS_ASSERT(mvla_formatd(1.0 / 3.0, buf) == 18 && strcmp(buf, "0.3333333333333333") == 0);
+  ALWAYS_ASSERT(mvla_formatf(1.0f / 3.0f, buf) > 0 && strcmp(buf, "0.33333334") == 0);
+  ALWAYS_ASSERT(mvla_formatd(1e16, buf) > 0 && strcmp(buf, "1e16") == 0);
+  ALWAYS_ASSERT(mvla_formatd(123456.0, buf) > 0 && strcmp(buf, "123456") == 0);
+  ALWAYS_ASSERT(mvla_formatd(-1.5e-7, buf) > 0 && strcmp(buf, "-1.5e-7") == 0);
+  ALWAYS_ASSERT(mvla_formatd(5e-324, buf) > 0 && strcmp(buf, "5e-324") == 0);
+  ALWAYS_ASSERT(mvla_formatd(DBL_MAX, buf) > 0 && strcmp(buf, "1.7976931348623157e308") == 0);
+  ALWAYS_ASSERT(mvla_formatf(FLT_MAX, buf) > 0 && strcmp(buf, "3.4028235e38") == 0);
+  ALWAYS_ASSERT(mvla_formatf(-0.0f, buf) == 2 && strcmp(buf, "-0") == 0);
+  ALWAYS_ASSERT(mvla_formatd(-INFINITY, buf) == 4 && strcmp(buf, "-inf") == 0);
+  ALWAYS_ASSERT(mvla_formatd(NAN, buf) == 3 && strcmp(buf, "nan") == 0);
+  ALWAYS_ASSERT(v3f_format(v3f(1.0f, -0.5f, 2.75f), buf) == 20 && strcmp(buf, "v3f_t(1, -0.5, 2.75)") == 0);
+  ALWAYS_ASSERT(v2i_format(v2i(-2147483647 - 1, 7), buf) > 0 && strcmp(buf, "v2i_t(-2147483648, 7)") == 0);
+
+  // mixed separators, blank lines and CRLF, stopping at the first bad line
+  ALWAYS_ASSERT(mvla_parse_n(MVLA_TYPE_V3F, text, sizeof(text) - 1, a, 4, &used) == 3);
+  ALWAYS_ASSERT(a[0].x == 1.5f && a[0].y == -2.0f && a[0].z == 300.0f);
+  ALWAYS_ASSERT(a[1].x == 4.0f && a[1].y == 5.0f && a[1].z == 6.25f);
+  ALWAYS_ASSERT(a[2].x == 0.1f && a[2].y == 1e-7f && a[2].z == 0.0f && signbit(a[2].z));
+  ALWAYS_ASSERT(strncmp(text + used, "7,8\n", 4) == 0);
+  ALWAYS_ASSERT(mvla_parse_n(MVLA_TYPE_V3F, text, sizeof(text) - 1, a, 1, &used) == 1);
+  ALWAYS_ASSERT(strncmp(text + used, "\n  4;5", 6) == 0);
+  ALWAYS_ASSERT(mvla_parse_n(MVLA_TYPE_V2F, "1 2x\n", 5, a, 1, &used) == 0 && used == 0);
+  ALWAYS_ASSERT(mvla_parse_n(MVLA_TYPE_V2F, "1 2", 3, a, 1, &used) == 1 && used == 3);
+  ALWAYS_ASSERT(mvla_parse_n(MVLA_TYPE_V4I, "1,-2,3,-2147483648\n4,5,6,2147483648\n", 35, ints, 2,
+                             &used) == 1);
+  ALWAYS_ASSERT(ints[0].y == -2 && ints[0].w == -2147483647 - 1 && used == 19);
+  ALWAYS_ASSERT(mvla_parse_n(MVLA_TYPE_V2U, "1,-1\n", 5, ints, 1, &used) == 0);
+
+  // long mantissas, far exponents and words go through strtod
+  ALWAYS_ASSERT(mvla_parse_n(MVLA_TYPE_V2D, "0.1000000000000000055511151231257827,1e300\n", 43, d, 1,
+                             &used) == 1);
+  ALWAYS_ASSERT(d[0].x == 0.1 && d[0].y == 1e300);
+  ALWAYS_ASSERT(mvla_parse_n(MVLA_TYPE_V2D, "inf -nan\n", 9, d, 1, &used) == 1);
+  ALWAYS_ASSERT(d[0].x == INFINITY && d[0].y != d[0].y);
+  ALWAYS_ASSERT(mvla_parse_n(MVLA_TYPE_F64, "9007199254740993\n", 17, d, 1, &used) == 1);
+  ALWAYS_ASSERT(d[0].x == 9007199254740992.0);
+
+  // format_n and parse_n are inverses
+  back[0] = v3f(1.0f / 3.0f, -1e-30f, 3e38f);
+  back[1] = v3f(0.0f, 1.0f, 16777217.0f);
+  back[2] = v3f(1e-45f, -2.5f, 100.0f);
+  ALWAYS_ASSERT(mvla_format_n(MVLA_TYPE_V3F, back, 3, dump, sizeof(dump), &len) == 3);
+  ALWAYS_ASSERT(mvla_parse_n(MVLA_TYPE_V3F, dump, len, a, 3, &used) == 3 && used == len);
+  ALWAYS_ASSERT(memcmp(a, back, sizeof(back)) == 0);
+  ALWAYS_ASSERT(mvla_format_n(MVLA_TYPE_V3F, back, 3, dump, 20, &len) == 0 && len == 0);
+  d[0] = v2d(0.1, 1e-300);
+  d[1] = v2d(-123456789.123456789, 2.0 / 3.0);
+  d[2] = v2d(DBL_MIN, 4.35);
+  ALWAYS_ASSERT(mvla_format_n(MVLA_TYPE_V2D, d, 3, dump, sizeof(dump), &len) == 3);
+  ALWAYS_ASSERT(mvla_parse_n(MVLA_TYPE_V2D, dump, len, dback, 3, &used) == 3 && used == len);
+  ALWAYS_ASSERT(memcmp(d, dback, sizeof(d)) == 0);
+  ALWAYS_ASSERT(mvla_dump_n((mvla_type_t) 0, d, 3, stdout) == MVLA_FILE_ERR_ARG);
+
+  // dumps read back like format_n output
+  file = tmpfile();
+  ALWAYS_ASSERT(file != NULL && mvla_dump_n(MVLA_TYPE_V2D, d, 3, file) == MVLA_FILE_OK);
+  rewind(file);
+  len = fread(dump, 1, sizeof(dump), file);
+  fclose(file);
+  ALWAYS_ASSERT(mvla_parse_n(MVLA_TYPE_V2D, dump, len, dback, 3, &used) == 3 && used == len);
+  ALWAYS_ASSERT(memcmp(d, dback, sizeof(d)) == 0);
+}
+
+void test_batch(void) {
+  test_batch_v3f();
+  test_batch_geom();
+  test_batch_blas();
+  test_batch_xform();
+  test_batch_v4d();
+  test_batch_int();
+}
+
+void test_soa_v3f(void) {
+  v3f_soa_t a = v3f_soa_alloc(13);
+  v3f_soa_t b = v3f_soa_alloc(13);
+  v3f_soa_t out = v3f_soa_alloc(13);
+  float lens[13];
+  size_t i;
+  ALWAYS_ASSERT(a.x != NULL && a.count == 13);
+  ALWAYS_ASSERT(((size_t) a.x % MVLA_SOA_ALIGN) == 0);
+  ALWAYS_ASSERT(((size_t) a.y % MVLA_SOA_ALIGN) == 0);
+  ALWAYS_ASSERT(((size_t) a.z % MVLA_SOA_ALIGN) == 0);
+  for (i = 0; i < 13; ++i) {
+    v3f_soa_set(&a, i, v3f(i + 1.0f, 2.0f * i, -0.5f * i));
+    v3f_soa_set(&b, i, v3f(0.5f, i + 1.0f, 3.0f));
+  }
+
+  // v3f_soa_get
+  v3f_t g = v3f_soa_get(&a, 4);
+  ALWAYS_ASSERT(g.x == 5.0f && g.y == 8.0f && g.z == -2.0f);
+
+  // v3f_soa_add
+  v3f_soa_add(&a, &b, &out);
+  for (i = 0; i < 13; ++i) {
+    v3f_t e = v3f_add(v3f_soa_get(&a, i), v3f_soa_get(&b, i));
+    v3f_t r = v3f_soa_get(&out, i);
+    ALWAYS_ASSERT(r.x == e.x && r.y == e.y && r.z == e.z);
+  }
+
+  // v3f_soa_max
+  v3f_soa_max(&a, &b, &out);
+  for (i = 0; i < 13; ++i) {
+    v3f_t e = v3f_max(v3f_soa_get(&a, i), v3f_soa_get(&b, i));
+    v3f_t r = v3f_soa_get(&out, i);
+    ALWAYS_ASSERT(r.x == e.x && r.y == e.y && r.z == e.z);
+  }
+
+  // v3f_soa_cos
+  v3f_soa_cos(&a, &out);
+  for (i = 0; i < 13; ++i) {
+    v3f_t e = v3f_cos(v3f_soa_get(&a, i));
+    v3f_t r = v3f_soa_get(&out, i);
+    ALWAYS_ASSERT(r.x == e.x && r.y == e.y && r.z == e.z);
+  }
+
+  // v3f_soa_sincos
+  v3f_soa_sincos(&a, &b, &out);
+  for (i = 0; i < 13; ++i) {
+    v3f_t es, ec;
+    v3f_t rs = v3f_soa_get(&b, i), rc = v3f_soa_get(&out, i);
+    v3f_sincos(v3f_soa_get(&a, i), &es, &ec);
+    ALWAYS_ASSERT(approxf(rs.x, es.x) && approxf(rs.y, es.y) && approxf(rs.z, es.z));
+    ALWAYS_ASSERT(approxf(rc.x, ec.x) && approxf(rc.y, ec.y) && approxf(rc.z, ec.z));
+  }
+
+  // v3f_soa_len
+  v3f_soa_len(&a, lens);
+  for (i = 0; i < 13; ++i) {
+    ALWAYS_ASSERT(lens[i] == v3f_len(v3f_soa_get(&a, i)));
+  }
+
+  // v3f_soa_dot, v3f_soa_cross, v3f_soa_normalize (b holds the sines from above)
+  v3f_soa_dot(&a, &b, lens);
+  v3f_soa_cross(&a, &b, &out);
+  for (i = 0; i < 13; ++i) {
+    v3f_t e = v3f_cross(v3f_soa_get(&a, i), v3f_soa_get(&b, i));
+    v3f_t r = v3f_soa_get(&out, i);
+    ALWAYS_ASSERT(approxf(lens[i], v3f_dot(v3f_soa_get(&a, i), v3f_soa_get(&b, i))));
+    ALWAYS_ASSERT(approxf(r.x, e.x) && approxf(r.y, e.y) && approxf(r.z, e.z));
+  }
+  v3f_soa_normalize(&a, &out);
+  for (i = 0; i < 13; ++i) {
+    v3f_t e = v3f_normalize(v3f_soa_get(&a, i));
+    v3f_t r = v3f_soa_get(&out, i);
+    ALWAYS_ASSERT(approxf(r.x, e.x) && approxf(r.y, e.y) && approxf(r.z, e.z));
+  }
+
+  v3f_soa_free(&a);
+  v3f_soa_free(&b);
+  v3f_soa_free(&out);
+  ALWAYS_ASSERT(a.x == NULL && a.count == 0);
+}
+
+void test_soa_v4d(void) {
+  v4d_soa_t a = v4d_soa_alloc(6);
+  double lens[6];
+  size_t i;
+  for (i = 0; i < 6; ++i) {
+    v4d_soa_set(&a, i, v4d(i, 1.0 - i, 0.5 * i, 2.0));
+  }
+
+  // v4d_soa_sqr_len
+  v4d_soa_sqr_len(&a, lens);
+  for (i = 0; i < 6; ++i) {
+    ALWAYS_ASSERT(lens[i] == v4d_sqr_len(v4d_soa_get(&a, i)));
+  }
+
+  // v4d_soa_sqrt in place
+  v4d_soa_sqrt(&a, &a);
+  ALWAYS_ASSERT(approxd(v4d_soa_get(&a, 4).x, 2.0));
+  ALWAYS_ASSERT(approxd(v4d_soa_get(&a, 0).w, sqrt(2.0)));
+
+  v4d_soa_free(&a);
+}
+
+void test_soa_int(void) {
+  v2u_soa_t a = v2u_soa_alloc(9);
+  size_t i;
+  for (i = 0; i < 9; ++i) {
+    v2u_soa_set(&a, i, v2u(i, 9 - i));
+  }
+
+  // v2u_soa_min
+  v2u_soa_min(&a, &a, &a);
+  ALWAYS_ASSERT(v2u_soa_get(&a, 3).x == 3 && v2u_soa_get(&a, 3).y == 6);
+
+  // v2u_soa_mul
+  v2u_soa_mul(&a, &a, &a);
+  for (i = 0; i < 9; ++i) {
+    ALWAYS_ASSERT(a.x[i] == i * i && a.y[i] == (9 - i) * (9 - i));
+  }
+
+  v2u_soa_free(&a);
+}
+
+void test_soa(void) {
+  test_soa_v3f();
+  test_soa_v4d();
+  test_soa_int();
+}
+
+void test_layout_v3f(void) {
+  v3f_t a[11], back[11];
+  v4f_t padded[11];
+  v3f_soa_t soa = v3f_soa_alloc(11);
+  size_t i;
+  for (i = 0; i < 11; ++i) {
+    a[i] = v3f(i + 0.25f, -(float) i, 100.0f + i);
+  }
+
+  // v3f_soa_from_aos
+  v3f_soa_from_aos(&soa, a);
+  for (i = 0; i < 11; ++i) {
+    ALWAYS_ASSERT(soa.x[i] == a[i].x && soa.y[i] == a[i].y && soa.z[i] == a[i].z);
+  }
+
+  // v3f_soa_to_aos
+  v3f_soa_to_aos(&soa, back);
+  for (i = 0; i < 11; ++i) {
+    ALWAYS_ASSERT(back[i].x == a[i].x && back[i].y == a[i].y && back[i].z == a[i].z);
+  }
+
+  // v3f_pad_n
+  v3f_pad_n(a, 1.0f, padded, 11);
+  for (i = 0; i < 11; ++i) {
+    ALWAYS_ASSERT(padded[i].x == a[i].x && padded[i].y == a[i].y);
+    ALWAYS_ASSERT(padded[i].z == a[i].z && padded[i].w == 1.0f);
+  }
+
+  // v4f_unpad_n
+  v4f_unpad_n(padded, back, 11);
+  for (i = 0; i < 11; ++i) {
+    ALWAYS_ASSERT(back[i].x == a[i].x && back[i].y == a[i].y && back[i].z == a[i].z);
+  }
+
+  v3f_soa_free(&soa);
+}
+
+void test_layout_int(void) {
+  v4i_t a[6], back[6];
+  v2u_t b[9], bback[9];
+  v3i_t c[5];
+  v4i_t cpad[5];
+  v4i_soa_t soa = v4i_soa_alloc(6);
+  v2u_soa_t usoa = v2u_soa_alloc(9);
+  size_t i;
+  for (i = 0; i < 6; ++i) {
+    // bit patterns that would be NaNs as floats must survive the shuffles
+    a[i] = v4i(-1, (int) i, 0x7fc00001, -2147483647 + (int) i);
+  }
+  for (i = 0; i < 9; ++i) {
+    b[i] = v2u(0xffffffffu - i, i);
+  }
+  for (i = 0; i < 5; ++i) {
+    c[i] = v3i((int) i, -(int) i, 0x7f800001);
+  }
+
+  // v4i_soa_from_aos / v4i_soa_to_aos
+  v4i_soa_from_aos(&soa, a);
+  ALWAYS_ASSERT(soa.z[5] == 0x7fc00001 && soa.w[5] == -2147483642);
+  v4i_soa_to_aos(&soa, back);
+  for (i = 0; i < 6; ++i) {
+    ALWAYS_ASSERT(back[i].x == a[i].x && back[i].y == a[i].y);
+    ALWAYS_ASSERT(back[i].z == a[i].z && back[i].w == a[i].w);
+  }
+
+  // v2u_soa_from_aos / v2u_soa_to_aos
+  v2u_soa_from_aos(&usoa, b);
+  ALWAYS_ASSERT(usoa.x[8] == 0xffffffffu - 8 && usoa.y[8] == 8);
+  v2u_soa_to_aos(&usoa, bback);
+  for (i = 0; i < 9; ++i) {
+    ALWAYS_ASSERT(bback[i].x == b[i].x && bback[i].y == b[i].y);
+  }
+
+  // v3i_pad_n
+  v3i_pad_n(c, -7, cpad, 5);
+  for (i = 0; i < 5; ++i) {
+    ALWAYS_ASSERT(cpad[i].x == c[i].x && cpad[i].y == c[i].y);
+    ALWAYS_ASSERT(cpad[i].z == 0x7f800001 && cpad[i].w == -7);
+  }
+
+  v4i_soa_free(&soa);
+  v2u_soa_free(&usoa);
+}
+
+void test_layout_d(void) {
+  v3d_t a[5], back[5];
+  v4d_t padded[5], b[3], bback[3];
+  v3d_soa_t soa = v3d_soa_alloc(5);
+  v4d_soa_t soa4 = v4d_soa_alloc(3);
+  size_t i;
+  for (i = 0; i < 5; ++i) {
+    a[i] = v3d(i * 1.5, -2.0 * i, i + 0.125);
+  }
+  for (i = 0; i < 3; ++i) {
+    b[i] = v4d(i, i + 1.0, i + 2.0, i + 3.0);
+  }
+
+  // v3d_soa_from_aos / v3d_soa_to_aos
+  v3d_soa_from_aos(&soa, a);
+  ALWAYS_ASSERT(soa.x[3] == 4.5 && soa.y[4] == -8.0 && soa.z[2] == 2.125);
+  v3d_soa_to_aos(&soa, back);
+  for (i = 0; i < 5; ++i) {
+    ALWAYS_ASSERT(back[i].x == a[i].x && back[i].y == a[i].y && back[i].z == a[i].z);
+  }
+
+  // v4d_soa_from_aos / v4d_soa_to_aos
+  v4d_soa_from_aos(&soa4, b);
+  ALWAYS_ASSERT(soa4.w[2] == 5.0 && soa4.x[1] == 1.0);
+  v4d_soa_to_aos(&soa4, bback);
+  for (i = 0; i < 3; ++i) {
+    ALWAYS_ASSERT(bback[i].x == b[i].x && bback[i].y == b[i].y);
+    ALWAYS_ASSERT(bback[i].z == b[i].z && bback[i].w == b[i].w);
+  }
+
+  // v3d_pad_n / v4d_unpad_n
+  v3d_pad_n(a, 0.0, padded, 5);
+  ALWAYS_ASSERT(padded[3].z == a[3].z && padded[3].w == 0.0);
+  v4d_unpad_n(padded, back, 5);
+  for (i = 0; i < 5; ++i) {
+    ALWAYS_ASSERT(back[i].x == a[i].x && back[i].y == a[i].y && back[i].z == a[i].z);
+  }
+
+  v3d_soa_free(&soa);
+  v4d_soa_free(&soa4);
+}
+
+void test_layout(void) {
+  test_layout_v3f();
+  test_layout_int();
+  test_layout_d();
+}
+
+void test_fast_math(void) {
+  v3f_t a[11], out[11];
+  v4d_t d[5], dout[5];
+  size_t i;
+  int k;
+
+  // sampled error against libm, loose relative bounds over the documented ulps
+  for (k = -400; k <= 400; ++k) {
+    float x = k * 0.2137f;
+    double y = k * 1.713;
+    ALWAYS_ASSERT(fabs(expf_fast(x) - exp(x)) <= 3e-7 * exp(x));
+    ALWAYS_ASSERT(fabs(sinf_fast(x * 9.0f) - sin(x * 9.0f)) <= 3e-7);
+    ALWAYS_ASSERT(fabs(cosf_fast(x) - cos(x)) <= 3e-7);
+    ALWAYS_ASSERT(fabs(logf_fast(fabsf(x) + 0.01f) - log(fabsf(x) + 0.01f)) <= 3e-7 * fabs(log(fabsf(x) + 0.01f)) + 1e-9);
+    ALWAYS_ASSERT(fabs(rsqrtf_fast(fabsf(x) + 1.0f) - 1.0 / sqrt(fabsf(x) + 1.0f)) <= 4e-7 / sqrt(fabsf(x) + 1.0f));
+    ALWAYS_ASSERT(fabs(expd_fast(y) - exp(y)) <= 3e-16 * exp(y));
+    ALWAYS_ASSERT(fabs(sind_fast(y * 50.0) - sin(y * 50.0)) <= 1e-15);
+    ALWAYS_ASSERT(fabs(logd_fast(fabs(y) + 0.5) - log(fabs(y) + 0.5)) <= 3e-16 * fabs(log(fabs(y) + 0.5)) + 1e-18);
+    ALWAYS_ASSERT(fabs(powd_fast(fabs(y) + 0.5, 1.5) - pow(fabs(y) + 0.5, 1.5)) <= 1e-14 * pow(fabs(y) + 0.5, 1.5));
+  }
+  ALWAYS_ASSERT(powf_fast(2.0f, 10.0f) == 1024.0f);
+
+  // out of domain inputs behave like libm
+  ALWAYS_ASSERT(isnan(expf_fast(NAN)) && expf_fast(INFINITY) == INFINITY && expf_fast(-INFINITY) == 0.0f);
+  ALWAYS_ASSERT(expf_fast(100.0f) == INFINITY && expd_fast(-800.0) == 0.0);
+  ALWAYS_ASSERT(logf_fast(0.0f) == -INFINITY && isnan(logf_fast(-1.0f)) && isnan(logd_fast(-1.0)));
+  ALWAYS_ASSERT(sinf_fast(1e10f) == sinf(1e10f) && cosd_fast(1e300) == cos(1e300));
+  ALWAYS_ASSERT(sqrtf_fast(0.0f) == 0.0f && rsqrtf_fast(0.0f) == INFINITY);
+  ALWAYS_ASSERT(powf_fast(-2.0f, 3.0f) == -8.0f && powd_fast(0.0, 2.0) == 0.0);
+
+  // batch forms agree with the scalar forms within the bounds
+  for (i = 0; i < 11; ++i) {
+    a[i] = v3f(i * 0.7f - 3.0f, i * 0.91f, -(float) i * 0.03f);
+  }
+  v3f_sin_fast_n(a, out, 11);
+  for (i = 0; i < 11; ++i) {
+    v3f_t e = v3f_sin_fast(a[i]);
+    ALWAYS_ASSERT(approxf(out[i].x, e.x) && approxf(out[i].y, e.y) && approxf(out[i].z, e.z));
+  }
+  v3f_pow_fast_n(a, a, out, 11);
+  for (i = 0; i < 11; ++i) {
+    v3f_t e = v3f_pow(a[i], a[i]);
+    ALWAYS_ASSERT((isnan(out[i].x) && isnan(e.x)) || fabsf(out[i].x - e.x) <= 1e-6f * fabsf(e.x));
+    ALWAYS_ASSERT(fabsf(out[i].y - e.y) <= 1e-6f * fabsf(e.y));
+  }
+  for (i = 0; i < 5; ++i) {
+    d[i] = v4d(i * 0.3 + 0.1, 1.0 + i, 2.0 * i + 0.5, 0.5);
+  }
+  v4d_log_fast_n(d, dout, 5);
+  for (i = 0; i < 5; ++i) {
+    ALWAYS_ASSERT(approxd(dout[i].x, log(d[i].x)) && approxd(dout[i].w, log(0.5)));
+  }
+  v3f_sincos_fast_n(a, out, a, 11);
+  for (i = 0; i < 11; ++i) {
+    float fs, fc;
+    float x = i * 0.7f - 3.0f;
+    sincosf_fast(x, &fs, &fc);
+    ALWAYS_ASSERT(fs == sinf_fast(x) && fc == cosf_fast(x));
+    ALWAYS_ASSERT(approxf(out[i].x, fs) && approxf(a[i].x, fc));
+    ALWAYS_ASSERT(approxf(out[i].y, sinf(i * 0.91f)) && approxf(a[i].y, cosf(i * 0.91f)));
+  }
+  v4d_tan_fast_n(d, dout, 5);
+  for (i = 0; i < 5; ++i) {
+    ALWAYS_ASSERT(approxd(dout[i].y, tan(d[i].y)) && approxd(dout[i].z, tan(d[i].z)));
+  }
+  v4d_sincos_fast_n(d, dout, d, 5);
+  for (i = 0; i < 5; ++i) {
+    ALWAYS_ASSERT(approxd(dout[i].y, sin(1.0 + i)) && approxd(d[i].y, cos(1.0 + i)));
+    ALWAYS_ASSERT(approxd(dout[i].w, sin(0.5)) && approxd(d[i].w, cos(0.5)));
+  }
+}
+
+void test_rng(void) {
+  mvla_rng_t rng = mvla_rng(42), other;
+  float sumf = 0.0f;
+  double sumd = 0.0;
+  int k;
+
+  // mvla_rng_next against the xoshiro256++ reference seeded with splitmix64
+  ALWAYS_ASSERT(mvla_rng_next(&rng) == UINT64_C(0xd0764d4f4476689f));
+  ALWAYS_ASSERT(mvla_rng_next(&rng) == UINT64_C(0x519e4174576f3791));
+  ALWAYS_ASSERT(mvla_rng_next(&rng) == UINT64_C(0xfbe07cfb0c24ed8c));
+
+  // mvla_rng_jump / mvla_rng_long_jump
+  rng = mvla_rng(42);
+  mvla_rng_jump(&rng);
+  ALWAYS_ASSERT(mvla_rng_next(&rng) == UINT64_C(0xc0b6f4be293b1ae5));
+  rng = mvla_rng(42);
+  mvla_rng_long_jump(&rng);
+  ALWAYS_ASSERT(mvla_rng_next(&rng) == UINT64_C(0x2019a87bfc0bb07));
+
+  // mvla_rng_randf / mvla_rng_randd stay in [0, 1)
+  rng = mvla_rng(7);
+  for (k = 0; k < 10000; ++k) {
+    float f = mvla_rng_randf(&rng);
+    double d = mvla_rng_randd(&rng);
+    ALWAYS_ASSERT(f >= 0.0f && f < 1.0f && d >= 0.0 && d < 1.0);
+    sumf += f;
+    sumd += d;
+  }
+  ALWAYS_ASSERT(fabsf(sumf / 10000.0f - 0.5f) < 0.02f && fabs(sumd / 10000.0 - 0.5) < 0.02);
+
+  // v3f_rand / v4d_rand draw components in order
+  rng = mvla_rng(9);
+  other = rng;
+  v3f_t r3 = v3f_rand(&rng);
+  ALWAYS_ASSERT(r3.x == mvla_rng_randf(&other) && r3.y == mvla_rng_randf(&other) && r3.z == mvla_rng_randf(&other));
+  v4d_t r4 = v4d_rand(&rng);
+  ALWAYS_ASSERT(r4.x == mvla_rng_randd(&other) && r4.y == mvla_rng_randd(&other));
+  ALWAYS_ASSERT(r4.z == mvla_rng_randd(&other) && r4.w == mvla_rng_randd(&other));
+
+  // mvla_srand makes randf / randd reproducible
+  mvla_srand(123);
+  sumf = randf();
+  sumd = randd();
+  mvla_srand(123);
+  ALWAYS_ASSERT(randf() == sumf && randd() == sumd);
+  rng = mvla_rng(123);
+  ALWAYS_ASSERT(mvla_rng_randf(&rng) == sumf);
+}
+
+void test_rng_batch(void) {
+  mvla_rng_t rng = mvla_rng(5), g;
+  mvla_rng_lanes_t lanes = mvla_rng_lanes(&rng), start = lanes;
+  v3f_t lo = v3f(-1.0f, 2.0f, 0.0f), hi = v3f(1.0f, 3.0f, 10.0f);
+  v3f_t box[37], sph[37];
+  v4f_t gauss[21];
+  v2f_t disk[19];
+  v3f_soa_t soa = v3f_soa_alloc(37);
+  float u[29], mean = 0.0f, var = 0.0f;
+  size_t i;
+  int l;
+
+  // mvla_rng_lanes starts lane l after l jumps and leaves rng past the last lane
+  g = mvla_rng(5);
+  for (l = 0; l < MVLA_RNG_LANES; ++l) {
+    mvla_rng_t e = mvla_rng_lane(&lanes, l);
+    ALWAYS_ASSERT(memcmp(&e, &g, sizeof(g)) == 0);
+    mvla_rng_jump(&g);
+  }
+  ALWAYS_ASSERT(memcmp(&rng, &g, sizeof(g)) == 0);
+
+  // mvla_rng_fill draws element i from lane i % MVLA_RNG_LANES
+  mvla_rng_fill(&lanes, u, 29);
+  for (l = 0; l < MVLA_RNG_LANES; ++l) {
+    g = mvla_rng_lane(&start, l);
+    for (i = l; i < 29; i += MVLA_RNG_LANES) {
+      ALWAYS_ASSERT(u[i] == mvla_rng_randf(&g));
+    }
+    mvla_rng_t e = mvla_rng_lane(&lanes, l);
+    ALWAYS_ASSERT(memcmp(&e, &g, sizeof(g)) == 0);
+  }
+
+  // v3f_rand_box_n / v3f_rand_sphere_n replayed with the scalar samplers
+  start = lanes;
+  v3f_rand_box_n(&lanes, lo, hi, box, 37);
+  v3f_rand_sphere_n(&lanes, sph, 37);
+  for (l = 0; l < MVLA_RNG_LANES; ++l) {
+    g = mvla_rng_lane(&start, l);
+    for (i = l; i < 37; i += MVLA_RNG_LANES) {
+      v3f_t e = v3f_rand_box(&g, lo, hi);
+      ALWAYS_ASSERT(approxf(box[i].x, e.x) && approxf(box[i].y, e.y) && approxf(box[i].z, e.z));
+      ALWAYS_ASSERT(box[i].x >= -1.0f && box[i].x < 1.0f && box[i].z >= 0.0f && box[i].z < 10.0f);
+    }
+    for (i = l; i < 37; i += MVLA_RNG_LANES) {
+      v3f_t e = v3f_rand_sphere(&g);
+      ALWAYS_ASSERT(approxf(sph[i].x, e.x) && approxf(sph[i].y, e.y) && approxf(sph[i].z, e.z));
+      ALWAYS_ASSERT(fabsf(v3f_len(sph[i]) - 1.0f) < 1e-5f);
+    }
+  }
+
+  // v3f_soa_rand_box matches the AoS form
+  lanes = start;
+  v3f_soa_rand_box(&lanes, lo, hi, &soa);
+  for (i = 0; i < 37; ++i) {
+    v3f_t r = v3f_soa_get(&soa, i);
+    ALWAYS_ASSERT(r.x == box[i].x && r.y == box[i].y && r.z == box[i].z);
+  }
+
+  // v2f_rand_disk_n stays in the unit disk
+  v2f_rand_disk_n(&lanes, disk, 19);
+  for (i = 0; i < 19; ++i) {
+    ALWAYS_ASSERT(v2f_len(disk[i]) <= 1.0f + 1e-6f);
+  }
+
+  // v4f_rand_gauss_n replayed, and roughly standard normal
+  start = lanes;
+  v4f_rand_gauss_n(&lanes, gauss, 21);
+  for (l = 0; l < MVLA_RNG_LANES; ++l) {
+    g = mvla_rng_lane(&start, l);
+    for (i = l; i < 21; i += MVLA_RNG_LANES) {
+      v4f_t e = v4f_rand_gauss(&g);
+      ALWAYS_ASSERT(approxf(gauss[i].x, e.x) && approxf(gauss[i].y, e.y));
+      ALWAYS_ASSERT(approxf(gauss[i].z, e.z) && approxf(gauss[i].w, e.w));
+    }
+  }
+  for (l = 0; l < 100; ++l) {
+    v4f_rand_gauss_n(&lanes, gauss, 21);
+    for (i = 0; i < 21; ++i) {
+      mean += gauss[i].x + gauss[i].y + gauss[i].z + gauss[i].w;
+      var += gauss[i].x * gauss[i].x + gauss[i].y * gauss[i].y + gauss[i].z * gauss[i].z + gauss[i].w * gauss[i].w;
+    }
+  }
+  ALWAYS_ASSERT(fabsf(mean / 8400.0f) < 0.05f && fabsf(var / 8400.0f - 1.0f) < 0.05f);
+
+  v3f_soa_free(&soa);
+}
+
+void test_philox(void) {
+  const uint64_t seed = UINT64_C(0x123456789abcdef0);
+  v4u_t blocks[37];
+  v4f_t fblocks[37];
+  float all[151], part[151];
+  size_t i, cut;
+
+  // Random123 known answers, key (seed lo, seed hi), counter (index lo, index hi, stream lo, stream hi)
+  v4u_t r = mvla_philox(0, 0, 0);
+  ALWAYS_ASSERT(r.x == 0x6627e8d5u && r.y == 0xe169c58du && r.z == 0xbc57ac4cu && r.w == 0x9b00dbd8u);
+  r = mvla_philox(UINT64_MAX, UINT64_MAX, UINT64_MAX);
+  ALWAYS_ASSERT(r.x == 0x408f276du && r.y == 0x41c83b0eu && r.z == 0xa20bc7c6u && r.w == 0x6d5451fdu);
+  r = mvla_philox(UINT64_C(0x299f31d0a4093822), UINT64_C(0x0370734413198a2e), UINT64_C(0x85a308d3243f6a88));
+  ALWAYS_ASSERT(r.x == 0xd16cfe09u && r.y == 0x94fdccebu && r.z == 0x5001e420u && r.w == 0x24126ea1u);
+  r = mvla_philox(seed, 7, (UINT64_C(1) << 32) + 5);
+  ALWAYS_ASSERT(r.x == 0x1da7f4abu && r.y == 0xb1c6cdd0u && r.z == 0x42cf3c32u && r.w == 0x46a15800u);
+
+  // batch blocks match the scalar ones, across the 32-bit index carry
+  mvla_philox_v4u_n(seed, 7, UINT64_C(0xfffffff0), blocks, 37);
+  mvla_philox_v4f_n(seed, 7, UINT64_C(0xfffffff0), fblocks, 37);
+  for (i = 0; i < 37; ++i) {
+    v4u_t e = mvla_philox(seed, 7, UINT64_C(0xfffffff0) + i);
+    v4f_t f = mvla_philox_v4f(seed, 7, UINT64_C(0xfffffff0) + i);
+    ALWAYS_ASSERT(blocks[i].x == e.x && blocks[i].y == e.y && blocks[i].z == e.z && blocks[i].w == e.w);
+    ALWAYS_ASSERT(fblocks[i].x == f.x && fblocks[i].y == f.y && fblocks[i].z == f.z && fblocks[i].w == f.w);
+    ALWAYS_ASSERT(f.x >= 0.0f && f.x < 1.0f && f.w >= 0.0f && f.w < 1.0f);
+  }
+
+  // mvla_philox_fill is bit-identical however the range is split
+  mvla_philox_fill(seed, 3, 2, all, 151);
+  for (i = 0; i < 151; ++i) {
+    v4f_t f = mvla_philox_v4f(seed, 3, (i + 2) / 4);
+    ALWAYS_ASSERT(all[i] == ((const float *) &f)[(i + 2) % 4]);
+  }
+  for (cut = 0; cut <= 151; cut += 13) {
+    mvla_philox_fill(seed, 3, 2, part, cut);
+    mvla_philox_fill(seed, 3, 2 + cut, part + cut, 151 - cut);
+    ALWAYS_ASSERT(memcmp(all, part, sizeof(all)) == 0);
+  }
+
+  // streams are independent of each other
+  r = mvla_philox(seed, 8, (UINT64_C(1) << 32) + 5);
+  ALWAYS_ASSERT(r.x != 0x1da7f4abu);
+}
+
+void test_qrng(void) {
+  const mvla_scramble_t scrambles[3] = {MVLA_SCRAMBLE_NONE, MVLA_SCRAMBLE_OWEN, MVLA_SCRAMBLE_SHIFT};
+  v4f_t all[64], part[64];
+  v2f_t pts[27];
+  v3f_t p;
+  int s, i, cut, seen[27];
+
+  // unscrambled reference points
+  p = v3f_sobol(MVLA_SCRAMBLE_NONE, 0, 5);
+  ALWAYS_ASSERT(p.x == 0.625f && p.y == 0.125f && p.z == 0.875f);
+  p = v3f_halton(MVLA_SCRAMBLE_NONE, 0, 7);
+  ALWAYS_ASSERT(p.x == 0.875f && approxf(p.y, 5.0f / 9.0f) && approxf(p.z, 0.44f));
+  ALWAYS_ASSERT(v2f_r2(MVLA_SCRAMBLE_NONE, 0, 0).x == 0.5f);
+  p = v3f_r3(MVLA_SCRAMBLE_NONE, 0, 3);
+  ALWAYS_ASSERT(approxf(p.x, fmodf(0.5f + 3.0f / 1.2207440846f, 1.0f)));
+
+  // batches equal the scalar points and any split of the range, for every sequence and scramble
+  for (s = 0; s < 3; ++s) {
+    v4f_sobol_n(scrambles[s], 9, 1000, all, 64);
+    for (cut = 0; cut <= 64; cut += 7) {
+      v4f_sobol_n(scrambles[s], 9, 1000, part, cut);
+      v4f_sobol_n(scrambles[s], 9, 1000 + cut, part + cut, 64 - cut);
+      ALWAYS_ASSERT(memcmp(all, part, sizeof(all)) == 0);
+    }
+    for (i = 0; i < 64; ++i) {
+      v4f_t e = v4f_sobol(scrambles[s], 9, 1000 + i);
+      ALWAYS_ASSERT(memcmp(&all[i], &e, sizeof(e)) == 0);
+      ALWAYS_ASSERT(e.x >= 0.0f && e.x < 1.0f && e.w >= 0.0f && e.w < 1.0f);
+    }
+    v4f_halton_n(scrambles[s], 9, 1000, all, 64);
+    v4f_halton_n(scrambles[s], 9, 1000, part, 30);
+    v4f_halton_n(scrambles[s], 9, 1030, part + 30, 34);
+    ALWAYS_ASSERT(memcmp(all, part, sizeof(all)) == 0);
+    v4f_r4_n(scrambles[s], 9, UINT64_C(1) << 40, all, 64);
+    v4f_r4_n(scrambles[s], 9, UINT64_C(1) << 40, part, 30);
+    v4f_r4_n(scrambles[s], 9, (UINT64_C(1) << 40) + 30, part + 30, 34);
+    ALWAYS_ASSERT(memcmp(all, part, sizeof(all)) == 0);
+  }
+
+  // scrambling keeps the stratification, one point per 1/16 (Sobol) or 1/9 (Halton base 3)
+  v2f_sobol_n(MVLA_SCRAMBLE_OWEN, 77, 0, pts, 16);
+  memset(seen, 0, sizeof(seen));
+  for (i = 0; i < 16; ++i) {
+    seen[(int) (pts[i].x * 16.0f)] += 1;
+    seen[16 + (int) (pts[i].y * 8.0f)] += 1;
+  }
+  for (i = 0; i < 16; ++i) {
+    ALWAYS_ASSERT(seen[i] == 1 && (i >= 8 || seen[16 + i] == 2));
+  }
+  v2f_halton_n(MVLA_SCRAMBLE_OWEN, 77, 0, pts, 27);
+  memset(seen, 0, sizeof(seen));
+  for (i = 0; i < 27; ++i) {
+    seen[(int) (pts[i].y * 27.0f)] += 1;
+  }
+  for (i = 0; i < 27; ++i) {
+    ALWAYS_ASSERT(seen[i] == 1);
+  }
+
+  // different seeds give different randomizations
+  p = v3f_sobol(MVLA_SCRAMBLE_OWEN, 1, 3);
+  ALWAYS_ASSERT(p.x != v3f_sobol(MVLA_SCRAMBLE_OWEN, 2, 3).x);
+  ALWAYS_ASSERT(v2f_r2(MVLA_SCRAMBLE_SHIFT, 1, 0).x != 0.5f);
+}
+
+void test_dispatch(void) {
+  mvla_tier_t best = mvla_tier_detect();
+  int t;
+
+  // mvla_tier_name
+  ALWAYS_ASSERT(strcmp(mvla_tier_name(MVLA_TIER_SCALAR), "scalar") == 0);
+  ALWAYS_ASSERT(strcmp(mvla_tier_name(MVLA_TIER_AVX512), "avx512") == 0);
+
+  // every tier up to the best one must agree with the scalar functions
+  for (t = MVLA_TIER_SCALAR; t <= MVLA_TIER_AVX512; ++t) {
+    mvla_tier_t bound = mvla_tier_set((mvla_tier_t) t);
+    ALWAYS_ASSERT(bound == ((mvla_tier_t) t < best ? (mvla_tier_t) t : best));
+    ALWAYS_ASSERT(mvla_tier_get() == bound);
+    test_batch();
+    test_mat_batch();
+    test_gemm();
+    test_gemv();
+    test_soa();
+    test_fast_math();
+    test_rng_batch();
+    test_philox();
+  }
+
+  mvla_tier_set(best);
 }
 
 int main(void) {
@@ -948,6 +2891,22 @@ int main(void) {
   test_v2();
   test_v3();
   test_v4();
+  test_mat();
+  test_vec();
+  test_gemm();
+  test_gemv();
+  test_dense_threads();
+  test_threads();
+  test_memory();
+  test_pages();
+  test_file();
+  test_text();
+  test_batch();
+  test_soa();
+  test_layout();
+  test_rng();
+  test_qrng();
+  test_dispatch();
 
   printf("All tests passing...\n");
 